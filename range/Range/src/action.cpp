@@ -1617,6 +1617,22 @@ void Action::onGeometryDevPurgeUnusedElements()
     R_LOG_TRACE_OUT;
 }
 
+void Action::onGeometryDevReorderMesh()
+{
+    R_LOG_TRACE_IN;
+    foreach (uint modelID, Session::getInstance().getSelectedModelIDs())
+    {
+        ModelActionInput modelActionInput(modelID);
+        modelActionInput.setReorderMesh();
+
+        ModelAction *modelAction = new ModelAction;
+        modelAction->setAutoDelete(true);
+        modelAction->addAction(modelActionInput);
+        JobManager::getInstance().submit(modelAction);
+    }
+    R_LOG_TRACE_OUT;
+}
+
 void Action::onGeometryDevRemoveDuplicateNodes()
 {
     R_LOG_TRACE_IN;
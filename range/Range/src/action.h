@@ -257,6 +257,9 @@ class Action : public QAction
         //! Purge unused elements.
         void onGeometryDevPurgeUnusedElements();
 
+        //! Reorder mesh.
+        void onGeometryDevReorderMesh();
+
         //! Merge duplicate nodes.
         void onGeometryDevRemoveDuplicateNodes();
 
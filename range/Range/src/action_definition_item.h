@@ -120,6 +120,7 @@ typedef enum _ActionType
     ACTION_GEOMETRY_DEV_EXPORT_INTERSECTED_ELEMENTS,
     ACTION_GEOMETRY_DEV_PURGE_UNUSED_NODES,
     ACTION_GEOMETRY_DEV_PURGE_UNUSED_ELEMENTS,
+    ACTION_GEOMETRY_DEV_REORDER_MESH,
     ACTION_GEOMETRY_DEV_REMOVE_DUPLICATE_NODES,
     ACTION_GEOMETRY_DEV_REMOVE_DUPLICATE_ELEMENTS,
     ACTION_GEOMETRY_DEV_POINT_INSIDE_SURFACE,
@@ -145,6 +145,7 @@ void ActionList::processAvailability(void)
         this->getAction(ACTION_GEOMETRY_DEV_EXPORT_INTERSECTED_ELEMENTS)->setEnabled(true);
         this->getAction(ACTION_GEOMETRY_DEV_PURGE_UNUSED_NODES)->setEnabled(true);
         this->getAction(ACTION_GEOMETRY_DEV_PURGE_UNUSED_ELEMENTS)->setEnabled(true);
+        this->getAction(ACTION_GEOMETRY_DEV_REORDER_MESH)->setEnabled(true);
         this->getAction(ACTION_GEOMETRY_DEV_REMOVE_DUPLICATE_NODES)->setEnabled(true);
         this->getAction(ACTION_GEOMETRY_DEV_REMOVE_DUPLICATE_ELEMENTS)->setEnabled(true);
         this->getAction(ACTION_GEOMETRY_DEV_POINT_INSIDE_SURFACE)->setEnabled(true);
@@ -259,6 +260,7 @@ void ActionList::setDisabled(bool allActions)
     this->getAction(ACTION_GEOMETRY_DEV_EXPORT_INTERSECTED_ELEMENTS)->setEnabled(enabled);
     this->getAction(ACTION_GEOMETRY_DEV_PURGE_UNUSED_NODES)->setEnabled(enabled);
     this->getAction(ACTION_GEOMETRY_DEV_PURGE_UNUSED_ELEMENTS)->setEnabled(enabled);
+    this->getAction(ACTION_GEOMETRY_DEV_REORDER_MESH)->setEnabled(enabled);
     this->getAction(ACTION_GEOMETRY_DEV_POINT_INSIDE_SURFACE)->setEnabled(enabled);
     this->getAction(ACTION_GEOMETRY_DEV_TETRAHEDRALIZE_SURFACE)->setEnabled(enabled);
     this->getAction(ACTION_GEOMETRY_DEV_CONSOLIDATE)->setEnabled(enabled);
@@ -431,6 +431,7 @@ void MainWindow::createMenus()
     menuGeometryDevelopement->addAction(this->actionList->getAction(ACTION_GEOMETRY_DEV_EXPORT_INTERSECTED_ELEMENTS));
     menuGeometryDevelopement->addAction(this->actionList->getAction(ACTION_GEOMETRY_DEV_PURGE_UNUSED_NODES));
     menuGeometryDevelopement->addAction(this->actionList->getAction(ACTION_GEOMETRY_DEV_PURGE_UNUSED_ELEMENTS));
+    menuGeometryDevelopement->addAction(this->actionList->getAction(ACTION_GEOMETRY_DEV_REORDER_MESH));
     menuGeometryDevelopement->addAction(this->actionList->getAction(ACTION_GEOMETRY_DEV_REMOVE_DUPLICATE_NODES));
     menuGeometryDevelopement->addAction(this->actionList->getAction(ACTION_GEOMETRY_DEV_REMOVE_DUPLICATE_ELEMENTS));
     menuGeometryDevelopement->addAction(this->actionList->getAction(ACTION_GEOMETRY_DEV_POINT_INSIDE_SURFACE));
@@ -69,6 +69,32 @@ MatrixSolverConfigDialog::MatrixSolverConfigDialog(uint modelID, QWidget *parent
 
     cgRowCount ++;
 
+    QLabel *labelCGPreconditioner = new QLabel(tr("Preconditioner:"));
+    cgLayout->addWidget(labelCGPreconditioner, cgRowCount, 0, 1, 1);
+
+    this->comboCGPreconditioner = MatrixSolverConfigDialog::createPreconditionerComboBox(solverConfCG.getPreconditionerType());
+    cgLayout->addWidget(this->comboCGPreconditioner, cgRowCount, 1, 1, 1);
+
+    cgRowCount ++;
+
+    this->checkCGDirectSolver = new QCheckBox(tr("Use sparse direct solver (Cholesky factorization)"));
+    this->checkCGDirectSolver->setChecked(solverConfCG.getDirectSolver());
+    cgLayout->addWidget(this->checkCGDirectSolver, cgRowCount, 0, 1, 2);
+
+    cgRowCount ++;
+
+    this->checkCGPipelined = new QCheckBox(tr("Use pipelined solver (single reduction per iteration)"));
+    this->checkCGPipelined->setChecked(solverConfCG.getPipelined());
+    cgLayout->addWidget(this->checkCGPipelined, cgRowCount, 0, 1, 2);
+
+    cgRowCount ++;
+
+    this->checkCGMixedPrecision = new QCheckBox(tr("Use mixed precision (single precision matrix with double precision refinement)"));
+    this->checkCGMixedPrecision->setChecked(solverConfCG.getMixedPrecision());
+    cgLayout->addWidget(this->checkCGMixedPrecision, cgRowCount, 0, 1, 2);
+
+    cgRowCount ++;
+
     // GMRES SOLVER
     RMatrixSolverConf &solverConfGMRES = Session::getInstance().getModel(this->modelID).getMatrixSolverConf(RMatrixSolverConf::GMRES);
 
@@ -119,6 +145,26 @@ MatrixSolverConfigDialog::MatrixSolverConfigDialog(uint modelID, QWidget *parent
 
     gmresRowCount ++;
 
+    QLabel *labelGMRESPreconditioner = new QLabel(tr("Preconditioner:"));
+    gmresLayout->addWidget(labelGMRESPreconditioner, gmresRowCount, 0, 1, 1);
+
+    this->comboGMRESPreconditioner = MatrixSolverConfigDialog::createPreconditionerComboBox(solverConfGMRES.getPreconditionerType());
+    gmresLayout->addWidget(this->comboGMRESPreconditioner, gmresRowCount, 1, 1, 1);
+
+    gmresRowCount ++;
+
+    this->checkGMRESDirectSolver = new QCheckBox(tr("Use sparse direct solver (LU factorization)"));
+    this->checkGMRESDirectSolver->setChecked(solverConfGMRES.getDirectSolver());
+    gmresLayout->addWidget(this->checkGMRESDirectSolver, gmresRowCount, 0, 1, 2);
+
+    gmresRowCount ++;
+
+    this->checkGMRESMixedPrecision = new QCheckBox(tr("Use mixed precision (single precision matrix with double precision refinement)"));
+    this->checkGMRESMixedPrecision->setChecked(solverConfGMRES.getMixedPrecision());
+    gmresLayout->addWidget(this->checkGMRESMixedPrecision, gmresRowCount, 0, 1, 2);
+
+    gmresRowCount ++;
+
     // Button layout
 
     QHBoxLayout *buttonsLayout = new QHBoxLayout;
@@ -146,6 +192,10 @@ int MatrixSolverConfigDialog::exec(void)
         solverConfCG.setNOuterIterations(this->spinCGNIterations->value());
         solverConfCG.setSolverCvgValue(this->editCGCvgValue->getValue());
         solverConfCG.setOutputFrequency(this->spinCGOutputFrequency->value());
+        solverConfCG.setPreconditionerType(RMatrixPreconditionerType(this->comboCGPreconditioner->currentData().toInt()));
+        solverConfCG.setDirectSolver(this->checkCGDirectSolver->isChecked());
+        solverConfCG.setPipelined(this->checkCGPipelined->isChecked());
+        solverConfCG.setMixedPrecision(this->checkCGMixedPrecision->isChecked());
 
         RMatrixSolverConf &solverConfGMRES = Session::getInstance().getModel(this->modelID).getMatrixSolverConf(RMatrixSolverConf::GMRES);
 
@@ -153,7 +203,26 @@ int MatrixSolverConfigDialog::exec(void)
         solverConfGMRES.setNOuterIterations(this->spinGMRESNOuterIterations->value());
         solverConfGMRES.setSolverCvgValue(this->editGMRESCvgValue->getValue());
         solverConfGMRES.setOutputFrequency(this->spinGMRESOutputFrequency->value());
+        solverConfGMRES.setPreconditionerType(RMatrixPreconditionerType(this->comboGMRESPreconditioner->currentData().toInt()));
+        solverConfGMRES.setDirectSolver(this->checkGMRESDirectSolver->isChecked());
+        solverConfGMRES.setMixedPrecision(this->checkGMRESMixedPrecision->isChecked());
     }
 
     return retVal;
 }
+
+QComboBox *MatrixSolverConfigDialog::createPreconditionerComboBox(RMatrixPreconditionerType preconditionerType)
+{
+    QComboBox *comboBox = new QComboBox;
+
+    for (int type=R_MATRIX_PRECONDITIONER_NONE;type<R_MATRIX_PRECONDITIONER_N_TYPES;type++)
+    {
+        comboBox->addItem(RMatrixSolverConf::getPreconditionerName(RMatrixPreconditionerType(type)),QVariant(type));
+        if (type == preconditionerType)
+        {
+            comboBox->setCurrentIndex(comboBox->count()-1);
+        }
+    }
+
+    return comboBox;
+}
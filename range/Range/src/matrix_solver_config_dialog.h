@@ -11,10 +11,14 @@
 #ifndef MATRIX_SOLVER_CONFIG_DIALOG_H
 #define MATRIX_SOLVER_CONFIG_DIALOG_H
 
+#include <QCheckBox>
+#include <QComboBox>
 #include <QDialog>
 #include <QSpinBox>
 #include <QGroupBox>
 
+#include <rmlib.h>
+
 #include "value_line_edit.h"
 
 class MatrixSolverConfigDialog : public QDialog
@@ -34,6 +38,14 @@ class MatrixSolverConfigDialog : public QDialog
         ValueLineEdit *editCGCvgValue;
         //! Output frequency.
         QSpinBox *spinCGOutputFrequency;
+        //! Preconditioner.
+        QComboBox *comboCGPreconditioner;
+        //! Sparse direct solver.
+        QCheckBox *checkCGDirectSolver;
+        //! Pipelined solver.
+        QCheckBox *checkCGPipelined;
+        //! Mixed precision solver.
+        QCheckBox *checkCGMixedPrecision;
         //! GMRES SOLVER CONFIGURATION
         QGroupBox *groupGMRES;
         //! Number of inner iterations.
@@ -44,6 +56,12 @@ class MatrixSolverConfigDialog : public QDialog
         ValueLineEdit *editGMRESCvgValue;
         //! Output frequency.
         QSpinBox *spinGMRESOutputFrequency;
+        //! Preconditioner.
+        QComboBox *comboGMRESPreconditioner;
+        //! Sparse direct solver.
+        QCheckBox *checkGMRESDirectSolver;
+        //! Mixed precision solver.
+        QCheckBox *checkGMRESMixedPrecision;
 
     public:
 
@@ -52,6 +70,11 @@ class MatrixSolverConfigDialog : public QDialog
 
         //! Execute dialog.
         int exec(void);
+
+    protected:
+
+        //! Create preconditioner combo box.
+        static QComboBox *createPreconditionerComboBox(RMatrixPreconditionerType preconditionerType);
         
     signals:
         
@@ -47,6 +47,10 @@ MeshGeneratorDialog::MeshGeneratorDialog(uint modelID, QWidget *parent) :
     this->keepResultsCheck->setChecked(this->meshInput.getKeepResults());
     this->keepResultsCheck->setEnabled(rModel.getNVariables() > 0);
 
+    this->reorderMeshCheck = new QCheckBox(tr("Reorder nodes and elements for memory locality"));
+    mainLayout->addWidget(this->reorderMeshCheck);
+    this->reorderMeshCheck->setChecked(this->meshInput.getReorderMesh());
+
     this->qualityMeshGroupBox = new QGroupBox(tr("Quality mesh"));
     mainLayout->addWidget(this->qualityMeshGroupBox);
     this->qualityMeshGroupBox->setCheckable(true);
@@ -184,6 +188,7 @@ void MeshGeneratorDialog::updateMeshInput(void)
     this->meshInput.setVolumeConstraint(this->volumeConstraintEdit->getValue());
     this->meshInput.setReconstruct(this->reconstructCheck->isChecked());
     this->meshInput.setKeepResults(this->keepResultsCheck->isChecked());
+    this->meshInput.setReorderMesh(this->reorderMeshCheck->isChecked());
 
     if (this->meshSizeFunctionMaxValueEdit->getValue() > this->meshSizeFunctionMaxValueEdit->getMaximum())
     {
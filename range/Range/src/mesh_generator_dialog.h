@@ -46,6 +46,8 @@ class MeshGeneratorDialog : public QDialog
         QCheckBox *reconstructCheck;
         //! Keep results check box.
         QCheckBox *keepResultsCheck;
+        //! Reorder mesh check box.
+        QCheckBox *reorderMeshCheck;
         //! TetGen parameters group box.
         QGroupBox *tetgenParamsGroupBox;
         //! TetGen parameters line edit.
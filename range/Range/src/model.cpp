@@ -816,6 +816,16 @@ uint Model::purgeUnusedElements()
     return nPurged;
 }
 
+void Model::reorderMesh(RSpaceFillingCurve::Type type)
+{
+    this->RModel::reorderMesh(type);
+
+    // View-factor matrix is bound to element numbering.
+    this->unloadViewFactorMatrix();
+
+    this->consolidate(Model::ConsolidateEdgeNodes | Model::ConsolidateEdgeElements | Model::ConsolidateHoleElements | Model::ConsolidateSliverElements | Model::ConsolidateIntersectedElements);
+}
+
 uint Model::removeDuplicateElements()
 {
     uint nMerged = this->RModel::removeDuplicateElements();
@@ -2812,6 +2822,9 @@ void Model::loadViewFactorMatrix()
     if (recentViewFactorMatrixFile.isEmpty())
     {
         this->viewFactorMatrix.getHeader().setHemicubeResolution(this->getProblemSetup().getRadiationSetup().getResolution());
+        this->viewFactorMatrix.getHeader().setViewFactorMethod(this->getProblemSetup().getRadiationSetup().getViewFactorMethod());
+        this->viewFactorMatrix.getHeader().setViewFactorCorrection(this->getProblemSetup().getRadiationSetup().getViewFactorCorrection());
+        this->viewFactorMatrix.getHeader().setViewFactorThreshold(this->getProblemSetup().getRadiationSetup().getViewFactorThreshold());
         this->generatePatchInputVector(this->viewFactorMatrix.getHeader().getPatchInput());
     }
     else
@@ -202,6 +202,9 @@ class Model : public RModel
         //! Purge unused elements.
         uint purgeUnusedElements();
 
+        //! Reorder nodes and elements along space filling curve.
+        void reorderMesh(RSpaceFillingCurve::Type type = RSpaceFillingCurve::Hilbert);
+
         //! Merge duplicate elements.
         uint removeDuplicateElements();
 
@@ -85,6 +85,10 @@ void ModelAction::executeAction(const ModelActionInput &modelActionInput)
                 Session::getInstance().storeCurentModelVersion(modelActionInput.getModelID(),tr("Purge unused elements"));
                 this->purgeUnusedElements(modelActionInput);
                 break;
+            case MODEL_ACTION_REORDER_MESH:
+                Session::getInstance().storeCurentModelVersion(modelActionInput.getModelID(),tr("Reorder mesh"));
+                this->reorderMesh(modelActionInput);
+                break;
             case MODEL_ACTION_REMOVE_DUPLICATE_NODES:
                 Session::getInstance().storeCurentModelVersion(modelActionInput.getModelID(),tr("Remove duplicate nodes"));
                 this->removeDuplicateNodes(modelActionInput);
@@ -384,6 +388,23 @@ void ModelAction::purgeUnusedElements(const ModelActionInput &modelActionInput)
     Session::getInstance().setModelChanged(modelActionInput.getModelID());
 }
 
+void ModelAction::reorderMesh(const ModelActionInput &modelActionInput)
+{
+    Model &rModel = Session::getInstance().getModel(modelActionInput.getModelID());
+
+    RLogger::info("Reordering mesh\n");
+    RLogger::indent();
+
+    // Picked entity IDs are no longer valid.
+    Session::getInstance().getPickList().removeItems(modelActionInput.getModelID());
+
+    rModel.reorderMesh();
+
+    RLogger::unindent();
+
+    Session::getInstance().setModelChanged(modelActionInput.getModelID());
+}
+
 void ModelAction::removeDuplicateNodes(const ModelActionInput &modelActionInput)
 {
     Model &rModel = Session::getInstance().getModel(modelActionInput.getModelID());
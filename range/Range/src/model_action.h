@@ -73,6 +73,9 @@ class ModelAction : public Job
         //! Purge unused elements.
         void purgeUnusedElements(const ModelActionInput &modelActionInput);
 
+        //! Reorder mesh.
+        void reorderMesh(const ModelActionInput &modelActionInput);
+
         //! Merge duplicate nodes.
         void removeDuplicateNodes(const ModelActionInput &modelActionInput);
 
@@ -216,6 +216,11 @@ void ModelActionInput::setPurgeUnusedElements()
     this->type = MODEL_ACTION_PURGE_UNUSED_ELEMENTS;
 }
 
+void ModelActionInput::setReorderMesh()
+{
+    this->type = MODEL_ACTION_REORDER_MESH;
+}
+
 void ModelActionInput::setRemoveDuplicateNodes()
 {
     this->type = MODEL_ACTION_REMOVE_DUPLICATE_NODES;
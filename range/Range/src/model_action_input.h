@@ -29,6 +29,7 @@ typedef enum _ModelActionType
     MODEL_ACTION_REMOVE_NODES,
     MODEL_ACTION_PURGE_UNUSED_NODES,
     MODEL_ACTION_PURGE_UNUSED_ELEMENTS,
+    MODEL_ACTION_REORDER_MESH,
     MODEL_ACTION_REMOVE_DUPLICATE_NODES,
     MODEL_ACTION_REMOVE_DUPLICATE_ELEMENTS,
     MODEL_ACTION_REMOVE_ELEMENTS,
@@ -197,6 +198,9 @@ class ModelActionInput
         //! Set purge unused elements.
         void setPurgeUnusedElements();
 
+        //! Set reorder mesh.
+        void setReorderMesh();
+
         //! Set merge duplicate nodes.
         void setRemoveDuplicateNodes();
 
@@ -12,6 +12,7 @@
 #include <QGroupBox>
 #include <QLabel>
 #include <QComboBox>
+#include <QCheckBox>
 #include <QPushButton>
 #include <QMessageBox>
 
@@ -19,6 +20,7 @@
 #include "job_manager.h"
 #include "model_action.h"
 #include "main_window.h"
+#include "value_line_edit.h"
 #include "radiation_setup_widget.h"
 
 RadiationSetupWidget::RadiationSetupWidget(const RRadiationSetup &radiationSetup, const QString &defaultViewFactorFileName, QWidget *parent)
@@ -75,6 +77,40 @@ RadiationSetupWidget::RadiationSetupWidget(const RRadiationSetup &radiationSetup
 
     this->connect(resolutionCombo,SIGNAL(currentIndexChanged(int)),SLOT(onResolutionChanged(int)));
 
+    QLabel *viewFactorMethodLabel = new QLabel(tr("View-factor method"));
+    viewFactorMethodLabel->setSizePolicy(QSizePolicy(QSizePolicy::Maximum,QSizePolicy::Expanding));
+    radiationLayout->addWidget(viewFactorMethodLabel,crow,0,1,1);
+
+    QComboBox *viewFactorMethodCombo = new QComboBox;
+    viewFactorMethodCombo->setSizePolicy(QSizePolicy(QSizePolicy::Expanding,QSizePolicy::Expanding));
+    for (int i=R_VIEW_FACTOR_METHOD_HEMICUBE;i<R_VIEW_FACTOR_METHOD_N_TYPES;i++)
+    {
+        viewFactorMethodCombo->addItem(RRadiationSetup::getViewFactorMethodText(RViewFactorMethod(i)));
+    }
+    viewFactorMethodCombo->setCurrentIndex(int(this->radiationSetup.getViewFactorMethod()));
+    radiationLayout->addWidget(viewFactorMethodCombo,crow,1,1,1);
+    crow++;
+
+    this->connect(viewFactorMethodCombo,SIGNAL(currentIndexChanged(int)),SLOT(onViewFactorMethodChanged(int)));
+
+    QCheckBox *viewFactorCorrectionCheck = new QCheckBox(tr("Enforce view-factor reciprocity and closure"));
+    viewFactorCorrectionCheck->setChecked(this->radiationSetup.getViewFactorCorrection());
+    radiationLayout->addWidget(viewFactorCorrectionCheck,crow,0,1,2);
+    crow++;
+
+    QObject::connect(viewFactorCorrectionCheck,&QCheckBox::toggled,this,&RadiationSetupWidget::onViewFactorCorrectionToggled);
+
+    QLabel *viewFactorThresholdLabel = new QLabel(tr("View-factor threshold"));
+    viewFactorThresholdLabel->setSizePolicy(QSizePolicy(QSizePolicy::Maximum,QSizePolicy::Expanding));
+    radiationLayout->addWidget(viewFactorThresholdLabel,crow,0,1,1);
+
+    ValueLineEdit *viewFactorThresholdEdit = new ValueLineEdit(0.0,1.0);
+    viewFactorThresholdEdit->setValue(this->radiationSetup.getViewFactorThreshold());
+    radiationLayout->addWidget(viewFactorThresholdEdit,crow,1,1,1);
+    crow++;
+
+    QObject::connect(viewFactorThresholdEdit,&ValueLineEdit::valueChanged,this,&RadiationSetupWidget::onViewFactorThresholdChanged);
+
 
     QGroupBox *customVfFile = new QGroupBox(tr("Custom view-factor file"));
     customVfFile->setCheckable(true);
@@ -113,6 +149,9 @@ RadiationSetupWidget::RadiationSetupWidget(const RRadiationSetup &radiationSetup
     {
         patchesOK = true;
         if (viewFactorMatrixHeader.getHemicubeResolution() == rModel.getViewFactorMatrix().getHeader().getHemicubeResolution() &&
+            viewFactorMatrixHeader.getViewFactorMethod() == rModel.getViewFactorMatrix().getHeader().getViewFactorMethod() &&
+            viewFactorMatrixHeader.getViewFactorCorrection() == rModel.getViewFactorMatrix().getHeader().getViewFactorCorrection() &&
+            viewFactorMatrixHeader.getViewFactorThreshold() == rModel.getViewFactorMatrix().getHeader().getViewFactorThreshold() &&
             rModel.getViewFactorMatrix().getPatchBook().getNPatches() == rModel.getViewFactorMatrix().size())
         {
             viewFactorsOK = true;
@@ -178,6 +217,24 @@ void RadiationSetupWidget::onResolutionChanged(int index)
     emit this->changed(this->radiationSetup);
 }
 
+void RadiationSetupWidget::onViewFactorMethodChanged(int index)
+{
+    this->radiationSetup.setViewFactorMethod(RViewFactorMethod(index));
+    emit this->changed(this->radiationSetup);
+}
+
+void RadiationSetupWidget::onViewFactorCorrectionToggled(bool checked)
+{
+    this->radiationSetup.setViewFactorCorrection(checked);
+    emit this->changed(this->radiationSetup);
+}
+
+void RadiationSetupWidget::onViewFactorThresholdChanged(double value)
+{
+    this->radiationSetup.setViewFactorThreshold(value);
+    emit this->changed(this->radiationSetup);
+}
+
 void RadiationSetupWidget::onCustomViewFactorFileToggled(bool checked)
 {
     if (!checked)
@@ -45,6 +45,15 @@ class RadiationSetupWidget : public QWidget
         //! Radiation resolution changed.
         void onResolutionChanged(int index);
 
+        //! View-factor method changed.
+        void onViewFactorMethodChanged(int index);
+
+        //! View-factor correction toggled.
+        void onViewFactorCorrectionToggled(bool checked);
+
+        //! View-factor threshold changed.
+        void onViewFactorThresholdChanged(double value);
+
         //! Radiation custom view-factor file toggled.
         void onCustomViewFactorFileToggled(bool checked);
 
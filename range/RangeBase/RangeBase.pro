@@ -27,7 +27,10 @@ SOURCES += \
     src/rbl_progress.cpp \
     src/rbl_r3vector.cpp \
     src/rbl_rmatrix.cpp \
+    src/rbl_rsmall_matrix.cpp \
     src/rbl_rvector.cpp \
+    src/rbl_simd.cpp \
+    src/rbl_space_filling_curve.cpp \
     src/rbl_statistics.cpp \
     src/rbl_stop_watch.cpp \
     src/rbl_utils.cpp \
@@ -57,7 +60,10 @@ HEADERS += \
     include/rbl_progress.h \
     include/rbl_r3vector.h \
     include/rbl_rmatrix.h \
+    include/rbl_rsmall_matrix.h \
     include/rbl_rvector.h \
+    include/rbl_simd.h \
+    include/rbl_space_filling_curve.h \
     include/rbl_statistics.h \
     include/rbl_stop_watch.h \
     include/rbl_utils.h \
@@ -42,6 +42,12 @@ class RBook
         //! Assignment operator.
         RBook & operator =(const RBook &book);
 
+        //! Equals operator.
+        bool operator ==(const RBook &book) const;
+
+        //! Not-equals operator.
+        bool operator !=(const RBook &book) const;
+
         //! Resize the array.
         //! Resizing will also result in reinitializing the array.
         void resize(uint size);
@@ -0,0 +1,133 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rbl_rsmall_matrix.h                                      *
+ *  GROUP:  RBL                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Small real matrix class declaration                 *
+ *********************************************************************/
+
+#ifndef RBL_RSMALL_MATRIX_H
+#define RBL_RSMALL_MATRIX_H
+
+#include <QString>
+
+#include "rbl_rmatrix.h"
+#include "rbl_rvector.h"
+
+//! Maximum number of rows and columns of small matrix.
+#define R_SMALL_MATRIX_MAX_SIZE 32
+
+/*
+ * Small dense matrix with contiguous row-major storage held inside the
+ * object (no heap allocation). Intended for element matrices which are
+ * created for every element and integration point.
+ */
+
+//! Small real matrix class.
+class RRSmallMatrix
+{
+
+    protected:
+
+        //! Number of rows.
+        uint nRows;
+        //! Number of columns.
+        uint nColumns;
+        //! Values (row-major, nColumns values per row).
+        double values[R_SMALL_MATRIX_MAX_SIZE*R_SMALL_MATRIX_MAX_SIZE];
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RRSmallMatrix *pMatrix = nullptr);
+
+    public:
+
+        //! Constructor.
+        RRSmallMatrix();
+
+        //! Constructor.
+        RRSmallMatrix(uint nRows,
+                      uint nColumns,
+                      double value = double());
+
+        //! Copy constructor.
+        RRSmallMatrix(const RRSmallMatrix &matrix);
+
+        //! Destructor.
+        ~RRSmallMatrix();
+
+        //! Assignment operator.
+        RRSmallMatrix & operator =(const RRSmallMatrix &matrix);
+
+        //! Return number of rows.
+        inline uint getNRows() const
+        {
+            return this->nRows;
+        }
+
+        //! Return number of columns.
+        inline uint getNColumns() const
+        {
+            return this->nColumns;
+        }
+
+        //! Resize matrix.
+        //! Number of rows and columns must not exceed R_SMALL_MATRIX_MAX_SIZE.
+        void resize(uint nRows,
+                    uint nColumns,
+                    double value = double());
+
+        //! Fill matrix with specified value.
+        void fill(double value);
+
+        //! Return value at given position.
+        double getValue(uint row,
+                        uint column) const;
+
+        //! Set value at given position.
+        void setValue(uint row,
+                      uint column,
+                      double value);
+
+        //! Access operator - return pointer to row values.
+        //! Row index is not checked.
+        inline const double * operator [](uint row) const
+        {
+            return this->values + row*this->nColumns;
+        }
+
+        //! Access operator - return pointer to row values.
+        //! Row index is not checked.
+        inline double * operator [](uint row)
+        {
+            return this->values + row*this->nColumns;
+        }
+
+        //! Return pointer to values.
+        inline const double * data() const
+        {
+            return this->values;
+        }
+
+        //! Return pointer to values.
+        inline double * data()
+        {
+            return this->values;
+        }
+
+        //! Multiplication / scale operator.
+        void operator *=(double scaleValue);
+
+        //! Convert to RRMatrix.
+        RRMatrix toMatrix() const;
+
+        //! Matrix vector multiplication - y=A*x.
+        //! If add is true y won't be cleared.
+        static void mlt(const RRSmallMatrix &A, const RRVector &x, RRVector &y, bool add = false);
+
+};
+
+#endif /* RBL_RSMALL_MATRIX_H */
@@ -99,6 +99,11 @@ class RRVector : public std::vector<double>
                              const RRVector &v2,
                              RRVector &x);
 
+        //! Add scaled vector x to vector y (y = y + a*x).
+        static void axpy(double a,
+                         const RRVector &x,
+                         RRVector &y);
+
         //! Euclidean norm.
         static double norm(const RRVector &v);
 
@@ -0,0 +1,70 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rbl_simd.h                                               *
+ *  GROUP:  RBL                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Vectorized kernels declaration                      *
+ *********************************************************************/
+
+#ifndef RBL_SIMD_H
+#define RBL_SIMD_H
+
+#include <QString>
+
+/*
+ * Dense vector kernels operating on raw arrays.
+ * Implementation is selected once at runtime based on CPU features
+ * (AVX-512, AVX2+FMA), generic unrolled loops are used otherwise.
+ */
+
+class RSimd
+{
+
+    public:
+
+        enum InstructionSet
+        {
+            Generic = 0,
+            AVX2,
+            AVX512,
+            NInstructionSets
+        };
+
+    public:
+
+        //! Return instruction set used by kernels.
+        static InstructionSet getInstructionSet(void);
+
+        //! Force instruction set used by kernels.
+        //! Instruction set is lowered to the best one supported by CPU.
+        static void setInstructionSet(InstructionSet instructionSet);
+
+        //! Return instruction set name.
+        static const QString &getInstructionSetName(InstructionSet instructionSet);
+
+        //! Dot product x.y
+        static double dot(const double *x, const double *y, qint64 n);
+
+        //! Sum of squares x.x
+        static double sumOfSquares(const double *x, qint64 n);
+
+        //! z = x + y
+        static void add(const double *x, const double *y, double *z, qint64 n);
+
+        //! z = x - y
+        static void subtract(const double *x, const double *y, double *z, qint64 n);
+
+        //! x = a * x
+        static void scale(double *x, double a, qint64 n);
+
+        //! y = y + a * x
+        static void axpy(double a, const double *x, double *y, qint64 n);
+
+        //! Return best instruction set supported by CPU.
+        static InstructionSet findSupportedInstructionSet(void);
+
+};
+
+#endif // RBL_SIMD_H
@@ -0,0 +1,59 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rbl_space_filling_curve.h                                *
+ *  GROUP:  RBL                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Space filling curve class declaration               *
+ *********************************************************************/
+
+#ifndef RBL_SPACE_FILLING_CURVE_H
+#define RBL_SPACE_FILLING_CURVE_H
+
+#include <vector>
+
+#include <QString>
+
+#include "rbl_r3vector.h"
+
+/*
+ * Space filling curves map 3D points to 1D keys so that points close
+ * in space get close keys. Sorting by key is used to order nodes and
+ * elements for better memory locality. Coordinates are quantized to
+ * 21 bits per axis within bounding box of given points.
+ */
+
+class RSpaceFillingCurve
+{
+
+    public:
+
+        enum Type
+        {
+            Morton = 0,
+            Hilbert,
+            NTypes
+        };
+
+        //! Number of bits per axis.
+        static const uint nBits;
+
+    public:
+
+        //! Return Morton (Z-order) key of quantized coordinates.
+        static quint64 findMortonKey(uint x, uint y, uint z);
+
+        //! Return Hilbert key of quantized coordinates.
+        static quint64 findHilbertKey(uint x, uint y, uint z);
+
+        //! Find order of points along space filling curve (order[newIndex] = oldIndex).
+        //! Points with equal key keep their original order.
+        static void findOrder(Type type, const std::vector<RR3Vector> &points, std::vector<uint> &order);
+
+        //! Return curve name.
+        static const QString &getName(Type type);
+
+};
+
+#endif // RBL_SPACE_FILLING_CURVE_H
@@ -71,6 +71,10 @@ class RValueVector
         //! If valueBook[i] == RConstants::eod then value will be removed.
         void remove(const std::vector<uint> &valueBook);
 
+        //! Move values to new positions.
+        //! Value at position i is moved to position valueBook[i] (valueBook must be a permutation).
+        void reorder(const std::vector<uint> &valueBook);
+
         //! Fill values with given value.
         void fill ( double value );
 
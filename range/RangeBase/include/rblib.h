@@ -30,8 +30,11 @@
 #include "rbl_plane.h"
 #include "rbl_progress.h"
 #include "rbl_rmatrix.h"
+#include "rbl_rsmall_matrix.h"
 #include "rbl_rvector.h"
 #include "rbl_r3vector.h"
+#include "rbl_simd.h"
+#include "rbl_space_filling_curve.h"
 #include "rbl_statistics.h"
 #include "rbl_stop_watch.h"
 #include "rbl_uvector.h"
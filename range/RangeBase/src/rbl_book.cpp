@@ -43,6 +43,16 @@ RBook &RBook::operator =(const RBook &book)
     return (*this);
 }
 
+bool RBook::operator ==(const RBook &book) const
+{
+    return (this->book == book.book);
+}
+
+bool RBook::operator !=(const RBook &book) const
+{
+    return !this->operator ==(book);
+}
+
 void RBook::resize(uint size)
 {
     this->book.resize(size);
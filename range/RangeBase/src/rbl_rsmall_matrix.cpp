@@ -0,0 +1,136 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rbl_rsmall_matrix.cpp                                    *
+ *  GROUP:  RBL                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Small real matrix class definition                  *
+ *********************************************************************/
+
+#include <algorithm>
+
+#include "rbl_rsmall_matrix.h"
+#include "rbl_error.h"
+#include "rbl_simd.h"
+
+
+RRSmallMatrix::RRSmallMatrix()
+    : nRows(0)
+    , nColumns(0)
+{
+    this->_init();
+} /* RRSmallMatrix::RRSmallMatrix */
+
+
+RRSmallMatrix::RRSmallMatrix(uint nRows, uint nColumns, double value)
+    : nRows(0)
+    , nColumns(0)
+{
+    this->_init();
+    this->resize(nRows,nColumns,value);
+} /* RRSmallMatrix::RRSmallMatrix */
+
+
+RRSmallMatrix::RRSmallMatrix(const RRSmallMatrix &matrix)
+{
+    this->_init(&matrix);
+} /* RRSmallMatrix::RRSmallMatrix (copy) */
+
+
+RRSmallMatrix::~RRSmallMatrix()
+{
+} /* RRSmallMatrix::~RRSmallMatrix */
+
+
+RRSmallMatrix & RRSmallMatrix::operator =(const RRSmallMatrix &matrix)
+{
+    this->_init(&matrix);
+    return (*this);
+} /* RRSmallMatrix::operator = */
+
+
+void RRSmallMatrix::_init(const RRSmallMatrix *pMatrix)
+{
+    if (pMatrix)
+    {
+        this->nRows = pMatrix->nRows;
+        this->nColumns = pMatrix->nColumns;
+        // Only used part of the storage is copied.
+        std::copy(pMatrix->values,pMatrix->values+pMatrix->nRows*pMatrix->nColumns,this->values);
+    }
+} /* RRSmallMatrix::_init */
+
+
+void RRSmallMatrix::resize(uint nRows, uint nColumns, double value)
+{
+    R_ERROR_ASSERT(nRows <= R_SMALL_MATRIX_MAX_SIZE);
+    R_ERROR_ASSERT(nColumns <= R_SMALL_MATRIX_MAX_SIZE);
+
+    this->nRows = nRows;
+    this->nColumns = nColumns;
+    this->fill(value);
+} /* RRSmallMatrix::resize */
+
+
+void RRSmallMatrix::fill(double value)
+{
+    std::fill(this->values,this->values+this->nRows*this->nColumns,value);
+} /* RRSmallMatrix::fill */
+
+
+double RRSmallMatrix::getValue(uint row, uint column) const
+{
+    R_ERROR_ASSERT(row < this->nRows);
+    R_ERROR_ASSERT(column < this->nColumns);
+
+    return this->values[row*this->nColumns+column];
+} /* RRSmallMatrix::getValue */
+
+
+void RRSmallMatrix::setValue(uint row, uint column, double value)
+{
+    R_ERROR_ASSERT(row < this->nRows);
+    R_ERROR_ASSERT(column < this->nColumns);
+
+    this->values[row*this->nColumns+column] = value;
+} /* RRSmallMatrix::setValue */
+
+
+void RRSmallMatrix::operator *=(double scaleValue)
+{
+    RSimd::scale(this->values,scaleValue,qint64(this->nRows)*this->nColumns);
+} /* RRSmallMatrix::operator *= */
+
+
+RRMatrix RRSmallMatrix::toMatrix() const
+{
+    RRMatrix matrix(this->nRows,this->nColumns);
+    for (uint i=0;i<this->nRows;i++)
+    {
+        for (uint j=0;j<this->nColumns;j++)
+        {
+            matrix[i][j] = this->values[i*this->nColumns+j];
+        }
+    }
+    return matrix;
+} /* RRSmallMatrix::toMatrix */
+
+
+void RRSmallMatrix::mlt(const RRSmallMatrix &A, const RRVector &x, RRVector &y, bool add)
+{
+    R_ERROR_ASSERT(A.getNColumns() == x.getNRows());
+
+    if (!add)
+    {
+        y.resize(A.getNRows());
+        y.fill(0.0);
+    }
+
+    R_ERROR_ASSERT(A.getNRows() == y.getNRows());
+
+    for (uint i=0;i<A.getNRows();i++)
+    {
+        y[i] += RSimd::dot(A[i],x.data(),A.getNColumns());
+    }
+} /* RRSmallMatrix::mlt */
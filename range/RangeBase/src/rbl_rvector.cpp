@@ -14,6 +14,7 @@
 
 #include "rbl_logger.h"
 #include "rbl_rvector.h"
+#include "rbl_simd.h"
 #include "rbl_error.h"
 #include "rbl_utils.h"
 
@@ -100,10 +101,7 @@ const double & RRVector::operator [](uint n) const
 
 void RRVector::operator *=(double scaleValue)
 {
-    for (uint i=0;i<this->size();i++)
-    {
-        this->at(i) *= scaleValue;
-    }
+    RSimd::scale(this->data(),scaleValue,qint64(this->size()));
 } /* RRVector::operator *= */
 
 bool RRVector::operator ==(const RRVector &array) const
@@ -130,12 +128,7 @@ bool RRVector::operator !=(const RRVector &array) const
 
 double RRVector::length() const
 {
-    double len = 0.0;
-    for (uint i=0;i<this->size();i++)
-    {
-        len += std::pow(this->at(i),2);
-    }
-    return sqrt(len);
+    return std::sqrt(RSimd::sumOfSquares(this->data(),qint64(this->size())));
 } /* RRVector::length */
 
 
@@ -144,10 +137,7 @@ double RRVector::normalize()
     double len = this->length();
     if (len != 0.0)
     {
-        for (uint i=0;i<this->size();i++)
-        {
-            (*this)[i] /= len;
-        }
+        RSimd::scale(this->data(),1.0/len,qint64(this->size()));
     }
     return len;
 } /* RRVector::normalize */
@@ -155,10 +145,7 @@ double RRVector::normalize()
 
 void RRVector::scale(double scale)
 {
-    for (uint i=0;i<this->size();i++)
-    {
-        (*this)[i] *= scale;
-    }
+    RSimd::scale(this->data(),scale,qint64(this->size()));
 } /* RRVector::scale */
 
 
@@ -209,12 +196,7 @@ double RRVector::dot(const RRVector &v1, const RRVector &v2)
 {
     R_ERROR_ASSERT(v1.size() == v2.size());
 
-    double dotProd = 0.0;
-    for (uint i=0;i<v1.size();i++)
-    {
-        dotProd += v1[i]*v2[i];
-    }
-    return dotProd;
+    return RSimd::dot(v1.data(),v2.data(),qint64(v1.size()));
 } /* RRVector::dot */
 
 
@@ -224,10 +206,7 @@ void RRVector::add(const RRVector &v1, const RRVector &v2, RRVector &x)
 
     x.resize(v1.size());
 
-    for (uint i=0;i<v1.size();i++)
-    {
-        x[i] = v1[i] + v2[i];
-    }
+    RSimd::add(v1.data(),v2.data(),x.data(),qint64(v1.size()));
 } /* RRVector::add */
 
 
@@ -237,13 +216,18 @@ void RRVector::subtract(const RRVector &v1, const RRVector &v2, RRVector &x)
 
     x.resize(v1.size());
 
-    for (uint i=0;i<v1.size();i++)
-    {
-        x[i] = v1[i] - v2[i];
-    }
+    RSimd::subtract(v1.data(),v2.data(),x.data(),qint64(v1.size()));
 } /* RRVector::subtract */
 
 
+void RRVector::axpy(double a, const RRVector &x, RRVector &y)
+{
+    R_ERROR_ASSERT(x.size() == y.size());
+
+    RSimd::axpy(a,x.data(),y.data(),qint64(x.size()));
+} /* RRVector::axpy */
+
+
 double RRVector::norm(const RRVector &v)
 {
     return v.length();
@@ -0,0 +1,388 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rbl_simd.cpp                                             *
+ *  GROUP:  RBL                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Vectorized kernels definition                       *
+ *********************************************************************/
+
+#include <algorithm>
+
+#include "rbl_simd.h"
+#include "rbl_error.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define RBL_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// Short vectors (mostly 3D coordinates) are not worth the dispatch.
+#define RBL_SIMD_MIN_SIZE 16
+
+typedef struct _RSimdKernels
+{
+    double (*dot)(const double *x, const double *y, qint64 n);
+    void (*add)(const double *x, const double *y, double *z, qint64 n);
+    void (*subtract)(const double *x, const double *y, double *z, qint64 n);
+    void (*scale)(double *x, double a, qint64 n);
+    void (*axpy)(double a, const double *x, double *y, qint64 n);
+} RSimdKernels;
+
+static const QString instructionSetNames [] =
+{
+    "Generic",
+    "AVX2",
+    "AVX-512"
+};
+
+/*********************************************************************
+ *  Generic                                                          *
+ *********************************************************************/
+
+static double dotGeneric(const double *x, const double *y, qint64 n)
+{
+    // Independent partial sums break the dependency chain of a single accumulator.
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    qint64 i = 0;
+    for (;i+4<=n;i+=4)
+    {
+        s0 += x[i]*y[i];
+        s1 += x[i+1]*y[i+1];
+        s2 += x[i+2]*y[i+2];
+        s3 += x[i+3]*y[i+3];
+    }
+    for (;i<n;i++)
+    {
+        s0 += x[i]*y[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+static void addGeneric(const double *x, const double *y, double *z, qint64 n)
+{
+    for (qint64 i=0;i<n;i++)
+    {
+        z[i] = x[i] + y[i];
+    }
+}
+
+static void subtractGeneric(const double *x, const double *y, double *z, qint64 n)
+{
+    for (qint64 i=0;i<n;i++)
+    {
+        z[i] = x[i] - y[i];
+    }
+}
+
+static void scaleGeneric(double *x, double a, qint64 n)
+{
+    for (qint64 i=0;i<n;i++)
+    {
+        x[i] *= a;
+    }
+}
+
+static void axpyGeneric(double a, const double *x, double *y, qint64 n)
+{
+    for (qint64 i=0;i<n;i++)
+    {
+        y[i] += a*x[i];
+    }
+}
+
+#ifdef RBL_SIMD_X86
+
+/*********************************************************************
+ *  AVX2                                                             *
+ *********************************************************************/
+
+__attribute__((target("avx2,fma")))
+static double dotAvx2(const double *x, const double *y, qint64 n)
+{
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    qint64 i = 0;
+    for (;i+8<=n;i+=8)
+    {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i),_mm256_loadu_pd(y+i),s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i+4),_mm256_loadu_pd(y+i+4),s1);
+    }
+    for (;i+4<=n;i+=4)
+    {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i),_mm256_loadu_pd(y+i),s0);
+    }
+    s0 = _mm256_add_pd(s0,s1);
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(s0),_mm256_extractf128_pd(s0,1));
+    s = _mm_add_sd(s,_mm_unpackhi_pd(s,s));
+    double value = _mm_cvtsd_f64(s);
+    for (;i<n;i++)
+    {
+        value += x[i]*y[i];
+    }
+    return value;
+}
+
+__attribute__((target("avx2,fma")))
+static void addAvx2(const double *x, const double *y, double *z, qint64 n)
+{
+    qint64 i = 0;
+    for (;i+4<=n;i+=4)
+    {
+        _mm256_storeu_pd(z+i,_mm256_add_pd(_mm256_loadu_pd(x+i),_mm256_loadu_pd(y+i)));
+    }
+    for (;i<n;i++)
+    {
+        z[i] = x[i] + y[i];
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void subtractAvx2(const double *x, const double *y, double *z, qint64 n)
+{
+    qint64 i = 0;
+    for (;i+4<=n;i+=4)
+    {
+        _mm256_storeu_pd(z+i,_mm256_sub_pd(_mm256_loadu_pd(x+i),_mm256_loadu_pd(y+i)));
+    }
+    for (;i<n;i++)
+    {
+        z[i] = x[i] - y[i];
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void scaleAvx2(double *x, double a, qint64 n)
+{
+    __m256d va = _mm256_set1_pd(a);
+    qint64 i = 0;
+    for (;i+4<=n;i+=4)
+    {
+        _mm256_storeu_pd(x+i,_mm256_mul_pd(_mm256_loadu_pd(x+i),va));
+    }
+    for (;i<n;i++)
+    {
+        x[i] *= a;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void axpyAvx2(double a, const double *x, double *y, qint64 n)
+{
+    __m256d va = _mm256_set1_pd(a);
+    qint64 i = 0;
+    for (;i+4<=n;i+=4)
+    {
+        _mm256_storeu_pd(y+i,_mm256_fmadd_pd(va,_mm256_loadu_pd(x+i),_mm256_loadu_pd(y+i)));
+    }
+    for (;i<n;i++)
+    {
+        y[i] += a*x[i];
+    }
+}
+
+/*********************************************************************
+ *  AVX-512                                                          *
+ *********************************************************************/
+
+__attribute__((target("avx512f")))
+static double dotAvx512(const double *x, const double *y, qint64 n)
+{
+    __m512d s0 = _mm512_setzero_pd();
+    __m512d s1 = _mm512_setzero_pd();
+    qint64 i = 0;
+    for (;i+16<=n;i+=16)
+    {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x+i),_mm512_loadu_pd(y+i),s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(x+i+8),_mm512_loadu_pd(y+i+8),s1);
+    }
+    if (i < n)
+    {
+        // Masked load of the remainder avoids scalar tail loop.
+        __mmask8 mask = (n - i >= 8) ? __mmask8(0xFF) : __mmask8((1u << (n - i)) - 1u);
+        s0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask,x+i),_mm512_maskz_loadu_pd(mask,y+i),s0);
+        i += 8;
+        if (i < n)
+        {
+            mask = __mmask8((1u << (n - i)) - 1u);
+            s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask,x+i),_mm512_maskz_loadu_pd(mask,y+i),s1);
+        }
+    }
+    return _mm512_reduce_add_pd(_mm512_add_pd(s0,s1));
+}
+
+__attribute__((target("avx512f")))
+static void addAvx512(const double *x, const double *y, double *z, qint64 n)
+{
+    qint64 i = 0;
+    for (;i+8<=n;i+=8)
+    {
+        _mm512_storeu_pd(z+i,_mm512_add_pd(_mm512_loadu_pd(x+i),_mm512_loadu_pd(y+i)));
+    }
+    if (i < n)
+    {
+        __mmask8 mask = __mmask8((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(z+i,mask,_mm512_add_pd(_mm512_maskz_loadu_pd(mask,x+i),_mm512_maskz_loadu_pd(mask,y+i)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void subtractAvx512(const double *x, const double *y, double *z, qint64 n)
+{
+    qint64 i = 0;
+    for (;i+8<=n;i+=8)
+    {
+        _mm512_storeu_pd(z+i,_mm512_sub_pd(_mm512_loadu_pd(x+i),_mm512_loadu_pd(y+i)));
+    }
+    if (i < n)
+    {
+        __mmask8 mask = __mmask8((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(z+i,mask,_mm512_sub_pd(_mm512_maskz_loadu_pd(mask,x+i),_mm512_maskz_loadu_pd(mask,y+i)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void scaleAvx512(double *x, double a, qint64 n)
+{
+    __m512d va = _mm512_set1_pd(a);
+    qint64 i = 0;
+    for (;i+8<=n;i+=8)
+    {
+        _mm512_storeu_pd(x+i,_mm512_mul_pd(_mm512_loadu_pd(x+i),va));
+    }
+    if (i < n)
+    {
+        __mmask8 mask = __mmask8((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(x+i,mask,_mm512_mul_pd(_mm512_maskz_loadu_pd(mask,x+i),va));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void axpyAvx512(double a, const double *x, double *y, qint64 n)
+{
+    __m512d va = _mm512_set1_pd(a);
+    qint64 i = 0;
+    for (;i+8<=n;i+=8)
+    {
+        _mm512_storeu_pd(y+i,_mm512_fmadd_pd(va,_mm512_loadu_pd(x+i),_mm512_loadu_pd(y+i)));
+    }
+    if (i < n)
+    {
+        __mmask8 mask = __mmask8((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(y+i,mask,_mm512_fmadd_pd(va,_mm512_maskz_loadu_pd(mask,x+i),_mm512_maskz_loadu_pd(mask,y+i)));
+    }
+}
+
+#endif // RBL_SIMD_X86
+
+static const RSimdKernels simdKernels [] =
+{
+    { dotGeneric, addGeneric, subtractGeneric, scaleGeneric, axpyGeneric },
+#ifdef RBL_SIMD_X86
+    { dotAvx2, addAvx2, subtractAvx2, scaleAvx2, axpyAvx2 },
+    { dotAvx512, addAvx512, subtractAvx512, scaleAvx512, axpyAvx512 }
+#else
+    { dotGeneric, addGeneric, subtractGeneric, scaleGeneric, axpyGeneric },
+    { dotGeneric, addGeneric, subtractGeneric, scaleGeneric, axpyGeneric }
+#endif
+};
+
+static RSimd::InstructionSet &getCurrentInstructionSet(void)
+{
+    static RSimd::InstructionSet currentInstructionSet = RSimd::findSupportedInstructionSet();
+    return currentInstructionSet;
+}
+
+static const RSimdKernels &getKernels(void)
+{
+    return simdKernels[getCurrentInstructionSet()];
+}
+
+RSimd::InstructionSet RSimd::getInstructionSet(void)
+{
+    return getCurrentInstructionSet();
+}
+
+void RSimd::setInstructionSet(RSimd::InstructionSet instructionSet)
+{
+    R_ERROR_ASSERT(instructionSet >= RSimd::Generic && instructionSet < RSimd::NInstructionSets);
+
+    getCurrentInstructionSet() = std::min(instructionSet,RSimd::findSupportedInstructionSet());
+}
+
+const QString &RSimd::getInstructionSetName(RSimd::InstructionSet instructionSet)
+{
+    R_ERROR_ASSERT(instructionSet >= RSimd::Generic && instructionSet < RSimd::NInstructionSets);
+    return instructionSetNames[instructionSet];
+}
+
+double RSimd::dot(const double *x, const double *y, qint64 n)
+{
+    if (n < RBL_SIMD_MIN_SIZE)
+    {
+        return dotGeneric(x,y,n);
+    }
+    return getKernels().dot(x,y,n);
+}
+
+double RSimd::sumOfSquares(const double *x, qint64 n)
+{
+    return RSimd::dot(x,x,n);
+}
+
+void RSimd::add(const double *x, const double *y, double *z, qint64 n)
+{
+    if (n < RBL_SIMD_MIN_SIZE)
+    {
+        addGeneric(x,y,z,n);
+        return;
+    }
+    getKernels().add(x,y,z,n);
+}
+
+void RSimd::subtract(const double *x, const double *y, double *z, qint64 n)
+{
+    if (n < RBL_SIMD_MIN_SIZE)
+    {
+        subtractGeneric(x,y,z,n);
+        return;
+    }
+    getKernels().subtract(x,y,z,n);
+}
+
+void RSimd::scale(double *x, double a, qint64 n)
+{
+    if (n < RBL_SIMD_MIN_SIZE)
+    {
+        scaleGeneric(x,a,n);
+        return;
+    }
+    getKernels().scale(x,a,n);
+}
+
+void RSimd::axpy(double a, const double *x, double *y, qint64 n)
+{
+    if (n < RBL_SIMD_MIN_SIZE)
+    {
+        axpyGeneric(a,x,y,n);
+        return;
+    }
+    getKernels().axpy(a,x,y,n);
+}
+
+RSimd::InstructionSet RSimd::findSupportedInstructionSet(void)
+{
+#ifdef RBL_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return RSimd::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return RSimd::AVX2;
+    }
+#endif
+    return RSimd::Generic;
+}
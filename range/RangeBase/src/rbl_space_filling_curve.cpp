@@ -0,0 +1,161 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rbl_space_filling_curve.cpp                              *
+ *  GROUP:  RBL                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Space filling curve class definition                *
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include "rbl_space_filling_curve.h"
+#include "rbl_error.h"
+
+const uint RSpaceFillingCurve::nBits = 21;
+
+static const QString spaceFillingCurveNames [] =
+{
+    "Morton",
+    "Hilbert"
+};
+
+typedef struct _RSpaceFillingCurveItem
+{
+    quint64 key;
+    uint index;
+} RSpaceFillingCurveItem;
+
+static bool spaceFillingCurveItemLess(const RSpaceFillingCurveItem &a, const RSpaceFillingCurveItem &b)
+{
+    if (a.key != b.key)
+    {
+        return (a.key < b.key);
+    }
+    return (a.index < b.index);
+}
+
+static inline quint64 interleaveBits(const uint X[3])
+{
+    quint64 key = 0;
+    for (int b=int(RSpaceFillingCurve::nBits)-1;b>=0;b--)
+    {
+        for (uint i=0;i<3;i++)
+        {
+            key = (key << 1) | quint64((X[i] >> b) & 1);
+        }
+    }
+    return key;
+}
+
+quint64 RSpaceFillingCurve::findMortonKey(uint x, uint y, uint z)
+{
+    uint X[3] = { x, y, z };
+    return interleaveBits(X);
+}
+
+quint64 RSpaceFillingCurve::findHilbertKey(uint x, uint y, uint z)
+{
+    // Skilling's transform of axes to transposed Hilbert index (AIP Conf. Proc. 707, 2004).
+    uint X[3] = { x, y, z };
+    uint M = 1u << (RSpaceFillingCurve::nBits - 1);
+
+    // Inverse undo.
+    for (uint Q=M;Q>1;Q>>=1)
+    {
+        uint P = Q - 1;
+        for (uint i=0;i<3;i++)
+        {
+            if (X[i] & Q)
+            {
+                X[0] ^= P;
+            }
+            else
+            {
+                uint t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode.
+    for (uint i=1;i<3;i++)
+    {
+        X[i] ^= X[i-1];
+    }
+    uint t = 0;
+    for (uint Q=M;Q>1;Q>>=1)
+    {
+        if (X[2] & Q)
+        {
+            t ^= Q - 1;
+        }
+    }
+    for (uint i=0;i<3;i++)
+    {
+        X[i] ^= t;
+    }
+
+    return interleaveBits(X);
+}
+
+void RSpaceFillingCurve::findOrder(RSpaceFillingCurve::Type type, const std::vector<RR3Vector> &points, std::vector<uint> &order)
+{
+    R_ERROR_ASSERT(type >= Morton && type < NTypes);
+
+    uint nPoints = uint(points.size());
+
+    order.resize(nPoints);
+    if (nPoints == 0)
+    {
+        return;
+    }
+
+    double lower[3] = { points[0][0], points[0][1], points[0][2] };
+    double upper[3] = { points[0][0], points[0][1], points[0][2] };
+    for (uint i=1;i<nPoints;i++)
+    {
+        for (uint j=0;j<3;j++)
+        {
+            lower[j] = std::min(lower[j],points[i][j]);
+            upper[j] = std::max(upper[j],points[i][j]);
+        }
+    }
+
+    // Same scale is used in all directions to keep curve cells cubic.
+    double size = std::max(upper[0]-lower[0],std::max(upper[1]-lower[1],upper[2]-lower[2]));
+    double maxCoordinate = double((1u << RSpaceFillingCurve::nBits) - 1);
+    double scale = (size > 0.0) ? maxCoordinate / size : 0.0;
+
+    std::vector<RSpaceFillingCurveItem> items(nPoints);
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nPoints);i++)
+    {
+        uint X[3];
+        for (uint j=0;j<3;j++)
+        {
+            double value = std::floor((points[i][j] - lower[j]) * scale);
+            X[j] = uint(std::min(std::max(value,0.0),maxCoordinate));
+        }
+        items[i].key = (type == Hilbert) ? RSpaceFillingCurve::findHilbertKey(X[0],X[1],X[2])
+                                         : RSpaceFillingCurve::findMortonKey(X[0],X[1],X[2]);
+        items[i].index = uint(i);
+    }
+
+    std::sort(items.begin(),items.end(),spaceFillingCurveItemLess);
+
+    for (uint i=0;i<nPoints;i++)
+    {
+        order[i] = items[i].index;
+    }
+}
+
+const QString &RSpaceFillingCurve::getName(RSpaceFillingCurve::Type type)
+{
+    R_ERROR_ASSERT(type >= Morton && type < NTypes);
+    return spaceFillingCurveNames[type];
+}
@@ -117,6 +117,19 @@ void RValueVector::remove(const std::vector<uint> &valueBook)
 } /* RValueVector::remove */
 
 
+void RValueVector::reorder(const std::vector<uint> &valueBook)
+{
+    R_ERROR_ASSERT(valueBook.size() == this->values.size());
+
+    RRVector valuesNew(this->values.size());
+    for (uint i=0;i<this->values.size();i++)
+    {
+        valuesNew[valueBook[i]] = this->values[i];
+    }
+    this->values = valuesNew;
+} /* RValueVector::reorder */
+
+
 void RValueVector::fill(double value)
 {
     std::fill(this->values.begin(),this->values.end(),value);
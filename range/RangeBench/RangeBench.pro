@@ -0,0 +1,71 @@
+QT += core
+
+include(../range.pri)
+
+win*-msvc* {
+    QMAKE_CXXFLAGS += -openmp
+    LIB_EXT = "lib"
+    LIB_PRE = ""
+}
+else {
+    macx {
+        QMAKE_CXXFLAGS += -Xpreprocessor -fopenmp -I/usr/local/include
+        LIBS += -lomp -L /usr/local/lib
+    }
+    else {
+        QMAKE_CXXFLAGS += -fopenmp
+        LIBS += -fopenmp
+    }
+    LIB_EXT = "a"
+    LIB_PRE = "lib"
+
+    !win* {
+        CONFIG += link_pkgconfig
+    }
+}
+
+TARGET = RangeBench
+TEMPLATE = app
+
+BUILDPATH = $${PWD}/../../build-range3
+
+SOURCES += \
+    src/bench_problem.cpp \
+    src/bench_runner.cpp \
+    src/main.cpp
+
+HEADERS += \
+    src/bench_problem.h \
+    src/bench_runner.h
+
+
+CONFIG -= debug_and_release
+CONFIG += rtti
+CONFIG += exceptions
+CONFIG += console
+CONFIG -= app_bundle
+
+CONFIG(debug, debug|release) {
+    TARGET = $$join(TARGET,,,_debug)
+}
+
+LIBS += \
+    -L../TetGen/ \
+    -L../RangeBase/ \
+    -L../RangeModel/ \
+    -L../RangeSolverLib/ \
+    -lRangeSolverLib$${DEBUG_EXT} \
+    -lRangeModel$${DEBUG_EXT} \
+    -lRangeBase$${DEBUG_EXT} \
+    -lTetGen$${DEBUG_EXT}
+
+PRE_TARGETDEPS += \
+    ../TetGen/$${LIB_PRE}TetGen$${DEBUG_EXT}.$${LIB_EXT} \
+    ../RangeBase/$${LIB_PRE}RangeBase$${DEBUG_EXT}.$${LIB_EXT} \
+    ../RangeModel/$${LIB_PRE}RangeModel$${DEBUG_EXT}.$${LIB_EXT} \
+    ../RangeSolverLib/$${LIB_PRE}RangeSolverLib$${DEBUG_EXT}.$${LIB_EXT}
+
+INCLUDEPATH += $${_PRO_FILE_PWD_}/../TetGen
+INCLUDEPATH += $${_PRO_FILE_PWD_}/../RangeBase/include
+INCLUDEPATH += $${_PRO_FILE_PWD_}/../RangeModel/include
+INCLUDEPATH += $${_PRO_FILE_PWD_}/../RangeSolverLib/include
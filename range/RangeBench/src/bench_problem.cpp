@@ -0,0 +1,578 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   bench_problem.cpp                                        *
+ *  GROUP:  RangeBench                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Benchmark problem class definition                  *
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include <rblib.h>
+
+#include "bench_problem.h"
+
+static QString problemIds [] =
+{
+    "none",
+    "poisson",
+    "elasticity",
+    "recorded"
+};
+
+//! Split of hexahedral cell (corner index = 4*i + 2*j + k) into 6 tetrahedra sharing main diagonal.
+static const uint cellTetrahedra[6][4] =
+{
+    {0,1,3,7},
+    {0,1,5,7},
+    {0,2,3,7},
+    {0,2,6,7},
+    {0,4,5,7},
+    {0,4,6,7}
+};
+
+//! Young's modulus used for elasticity problem.
+static const double youngModulus = 1.0;
+//! Poisson ratio used for elasticity problem.
+static const double poissonRatio = 0.3;
+
+void BenchProblem::_init(const BenchProblem *pProblem)
+{
+    if (pProblem)
+    {
+        this->type = pProblem->type;
+        this->name = pProblem->name;
+        this->meshSize = pProblem->meshSize;
+        this->nodes = pProblem->nodes;
+        this->nodeRows = pProblem->nodeRows;
+        this->A = pProblem->A;
+        this->Acsr = pProblem->Acsr;
+        this->b = pProblem->b;
+        this->blockSize = pProblem->blockSize;
+        this->rowBlockIndexes = pProblem->rowBlockIndexes;
+        this->nearNullSpace = pProblem->nearNullSpace;
+        this->symmetric = pProblem->symmetric;
+        this->recordedSolverConf = pProblem->recordedSolverConf;
+        this->recordedPreconditionerType = pProblem->recordedPreconditionerType;
+    }
+}
+
+BenchProblem::BenchProblem()
+    : type(BenchProblem::None)
+    , meshSize(0)
+    , blockSize(1)
+    , symmetric(true)
+    , recordedPreconditionerType(R_MATRIX_PRECONDITIONER_NONE)
+{
+    this->_init();
+}
+
+BenchProblem::BenchProblem(const BenchProblem &problem)
+{
+    this->_init(&problem);
+}
+
+BenchProblem::~BenchProblem()
+{
+}
+
+BenchProblem &BenchProblem::operator =(const BenchProblem &problem)
+{
+    this->_init(&problem);
+    return (*this);
+}
+
+void BenchProblem::generate(BenchProblem::Type type, uint meshSize)
+{
+    if (type != BenchProblem::Poisson && type != BenchProblem::Elasticity)
+    {
+        throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Only Poisson and elasticity problems can be generated.");
+    }
+    if (meshSize == 0)
+    {
+        throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Mesh size must be greater than zero.");
+    }
+
+    this->type = type;
+    this->name = BenchProblem::getId(type) + QString("-%1").arg(meshSize);
+    this->meshSize = meshSize;
+    this->blockSize = (type == BenchProblem::Elasticity) ? 3 : 1;
+    this->symmetric = true;
+
+    uint m = meshSize + 1;
+    uint nNodes = m*m*m;
+
+    this->nodes.resize(nNodes);
+    for (uint i=0;i<m;i++)
+    {
+        for (uint j=0;j<m;j++)
+        {
+            for (uint k=0;k<m;k++)
+            {
+                this->nodes[this->findNodeIndex(i,j,k)] = RR3Vector(double(i)/double(meshSize),
+                                                                    double(j)/double(meshSize),
+                                                                    double(k)/double(meshSize));
+            }
+        }
+    }
+
+    // Nodes on face x=0 are fixed, remaining node components are numbered node by node.
+    uint nRows = 0;
+    this->nodeRows.assign(size_t(nNodes)*this->blockSize,RConstants::eod);
+    this->rowBlockIndexes.clear();
+    for (uint i=1;i<m;i++)
+    {
+        for (uint j=0;j<m;j++)
+        {
+            for (uint k=0;k<m;k++)
+            {
+                uint nodeID = this->findNodeIndex(i,j,k);
+                for (uint c=0;c<this->blockSize;c++)
+                {
+                    this->nodeRows[size_t(nodeID)*this->blockSize+c] = nRows++;
+                    this->rowBlockIndexes.push_back(nodeID);
+                }
+            }
+        }
+    }
+
+    // Rigid body modes.
+    this->nearNullSpace.clear();
+    if (type == BenchProblem::Elasticity)
+    {
+        this->nearNullSpace.resize(6,RRVector(nRows,0.0));
+        for (uint nodeID=0;nodeID<nNodes;nodeID++)
+        {
+            double x = this->nodes[nodeID][0] - 0.5;
+            double y = this->nodes[nodeID][1] - 0.5;
+            double z = this->nodes[nodeID][2] - 0.5;
+            double modes[6][3] = {{1.0,0.0,0.0},{0.0,1.0,0.0},{0.0,0.0,1.0},{0.0,-z,y},{z,0.0,-x},{-y,x,0.0}};
+            for (uint c=0;c<3;c++)
+            {
+                uint row = this->nodeRows[size_t(nodeID)*3+c];
+                if (row == RConstants::eod)
+                {
+                    continue;
+                }
+                for (uint q=0;q<6;q++)
+                {
+                    this->nearNullSpace[q][row] = modes[q][c];
+                }
+            }
+        }
+    }
+
+    // Sequential assembly creates sparsity pattern so that following assemblies can run in parallel.
+    this->A.clear();
+    this->A.setNRows(nRows);
+    this->b.resize(nRows);
+    this->b.fill(0.0);
+    for (uint i=0;i<meshSize;i++)
+    {
+        for (uint j=0;j<meshSize;j++)
+        {
+            for (uint k=0;k<meshSize;k++)
+            {
+                uint corners[8];
+                for (uint c=0;c<8;c++)
+                {
+                    corners[c] = this->findNodeIndex(i+((c>>2)&1),j+((c>>1)&1),k+(c&1));
+                }
+                for (uint t=0;t<6;t++)
+                {
+                    uint nodeIDs[4] = {corners[cellTetrahedra[t][0]],corners[cellTetrahedra[t][1]],corners[cellTetrahedra[t][2]],corners[cellTetrahedra[t][3]]};
+                    this->assembleElement(nodeIDs);
+                }
+            }
+        }
+    }
+    this->freeze();
+}
+
+void BenchProblem::readMatrixMarket(const QString &fileName, uint blockSize)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    QTextStream in(&file);
+
+    QString header = in.readLine().toLower();
+    if (!header.startsWith("%%matrixmarket matrix coordinate"))
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"File \'%s\' is not a MatrixMarket coordinate matrix.",fileName.toUtf8().constData());
+    }
+    if (header.contains("complex"))
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Complex matrix in file \'%s\' is not supported.",fileName.toUtf8().constData());
+    }
+    bool pattern = header.contains("pattern");
+    bool symmetricStorage = header.contains("symmetric");
+
+    QString line;
+    do
+    {
+        line = in.readLine();
+    } while (!in.atEnd() && (line.startsWith('%') || line.trimmed().isEmpty()));
+
+    QStringList sizes = line.simplified().split(' ');
+    if (sizes.size() != 3)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Invalid size line in file \'%s\'.",fileName.toUtf8().constData());
+    }
+    uint nRows = sizes[0].toUInt();
+    uint nColumns = sizes[1].toUInt();
+    uint nEntries = sizes[2].toUInt();
+    if (nRows != nColumns || nRows == 0)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Matrix in file \'%s\' is not square.",fileName.toUtf8().constData());
+    }
+    if (blockSize == 0 || nRows % blockSize != 0)
+    {
+        throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Number of rows (%u) is not divisible by block size (%u).",nRows,blockSize);
+    }
+
+    this->A.clear();
+    this->A.setNRows(nRows);
+    for (uint i=0;i<nEntries;i++)
+    {
+        uint row = 0;
+        uint column = 0;
+        double value = 1.0;
+        in >> row >> column;
+        if (!pattern)
+        {
+            in >> value;
+        }
+        if (in.status() != QTextStream::Ok || row == 0 || column == 0 || row > nRows || column > nRows)
+        {
+            throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Invalid entry %u in file \'%s\'.",i+1,fileName.toUtf8().constData());
+        }
+        this->A.addValue(row-1,column-1,value);
+        if (symmetricStorage && row != column)
+        {
+            this->A.addValue(column-1,row-1,value);
+        }
+    }
+    file.close();
+
+    QFileInfo fileInfo(fileName);
+
+    this->type = BenchProblem::Recorded;
+    this->name = fileInfo.completeBaseName();
+    this->meshSize = 0;
+    this->nodes.clear();
+    this->nodeRows.clear();
+    this->blockSize = blockSize;
+    this->rowBlockIndexes.clear();
+    this->nearNullSpace.clear();
+
+    this->freeze();
+
+    // Files written as general may still hold symmetric matrix (e.g. RMatrixSystem::writeMatrixMarket).
+    this->symmetric = symmetricStorage || BenchProblem::isNumericallySymmetric(this->Acsr);
+    if (this->symmetric && !symmetricStorage)
+    {
+        RLogger::info("Matrix stored as general is numerically symmetric.\n");
+    }
+
+    RRVector ones(nRows,1.0);
+    RSparseMatrixCSR::mlt(this->Acsr,ones,this->b);
+}
+
+void BenchProblem::readMatrixSystem(const QString &fileName)
+{
+    RMatrixSystem matrixSystem;
+    matrixSystem.read(fileName);
+
+    if (matrixSystem.getMatrix().getNRows() == 0 || matrixSystem.getRhs().size() != matrixSystem.getMatrix().getNRows())
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Matrix system in file \'%s\' is empty or inconsistent.",fileName.toUtf8().constData());
+    }
+
+    QFileInfo fileInfo(fileName);
+
+    this->type = BenchProblem::Recorded;
+    this->name = fileInfo.completeBaseName();
+    this->meshSize = 0;
+    this->nodes.clear();
+    this->nodeRows.clear();
+    this->A.clear();
+    this->Acsr = matrixSystem.getMatrix();
+    this->b = matrixSystem.getRhs();
+    this->blockSize = std::max(matrixSystem.getBlockSize(),uint(1));
+    this->rowBlockIndexes = matrixSystem.getRowBlockIndexes();
+    this->nearNullSpace = matrixSystem.getNearNullSpace();
+    // Systems solved by conjugate gradient are symmetric.
+    this->symmetric = (matrixSystem.getMatrixSolverConf().getType() == RMatrixSolverConf::CG);
+    this->recordedSolverConf = matrixSystem.getMatrixSolverConf();
+    this->recordedPreconditionerType = matrixSystem.getPreconditionerType();
+}
+
+void BenchProblem::assemble(void)
+{
+    if (!this->isGenerated())
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Only generated problems can be assembled.");
+    }
+
+    this->A.clearValues();
+    this->b.fill(0.0);
+
+    // Cells with the same parity in all directions do not share any node.
+    uint nColorCells = (this->meshSize + 1) / 2;
+    for (uint color=0;color<8;color++)
+    {
+        uint ci = (color >> 2) & 1;
+        uint cj = (color >> 1) & 1;
+        uint ck = color & 1;
+
+#pragma omp parallel for default(shared)
+        for (int64_t n=0;n<int64_t(nColorCells)*nColorCells*nColorCells;n++)
+        {
+            uint i = ci + 2 * uint(n / (int64_t(nColorCells)*nColorCells));
+            uint j = cj + 2 * uint((n / nColorCells) % nColorCells);
+            uint k = ck + 2 * uint(n % nColorCells);
+            if (i >= this->meshSize || j >= this->meshSize || k >= this->meshSize)
+            {
+                continue;
+            }
+            uint corners[8];
+            for (uint c=0;c<8;c++)
+            {
+                corners[c] = this->findNodeIndex(i+((c>>2)&1),j+((c>>1)&1),k+(c&1));
+            }
+            for (uint t=0;t<6;t++)
+            {
+                uint nodeIDs[4] = {corners[cellTetrahedra[t][0]],corners[cellTetrahedra[t][1]],corners[cellTetrahedra[t][2]],corners[cellTetrahedra[t][3]]};
+                this->assembleElement(nodeIDs);
+            }
+        }
+    }
+}
+
+void BenchProblem::freeze(void)
+{
+    this->Acsr.build(this->A);
+}
+
+bool BenchProblem::isNumericallySymmetric(const RSparseMatrixCSR &matrix, double tolerance)
+{
+    double maxValue = 0.0;
+    for (uint k=0;k<matrix.getNValues();k++)
+    {
+        maxValue = std::max(maxValue,std::abs(matrix.getValue(k)));
+    }
+
+    for (uint i=0;i<matrix.getNRows();i++)
+    {
+        for (uint k=matrix.getRowBegin(i);k<matrix.getRowEnd(i);k++)
+        {
+            uint j = matrix.getColumnIndex(k);
+            // Both triangles are checked, value may be missing on either side.
+            if (j != i && std::abs(matrix.getValue(k) - matrix.findValue(j,i)) > tolerance * maxValue)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool BenchProblem::isGenerated(void) const
+{
+    return (this->type == BenchProblem::Poisson || this->type == BenchProblem::Elasticity);
+}
+
+BenchProblem::Type BenchProblem::getType(void) const
+{
+    return this->type;
+}
+
+const QString &BenchProblem::getName(void) const
+{
+    return this->name;
+}
+
+uint BenchProblem::getNElements(void) const
+{
+    return 6 * this->meshSize * this->meshSize * this->meshSize;
+}
+
+const RSparseMatrixCSR &BenchProblem::getMatrix(void) const
+{
+    return this->Acsr;
+}
+
+const RRVector &BenchProblem::getRhs(void) const
+{
+    return this->b;
+}
+
+uint BenchProblem::getBlockSize(void) const
+{
+    return this->blockSize;
+}
+
+const std::vector<uint> &BenchProblem::getRowBlockIndexes(void) const
+{
+    return this->rowBlockIndexes;
+}
+
+const std::vector<RRVector> &BenchProblem::getNearNullSpace(void) const
+{
+    return this->nearNullSpace;
+}
+
+bool BenchProblem::getSymmetric(void) const
+{
+    return this->symmetric;
+}
+
+const RMatrixSolverConf &BenchProblem::getRecordedSolverConf(void) const
+{
+    return this->recordedSolverConf;
+}
+
+RMatrixPreconditionerType BenchProblem::getRecordedPreconditionerType(void) const
+{
+    return this->recordedPreconditionerType;
+}
+
+const QString &BenchProblem::getId(BenchProblem::Type type)
+{
+    R_ERROR_ASSERT(type >= BenchProblem::None && type < BenchProblem::NTypes);
+    return problemIds[type];
+}
+
+BenchProblem::Type BenchProblem::getTypeFromId(const QString &id)
+{
+    for (int type=BenchProblem::None;type<BenchProblem::NTypes;type++)
+    {
+        if (problemIds[type] == id)
+        {
+            return BenchProblem::Type(type);
+        }
+    }
+    return BenchProblem::None;
+}
+
+uint BenchProblem::findNodeIndex(uint i, uint j, uint k) const
+{
+    uint m = this->meshSize + 1;
+    return (i*m + j)*m + k;
+}
+
+void BenchProblem::assembleElement(const uint nodeIDs[4])
+{
+    const RR3Vector &n0 = this->nodes[nodeIDs[0]];
+
+    double J[3][3];
+    for (uint q=0;q<3;q++)
+    {
+        const RR3Vector &nq = this->nodes[nodeIDs[q+1]];
+        J[0][q] = nq[0] - n0[0];
+        J[1][q] = nq[1] - n0[1];
+        J[2][q] = nq[2] - n0[2];
+    }
+
+    double detJ = J[0][0]*(J[1][1]*J[2][2]-J[1][2]*J[2][1])
+                - J[0][1]*(J[1][0]*J[2][2]-J[1][2]*J[2][0])
+                + J[0][2]*(J[1][0]*J[2][1]-J[1][1]*J[2][0]);
+
+    double iJ[3][3];
+    iJ[0][0] = (J[1][1]*J[2][2]-J[1][2]*J[2][1])/detJ;
+    iJ[0][1] = (J[0][2]*J[2][1]-J[0][1]*J[2][2])/detJ;
+    iJ[0][2] = (J[0][1]*J[1][2]-J[0][2]*J[1][1])/detJ;
+    iJ[1][0] = (J[1][2]*J[2][0]-J[1][0]*J[2][2])/detJ;
+    iJ[1][1] = (J[0][0]*J[2][2]-J[0][2]*J[2][0])/detJ;
+    iJ[1][2] = (J[0][2]*J[1][0]-J[0][0]*J[1][2])/detJ;
+    iJ[2][0] = (J[1][0]*J[2][1]-J[1][1]*J[2][0])/detJ;
+    iJ[2][1] = (J[0][1]*J[2][0]-J[0][0]*J[2][1])/detJ;
+    iJ[2][2] = (J[0][0]*J[1][1]-J[0][1]*J[1][0])/detJ;
+
+    // Shape function gradients.
+    double g[4][3];
+    for (uint d=0;d<3;d++)
+    {
+        g[1][d] = iJ[0][d];
+        g[2][d] = iJ[1][d];
+        g[3][d] = iJ[2][d];
+        g[0][d] = -(g[1][d] + g[2][d] + g[3][d]);
+    }
+
+    double volume = std::fabs(detJ) / 6.0;
+
+    if (this->type == BenchProblem::Poisson)
+    {
+        for (uint a=0;a<4;a++)
+        {
+            uint row = this->nodeRows[nodeIDs[a]];
+            if (row == RConstants::eod)
+            {
+                continue;
+            }
+            for (uint c=0;c<4;c++)
+            {
+                uint column = this->nodeRows[nodeIDs[c]];
+                if (column == RConstants::eod)
+                {
+                    continue;
+                }
+                this->A.addValue(row,column,volume*(g[a][0]*g[c][0]+g[a][1]*g[c][1]+g[a][2]*g[c][2]));
+            }
+            this->b[row] += volume / 4.0;
+        }
+    }
+    else
+    {
+        double lambda = youngModulus*poissonRatio/((1.0+poissonRatio)*(1.0-2.0*poissonRatio));
+        double mu = youngModulus/(2.0*(1.0+poissonRatio));
+
+        for (uint a=0;a<4;a++)
+        {
+            for (uint p=0;p<3;p++)
+            {
+                uint row = this->nodeRows[size_t(nodeIDs[a])*3+p];
+                if (row == RConstants::eod)
+                {
+                    continue;
+                }
+                for (uint c=0;c<4;c++)
+                {
+                    double gg = g[a][0]*g[c][0] + g[a][1]*g[c][1] + g[a][2]*g[c][2];
+                    for (uint q=0;q<3;q++)
+                    {
+                        uint column = this->nodeRows[size_t(nodeIDs[c])*3+q];
+                        if (column == RConstants::eod)
+                        {
+                            continue;
+                        }
+                        double value = lambda*g[a][p]*g[c][q] + mu*g[a][q]*g[c][p];
+                        if (p == q)
+                        {
+                            value += mu*gg;
+                        }
+                        this->A.addValue(row,column,volume*value);
+                    }
+                }
+            }
+            // Gravity load in -z direction.
+            uint row = this->nodeRows[size_t(nodeIDs[a])*3+2];
+            if (row != RConstants::eod)
+            {
+                this->b[row] -= volume / 4.0;
+            }
+        }
+    }
+}
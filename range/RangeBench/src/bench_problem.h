@@ -0,0 +1,163 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   bench_problem.h                                          *
+ *  GROUP:  RangeBench                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Benchmark problem class declaration                 *
+ *********************************************************************/
+
+#ifndef BENCH_PROBLEM_H
+#define BENCH_PROBLEM_H
+
+#include <vector>
+
+#include <QString>
+
+#include <rmlib.h>
+
+/*
+ * Benchmark problem is either generated on a structured tetrahedral mesh
+ * of the unit cube (n x n x n cells, each split into 6 linear tetrahedra,
+ * face x=0 fixed) or read from a matrix file recorded from a real run.
+ */
+
+class BenchProblem
+{
+
+    public:
+
+        enum Type
+        {
+            None = 0,
+            Poisson,
+            Elasticity,
+            Recorded,
+            NTypes
+        };
+
+    protected:
+
+        //! Problem type.
+        Type type;
+        //! Problem name.
+        QString name;
+        //! Number of cells along mesh edge (generated problems).
+        uint meshSize;
+        //! Node coordinates (generated problems).
+        std::vector<RR3Vector> nodes;
+        //! Matrix row of each node component (RConstants::eod if component is fixed).
+        std::vector<uint> nodeRows;
+        //! System matrix.
+        RSparseMatrix A;
+        //! System matrix in compressed sparse row format.
+        RSparseMatrixCSR Acsr;
+        //! Right hand side vector.
+        RRVector b;
+        //! Number of unknowns per node.
+        uint blockSize;
+        //! Block (node) index of each matrix row.
+        std::vector<uint> rowBlockIndexes;
+        //! Near null space (rigid body modes) for algebraic multigrid.
+        std::vector<RRVector> nearNullSpace;
+        //! Matrix is symmetric.
+        bool symmetric;
+        //! Matrix solver configuration the system was recorded with.
+        RMatrixSolverConf recordedSolverConf;
+        //! Preconditioner the system was recorded with.
+        RMatrixPreconditionerType recordedPreconditionerType;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const BenchProblem *pProblem = nullptr);
+
+    public:
+
+        //! Constructor.
+        BenchProblem();
+
+        //! Copy constructor.
+        BenchProblem(const BenchProblem &problem);
+
+        //! Destructor.
+        ~BenchProblem();
+
+        //! Assignment operator.
+        BenchProblem & operator =(const BenchProblem &problem);
+
+        //! Generate Poisson or elasticity problem with given number of cells along mesh edge.
+        void generate(Type type, uint meshSize);
+
+        //! Read problem from MatrixMarket coordinate file.
+        //! Right hand side is set to A*1 so that exact solution is vector of ones.
+        void readMatrixMarket(const QString &fileName, uint blockSize = 1);
+
+        //! Read problem from matrix system file dumped by matrix solver.
+        //! Recorded right hand side, block structure and near null space are used.
+        void readMatrixSystem(const QString &fileName);
+
+        //! Assemble system matrix and right hand side vector (generated problems only).
+        //! Elements are assembled in parallel, one color (independent set of cells) at a time.
+        void assemble(void);
+
+        //! Convert assembled matrix to compressed sparse row format.
+        void freeze(void);
+
+        //! Return true if problem was generated and can be assembled.
+        bool isGenerated(void) const;
+
+        //! Return problem type.
+        Type getType(void) const;
+
+        //! Return problem name.
+        const QString &getName(void) const;
+
+        //! Return number of elements (generated problems).
+        uint getNElements(void) const;
+
+        //! Return system matrix in compressed sparse row format.
+        const RSparseMatrixCSR &getMatrix(void) const;
+
+        //! Return right hand side vector.
+        const RRVector &getRhs(void) const;
+
+        //! Return number of unknowns per node.
+        uint getBlockSize(void) const;
+
+        //! Return block (node) index of each matrix row.
+        const std::vector<uint> &getRowBlockIndexes(void) const;
+
+        //! Return near null space.
+        const std::vector<RRVector> &getNearNullSpace(void) const;
+
+        //! Return true if matrix is symmetric.
+        bool getSymmetric(void) const;
+
+        //! Return matrix solver configuration the system was recorded with.
+        const RMatrixSolverConf &getRecordedSolverConf(void) const;
+
+        //! Return preconditioner the system was recorded with.
+        RMatrixPreconditionerType getRecordedPreconditionerType(void) const;
+
+        //! Return problem type id.
+        static const QString &getId(Type type);
+
+        //! Return problem type from id.
+        static Type getTypeFromId(const QString &id);
+
+    protected:
+
+        //! Return node index.
+        uint findNodeIndex(uint i, uint j, uint k) const;
+
+        //! Assemble element (linear tetrahedron).
+        void assembleElement(const uint nodeIDs[4]);
+
+        //! Return true if matrix values are symmetric within relative tolerance.
+        static bool isNumericallySymmetric(const RSparseMatrixCSR &matrix, double tolerance = 1.0e-12);
+
+};
+
+#endif // BENCH_PROBLEM_H
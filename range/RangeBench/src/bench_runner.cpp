@@ -0,0 +1,494 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   bench_runner.cpp                                         *
+ *  GROUP:  RangeBench                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Benchmark runner class definition                   *
+ *********************************************************************/
+
+#include <omp.h>
+
+#include <cmath>
+
+#include <rblib.h>
+#include <rsolverlib.h>
+
+#include "bench_runner.h"
+
+static QString preconditionerIds [] =
+{
+    "none",
+    "jacobi",
+    "block-jacobi",
+    "ic",
+    "ilu",
+    "amg",
+    "ilut"
+};
+
+void BenchRunner::_init(const BenchRunner *pRunner)
+{
+    if (pRunner)
+    {
+        this->nThreads = pRunner->nThreads;
+        this->nRepeats = pRunner->nRepeats;
+        this->preconditioners = pRunner->preconditioners;
+        this->solvers = pRunner->solvers;
+        this->solverCvgValue = pRunner->solverCvgValue;
+        this->nSolverIterations = pRunner->nSolverIterations;
+        this->results = pRunner->results;
+    }
+}
+
+BenchRunner::BenchRunner()
+    : nRepeats(10)
+    , solverCvgValue(1.0e-10)
+    , nSolverIterations(10000)
+{
+    this->nThreads.push_back(1);
+    this->preconditioners.push_back(R_MATRIX_PRECONDITIONER_JACOBI);
+    this->preconditioners.push_back(R_MATRIX_PRECONDITIONER_BLOCK_JACOBI);
+    this->preconditioners.push_back(R_MATRIX_PRECONDITIONER_INCOMPLETE_CHOLESKY);
+    this->preconditioners.push_back(R_MATRIX_PRECONDITIONER_INCOMPLETE_LU);
+    this->preconditioners.push_back(R_MATRIX_PRECONDITIONER_ALGEBRAIC_MULTIGRID);
+    this->solvers.push_back("cg");
+    this->solvers.push_back("gmres");
+    this->_init();
+}
+
+BenchRunner::BenchRunner(const BenchRunner &runner)
+{
+    this->_init(&runner);
+}
+
+BenchRunner::~BenchRunner()
+{
+}
+
+BenchRunner &BenchRunner::operator =(const BenchRunner &runner)
+{
+    this->_init(&runner);
+    return (*this);
+}
+
+void BenchRunner::setNThreads(const std::vector<uint> &nThreads)
+{
+    this->nThreads = nThreads;
+}
+
+void BenchRunner::setNRepeats(uint nRepeats)
+{
+    this->nRepeats = std::max(nRepeats,uint(1));
+}
+
+const std::vector<RMatrixPreconditionerType> &BenchRunner::getPreconditioners(void) const
+{
+    return this->preconditioners;
+}
+
+void BenchRunner::setPreconditioners(const std::vector<RMatrixPreconditionerType> &preconditioners)
+{
+    this->preconditioners = preconditioners;
+}
+
+const std::vector<QString> &BenchRunner::getSolvers(void) const
+{
+    return this->solvers;
+}
+
+void BenchRunner::setSolvers(const std::vector<QString> &solvers)
+{
+    this->solvers = solvers;
+}
+
+void BenchRunner::setSolverCvgValue(double solverCvgValue)
+{
+    this->solverCvgValue = solverCvgValue;
+}
+
+void BenchRunner::setNSolverIterations(uint nSolverIterations)
+{
+    this->nSolverIterations = nSolverIterations;
+}
+
+void BenchRunner::run(BenchProblem &problem)
+{
+    RLogger::info("Benchmark problem \'%s\' - rows = %u, nonzeros = %u\n",
+                  problem.getName().toUtf8().constData(),
+                  problem.getMatrix().getNRows(),
+                  problem.getMatrix().getNValues());
+
+    for (uint i=0;i<this->nThreads.size();i++)
+    {
+        uint nThreads = std::max(this->nThreads[i],uint(1));
+        if (int(nThreads) > omp_get_num_procs())
+        {
+            RLogger::warning("Number of threads (%u) exceeds number of processors (%d).\n",nThreads,omp_get_num_procs());
+        }
+        omp_set_num_threads(int(nThreads));
+
+        RLogger::info("Threads = %u\n",nThreads);
+        RLogger::indent();
+
+        if (problem.isGenerated())
+        {
+            this->runAssembly(problem,nThreads);
+        }
+        this->runSpMV(problem,nThreads);
+        for (uint j=0;j<this->preconditioners.size();j++)
+        {
+            QString reason;
+            if (BenchRunner::isApplicable(problem,QString(),this->preconditioners[j],reason))
+            {
+                this->runPreconditioner(problem,this->preconditioners[j],nThreads);
+            }
+            else if (this->preconditioners[j] != R_MATRIX_PRECONDITIONER_NONE)
+            {
+                RLogger::info("Skipping preconditioner \'%s\': %s\n",
+                              BenchRunner::getPreconditionerId(this->preconditioners[j]).toUtf8().constData(),
+                              reason.toUtf8().constData());
+            }
+        }
+        for (uint k=0;k<this->solvers.size();k++)
+        {
+            if (this->solvers[k] == "direct")
+            {
+                this->runSolve(problem,this->solvers[k],R_MATRIX_PRECONDITIONER_NONE,nThreads);
+                continue;
+            }
+            for (uint j=0;j<this->preconditioners.size();j++)
+            {
+                QString reason;
+                if (BenchRunner::isApplicable(problem,this->solvers[k],this->preconditioners[j],reason))
+                {
+                    this->runSolve(problem,this->solvers[k],this->preconditioners[j],nThreads);
+                }
+                else
+                {
+                    RLogger::info("Skipping solver \'%s/%s\': %s\n",
+                                  this->solvers[k].toUtf8().constData(),
+                                  BenchRunner::getPreconditionerId(this->preconditioners[j]).toUtf8().constData(),
+                                  reason.toUtf8().constData());
+                }
+            }
+        }
+
+        RLogger::unindent(false);
+    }
+}
+
+const std::vector<BenchResult> &BenchRunner::getResults(void) const
+{
+    return this->results;
+}
+
+void BenchRunner::writeCsv(QTextStream &out) const
+{
+    out << "problem,rows,nnz,threads,benchmark,variant,repeats,time_min,time_avg,gflops,gbytes_per_s,flops,bytes,iterations,residual,speedup\n";
+
+    for (uint i=0;i<this->results.size();i++)
+    {
+        const BenchResult &result = this->results[i];
+
+        double speedup = 1.0;
+        for (uint j=0;j<=i;j++)
+        {
+            const BenchResult &base = this->results[j];
+            if (base.problem == result.problem && base.benchmark == result.benchmark && base.variant == result.variant)
+            {
+                if (result.minTime > 0.0)
+                {
+                    speedup = base.minTime / result.minTime;
+                }
+                break;
+            }
+        }
+
+        double gflops = (result.minTime > 0.0) ? result.flops / result.minTime * 1.0e-9 : 0.0;
+        double gbytes = (result.minTime > 0.0) ? result.bytes / result.minTime * 1.0e-9 : 0.0;
+
+        out << result.problem << ","
+            << result.nRows << ","
+            << result.nNonZeros << ","
+            << result.nThreads << ","
+            << result.benchmark << ","
+            << result.variant << ","
+            << result.nRepeats << ","
+            << QString::number(result.minTime,'e',6) << ","
+            << QString::number(result.avgTime,'e',6) << ","
+            << QString::number(gflops,'f',4) << ","
+            << QString::number(gbytes,'f',4) << ","
+            << QString::number(result.flops,'e',6) << ","
+            << QString::number(result.bytes,'e',6) << ","
+            << result.nIterations << ","
+            << QString::number(result.residual,'e',6) << ","
+            << QString::number(speedup,'f',4) << "\n";
+    }
+    out.flush();
+}
+
+const QString &BenchRunner::getPreconditionerId(RMatrixPreconditionerType preconditionerType)
+{
+    R_ERROR_ASSERT(R_MATRIX_PRECONDITIONER_TYPE_IS_VALID(preconditionerType));
+    return preconditionerIds[preconditionerType];
+}
+
+RMatrixPreconditionerType BenchRunner::getPreconditionerTypeFromId(const QString &id)
+{
+    for (int type=R_MATRIX_PRECONDITIONER_NONE;type<R_MATRIX_PRECONDITIONER_N_TYPES;type++)
+    {
+        if (preconditionerIds[type] == id)
+        {
+            return RMatrixPreconditionerType(type);
+        }
+    }
+    return R_MATRIX_PRECONDITIONER_N_TYPES;
+}
+
+void BenchRunner::runAssembly(BenchProblem &problem, uint nThreads)
+{
+    std::vector<double> assemblyTimes;
+    std::vector<double> freezeTimes;
+
+    for (uint r=0;r<this->nRepeats;r++)
+    {
+        double startTime = omp_get_wtime();
+        problem.assemble();
+        double assemblyTime = omp_get_wtime();
+        problem.freeze();
+        double freezeTime = omp_get_wtime();
+
+        assemblyTimes.push_back(assemblyTime - startTime);
+        freezeTimes.push_back(freezeTime - assemblyTime);
+    }
+
+    this->addResult(problem,nThreads,"assembly","colored",assemblyTimes);
+    this->addResult(problem,nThreads,"assembly","csr",freezeTimes);
+}
+
+void BenchRunner::runSpMV(const BenchProblem &problem, uint nThreads)
+{
+    const RSparseMatrixCSR &A = problem.getMatrix();
+    uint nRows = A.getNRows();
+    double nValues = double(A.getNValues());
+
+    RRVector x(nRows);
+    for (uint i=0;i<nRows;i++)
+    {
+        x[i] = std::sin(double(i));
+    }
+    RRVector y(nRows,0.0);
+
+    std::vector<double> times(this->nRepeats,0.0);
+    double startTime = 0.0;
+
+#pragma omp parallel default(shared)
+    {
+        // First multiplication is not measured (warm-up).
+        RSparseMatrixCSR::mlt(A,x,y);
+        for (uint r=0;r<this->nRepeats;r++)
+        {
+#pragma omp barrier
+#pragma omp master
+            startTime = omp_get_wtime();
+            RSparseMatrixCSR::mlt(A,x,y);
+#pragma omp master
+            times[r] = omp_get_wtime() - startTime;
+        }
+    }
+
+    this->addResult(problem,nThreads,"spmv","csr",times,
+                    2.0*nValues,
+                    nValues*(sizeof(double)+sizeof(uint)) + double(nRows+1)*sizeof(uint) + 2.0*nRows*sizeof(double));
+
+    if (problem.getBlockSize() > 1)
+    {
+        RSparseMatrixBSR Ab(A,problem.getBlockSize(),problem.getRowBlockIndexes());
+        double nBlocks = double(Ab.getNBlocks());
+        double nBlockRows = double(Ab.getNBlockRows());
+        double blockSize = double(Ab.getBlockSize());
+
+#pragma omp parallel default(shared)
+        {
+            RSparseMatrixBSR::mlt(Ab,x,y);
+            for (uint r=0;r<this->nRepeats;r++)
+            {
+#pragma omp barrier
+#pragma omp master
+                startTime = omp_get_wtime();
+                RSparseMatrixBSR::mlt(Ab,x,y);
+#pragma omp master
+                times[r] = omp_get_wtime() - startTime;
+            }
+        }
+
+        // Only nonzero values are counted as useful work, stored padding is counted as memory traffic.
+        this->addResult(problem,nThreads,"spmv",QString("bsr%1").arg(Ab.getBlockSize()),times,
+                        2.0*nValues,
+                        nBlocks*(blockSize*blockSize*sizeof(double)+sizeof(uint)) + (nBlockRows+1.0)*sizeof(uint) + 2.0*nBlockRows*blockSize*sizeof(uint) + 2.0*nRows*sizeof(double));
+    }
+}
+
+void BenchRunner::runPreconditioner(const BenchProblem &problem, RMatrixPreconditionerType preconditionerType, uint nThreads)
+{
+    const RSparseMatrixCSR &A = problem.getMatrix();
+    uint nRows = A.getNRows();
+    const QString &variant = BenchRunner::getPreconditionerId(preconditionerType);
+
+    double startTime = omp_get_wtime();
+    RMatrixPreconditioner P(A,preconditionerType,problem.getBlockSize(),problem.getNearNullSpace(),problem.getRowBlockIndexes());
+    std::vector<double> setupTimes(1,omp_get_wtime() - startTime);
+
+    this->addResult(problem,nThreads,"setup",variant,setupTimes);
+
+    RRVector x(nRows);
+    for (uint i=0;i<nRows;i++)
+    {
+        x[i] = std::sin(double(i));
+    }
+    RRVector y(nRows,0.0);
+
+    std::vector<double> times(this->nRepeats,0.0);
+
+#pragma omp parallel default(shared)
+    {
+        P.compute(x,y);
+        for (uint r=0;r<this->nRepeats;r++)
+        {
+#pragma omp barrier
+#pragma omp master
+            startTime = omp_get_wtime();
+            P.compute(x,y);
+#pragma omp barrier
+#pragma omp master
+            times[r] = omp_get_wtime() - startTime;
+        }
+    }
+
+    double flops = 0.0;
+    double bytes = 0.0;
+    if (preconditionerType == R_MATRIX_PRECONDITIONER_JACOBI)
+    {
+        flops = double(nRows);
+        bytes = 3.0*nRows*sizeof(double);
+    }
+
+    this->addResult(problem,nThreads,"apply",variant,times,flops,bytes);
+}
+
+void BenchRunner::runSolve(const BenchProblem &problem, const QString &solver, RMatrixPreconditionerType preconditionerType, uint nThreads)
+{
+    const RSparseMatrixCSR &A = problem.getMatrix();
+    const RRVector &b = problem.getRhs();
+
+    RMatrixSolverConf matrixSolverConf(solver == "gmres" || (solver == "direct" && !problem.getSymmetric()) ? RMatrixSolverConf::GMRES : RMatrixSolverConf::CG);
+    matrixSolverConf.setSolverCvgValue(this->solverCvgValue);
+    matrixSolverConf.setNOuterIterations(this->nSolverIterations);
+    matrixSolverConf.setPreconditionerType(preconditionerType);
+    matrixSolverConf.setDirectSolver(solver == "direct");
+    matrixSolverConf.setPipelined(solver == "pipecg");
+
+    RMatrixSolver matrixSolver(matrixSolverConf);
+    matrixSolver.disableConvergenceLogFile();
+    if (preconditionerType == R_MATRIX_PRECONDITIONER_ALGEBRAIC_MULTIGRID)
+    {
+        matrixSolver.setNearNullSpace(problem.getNearNullSpace(),problem.getRowBlockIndexes());
+    }
+    else
+    {
+        matrixSolver.setRowBlockIndexes(problem.getRowBlockIndexes());
+    }
+
+    RRVector x(b.size(),0.0);
+
+    double startTime = omp_get_wtime();
+    matrixSolver.solve(A,b,x,preconditionerType,problem.getBlockSize());
+    std::vector<double> times(1,omp_get_wtime() - startTime);
+
+    RRVector r;
+    RSparseMatrixCSR::mlt(A,x,r);
+    double rn = 0.0;
+    double bn = 0.0;
+    for (uint i=0;i<b.size();i++)
+    {
+        rn += (b[i] - r[i]) * (b[i] - r[i]);
+        bn += b[i] * b[i];
+    }
+    double residual = (bn > 0.0) ? std::sqrt(rn/bn) : std::sqrt(rn);
+
+    QString variant(solver);
+    if (solver != "direct")
+    {
+        variant += "/" + BenchRunner::getPreconditionerId(preconditionerType);
+    }
+
+    this->addResult(problem,nThreads,"solve",variant,times,0.0,0.0,matrixSolver.getIterationInfo().getIteration(),residual);
+}
+
+bool BenchRunner::isApplicable(const BenchProblem &problem, const QString &solver, RMatrixPreconditionerType preconditionerType, QString &reason)
+{
+    if ((solver == "cg" || solver == "pipecg") && !problem.getSymmetric())
+    {
+        reason = "matrix is not symmetric";
+        return false;
+    }
+    switch (preconditionerType)
+    {
+        case R_MATRIX_PRECONDITIONER_NONE:
+            reason = "nothing to measure";
+            return !solver.isEmpty();
+        case R_MATRIX_PRECONDITIONER_BLOCK_JACOBI:
+            reason = "block size is 1";
+            return (problem.getBlockSize() > 1);
+        case R_MATRIX_PRECONDITIONER_INCOMPLETE_CHOLESKY:
+            reason = problem.getSymmetric() ? "not used with GMRES" : "matrix is not symmetric";
+            return (problem.getSymmetric() && solver != "gmres");
+        case R_MATRIX_PRECONDITIONER_INCOMPLETE_LU:
+        case R_MATRIX_PRECONDITIONER_INCOMPLETE_LU_THRESHOLD:
+            reason = "nonsymmetric preconditioner is not used with CG";
+            return (solver != "cg" && solver != "pipecg");
+        default:
+            return true;
+    }
+}
+
+void BenchRunner::addResult(const BenchProblem &problem,
+                            uint nThreads,
+                            const QString &benchmark,
+                            const QString &variant,
+                            const std::vector<double> &times,
+                            double flops,
+                            double bytes,
+                            uint nIterations,
+                            double residual)
+{
+    BenchResult result;
+    result.problem = problem.getName();
+    result.nRows = problem.getMatrix().getNRows();
+    result.nNonZeros = problem.getMatrix().getNValues();
+    result.nThreads = nThreads;
+    result.benchmark = benchmark;
+    result.variant = variant;
+    result.nRepeats = uint(times.size());
+    result.minTime = 0.0;
+    result.avgTime = 0.0;
+    for (uint i=0;i<times.size();i++)
+    {
+        result.minTime = (i == 0) ? times[i] : std::min(result.minTime,times[i]);
+        result.avgTime += times[i];
+    }
+    if (!times.empty())
+    {
+        result.avgTime /= double(times.size());
+    }
+    result.flops = flops;
+    result.bytes = bytes;
+    result.nIterations = nIterations;
+    result.residual = residual;
+
+    RLogger::info("%-9s %-20s %12.6f s\n",benchmark.toUtf8().constData(),variant.toUtf8().constData(),result.minTime);
+
+    this->results.push_back(result);
+}
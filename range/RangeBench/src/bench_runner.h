@@ -0,0 +1,164 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   bench_runner.h                                           *
+ *  GROUP:  RangeBench                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Benchmark runner class declaration                  *
+ *********************************************************************/
+
+#ifndef BENCH_RUNNER_H
+#define BENCH_RUNNER_H
+
+#include <vector>
+
+#include <QString>
+#include <QTextStream>
+
+#include <rmlib.h>
+
+#include "bench_problem.h"
+
+//! Single benchmark measurement.
+typedef struct _BenchResult
+{
+    //! Problem name.
+    QString problem;
+    //! Number of matrix rows.
+    uint nRows;
+    //! Number of matrix nonzeros.
+    uint nNonZeros;
+    //! Number of threads.
+    uint nThreads;
+    //! Benchmark name (assembly, spmv, setup, apply, solve).
+    QString benchmark;
+    //! Benchmark variant (matrix format, preconditioner, solver).
+    QString variant;
+    //! Number of repetitions.
+    uint nRepeats;
+    //! Minimum time in seconds.
+    double minTime;
+    //! Average time in seconds.
+    double avgTime;
+    //! Floating point operations per repetition (0 if not modelled).
+    double flops;
+    //! Bytes moved from memory per repetition (0 if not modelled).
+    double bytes;
+    //! Number of solver iterations.
+    uint nIterations;
+    //! Relative residual after solve.
+    double residual;
+} BenchResult;
+
+class BenchRunner
+{
+
+    protected:
+
+        //! Thread counts to measure.
+        std::vector<uint> nThreads;
+        //! Number of repetitions of kernel benchmarks.
+        uint nRepeats;
+        //! Preconditioners to measure.
+        std::vector<RMatrixPreconditionerType> preconditioners;
+        //! Matrix solvers to measure.
+        std::vector<QString> solvers;
+        //! Solver convergence value.
+        double solverCvgValue;
+        //! Maximum number of solver iterations.
+        uint nSolverIterations;
+        //! Collected results.
+        std::vector<BenchResult> results;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const BenchRunner *pRunner = nullptr);
+
+    public:
+
+        //! Constructor.
+        BenchRunner();
+
+        //! Copy constructor.
+        BenchRunner(const BenchRunner &runner);
+
+        //! Destructor.
+        ~BenchRunner();
+
+        //! Assignment operator.
+        BenchRunner & operator =(const BenchRunner &runner);
+
+        //! Set thread counts to measure.
+        void setNThreads(const std::vector<uint> &nThreads);
+
+        //! Set number of repetitions of kernel benchmarks.
+        void setNRepeats(uint nRepeats);
+
+        //! Return preconditioners to measure.
+        const std::vector<RMatrixPreconditionerType> &getPreconditioners(void) const;
+
+        //! Set preconditioners to measure.
+        void setPreconditioners(const std::vector<RMatrixPreconditionerType> &preconditioners);
+
+        //! Return matrix solvers to measure.
+        const std::vector<QString> &getSolvers(void) const;
+
+        //! Set matrix solvers to measure (cg, pipecg, gmres, direct).
+        void setSolvers(const std::vector<QString> &solvers);
+
+        //! Set solver convergence value.
+        void setSolverCvgValue(double solverCvgValue);
+
+        //! Set maximum number of solver iterations.
+        void setNSolverIterations(uint nSolverIterations);
+
+        //! Run all benchmarks on given problem for each thread count.
+        void run(BenchProblem &problem);
+
+        //! Return collected results.
+        const std::vector<BenchResult> &getResults(void) const;
+
+        //! Write results in CSV format.
+        //! Speedup is relative to the first thread count measured for the same benchmark.
+        void writeCsv(QTextStream &out) const;
+
+        //! Return preconditioner id.
+        static const QString &getPreconditionerId(RMatrixPreconditionerType preconditionerType);
+
+        //! Return preconditioner type from id (R_MATRIX_PRECONDITIONER_N_TYPES if not found).
+        static RMatrixPreconditionerType getPreconditionerTypeFromId(const QString &id);
+
+    protected:
+
+        //! Measure assembly of generated problem.
+        void runAssembly(BenchProblem &problem, uint nThreads);
+
+        //! Measure sparse matrix vector multiplication.
+        void runSpMV(const BenchProblem &problem, uint nThreads);
+
+        //! Measure preconditioner setup and application.
+        void runPreconditioner(const BenchProblem &problem, RMatrixPreconditionerType preconditionerType, uint nThreads);
+
+        //! Measure full solve.
+        void runSolve(const BenchProblem &problem, const QString &solver, RMatrixPreconditionerType preconditionerType, uint nThreads);
+
+        //! Return true if preconditioner can be used with given problem and solver.
+        //! If not, reason is set to explanation which can be logged.
+        static bool isApplicable(const BenchProblem &problem, const QString &solver, RMatrixPreconditionerType preconditionerType, QString &reason);
+
+        //! Append result.
+        void addResult(const BenchProblem &problem,
+                       uint nThreads,
+                       const QString &benchmark,
+                       const QString &variant,
+                       const std::vector<double> &times,
+                       double flops = 0.0,
+                       double bytes = 0.0,
+                       uint nIterations = 0,
+                       double residual = 0.0);
+
+};
+
+#endif // BENCH_RUNNER_H
@@ -0,0 +1,247 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   main.cpp                                                 *
+ *  GROUP:  RangeBench                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Main function                                       *
+ *********************************************************************/
+
+#include <locale.h>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QLocale>
+#include <QStringList>
+#include <QTextStream>
+
+#include <rblib.h>
+
+#include "bench_problem.h"
+#include "bench_runner.h"
+
+static std::vector<uint> parseUIntList(const QString &text, const QString &option)
+{
+    std::vector<uint> values;
+    QStringList items = text.split(',',Qt::SkipEmptyParts);
+    for (int i=0;i<items.size();i++)
+    {
+        bool ok = false;
+        uint value = items[i].trimmed().toUInt(&ok);
+        if (!ok)
+        {
+            throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Invalid value \'%s\' of option \'%s\'.",items[i].toUtf8().constData(),option.toUtf8().constData());
+        }
+        values.push_back(value);
+    }
+    return values;
+}
+
+static int run(void)
+{
+    QList<RArgumentOption> validOptions;
+    validOptions.append(RArgumentOption("problems",RArgumentOption::String,QVariant("poisson,elasticity"),"Generated problems (poisson, elasticity)",false,false));
+    validOptions.append(RArgumentOption("sizes",RArgumentOption::String,QVariant("10,20,30"),"Number of cells along edge of generated meshes",false,false));
+    validOptions.append(RArgumentOption("matrix",RArgumentOption::String,QVariant(),"Recorded matrices in MatrixMarket format (comma separated)",false,false));
+    validOptions.append(RArgumentOption("system",RArgumentOption::String,QVariant(),"Matrix systems dumped by solver (comma separated)",false,false));
+    validOptions.append(RArgumentOption("block-size",RArgumentOption::Integer,QVariant(1),"Block size of recorded matrices",false,false));
+    validOptions.append(RArgumentOption("nthreads",RArgumentOption::String,QVariant("1"),"Thread counts to measure (comma separated)",false,false));
+    validOptions.append(RArgumentOption("repeat",RArgumentOption::Integer,QVariant(10),"Number of repetitions of kernel benchmarks",false,false));
+    validOptions.append(RArgumentOption("preconditioners",RArgumentOption::String,QVariant("jacobi,block-jacobi,ic,ilu,amg"),"Preconditioners (none, jacobi, block-jacobi, ic, ilu, amg, ilut)",false,false));
+    validOptions.append(RArgumentOption("solvers",RArgumentOption::String,QVariant("cg,gmres"),"Matrix solvers (cg, pipecg, gmres, direct)",false,false));
+    validOptions.append(RArgumentOption("tolerance",RArgumentOption::Real,QVariant(1.0e-10),"Solver convergence value",false,false));
+    validOptions.append(RArgumentOption("max-iterations",RArgumentOption::Integer,QVariant(10000),"Maximum number of solver iterations",false,false));
+    validOptions.append(RArgumentOption("output",RArgumentOption::Path,QVariant(),"Results file (CSV), standard output if not set",false,false));
+    validOptions.append(RArgumentOption("log-file",RArgumentOption::Path,QVariant(),"Log file name",false,false));
+
+    RArgumentsParser argumentsParser(QCoreApplication::arguments(),validOptions,false);
+
+    if (argumentsParser.isSet("help"))
+    {
+        argumentsParser.printHelp();
+        return 0;
+    }
+    if (argumentsParser.isSet("version"))
+    {
+        argumentsParser.printVersion();
+        return 0;
+    }
+    if (argumentsParser.isSet("log-file"))
+    {
+        RLogger::getInstance().setFile(argumentsParser.getValue("log-file").toString());
+    }
+
+    BenchRunner runner;
+
+    if (argumentsParser.isSet("nthreads"))
+    {
+        runner.setNThreads(parseUIntList(argumentsParser.getValue("nthreads").toString(),"nthreads"));
+    }
+    if (argumentsParser.isSet("repeat"))
+    {
+        runner.setNRepeats(argumentsParser.getValue("repeat").toUInt());
+    }
+    if (argumentsParser.isSet("tolerance"))
+    {
+        runner.setSolverCvgValue(argumentsParser.getValue("tolerance").toDouble());
+    }
+    if (argumentsParser.isSet("max-iterations"))
+    {
+        runner.setNSolverIterations(argumentsParser.getValue("max-iterations").toUInt());
+    }
+    if (argumentsParser.isSet("preconditioners"))
+    {
+        std::vector<RMatrixPreconditionerType> preconditioners;
+        QStringList items = argumentsParser.getValue("preconditioners").toString().split(',',Qt::SkipEmptyParts);
+        for (int i=0;i<items.size();i++)
+        {
+            RMatrixPreconditionerType preconditionerType = BenchRunner::getPreconditionerTypeFromId(items[i].trimmed());
+            if (preconditionerType == R_MATRIX_PRECONDITIONER_N_TYPES)
+            {
+                throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Unknown preconditioner \'%s\'.",items[i].toUtf8().constData());
+            }
+            preconditioners.push_back(preconditionerType);
+        }
+        runner.setPreconditioners(preconditioners);
+    }
+    if (argumentsParser.isSet("solvers"))
+    {
+        std::vector<QString> solvers;
+        QStringList items = argumentsParser.getValue("solvers").toString().split(',',Qt::SkipEmptyParts);
+        for (int i=0;i<items.size();i++)
+        {
+            QString solver = items[i].trimmed();
+            if (solver != "cg" && solver != "pipecg" && solver != "gmres" && solver != "direct")
+            {
+                throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Unknown matrix solver \'%s\'.",solver.toUtf8().constData());
+            }
+            solvers.push_back(solver);
+        }
+        runner.setSolvers(solvers);
+    }
+
+    // Generated problems are skipped if only recorded matrices are requested.
+    if (argumentsParser.isSet("problems") || (!argumentsParser.isSet("matrix") && !argumentsParser.isSet("system")))
+    {
+        QString problems = argumentsParser.isSet("problems") ? argumentsParser.getValue("problems").toString() : QString("poisson,elasticity");
+        QString sizes = argumentsParser.isSet("sizes") ? argumentsParser.getValue("sizes").toString() : QString("10,20,30");
+
+        QStringList problemIds = problems.split(',',Qt::SkipEmptyParts);
+        std::vector<uint> meshSizes = parseUIntList(sizes,"sizes");
+
+        for (int i=0;i<problemIds.size();i++)
+        {
+            BenchProblem::Type type = BenchProblem::getTypeFromId(problemIds[i].trimmed());
+            if (type != BenchProblem::Poisson && type != BenchProblem::Elasticity)
+            {
+                throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Unknown problem \'%s\'.",problemIds[i].toUtf8().constData());
+            }
+            for (uint j=0;j<meshSizes.size();j++)
+            {
+                BenchProblem problem;
+                problem.generate(type,meshSizes[j]);
+                runner.run(problem);
+            }
+        }
+    }
+
+    if (argumentsParser.isSet("matrix"))
+    {
+        uint blockSize = argumentsParser.isSet("block-size") ? argumentsParser.getValue("block-size").toUInt() : 1;
+        QStringList fileNames = argumentsParser.getValue("matrix").toString().split(',',Qt::SkipEmptyParts);
+        for (int i=0;i<fileNames.size();i++)
+        {
+            BenchProblem problem;
+            problem.readMatrixMarket(fileNames[i].trimmed(),blockSize);
+            runner.run(problem);
+        }
+    }
+
+    if (argumentsParser.isSet("system"))
+    {
+        // Without explicit choice the solver and preconditioner the system was recorded with are replayed.
+        bool replaySolver = !argumentsParser.isSet("solvers");
+        bool replayPreconditioner = !argumentsParser.isSet("preconditioners");
+        std::vector<QString> solvers(runner.getSolvers());
+        std::vector<RMatrixPreconditionerType> preconditioners(runner.getPreconditioners());
+
+        QStringList fileNames = argumentsParser.getValue("system").toString().split(',',Qt::SkipEmptyParts);
+        for (int i=0;i<fileNames.size();i++)
+        {
+            BenchProblem problem;
+            problem.readMatrixSystem(fileNames[i].trimmed());
+            if (replaySolver)
+            {
+                const RMatrixSolverConf &recordedSolverConf = problem.getRecordedSolverConf();
+                QString solver("cg");
+                if (recordedSolverConf.getDirectSolver())
+                {
+                    solver = "direct";
+                }
+                else if (recordedSolverConf.getType() == RMatrixSolverConf::GMRES)
+                {
+                    solver = "gmres";
+                }
+                else if (recordedSolverConf.getPipelined())
+                {
+                    solver = "pipecg";
+                }
+                runner.setSolvers(std::vector<QString>(1,solver));
+            }
+            if (replayPreconditioner)
+            {
+                runner.setPreconditioners(std::vector<RMatrixPreconditionerType>(1,problem.getRecordedPreconditionerType()));
+            }
+            runner.run(problem);
+            runner.setSolvers(solvers);
+            runner.setPreconditioners(preconditioners);
+        }
+    }
+
+    if (argumentsParser.isSet("output"))
+    {
+        QString fileName = argumentsParser.getValue("output").toString();
+        QFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open file \'%s\'.",fileName.toUtf8().constData());
+        }
+        QTextStream out(&file);
+        runner.writeCsv(out);
+        file.close();
+        RLogger::info("Results written to file \'%s\'.\n",fileName.toUtf8().constData());
+    }
+    else
+    {
+        QTextStream out(stdout);
+        runner.writeCsv(out);
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+
+    // Needed for printf functions family to work correctly.
+    setlocale(LC_ALL,"C");
+    QLocale::setDefault(QLocale::c());
+
+    RArgumentsParser::printHeader("Benchmark");
+
+    int exitValue = 0;
+    try
+    {
+        exitValue = run();
+    }
+    catch (const RError &error)
+    {
+        RLogger::error("Benchmark failed. %s\n",error.getMessage().toUtf8().constData());
+        exitValue = 1;
+    }
+
+    RArgumentsParser::printFooter();
+    return exitValue;
+} /* main */
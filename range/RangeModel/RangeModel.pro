@@ -24,7 +24,7 @@ DEFINES += RANGEMODEL_LIBRARY
 
 DEFINES += "FILE_MAJOR_VERSION=1"
 DEFINES += "FILE_MINOR_VERSION=1"
-DEFINES += "FILE_RELEASE_VERSION=0"
+DEFINES += "FILE_RELEASE_VERSION=7"
 
 INCLUDEPATH += include
 
@@ -35,6 +35,7 @@ SOURCES += \
     src/rml_cut.cpp \
     src/rml_eigen_value_solver_conf.cpp \
     src/rml_element.cpp \
+    src/rml_element_geometry_cache.cpp \
     src/rml_element_group.cpp \
     src/rml_element_shape_derivation.cpp \
     src/rml_element_shape_function.cpp \
@@ -56,9 +57,11 @@ SOURCES += \
     src/rml_material_list.cpp \
     src/rml_material_property.cpp \
     src/rml_matrix_solver_conf.cpp \
+    src/rml_matrix_system.cpp \
     src/rml_mesh_generator.cpp \
     src/rml_mesh_input.cpp \
     src/rml_mesh_setup.cpp \
+    src/rml_mesh_view.cpp \
     src/rml_modal_setup.cpp \
     src/rml_model.cpp \
     src/rml_model_data.cpp \
@@ -83,6 +86,8 @@ SOURCES += \
     src/rml_segment.cpp \
     src/rml_shape_generator.cpp \
     src/rml_sparse_matrix.cpp \
+    src/rml_sparse_matrix_bsr.cpp \
+    src/rml_sparse_matrix_csr.cpp \
     src/rml_stream_line.cpp \
     src/rml_surface.cpp \
     src/rml_tetgen.cpp \
@@ -105,7 +110,9 @@ HEADERS += \
     include/rml_cut.h \
     include/rml_eigen_value_solver_conf.h \
     include/rml_element.h \
+    include/rml_element_geometry_cache.h \
     include/rml_element_group.h \
+    include/rml_element_kernel.h \
     include/rml_element_shape_derivation.h \
     include/rml_element_shape_function.h \
     include/rml_entity_group.h \
@@ -126,9 +133,11 @@ HEADERS += \
     include/rml_material_list.h \
     include/rml_material_property.h \
     include/rml_matrix_solver_conf.h \
+    include/rml_matrix_system.h \
     include/rml_mesh_generator.h \
     include/rml_mesh_input.h \
     include/rml_mesh_setup.h \
+    include/rml_mesh_view.h \
     include/rml_modal_setup.h \
     include/rml_model.h \
     include/rml_model_data.h \
@@ -154,6 +163,8 @@ HEADERS += \
     include/rml_segment.h \
     include/rml_shape_generator.h \
     include/rml_sparse_matrix.h \
+    include/rml_sparse_matrix_bsr.h \
+    include/rml_sparse_matrix_csr.h \
     include/rml_sparse_vector.h \
     include/rml_stream_line.h \
     include/rml_surface.h \
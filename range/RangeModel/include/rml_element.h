@@ -235,6 +235,21 @@ class RElement
                              RRMatrix &J,
                              RRMatrix &Rt ) const;
 
+        //! Calculate shape function derivatives with respect to local element
+        //! coordinates (global for volume elements) and jacobian determinant.
+        //! Fixed-size element kernels are used so no memory is allocated.
+        //! B - shape function derivatives (nNodes x nDimensions)
+        //! R - rotation matrix from local to global coordinates (3 x 3).
+        double findShapeDerivatives( const std::vector <RNode> &nodes,
+                                     unsigned int iPoint,
+                                     RRSmallMatrix &B,
+                                     RRSmallMatrix &R ) const;
+
+        //! Calculate shape function derivatives and jacobian determinant.
+        double findShapeDerivatives( const std::vector <RNode> &nodes,
+                                     unsigned int iPoint,
+                                     RRSmallMatrix &B ) const;
+
         //! Find out on which side and where is given vector intersecting the element.
         unsigned int findIntersectedSide( const std::vector <RNode> &nodes,
                                           const RR3Vector &position,
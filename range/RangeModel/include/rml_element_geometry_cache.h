@@ -0,0 +1,107 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_element_geometry_cache.h                             *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Element geometry cache class declaration            *
+ *********************************************************************/
+
+#ifndef RML_ELEMENT_GEOMETRY_CACHE_H
+#define RML_ELEMENT_GEOMETRY_CACHE_H
+
+#include <vector>
+
+#include "rml_element.h"
+
+/*
+ * Cache of jacobian determinants, shape function derivatives and local
+ * rotation matrices for all elements of a mesh. Cache is tagged with
+ * a fingerprint of node coordinates and element connectivity and is
+ * rebuilt only if the mesh differs from the one it was built for.
+ * Elements with constant derivatives store only one integration point.
+ */
+
+class RElementGeometryCache
+{
+
+    protected:
+
+        //! Indicator whether cache holds valid data.
+        bool valid;
+        //! Mesh fingerprint for which cache was built.
+        quint64 meshHash;
+        //! Number of times cache has been built.
+        uint nBuilds;
+        //! Element types.
+        std::vector<RElementType> elementTypes;
+        //! Offset of each element data in values array (nElements + 1).
+        std::vector<quint64> offsets;
+        //! Cached values.
+        //! For each element: rotation matrix (3x3, line and surface elements only) followed by
+        //! jacobian determinant and shape derivatives (nNodes x nDimensions) for each stored integration point.
+        std::vector<double> values;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RElementGeometryCache *pElementGeometryCache = nullptr);
+
+    public:
+
+        //! Constructor.
+        RElementGeometryCache();
+
+        //! Copy constructor.
+        RElementGeometryCache(const RElementGeometryCache &elementGeometryCache);
+
+        //! Destructor.
+        ~RElementGeometryCache();
+
+        //! Assignment operator.
+        RElementGeometryCache & operator =(const RElementGeometryCache &elementGeometryCache);
+
+        //! Return true if cache is valid for given mesh.
+        bool isValid(const std::vector<RNode> &nodes, const std::vector<RElement> &elements) const;
+
+        //! Rebuild cache if it is not valid for given mesh.
+        //! Return true if cache was rebuilt.
+        bool update(const std::vector<RNode> &nodes, const std::vector<RElement> &elements);
+
+        //! Invalidate cache and release memory.
+        void invalidate(void);
+
+        //! Return number of times cache has been built.
+        uint getNBuilds(void) const;
+
+        //! Return jacobian determinant for given element and integration point.
+        double getJacobian(uint elementID, uint iPoint) const;
+
+        //! Return pointer to shape function derivatives (row-major nNodes x nDimensions)
+        //! for given element and integration point.
+        const double *getDerivative(uint elementID, uint iPoint) const;
+
+        //! Copy shape function derivatives into B and return jacobian determinant.
+        double findShapeDerivatives(uint elementID, uint iPoint, RRSmallMatrix &B) const;
+
+        //! Copy rotation matrix from local to global coordinates into R.
+        void findRotation(uint elementID, RRSmallMatrix &R) const;
+
+        //! Find mesh fingerprint.
+        static quint64 findMeshHash(const std::vector<RNode> &nodes, const std::vector<RElement> &elements);
+
+    protected:
+
+        //! Return number of stored integration points for given element type.
+        static uint getNStoredPoints(RElementType type);
+
+        //! Return number of local dimensions for given element type.
+        static uint getNDimensions(RElementType type);
+
+        //! Return true if rotation matrix is stored for given element type.
+        static bool hasRotation(RElementType type);
+
+};
+
+#endif // RML_ELEMENT_GEOMETRY_CACHE_H
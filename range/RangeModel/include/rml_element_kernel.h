@@ -0,0 +1,420 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_element_kernel.h                                     *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Fixed-size element kernel declaration               *
+ *********************************************************************/
+
+#ifndef RML_ELEMENT_KERNEL_H
+#define RML_ELEMENT_KERNEL_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "rml_element.h"
+
+/*
+ * Element kernels are specialized for each element type at compile time.
+ * Node coordinates, Jacobian and its inverse are held in fixed-size arrays
+ * on stack and all loops have constant bounds so that they can be unrolled.
+ * Kernels reproduce RElement::findJacobian without any heap allocation.
+ */
+
+//! Element type traits.
+template <RElementType type> struct RElementTraits;
+
+template <> struct RElementTraits<R_ELEMENT_TRUSS1>
+{
+    static const uint nNodes = 2;
+    static const uint nDimensions = 1;
+    static const uint nIntegrationPoints = 2;
+};
+
+template <> struct RElementTraits<R_ELEMENT_TRI1>
+{
+    static const uint nNodes = 3;
+    static const uint nDimensions = 2;
+    static const uint nIntegrationPoints = 3;
+};
+
+template <> struct RElementTraits<R_ELEMENT_QUAD1>
+{
+    static const uint nNodes = 4;
+    static const uint nDimensions = 2;
+    static const uint nIntegrationPoints = 4;
+};
+
+template <> struct RElementTraits<R_ELEMENT_TETRA1>
+{
+    static const uint nNodes = 4;
+    static const uint nDimensions = 3;
+    static const uint nIntegrationPoints = 4;
+};
+
+//! Element geometry in local coordinates.
+//! Lines are rotated into X axis, surfaces into XY plane.
+template <uint nNodes, uint nDimensions> struct RElementKernelGeometry;
+
+template <uint nNodes> struct RElementKernelGeometry<nNodes,1>
+{
+    //! Find local node coordinates and rotation matrix (columns are local axes).
+    static void findLocalNodes(const RElement &element, const std::vector<RNode> &nodes, double lNodes[nNodes][1], double R[3][3])
+    {
+        const RNode &node0 = nodes[element.getNodeId(0)];
+        const RNode &node1 = nodes[element.getNodeId(1)];
+
+        // Same local system as RR3Vector::findRotationMatrix.
+        double lx[3] = { node1.getX() - node0.getX(),
+                         node1.getY() - node0.getY(),
+                         node1.getZ() - node0.getZ() };
+        double ll = std::sqrt(lx[0]*lx[0] + lx[1]*lx[1] + lx[2]*lx[2]);
+        if (ll > 0.0)
+        {
+            lx[0] /= ll;
+            lx[1] /= ll;
+            lx[2] /= ll;
+        }
+
+        double ly[3] = { 1.0, 0.0, 0.0 };
+        if (ll > 0.0 && std::fabs(std::acos(std::min(std::max(lx[0],-1.0),1.0))) < RConstants::pi/10.0)
+        {
+            ly[0] = 0.0;
+            ly[1] = 1.0;
+        }
+
+        double lz[3] = { lx[1]*ly[2] - lx[2]*ly[1],
+                         lx[2]*ly[0] - lx[0]*ly[2],
+                         lx[0]*ly[1] - lx[1]*ly[0] };
+        double lzl = std::sqrt(lz[0]*lz[0] + lz[1]*lz[1] + lz[2]*lz[2]);
+        if (lzl < RConstants::eps)
+        {
+            lz[0] = 0.0;
+            lz[1] = 0.0;
+            lz[2] = 1.0;
+        }
+        else
+        {
+            lz[0] /= lzl;
+            lz[1] /= lzl;
+            lz[2] /= lzl;
+        }
+
+        ly[0] = lz[1]*lx[2] - lz[2]*lx[1];
+        ly[1] = lz[2]*lx[0] - lz[0]*lx[2];
+        ly[2] = lz[0]*lx[1] - lz[1]*lx[0];
+        double lyl = std::sqrt(ly[0]*ly[0] + ly[1]*ly[1] + ly[2]*ly[2]);
+        if (lyl > 0.0)
+        {
+            ly[0] /= lyl;
+            ly[1] /= lyl;
+            ly[2] /= lyl;
+        }
+
+        for (uint i=0;i<3;i++)
+        {
+            R[i][0] = lx[i];
+            R[i][1] = ly[i];
+            R[i][2] = lz[i];
+        }
+
+        for (uint i=0;i<nNodes;i++)
+        {
+            const RNode &node = nodes[element.getNodeId(i)];
+            lNodes[i][0] = lx[0]*(node.getX() - node0.getX())
+                         + lx[1]*(node.getY() - node0.getY())
+                         + lx[2]*(node.getZ() - node0.getZ());
+        }
+    }
+
+    //! Invert Jacobian and return its determinant.
+    static double invert(const double J[1][1], double Ji[1][1])
+    {
+        Ji[0][0] = (std::abs(J[0][0]) > RConstants::eps) ? 1.0 / J[0][0] : J[0][0];
+        return J[0][0];
+    }
+};
+
+template <uint nNodes> struct RElementKernelGeometry<nNodes,2>
+{
+    //! Find local node coordinates and rotation matrix (columns are local axes).
+    static void findLocalNodes(const RElement &element, const std::vector<RNode> &nodes, double lNodes[nNodes][2], double R[3][3])
+    {
+        const RNode &node0 = nodes[element.getNodeId(0)];
+        const RNode &node1 = nodes[element.getNodeId(1)];
+        const RNode &node2 = nodes[element.getNodeId(2)];
+
+        // Same local system as RTriangle::findRotationMatrix.
+        double lx[3] = { node1.getX() - node0.getX(),
+                         node1.getY() - node0.getY(),
+                         node1.getZ() - node0.getZ() };
+        double ly[3] = { node2.getX() - node0.getX(),
+                         node2.getY() - node0.getY(),
+                         node2.getZ() - node0.getZ() };
+        double lz[3] = { lx[1]*ly[2] - lx[2]*ly[1],
+                         lx[2]*ly[0] - lx[0]*ly[2],
+                         lx[0]*ly[1] - lx[1]*ly[0] };
+
+        double lxl = std::sqrt(lx[0]*lx[0] + lx[1]*lx[1] + lx[2]*lx[2]);
+        double lzl = std::sqrt(lz[0]*lz[0] + lz[1]*lz[1] + lz[2]*lz[2]);
+        for (uint i=0;i<3;i++)
+        {
+            if (lxl > 0.0)
+            {
+                lx[i] /= lxl;
+            }
+            if (lzl > 0.0)
+            {
+                lz[i] /= lzl;
+            }
+        }
+
+        ly[0] = lz[1]*lx[2] - lz[2]*lx[1];
+        ly[1] = lz[2]*lx[0] - lz[0]*lx[2];
+        ly[2] = lz[0]*lx[1] - lz[1]*lx[0];
+        double lyl = std::sqrt(ly[0]*ly[0] + ly[1]*ly[1] + ly[2]*ly[2]);
+        if (lyl > 0.0)
+        {
+            ly[0] /= lyl;
+            ly[1] /= lyl;
+            ly[2] /= lyl;
+        }
+
+        for (uint i=0;i<3;i++)
+        {
+            R[i][0] = lx[i];
+            R[i][1] = ly[i];
+            R[i][2] = lz[i];
+        }
+
+        for (uint i=0;i<nNodes;i++)
+        {
+            const RNode &node = nodes[element.getNodeId(i)];
+            double x = node.getX() - node0.getX();
+            double y = node.getY() - node0.getY();
+            double z = node.getZ() - node0.getZ();
+            lNodes[i][0] = lx[0]*x + lx[1]*y + lx[2]*z;
+            lNodes[i][1] = ly[0]*x + ly[1]*y + ly[2]*z;
+        }
+    }
+
+    //! Invert Jacobian and return its determinant.
+    static double invert(const double J[2][2], double Ji[2][2])
+    {
+        double detJ = J[0][0]*J[1][1] - J[0][1]*J[1][0];
+        if (detJ == 0.0)
+        {
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Can not invert matrix. Matrix determinant = 0");
+        }
+        Ji[0][0] =  J[1][1] / detJ;
+        Ji[0][1] = -J[0][1] / detJ;
+        Ji[1][0] = -J[1][0] / detJ;
+        Ji[1][1] =  J[0][0] / detJ;
+        return detJ;
+    }
+};
+
+template <uint nNodes> struct RElementKernelGeometry<nNodes,3>
+{
+    //! Find local node coordinates and rotation matrix (identity).
+    static void findLocalNodes(const RElement &element, const std::vector<RNode> &nodes, double lNodes[nNodes][3], double R[3][3])
+    {
+        for (uint i=0;i<3;i++)
+        {
+            R[i][0] = R[i][1] = R[i][2] = 0.0;
+            R[i][i] = 1.0;
+        }
+        for (uint i=0;i<nNodes;i++)
+        {
+            const RNode &node = nodes[element.getNodeId(i)];
+            lNodes[i][0] = node.getX();
+            lNodes[i][1] = node.getY();
+            lNodes[i][2] = node.getZ();
+        }
+    }
+
+    //! Invert Jacobian and return its determinant.
+    static double invert(const double J[3][3], double Ji[3][3])
+    {
+        double c00 = J[1][1]*J[2][2] - J[1][2]*J[2][1];
+        double c01 = J[1][2]*J[2][0] - J[1][0]*J[2][2];
+        double c02 = J[1][0]*J[2][1] - J[1][1]*J[2][0];
+
+        double detJ = J[0][0]*c00 + J[0][1]*c01 + J[0][2]*c02;
+        if (detJ == 0.0)
+        {
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Can not invert matrix. Singular matrix.");
+        }
+
+        Ji[0][0] = c00 / detJ;
+        Ji[0][1] = (J[0][2]*J[2][1] - J[0][1]*J[2][2]) / detJ;
+        Ji[0][2] = (J[0][1]*J[1][2] - J[0][2]*J[1][1]) / detJ;
+        Ji[1][0] = c01 / detJ;
+        Ji[1][1] = (J[0][0]*J[2][2] - J[0][2]*J[2][0]) / detJ;
+        Ji[1][2] = (J[0][2]*J[1][0] - J[0][0]*J[1][2]) / detJ;
+        Ji[2][0] = c02 / detJ;
+        Ji[2][1] = (J[0][1]*J[2][0] - J[0][0]*J[2][1]) / detJ;
+        Ji[2][2] = (J[0][0]*J[1][1] - J[0][1]*J[1][0]) / detJ;
+        return detJ;
+    }
+};
+
+//! Fixed-size element kernel.
+template <RElementType type>
+class RElementKernel
+{
+
+    public:
+
+        //! Number of nodes.
+        static const uint nNodes = RElementTraits<type>::nNodes;
+        //! Number of local dimensions.
+        static const uint nDimensions = RElementTraits<type>::nDimensions;
+        //! Number of integration points.
+        static const uint nIntegrationPoints = RElementTraits<type>::nIntegrationPoints;
+
+        typedef RElementKernelGeometry<nNodes,nDimensions> Geometry;
+
+    protected:
+
+        //! Shape function values copied from RElement into contiguous arrays.
+        struct ShapeTable
+        {
+            double N[nIntegrationPoints][nNodes];
+            double dN[nIntegrationPoints][nNodes][nDimensions];
+            double w[nIntegrationPoints];
+
+            ShapeTable()
+            {
+                R_ERROR_ASSERT(RElement::getNNodes(type) == nNodes);
+                R_ERROR_ASSERT(RElement::getNIntegrationPoints(type) == nIntegrationPoints);
+
+                for (uint k=0;k<nIntegrationPoints;k++)
+                {
+                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(type,k);
+                    for (uint m=0;m<nNodes;m++)
+                    {
+                        this->N[k][m] = shapeFunc.getN()[m];
+                        for (uint c=0;c<nDimensions;c++)
+                        {
+                            this->dN[k][m][c] = shapeFunc.getDN()[m][c];
+                        }
+                    }
+                    this->w[k] = shapeFunc.getW();
+                }
+            }
+        };
+
+        //! Return shape function table.
+        static const ShapeTable &getShapeTable(void)
+        {
+            static const ShapeTable table;
+            return table;
+        }
+
+    public:
+
+        //! Return pointer to shape function values at given integration point.
+        static const double * getN(uint iPoint)
+        {
+            return RElementKernel<type>::getShapeTable().N[iPoint];
+        }
+
+        //! Return weight factor at given integration point.
+        static double getW(uint iPoint)
+        {
+            return RElementKernel<type>::getShapeTable().w[iPoint];
+        }
+
+        //! Find local node coordinates and rotation matrix.
+        static void findLocalNodes(const RElement &element, const std::vector<RNode> &nodes, double lNodes[nNodes][nDimensions], double R[3][3])
+        {
+            Geometry::findLocalNodes(element,nodes,lNodes,R);
+        }
+
+        //! Find inverse Jacobian at given integration point.
+        //! Return Jacobian determinant.
+        static double findJacobian(const double lNodes[nNodes][nDimensions], uint iPoint, double Ji[nDimensions][nDimensions])
+        {
+            R_ERROR_ASSERT(iPoint < nIntegrationPoints);
+
+            const double (&dN)[nNodes][nDimensions] = RElementKernel<type>::getShapeTable().dN[iPoint];
+
+            double J[nDimensions][nDimensions];
+            for (uint i=0;i<nDimensions;i++)
+            {
+                for (uint j=0;j<nDimensions;j++)
+                {
+                    double value = 0.0;
+                    for (uint k=0;k<nNodes;k++)
+                    {
+                        value += dN[k][i]*lNodes[k][j];
+                    }
+                    J[i][j] = value;
+                }
+            }
+            return Geometry::invert(J,Ji);
+        }
+
+        //! Find shape function derivatives with respect to local element coordinates
+        //! (global coordinates for volume elements) at given integration point.
+        //! Return Jacobian determinant.
+        static double findShapeDerivatives(const double lNodes[nNodes][nDimensions], uint iPoint, double B[nNodes][nDimensions])
+        {
+            double Ji[nDimensions][nDimensions];
+            double detJ = RElementKernel<type>::findJacobian(lNodes,iPoint,Ji);
+
+            const double (&dN)[nNodes][nDimensions] = RElementKernel<type>::getShapeTable().dN[iPoint];
+
+            for (uint m=0;m<nNodes;m++)
+            {
+                for (uint c=0;c<nDimensions;c++)
+                {
+                    double value = 0.0;
+                    for (uint k=0;k<nDimensions;k++)
+                    {
+                        value += dN[m][k]*Ji[c][k];
+                    }
+                    B[m][c] = value;
+                }
+            }
+            return detJ;
+        }
+
+        //! Find shape function derivatives at given integration point and store them in small matrix.
+        //! B is resized to nNodes x nDimensions and R to 3 x 3.
+        //! Return Jacobian determinant.
+        static double findShapeDerivatives(const RElement &element, const std::vector<RNode> &nodes, uint iPoint, RRSmallMatrix &B, RRSmallMatrix &R)
+        {
+            double lNodes[nNodes][nDimensions];
+            double lR[3][3];
+            double lB[nNodes][nDimensions];
+
+            Geometry::findLocalNodes(element,nodes,lNodes,lR);
+            double detJ = RElementKernel<type>::findShapeDerivatives(lNodes,iPoint,lB);
+
+            B.resize(nNodes,nDimensions);
+            for (uint m=0;m<nNodes;m++)
+            {
+                for (uint c=0;c<nDimensions;c++)
+                {
+                    B[m][c] = lB[m][c];
+                }
+            }
+            R.resize(3,3);
+            for (uint i=0;i<3;i++)
+            {
+                for (uint j=0;j<3;j++)
+                {
+                    R[i][j] = lR[i][j];
+                }
+            }
+            return detJ;
+        }
+
+};
+
+#endif // RML_ELEMENT_KERNEL_H
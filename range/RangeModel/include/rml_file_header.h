@@ -21,6 +21,7 @@ typedef enum _RFileType
     R_FILE_TYPE_VIEW_FACTOR_MATRIX,
     R_FILE_TYPE_DISPLAY_PROPERTIES,
     R_FILE_TYPE_LINK,
+    R_FILE_TYPE_MATRIX_SYSTEM,
     R_FILE_N_TYPES
 } RFileType;
 
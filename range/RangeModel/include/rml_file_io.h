@@ -44,6 +44,7 @@
 #include "rml_patch_input.h"
 #include "rml_point.h"
 #include "rml_problem_task_item.h"
+#include "rml_sparse_matrix_csr.h"
 #include "rml_sparse_vector.h"
 #include "rml_stream_line.h"
 #include "rml_surface.h"
@@ -136,6 +137,17 @@ class RFileIO
         //! Write qsizetype value.
         static void writeBinary(RSaveFile &outFile, const qsizetype &sValue);
 
+        // quint64
+
+        //! Read quint64 value.
+        static void readAscii(RFile &inFile, quint64 &uValue);
+        //! Read quint64 value.
+        static void readBinary(RFile &inFile, quint64 &uValue);
+        //! Write quint64 value.
+        static void writeAscii(RSaveFile &outFile, const quint64 &uValue, bool addNewLine = true);
+        //! Write quint64 value.
+        static void writeBinary(RSaveFile &outFile, const quint64 &uValue);
+
         // QString
 
         //! Read string value.
@@ -738,6 +750,17 @@ class RFileIO
         //! Write RMatrixSolverConf.
         static void writeBinary(RSaveFile &outFile, const RMatrixSolverConf &matrixSolver);
 
+        // RSparseMatrixCSR
+
+        //! Read RSparseMatrixCSR.
+        static void readAscii(RFile &inFile, RSparseMatrixCSR &sparseMatrix);
+        //! Read RSparseMatrixCSR.
+        static void readBinary(RFile &inFile, RSparseMatrixCSR &sparseMatrix);
+        //! Write RSparseMatrixCSR.
+        static void writeAscii(RSaveFile &outFile, const RSparseMatrixCSR &sparseMatrix);
+        //! Write RSparseMatrixCSR.
+        static void writeBinary(RSaveFile &outFile, const RSparseMatrixCSR &sparseMatrix);
+
         // RMonitoringPoint
 
         //! Read RMonitoringPoint.
@@ -805,6 +828,17 @@ class RFileIO
         //! Write RRadiationResolution.
         static void writeBinary(RSaveFile &outFile, const RRadiationResolution &radiationResolution);
 
+        // RViewFactorMethod
+
+        //! Read RViewFactorMethod.
+        static void readAscii(RFile &inFile, RViewFactorMethod &viewFactorMethod);
+        //! Read RViewFactorMethod.
+        static void readBinary(RFile &inFile, RViewFactorMethod &viewFactorMethod);
+        //! Write RViewFactorMethod.
+        static void writeAscii(RSaveFile &outFile, const RViewFactorMethod &viewFactorMethod, bool addNewLine = true);
+        //! Write RViewFactorMethod.
+        static void writeBinary(RSaveFile &outFile, const RViewFactorMethod &viewFactorMethod);
+
         // RRadiationSetup
 
         //! Read RRadiationSetup.
@@ -13,9 +13,49 @@
 
 #include <QString>
 
+#define R_MATRIX_PRECONDITIONER_TYPE_IS_VALID(_type) \
+( \
+    ( \
+        _type >= R_MATRIX_PRECONDITIONER_NONE && \
+        _type < R_MATRIX_PRECONDITIONER_N_TYPES \
+    ) \
+)
+
+#define R_NODE_ORDERING_TYPE_IS_VALID(_type) \
+( \
+    ( \
+        _type >= R_NODE_ORDERING_NONE && \
+        _type < R_NODE_ORDERING_N_TYPES \
+    ) \
+)
+
 //! Matrix solver type.
 typedef int RMatrixSolverType;
 
+//! Matrix preconditioner type.
+typedef enum _RMatrixPreconditionerType
+{
+    R_MATRIX_PRECONDITIONER_NONE = 0,
+    R_MATRIX_PRECONDITIONER_JACOBI,
+    R_MATRIX_PRECONDITIONER_BLOCK_JACOBI,
+    R_MATRIX_PRECONDITIONER_INCOMPLETE_CHOLESKY,
+    R_MATRIX_PRECONDITIONER_INCOMPLETE_LU,
+    R_MATRIX_PRECONDITIONER_ALGEBRAIC_MULTIGRID,
+    R_MATRIX_PRECONDITIONER_INCOMPLETE_LU_THRESHOLD,
+//    R_MATRIX_PRECONDITIONER_SSOR,
+//    R_MATRIX_PRECONDITIONER_DILU,
+    R_MATRIX_PRECONDITIONER_N_TYPES
+} RMatrixPreconditionerType;
+
+//! Node (unknown) ordering type.
+typedef enum _RNodeOrderingType
+{
+    R_NODE_ORDERING_NONE = 0,
+    R_NODE_ORDERING_REVERSE_CUTHILL_MCKEE,
+    R_NODE_ORDERING_NESTED_DISSECTION,
+    R_NODE_ORDERING_N_TYPES
+} RNodeOrderingType;
+
 //! Matrix solver class.
 class RMatrixSolverConf
 {
@@ -42,9 +82,23 @@ class RMatrixSolverConf
         double solverCvgValue;
         //! Output frequency.
         unsigned int outputFrequency;
+        //! Preconditioner type.
+        RMatrixPreconditionerType preconditionerType;
+        //! Use sparse direct solver instead of iterative solver.
+        bool directSolver;
+        //! Use pipelined variant of iterative solver (single fused reduction per iteration).
+        bool pipelined;
+        //! Store matrix and preconditioner in single precision and refine solution in double precision.
+        bool mixedPrecision;
         // FOLOWING MEMBERS ARE NOT SAVED TO FILE
         //! Output file name.
         QString outputFileName;
+        //! Matrix system dump file name (system is not dumped if empty).
+        QString systemFileName;
+        //! Solve matrix system without assembled matrix.
+        bool matrixFree;
+        //! Ordering of nodes used when numbering unknowns.
+        RNodeOrderingType nodeOrdering;
 
     private:
 
@@ -95,12 +149,58 @@ class RMatrixSolverConf
         //! Set output frequency.
         void setOutputFrequency ( unsigned int outputFrequency );
 
+        //! Return preconditioner type.
+        RMatrixPreconditionerType getPreconditionerType ( void ) const;
+
+        //! Set preconditioner type.
+        void setPreconditionerType ( RMatrixPreconditionerType preconditionerType );
+
+        //! Return true if sparse direct solver is used.
+        bool getDirectSolver ( void ) const;
+
+        //! Set whether sparse direct solver is used.
+        void setDirectSolver ( bool directSolver );
+
+        //! Return true if pipelined variant of iterative solver is used.
+        bool getPipelined ( void ) const;
+
+        //! Set whether pipelined variant of iterative solver is used.
+        //! Only conjugate gradient solver has pipelined variant.
+        void setPipelined ( bool pipelined );
+
+        //! Return true if mixed precision iterative refinement is used.
+        bool getMixedPrecision ( void ) const;
+
+        //! Set whether mixed precision iterative refinement is used.
+        void setMixedPrecision ( bool mixedPrecision );
+
         //! Return output file name.
         const QString & getOutputFileName ( void ) const;
 
         //! Set output file name.
         void setOutputFileName ( const QString &outputFileName );
 
+        //! Return matrix system dump file name.
+        const QString & getSystemFileName ( void ) const;
+
+        //! Set matrix system dump file name.
+        //! If set each solved system is written to the file before it is solved.
+        void setSystemFileName ( const QString &systemFileName );
+
+        //! Return true if matrix system is solved without assembled matrix.
+        bool getMatrixFree ( void ) const;
+
+        //! Set whether matrix system is solved without assembled matrix.
+        //! Only solvers supporting element matrix operator take this into account.
+        void setMatrixFree ( bool matrixFree );
+
+        //! Return node ordering type.
+        RNodeOrderingType getNodeOrdering ( void ) const;
+
+        //! Set node ordering type.
+        //! Nodes are renumbered before unknowns are assigned to reduce matrix bandwidth or fill.
+        void setNodeOrdering ( RNodeOrderingType nodeOrdering );
+
         //! Allow RFileIO to access private members.
         friend class RFileIO;
 
@@ -109,6 +209,19 @@ class RMatrixSolverConf
 
         //! Return solver id.
         static const QString & getId ( RMatrixSolverType type );
+
+        //! Return preconditioner name.
+        static const QString & getPreconditionerName ( RMatrixPreconditionerType preconditionerType );
+
+        //! Return node ordering name.
+        static const QString & getNodeOrderingName ( RNodeOrderingType nodeOrdering );
+
+        //! Return node ordering id.
+        static const QString & getNodeOrderingId ( RNodeOrderingType nodeOrdering );
+
+        //! Return node ordering type for given id.
+        //! If id is not valid R_NODE_ORDERING_N_TYPES is returned.
+        static RNodeOrderingType findNodeOrdering ( const QString &nodeOrderingId );
 };
 
 #endif /* RML_MATRIX_SOLVER_H */
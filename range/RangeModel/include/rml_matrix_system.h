@@ -0,0 +1,155 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_matrix_system.h                                      *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Matrix system class declaration                     *
+ *********************************************************************/
+
+#ifndef RML_MATRIX_SYSTEM_H
+#define RML_MATRIX_SYSTEM_H
+
+#include <vector>
+
+#include <rblib.h>
+
+#include "rml_matrix_solver_conf.h"
+#include "rml_sparse_matrix_csr.h"
+
+/*
+ * Matrix system A*x = b together with the solver setup it was solved with.
+ * Systems are dumped from real runs so that solvers and preconditioners
+ * can be tuned offline without re-running the whole simulation.
+ */
+
+class RMatrixSystem
+{
+
+    protected:
+
+        //! Matrix solver configuration.
+        RMatrixSolverConf matrixSolverConf;
+        //! Preconditioner type.
+        RMatrixPreconditionerType preconditionerType;
+        //! Number of unknowns per node.
+        uint blockSize;
+        //! System matrix.
+        RSparseMatrixCSR A;
+        //! Right hand side vector.
+        RRVector b;
+        //! Initial guess.
+        RRVector x;
+        //! Block (node) index of each matrix row.
+        std::vector<uint> rowBlockIndexes;
+        //! Near null space (rigid body modes).
+        std::vector<RRVector> nearNullSpace;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RMatrixSystem *pMatrixSystem = nullptr);
+
+    public:
+
+        //! Constructor.
+        RMatrixSystem();
+
+        //! Copy constructor.
+        RMatrixSystem(const RMatrixSystem &matrixSystem);
+
+        //! Destructor.
+        ~RMatrixSystem();
+
+        //! Assignment operator.
+        RMatrixSystem &operator =(const RMatrixSystem &matrixSystem);
+
+        //! Return matrix solver configuration.
+        const RMatrixSolverConf &getMatrixSolverConf(void) const;
+
+        //! Set matrix solver configuration.
+        void setMatrixSolverConf(const RMatrixSolverConf &matrixSolverConf);
+
+        //! Return preconditioner type.
+        RMatrixPreconditionerType getPreconditionerType(void) const;
+
+        //! Set preconditioner type.
+        void setPreconditionerType(RMatrixPreconditionerType preconditionerType);
+
+        //! Return number of unknowns per node.
+        uint getBlockSize(void) const;
+
+        //! Set number of unknowns per node.
+        void setBlockSize(uint blockSize);
+
+        //! Return system matrix.
+        const RSparseMatrixCSR &getMatrix(void) const;
+
+        //! Set system matrix.
+        void setMatrix(const RSparseMatrixCSR &A);
+
+        //! Return right hand side vector.
+        const RRVector &getRhs(void) const;
+
+        //! Set right hand side vector.
+        void setRhs(const RRVector &b);
+
+        //! Return initial guess.
+        const RRVector &getInitialGuess(void) const;
+
+        //! Set initial guess.
+        void setInitialGuess(const RRVector &x);
+
+        //! Return block (node) index of each matrix row.
+        const std::vector<uint> &getRowBlockIndexes(void) const;
+
+        //! Set block (node) index of each matrix row.
+        void setRowBlockIndexes(const std::vector<uint> &rowBlockIndexes);
+
+        //! Return near null space.
+        const std::vector<RRVector> &getNearNullSpace(void) const;
+
+        //! Set near null space.
+        void setNearNullSpace(const std::vector<RRVector> &nearNullSpace);
+
+        //! Clear matrix system.
+        void clear(void);
+
+        //! Read from file.
+        void read(const QString &fileName);
+
+        //! Write to file.
+        //! If MatrixMarket extension is used matrix is written to given file and right hand side vector to file with "rhs" suffix.
+        void write(const QString &fileName) const;
+
+        //! Return default file extension.
+        static QString getDefaultFileExtension(bool binary = true);
+
+        //! Return MatrixMarket file extension.
+        static QString getMatrixMarketFileExtension(void);
+
+        //! Write matrix in MatrixMarket coordinate format.
+        //! Matrix is written as square matrix with number of columns equal to number of rows.
+        static void writeMatrixMarket(const QString &fileName, const RSparseMatrixCSR &A);
+
+        //! Write vector in MatrixMarket array format.
+        static void writeMatrixMarket(const QString &fileName, const RRVector &v);
+
+    protected:
+
+        //! Read from the ASCII file.
+        void readAscii(const QString &fileName);
+
+        //! Read from the binary file.
+        void readBinary(const QString &fileName);
+
+        //! Write to the ASCII file.
+        void writeAscii(const QString &fileName) const;
+
+        //! Write to the binary file.
+        void writeBinary(const QString &fileName) const;
+
+};
+
+#endif // RML_MATRIX_SYSTEM_H
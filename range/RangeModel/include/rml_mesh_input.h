@@ -44,6 +44,8 @@ class RMeshInput
         bool surfaceIntegrityCheck;
         //! Keep results after mesh generation is done.
         bool keepResults;
+        //! Reorder nodes and elements along space filling curve after mesh generation is done.
+        bool reorderMesh;
 
         //! Use provided TetGen mesh input line directly.
         bool useTetGenInputParams;
@@ -141,6 +143,12 @@ class RMeshInput
         //! Set whether results should be kept.
         void setKeepResults(bool keepResults);
 
+        //! Return whether mesh should be reordered after generation.
+        bool getReorderMesh(void) const;
+
+        //! Set whether mesh should be reordered after generation.
+        void setReorderMesh(bool reorderMesh);
+
         //! Return whether to use TetGen input parameters directly.
         bool getUseTetGenInputParams(void) const;
 
@@ -0,0 +1,151 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_mesh_view.h                                          *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Mesh view class declaration                         *
+ *********************************************************************/
+
+#ifndef RML_MESH_VIEW_H
+#define RML_MESH_VIEW_H
+
+#include <vector>
+
+#include "rml_element.h"
+
+/*
+ * Read-only compact copy of the mesh for solver loops. Node coordinates
+ * are stored in separate x, y and z arrays, element connectivity and
+ * node to element adjacency in compressed (CSR) arrays. View is tagged
+ * with a fingerprint of the mesh and is rebuilt only if the mesh differs
+ * from the one it was built for.
+ */
+
+class RMeshView
+{
+
+    protected:
+
+        //! Indicator whether view holds valid data.
+        bool valid;
+        //! Mesh fingerprint for which view was built.
+        quint64 meshHash;
+        //! Number of times view has been built.
+        uint nBuilds;
+        //! Node x coordinates.
+        std::vector<double> x;
+        //! Node y coordinates.
+        std::vector<double> y;
+        //! Node z coordinates.
+        std::vector<double> z;
+        //! Element types.
+        std::vector<RElementType> elementTypes;
+        //! Offset of each element in element nodes array (nElements + 1).
+        std::vector<uint> elementNodePointers;
+        //! Element node IDs.
+        std::vector<uint> elementNodes;
+        //! Offset of each node in node elements array (nNodes + 1).
+        std::vector<uint> nodeElementPointers;
+        //! Element IDs of each node (sorted in ascending order).
+        std::vector<uint> nodeElements;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RMeshView *pMeshView = nullptr);
+
+    public:
+
+        //! Constructor.
+        RMeshView();
+
+        //! Copy constructor.
+        RMeshView(const RMeshView &meshView);
+
+        //! Destructor.
+        ~RMeshView();
+
+        //! Assignment operator.
+        RMeshView & operator =(const RMeshView &meshView);
+
+        //! Return true if view is valid for given mesh.
+        bool isValid(const std::vector<RNode> &nodes, const std::vector<RElement> &elements) const;
+
+        //! Rebuild view if it is not valid for given mesh.
+        //! Return true if view was rebuilt.
+        bool update(const std::vector<RNode> &nodes, const std::vector<RElement> &elements);
+
+        //! Invalidate view and release memory.
+        void invalidate(void);
+
+        //! Return number of times view has been built.
+        uint getNBuilds(void) const;
+
+        //! Return number of nodes.
+        inline uint getNNodes(void) const
+        {
+            return uint(this->x.size());
+        }
+
+        //! Return number of elements.
+        inline uint getNElements(void) const
+        {
+            return uint(this->elementTypes.size());
+        }
+
+        //! Return pointer to node x coordinates.
+        inline const double *getX(void) const
+        {
+            return this->x.data();
+        }
+
+        //! Return pointer to node y coordinates.
+        inline const double *getY(void) const
+        {
+            return this->y.data();
+        }
+
+        //! Return pointer to node z coordinates.
+        inline const double *getZ(void) const
+        {
+            return this->z.data();
+        }
+
+        //! Return element type.
+        inline RElementType getElementType(uint elementID) const
+        {
+            return this->elementTypes[elementID];
+        }
+
+        //! Return number of element nodes.
+        inline uint getNElementNodes(uint elementID) const
+        {
+            return this->elementNodePointers[elementID+1] - this->elementNodePointers[elementID];
+        }
+
+        //! Return pointer to element node IDs.
+        inline const uint *getElementNodes(uint elementID) const
+        {
+            return this->elementNodes.data() + this->elementNodePointers[elementID];
+        }
+
+        //! Return number of elements connected to given node.
+        inline uint getNNodeElements(uint nodeID) const
+        {
+            return this->nodeElementPointers[nodeID+1] - this->nodeElementPointers[nodeID];
+        }
+
+        //! Return pointer to IDs of elements connected to given node.
+        inline const uint *getNodeElements(uint nodeID) const
+        {
+            return this->nodeElements.data() + this->nodeElementPointers[nodeID];
+        }
+
+        //! Return memory size in bytes.
+        quint64 getMemorySize(void) const;
+
+};
+
+#endif // RML_MESH_VIEW_H
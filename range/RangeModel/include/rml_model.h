@@ -309,6 +309,11 @@ class RModel : public RProblem, public RResults
         //! Purge unused elements.
         uint purgeUnusedElements();
 
+        //! Reorder nodes and elements along space filling curve to improve memory locality.
+        //! Elements stay grouped by element group. Element groups, results, neighbors and
+        //! dependent entities are remapped accordingly.
+        void reorderMesh(RSpaceFillingCurve::Type type = RSpaceFillingCurve::Hilbert);
+
         /*************************************************************
          * Interpolated element interface                            *
          *************************************************************/
@@ -866,6 +871,10 @@ class RModel : public RProblem, public RResults
         //! Generate patch input vector.
         void generatePatchInputVector(std::vector<RPatchInput> &patchInput) const;
 
+        //! Generate patch geometry hashes.
+        //! Hash depends on patch element IDs, types, node IDs and node coordinates.
+        void generatePatchHashes(const RPatchBook &book, std::vector<quint64> &patchHashes) const;
+
         //! Find patch center.
         void findPatchCenter(const RPatch &rPatch, double &cx, double &cy, double &cz) const;
 
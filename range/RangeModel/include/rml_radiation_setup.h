@@ -20,6 +20,18 @@ typedef enum RRadiationResolution
     R_RADIATION_RESOLUTION_HIGH   = 300
 } RRadiationResolution;
 
+#define R_VIEW_FACTOR_METHOD_TYPE_IS_VALID(_type) \
+( \
+    _type >= R_VIEW_FACTOR_METHOD_HEMICUBE && _type < R_VIEW_FACTOR_METHOD_N_TYPES \
+)
+
+typedef enum _RViewFactorMethod
+{
+    R_VIEW_FACTOR_METHOD_HEMICUBE = 0,
+    R_VIEW_FACTOR_METHOD_MONTE_CARLO,
+    R_VIEW_FACTOR_METHOD_N_TYPES
+} RViewFactorMethod;
+
 class RRadiationSetup
 {
 
@@ -27,8 +39,14 @@ class RRadiationSetup
 
         //! Radiation view factor resolution.
         RRadiationResolution resolution;
+        //! View-factor calculation method.
+        RViewFactorMethod viewFactorMethod;
         //! View-factor matrix file.
         QString viewFactorMatrixFile;
+        //! Enforce reciprocity and closure of calculated view-factors.
+        bool viewFactorCorrection;
+        //! View-factors below this threshold are dropped.
+        double viewFactorThreshold;
 
     private:
 
@@ -55,18 +73,39 @@ class RRadiationSetup
         //! Set resolution.
         void setResolution(const RRadiationResolution &value);
 
+        //! Return view-factor calculation method.
+        RViewFactorMethod getViewFactorMethod(void) const;
+
+        //! Set view-factor calculation method.
+        void setViewFactorMethod(RViewFactorMethod viewFactorMethod);
+
         //! Return view-factor matrix file.
         const QString &getViewFactorMatrixFile(void) const;
 
         //! Set view-factor matrix file.
         void setViewFactorMatrixFile(const QString &viewFactorMatrixFile);
 
+        //! Return true if view-factor reciprocity and closure should be enforced.
+        bool getViewFactorCorrection(void) const;
+
+        //! Set whether view-factor reciprocity and closure should be enforced.
+        void setViewFactorCorrection(bool viewFactorCorrection);
+
+        //! Return view-factor threshold.
+        double getViewFactorThreshold(void) const;
+
+        //! Set view-factor threshold.
+        void setViewFactorThreshold(double viewFactorThreshold);
+
         //! Find most recent view factor matrix file.
         static QString findRecentViewFactorMatrixFile(const QString &viewFactorMatrixFile, uint timeStep = 0);
 
         //! Get radiation resolution text representation.
         static QString getResolutionText(RRadiationResolution resolution);
 
+        //! Get view-factor method text representation.
+        static const QString &getViewFactorMethodText(RViewFactorMethod viewFactorMethod);
+
         //! Convert to printable string.
         QString toString() const;
 
@@ -122,6 +122,14 @@ class RResults
         //! If elementBook[i] == RConstants::eod then element will be removed.
         void removeElements(const std::vector<uint>&elementBook);
 
+        //! Move node values to new positions.
+        //! Node at position i is moved to position nodeBook[i].
+        void reorderNodes(const std::vector<uint> &nodeBook);
+
+        //! Move element values to new positions.
+        //! Element at position i is moved to position elementBook[i].
+        void reorderElements(const std::vector<uint> &elementBook);
+
 };
 
 #endif /* RML_RESULTS_H */
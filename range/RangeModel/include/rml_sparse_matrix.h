@@ -81,6 +81,9 @@ class RSparseMatrix
         //! Clear all values.
         void clear(void);
 
+        //! Set all values to zero while keeping the sparsity pattern.
+        void clearValues(void);
+
         //! Find column position.
         bool findColumnPosition(uint rowIndex, uint columnIndex, uint &rowPosition) const;
 
@@ -0,0 +1,133 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_sparse_matrix_bsr.h                                  *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Block sparse row matrix class declaration           *
+ *********************************************************************/
+
+#ifndef RML_SPARSE_MATRIX_BSR_H
+#define RML_SPARSE_MATRIX_BSR_H
+
+#include <vector>
+
+#include <rblib.h>
+
+#include "rml_sparse_matrix_csr.h"
+
+/*
+ * Matrix rows are grouped into blocks of blockSize rows (typically all
+ * degrees of freedom of one node). Each nonzero block is stored as a dense
+ * blockSize x blockSize row-major array and only one column index is stored
+ * per block.
+ *
+ * Rows do not have to fill whole blocks (e.g. node with constrained
+ * displacement component). Missing rows and columns are stored as zeros and
+ * are skipped when result is written, so vectors always have original size.
+ * If rows of every block are consecutive, blocks of vector x are read
+ * directly (missing trailing columns are multiplied by stored zeros).
+ */
+
+class RSparseMatrixBSR
+{
+
+    protected:
+
+        //! Block size.
+        uint blockSize;
+        //! Number of rows of original matrix.
+        uint nRows;
+        //! Position of first block in each block row (size = nBlockRows + 1).
+        std::vector<uint> blockRowPointers;
+        //! Block column index of each block.
+        std::vector<uint> blockColumnIndexes;
+        //! Block values (blockSize*blockSize values per block in row-major order).
+        std::vector<double> values;
+        //! Original row of each block row component (RConstants::eod if component is missing).
+        std::vector<uint> rowPositions;
+        //! Original column of each block column component (missing component points to existing column of the same block).
+        std::vector<uint> columnPositions;
+        //! Rows of each block are consecutive, so block of vector x can be read directly.
+        bool contiguous;
+        //! Position in block values of each value of matrix from which block matrix was built.
+        std::vector<size_t> valuePositions;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RSparseMatrixBSR *pMatrix = nullptr);
+
+    public:
+
+        //! Constructor.
+        RSparseMatrixBSR();
+
+        //! Construct from compressed sparse row matrix.
+        RSparseMatrixBSR(const RSparseMatrixCSR &matrix, uint blockSize, const std::vector<uint> &rowBlockIndexes = std::vector<uint>());
+
+        //! Copy constructor.
+        RSparseMatrixBSR(const RSparseMatrixBSR &matrix);
+
+        //! Destructor.
+        ~RSparseMatrixBSR();
+
+        //! Assignment operator.
+        RSparseMatrixBSR & operator =(const RSparseMatrixBSR &matrix);
+
+        //! Build from square compressed sparse row matrix.
+        //! rowBlockIndexes assigns each row to a block, if empty consecutive groups of blockSize rows are used.
+        void build(const RSparseMatrixCSR &matrix, uint blockSize, const std::vector<uint> &rowBlockIndexes = std::vector<uint>());
+
+        //! Copy values of matrix with the same sparsity pattern as matrix from which block matrix was built.
+        //! Block structure is reused, no blocks are added or removed.
+        void updateValues(const RSparseMatrixCSR &matrix);
+
+        //! Return block size.
+        inline uint getBlockSize(void) const
+        {
+            return this->blockSize;
+        }
+
+        //! Return number of rows of original matrix.
+        inline uint getNRows(void) const
+        {
+            return this->nRows;
+        }
+
+        //! Return number of block rows.
+        inline uint getNBlockRows(void) const
+        {
+            return uint(this->blockRowPointers.empty() ? 0 : this->blockRowPointers.size() - 1);
+        }
+
+        //! Return number of stored blocks.
+        inline uint getNBlocks(void) const
+        {
+            return uint(this->blockColumnIndexes.size());
+        }
+
+        //! Find block diagonal matrix with inverted diagonal blocks.
+        //! Missing components are replaced by identity, singular blocks are replaced by inverted diagonal.
+        void findInverseBlockDiagonal(RSparseMatrixBSR &inverseBlockDiagonal) const;
+
+        //! Clear matrix.
+        void clear(void);
+
+        //! Matrix vector multiplication - y=A*x.
+        //! When called from inside of an OpenMP parallel region block rows are distributed among threads.
+        static void mlt(const RSparseMatrixBSR &A, const RRVector &x, RRVector &y);
+
+    protected:
+
+        //! Matrix vector multiplication kernel for fixed block size and contiguous blocks.
+        template <uint size>
+        static void mltFixed(const RSparseMatrixBSR &A, const RRVector &x, RRVector &y);
+
+        //! Matrix vector multiplication kernel for any block size and block layout.
+        static void mltGeneric(const RSparseMatrixBSR &A, const RRVector &x, RRVector &y);
+
+};
+
+#endif // RML_SPARSE_MATRIX_BSR_H
@@ -0,0 +1,173 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_sparse_matrix_csr.h                                  *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Compressed sparse row matrix class declaration      *
+ *********************************************************************/
+
+#ifndef RML_SPARSE_MATRIX_CSR_H
+#define RML_SPARSE_MATRIX_CSR_H
+
+#include <vector>
+
+#include <rblib.h>
+
+#include "rml_sparse_matrix.h"
+
+/*
+ * Following matrix:
+ *
+ * [ 1.0 , 0.0 , 2.0 ]
+ * [ 0.0 , 3.0 , 0.0 ]
+ * [ 4.0 , 0.0 , 5.0 ]
+ *
+ * will be stored as:
+ *
+ * rowPointers    = [ 0 , 2 , 3 , 5 ]
+ * columnIndexes  = [ 0 , 2 , 1 , 0 , 2 ]
+ * values         = [ 1.0 , 2.0 , 3.0 , 4.0 , 5.0 ]
+ *
+ * Column indexes within each row are sorted in ascending order.
+ */
+
+class RSparseMatrixCSR
+{
+
+    protected:
+
+        //! Position of first value in each row (size = nRows + 1).
+        std::vector<uint> rowPointers;
+        //! Column index of each value.
+        std::vector<uint> columnIndexes;
+        //! Values.
+        std::vector<double> values;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RSparseMatrixCSR *pMatrix = nullptr);
+
+    public:
+
+        //! Constructor.
+        RSparseMatrixCSR();
+
+        //! Construct from sparse matrix.
+        explicit RSparseMatrixCSR(const RSparseMatrix &matrix);
+
+        //! Copy constructor.
+        RSparseMatrixCSR(const RSparseMatrixCSR &matrix);
+
+        //! Destructor.
+        ~RSparseMatrixCSR();
+
+        //! Assignment operator.
+        RSparseMatrixCSR & operator =(const RSparseMatrixCSR &matrix);
+
+        //! Freeze sparse matrix into compressed form.
+        void build(const RSparseMatrix &matrix);
+
+        //! Build from already compressed arrays.
+        //! Column indexes within each row must be sorted in ascending order.
+        void build(const std::vector<uint> &rowPointers, const std::vector<uint> &columnIndexes, const std::vector<double> &values);
+
+        //! Return number of rows.
+        inline uint getNRows(void) const
+        {
+            return uint(this->rowPointers.empty() ? 0 : this->rowPointers.size() - 1);
+        }
+
+        //! Return number of columns (maximum column index + 1).
+        uint findNColumns(void) const;
+
+        //! Return number of stored values.
+        inline uint getNValues(void) const
+        {
+            return uint(this->values.size());
+        }
+
+        //! Return position of first value in given row.
+        inline uint getRowBegin(uint rowIndex) const
+        {
+            return this->rowPointers[rowIndex];
+        }
+
+        //! Return position past the last value in given row.
+        inline uint getRowEnd(uint rowIndex) const
+        {
+            return this->rowPointers[rowIndex+1];
+        }
+
+        //! Return column index at given value position.
+        inline uint getColumnIndex(uint position) const
+        {
+            return this->columnIndexes[position];
+        }
+
+        //! Return value at given value position.
+        inline double getValue(uint position) const
+        {
+            return this->values[position];
+        }
+
+        //! Return reference to value at given value position.
+        inline double & getValue(uint position)
+        {
+            return this->values[position];
+        }
+
+        //! Return dot product of given row and vector x.
+        inline double mltRow(uint rowIndex, const RRVector &x) const
+        {
+            double value = 0.0;
+            const uint *pIndex = this->columnIndexes.data();
+            const double *pValue = this->values.data();
+            const double *pX = x.data();
+            for (uint k=this->rowPointers[rowIndex];k<this->rowPointers[rowIndex+1];k++)
+            {
+                value += pValue[k] * pX[pIndex[k]];
+            }
+            return value;
+        }
+
+        //! Return const reference to row pointers.
+        const std::vector<uint> & getRowPointers(void) const;
+
+        //! Return const reference to column indexes.
+        const std::vector<uint> & getColumnIndexes(void) const;
+
+        //! Return const reference to values.
+        const std::vector<double> & getValues(void) const;
+
+        //! Find value position for given row and column index.
+        bool findPosition(uint rowIndex, uint columnIndex, uint &position) const;
+
+        //! Find value at given row and column index. If value is not found 0.0 is returned.
+        double findValue(uint rowIndex, uint columnIndex) const;
+
+        //! Return vector of diagonal values.
+        RRVector getDiagonal(void) const;
+
+        //! Return euclidean norm of the matrix (same definition as RSparseMatrix::findNorm).
+        double findNorm(void) const;
+
+        //! Clear matrix.
+        void clear(void);
+
+        //! Matrix vector multiplication - y=A*x.
+        //! When called from inside of an OpenMP parallel region rows are distributed among threads.
+        static void mlt(const RSparseMatrixCSR &A, const RRVector &x, RRVector &y);
+
+        //! Matrix matrix multiplication - C=A*B.
+        static void mlt(const RSparseMatrixCSR &A, const RSparseMatrixCSR &B, RSparseMatrixCSR &C);
+
+        //! Matrix transposition - At=A^T.
+        //! Number of columns of A is given explicitly because trailing empty columns are not stored.
+        static void transpose(const RSparseMatrixCSR &A, uint nColumns, RSparseMatrixCSR &At);
+
+};
+
+#endif // RML_SPARSE_MATRIX_CSR_H
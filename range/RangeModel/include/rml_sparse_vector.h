@@ -12,6 +12,7 @@
 #define RML_SPARSE_VECTOR_H
 
 #include <QtGlobal>
+#include <algorithm>
 #include <vector>
 
 /*
@@ -141,6 +142,21 @@ class RSparseVector
             return idxList;
         }
 
+        //! Find position of given index.
+        //! Return false if index is not present.
+        bool findPosition(uint index, uint &position) const
+        {
+            typename std::vector< RSparseVectorItem<T> >::const_iterator iter;
+
+            iter = std::lower_bound(this->data.begin(),this->data.end(),RSparseVectorItem<T>(index,T()));
+            if (iter == this->data.end() || iter->index != index)
+            {
+                return false;
+            }
+            position = uint(iter - this->data.begin());
+            return true;
+        }
+
         //! Add value.
         //! If value with given index already exist value will be added to its current value.
         void addValue(uint index, T value)
@@ -148,11 +164,10 @@ class RSparseVector
             typename std::vector< RSparseVectorItem<T> >::iterator iter;
             RSparseVectorItem<T> match(index,value);
 
-            iter = std::find(this->data.begin(),this->data.end(),match);
-            if (iter == this->data.end())
+            iter = std::lower_bound(this->data.begin(),this->data.end(),match);
+            if (iter == this->data.end() || iter->index != index)
             {
-                this->data.push_back(RSparseVectorItem<T>(index,value));
-                std::sort(this->data.begin(),this->data.end());
+                this->data.insert(iter,match);
             }
             else
             {
@@ -160,6 +175,18 @@ class RSparseVector
             }
         }
 
+        //! Set vector of indexes (sparsity pattern) with all values set to zero.
+        //! Indexes must be sorted in ascending order and unique.
+        void setIndexes(const std::vector<uint> &indexes)
+        {
+            this->data.clear();
+            this->data.reserve(indexes.size());
+            for (uint i=0;i<indexes.size();i++)
+            {
+                this->data.push_back(RSparseVectorItem<T>(indexes[i],T()));
+            }
+        }
+
         //! Return real sized vector of values.
         //! nElements difines minimum size of the vector.
         std::vector<T> getValues(uint nElements) const
@@ -200,6 +227,15 @@ class RSparseVector
             this->data.clear();
         }
 
+        //! Set all values to zero while keeping the indexes.
+        void clearValues(void)
+        {
+            for (uint i=0;i<this->data.size();i++)
+            {
+                this->data[i].value = T();
+            }
+        }
+
 };
 
 #endif // RML_SPARSE_VECTOR_H
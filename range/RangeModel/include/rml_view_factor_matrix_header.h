@@ -13,7 +13,10 @@
 
 #include <vector>
 
+#include <QtGlobal>
+
 #include "rml_patch_input.h"
+#include "rml_radiation_setup.h"
 
 class RViewFactorMatrixHeader
 {
@@ -24,8 +27,16 @@ class RViewFactorMatrixHeader
         std::vector<RPatchInput> patchInput;
         //! Hemicube resolution.
         unsigned int hemicubeResolution;
+        //! View-factor calculation method.
+        RViewFactorMethod viewFactorMethod;
+        //! Enforce view-factor reciprocity and closure.
+        bool viewFactorCorrection;
+        //! View-factor threshold.
+        double viewFactorThreshold;
         //! Number of elements.
         unsigned int nElements;
+        //! Patch geometry hashes (one per patch).
+        std::vector<quint64> patchHashes;
 
     private:
 
@@ -67,12 +78,36 @@ class RViewFactorMatrixHeader
         //! Set hemicube resolution.
         void setHemicubeResolution(unsigned int hemicubeResolution);
 
+        //! Return view-factor calculation method.
+        RViewFactorMethod getViewFactorMethod(void) const;
+
+        //! Set view-factor calculation method.
+        void setViewFactorMethod(RViewFactorMethod viewFactorMethod);
+
+        //! Return whether view-factor reciprocity and closure is enforced.
+        bool getViewFactorCorrection(void) const;
+
+        //! Set whether view-factor reciprocity and closure is enforced.
+        void setViewFactorCorrection(bool viewFactorCorrection);
+
+        //! Return view-factor threshold.
+        double getViewFactorThreshold(void) const;
+
+        //! Set view-factor threshold.
+        void setViewFactorThreshold(double viewFactorThreshold);
+
         //! Return number of elements.
         unsigned int getNElements(void) const;
 
         //! Set number of elements.
         void setNElements(unsigned int nElements);
 
+        //! Return const reference to patch geometry hashes.
+        const std::vector<quint64> &getPatchHashes(void) const;
+
+        //! Return reference to patch geometry hashes.
+        std::vector<quint64> &getPatchHashes(void);
+
         //! Clear header.
         void clear(void);
 
@@ -17,7 +17,9 @@
 #include "rml_cut.h"
 #include "rml_eigen_value_solver_conf.h"
 #include "rml_element.h"
+#include "rml_element_geometry_cache.h"
 #include "rml_element_group.h"
+#include "rml_element_kernel.h"
 #include "rml_entity_group_data.h"
 #include "rml_element_shape_derivation.h"
 #include "rml_element_shape_function.h"
@@ -36,9 +38,11 @@
 #include "rml_material_list.h"
 #include "rml_material_property.h"
 #include "rml_matrix_solver_conf.h"
+#include "rml_matrix_system.h"
 #include "rml_mesh_generator.h"
 #include "rml_mesh_input.h"
 #include "rml_mesh_setup.h"
+#include "rml_mesh_view.h"
 #include "rml_modal_setup.h"
 #include "rml_model_data.h"
 #include "rml_model.h"
@@ -63,6 +67,8 @@
 #include "rml_segment.h"
 #include "rml_shape_generator.h"
 #include "rml_sparse_matrix.h"
+#include "rml_sparse_matrix_bsr.h"
+#include "rml_sparse_matrix_csr.h"
 #include "rml_sparse_vector.h"
 #include "rml_stream_line.h"
 #include "rml_surface.h"
@@ -13,6 +13,7 @@
 #include <cmath>
 
 #include "rml_element.h"
+#include "rml_element_kernel.h"
 #include "rml_element_shape_function.h"
 #include "rml_interpolated_element.h"
 #include "rml_triangle.h"
@@ -1341,6 +1342,64 @@ double RElement::findJacobian(const std::vector<RNode> &nodes, unsigned int iPoi
 } /* RElement::findJacobian */
 
 
+double RElement::findShapeDerivatives(const std::vector<RNode> &nodes, unsigned int iPoint, RRSmallMatrix &B, RRSmallMatrix &R) const
+{
+    switch (this->getType())
+    {
+        case R_ELEMENT_TRUSS1:
+            return RElementKernel<R_ELEMENT_TRUSS1>::findShapeDerivatives(*this,nodes,iPoint,B,R);
+        case R_ELEMENT_TRI1:
+            return RElementKernel<R_ELEMENT_TRI1>::findShapeDerivatives(*this,nodes,iPoint,B,R);
+        case R_ELEMENT_QUAD1:
+            return RElementKernel<R_ELEMENT_QUAD1>::findShapeDerivatives(*this,nodes,iPoint,B,R);
+        case R_ELEMENT_TETRA1:
+            return RElementKernel<R_ELEMENT_TETRA1>::findShapeDerivatives(*this,nodes,iPoint,B,R);
+        default:
+            break;
+    }
+
+    // Generic path for element types without fixed-size kernel.
+    const RRMatrix &dN = RElement::getShapeFunction(this->getType(),iPoint).getDN();
+
+    RRMatrix J, Rt;
+    double detJ = this->findJacobian(nodes,iPoint,J,Rt);
+
+    B.resize(dN.getNRows(),dN.getNColumns());
+    for (uint m=0;m<dN.getNRows();m++)
+    {
+        for (uint c=0;c<dN.getNColumns();c++)
+        {
+            for (uint k=0;k<dN.getNColumns();k++)
+            {
+                B[m][c] += dN[m][k]*J[c][k];
+            }
+        }
+    }
+
+    RRMatrix Rg;
+    RRVector t;
+    this->findTransformationMatrix(nodes,Rg,t);
+
+    R.resize(3,3);
+    for (uint i=0;i<3;i++)
+    {
+        for (uint j=0;j<3;j++)
+        {
+            R[i][j] = Rg[i][j];
+        }
+    }
+
+    return detJ;
+} /* RElement::findShapeDerivatives */
+
+
+double RElement::findShapeDerivatives(const std::vector<RNode> &nodes, unsigned int iPoint, RRSmallMatrix &B) const
+{
+    RRSmallMatrix R;
+    return this->findShapeDerivatives(nodes,iPoint,B,R);
+} /* RElement::findShapeDerivatives */
+
+
 unsigned int RElement::findIntersectedSide(const std::vector<RNode> &nodes,
                                            const RR3Vector &position,
                                            const RR3Vector &direction,
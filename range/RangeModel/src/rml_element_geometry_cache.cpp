@@ -0,0 +1,282 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_element_geometry_cache.cpp                           *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Element geometry cache class definition             *
+ *********************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "rml_element_geometry_cache.h"
+
+static inline void hashValue(quint64 &hash, quint64 value)
+{
+    // FNV-1a applied on 64-bit words.
+    hash ^= value;
+    hash *= Q_UINT64_C(1099511628211);
+}
+
+static inline void hashValue(quint64 &hash, double value)
+{
+    quint64 bits;
+    std::memcpy(&bits,&value,sizeof(bits));
+    hashValue(hash,bits);
+}
+
+void RElementGeometryCache::_init(const RElementGeometryCache *pElementGeometryCache)
+{
+    if (pElementGeometryCache)
+    {
+        this->valid = pElementGeometryCache->valid;
+        this->meshHash = pElementGeometryCache->meshHash;
+        this->nBuilds = pElementGeometryCache->nBuilds;
+        this->elementTypes = pElementGeometryCache->elementTypes;
+        this->offsets = pElementGeometryCache->offsets;
+        this->values = pElementGeometryCache->values;
+    }
+}
+
+RElementGeometryCache::RElementGeometryCache()
+    : valid(false)
+    , meshHash(0)
+    , nBuilds(0)
+{
+    this->_init();
+}
+
+RElementGeometryCache::RElementGeometryCache(const RElementGeometryCache &elementGeometryCache)
+{
+    this->_init(&elementGeometryCache);
+}
+
+RElementGeometryCache::~RElementGeometryCache()
+{
+
+}
+
+RElementGeometryCache &RElementGeometryCache::operator =(const RElementGeometryCache &elementGeometryCache)
+{
+    this->_init(&elementGeometryCache);
+    return (*this);
+}
+
+bool RElementGeometryCache::isValid(const std::vector<RNode> &nodes, const std::vector<RElement> &elements) const
+{
+    if (!this->valid || this->elementTypes.size() != elements.size())
+    {
+        return false;
+    }
+    return (this->meshHash == RElementGeometryCache::findMeshHash(nodes,elements));
+}
+
+bool RElementGeometryCache::update(const std::vector<RNode> &nodes, const std::vector<RElement> &elements)
+{
+    quint64 hash = RElementGeometryCache::findMeshHash(nodes,elements);
+
+    if (this->valid && this->elementTypes.size() == elements.size() && this->meshHash == hash)
+    {
+        return false;
+    }
+
+    uint nElements = uint(elements.size());
+
+    this->elementTypes.resize(nElements);
+    this->offsets.resize(nElements+1);
+    this->offsets[0] = 0;
+
+    for (uint i=0;i<nElements;i++)
+    {
+        RElementType type = elements[i].getType();
+        uint nStoredPoints = RElementGeometryCache::getNStoredPoints(type);
+        quint64 elementSize = 0;
+        if (nStoredPoints > 0)
+        {
+            elementSize = (RElementGeometryCache::hasRotation(type) ? 9 : 0)
+                        + nStoredPoints * (1 + RElement::getNNodes(type) * RElementGeometryCache::getNDimensions(type));
+        }
+        this->elementTypes[i] = type;
+        this->offsets[i+1] = this->offsets[i] + elementSize;
+    }
+
+    this->values.resize(this->offsets[nElements]);
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nElements);i++)
+    {
+        RElementType type = this->elementTypes[i];
+        uint nStoredPoints = RElementGeometryCache::getNStoredPoints(type);
+        if (nStoredPoints == 0)
+        {
+            continue;
+        }
+
+        double *elementValues = this->values.data() + this->offsets[i];
+        uint nValues = RElement::getNNodes(type) * RElementGeometryCache::getNDimensions(type);
+
+        RRSmallMatrix B;
+        RRSmallMatrix R;
+
+        for (uint k=0;k<nStoredPoints;k++)
+        {
+            double *pointValues = elementValues + (RElementGeometryCache::hasRotation(type) ? 9 : 0) + k * (1 + nValues);
+            try
+            {
+                pointValues[0] = elements[i].findShapeDerivatives(nodes,k,B,R);
+                std::copy(B.data(),B.data()+nValues,pointValues+1);
+            }
+            catch (...)
+            {
+                // Degenerated element, error is reported when the element is accessed.
+                pointValues[0] = std::numeric_limits<double>::quiet_NaN();
+                std::fill(pointValues+1,pointValues+1+nValues,0.0);
+                R.resize(3,3);
+            }
+        }
+        if (RElementGeometryCache::hasRotation(type))
+        {
+            std::copy(R.data(),R.data()+9,elementValues);
+        }
+    }
+
+    this->meshHash = hash;
+    this->valid = true;
+    this->nBuilds++;
+
+    return true;
+}
+
+void RElementGeometryCache::invalidate(void)
+{
+    this->valid = false;
+    this->meshHash = 0;
+    this->elementTypes.clear();
+    this->offsets.clear();
+    this->values.clear();
+    this->elementTypes.shrink_to_fit();
+    this->offsets.shrink_to_fit();
+    this->values.shrink_to_fit();
+}
+
+uint RElementGeometryCache::getNBuilds(void) const
+{
+    return this->nBuilds;
+}
+
+double RElementGeometryCache::getJacobian(uint elementID, uint iPoint) const
+{
+    const double *derivative = this->getDerivative(elementID,iPoint);
+    return *(derivative - 1);
+}
+
+const double *RElementGeometryCache::getDerivative(uint elementID, uint iPoint) const
+{
+    R_ERROR_ASSERT(this->valid);
+    R_ERROR_ASSERT(elementID < this->elementTypes.size());
+
+    RElementType type = this->elementTypes[elementID];
+
+    R_ERROR_ASSERT(iPoint < RElement::getNIntegrationPoints(type));
+
+    uint nStoredPoints = RElementGeometryCache::getNStoredPoints(type);
+    uint k = (nStoredPoints == 1) ? 0 : iPoint;
+    uint nValues = RElement::getNNodes(type) * RElementGeometryCache::getNDimensions(type);
+
+    const double *pointValues = this->values.data()
+                              + this->offsets[elementID]
+                              + (RElementGeometryCache::hasRotation(type) ? 9 : 0)
+                              + k * (1 + nValues);
+
+    if (std::isnan(pointValues[0]))
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to compute jacobian of element %u.",elementID);
+    }
+
+    return pointValues + 1;
+}
+
+double RElementGeometryCache::findShapeDerivatives(uint elementID, uint iPoint, RRSmallMatrix &B) const
+{
+    const double *derivative = this->getDerivative(elementID,iPoint);
+
+    RElementType type = this->elementTypes[elementID];
+    uint nNodes = RElement::getNNodes(type);
+    uint nDimensions = RElementGeometryCache::getNDimensions(type);
+
+    B.resize(nNodes,nDimensions);
+    std::copy(derivative,derivative+nNodes*nDimensions,B.data());
+
+    return *(derivative - 1);
+}
+
+void RElementGeometryCache::findRotation(uint elementID, RRSmallMatrix &R) const
+{
+    R_ERROR_ASSERT(this->valid);
+    R_ERROR_ASSERT(elementID < this->elementTypes.size());
+
+    R.resize(3,3);
+
+    RElementType type = this->elementTypes[elementID];
+    if (RElementGeometryCache::hasRotation(type) && RElementGeometryCache::getNStoredPoints(type) > 0)
+    {
+        const double *rotation = this->values.data() + this->offsets[elementID];
+        std::copy(rotation,rotation+9,R.data());
+    }
+    else
+    {
+        R[0][0] = R[1][1] = R[2][2] = 1.0;
+    }
+}
+
+quint64 RElementGeometryCache::findMeshHash(const std::vector<RNode> &nodes, const std::vector<RElement> &elements)
+{
+    quint64 hash = Q_UINT64_C(14695981039346656037);
+
+    hashValue(hash,quint64(nodes.size()));
+    hashValue(hash,quint64(elements.size()));
+
+    for (uint i=0;i<nodes.size();i++)
+    {
+        hashValue(hash,nodes[i].getX());
+        hashValue(hash,nodes[i].getY());
+        hashValue(hash,nodes[i].getZ());
+    }
+    for (uint i=0;i<elements.size();i++)
+    {
+        hashValue(hash,quint64(elements[i].getType()));
+        for (uint j=0;j<elements[i].size();j++)
+        {
+            hashValue(hash,quint64(elements[i].getNodeId(j)));
+        }
+    }
+
+    return hash;
+}
+
+uint RElementGeometryCache::getNStoredPoints(RElementType type)
+{
+    uint nPoints = RElement::getNIntegrationPoints(type);
+    if (nPoints > 0 && RElement::hasConstantDerivative(type))
+    {
+        return 1;
+    }
+    return nPoints;
+}
+
+uint RElementGeometryCache::getNDimensions(RElementType type)
+{
+    if (RElement::getNIntegrationPoints(type) == 0)
+    {
+        return 0;
+    }
+    return RElement::getShapeFunction(type,0).getDN().getNColumns();
+}
+
+bool RElementGeometryCache::hasRotation(RElementType type)
+{
+    return (R_ELEMENT_TYPE_IS_LINE(type) || R_ELEMENT_TYPE_IS_SURFACE(type));
+}
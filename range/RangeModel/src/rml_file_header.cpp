@@ -18,7 +18,8 @@ static const char* fileTypeDesc [] =
     "Material",
     "ViewFactorMatrix",
     "DisplayProperties",
-    "Link"
+    "Link",
+    "MatrixSystem"
 };
 
 void RFileHeader::_init(const RFileHeader *pHeader)
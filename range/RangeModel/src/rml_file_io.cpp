@@ -424,6 +424,58 @@ void RFileIO::writeBinary(RSaveFile &outFile, const qsizetype &sValue)
 } /* RFileIO::writeBinary */
 
 
+/*********************************************************************
+ *  quint64                                                          *
+ *********************************************************************/
+
+
+void RFileIO::readAscii(RFile &inFile, quint64 &uValue)
+{
+    inFile.getTextStream() >> uValue;
+    if (inFile.getTextStream().status() != QTextStream::Ok)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF, "Failed to read quint64 value.");
+    }
+} /* RFileIO::readAscii */
+
+
+void RFileIO::readBinary(RFile &inFile, quint64 &uValue)
+{
+    inFile.read((char*)&uValue,sizeof(quint64));
+    if (inFile.error() != RFile::NoError)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read quint64 value.");
+    }
+} /* RFileIO::readBinary */
+
+
+void RFileIO::writeAscii(RSaveFile &outFile, const quint64 &uValue, bool addNewLine)
+{
+    if (!addNewLine)
+    {
+        outFile.getTextStream() << uValue;
+    }
+    else
+    {
+        outFile.getTextStream() << uValue << RConstants::endl;
+    }
+    if (outFile.getTextStream().status() != QTextStream::Ok)
+    {
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write quint64 value.");
+    }
+} /* RFileIO::writeAscii */
+
+
+void RFileIO::writeBinary(RSaveFile &outFile, const quint64 &uValue)
+{
+    outFile.write((char*)&uValue,sizeof(quint64));
+    if (outFile.error() != RFile::NoError)
+    {
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write quint64 value.");
+    }
+} /* RFileIO::writeBinary */
+
+
 /*********************************************************************
  *  QString                                                          *
  *********************************************************************/
@@ -4005,6 +4057,24 @@ void RFileIO::readAscii(RFile &inFile, RMatrixSolverConf &matrixSolver)
     RFileIO::readAscii(inFile,matrixSolver.nOuterIterations);
     RFileIO::readAscii(inFile,matrixSolver.solverCvgValue);
     RFileIO::readAscii(inFile,matrixSolver.outputFrequency);
+    if (inFile.getVersion() > RVersion(1,1,0))
+    {
+        int preconditionerType = 0;
+        RFileIO::readAscii(inFile,preconditionerType);
+        matrixSolver.preconditionerType = RMatrixPreconditionerType(preconditionerType);
+    }
+    if (inFile.getVersion() > RVersion(1,1,1))
+    {
+        RFileIO::readAscii(inFile,matrixSolver.directSolver);
+    }
+    if (inFile.getVersion() > RVersion(1,1,2))
+    {
+        RFileIO::readAscii(inFile,matrixSolver.pipelined);
+    }
+    if (inFile.getVersion() > RVersion(1,1,3))
+    {
+        RFileIO::readAscii(inFile,matrixSolver.mixedPrecision);
+    }
 } /* RFileIO::readAscii */
 
 
@@ -4015,6 +4085,24 @@ void RFileIO::readBinary(RFile &inFile, RMatrixSolverConf &matrixSolver)
     RFileIO::readBinary(inFile,matrixSolver.nOuterIterations);
     RFileIO::readBinary(inFile,matrixSolver.solverCvgValue);
     RFileIO::readBinary(inFile,matrixSolver.outputFrequency);
+    if (inFile.getVersion() > RVersion(1,1,0))
+    {
+        int preconditionerType = 0;
+        RFileIO::readBinary(inFile,preconditionerType);
+        matrixSolver.preconditionerType = RMatrixPreconditionerType(preconditionerType);
+    }
+    if (inFile.getVersion() > RVersion(1,1,1))
+    {
+        RFileIO::readBinary(inFile,matrixSolver.directSolver);
+    }
+    if (inFile.getVersion() > RVersion(1,1,2))
+    {
+        RFileIO::readBinary(inFile,matrixSolver.pipelined);
+    }
+    if (inFile.getVersion() > RVersion(1,1,3))
+    {
+        RFileIO::readBinary(inFile,matrixSolver.mixedPrecision);
+    }
 } /* RFileIO::readBinary */
 
 
@@ -4041,6 +4129,26 @@ void RFileIO::writeAscii(RSaveFile &outFile, const RMatrixSolverConf &matrixSolv
         RFileIO::writeAscii(outFile,' ',false);
     }
     RFileIO::writeAscii(outFile,matrixSolver.outputFrequency,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,int(matrixSolver.preconditionerType),addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,matrixSolver.directSolver,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,matrixSolver.pipelined,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,matrixSolver.mixedPrecision,addNewLine);
 } /* RFileIO::writeAscii */
 
 
@@ -4051,6 +4159,133 @@ void RFileIO::writeBinary(RSaveFile &outFile, const RMatrixSolverConf &matrixSol
     RFileIO::writeBinary(outFile,matrixSolver.nOuterIterations);
     RFileIO::writeBinary(outFile,matrixSolver.solverCvgValue);
     RFileIO::writeBinary(outFile,matrixSolver.outputFrequency);
+    RFileIO::writeBinary(outFile,int(matrixSolver.preconditionerType));
+    RFileIO::writeBinary(outFile,matrixSolver.directSolver);
+    RFileIO::writeBinary(outFile,matrixSolver.pipelined);
+    RFileIO::writeBinary(outFile,matrixSolver.mixedPrecision);
+} /* RFileIO::writeBinary */
+
+
+/*********************************************************************
+ *  RSparseMatrixCSR                                                 *
+ *********************************************************************/
+
+
+void RFileIO::readAscii(RFile &inFile, RSparseMatrixCSR &sparseMatrix)
+{
+    unsigned int nRows = 0;
+    unsigned int nValues = 0;
+
+    RFileIO::readAscii(inFile,nRows);
+    RFileIO::readAscii(inFile,nValues);
+
+    std::vector<uint> rowPointers(nRows+1);
+    std::vector<uint> columnIndexes(nValues);
+    std::vector<double> values(nValues);
+
+    for (unsigned int i=0;i<=nRows;i++)
+    {
+        RFileIO::readAscii(inFile,rowPointers[i]);
+    }
+    for (unsigned int i=0;i<nValues;i++)
+    {
+        RFileIO::readAscii(inFile,columnIndexes[i]);
+    }
+    for (unsigned int i=0;i<nValues;i++)
+    {
+        RFileIO::readAscii(inFile,values[i]);
+    }
+    if (rowPointers[nRows] != nValues)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read RSparseMatrixCSR value - inconsistent row pointers.");
+    }
+
+    sparseMatrix.build(rowPointers,columnIndexes,values);
+} /* RFileIO::readAscii */
+
+
+void RFileIO::readBinary(RFile &inFile, RSparseMatrixCSR &sparseMatrix)
+{
+    unsigned int nRows = 0;
+    unsigned int nValues = 0;
+
+    RFileIO::readBinary(inFile,nRows);
+    RFileIO::readBinary(inFile,nValues);
+
+    std::vector<uint> rowPointers(nRows+1);
+    std::vector<uint> columnIndexes(nValues);
+    std::vector<double> values(nValues);
+
+    // Arrays are read at once, matrices dumped from large models have hundreds of millions of values.
+    inFile.read((char*)rowPointers.data(),qint64(rowPointers.size()*sizeof(uint)));
+    inFile.read((char*)columnIndexes.data(),qint64(columnIndexes.size()*sizeof(uint)));
+    inFile.read((char*)values.data(),qint64(values.size()*sizeof(double)));
+    if (inFile.error() != RFile::NoError || rowPointers[nRows] != nValues)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read RSparseMatrixCSR value.");
+    }
+
+    sparseMatrix.build(rowPointers,columnIndexes,values);
+} /* RFileIO::readBinary */
+
+
+void RFileIO::writeAscii(RSaveFile &outFile, const RSparseMatrixCSR &sparseMatrix)
+{
+    unsigned int nRows = sparseMatrix.getNRows();
+    unsigned int nValues = sparseMatrix.getNValues();
+
+    RFileIO::writeAscii(outFile,nRows,false);
+    RFileIO::writeAscii(outFile,' ',false);
+    RFileIO::writeAscii(outFile,nValues);
+    for (unsigned int i=0;i<=nRows;i++)
+    {
+        RFileIO::writeAscii(outFile,(i < nRows) ? sparseMatrix.getRowBegin(i) : nValues,false);
+        if (i < nRows)
+        {
+            RFileIO::writeAscii(outFile,' ',false);
+        }
+    }
+    RFileIO::writeNewLineAscii(outFile);
+    for (unsigned int i=0;i<nValues;i++)
+    {
+        RFileIO::writeAscii(outFile,sparseMatrix.getColumnIndexes()[i],false);
+        if (i+1 < nValues)
+        {
+            RFileIO::writeAscii(outFile,' ',false);
+        }
+    }
+    RFileIO::writeNewLineAscii(outFile);
+    for (unsigned int i=0;i<nValues;i++)
+    {
+        RFileIO::writeAscii(outFile,sparseMatrix.getValues()[i],false);
+        if (i+1 < nValues)
+        {
+            RFileIO::writeAscii(outFile,' ',false);
+        }
+    }
+    RFileIO::writeNewLineAscii(outFile);
+} /* RFileIO::writeAscii */
+
+
+void RFileIO::writeBinary(RSaveFile &outFile, const RSparseMatrixCSR &sparseMatrix)
+{
+    RFileIO::writeBinary(outFile,sparseMatrix.getNRows());
+    RFileIO::writeBinary(outFile,sparseMatrix.getNValues());
+    if (sparseMatrix.getRowPointers().empty())
+    {
+        // Empty matrix has no row pointers, write the single closing one.
+        RFileIO::writeBinary(outFile,(unsigned int)0);
+    }
+    else
+    {
+        outFile.write((const char*)sparseMatrix.getRowPointers().data(),qint64(sparseMatrix.getRowPointers().size()*sizeof(uint)));
+    }
+    outFile.write((const char*)sparseMatrix.getColumnIndexes().data(),qint64(sparseMatrix.getNValues()*sizeof(uint)));
+    outFile.write((const char*)sparseMatrix.getValues().data(),qint64(sparseMatrix.getNValues()*sizeof(double)));
+    if (outFile.error() != RFile::NoError)
+    {
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write RSparseMatrixCSR value.");
+    }
 } /* RFileIO::writeBinary */
 
 
@@ -4364,6 +4599,56 @@ void RFileIO::writeBinary(RSaveFile &outFile, const RRadiationResolution &radiat
 }
 
 
+/*********************************************************************
+ *  RViewFactorMethod                                                *
+ *********************************************************************/
+
+void RFileIO::readAscii(RFile &inFile, RViewFactorMethod &viewFactorMethod)
+{
+    int iValue;
+    inFile.getTextStream() >> iValue;
+    if (inFile.getTextStream().status() != QTextStream::Ok)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF, "Failed to read RViewFactorMethod value.");
+    }
+    viewFactorMethod = RViewFactorMethod(iValue);
+}
+
+void RFileIO::readBinary(RFile &inFile, RViewFactorMethod &viewFactorMethod)
+{
+    inFile.read((char*)&viewFactorMethod,sizeof(RViewFactorMethod));
+    if (inFile.error() != RFile::NoError)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read RViewFactorMethod value.");
+    }
+}
+
+void RFileIO::writeAscii(RSaveFile &outFile, const RViewFactorMethod &viewFactorMethod, bool addNewLine)
+{
+    if (!addNewLine)
+    {
+        outFile.getTextStream() << int(viewFactorMethod);
+    }
+    else
+    {
+        outFile.getTextStream() << int(viewFactorMethod) << RConstants::endl;
+    }
+    if (outFile.getTextStream().status() != QTextStream::Ok)
+    {
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write RViewFactorMethod value.");
+    }
+}
+
+void RFileIO::writeBinary(RSaveFile &outFile, const RViewFactorMethod &viewFactorMethod)
+{
+    outFile.write((char*)&viewFactorMethod,sizeof(RViewFactorMethod));
+    if (outFile.error() != RFile::NoError)
+    {
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write RViewFactorMethod value.");
+    }
+}
+
+
 /*********************************************************************
  *  RRadiationSetup                                                  *
  *********************************************************************/
@@ -4372,12 +4657,30 @@ void RFileIO::readAscii(RFile &inFile, RRadiationSetup &radiationSetup)
 {
     RFileIO::readAscii(inFile,radiationSetup.resolution);
     RFileIO::readAscii(inFile,radiationSetup.viewFactorMatrixFile);
+    if (inFile.getVersion() > RVersion(1,1,5))
+    {
+        RFileIO::readAscii(inFile,radiationSetup.viewFactorCorrection);
+        RFileIO::readAscii(inFile,radiationSetup.viewFactorThreshold);
+    }
+    if (inFile.getVersion() > RVersion(1,1,6))
+    {
+        RFileIO::readAscii(inFile,radiationSetup.viewFactorMethod);
+    }
 }
 
 void RFileIO::readBinary(RFile &inFile, RRadiationSetup &radiationSetup)
 {
     RFileIO::readBinary(inFile,radiationSetup.resolution);
     RFileIO::readBinary(inFile,radiationSetup.viewFactorMatrixFile);
+    if (inFile.getVersion() > RVersion(1,1,5))
+    {
+        RFileIO::readBinary(inFile,radiationSetup.viewFactorCorrection);
+        RFileIO::readBinary(inFile,radiationSetup.viewFactorThreshold);
+    }
+    if (inFile.getVersion() > RVersion(1,1,6))
+    {
+        RFileIO::readBinary(inFile,radiationSetup.viewFactorMethod);
+    }
 }
 
 void RFileIO::writeAscii(RSaveFile &outFile, const RRadiationSetup &radiationSetup, bool addNewLine)
@@ -4388,12 +4691,30 @@ void RFileIO::writeAscii(RSaveFile &outFile, const RRadiationSetup &radiationSet
         RFileIO::writeAscii(outFile,' ',false);
     }
     RFileIO::writeAscii(outFile,radiationSetup.viewFactorMatrixFile,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,radiationSetup.viewFactorCorrection,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,radiationSetup.viewFactorThreshold,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,radiationSetup.viewFactorMethod,addNewLine);
 }
 
 void RFileIO::writeBinary(RSaveFile &outFile, const RRadiationSetup &radiationSetup)
 {
     RFileIO::writeBinary(outFile,radiationSetup.resolution);
     RFileIO::writeBinary(outFile,radiationSetup.viewFactorMatrixFile);
+    RFileIO::writeBinary(outFile,radiationSetup.viewFactorCorrection);
+    RFileIO::writeBinary(outFile,radiationSetup.viewFactorThreshold);
+    RFileIO::writeBinary(outFile,radiationSetup.viewFactorMethod);
 }
 
 
@@ -4740,6 +5061,16 @@ void RFileIO::readAscii(RFile &inFile, RViewFactorMatrixHeader &viewFactorMatrix
     RFileIO::readAscii(inFile,viewFactorMatrixHeader.patchInput);
     RFileIO::readAscii(inFile,viewFactorMatrixHeader.hemicubeResolution);
     RFileIO::readAscii(inFile,viewFactorMatrixHeader.nElements);
+    if (inFile.getVersion() > RVersion(1,1,4))
+    {
+        RFileIO::readAscii(inFile,viewFactorMatrixHeader.patchHashes);
+    }
+    if (inFile.getVersion() > RVersion(1,1,6))
+    {
+        RFileIO::readAscii(inFile,viewFactorMatrixHeader.viewFactorMethod);
+        RFileIO::readAscii(inFile,viewFactorMatrixHeader.viewFactorCorrection);
+        RFileIO::readAscii(inFile,viewFactorMatrixHeader.viewFactorThreshold);
+    }
 }
 
 void RFileIO::readBinary(RFile &inFile, RViewFactorMatrixHeader &viewFactorMatrixHeader)
@@ -4747,6 +5078,16 @@ void RFileIO::readBinary(RFile &inFile, RViewFactorMatrixHeader &viewFactorMatri
     RFileIO::readBinary(inFile,viewFactorMatrixHeader.patchInput);
     RFileIO::readBinary(inFile,viewFactorMatrixHeader.hemicubeResolution);
     RFileIO::readBinary(inFile,viewFactorMatrixHeader.nElements);
+    if (inFile.getVersion() > RVersion(1,1,4))
+    {
+        RFileIO::readBinary(inFile,viewFactorMatrixHeader.patchHashes);
+    }
+    if (inFile.getVersion() > RVersion(1,1,6))
+    {
+        RFileIO::readBinary(inFile,viewFactorMatrixHeader.viewFactorMethod);
+        RFileIO::readBinary(inFile,viewFactorMatrixHeader.viewFactorCorrection);
+        RFileIO::readBinary(inFile,viewFactorMatrixHeader.viewFactorThreshold);
+    }
 }
 
 void RFileIO::writeAscii(RSaveFile &outFile, const RViewFactorMatrixHeader &viewFactorMatrixHeader, bool addNewLine)
@@ -4762,6 +5103,26 @@ void RFileIO::writeAscii(RSaveFile &outFile, const RViewFactorMatrixHeader &view
         RFileIO::writeAscii(outFile,' ',false);
     }
     RFileIO::writeAscii(outFile,viewFactorMatrixHeader.nElements,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,viewFactorMatrixHeader.patchHashes,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,viewFactorMatrixHeader.viewFactorMethod,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,viewFactorMatrixHeader.viewFactorCorrection,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,viewFactorMatrixHeader.viewFactorThreshold,addNewLine);
 }
 
 void RFileIO::writeBinary(RSaveFile &outFile, const RViewFactorMatrixHeader &viewFactorMatrixHeader)
@@ -4769,6 +5130,10 @@ void RFileIO::writeBinary(RSaveFile &outFile, const RViewFactorMatrixHeader &vie
     RFileIO::writeBinary(outFile,viewFactorMatrixHeader.patchInput);
     RFileIO::writeBinary(outFile,viewFactorMatrixHeader.hemicubeResolution);
     RFileIO::writeBinary(outFile,viewFactorMatrixHeader.nElements);
+    RFileIO::writeBinary(outFile,viewFactorMatrixHeader.patchHashes);
+    RFileIO::writeBinary(outFile,viewFactorMatrixHeader.viewFactorMethod);
+    RFileIO::writeBinary(outFile,viewFactorMatrixHeader.viewFactorCorrection);
+    RFileIO::writeBinary(outFile,viewFactorMatrixHeader.viewFactorThreshold);
 }
 
 
@@ -25,6 +25,24 @@ static RMatrixSolverDesc matrixSolverDesc [] =
     { "Generalized Minimal Residual", "mxs-GMRES" }
 };
 
+static QString matrixPreconditionerNames [] =
+{
+    "None",
+    "Jacobi",
+    "Block Jacobi",
+    "Incomplete Cholesky - IC(0)",
+    "Incomplete LU - ILU(0)",
+    "Algebraic multigrid - SA-AMG",
+    "Incomplete LU with threshold - ILUT"
+};
+
+static RMatrixSolverDesc nodeOrderingDesc [] =
+{
+    { "None", "none" },
+    { "Reverse Cuthill-McKee", "rcm" },
+    { "Nested dissection", "nd" }
+};
+
 void RMatrixSolverConf::_init(const RMatrixSolverConf *pMatrixSolver)
 {
     if (pMatrixSolver)
@@ -34,7 +52,14 @@ void RMatrixSolverConf::_init(const RMatrixSolverConf *pMatrixSolver)
         this->nOuterIterations = pMatrixSolver->nOuterIterations;
         this->solverCvgValue = pMatrixSolver->solverCvgValue;
         this->outputFrequency = pMatrixSolver->outputFrequency;
+        this->preconditionerType = pMatrixSolver->preconditionerType;
+        this->directSolver = pMatrixSolver->directSolver;
+        this->pipelined = pMatrixSolver->pipelined;
+        this->mixedPrecision = pMatrixSolver->mixedPrecision;
         this->outputFileName = pMatrixSolver->outputFileName;
+        this->systemFileName = pMatrixSolver->systemFileName;
+        this->matrixFree = pMatrixSolver->matrixFree;
+        this->nodeOrdering = pMatrixSolver->nodeOrdering;
     }
 }
 
@@ -44,6 +69,12 @@ RMatrixSolverConf::RMatrixSolverConf(RMatrixSolverType type)
     , nOuterIterations(1000)
     , solverCvgValue(RConstants::eps)
     , outputFrequency(100)
+    , preconditionerType(R_MATRIX_PRECONDITIONER_JACOBI)
+    , directSolver(false)
+    , pipelined(false)
+    , mixedPrecision(false)
+    , matrixFree(false)
+    , nodeOrdering(R_NODE_ORDERING_NONE)
 {
     switch (this->type)
     {
@@ -128,6 +159,46 @@ void RMatrixSolverConf::setOutputFrequency(unsigned int outputFrequency)
     this->outputFrequency = outputFrequency;
 }
 
+RMatrixPreconditionerType RMatrixSolverConf::getPreconditionerType(void) const
+{
+    return this->preconditionerType;
+}
+
+void RMatrixSolverConf::setPreconditionerType(RMatrixPreconditionerType preconditionerType)
+{
+    this->preconditionerType = preconditionerType;
+}
+
+bool RMatrixSolverConf::getDirectSolver(void) const
+{
+    return this->directSolver;
+}
+
+void RMatrixSolverConf::setDirectSolver(bool directSolver)
+{
+    this->directSolver = directSolver;
+}
+
+bool RMatrixSolverConf::getPipelined(void) const
+{
+    return this->pipelined;
+}
+
+void RMatrixSolverConf::setPipelined(bool pipelined)
+{
+    this->pipelined = pipelined;
+}
+
+bool RMatrixSolverConf::getMixedPrecision(void) const
+{
+    return this->mixedPrecision;
+}
+
+void RMatrixSolverConf::setMixedPrecision(bool mixedPrecision)
+{
+    this->mixedPrecision = mixedPrecision;
+}
+
 const QString &RMatrixSolverConf::getOutputFileName(void) const
 {
     return this->outputFileName;
@@ -138,6 +209,37 @@ void RMatrixSolverConf::setOutputFileName(const QString &outputFileName)
     this->outputFileName = outputFileName;
 }
 
+const QString &RMatrixSolverConf::getSystemFileName(void) const
+{
+    return this->systemFileName;
+}
+
+void RMatrixSolverConf::setSystemFileName(const QString &systemFileName)
+{
+    this->systemFileName = systemFileName;
+}
+
+bool RMatrixSolverConf::getMatrixFree(void) const
+{
+    return this->matrixFree;
+}
+
+void RMatrixSolverConf::setMatrixFree(bool matrixFree)
+{
+    this->matrixFree = matrixFree;
+}
+
+RNodeOrderingType RMatrixSolverConf::getNodeOrdering(void) const
+{
+    return this->nodeOrdering;
+}
+
+void RMatrixSolverConf::setNodeOrdering(RNodeOrderingType nodeOrdering)
+{
+    R_ERROR_ASSERT(R_NODE_ORDERING_TYPE_IS_VALID(nodeOrdering));
+    this->nodeOrdering = nodeOrdering;
+}
+
 const QString &RMatrixSolverConf::getName(RMatrixSolverType type)
 {
     return matrixSolverDesc[type].name;
@@ -147,3 +249,33 @@ const QString &RMatrixSolverConf::getId(RMatrixSolverType type)
 {
     return matrixSolverDesc[type].id;
 }
+
+const QString &RMatrixSolverConf::getPreconditionerName(RMatrixPreconditionerType preconditionerType)
+{
+    R_ERROR_ASSERT(R_MATRIX_PRECONDITIONER_TYPE_IS_VALID(preconditionerType));
+    return matrixPreconditionerNames[preconditionerType];
+}
+
+const QString &RMatrixSolverConf::getNodeOrderingName(RNodeOrderingType nodeOrdering)
+{
+    R_ERROR_ASSERT(R_NODE_ORDERING_TYPE_IS_VALID(nodeOrdering));
+    return nodeOrderingDesc[nodeOrdering].name;
+}
+
+const QString &RMatrixSolverConf::getNodeOrderingId(RNodeOrderingType nodeOrdering)
+{
+    R_ERROR_ASSERT(R_NODE_ORDERING_TYPE_IS_VALID(nodeOrdering));
+    return nodeOrderingDesc[nodeOrdering].id;
+}
+
+RNodeOrderingType RMatrixSolverConf::findNodeOrdering(const QString &nodeOrderingId)
+{
+    for (int i=R_NODE_ORDERING_NONE;i<R_NODE_ORDERING_N_TYPES;i++)
+    {
+        if (nodeOrderingDesc[i].id == nodeOrderingId)
+        {
+            return RNodeOrderingType(i);
+        }
+    }
+    return R_NODE_ORDERING_N_TYPES;
+}
@@ -0,0 +1,520 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_matrix_system.cpp                                    *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Matrix system class definition                      *
+ *********************************************************************/
+
+#include <QFile>
+#include <QTextStream>
+
+#include "rml_matrix_system.h"
+#include "rml_file_manager.h"
+#include "rml_file_io.h"
+
+
+static const RVersion _version = RVersion(FILE_MAJOR_VERSION,FILE_MINOR_VERSION,FILE_RELEASE_VERSION);
+
+void RMatrixSystem::_init(const RMatrixSystem *pMatrixSystem)
+{
+    if (pMatrixSystem)
+    {
+        this->matrixSolverConf = pMatrixSystem->matrixSolverConf;
+        this->preconditionerType = pMatrixSystem->preconditionerType;
+        this->blockSize = pMatrixSystem->blockSize;
+        this->A = pMatrixSystem->A;
+        this->b = pMatrixSystem->b;
+        this->x = pMatrixSystem->x;
+        this->rowBlockIndexes = pMatrixSystem->rowBlockIndexes;
+        this->nearNullSpace = pMatrixSystem->nearNullSpace;
+    }
+}
+
+RMatrixSystem::RMatrixSystem()
+    : preconditionerType(R_MATRIX_PRECONDITIONER_NONE)
+    , blockSize(1)
+{
+    this->_init();
+}
+
+RMatrixSystem::RMatrixSystem(const RMatrixSystem &matrixSystem)
+{
+    this->_init(&matrixSystem);
+}
+
+RMatrixSystem::~RMatrixSystem()
+{
+}
+
+RMatrixSystem &RMatrixSystem::operator =(const RMatrixSystem &matrixSystem)
+{
+    this->_init(&matrixSystem);
+    return (*this);
+}
+
+const RMatrixSolverConf &RMatrixSystem::getMatrixSolverConf(void) const
+{
+    return this->matrixSolverConf;
+}
+
+void RMatrixSystem::setMatrixSolverConf(const RMatrixSolverConf &matrixSolverConf)
+{
+    this->matrixSolverConf = matrixSolverConf;
+}
+
+RMatrixPreconditionerType RMatrixSystem::getPreconditionerType(void) const
+{
+    return this->preconditionerType;
+}
+
+void RMatrixSystem::setPreconditionerType(RMatrixPreconditionerType preconditionerType)
+{
+    this->preconditionerType = preconditionerType;
+}
+
+uint RMatrixSystem::getBlockSize(void) const
+{
+    return this->blockSize;
+}
+
+void RMatrixSystem::setBlockSize(uint blockSize)
+{
+    this->blockSize = blockSize;
+}
+
+const RSparseMatrixCSR &RMatrixSystem::getMatrix(void) const
+{
+    return this->A;
+}
+
+void RMatrixSystem::setMatrix(const RSparseMatrixCSR &A)
+{
+    this->A = A;
+}
+
+const RRVector &RMatrixSystem::getRhs(void) const
+{
+    return this->b;
+}
+
+void RMatrixSystem::setRhs(const RRVector &b)
+{
+    this->b = b;
+}
+
+const RRVector &RMatrixSystem::getInitialGuess(void) const
+{
+    return this->x;
+}
+
+void RMatrixSystem::setInitialGuess(const RRVector &x)
+{
+    this->x = x;
+}
+
+const std::vector<uint> &RMatrixSystem::getRowBlockIndexes(void) const
+{
+    return this->rowBlockIndexes;
+}
+
+void RMatrixSystem::setRowBlockIndexes(const std::vector<uint> &rowBlockIndexes)
+{
+    this->rowBlockIndexes = rowBlockIndexes;
+}
+
+const std::vector<RRVector> &RMatrixSystem::getNearNullSpace(void) const
+{
+    return this->nearNullSpace;
+}
+
+void RMatrixSystem::setNearNullSpace(const std::vector<RRVector> &nearNullSpace)
+{
+    this->nearNullSpace = nearNullSpace;
+}
+
+void RMatrixSystem::clear(void)
+{
+    this->matrixSolverConf = RMatrixSolverConf();
+    this->preconditionerType = R_MATRIX_PRECONDITIONER_NONE;
+    this->blockSize = 1;
+    this->A = RSparseMatrixCSR();
+    this->b.clear();
+    this->x.clear();
+    this->rowBlockIndexes.clear();
+    this->nearNullSpace.clear();
+}
+
+void RMatrixSystem::read(const QString &fileName)
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
+
+    QString ext = RFileManager::getExtension(fileName);
+
+    try
+    {
+        if (ext == RMatrixSystem::getDefaultFileExtension(false))
+        {
+            this->readAscii(fileName);
+        }
+        else if (ext == RMatrixSystem::getDefaultFileExtension(true))
+        {
+            this->readBinary(fileName);
+        }
+        else
+        {
+            throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF, "Unknown extension \"" + ext + "\".");
+        }
+    }
+    catch (RError &error)
+    {
+        throw error;
+    }
+    catch (std::bad_alloc&)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF, "Memory allocation failed.");
+    }
+    catch (const std::exception& x)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF, "%s.", typeid(x).name());
+    }
+    catch (...)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF, "Unknown exception.");
+    }
+}
+
+void RMatrixSystem::write(const QString &fileName) const
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
+
+    QString ext = RFileManager::getExtension(fileName);
+
+    try
+    {
+        if (ext == RMatrixSystem::getDefaultFileExtension(false))
+        {
+            this->writeAscii(fileName);
+        }
+        else if (ext == RMatrixSystem::getDefaultFileExtension(true))
+        {
+            this->writeBinary(fileName);
+        }
+        else if (ext == RMatrixSystem::getMatrixMarketFileExtension())
+        {
+            RMatrixSystem::writeMatrixMarket(fileName,this->A);
+            RMatrixSystem::writeMatrixMarket(RFileManager::getFileNameWithSuffix(fileName,"rhs"),this->b);
+        }
+        else
+        {
+            throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF, "Unknown extension \"" + ext + "\".");
+        }
+    }
+    catch (RError &error)
+    {
+        throw error;
+    }
+    catch (std::bad_alloc&)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF, "Memory allocation failed.");
+    }
+    catch (const std::exception& x)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF, "%s.", typeid(x).name());
+    }
+    catch (...)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF, "Unknown exception.");
+    }
+}
+
+QString RMatrixSystem::getDefaultFileExtension(bool binary)
+{
+    return binary ? "rbs" : "rts";
+}
+
+QString RMatrixSystem::getMatrixMarketFileExtension(void)
+{
+    return "mtx";
+}
+
+void RMatrixSystem::writeMatrixMarket(const QString &fileName, const RSparseMatrixCSR &A)
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
+
+    RLogger::info("Writing MatrixMarket file \'%s\'\n",fileName.toUtf8().constData());
+
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    QTextStream out(&file);
+
+    out.setRealNumberNotation(QTextStream::ScientificNotation);
+    out.setRealNumberPrecision(17);
+
+    out << "%%MatrixMarket matrix coordinate real general\n";
+    // System matrix is square, trailing columns without values must still be counted.
+    out << A.getNRows() << " " << A.getNRows() << " " << A.getNValues() << "\n";
+    for (uint i=0;i<A.getNRows();i++)
+    {
+        for (uint k=A.getRowBegin(i);k<A.getRowEnd(i);k++)
+        {
+            // MatrixMarket indexes are 1-based.
+            out << i+1 << " " << A.getColumnIndex(k)+1 << " " << A.getValue(k) << "\n";
+        }
+    }
+    out.flush();
+    if (out.status() != QTextStream::Ok)
+    {
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write to file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    file.close();
+}
+
+void RMatrixSystem::writeMatrixMarket(const QString &fileName, const RRVector &v)
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
+
+    RLogger::info("Writing MatrixMarket file \'%s\'\n",fileName.toUtf8().constData());
+
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    QTextStream out(&file);
+
+    out.setRealNumberNotation(QTextStream::ScientificNotation);
+    out.setRealNumberPrecision(17);
+
+    out << "%%MatrixMarket matrix array real general\n";
+    out << v.getNRows() << " 1\n";
+    for (uint i=0;i<v.getNRows();i++)
+    {
+        out << v[i] << "\n";
+    }
+    out.flush();
+    if (out.status() != QTextStream::Ok)
+    {
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write to file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    file.close();
+}
+
+void RMatrixSystem::readAscii(const QString &fileName)
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
+
+    RLogger::info("Reading ascii file \'%s\'\n",fileName.toUtf8().constData());
+
+    RFile file(fileName,RFile::ASCII);
+
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    RFileHeader fileHeader;
+
+    RFileIO::readAscii(file,fileHeader);
+    if (fileHeader.getType() != R_FILE_TYPE_MATRIX_SYSTEM)
+    {
+        throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF,"File type of the file \'" + fileName + "\' is not MATRIX SYSTEM.");
+    }
+
+    // Set file version
+    file.setVersion(fileHeader.getVersion());
+
+    int preconditionerType = R_MATRIX_PRECONDITIONER_NONE;
+
+    RFileIO::readAscii(file,this->matrixSolverConf);
+    RFileIO::readAscii(file,preconditionerType);
+    if (!R_MATRIX_PRECONDITIONER_TYPE_IS_VALID(preconditionerType))
+    {
+        throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF,"Invalid preconditioner type \'%d\'.",preconditionerType);
+    }
+    this->preconditionerType = RMatrixPreconditionerType(preconditionerType);
+    RFileIO::readAscii(file,this->blockSize);
+    RFileIO::readAscii(file,this->A);
+    RFileIO::readAscii(file,this->b,true);
+    RFileIO::readAscii(file,this->x,true);
+
+    uint nRowBlockIndexes = 0;
+    RFileIO::readAscii(file,nRowBlockIndexes);
+    this->rowBlockIndexes.resize(nRowBlockIndexes);
+    for (uint i=0;i<nRowBlockIndexes;i++)
+    {
+        RFileIO::readAscii(file,this->rowBlockIndexes[i]);
+    }
+
+    uint nNearNullSpace = 0;
+    RFileIO::readAscii(file,nNearNullSpace);
+    this->nearNullSpace.resize(nNearNullSpace);
+    for (uint i=0;i<nNearNullSpace;i++)
+    {
+        RFileIO::readAscii(file,this->nearNullSpace[i],true);
+    }
+
+    file.close();
+}
+
+void RMatrixSystem::readBinary(const QString &fileName)
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
+
+    RLogger::info("Reading binary file \'%s\'\n",fileName.toUtf8().constData());
+
+    RFile file(fileName,RFile::BINARY);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    RFileHeader fileHeader;
+
+    RFileIO::readBinary(file,fileHeader);
+    if (fileHeader.getType() != R_FILE_TYPE_MATRIX_SYSTEM)
+    {
+        throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF,"File type of the file \'" + fileName + "\' is not MATRIX SYSTEM.");
+    }
+
+    // Set file version
+    file.setVersion(fileHeader.getVersion());
+
+    int preconditionerType = R_MATRIX_PRECONDITIONER_NONE;
+
+    RFileIO::readBinary(file,this->matrixSolverConf);
+    RFileIO::readBinary(file,preconditionerType);
+    if (!R_MATRIX_PRECONDITIONER_TYPE_IS_VALID(preconditionerType))
+    {
+        throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF,"Invalid preconditioner type \'%d\'.",preconditionerType);
+    }
+    this->preconditionerType = RMatrixPreconditionerType(preconditionerType);
+    RFileIO::readBinary(file,this->blockSize);
+    RFileIO::readBinary(file,this->A);
+    RFileIO::readBinary(file,this->b,true);
+    RFileIO::readBinary(file,this->x,true);
+
+    uint nRowBlockIndexes = 0;
+    RFileIO::readBinary(file,nRowBlockIndexes);
+    this->rowBlockIndexes.resize(nRowBlockIndexes);
+    for (uint i=0;i<nRowBlockIndexes;i++)
+    {
+        RFileIO::readBinary(file,this->rowBlockIndexes[i]);
+    }
+
+    uint nNearNullSpace = 0;
+    RFileIO::readBinary(file,nNearNullSpace);
+    this->nearNullSpace.resize(nNearNullSpace);
+    for (uint i=0;i<nNearNullSpace;i++)
+    {
+        RFileIO::readBinary(file,this->nearNullSpace[i],true);
+    }
+
+    file.close();
+}
+
+void RMatrixSystem::writeAscii(const QString &fileName) const
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
+
+    RLogger::info("Writing ascii file \'%s\'\n",fileName.toUtf8().constData());
+
+    RSaveFile file(fileName,RSaveFile::ASCII);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    RFileIO::writeAscii(file,RFileHeader(R_FILE_TYPE_MATRIX_SYSTEM,_version));
+    RFileIO::writeAscii(file,this->matrixSolverConf);
+    RFileIO::writeAscii(file,int(this->preconditionerType));
+    RFileIO::writeAscii(file,this->blockSize);
+    RFileIO::writeAscii(file,this->A);
+    RFileIO::writeAscii(file,this->b,true);
+    RFileIO::writeAscii(file,this->x,true);
+    RFileIO::writeAscii(file,uint(this->rowBlockIndexes.size()));
+    for (uint i=0;i<this->rowBlockIndexes.size();i++)
+    {
+        RFileIO::writeAscii(file,this->rowBlockIndexes[i],false);
+        RFileIO::writeAscii(file,' ',false);
+    }
+    RFileIO::writeNewLineAscii(file);
+    RFileIO::writeAscii(file,uint(this->nearNullSpace.size()));
+    for (uint i=0;i<this->nearNullSpace.size();i++)
+    {
+        RFileIO::writeAscii(file,this->nearNullSpace[i],true);
+    }
+
+    file.commit();
+}
+
+void RMatrixSystem::writeBinary(const QString &fileName) const
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
+
+    RLogger::info("Writing binary file \'%s\'\n",fileName.toUtf8().constData());
+
+    RSaveFile file(fileName,RSaveFile::BINARY);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    RFileIO::writeBinary(file,RFileHeader(R_FILE_TYPE_MATRIX_SYSTEM,_version));
+    RFileIO::writeBinary(file,this->matrixSolverConf);
+    RFileIO::writeBinary(file,int(this->preconditionerType));
+    RFileIO::writeBinary(file,this->blockSize);
+    RFileIO::writeBinary(file,this->A);
+    RFileIO::writeBinary(file,this->b,true);
+    RFileIO::writeBinary(file,this->x,true);
+    RFileIO::writeBinary(file,uint(this->rowBlockIndexes.size()));
+    for (uint i=0;i<this->rowBlockIndexes.size();i++)
+    {
+        RFileIO::writeBinary(file,this->rowBlockIndexes[i]);
+    }
+    RFileIO::writeBinary(file,uint(this->nearNullSpace.size()));
+    for (uint i=0;i<this->nearNullSpace.size();i++)
+    {
+        RFileIO::writeBinary(file,this->nearNullSpace[i],true);
+    }
+
+    file.commit();
+}
@@ -135,6 +135,11 @@ void RMeshGenerator::generate(const RMeshInput &meshInput, RModel &model)
         RLogger::unindent();
         throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to import mesh from TetGen format: %s", error.getMessage().toUtf8().constData());
     }
+
+    if (meshInput.getReorderMesh())
+    {
+        model.reorderMesh();
+    }
 }
 
 void RMeshGenerator::generate(const std::vector<RNode> &nodes, const std::vector<RElement> &elements, std::vector<RNode> &steinerNodes, std::vector<RElement> &volumes)
@@ -160,6 +165,7 @@ void RMeshGenerator::generate(const std::vector<RNode> &nodes, const std::vector
     input.setSurfaceIntegrityCheck(true);
     input.setQualityMesh(false);
     input.setKeepResults(false);
+    input.setReorderMesh(false);
     input.setOutputEdges(false);
 
     try
@@ -209,6 +215,7 @@ std::vector<RTetrahedron> RMeshGenerator::generate(const std::vector<RTriangle>
     input.setSurfaceIntegrityCheck(true);
     input.setQualityMesh(false);
     input.setKeepResults(false);
+    input.setReorderMesh(false);
     input.setOutputEdges(false);
 
     try
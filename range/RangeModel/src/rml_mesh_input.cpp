@@ -26,6 +26,7 @@ void RMeshInput::_init(const RMeshInput *pMeshInput)
         this->tolerance = pMeshInput->tolerance;
         this->surfaceIntegrityCheck = pMeshInput->surfaceIntegrityCheck;
         this->keepResults = pMeshInput->keepResults;
+        this->reorderMesh = pMeshInput->reorderMesh;
         this->useTetGenInputParams = pMeshInput->useTetGenInputParams;
         this->tetGenInputParams = pMeshInput->tetGenInputParams;
     }
@@ -43,6 +44,7 @@ RMeshInput::RMeshInput() :
     tolerance(1.0e-10),
     surfaceIntegrityCheck(false),
     keepResults(true),
+    reorderMesh(true),
     useTetGenInputParams(false),
     tetGenInputParams(QString())
 {
@@ -184,6 +186,16 @@ void RMeshInput::setKeepResults(bool keepResults)
     this->keepResults = keepResults;
 }
 
+bool RMeshInput::getReorderMesh(void) const
+{
+    return this->reorderMesh;
+}
+
+void RMeshInput::setReorderMesh(bool reorderMesh)
+{
+    this->reorderMesh = reorderMesh;
+}
+
 bool RMeshInput::getUseTetGenInputParams(void) const
 {
     return this->useTetGenInputParams;
@@ -0,0 +1,181 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_mesh_view.cpp                                        *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Mesh view class definition                          *
+ *********************************************************************/
+
+#include <limits>
+
+#include "rml_mesh_view.h"
+#include "rml_element_geometry_cache.h"
+
+void RMeshView::_init(const RMeshView *pMeshView)
+{
+    if (pMeshView)
+    {
+        this->valid = pMeshView->valid;
+        this->meshHash = pMeshView->meshHash;
+        this->nBuilds = pMeshView->nBuilds;
+        this->x = pMeshView->x;
+        this->y = pMeshView->y;
+        this->z = pMeshView->z;
+        this->elementTypes = pMeshView->elementTypes;
+        this->elementNodePointers = pMeshView->elementNodePointers;
+        this->elementNodes = pMeshView->elementNodes;
+        this->nodeElementPointers = pMeshView->nodeElementPointers;
+        this->nodeElements = pMeshView->nodeElements;
+    }
+}
+
+RMeshView::RMeshView()
+    : valid(false)
+    , meshHash(0)
+    , nBuilds(0)
+{
+    this->_init();
+}
+
+RMeshView::RMeshView(const RMeshView &meshView)
+{
+    this->_init(&meshView);
+}
+
+RMeshView::~RMeshView()
+{
+
+}
+
+RMeshView &RMeshView::operator =(const RMeshView &meshView)
+{
+    this->_init(&meshView);
+    return (*this);
+}
+
+bool RMeshView::isValid(const std::vector<RNode> &nodes, const std::vector<RElement> &elements) const
+{
+    if (!this->valid || this->x.size() != nodes.size() || this->elementTypes.size() != elements.size())
+    {
+        return false;
+    }
+    return (this->meshHash == RElementGeometryCache::findMeshHash(nodes,elements));
+}
+
+bool RMeshView::update(const std::vector<RNode> &nodes, const std::vector<RElement> &elements)
+{
+    quint64 hash = RElementGeometryCache::findMeshHash(nodes,elements);
+
+    if (this->valid && this->x.size() == nodes.size() && this->elementTypes.size() == elements.size() && this->meshHash == hash)
+    {
+        return false;
+    }
+
+    uint nNodes = uint(nodes.size());
+    uint nElements = uint(elements.size());
+
+    this->x.resize(nNodes);
+    this->y.resize(nNodes);
+    this->z.resize(nNodes);
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nNodes);i++)
+    {
+        this->x[i] = nodes[i].getX();
+        this->y[i] = nodes[i].getY();
+        this->z[i] = nodes[i].getZ();
+    }
+
+    // Element to node connectivity.
+    this->elementTypes.resize(nElements);
+    this->elementNodePointers.resize(nElements+1);
+    this->elementNodePointers[0] = 0;
+
+    quint64 nElementNodes = 0;
+    for (uint i=0;i<nElements;i++)
+    {
+        this->elementTypes[i] = elements[i].getType();
+        nElementNodes += elements[i].size();
+        if (nElementNodes > quint64(std::numeric_limits<uint>::max()))
+        {
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Too many element nodes to build mesh view.");
+        }
+        this->elementNodePointers[i+1] = uint(nElementNodes);
+    }
+
+    this->elementNodes.resize(nElementNodes);
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nElements);i++)
+    {
+        uint *elementNodeIDs = this->elementNodes.data() + this->elementNodePointers[i];
+        for (uint j=0;j<elements[i].size();j++)
+        {
+            elementNodeIDs[j] = elements[i].getNodeId(j);
+        }
+    }
+
+    // Node to element connectivity.
+    this->nodeElementPointers.assign(nNodes+1,0);
+    for (uint i=0;i<this->elementNodes.size();i++)
+    {
+        this->nodeElementPointers[this->elementNodes[i]+1]++;
+    }
+    for (uint i=0;i<nNodes;i++)
+    {
+        this->nodeElementPointers[i+1] += this->nodeElementPointers[i];
+    }
+
+    this->nodeElements.resize(this->nodeElementPointers[nNodes]);
+    std::vector<uint> nodeElementPositions(this->nodeElementPointers.begin(),this->nodeElementPointers.end()-1);
+    for (uint i=0;i<nElements;i++)
+    {
+        for (uint j=this->elementNodePointers[i];j<this->elementNodePointers[i+1];j++)
+        {
+            this->nodeElements[nodeElementPositions[this->elementNodes[j]]++] = i;
+        }
+    }
+
+    this->meshHash = hash;
+    this->valid = true;
+    this->nBuilds++;
+
+    return true;
+}
+
+void RMeshView::invalidate(void)
+{
+    this->valid = false;
+    this->meshHash = 0;
+    this->x.clear();
+    this->y.clear();
+    this->z.clear();
+    this->elementTypes.clear();
+    this->elementNodePointers.clear();
+    this->elementNodes.clear();
+    this->nodeElementPointers.clear();
+    this->nodeElements.clear();
+    this->x.shrink_to_fit();
+    this->y.shrink_to_fit();
+    this->z.shrink_to_fit();
+    this->elementTypes.shrink_to_fit();
+    this->elementNodePointers.shrink_to_fit();
+    this->elementNodes.shrink_to_fit();
+    this->nodeElementPointers.shrink_to_fit();
+    this->nodeElements.shrink_to_fit();
+}
+
+uint RMeshView::getNBuilds(void) const
+{
+    return this->nBuilds;
+}
+
+quint64 RMeshView::getMemorySize(void) const
+{
+    return quint64(this->x.size() + this->y.size() + this->z.size()) * sizeof(double)
+         + quint64(this->elementTypes.size()) * sizeof(RElementType)
+         + quint64(this->elementNodePointers.size() + this->elementNodes.size()) * sizeof(uint)
+         + quint64(this->nodeElementPointers.size() + this->nodeElements.size()) * sizeof(uint);
+}
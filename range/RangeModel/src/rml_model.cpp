@@ -18,6 +18,7 @@
 #include <vector>
 #include <stack>
 #include <cmath>
+#include <cstring>
 #include <float.h>
 
 #include <rblib.h>
@@ -31,6 +32,13 @@
 
 static const RVersion _version = RVersion(FILE_MAJOR_VERSION,FILE_MINOR_VERSION,FILE_RELEASE_VERSION);
 
+static inline void hashPatchValue(quint64 &hash, quint64 value)
+{
+    // FNV-1a applied on 64-bit words.
+    hash ^= value;
+    hash *= Q_UINT64_C(1099511628211);
+}
+
 
 void RModel::_init (const RModel *pModel)
 {
@@ -2106,6 +2114,168 @@ uint RModel::purgeUnusedElements()
 } /* RModel::purgeUnusedElements */
 
 
+static void reorderNeighbors(std::vector<RUVector> &neighbors, const std::vector<uint> &elementBook)
+{
+    if (neighbors.size() != elementBook.size())
+    {
+        return;
+    }
+
+    std::vector<RUVector> neighborsNew(neighbors.size());
+    for (uint i=0;i<neighbors.size();i++)
+    {
+        RUVector &elementNeighbors = neighborsNew[elementBook[i]];
+        elementNeighbors = neighbors[i];
+        for (uint j=0;j<elementNeighbors.size();j++)
+        {
+            if (elementNeighbors[j] != RConstants::eod)
+            {
+                elementNeighbors[j] = elementBook[elementNeighbors[j]];
+            }
+        }
+    }
+    neighbors.swap(neighborsNew);
+}
+
+
+void RModel::reorderMesh(RSpaceFillingCurve::Type type)
+{
+    RLogger::info("Reordering mesh along %s curve\n",RSpaceFillingCurve::getName(type).toUtf8().constData());
+    RLogger::indent();
+
+    uint nNodes = this->getNNodes();
+    uint nElements = this->getNElements();
+    uint nElementGroups = this->getNElementGroups();
+
+    // Find new node positions.
+    std::vector<RR3Vector> points(nNodes);
+    for (uint i=0;i<nNodes;i++)
+    {
+        points[i] = RR3Vector(this->nodes[i].getX(),this->nodes[i].getY(),this->nodes[i].getZ());
+    }
+
+    std::vector<uint> nodeOrder;
+    RSpaceFillingCurve::findOrder(type,points,nodeOrder);
+
+    std::vector<uint> nodeBook(nNodes);
+    for (uint i=0;i<nNodes;i++)
+    {
+        nodeBook[nodeOrder[i]] = i;
+    }
+
+    // Find new element positions.
+    // Elements are ordered by element group first and by position of their center along the curve second.
+    points.resize(nElements);
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nElements);i++)
+    {
+        const RElement &rElement = this->elements[i];
+        double x = 0.0, y = 0.0, z = 0.0;
+        for (uint j=0;j<rElement.size();j++)
+        {
+            const RNode &rNode = this->nodes[rElement.getNodeId(j)];
+            x += rNode.getX();
+            y += rNode.getY();
+            z += rNode.getZ();
+        }
+        if (rElement.size() > 0)
+        {
+            x /= double(rElement.size());
+            y /= double(rElement.size());
+            z /= double(rElement.size());
+        }
+        points[i] = RR3Vector(x,y,z);
+    }
+
+    std::vector<uint> elementOrder;
+    RSpaceFillingCurve::findOrder(type,points,elementOrder);
+    std::vector<RR3Vector>().swap(points);
+
+    // Elements which do not belong to any group are placed at the end.
+    std::vector<uint> elementGroupIDs(nElements,nElementGroups);
+    for (uint i=0;i<nElementGroups;i++)
+    {
+        const RElementGroup *pElementGroup = this->getElementGroupPtr(i);
+        for (uint j=0;j<pElementGroup->size();j++)
+        {
+            uint elementID = pElementGroup->get(j);
+            if (elementGroupIDs[elementID] == nElementGroups)
+            {
+                elementGroupIDs[elementID] = i;
+            }
+        }
+    }
+
+    std::vector<uint> groupOffsets(nElementGroups+2,0);
+    for (uint i=0;i<nElements;i++)
+    {
+        groupOffsets[elementGroupIDs[i]+1]++;
+    }
+    for (uint i=0;i<=nElementGroups;i++)
+    {
+        groupOffsets[i+1] += groupOffsets[i];
+    }
+
+    std::vector<uint> elementBook(nElements);
+    for (uint i=0;i<nElements;i++)
+    {
+        uint elementID = elementOrder[i];
+        elementBook[elementID] = groupOffsets[elementGroupIDs[elementID]]++;
+    }
+
+    RLogger::info("Moving nodes\n");
+    std::vector<RNode> nodesNew(nNodes);
+    for (uint i=0;i<nNodes;i++)
+    {
+        nodesNew[nodeBook[i]] = this->nodes[i];
+    }
+    this->nodes.swap(nodesNew);
+    std::vector<RNode>().swap(nodesNew);
+    this->RResults::reorderNodes(nodeBook);
+
+    RLogger::info("Moving elements\n");
+    std::vector<RElement> elementsNew(nElements);
+    for (uint i=0;i<nElements;i++)
+    {
+        RElement &rElement = elementsNew[elementBook[i]];
+        rElement = this->elements[i];
+        for (uint j=0;j<rElement.size();j++)
+        {
+            rElement.setNodeId(j,nodeBook[rElement.getNodeId(j)]);
+        }
+    }
+    this->elements.swap(elementsNew);
+    std::vector<RElement>().swap(elementsNew);
+    this->RResults::reorderElements(elementBook);
+
+    RLogger::info("Fixing element ID references in element groups\n");
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nElementGroups);i++)
+    {
+        RElementGroup *pElementGroup = this->getElementGroupPtr(uint(i));
+        std::vector<uint> elementIDs(pElementGroup->size());
+        for (uint j=0;j<pElementGroup->size();j++)
+        {
+            elementIDs[j] = elementBook[pElementGroup->get(j)];
+        }
+        // Group elements are visited in memory order.
+        std::sort(elementIDs.begin(),elementIDs.end());
+        for (uint j=0;j<pElementGroup->size();j++)
+        {
+            pElementGroup->set(j,elementIDs[j]);
+        }
+    }
+
+    RLogger::info("Updating neighbors\n");
+    reorderNeighbors(this->surfaceNeigs,elementBook);
+    reorderNeighbors(this->volumeNeigs,elementBook);
+
+    this->createDependentEntities();
+
+    RLogger::unindent();
+} /* RModel::reorderMesh */
+
+
 /*********************************************************************
  * Interpolated element interface                                    *
  *********************************************************************/
@@ -6422,6 +6592,40 @@ void RModel::generatePatchInputVector(std::vector<RPatchInput> &patchInput) cons
 } /* RModel::generatePatchInputVector */
 
 
+void RModel::generatePatchHashes(const RPatchBook &book, std::vector<quint64> &patchHashes) const
+{
+    patchHashes.resize(book.getNPatches());
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(book.getNPatches());i++)
+    {
+        const RUVector &rElementIDs = book.getPatch(uint(i)).getElementIDs();
+
+        quint64 hash = Q_UINT64_C(14695981039346656037);
+        hashPatchValue(hash,quint64(rElementIDs.size()));
+        for (uint j=0;j<rElementIDs.size();j++)
+        {
+            const RElement &rElement = this->getElement(rElementIDs[j]);
+            hashPatchValue(hash,quint64(rElementIDs[j]));
+            hashPatchValue(hash,quint64(rElement.getType()));
+            for (uint k=0;k<rElement.size();k++)
+            {
+                const RNode &rNode = this->getNode(rElement.getNodeId(k));
+                double coordinates[3] = { rNode.getX(), rNode.getY(), rNode.getZ() };
+                hashPatchValue(hash,quint64(rElement.getNodeId(k)));
+                for (uint l=0;l<3;l++)
+                {
+                    quint64 bits;
+                    std::memcpy(&bits,&coordinates[l],sizeof(bits));
+                    hashPatchValue(hash,bits);
+                }
+            }
+        }
+        patchHashes[i] = hash;
+    }
+} /* RModel::generatePatchHashes */
+
+
 void RModel::findPatchCenter(const RPatch &rPatch, double &cx, double &cy, double &cz) const
 {
     const RUVector &rElementIDs = rPatch.getElementIDs();
@@ -6510,6 +6714,9 @@ QString RModel::findRecentViewFactorMatrixFile() const
 void RModel::generateViewFactorMatrixHeader(RViewFactorMatrixHeader &viewFactorMatrixHeader) const
 {
     viewFactorMatrixHeader.setHemicubeResolution(this->getProblemSetup().getRadiationSetup().getResolution());
+    viewFactorMatrixHeader.setViewFactorMethod(this->getProblemSetup().getRadiationSetup().getViewFactorMethod());
+    viewFactorMatrixHeader.setViewFactorCorrection(this->getProblemSetup().getRadiationSetup().getViewFactorCorrection());
+    viewFactorMatrixHeader.setViewFactorThreshold(this->getProblemSetup().getRadiationSetup().getViewFactorThreshold());
     this->generatePatchInputVector(viewFactorMatrixHeader.getPatchInput());
     viewFactorMatrixHeader.setNElements(this->getNElements());
 } /* RModel::generateViewFactorMatrixHeade */
@@ -10,21 +10,34 @@
 
 #include <QFileInfo>
 
+#include <rblib.h>
+
 #include "rml_file_manager.h"
 #include "rml_radiation_setup.h"
 
+static const QString viewFactorMethodTexts [] =
+{
+    "Hemi-cube",
+    "Monte Carlo ray tracing"
+};
 
 void RRadiationSetup::_init(const RRadiationSetup *pRadiationSetup)
 {
     if (pRadiationSetup)
     {
         this->resolution = pRadiationSetup->resolution;
+        this->viewFactorMethod = pRadiationSetup->viewFactorMethod;
         this->viewFactorMatrixFile = pRadiationSetup->viewFactorMatrixFile;
+        this->viewFactorCorrection = pRadiationSetup->viewFactorCorrection;
+        this->viewFactorThreshold = pRadiationSetup->viewFactorThreshold;
     }
 }
 
 RRadiationSetup::RRadiationSetup()
     : resolution(R_RADIATION_RESOLUTION_MEDIUM)
+    , viewFactorMethod(R_VIEW_FACTOR_METHOD_HEMICUBE)
+    , viewFactorCorrection(false)
+    , viewFactorThreshold(0.0)
 {
     this->_init();
 }
@@ -55,6 +68,16 @@ void RRadiationSetup::setResolution(const RRadiationResolution &value)
     this->resolution = value;
 }
 
+RViewFactorMethod RRadiationSetup::getViewFactorMethod(void) const
+{
+    return this->viewFactorMethod;
+}
+
+void RRadiationSetup::setViewFactorMethod(RViewFactorMethod viewFactorMethod)
+{
+    this->viewFactorMethod = viewFactorMethod;
+}
+
 const QString &RRadiationSetup::getViewFactorMatrixFile(void) const
 {
     return this->viewFactorMatrixFile;
@@ -65,6 +88,26 @@ void RRadiationSetup::setViewFactorMatrixFile(const QString &viewFactorMatrixFil
     this->viewFactorMatrixFile = viewFactorMatrixFile;
 }
 
+bool RRadiationSetup::getViewFactorCorrection(void) const
+{
+    return this->viewFactorCorrection;
+}
+
+void RRadiationSetup::setViewFactorCorrection(bool viewFactorCorrection)
+{
+    this->viewFactorCorrection = viewFactorCorrection;
+}
+
+double RRadiationSetup::getViewFactorThreshold(void) const
+{
+    return this->viewFactorThreshold;
+}
+
+void RRadiationSetup::setViewFactorThreshold(double viewFactorThreshold)
+{
+    this->viewFactorThreshold = viewFactorThreshold;
+}
+
 QString RRadiationSetup::findRecentViewFactorMatrixFile(const QString &viewFactorMatrixFile, uint timeStep)
 {
     if (viewFactorMatrixFile.isEmpty())
@@ -107,8 +150,18 @@ QString RRadiationSetup::getResolutionText(RRadiationResolution resolution)
     return "Unknown";
 }
 
+const QString &RRadiationSetup::getViewFactorMethodText(RViewFactorMethod viewFactorMethod)
+{
+    R_ERROR_ASSERT(R_VIEW_FACTOR_METHOD_TYPE_IS_VALID(viewFactorMethod));
+    return viewFactorMethodTexts[viewFactorMethod];
+}
+
 QString RRadiationSetup::toString() const
 {
-    return "{ Resolution: " + QString::number(this->resolution) + ", View-factor matrix file: " + this->viewFactorMatrixFile + " }";
+    return "{ Resolution: " + QString::number(this->resolution)
+         + ", View-factor method: " + RRadiationSetup::getViewFactorMethodText(this->viewFactorMethod)
+         + ", View-factor matrix file: " + this->viewFactorMatrixFile
+         + ", View-factor correction: " + (this->viewFactorCorrection ? "true" : "false")
+         + ", View-factor threshold: " + QString::number(this->viewFactorThreshold) + " }";
 }
 
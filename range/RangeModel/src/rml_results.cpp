@@ -318,3 +318,39 @@ void RResults::removeElements(const std::vector<uint> &elementBook)
         }
     }
 } /* RResults::removeElements */
+
+
+void RResults::reorderNodes(const std::vector<uint> &nodeBook)
+{
+    std::vector<RVariable>::iterator iter;
+
+    R_ERROR_ASSERT(nodeBook.size() == this->getNNodes());
+
+    for (iter = this->variables.begin();
+         iter != this->variables.end();
+         ++iter)
+    {
+        if (iter->getApplyType() == R_VARIABLE_APPLY_NODE)
+        {
+            iter->reorderValues(nodeBook);
+        }
+    }
+} /* RResults::reorderNodes */
+
+
+void RResults::reorderElements(const std::vector<uint> &elementBook)
+{
+    std::vector<RVariable>::iterator iter;
+
+    R_ERROR_ASSERT(elementBook.size() == this->getNElements());
+
+    for (iter = this->variables.begin();
+         iter != this->variables.end();
+         ++iter)
+    {
+        if (iter->getApplyType() == R_VARIABLE_APPLY_ELEMENT)
+        {
+            iter->reorderValues(elementBook);
+        }
+    }
+} /* RResults::reorderElements */
@@ -120,18 +120,18 @@ void RSparseMatrix::clear(void)
     }
 }
 
-bool RSparseMatrix::findColumnPosition(uint rowIndex, uint columnIndex, uint &rowPosition) const
+void RSparseMatrix::clearValues(void)
 {
-    std::vector<uint> columnIndexes = this->getRowIndexes(rowIndex);
-    for (uint i=0;i<columnIndexes.size();i++)
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(this->data.size());i++)
     {
-        if (columnIndexes[i] == columnIndex)
-        {
-            rowPosition = i;
-            return true;
-        }
+        this->data[i].clearValues();
     }
-    return false;
+}
+
+bool RSparseMatrix::findColumnPosition(uint rowIndex, uint columnIndex, uint &rowPosition) const
+{
+    return this->data[rowIndex].findPosition(columnIndex,rowPosition);
 }
 
 uint RSparseMatrix::findMaxColumnIndex(void) const
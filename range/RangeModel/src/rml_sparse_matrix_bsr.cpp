@@ -0,0 +1,494 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_sparse_matrix_bsr.cpp                                *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Block sparse row matrix class definition            *
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <omp.h>
+
+#include <rblib.h>
+
+#include "rml_sparse_matrix_bsr.h"
+
+void RSparseMatrixBSR::_init(const RSparseMatrixBSR *pMatrix)
+{
+    if (pMatrix)
+    {
+        this->blockSize = pMatrix->blockSize;
+        this->nRows = pMatrix->nRows;
+        this->blockRowPointers = pMatrix->blockRowPointers;
+        this->blockColumnIndexes = pMatrix->blockColumnIndexes;
+        this->values = pMatrix->values;
+        this->rowPositions = pMatrix->rowPositions;
+        this->columnPositions = pMatrix->columnPositions;
+        this->contiguous = pMatrix->contiguous;
+        this->valuePositions = pMatrix->valuePositions;
+    }
+}
+
+RSparseMatrixBSR::RSparseMatrixBSR()
+    : blockSize(1)
+    , nRows(0)
+    , contiguous(true)
+{
+    this->_init();
+}
+
+RSparseMatrixBSR::RSparseMatrixBSR(const RSparseMatrixCSR &matrix, uint blockSize, const std::vector<uint> &rowBlockIndexes)
+    : blockSize(1)
+    , nRows(0)
+    , contiguous(true)
+{
+    this->_init();
+    this->build(matrix,blockSize,rowBlockIndexes);
+}
+
+RSparseMatrixBSR::RSparseMatrixBSR(const RSparseMatrixBSR &matrix)
+{
+    this->_init(&matrix);
+}
+
+RSparseMatrixBSR::~RSparseMatrixBSR()
+{
+}
+
+RSparseMatrixBSR &RSparseMatrixBSR::operator =(const RSparseMatrixBSR &matrix)
+{
+    this->_init(&matrix);
+    return (*this);
+}
+
+void RSparseMatrixBSR::build(const RSparseMatrixCSR &matrix, uint blockSize, const std::vector<uint> &rowBlockIndexes)
+{
+    if (blockSize == 0)
+    {
+        throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Block size must be greater than zero.");
+    }
+
+    uint n = matrix.getNRows();
+
+    if (!rowBlockIndexes.empty() && rowBlockIndexes.size() != n)
+    {
+        throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Number of row block indexes (%u) differs from number of matrix rows (%u).",uint(rowBlockIndexes.size()),n);
+    }
+
+    this->blockSize = blockSize;
+    this->nRows = n;
+
+    // Number blocks in order of their first row, components within block follow row order.
+    std::vector<uint> rowBlocks(n);
+    std::vector<uint> rowComponents(n);
+    std::vector<uint> blockNumbers;
+    std::vector<uint> blockNRows;
+
+    for (uint i=0;i<n;i++)
+    {
+        uint blockIndex = rowBlockIndexes.empty() ? i / blockSize : rowBlockIndexes[i];
+        if (blockIndex >= blockNumbers.size())
+        {
+            blockNumbers.resize(blockIndex+1,RConstants::eod);
+        }
+        if (blockNumbers[blockIndex] == RConstants::eod)
+        {
+            blockNumbers[blockIndex] = uint(blockNRows.size());
+            blockNRows.push_back(0);
+        }
+        uint b = blockNumbers[blockIndex];
+        if (blockNRows[b] >= blockSize)
+        {
+            throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Block %u has more than %u rows.",blockIndex,blockSize);
+        }
+        rowBlocks[i] = b;
+        rowComponents[i] = blockNRows[b]++;
+    }
+
+    uint nBlockRows = uint(blockNRows.size());
+
+    this->rowPositions.assign(size_t(nBlockRows)*blockSize,RConstants::eod);
+    for (uint i=0;i<n;i++)
+    {
+        this->rowPositions[size_t(rowBlocks[i])*blockSize+rowComponents[i]] = i;
+    }
+
+    // Missing components are always trailing, their (zero) columns point to the first component.
+    this->columnPositions = this->rowPositions;
+    this->contiguous = true;
+    for (uint i=0;i<nBlockRows;i++)
+    {
+        uint first = this->rowPositions[size_t(i)*blockSize];
+        for (uint k=0;k<blockNRows[i];k++)
+        {
+            if (this->rowPositions[size_t(i)*blockSize+k] != first + k)
+            {
+                this->contiguous = false;
+            }
+        }
+        for (uint k=blockNRows[i];k<blockSize;k++)
+        {
+            this->columnPositions[size_t(i)*blockSize+k] = first;
+        }
+        if (first + blockSize > n)
+        {
+            this->contiguous = false;
+        }
+    }
+
+    this->blockRowPointers.assign(nBlockRows+1,0);
+
+    size_t blockLength = size_t(blockSize)*blockSize;
+
+#pragma omp parallel default(shared)
+    {
+        // Last block row in which block column was used.
+        std::vector<uint> marks(nBlockRows,RConstants::eod);
+
+        // Count number of blocks in each block row.
+#pragma omp for
+        for (int64_t i=0;i<int64_t(nBlockRows);i++)
+        {
+            uint nBlocks = 0;
+            for (uint c=0;c<blockNRows[i];c++)
+            {
+                uint row = this->rowPositions[size_t(i)*blockSize+c];
+                for (uint k=matrix.getRowBegin(row);k<matrix.getRowEnd(row);k++)
+                {
+                    uint j = rowBlocks[matrix.getColumnIndex(k)];
+                    if (marks[j] != uint(i))
+                    {
+                        marks[j] = uint(i);
+                        nBlocks++;
+                    }
+                }
+            }
+            this->blockRowPointers[i+1] = nBlocks;
+        }
+
+#pragma omp single
+        {
+            for (uint i=0;i<nBlockRows;i++)
+            {
+                this->blockRowPointers[i+1] += this->blockRowPointers[i];
+            }
+            this->blockColumnIndexes.resize(this->blockRowPointers[nBlockRows]);
+            this->values.assign(this->blockColumnIndexes.size()*blockLength,0.0);
+            this->valuePositions.resize(matrix.getNValues());
+        }
+
+        std::fill(marks.begin(),marks.end(),RConstants::eod);
+
+        // Fill block column indexes and values.
+#pragma omp for
+        for (int64_t i=0;i<int64_t(nBlockRows);i++)
+        {
+            uint begin = this->blockRowPointers[i];
+            uint end = this->blockRowPointers[i+1];
+            uint position = begin;
+            for (uint c=0;c<blockNRows[i];c++)
+            {
+                uint row = this->rowPositions[size_t(i)*blockSize+c];
+                for (uint k=matrix.getRowBegin(row);k<matrix.getRowEnd(row);k++)
+                {
+                    uint j = rowBlocks[matrix.getColumnIndex(k)];
+                    if (marks[j] != uint(i))
+                    {
+                        marks[j] = uint(i);
+                        this->blockColumnIndexes[position++] = j;
+                    }
+                }
+            }
+            std::sort(this->blockColumnIndexes.begin()+begin,this->blockColumnIndexes.begin()+end);
+
+            for (uint c=0;c<blockNRows[i];c++)
+            {
+                uint row = this->rowPositions[size_t(i)*blockSize+c];
+                for (uint k=matrix.getRowBegin(row);k<matrix.getRowEnd(row);k++)
+                {
+                    uint column = matrix.getColumnIndex(k);
+                    uint p = uint(std::lower_bound(this->blockColumnIndexes.begin()+begin,this->blockColumnIndexes.begin()+end,rowBlocks[column]) - this->blockColumnIndexes.begin());
+                    this->valuePositions[k] = p*blockLength+c*blockSize+rowComponents[column];
+                    this->values[this->valuePositions[k]] = matrix.getValue(k);
+                }
+            }
+        }
+    }
+}
+
+void RSparseMatrixBSR::updateValues(const RSparseMatrixCSR &matrix)
+{
+    if (matrix.getNValues() != this->valuePositions.size())
+    {
+        throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Number of matrix values (%u) differs from number of values of block matrix source (%u).",
+                     matrix.getNValues(),uint(this->valuePositions.size()));
+    }
+
+#pragma omp parallel for default(shared)
+    for (int64_t k=0;k<int64_t(this->valuePositions.size());k++)
+    {
+        this->values[this->valuePositions[k]] = matrix.getValue(uint(k));
+    }
+}
+
+void RSparseMatrixBSR::findInverseBlockDiagonal(RSparseMatrixBSR &inverseBlockDiagonal) const
+{
+    uint nBlockRows = this->getNBlockRows();
+    uint size = this->blockSize;
+    size_t blockLength = size_t(size)*size;
+
+    inverseBlockDiagonal.blockSize = size;
+    inverseBlockDiagonal.nRows = this->nRows;
+    inverseBlockDiagonal.rowPositions = this->rowPositions;
+    inverseBlockDiagonal.columnPositions = this->columnPositions;
+    inverseBlockDiagonal.contiguous = this->contiguous;
+    inverseBlockDiagonal.valuePositions.clear();
+    inverseBlockDiagonal.blockRowPointers.resize(nBlockRows+1);
+    inverseBlockDiagonal.blockColumnIndexes.resize(nBlockRows);
+    inverseBlockDiagonal.values.assign(nBlockRows*blockLength,0.0);
+
+#pragma omp parallel default(shared)
+    {
+        std::vector<double> block(blockLength);
+
+#pragma omp for
+        for (int64_t i=0;i<int64_t(nBlockRows);i++)
+        {
+            inverseBlockDiagonal.blockRowPointers[i+1] = uint(i+1);
+            inverseBlockDiagonal.blockColumnIndexes[i] = uint(i);
+
+            std::fill(block.begin(),block.end(),0.0);
+
+            uint begin = this->blockRowPointers[i];
+            uint end = this->blockRowPointers[i+1];
+            std::vector<uint>::const_iterator iter = std::lower_bound(this->blockColumnIndexes.begin()+begin,this->blockColumnIndexes.begin()+end,uint(i));
+            if (iter != this->blockColumnIndexes.begin()+end && *iter == uint(i))
+            {
+                size_t p = size_t(iter - this->blockColumnIndexes.begin());
+                std::copy(this->values.begin()+p*blockLength,this->values.begin()+(p+1)*blockLength,block.begin());
+            }
+
+            for (uint c=0;c<size;c++)
+            {
+                if (this->rowPositions[size_t(i)*size+c] == RConstants::eod)
+                {
+                    block[c*size+c] = 1.0;
+                }
+            }
+
+            double *inverse = inverseBlockDiagonal.values.data() + i*blockLength;
+            for (uint c=0;c<size;c++)
+            {
+                inverse[c*size+c] = 1.0;
+            }
+
+            // Gauss-Jordan elimination with partial pivoting.
+            double maxValue = 0.0;
+            for (uint k=0;k<blockLength;k++)
+            {
+                maxValue = std::max(maxValue,std::abs(block[k]));
+            }
+
+            std::vector<double> original(block);
+            bool singular = (maxValue == 0.0);
+
+            for (uint k=0;k<size && !singular;k++)
+            {
+                uint pivotRow = k;
+                for (uint r=k+1;r<size;r++)
+                {
+                    if (std::abs(block[r*size+k]) > std::abs(block[pivotRow*size+k]))
+                    {
+                        pivotRow = r;
+                    }
+                }
+                if (std::abs(block[pivotRow*size+k]) <= RConstants::eps * maxValue)
+                {
+                    singular = true;
+                    break;
+                }
+                if (pivotRow != k)
+                {
+                    for (uint c=0;c<size;c++)
+                    {
+                        std::swap(block[k*size+c],block[pivotRow*size+c]);
+                        std::swap(inverse[k*size+c],inverse[pivotRow*size+c]);
+                    }
+                }
+                double pivot = 1.0 / block[k*size+k];
+                for (uint c=0;c<size;c++)
+                {
+                    block[k*size+c] *= pivot;
+                    inverse[k*size+c] *= pivot;
+                }
+                for (uint r=0;r<size;r++)
+                {
+                    double factor = block[r*size+k];
+                    if (r == k || factor == 0.0)
+                    {
+                        continue;
+                    }
+                    for (uint c=0;c<size;c++)
+                    {
+                        block[r*size+c] -= factor * block[k*size+c];
+                        inverse[r*size+c] -= factor * inverse[k*size+c];
+                    }
+                }
+            }
+
+            if (singular)
+            {
+                std::fill(inverse,inverse+blockLength,0.0);
+                for (uint c=0;c<size;c++)
+                {
+                    double d = original[c*size+c];
+                    inverse[c*size+c] = (d == 0.0) ? 1.0 : 1.0 / d;
+                }
+            }
+        }
+    }
+    inverseBlockDiagonal.blockRowPointers[0] = 0;
+}
+
+void RSparseMatrixBSR::clear(void)
+{
+    this->blockSize = 1;
+    this->nRows = 0;
+    this->blockRowPointers.clear();
+    this->blockColumnIndexes.clear();
+    this->values.clear();
+    this->rowPositions.clear();
+    this->columnPositions.clear();
+    this->contiguous = true;
+    this->valuePositions.clear();
+}
+
+void RSparseMatrixBSR::mlt(const RSparseMatrixBSR &A, const RRVector &x, RRVector &y)
+{
+#pragma omp single
+    y.resize(A.getNRows(),0.0);
+
+    if (!A.contiguous)
+    {
+        RSparseMatrixBSR::mltGeneric(A,x,y);
+        return;
+    }
+
+    switch (A.getBlockSize())
+    {
+        case 3:
+            RSparseMatrixBSR::mltFixed<3>(A,x,y);
+            break;
+        case 4:
+            RSparseMatrixBSR::mltFixed<4>(A,x,y);
+            break;
+        default:
+            RSparseMatrixBSR::mltGeneric(A,x,y);
+            break;
+    }
+}
+
+//! Dense block times vector product accumulated to y (y += B*x).
+template <uint size>
+static inline void mltBlock(const double *pBlock, const double *x, double *y)
+{
+    for (uint r=0;r<size;r++)
+    {
+        for (uint c=0;c<size;c++)
+        {
+            y[r] += pBlock[r*size+c] * x[c];
+        }
+    }
+}
+
+template <>
+inline void mltBlock<3>(const double *pBlock, const double *x, double *y)
+{
+    y[0] += pBlock[0] * x[0] + pBlock[1] * x[1] + pBlock[2] * x[2];
+    y[1] += pBlock[3] * x[0] + pBlock[4] * x[1] + pBlock[5] * x[2];
+    y[2] += pBlock[6] * x[0] + pBlock[7] * x[1] + pBlock[8] * x[2];
+}
+
+template <>
+inline void mltBlock<4>(const double *pBlock, const double *x, double *y)
+{
+    y[0] += pBlock[0]  * x[0] + pBlock[1]  * x[1] + pBlock[2]  * x[2] + pBlock[3]  * x[3];
+    y[1] += pBlock[4]  * x[0] + pBlock[5]  * x[1] + pBlock[6]  * x[2] + pBlock[7]  * x[3];
+    y[2] += pBlock[8]  * x[0] + pBlock[9]  * x[1] + pBlock[10] * x[2] + pBlock[11] * x[3];
+    y[3] += pBlock[12] * x[0] + pBlock[13] * x[1] + pBlock[14] * x[2] + pBlock[15] * x[3];
+}
+
+template <uint size>
+void RSparseMatrixBSR::mltFixed(const RSparseMatrixBSR &A, const RRVector &x, RRVector &y)
+{
+    const uint *pRow = A.blockRowPointers.data();
+    const uint *pIndex = A.blockColumnIndexes.data();
+    const double *pValue = A.values.data();
+    const uint *pRowPosition = A.rowPositions.data();
+    const uint *pColumnPosition = A.columnPositions.data();
+    const double *pX = x.data();
+    double *pY = y.data();
+
+#pragma omp for
+    for (int64_t i=0;i<int64_t(A.getNBlockRows());i++)
+    {
+        double value[size] = {};
+        for (uint k=pRow[i];k<pRow[i+1];k++)
+        {
+            mltBlock<size>(pValue + size_t(k)*size*size,pX + pColumnPosition[size_t(pIndex[k])*size],value);
+        }
+        for (uint r=0;r<size;r++)
+        {
+            uint row = pRowPosition[size_t(i)*size+r];
+            if (row != RConstants::eod)
+            {
+                pY[row] = value[r];
+            }
+        }
+    }
+}
+
+void RSparseMatrixBSR::mltGeneric(const RSparseMatrixBSR &A, const RRVector &x, RRVector &y)
+{
+    uint size = A.getBlockSize();
+
+    const uint *pRow = A.blockRowPointers.data();
+    const uint *pIndex = A.blockColumnIndexes.data();
+    const double *pValue = A.values.data();
+    const uint *pRowPosition = A.rowPositions.data();
+    const uint *pColumnPosition = A.columnPositions.data();
+    const double *pX = x.data();
+    double *pY = y.data();
+
+    std::vector<double> value(size);
+
+#pragma omp for
+    for (int64_t i=0;i<int64_t(A.getNBlockRows());i++)
+    {
+        std::fill(value.begin(),value.end(),0.0);
+        for (uint k=pRow[i];k<pRow[i+1];k++)
+        {
+            const double *pBlock = pValue + size_t(k)*size*size;
+            const uint *pColumn = pColumnPosition + size_t(pIndex[k])*size;
+            for (uint r=0;r<size;r++)
+            {
+                for (uint c=0;c<size;c++)
+                {
+                    value[r] += pBlock[r*size+c] * pX[pColumn[c]];
+                }
+            }
+        }
+        for (uint r=0;r<size;r++)
+        {
+            uint row = pRowPosition[size_t(i)*size+r];
+            if (row != RConstants::eod)
+            {
+                pY[row] = value[r];
+            }
+        }
+    }
+}
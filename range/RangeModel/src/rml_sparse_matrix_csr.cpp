@@ -0,0 +1,316 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_sparse_matrix_csr.cpp                                *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Compressed sparse row matrix class definition       *
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <omp.h>
+
+#include <rblib.h>
+
+#include "rml_sparse_matrix_csr.h"
+
+void RSparseMatrixCSR::_init(const RSparseMatrixCSR *pMatrix)
+{
+    if (pMatrix)
+    {
+        this->rowPointers = pMatrix->rowPointers;
+        this->columnIndexes = pMatrix->columnIndexes;
+        this->values = pMatrix->values;
+    }
+}
+
+RSparseMatrixCSR::RSparseMatrixCSR()
+{
+    this->_init();
+}
+
+RSparseMatrixCSR::RSparseMatrixCSR(const RSparseMatrix &matrix)
+{
+    this->_init();
+    this->build(matrix);
+}
+
+RSparseMatrixCSR::RSparseMatrixCSR(const RSparseMatrixCSR &matrix)
+{
+    this->_init(&matrix);
+}
+
+RSparseMatrixCSR::~RSparseMatrixCSR()
+{
+}
+
+RSparseMatrixCSR &RSparseMatrixCSR::operator =(const RSparseMatrixCSR &matrix)
+{
+    this->_init(&matrix);
+    return (*this);
+}
+
+void RSparseMatrixCSR::build(const RSparseMatrix &matrix)
+{
+    uint nRows = matrix.getNRows();
+
+    this->rowPointers.resize(nRows+1);
+    this->rowPointers[0] = 0;
+    for (uint i=0;i<nRows;i++)
+    {
+        this->rowPointers[i+1] = this->rowPointers[i] + matrix.getNColumns(i);
+    }
+
+    this->columnIndexes.resize(this->rowPointers[nRows]);
+    this->values.resize(this->rowPointers[nRows]);
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nRows);i++)
+    {
+        const RSparseVector<double> &row = matrix.getVector(uint(i));
+        uint position = this->rowPointers[i];
+        for (uint j=0;j<row.size();j++)
+        {
+            this->columnIndexes[position+j] = row.getIndex(j);
+            this->values[position+j] = row.getValue(j);
+        }
+    }
+}
+
+void RSparseMatrixCSR::build(const std::vector<uint> &rowPointers, const std::vector<uint> &columnIndexes, const std::vector<double> &values)
+{
+    R_ERROR_ASSERT(!rowPointers.empty());
+    R_ERROR_ASSERT(rowPointers.back() == columnIndexes.size());
+    R_ERROR_ASSERT(columnIndexes.size() == values.size());
+
+    this->rowPointers = rowPointers;
+    this->columnIndexes = columnIndexes;
+    this->values = values;
+}
+
+uint RSparseMatrixCSR::findNColumns(void) const
+{
+    uint nColumns = 0;
+    for (uint k=0;k<this->columnIndexes.size();k++)
+    {
+        nColumns = std::max(nColumns,this->columnIndexes[k]+1);
+    }
+    return nColumns;
+}
+
+const std::vector<uint> &RSparseMatrixCSR::getRowPointers(void) const
+{
+    return this->rowPointers;
+}
+
+const std::vector<uint> &RSparseMatrixCSR::getColumnIndexes(void) const
+{
+    return this->columnIndexes;
+}
+
+const std::vector<double> &RSparseMatrixCSR::getValues(void) const
+{
+    return this->values;
+}
+
+bool RSparseMatrixCSR::findPosition(uint rowIndex, uint columnIndex, uint &position) const
+{
+    std::vector<uint>::const_iterator first = this->columnIndexes.begin() + this->rowPointers[rowIndex];
+    std::vector<uint>::const_iterator last = this->columnIndexes.begin() + this->rowPointers[rowIndex+1];
+    std::vector<uint>::const_iterator iter = std::lower_bound(first,last,columnIndex);
+
+    if (iter == last || *iter != columnIndex)
+    {
+        return false;
+    }
+    position = uint(iter - this->columnIndexes.begin());
+    return true;
+}
+
+double RSparseMatrixCSR::findValue(uint rowIndex, uint columnIndex) const
+{
+    uint position = 0;
+    if (this->findPosition(rowIndex,columnIndex,position))
+    {
+        return this->values[position];
+    }
+    return 0.0;
+}
+
+RRVector RSparseMatrixCSR::getDiagonal(void) const
+{
+    uint nRows = this->getNRows();
+    RRVector d(nRows,0.0);
+
+    for (uint i=0;i<nRows;i++)
+    {
+        d[i] = this->findValue(i,i);
+    }
+
+    return d;
+}
+
+double RSparseMatrixCSR::findNorm(void) const
+{
+    uint nRows = this->getNRows();
+    double norm = 0.0;
+
+#pragma omp parallel for default(shared) reduction(+:norm)
+    for (int64_t i=0;i<int64_t(nRows);i++)
+    {
+        double rowSum = 0.0;
+        for (uint k=this->rowPointers[i];k<this->rowPointers[i+1];k++)
+        {
+            rowSum += this->values[k];
+        }
+        norm += rowSum * rowSum;
+    }
+
+    return std::sqrt(norm);
+}
+
+void RSparseMatrixCSR::clear(void)
+{
+    this->rowPointers.clear();
+    this->columnIndexes.clear();
+    this->values.clear();
+}
+
+void RSparseMatrixCSR::mlt(const RSparseMatrixCSR &A, const RRVector &x, RRVector &y)
+{
+#pragma omp single
+    y.resize(A.getNRows(),0.0);
+
+    const uint *pRow = A.rowPointers.data();
+    const uint *pIndex = A.columnIndexes.data();
+    const double *pValue = A.values.data();
+    const double *pX = x.data();
+    double *pY = y.data();
+
+#pragma omp for
+    for (int64_t i=0;i<int64_t(A.getNRows());i++)
+    {
+        double value = 0.0;
+        for (uint k=pRow[i];k<pRow[i+1];k++)
+        {
+            value += pValue[k] * pX[pIndex[k]];
+        }
+        pY[i] = value;
+    }
+}
+
+void RSparseMatrixCSR::mlt(const RSparseMatrixCSR &A, const RSparseMatrixCSR &B, RSparseMatrixCSR &C)
+{
+    uint nRows = A.getNRows();
+    uint nColumns = B.findNColumns();
+
+    C.rowPointers.assign(nRows+1,0);
+
+#pragma omp parallel default(shared)
+    {
+        // Last row in which column was used.
+        std::vector<uint> marks(nColumns,RConstants::eod);
+        // Accumulated values of currently processed row.
+        std::vector<double> accumulator(nColumns,0.0);
+
+        // Count number of values in each row.
+#pragma omp for
+        for (int64_t i=0;i<int64_t(nRows);i++)
+        {
+            uint nValues = 0;
+            for (uint k=A.rowPointers[i];k<A.rowPointers[i+1];k++)
+            {
+                uint r = A.columnIndexes[k];
+                for (uint l=B.rowPointers[r];l<B.rowPointers[r+1];l++)
+                {
+                    uint j = B.columnIndexes[l];
+                    if (marks[j] != uint(i))
+                    {
+                        marks[j] = uint(i);
+                        nValues++;
+                    }
+                }
+            }
+            C.rowPointers[i+1] = nValues;
+        }
+
+#pragma omp single
+        {
+            for (uint i=0;i<nRows;i++)
+            {
+                C.rowPointers[i+1] += C.rowPointers[i];
+            }
+            C.columnIndexes.resize(C.rowPointers[nRows]);
+            C.values.resize(C.rowPointers[nRows]);
+        }
+
+        std::fill(marks.begin(),marks.end(),RConstants::eod);
+
+        // Compute values.
+#pragma omp for
+        for (int64_t i=0;i<int64_t(nRows);i++)
+        {
+            uint rowBegin = C.rowPointers[i];
+            uint rowEnd = C.rowPointers[i+1];
+            uint nValues = 0;
+            for (uint k=A.rowPointers[i];k<A.rowPointers[i+1];k++)
+            {
+                uint r = A.columnIndexes[k];
+                double a = A.values[k];
+                for (uint l=B.rowPointers[r];l<B.rowPointers[r+1];l++)
+                {
+                    uint j = B.columnIndexes[l];
+                    if (marks[j] != uint(i))
+                    {
+                        marks[j] = uint(i);
+                        C.columnIndexes[rowBegin + nValues] = j;
+                        accumulator[j] = a * B.values[l];
+                        nValues++;
+                    }
+                    else
+                    {
+                        accumulator[j] += a * B.values[l];
+                    }
+                }
+            }
+
+            std::sort(C.columnIndexes.begin()+rowBegin,C.columnIndexes.begin()+rowEnd);
+            for (uint p=rowBegin;p<rowEnd;p++)
+            {
+                C.values[p] = accumulator[C.columnIndexes[p]];
+            }
+        }
+    }
+}
+
+void RSparseMatrixCSR::transpose(const RSparseMatrixCSR &A, uint nColumns, RSparseMatrixCSR &At)
+{
+    uint nRows = A.getNRows();
+
+    At.rowPointers.assign(nColumns+1,0);
+    for (uint k=0;k<A.columnIndexes.size();k++)
+    {
+        At.rowPointers[A.columnIndexes[k]+1]++;
+    }
+    for (uint j=0;j<nColumns;j++)
+    {
+        At.rowPointers[j+1] += At.rowPointers[j];
+    }
+
+    At.columnIndexes.resize(A.columnIndexes.size());
+    At.values.resize(A.values.size());
+
+    std::vector<uint> positions(At.rowPointers.begin(),At.rowPointers.end()-1);
+    for (uint i=0;i<nRows;i++)
+    {
+        for (uint k=A.rowPointers[i];k<A.rowPointers[i+1];k++)
+        {
+            uint position = positions[A.columnIndexes[k]]++;
+            At.columnIndexes[position] = i;
+            At.values[position] = A.values[k];
+        }
+    }
+}
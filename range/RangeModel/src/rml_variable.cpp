@@ -478,6 +478,19 @@ void RVariable::removeValues(const std::vector<uint> &valueBook)
 } /* RVariable::removeValues */
 
 
+void RVariable::reorderValues(const std::vector<uint> &valueBook)
+{
+    std::vector<RValueVector>::iterator iter;
+
+    for (iter = this->values.begin();
+         iter != this->values.end();
+         ++iter)
+    {
+        iter->reorder(valueBook);
+    }
+} /* RVariable::reorderValues */
+
+
 const RVariableData &RVariable::getVariableData(void) const
 {
     return this->variableData;
@@ -18,12 +18,19 @@ void RViewFactorMatrixHeader::_init(const RViewFactorMatrixHeader *pViewFactorMa
     {
         this->patchInput = pViewFactorMatrixHeader->patchInput;
         this->hemicubeResolution = pViewFactorMatrixHeader->hemicubeResolution;
+        this->viewFactorMethod = pViewFactorMatrixHeader->viewFactorMethod;
+        this->viewFactorCorrection = pViewFactorMatrixHeader->viewFactorCorrection;
+        this->viewFactorThreshold = pViewFactorMatrixHeader->viewFactorThreshold;
         this->nElements = pViewFactorMatrixHeader->nElements;
+        this->patchHashes = pViewFactorMatrixHeader->patchHashes;
     }
 }
 
 RViewFactorMatrixHeader::RViewFactorMatrixHeader()
     : hemicubeResolution(R_RADIATION_RESOLUTION_MEDIUM)
+    , viewFactorMethod(R_VIEW_FACTOR_METHOD_HEMICUBE)
+    , viewFactorCorrection(false)
+    , viewFactorThreshold(0.0)
     , nElements(0)
 {
     this->_init();
@@ -62,10 +69,26 @@ bool RViewFactorMatrixHeader::operator ==(const RViewFactorMatrixHeader &viewFac
     {
         return false;
     }
+    if (this->viewFactorMethod != viewFactorMatrixHeader.viewFactorMethod)
+    {
+        return false;
+    }
+    if (this->viewFactorCorrection != viewFactorMatrixHeader.viewFactorCorrection)
+    {
+        return false;
+    }
+    if (this->viewFactorThreshold != viewFactorMatrixHeader.viewFactorThreshold)
+    {
+        return false;
+    }
     if (this->nElements != viewFactorMatrixHeader.nElements)
     {
         return false;
     }
+    if (this->patchHashes != viewFactorMatrixHeader.patchHashes)
+    {
+        return false;
+    }
     return true;
 }
 
@@ -94,6 +117,36 @@ void RViewFactorMatrixHeader::setHemicubeResolution(unsigned int hemicubeResolut
     this->hemicubeResolution = hemicubeResolution;
 }
 
+RViewFactorMethod RViewFactorMatrixHeader::getViewFactorMethod(void) const
+{
+    return this->viewFactorMethod;
+}
+
+void RViewFactorMatrixHeader::setViewFactorMethod(RViewFactorMethod viewFactorMethod)
+{
+    this->viewFactorMethod = viewFactorMethod;
+}
+
+bool RViewFactorMatrixHeader::getViewFactorCorrection(void) const
+{
+    return this->viewFactorCorrection;
+}
+
+void RViewFactorMatrixHeader::setViewFactorCorrection(bool viewFactorCorrection)
+{
+    this->viewFactorCorrection = viewFactorCorrection;
+}
+
+double RViewFactorMatrixHeader::getViewFactorThreshold(void) const
+{
+    return this->viewFactorThreshold;
+}
+
+void RViewFactorMatrixHeader::setViewFactorThreshold(double viewFactorThreshold)
+{
+    this->viewFactorThreshold = viewFactorThreshold;
+}
+
 unsigned int RViewFactorMatrixHeader::getNElements(void) const
 {
     return this->nElements;
@@ -104,8 +157,22 @@ void RViewFactorMatrixHeader::setNElements(unsigned int nElements)
     this->nElements = nElements;
 }
 
+const std::vector<quint64> &RViewFactorMatrixHeader::getPatchHashes(void) const
+{
+    return this->patchHashes;
+}
+
+std::vector<quint64> &RViewFactorMatrixHeader::getPatchHashes(void)
+{
+    return this->patchHashes;
+}
+
 void RViewFactorMatrixHeader::clear(void)
 {
     this->hemicubeResolution = 0;
+    this->viewFactorMethod = R_VIEW_FACTOR_METHOD_HEMICUBE;
+    this->viewFactorCorrection = false;
+    this->viewFactorThreshold = 0.0;
     this->patchInput.clear();
+    this->patchHashes.clear();
 }
@@ -39,6 +39,9 @@ void MainTask::run(void)
         validOptions.append(RArgumentOption("log-file",RArgumentOption::Path,QVariant(),"Log file name",false,false));
         validOptions.append(RArgumentOption("convergence-file",RArgumentOption::Path,QVariant(),"Convergence file name",false,false));
         validOptions.append(RArgumentOption("monitoring-file",RArgumentOption::Path,QVariant(),"Monitoring file name",false,false));
+        validOptions.append(RArgumentOption("matrix-system-file",RArgumentOption::Path,QVariant(),"Dump each solved matrix system to file (rbs, rts or mtx extension)",false,false));
+        validOptions.append(RArgumentOption("matrix-free",RArgumentOption::Switch,QVariant(),"Solve heat and acoustic matrix systems without assembled matrix",false,false));
+        validOptions.append(RArgumentOption("node-ordering",RArgumentOption::String,QVariant("none"),"Node ordering used when numbering unknowns (none, rcm, nd)",false,false));
         validOptions.append(RArgumentOption("nthreads",RArgumentOption::Integer,QVariant(1),"Number of threads to use",false,false));
         validOptions.append(RArgumentOption("restart",RArgumentOption::Switch,QVariant(),"Restart solver",false,false));
         validOptions.append(RArgumentOption("task-id",RArgumentOption::Path,QVariant(),"Task ID for inter process communication",false,false));
@@ -89,6 +92,24 @@ void MainTask::run(void)
         {
             solverInput.setMonitoringFileName(argumentsParser.getValue("monitoring-file").toString());
         }
+        if (argumentsParser.isSet("matrix-system-file"))
+        {
+            solverInput.setMatrixSystemFileName(argumentsParser.getValue("matrix-system-file").toString());
+        }
+        if (argumentsParser.isSet("matrix-free"))
+        {
+            solverInput.setMatrixFree(true);
+        }
+        if (argumentsParser.isSet("node-ordering"))
+        {
+            QString nodeOrderingId = argumentsParser.getValue("node-ordering").toString();
+            RNodeOrderingType nodeOrdering = RMatrixSolverConf::findNodeOrdering(nodeOrderingId);
+            if (!R_NODE_ORDERING_TYPE_IS_VALID(nodeOrdering))
+            {
+                throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Unknown node ordering \"%s\".",nodeOrderingId.toUtf8().constData());
+            }
+            solverInput.setNodeOrdering(nodeOrdering);
+        }
         if (argumentsParser.isSet("nthreads"))
         {
             solverInput.setNThreads(argumentsParser.getValue("nthreads").toUInt());
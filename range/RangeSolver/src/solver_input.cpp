@@ -16,12 +16,17 @@ void SolverInput::_init(const SolverInput *pSolverInput)
     {
         this->modelFileName = pSolverInput->modelFileName;
         this->convergenceFileName = pSolverInput->convergenceFileName;
+        this->matrixSystemFileName = pSolverInput->matrixSystemFileName;
+        this->matrixFree = pSolverInput->matrixFree;
+        this->nodeOrdering = pSolverInput->nodeOrdering;
         this->restart = pSolverInput->restart;
     }
 }
 
 SolverInput::SolverInput(const QString &modelFileName)
     : modelFileName(modelFileName)
+    , matrixFree(false)
+    , nodeOrdering(R_NODE_ORDERING_NONE)
     , restart(false)
 {
     this->_init();
@@ -53,6 +58,21 @@ void SolverInput::setMonitoringFileName(const QString &monitoringFileName)
     this->monitoringFileName = monitoringFileName;
 }
 
+void SolverInput::setMatrixSystemFileName(const QString &matrixSystemFileName)
+{
+    this->matrixSystemFileName = matrixSystemFileName;
+}
+
+void SolverInput::setMatrixFree(bool matrixFree)
+{
+    this->matrixFree = matrixFree;
+}
+
+void SolverInput::setNodeOrdering(RNodeOrderingType nodeOrdering)
+{
+    this->nodeOrdering = nodeOrdering;
+}
+
 void SolverInput::setNThreads(uint nThreads)
 {
     this->nThreads = nThreads;
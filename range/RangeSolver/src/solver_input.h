@@ -13,6 +13,8 @@
 
 #include <QString>
 
+#include <rmlib.h>
+
 class SolverTask;
 
 class SolverInput
@@ -26,6 +28,12 @@ class SolverInput
         QString convergenceFileName;
         //! Monitoring file.
         QString monitoringFileName;
+        //! Matrix system dump file.
+        QString matrixSystemFileName;
+        //! Solve matrix systems without assembled matrix.
+        bool matrixFree;
+        //! Node ordering used when numbering unknowns.
+        RNodeOrderingType nodeOrdering;
         //! Number of threads to use.
         uint nThreads;
         //! Force to restart solver
@@ -56,6 +64,15 @@ class SolverInput
         //! Set monitoring file name.
         void setMonitoringFileName(const QString &monitoringFileName);
 
+        //! Set matrix system dump file name.
+        void setMatrixSystemFileName(const QString &matrixSystemFileName);
+
+        //! Set whether matrix systems are solved without assembled matrix.
+        void setMatrixFree(bool matrixFree);
+
+        //! Set node ordering used when numbering unknowns.
+        void setNodeOrdering(RNodeOrderingType nodeOrdering);
+
         //! Set number of threads to use.
         void setNThreads(uint nThreads);
 
@@ -22,6 +22,9 @@ SolverTask::SolverTask(const SolverInput &solverInput, QCoreApplication *app, QO
     , modelFileName(solverInput.modelFileName)
     , convergenceFileName(solverInput.convergenceFileName)
     , monitoringFileName(solverInput.monitoringFileName)
+    , matrixSystemFileName(solverInput.matrixSystemFileName)
+    , matrixFree(solverInput.matrixFree)
+    , nodeOrdering(solverInput.nodeOrdering)
     , nThreads(solverInput.nThreads)
     , restart(solverInput.restart)
     , app(app)
@@ -54,6 +57,12 @@ void SolverTask::run(void)
 
     model.getMatrixSolverConf(RMatrixSolverConf::CG).setOutputFileName(RFileManager::getFileNameWithSuffix(this->convergenceFileName,RMatrixSolverConf::getId(RMatrixSolverConf::CG)));
     model.getMatrixSolverConf(RMatrixSolverConf::GMRES).setOutputFileName(RFileManager::getFileNameWithSuffix(this->convergenceFileName,RMatrixSolverConf::getId(RMatrixSolverConf::GMRES)));
+    model.getMatrixSolverConf(RMatrixSolverConf::CG).setSystemFileName(this->matrixSystemFileName);
+    model.getMatrixSolverConf(RMatrixSolverConf::GMRES).setSystemFileName(this->matrixSystemFileName);
+    model.getMatrixSolverConf(RMatrixSolverConf::CG).setMatrixFree(this->matrixFree);
+    model.getMatrixSolverConf(RMatrixSolverConf::GMRES).setMatrixFree(this->matrixFree);
+    model.getMatrixSolverConf(RMatrixSolverConf::CG).setNodeOrdering(this->nodeOrdering);
+    model.getMatrixSolverConf(RMatrixSolverConf::GMRES).setNodeOrdering(this->nodeOrdering);
     model.getMonitoringPointManager().setOutputFileName(this->monitoringFileName);
     if (this->restart)
     {
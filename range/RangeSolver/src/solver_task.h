@@ -29,6 +29,12 @@ class SolverTask : public QObject
         QString convergenceFileName;
         //! Monitoring file name.
         QString monitoringFileName;
+        //! Matrix system dump file name.
+        QString matrixSystemFileName;
+        //! Solve matrix systems without assembled matrix.
+        bool matrixFree;
+        //! Node ordering used when numbering unknowns.
+        RNodeOrderingType nodeOrdering;
         //! Number of threads to use.
         uint nThreads;
         //! Force to restart solver
@@ -25,18 +25,24 @@ DEFINES += RANGESOLVERLIB_LIBRARY
 INCLUDEPATH += include
 
 SOURCES += \
+    src/ralgebraicmultigrid.cpp \
     src/rconvection.cpp \
     src/reigenvaluesolver.cpp \
+    src/relementmatrixoperator.cpp \
+    src/rgraphordering.cpp \
     src/rhemicube.cpp \
     src/rhemicubepixel.cpp \
+    src/rhemicubescene.cpp \
     src/rhemicubesector.cpp \
     src/riterationinfo.cpp \
     src/riterationinfovalue.cpp \
     src/rlocalrotation.cpp \
     src/rmatrixmanager.cpp \
+    src/rmatrixoperator.cpp \
     src/rmatrixpreconditioner.cpp \
     src/rmatrixsolver.cpp \
     src/rscales.cpp \
+    src/rsingleprecisionmatrixoperator.cpp \
     src/rsolver.cpp \
     src/rsolveracoustic.cpp \
     src/rsolverelectrostatics.cpp \
@@ -50,21 +56,30 @@ SOURCES += \
     src/rsolverradiativeheat.cpp \
     src/rsolvershareddata.cpp \
     src/rsolverstress.cpp \
-    src/rsolverwave.cpp
+    src/rsolverwave.cpp \
+    src/rsparsedirectsolver.cpp \
+    src/rsparsematrixoperator.cpp \
+    src/rviewfactorraytracer.cpp
 
 HEADERS += \
+    include/ralgebraicmultigrid.h \
     include/rconvection.h \
     include/reigenvaluesolver.h \
+    include/relementmatrixoperator.h \
+    include/rgraphordering.h \
     include/rhemicube.h \
     include/rhemicubepixel.h \
+    include/rhemicubescene.h \
     include/rhemicubesector.h \
     include/riterationinfo.h \
     include/riterationinfovalue.h \
     include/rlocalrotation.h \
     include/rmatrixmanager.h \
+    include/rmatrixoperator.h \
     include/rmatrixpreconditioner.h \
     include/rmatrixsolver.h \
     include/rscales.h \
+    include/rsingleprecisionmatrixoperator.h \
     include/rsolver.h \
     include/rsolveracoustic.h \
     include/rsolverelectrostatics.h \
@@ -79,7 +94,10 @@ HEADERS += \
     include/rsolverradiativeheat.h \
     include/rsolvershareddata.h \
     include/rsolverstress.h \
-    include/rsolverwave.h
+    include/rsolverwave.h \
+    include/rsparsedirectsolver.h \
+    include/rsparsematrixoperator.h \
+    include/rviewfactorraytracer.h
 
 CONFIG -= debug_and_release
 CONFIG += copy_dir_files
@@ -0,0 +1,127 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   ralgebraicmultigrid.h                                    *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Algebraic multigrid class declaration               *
+ *********************************************************************/
+
+#ifndef RALGEBRAICMULTIGRID_H
+#define RALGEBRAICMULTIGRID_H
+
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+/*
+ * Smoothed aggregation algebraic multigrid (SA-AMG).
+ *
+ * Matrix rows are grouped into blocks (nodes). Blocks are aggregated based on
+ * strength of connection. Tentative prolongator interpolates near null space
+ * vectors (constant for scalar problems, rigid body modes for elasticity)
+ * exactly on every aggregate and is smoothed by one damped Jacobi step.
+ * Coarse level matrix is computed as Galerkin product R*A*P, where R=P^T.
+ *
+ * Preconditioner is applied as one symmetric V-cycle with damped Jacobi smoother.
+ */
+
+class RAlgebraicMultigrid
+{
+
+    protected:
+
+        //! Fine level matrix. Matrix is not owned and must outlive the multigrid.
+        const RSparseMatrixCSR *pMatrix;
+        //! Matrices on coarse levels (level 1 and higher).
+        std::vector<RSparseMatrixCSR> coarseMatrices;
+        //! Prolongators from level l+1 to level l.
+        std::vector<RSparseMatrixCSR> prolongators;
+        //! Restrictors from level l to level l+1.
+        std::vector<RSparseMatrixCSR> restrictors;
+        //! Smoother weights (damping factor divided by diagonal) on each level.
+        std::vector<RRVector> smootherWeights;
+        //! LU factorization of coarsest level matrix.
+        RRMatrix coarseLU;
+        //! Row permutation of coarsest level LU factorization.
+        std::vector<uint> coarsePivots;
+
+        //! Right hand side vectors on each level.
+        mutable std::vector<RRVector> levelB;
+        //! Solution vectors on each level.
+        mutable std::vector<RRVector> levelX;
+        //! Residual vectors on each level.
+        mutable std::vector<RRVector> levelR;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RAlgebraicMultigrid *pAlgebraicMultigrid = nullptr);
+
+    public:
+
+        //! Constructor.
+        RAlgebraicMultigrid();
+
+        //! Copy constructor.
+        RAlgebraicMultigrid(const RAlgebraicMultigrid &algebraicMultigrid);
+
+        //! Destructor.
+        ~RAlgebraicMultigrid();
+
+        //! Assignment operator.
+        RAlgebraicMultigrid & operator =(const RAlgebraicMultigrid &algebraicMultigrid);
+
+        //! Build multigrid hierarchy.
+        //! Each vector in nearNullSpace must have size equal to number of matrix rows.
+        //! If nearNullSpace is empty, constant vector for each of blockSize components is used.
+        //! rowBlockIndexes assigns each row to a block (node), if empty consecutive groups of blockSize rows are used.
+        void build(const RSparseMatrixCSR &matrix,
+                   unsigned int blockSize = 1,
+                   const std::vector<RRVector> &nearNullSpace = std::vector<RRVector>(),
+                   const std::vector<uint> &rowBlockIndexes = std::vector<uint>());
+
+        //! Return number of levels.
+        uint getNLevels(void) const;
+
+        //! Apply one V-cycle to equation system A*x=b with zero initial guess.
+        //! When called from inside of an OpenMP parallel region rows are distributed among threads.
+        void compute(const RRVector &b, RRVector &x) const;
+
+    protected:
+
+        //! Return matrix on given level.
+        const RSparseMatrixCSR & getMatrix(uint level) const;
+
+        //! Find aggregates of blocks.
+        //! Returns number of aggregates, blocks which are not strongly connected to any other block are not aggregated.
+        static uint findAggregates(const RSparseMatrixCSR &matrix, const std::vector<uint> &rowBlockIndexes, uint nBlocks, double strengthThreshold, std::vector<uint> &blockAggregates);
+
+        //! Build tentative prolongator and coarse level near null space.
+        static void buildTentativeProlongator(const std::vector<RRVector> &nearNullSpace,
+                                              const std::vector<uint> &rowBlockIndexes,
+                                              const std::vector<uint> &blockAggregates,
+                                              uint nAggregates,
+                                              RSparseMatrixCSR &tentativeProlongator,
+                                              std::vector<RRVector> &coarseNearNullSpace);
+
+        //! Estimate spectral radius of D^-1*A by power iteration.
+        static double estimateSpectralRadius(const RSparseMatrixCSR &matrix, const RRVector &invDiagonal);
+
+        //! Factorize coarsest level matrix.
+        void factorizeCoarseMatrix(void);
+
+        //! Apply V-cycle on given level.
+        void cycle(uint level, const RRVector &b, RRVector &x) const;
+
+        //! Perform damped Jacobi smoothing sweeps.
+        void smooth(uint level, const RRVector &b, RRVector &x, uint nSweeps, bool zeroInitialGuess) const;
+
+        //! Solve coarsest level equation system.
+        void solveCoarse(const RRVector &b, RRVector &x) const;
+
+};
+
+#endif // RALGEBRAICMULTIGRID_H
@@ -0,0 +1,118 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   relementmatrixoperator.h                                 *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Element matrix operator class declaration           *
+ *********************************************************************/
+
+#ifndef RELEMENTMATRIXOPERATOR_H
+#define RELEMENTMATRIXOPERATOR_H
+
+#include <vector>
+
+#include <rmlib.h>
+
+#include "rmatrixoperator.h"
+
+/*
+ * Matrix free operator. Global matrix is never assembled, matrix vector
+ * product is computed element by element from stored element matrices.
+ * Symmetric element matrices store only upper triangle. Elements are
+ * processed in batches of elements which do not share any matrix row so
+ * that scatter to the result vector needs no synchronization.
+ */
+
+class RElementMatrixOperator : public RMatrixOperator
+{
+
+    protected:
+
+        //! Number of rows.
+        uint nRows;
+        //! Store only upper triangle of element matrices.
+        bool symmetric;
+        //! Position of first element in each batch (size = nBatches + 1).
+        std::vector<uint> batchPointers;
+        //! Elements ordered by batches.
+        std::vector<uint> batchElements;
+        //! Offset of element matrix rows in positions array (size = nElements + 1).
+        std::vector<uint> positionOffsets;
+        //! Offset of element matrix values in values array (size = nElements + 1).
+        std::vector<quint64> valueOffsets;
+        //! Global matrix row of each element matrix row (RConstants::eod if row is not part of the system).
+        std::vector<uint> positions;
+        //! Element matrix values.
+        std::vector<double> values;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RElementMatrixOperator *pElementMatrixOperator = nullptr);
+
+    public:
+
+        //! Constructor.
+        RElementMatrixOperator();
+
+        //! Copy constructor.
+        RElementMatrixOperator(const RElementMatrixOperator &elementMatrixOperator);
+
+        //! Destructor.
+        ~RElementMatrixOperator();
+
+        //! Assignment operator.
+        RElementMatrixOperator & operator =(const RElementMatrixOperator &elementMatrixOperator);
+
+        //! Allocate storage for element matrices.
+        //! elementSizes holds number of rows of each element matrix (0 if element is not used).
+        //! Elements within one batch must not share any matrix row.
+        void build(uint nRows,
+                   const std::vector<uint> &elementSizes,
+                   const std::vector< std::vector<uint> > &elementBatches,
+                   bool symmetric);
+
+        //! Clear operator and release memory.
+        void clear(void);
+
+        //! Set all element matrix values to zero while layout is kept.
+        void clearValues(void);
+
+        //! Return number of elements.
+        uint getNElements(void) const;
+
+        //! Return size of stored data in bytes.
+        quint64 getMemorySize(void) const;
+
+        //! Set element matrix.
+        //! elementPositions holds global matrix row of each element matrix row (RConstants::eod if not part of the system).
+        //! If operator is symmetric only upper triangle of Ae is used.
+        //! Can be called in parallel for different elements.
+        void setElementMatrix(uint elementID, const uint *elementPositions, const RRSmallMatrix &Ae);
+
+        //! Return number of rows.
+        uint getNRows(void) const;
+
+        //! Matrix vector multiplication - y=A*x.
+        void mlt(const RRVector &x, RRVector &y) const;
+
+        //! Find matrix diagonal.
+        void findDiagonal(RRVector &d) const;
+
+        //! Find matrix norm (norm of row sums).
+        double findNorm(void) const;
+
+        //! Find Frobenius norm.
+        //! Element contributions to shared matrix values are not summed, returned value is an estimate.
+        double findFrobeniusNorm(void) const;
+
+    protected:
+
+        //! Accumulate product of element matrix and x to y.
+        void mltElement(uint elementID, const double *x, double *y) const;
+
+};
+
+#endif // RELEMENTMATRIXOPERATOR_H
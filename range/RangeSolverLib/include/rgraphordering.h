@@ -0,0 +1,50 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rgraphordering.h                                         *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Graph ordering class declaration                    *
+ *********************************************************************/
+
+#ifndef RGRAPHORDERING_H
+#define RGRAPHORDERING_H
+
+#include <vector>
+
+#include <rblib.h>
+
+/*
+ * Orderings of symmetric graphs given in compressed adjacency format
+ * (adjacency of vertex i is stored at positions adjacencyPointers[i]
+ * to adjacencyPointers[i+1]). Resulting permutation lists vertices in
+ * their new order (permutation[newIndex] = oldIndex).
+ */
+
+class RGraphOrdering
+{
+
+    public:
+
+        //! Find reverse Cuthill-McKee ordering (bandwidth reduction).
+        //! Each connected component starts from pseudo-peripheral vertex.
+        static void findReverseCuthillMcKee(const std::vector<uint> &adjacencyPointers,
+                                            const std::vector<uint> &adjacency,
+                                            std::vector<uint> &permutation);
+
+        //! Find nested dissection ordering (fill reduction).
+        //! Separators are found from level structures and numbered after both halves.
+        static void findNestedDissection(const std::vector<uint> &adjacencyPointers,
+                                         const std::vector<uint> &adjacency,
+                                         std::vector<uint> &permutation);
+
+        //! Find bandwidth of graph with vertices in order given by permutation.
+        //! Empty permutation stands for original order.
+        static uint findBandwidth(const std::vector<uint> &adjacencyPointers,
+                                  const std::vector<uint> &adjacency,
+                                  const std::vector<uint> &permutation);
+
+};
+
+#endif // RGRAPHORDERING_H
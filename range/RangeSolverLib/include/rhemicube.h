@@ -16,7 +16,9 @@
 #include <rblib.h>
 #include <rmlib.h>
 
+#include "rhemicubescene.h"
 #include "rhemicubesector.h"
+#include "rviewfactorraytracer.h"
 
 class RHemiCube
 {
@@ -25,6 +27,8 @@ class RHemiCube
 
         //! Vector of hemicube sector.
         std::vector<RHemiCubeSector*> sectors;
+        //! Eye position.
+        RR3Vector eyePosition;
         //! Eye direction.
         RR3Vector eyeDirection;
 
@@ -51,6 +55,10 @@ class RHemiCube
         //! Visible part of the triangle will be stored in hemicube.
         void rayTraceTriangle(const RTriangle &triangle, uint color);
 
+        //! Ray-trace scene.
+        //! Triangles with skipColor will not be rendered.
+        void rayTraceScene(const RHemiCubeScene &scene, uint skipColor);
+
         //! Return view factors.
         //! Function returns map of color to view-factor value (color = 0 => empty).
         std::map<uint,double> getViewFactors(void) const;
@@ -59,10 +67,25 @@ class RHemiCube
         double getFillRatio(void) const;
 
         //! Calculate view factors.
+        //! View-factor method and resolution are taken from model radiation setup.
         static void calculateViewFactors(const RModel &model, RViewFactorMatrix &rViewFactorMatrix);
 
+        //! Update view factors.
+        //! View-factor matrix must contain new patch input and patch book.
+        //! Rows of unchanged patches which can not see any changed patch are taken from old matrix,
+        //! remaining rows are recalculated. All rows are recalculated when view-factor correction is enabled.
+        static void updateViewFactors(const RModel &model, const RViewFactorMatrix &oldViewFactorMatrix, RViewFactorMatrix &rViewFactorMatrix);
+
     private:
 
+        //! Calculate view factors of rows with set flag.
+        static void calculateViewFactors(const RModel &model, RViewFactorMatrix &rViewFactorMatrix, const std::vector<bool> &rowFlags);
+
+        //! Post-process view factors according to radiation setup.
+        //! Entries below threshold are dropped, optionally reciprocity (A_i*F_ij = A_j*F_ji)
+        //! and closure (row sum equal to original row sum, at most 1) are enforced.
+        static void postProcessViewFactors(const RModel &model, RViewFactorMatrix &rViewFactorMatrix);
+
         //! Generate hemicube.
         void generate(const RR3Vector &eyePosition, const RR3Vector &eyeDirection, uint resolution, double size);
 
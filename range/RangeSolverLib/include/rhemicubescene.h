@@ -0,0 +1,109 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rhemicubescene.h                                         *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: View-factor hemi-cube scene class declaration       *
+ *********************************************************************/
+
+#ifndef RHEMICUBESCENE_H
+#define RHEMICUBESCENE_H
+
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+#include "rhemicubesector.h"
+
+/*
+ * Triangles of all receiving patches organized in bounding volume
+ * hierarchy. Scene is built once and shared (read-only) by all eyes.
+ * Sectors are rendered by front-to-back traversal of the hierarchy.
+ * Nodes outside sector frustum or behind fully covered sector are
+ * skipped. Single rays are intersected with leaf triangles packed in
+ * blocks of four (one vector register of doubles).
+ */
+
+typedef struct _RHemiCubeSceneNode
+{
+    //! Node limit box.
+    RLimitBox box;
+    //! Leaf: position of first triangle, inner node: position of first child.
+    uint first;
+    //! Number of triangles (0 = inner node with two children).
+    uint nTriangles;
+} RHemiCubeSceneNode;
+
+class RHemiCubeScene
+{
+
+    protected:
+
+        //! Triangles.
+        std::vector<RTriangle> triangles;
+        //! Triangle colors (patch IDs).
+        std::vector<uint> colors;
+        //! Hierarchy nodes (root is first).
+        std::vector<RHemiCubeSceneNode> nodes;
+        //! First triangle block of each leaf node.
+        std::vector<uint> nodeBlocks;
+        //! Triangle blocks (vertex, first edge, second edge; each coordinate for four triangles).
+        std::vector<double> blocks;
+        //! Minimum ray intersection distance.
+        double minDistance;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RHemiCubeScene *pHemiCubeScene = nullptr);
+
+    public:
+
+        //! Constructor.
+        //! Scene is built from elements of receiving patches.
+        RHemiCubeScene(const RModel &model, const RPatchBook &patchBook, const std::vector<RPatchInput> &patchInput);
+
+        //! Copy constructor.
+        RHemiCubeScene(const RHemiCubeScene &hemiCubeScene);
+
+        //! Destructor.
+        ~RHemiCubeScene();
+
+        //! Assignment operator.
+        RHemiCubeScene &operator =(const RHemiCubeScene &hemiCubeScene);
+
+        //! Return number of triangles.
+        uint getNTriangles(void) const;
+
+        //! Return number of hierarchy nodes.
+        uint getNNodes(void) const;
+
+        //! Ray-trace scene into given sector.
+        //! Triangles with skipColor will not be rendered.
+        void rayTrace(RHemiCubeSector &sector, const RR3Vector &eyePosition, uint skipColor) const;
+
+        //! Find nearest triangle hit by ray.
+        //! Triangles with skipColor are ignored.
+        //! Return false if no triangle is hit.
+        bool findIntersection(const RR3Vector &origin, const RR3Vector &direction, uint skipColor, double &distance, uint &color) const;
+
+    private:
+
+        //! Build bounding volume hierarchy.
+        void build(void);
+
+        //! Pack leaf triangles into blocks.
+        void buildBlocks(void);
+
+        //! Find limit box of triangles in given range.
+        RLimitBox findLimitBox(uint first, uint nTriangles) const;
+
+        //! Find shortest distance between position and limit box.
+        static double findDistance(const RLimitBox &box, const RR3Vector &position);
+
+};
+
+#endif // RHEMICUBESCENE_H
@@ -41,6 +41,8 @@ class RHemiCubeSector
 
         //! Limit polygon.
         std::vector<RR3Vector> limitPolygon;
+        //! Inward normals of frustum planes passing through eye position.
+        std::vector<RR3Vector> frustumNormals;
         //! Resolution.
         uint resolution;
         //! Eye position.
@@ -49,6 +51,10 @@ class RHemiCubeSector
         RR3Vector eyeDirection;
         //! Pixels.
         std::vector<RHemiCubePixel> pixels;
+        //! Number of colored pixels.
+        uint nColoredPixels;
+        //! Upper bound of colored pixel depth.
+        double coverDistance;
 
     private:
 
@@ -89,6 +95,14 @@ class RHemiCubeSector
         //! Visible part of the triangle will be stored in the segment pixels.
         void rayTraceTriangle(const RTriangle &triangle, uint color);
 
+        //! Test if limit box may be visible in sector.
+        //! Test is conservative, false is returned only if box is outside sector frustum.
+        bool testVisibility(const RLimitBox &box) const;
+
+        //! Return distance beyond which nothing is visible in sector.
+        //! If any pixel is not colored maximum double value is returned.
+        double getCoverDistance(void) const;
+
     private:
 
         //! Test if triangle is visible in sector.
@@ -105,6 +119,13 @@ class RHemiCubeSector
         //! Return limit polygon.
         std::vector<RR3Vector> findLimitPolygon(void) const;
 
+        //! Return frustum plane normals.
+        std::vector<RR3Vector> findFrustumNormals(void) const;
+
+        //! Find range of pixels covered by triangle projection.
+        //! Return false if triangle projection does not cover any pixel.
+        bool findPixelRange(const RTriangle &triangle, uint &iFirst, uint &iLast, uint &jFirst, uint &jLast) const;
+
         //! Find limit polygons min and max ranges.
         RLimitBox findLimitBox(void) const;
 
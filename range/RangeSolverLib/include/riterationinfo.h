@@ -62,15 +62,24 @@ class RIterationInfo
         //! Set number of iterations.
         void setNIterations(unsigned int nIterations);
 
+        //! Return iteration print frequency.
+        unsigned int getOutputFrequency(void) const;
+
         //! Set iteration print frequency.
         void setOutputFrequency(unsigned int outputFrequency);
 
         //! Set convergence value.
         void setConvergenceValue(double convergenceValue);
 
+        //! Return current iteration.
+        unsigned int getIteration(void) const;
+
         //! Set iteration.
         void setIteration(unsigned int iteration);
 
+        //! Return current error.
+        double getError(void) const;
+
         //! Set error.
         void setError(double error);
 
@@ -0,0 +1,52 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rmatrixoperator.h                                        *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Matrix operator class declaration                   *
+ *********************************************************************/
+
+#ifndef RMATRIXOPERATOR_H
+#define RMATRIXOPERATOR_H
+
+#include <rblib.h>
+
+/*
+ * Linear operator used by iterative matrix solvers. Solver needs only
+ * matrix vector product, diagonal and norms so the matrix does not
+ * have to be assembled.
+ */
+
+class RMatrixOperator
+{
+
+    public:
+
+        //! Destructor.
+        virtual ~RMatrixOperator();
+
+        //! Return number of rows.
+        virtual uint getNRows(void) const = 0;
+
+        //! Matrix vector multiplication - y=A*x.
+        //! When called from inside of an OpenMP parallel region rows are distributed among threads.
+        virtual void mlt(const RRVector &x, RRVector &y) const = 0;
+
+        //! Find matrix diagonal.
+        virtual void findDiagonal(RRVector &d) const = 0;
+
+        //! Find matrix norm (norm of row sums).
+        virtual double findNorm(void) const = 0;
+
+        //! Find Frobenius norm.
+        virtual double findFrobeniusNorm(void) const = 0;
+
+        //! Find weight of each unknown in solution norm used by GMRES convergence check.
+        //! Empty weights (default) mean that euclidean norm of solution is used.
+        virtual void findSolutionNormWeights(RRVector &weights) const;
+
+};
+
+#endif // RMATRIXOPERATOR_H
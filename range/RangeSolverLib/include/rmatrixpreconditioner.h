@@ -11,19 +11,13 @@
 #ifndef RMATRIXPRECONDITIONER_H
 #define RMATRIXPRECONDITIONER_H
 
+#include <vector>
+
 #include <rblib.h>
 #include <rmlib.h>
 
-typedef enum _RMatrixPreconditionerType
-{
-    R_MATRIX_PRECONDITIONER_NONE = 0,
-    R_MATRIX_PRECONDITIONER_JACOBI,
-    R_MATRIX_PRECONDITIONER_BLOCK_JACOBI,
-//    R_MATRIX_PRECONDITIONER_SSOR,
-//    R_MATRIX_PRECONDITIONER_ILU,
-//    R_MATRIX_PRECONDITIONER_DILU,
-    R_MATRIX_PRECONDITIONER_N_TYPES
-} RMatrixPreconditionerType;
+#include "ralgebraicmultigrid.h"
+#include "rmatrixoperator.h"
 
 class RMatrixPreconditioner
 {
@@ -34,6 +28,25 @@ class RMatrixPreconditioner
         RMatrixPreconditionerType matrixPreconditionerType;
         //! Preconditioner values.
         RRMatrix data;
+        //! Inverted diagonal blocks (block Jacobi).
+        RSparseMatrixBSR inverseBlockDiagonal;
+        //! Incomplete factorization stored in a single matrix.
+        //! Strictly lower part holds unit lower triangular factor L, upper part including diagonal holds factor U.
+        RSparseMatrixCSR LU;
+        //! Position of diagonal value in each row of LU.
+        std::vector<uint> diagonalPositions;
+        //! Incomplete factorization values in single precision, used instead of LU values if not empty.
+        std::vector<float> singleLUValues;
+        //! Position of first row in each level of forward substitution (size = nLevels + 1).
+        std::vector<uint> lowerLevelPointers;
+        //! Rows ordered by forward substitution levels.
+        std::vector<uint> lowerLevelRows;
+        //! Position of first row in each level of backward substitution (size = nLevels + 1).
+        std::vector<uint> upperLevelPointers;
+        //! Rows ordered by backward substitution levels.
+        std::vector<uint> upperLevelRows;
+        //! Algebraic multigrid hierarchy.
+        RAlgebraicMultigrid multigrid;
 
     private:
 
@@ -43,7 +56,21 @@ class RMatrixPreconditioner
     public:
 
         //! Constructor.
-        RMatrixPreconditioner(const RSparseMatrix &matrix, RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_NONE, unsigned int blockSize = 1 );
+        //! Near null space is used only by algebraic multigrid (see RAlgebraicMultigrid::build).
+        //! Row block indexes are used by block Jacobi and algebraic multigrid.
+        //! Matrix must outlive algebraic multigrid preconditioner.
+        //! If block matrix built from matrix is given, block Jacobi uses it instead of building its own.
+        RMatrixPreconditioner(const RSparseMatrixCSR &matrix,
+                              RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_NONE,
+                              unsigned int blockSize = 1,
+                              const std::vector<RRVector> &nearNullSpace = std::vector<RRVector>(),
+                              const std::vector<uint> &rowBlockIndexes = std::vector<uint>(),
+                              const RSparseMatrixBSR *pBlockMatrix = nullptr);
+
+        //! Constructor.
+        //! Only preconditioners which do not need assembled matrix (none, Jacobi) are supported.
+        RMatrixPreconditioner(const RMatrixOperator &matrixOperator,
+                              RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_NONE);
 
         //! Copy constructor.
         RMatrixPreconditioner(const RMatrixPreconditioner &matrixPreconditioner);
@@ -55,15 +82,48 @@ class RMatrixPreconditioner
         RMatrixPreconditioner & operator =(const RMatrixPreconditioner &matrixPreconditioner);
 
         //! Compute preconditioner equation system.
+        //! When called from inside of an OpenMP parallel region rows are distributed among threads.
         void compute(const RRVector &x, RRVector &y) const;
 
+        //! Store incomplete factorization in single precision.
+        //! Other preconditioners and factorization with values out of single precision range are kept in double precision.
+        void convertToSinglePrecision(void);
+
     protected:
 
         //! Construct Jacobi preconditioner.
-        void constructJacobi(const RSparseMatrix &matrix);
+        void constructJacobi(const RSparseMatrixCSR &matrix);
+
+        //! Construct Jacobi preconditioner from matrix diagonal.
+        void constructJacobi(const RRVector &diagonal);
 
         //! Construct Block Jacobi preconditioner.
-        void constructBlockJacobi(const RSparseMatrix &matrix, unsigned int blockSize);
+        //! rowBlockIndexes assigns each row to a block, if empty consecutive groups of blockSize rows are used.
+        //! Block matrix is built only if pBlockMatrix is nullptr or has different block size.
+        void constructBlockJacobi(const RSparseMatrixCSR &matrix, unsigned int blockSize, const std::vector<uint> &rowBlockIndexes, const RSparseMatrixBSR *pBlockMatrix);
+
+        //! Construct incomplete Cholesky preconditioner with zero fill-in - IC(0).
+        //! Matrix is expected to be symmetric positive definite with symmetric sparsity pattern.
+        //! If factorization breaks down diagonal is shifted and factorization is restarted.
+        void constructIncompleteCholesky(const RSparseMatrixCSR &matrix);
+
+        //! Construct incomplete LU preconditioner with zero fill-in - ILU(0).
+        void constructIncompleteLU(const RSparseMatrixCSR &matrix);
+
+        //! Construct incomplete LU preconditioner with threshold dropping - ILUT.
+        //! Fill-in values smaller than drop tolerance times row norm are dropped
+        //! and only largest values (at most number of row values in original matrix times fill factor)
+        //! are kept in each row of L and U factor.
+        void constructIncompleteLUThreshold(const RSparseMatrixCSR &matrix,
+                                            double dropTolerance = 1.0e-4,
+                                            unsigned int fillFactor = 2);
+
+        //! Find diagonal positions of LU factor.
+        void findDiagonalPositions(void);
+
+        //! Find level schedule for forward and backward substitution.
+        //! Rows within one level do not depend on each other and are solved in parallel.
+        void findLevelSchedule(void);
 
         //! Compute Jacobi equation system.
         void computeJacobi(const RRVector &x, RRVector &y) const;
@@ -71,6 +131,13 @@ class RMatrixPreconditioner
         //! Construct Block Jacobi equation system.
         void computeBlockJacobi(const RRVector &x, RRVector &y) const;
 
+        //! Compute incomplete factorization equation system (forward and backward substitution).
+        void computeIncompleteFactorization(const RRVector &x, RRVector &y) const;
+
+        //! Compute incomplete factorization equation system with factorization values of given precision.
+        template <typename T>
+        void computeIncompleteFactorization(const T *pValue, const RRVector &x, RRVector &y) const;
+
 };
 
 #endif // RMATRIXPRECONDITIONER_H
@@ -14,7 +14,11 @@
 #include <rmlib.h>
 
 #include "riterationinfo.h"
+#include "rmatrixoperator.h"
 #include "rmatrixpreconditioner.h"
+#include "rsingleprecisionmatrixoperator.h"
+#include "rsparsedirectsolver.h"
+#include "rsparsematrixoperator.h"
 
 class RMatrixSolver
 {
@@ -25,6 +29,22 @@ class RMatrixSolver
         RMatrixSolverConf matrixSolverConf;
         //! Iteration ionformation.
         RIterationInfo iterationInfo;
+        //! Near null space vectors used by algebraic multigrid preconditioner.
+        std::vector<RRVector> nearNullSpace;
+        //! Block (node) index of each matrix row used by block matrix and block preconditioners.
+        std::vector<uint> rowBlockIndexes;
+        //! Sparse direct solver holding factorization between solves.
+        RSparseDirectSolver directSolver;
+        //! External sparse direct solver which outlives matrix solver (not owned).
+        RSparseDirectSolver *pExternalDirectSolver;
+        //! Block sparse row matrix kept between solves, only values are updated while sparsity pattern does not change.
+        RSparseMatrixBSR blockMatrix;
+        //! Row pointers of matrix from which block matrix was built.
+        std::vector<uint> blockMatrixRowPointers;
+        //! Column indexes of matrix from which block matrix was built.
+        std::vector<uint> blockMatrixColumnIndexes;
+        //! Row block indexes used to build block matrix.
+        std::vector<uint> blockMatrixRowBlockIndexes;
 
     private:
 
@@ -48,16 +68,81 @@ class RMatrixSolver
         //! Solve matrix system.
         void solve(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_NONE, unsigned int blockSize = 1);
 
+        //! Solve matrix system with matrix already frozen in compressed sparse row format.
+        void solve(const RSparseMatrixCSR &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_NONE, unsigned int blockSize = 1);
+
+        //! Solve matrix system given by matrix operator without assembled matrix (matrix free).
+        //! Sparse direct solver is replaced by iterative solver and preconditioners requiring assembled matrix by Jacobi preconditioner.
+        void solve(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_NONE);
+
+        //! Set near null space used by algebraic multigrid preconditioner.
+        //! Each vector must have size equal to number of matrix rows.
+        //! rowBlockIndexes assigns each matrix row to a block (node), if empty consecutive groups of blockSize rows are used.
+        void setNearNullSpace(const std::vector<RRVector> &nearNullSpace, const std::vector<uint> &rowBlockIndexes = std::vector<uint>());
+
+        //! Set block (node) index of each matrix row.
+        //! If empty consecutive groups of blockSize rows are used.
+        void setRowBlockIndexes(const std::vector<uint> &rowBlockIndexes);
+
+        //! Set external sparse direct solver used to keep factorization between instances of matrix solver.
+        //! If nullptr is given own direct solver is used.
+        void setDirectSolver(RSparseDirectSolver *pDirectSolver);
+
+        //! Return iteration information of last solve.
+        const RIterationInfo &getIterationInfo(void) const;
+
         //! Disable convergence log file.
         void disableConvergenceLogFile(void);
 
     protected:
 
+        //! Scale equation system and run iterative solver selected by configuration.
+        void solveIterative(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P);
+
+        //! Scale equation system by given matrix norm and run iterative solver selected by configuration.
+        //! No header or footer is printed.
+        void solveIterativeScaled(const RMatrixOperator &A, double An, const RRVector &b, RRVector &x, RMatrixPreconditioner &P);
+
+        //! Mixed precision iterative refinement.
+        //! Correction is found by iterative solver with single precision matrix and preconditioner,
+        //! residual and solution are updated in double precision.
+        //! Iteration info holds double precision residual of returned solution.
+        void solveMixedPrecision(const RSparseMatrixCSR &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P);
+
         //! ConjugateGradient solver.
-        void solveCG(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P);
+        void solveCG(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P);
+
+        //! Pipelined ConjugateGradient solver (Ghysels-Vanroose).
+        //! All dot products of one iteration are computed in one fused pass together with vector updates
+        //! and combined in one reduction.
+        void solvePipelinedCG(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P);
+
+        //! Flexible generalized minimal residual solver.
+        //! Preconditioned vectors are stored so that preconditioner may change between iterations.
+        //! Krylov vectors are orthogonalized with classical Gram-Schmidt and selective reorthogonalization.
+        //! Restart length is increased if residual stagnates over a restart cycle.
+        void solveGMRES(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P);
+
+        //! Find projections of w to first nv vectors of v and squared norm of w (stored at position nv).
+        //! Must be called by all threads of parallel region, each thread processes rows <jb,je).
+        static void findProjections(const RRMatrix &v, uint nv, const double *pw, int64_t jb, int64_t je, std::vector<double> &partials, uint partialStride, uint threadID, uint nThreads, std::vector<double> &hw);
+
+        //! Subtract projections hw of first nv vectors of v from w for rows <jb,je).
+        static void subtractProjections(const RRMatrix &v, uint nv, const std::vector<double> &hw, double *pw, int64_t jb, int64_t je);
+
+        //! Build block matrix or update its values if matrix pattern and block layout did not change since last solve.
+        void prepareBlockMatrix(const RSparseMatrixCSR &A, unsigned int blockSize);
+
+        //! Sparse direct solver.
+        //! Cholesky factorization is used for CG configuration, LU factorization for GMRES configuration.
+        void solveDirect(const RSparseMatrixCSR &A, const RRVector &b, RRVector &x);
+
+        //! Return matrix system dump file name.
+        //! Solver configuration takes precedence over RANGE_MATRIX_SYSTEM_FILE environment variable.
+        QString findSystemFileName(void) const;
 
-        //! Generalize minimal residual solver.
-        void solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P);
+        //! Write matrix system to file if dump file name is set.
+        void writeSystem(const RSparseMatrixCSR &A, const RRVector &b, const RRVector &x, RMatrixPreconditionerType matrixPreconditionerType, unsigned int blockSize) const;
 
 };
 
@@ -0,0 +1,78 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsingleprecisionmatrixoperator.h                         *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Single precision matrix operator class declaration  *
+ *********************************************************************/
+
+#ifndef RSINGLEPRECISIONMATRIXOPERATOR_H
+#define RSINGLEPRECISIONMATRIXOPERATOR_H
+
+#include <vector>
+
+#include <rmlib.h>
+
+#include "rmatrixoperator.h"
+
+//! Matrix operator of assembled sparse matrix with values stored in single precision.
+//! Sparsity pattern is shared with referenced matrix which must outlive the operator.
+//! Products are accumulated in double precision.
+class RSinglePrecisionMatrixOperator : public RMatrixOperator
+{
+
+    protected:
+
+        //! Matrix providing sparsity pattern.
+        const RSparseMatrixCSR *pMatrix;
+        //! Matrix values in single precision.
+        std::vector<float> values;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RSinglePrecisionMatrixOperator *pSinglePrecisionMatrixOperator = nullptr);
+
+    public:
+
+        //! Constructor.
+        //! Matrix values must be in single precision range (see isInRange).
+        explicit RSinglePrecisionMatrixOperator(const RSparseMatrixCSR &matrix);
+
+        //! Copy constructor.
+        RSinglePrecisionMatrixOperator(const RSinglePrecisionMatrixOperator &singlePrecisionMatrixOperator);
+
+        //! Destructor.
+        ~RSinglePrecisionMatrixOperator();
+
+        //! Assignment operator.
+        RSinglePrecisionMatrixOperator & operator =(const RSinglePrecisionMatrixOperator &singlePrecisionMatrixOperator);
+
+        //! Return number of rows.
+        uint getNRows(void) const;
+
+        //! Matrix vector multiplication - y=A*x.
+        void mlt(const RRVector &x, RRVector &y) const;
+
+        //! Find matrix diagonal.
+        void findDiagonal(RRVector &d) const;
+
+        //! Find matrix norm (norm of row sums).
+        double findNorm(void) const;
+
+        //! Find Frobenius norm.
+        double findFrobeniusNorm(void) const;
+
+        //! Return true if all values can be stored in single precision without overflow
+        //! and no nonzero value underflows to denormalized number or zero.
+        static bool isInRange(const std::vector<double> &values);
+
+        //! Find weight of each unknown in solution norm.
+        //! Weight is number of matrix values in unknown's column, so that solution is weighted the same way as in A*x.
+        void findSolutionNormWeights(RRVector &weights) const;
+
+};
+
+#endif // RSINGLEPRECISIONMATRIXOPERATOR_H
@@ -95,7 +95,7 @@ class RSolverAcoustic : public RSolverGeneric
         void statistics(void);
 
         //! Assembly matrix
-        void assemblyMatrix(unsigned int elementID, const RRMatrix &Me, const RRMatrix &Ce, const RRMatrix &Ke, const RRVector &fe);
+        void assemblyMatrix(unsigned int elementID, const RRSmallMatrix &Me, const RRSmallMatrix &Ce, const RRSmallMatrix &Ke, const RRVector &fe);
 
         //! Find absorbing boundary nodes.
         std::vector<bool> findAbsorbingBoundaryNodes(void) const;
@@ -18,8 +18,11 @@
 #include <rblib.h>
 #include <rmlib.h>
 
+#include "relementmatrixoperator.h"
+#include "rgraphordering.h"
 #include "rlocalrotation.h"
 #include "rscales.h"
+#include "rsparsedirectsolver.h"
 #include "rsolvershareddata.h"
 
 template <typename T>
@@ -58,14 +61,28 @@ class RSolverGeneric
         RSparseMatrix M;
         //! Matrix A.
         RSparseMatrix A;
+        //! Element matrix operator used instead of matrix A if matrix system is solved matrix free.
+        RElementMatrixOperator elementMatrixOperator;
+        //! Indicator whether element matrices are assembled into element matrix operator instead of matrix A.
+        bool matrixFree;
         //! Vector x.
         RRVector x;
         //! Vector b.
         RRVector b;
         //! Node book.
         RBook nodeBook;
+        //! Node book for which sparsity pattern of matrix A was generated.
+        RBook matrixPatternNodeBook;
+        //! Order in which nodes are numbered (empty if nodes are numbered in original order).
+        std::vector<uint> nodeOrder;
+        //! Node ordering type for which node order was computed.
+        RNodeOrderingType nodeOrderType;
+        //! Element colors (elements with same color do not share any node).
+        std::vector<uint> elementColors;
         //! Local rotations.
         std::vector<RLocalRotation> localRotations;
+        //! Sparse direct solver keeping factorization of matrix A between solves.
+        RSparseDirectSolver directSolver;
         //! Element temperature vector.
         RRVector elementTemperature;
         //! Scales.
@@ -140,6 +157,16 @@ class RSolverGeneric
         //! Recover shared data.
         virtual void recoverSharedData(void);
 
+        //! Return element geometry cache valid for current mesh.
+        //! Cache is shared by all solvers and rebuilt only if mesh has changed.
+        //! Must not be called from parallel region.
+        const RElementGeometryCache &getGeometryCache(void);
+
+        //! Return mesh view valid for current mesh.
+        //! View is shared by all solvers and rebuilt only if mesh has changed.
+        //! Must not be called from parallel region.
+        const RMeshView &getMeshView(void);
+
         //! Update scales.
         virtual void updateScales(void) = 0;
 
@@ -173,6 +200,41 @@ class RSolverGeneric
         //! Generate node book.
         void generateNodeBook(RProblemType problemType);
 
+        //! Assign consecutive values to enabled node book positions.
+        //! Nodes are visited in order given by node ordering set in matrix solver configuration,
+        //! all variables of a node receive consecutive values (nodeBook size = nNodes * nVariables).
+        void renumberNodeBook(uint nVariables);
+
+        //! Prepare matrix A for assembly.
+        //! Sparsity pattern is generated from element connectivity only if mesh or node book has changed,
+        //! otherwise matrix values are set to zero while pattern is kept.
+        //! Number of variables per node must match node book layout (nodeBook size = nNodes * nVariables).
+        //! Each enabled node book position is expanded into blockSize consecutive matrix rows.
+        void prepareMatrixPattern(uint nVariables = 1, uint blockSize = 1);
+
+        //! Prepare element matrix operator for assembly (single variable per node).
+        //! Layout is generated only if mesh or node book has changed, otherwise element matrices are set to zero.
+        //! Matrix A is released.
+        void prepareElementMatrixOperator(bool symmetric);
+
+        //! Store element matrix in element matrix operator.
+        //! Rows of nodes which are not in node book are excluded from matrix system.
+        void assemblyElementMatrix(uint elementID, const RRSmallMatrix &Ae);
+
+        //! Find node index of each matrix row (node book size = nNodes * nVariables).
+        //! Rows of one node form one block of block matrix and block preconditioners.
+        void findRowBlockIndexes(uint nVariables, std::vector<uint> &rowBlockIndexes) const;
+
+        //! Generate element colors using greedy coloring of element-node connectivity.
+        void generateElementColors(void);
+
+        //! Split elements from given element group into batches of same color.
+        //! Elements in one batch do not share any node and therefore can be assembled in parallel without locking.
+        std::vector< std::vector<uint> > findElementColorBatches(const RElementGroup &elementGroup) const;
+
+        //! Split all elements into batches of same color.
+        std::vector< std::vector<uint> > findElementColorBatches(void) const;
+
         //! Generate material element vector.
         void generateMaterialVecor(RMaterialPropertyType materialPropertyType, RRVector &materialPropertyValues) const;
 
@@ -86,7 +86,7 @@ class RSolverHeat : public RSolverGeneric
         void statistics(void);
 
         //! Assembly matrix
-        void assemblyMatrix(unsigned int elementID, const RRMatrix &Me, const RRMatrix &Ke, const RRVector &fe);
+        void assemblyMatrix(unsigned int elementID, const RRSmallMatrix &Me, const RRSmallMatrix &Ke, const RRVector &fe);
 
         //! Get simple convection BC values.
         bool getSimpleConvection(const RElementGroup &elementGroup, double &htc, double &htt);
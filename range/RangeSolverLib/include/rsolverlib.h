@@ -11,17 +11,23 @@
 #ifndef RSOLVERLIB_H
 #define RSOLVERLIB_H
 
+#include "ralgebraicmultigrid.h"
 #include "rconvection.h"
 #include "reigenvaluesolver.h"
+#include "relementmatrixoperator.h"
+#include "rgraphordering.h"
 #include "rhemicube.h"
 #include "rhemicubepixel.h"
+#include "rhemicubescene.h"
 #include "rhemicubesector.h"
 #include "riterationinfo.h"
 #include "riterationinfovalue.h"
 #include "rlocalrotation.h"
+#include "rmatrixoperator.h"
 #include "rmatrixpreconditioner.h"
 #include "rmatrixsolver.h"
 #include "rscales.h"
+#include "rsingleprecisionmatrixoperator.h"
 #include "rsolver.h"
 #include "rsolverfluidparticle.h"
 #include "rsolverelectrostatics.h"
@@ -35,5 +41,8 @@
 #include "rsolvershareddata.h"
 #include "rsolverstress.h"
 #include "rsolverwave.h"
+#include "rsparsedirectsolver.h"
+#include "rsparsematrixoperator.h"
+#include "rviewfactorraytracer.h"
 
 #endif // RSOLVERLIB_H
@@ -56,6 +56,15 @@ class RSolverRadiativeHeat : public RSolverGeneric
         //! Check if solver has converged.
         bool hasConverged(void) const;
 
+        //! Assemble radiosity system of patches.
+        //! Each row is assembled from non-zero view-factors of one view-factor matrix row.
+        static void assemblyRadiationSystem(const RViewFactorMatrix &viewFactorMatrix,
+                                            const RRVector &patchEmissivity,
+                                            const RRVector &patchTemperature,
+                                            const RRVector &patchAmbientTemperature,
+                                            RSparseMatrix &A,
+                                            RRVector &b);
+
     protected:
 
         //! Find temperature scale.
@@ -88,6 +97,10 @@ class RSolverRadiativeHeat : public RSolverGeneric
         //! Check if view-factor header correspond with input.
         bool checkViewFactorHeader(const RViewFactorMatrixHeader &viewFactorMatrixHeader) const;
 
+        //! Check if view-factor patch geometry correspond with model.
+        //! Matrices without patch hashes are assumed to be valid.
+        bool checkViewFactorGeometry(const RViewFactorMatrix &viewFactorMatrix) const;
+
 };
 
 #endif // RSOLVERRADIATIVEHEAT_H
@@ -22,6 +22,10 @@ class RSolverSharedData
 
         //! Variables.
         QMap<QString,RRVector> data;
+        //! Element geometry cache shared by all solvers.
+        RElementGeometryCache geometryCache;
+        //! Mesh view shared by all solvers.
+        RMeshView meshView;
 
     private:
 
@@ -54,8 +58,21 @@ class RSolverSharedData
         RRVector &findData(const QString &name);
 
         //! Clear shared data.
+        //! Element geometry cache and mesh view are not cleared.
         void clearData(void);
 
+        //! Return const reference to element geometry cache.
+        const RElementGeometryCache &getGeometryCache(void) const;
+
+        //! Return reference to element geometry cache.
+        RElementGeometryCache &getGeometryCache(void);
+
+        //! Return const reference to mesh view.
+        const RMeshView &getMeshView(void) const;
+
+        //! Return reference to mesh view.
+        RMeshView &getMeshView(void);
+
 };
 
 #endif // RSOLVERSHAREDDATA_H
@@ -118,6 +118,10 @@ class RSolverStress : public RSolverGeneric
         //! Apply local rotations to vector.
         void applyLocalRotations(unsigned int elementID, RRVector &fe);
 
+        //! Find rigid body modes (3 translations and 3 rotations) of enabled displacement components.
+        //! Modes are used as near null space by algebraic multigrid preconditioner.
+        void findRigidBodyModes(std::vector<RRVector> &rigidBodyModes, std::vector<uint> &rowBlockIndexes) const;
+
 };
 
 #endif // RSOLVERSTRESS_H
@@ -0,0 +1,138 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsparsedirectsolver.h                                    *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Sparse direct solver class declaration              *
+ *********************************************************************/
+
+#ifndef RSPARSEDIRECTSOLVER_H
+#define RSPARSEDIRECTSOLVER_H
+
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+#include "rgraphordering.h"
+
+/*
+ * Multifrontal supernodal sparse direct solver.
+ *
+ * 1. Fill-reducing ordering - nested dissection of the graph of A+A^T.
+ * 2. Symbolic factorization - elimination tree, postorder and fundamental supernodes.
+ * 3. Numeric factorization - Cholesky (L*L^T) for symmetric positive definite matrices
+ *    or LU without pivoting on symmetric pattern of A+A^T. Small LU pivots are perturbed
+ *    (static pivoting). Independent supernodes are factorized in parallel.
+ *
+ * Factorization is kept until matrix changes. If only values change, ordering
+ * and symbolic factorization are reused.
+ */
+
+class RSparseDirectSolver
+{
+
+    protected:
+
+        //! Factorization is symmetric (Cholesky).
+        bool symmetric;
+        //! Number of LU pivots perturbed in last numeric factorization.
+        uint nPerturbedPivots;
+        //! Factorized matrix.
+        RSparseMatrixCSR matrix;
+        //! Numeric factorization is valid for stored matrix.
+        bool factorized;
+        //! Permutation (new index -> original index).
+        std::vector<uint> permutation;
+        //! Inverse permutation (original index -> new index).
+        std::vector<uint> inversePermutation;
+        //! First column of each supernode (size = nSupernodes + 1).
+        std::vector<uint> supernodePointers;
+        //! Supernodes grouped by height in supernodal elimination tree.
+        std::vector<uint> levelPointers;
+        //! Supernodes ordered by levels.
+        std::vector<uint> levelSupernodes;
+        //! Parent supernode (RConstants::eod for roots).
+        std::vector<uint> supernodeParents;
+        //! Position of first child of each supernode (size = nSupernodes + 1).
+        std::vector<uint> childPointers;
+        //! Child supernodes.
+        std::vector<uint> children;
+        //! Position of first row index of each supernode (size = nSupernodes + 1).
+        std::vector<uint> rowIndexPointers;
+        //! Row indexes of each supernode in ascending order starting with own columns.
+        std::vector<uint> rowIndexes;
+        //! Position of first factor value of each supernode (size = nSupernodes + 1).
+        std::vector<size_t> valuePointers;
+        //! Lower factor values, dense column-major block for each supernode.
+        std::vector<double> lValues;
+        //! Transposed upper factor values (LU only), dense column-major block for each supernode.
+        std::vector<double> uValues;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RSparseDirectSolver *pSparseDirectSolver = nullptr);
+
+    public:
+
+        //! Constructor.
+        RSparseDirectSolver();
+
+        //! Copy constructor.
+        RSparseDirectSolver(const RSparseDirectSolver &sparseDirectSolver);
+
+        //! Destructor.
+        ~RSparseDirectSolver();
+
+        //! Assignment operator.
+        RSparseDirectSolver & operator =(const RSparseDirectSolver &sparseDirectSolver);
+
+        //! Factorize matrix.
+        //! If given matrix is equal to already factorized matrix nothing is done.
+        //! If symmetric factorization fails LU factorization is used instead.
+        void factorize(const RSparseMatrixCSR &A, bool symmetric);
+
+        //! Return true if given matrix is already factorized.
+        bool isFactorized(const RSparseMatrixCSR &A, bool symmetric) const;
+
+        //! Solve A*x=b using computed factorization.
+        void solve(const RRVector &b, RRVector &x) const;
+
+        //! Return number of LU pivots perturbed in last numeric factorization.
+        //! Solution of factorization with perturbed pivots should be iteratively refined.
+        uint getNPerturbedPivots(void) const;
+
+        //! Return number of values in factor.
+        size_t getNFactorValues(void) const;
+
+        //! Clear factorization.
+        void clear(void);
+
+    protected:
+
+        //! Return true if given matrix has same sparsity pattern as factorized matrix.
+        bool hasSamePattern(const RSparseMatrixCSR &A) const;
+
+        //! Find fill-reducing ordering and symbolic factorization.
+        void analyze(void);
+
+        //! Compute numeric factorization.
+        //! Return false if symmetric factorization encounters non-positive pivot.
+        bool computeNumeric(void);
+
+        //! Factorize single supernode.
+        //! Update matrices of child supernodes are assembled and released, own update matrix is stored.
+        //! Return false if symmetric factorization encounters non-positive pivot.
+        bool factorizeSupernode(uint supernode,
+                                const RSparseMatrixCSR &transposedMatrix,
+                                double pivotTolerance,
+                                bool parallel,
+                                std::vector< std::vector<double> > &updateMatrices,
+                                uint &nPerturbedPivots);
+
+};
+
+#endif // RSPARSEDIRECTSOLVER_H
@@ -0,0 +1,71 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsparsematrixoperator.h                                  *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Sparse matrix operator class declaration            *
+ *********************************************************************/
+
+#ifndef RSPARSEMATRIXOPERATOR_H
+#define RSPARSEMATRIXOPERATOR_H
+
+#include <rmlib.h>
+
+#include "rmatrixoperator.h"
+
+//! Matrix operator of assembled sparse matrix.
+//! Matrices are referenced and must outlive the operator.
+class RSparseMatrixOperator : public RMatrixOperator
+{
+
+    protected:
+
+        //! Matrix.
+        const RSparseMatrixCSR *pMatrix;
+        //! Block matrix used for multiplication if not empty.
+        const RSparseMatrixBSR *pBlockMatrix;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RSparseMatrixOperator *pSparseMatrixOperator = nullptr);
+
+    public:
+
+        //! Constructor.
+        //! If block matrix is given and not empty it is used for matrix vector multiplication.
+        RSparseMatrixOperator(const RSparseMatrixCSR &matrix, const RSparseMatrixBSR *pBlockMatrix = nullptr);
+
+        //! Copy constructor.
+        RSparseMatrixOperator(const RSparseMatrixOperator &sparseMatrixOperator);
+
+        //! Destructor.
+        ~RSparseMatrixOperator();
+
+        //! Assignment operator.
+        RSparseMatrixOperator & operator =(const RSparseMatrixOperator &sparseMatrixOperator);
+
+        //! Return number of rows.
+        uint getNRows(void) const;
+
+        //! Matrix vector multiplication - y=A*x.
+        void mlt(const RRVector &x, RRVector &y) const;
+
+        //! Find matrix diagonal.
+        void findDiagonal(RRVector &d) const;
+
+        //! Find matrix norm (norm of row sums).
+        double findNorm(void) const;
+
+        //! Find Frobenius norm.
+        double findFrobeniusNorm(void) const;
+
+        //! Find weight of each unknown in solution norm.
+        //! Weight is number of matrix values in unknown's column, so that solution is weighted the same way as in A*x.
+        void findSolutionNormWeights(RRVector &weights) const;
+
+};
+
+#endif // RSPARSEMATRIXOPERATOR_H
@@ -0,0 +1,99 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rviewfactorraytracer.h                                   *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: View-factor ray tracer class declaration            *
+ *********************************************************************/
+
+#ifndef RVIEWFACTORRAYTRACER_H
+#define RVIEWFACTORRAYTRACER_H
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+#include "rhemicubescene.h"
+
+/*
+ * Monte Carlo estimate of view-factors from one patch. Ray origins are
+ * distributed uniformly over patch area and directions are cosine
+ * weighted, so that view-factor to other patch is the fraction of rays
+ * which hit it first. Rays are traced in batches until variance of every
+ * view-factor estimate drops below target variance.
+ */
+
+class RViewFactorRayTracer
+{
+
+    protected:
+
+        //! First vertex of each patch triangle.
+        std::vector<RR3Vector> vertices;
+        //! First edge of each patch triangle.
+        std::vector<RR3Vector> edges1;
+        //! Second edge of each patch triangle.
+        std::vector<RR3Vector> edges2;
+        //! Unit normal of each patch triangle.
+        std::vector<RR3Vector> normals;
+        //! First unit tangent of each patch triangle.
+        std::vector<RR3Vector> tangents1;
+        //! Second unit tangent of each patch triangle.
+        std::vector<RR3Vector> tangents2;
+        //! Cumulative triangle areas.
+        std::vector<double> cumulativeAreas;
+        //! Random number generator.
+        std::mt19937_64 generator;
+        //! Number of hits of each color.
+        std::map<uint,uint> nHits;
+        //! Number of traced rays.
+        uint nRays;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RViewFactorRayTracer *pViewFactorRayTracer = nullptr);
+
+    public:
+
+        //! Constructor.
+        //! Random number generator is initialized with given seed.
+        RViewFactorRayTracer(const RModel &model, const RPatch &patch, quint64 seed);
+
+        //! Copy constructor.
+        RViewFactorRayTracer(const RViewFactorRayTracer &viewFactorRayTracer);
+
+        //! Destructor.
+        ~RViewFactorRayTracer();
+
+        //! Assignment operator.
+        RViewFactorRayTracer &operator =(const RViewFactorRayTracer &viewFactorRayTracer);
+
+        //! Ray-trace scene.
+        //! Triangles with skipColor will not be hit.
+        //! Target standard deviation of each view-factor is 1/resolution.
+        void rayTraceScene(const RHemiCubeScene &scene, uint skipColor, uint resolution);
+
+        //! Return view factors.
+        //! Function returns map of color to view-factor value.
+        std::map<uint,double> getViewFactors(void) const;
+
+        //! Return number of traced rays.
+        uint getNRays(void) const;
+
+    private:
+
+        //! Generate random number in interval [0,1).
+        double generateRandomNumber(void);
+
+        //! Generate ray.
+        void generateRay(RR3Vector &origin, RR3Vector &direction);
+
+};
+
+#endif // RVIEWFACTORRAYTRACER_H
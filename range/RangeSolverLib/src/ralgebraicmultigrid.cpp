@@ -0,0 +1,798 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   ralgebraicmultigrid.cpp                                  *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Algebraic multigrid class definition                *
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <omp.h>
+
+#include "ralgebraicmultigrid.h"
+
+//! Maximum number of levels.
+static const uint maxNLevels = 10;
+//! Coarsening stops when number of rows drops below this value.
+static const uint coarseNRows = 500;
+//! Maximum number of rows for which coarsest level is solved directly.
+static const uint maxDirectNRows = 2000;
+//! Number of smoother sweeps before and after coarse level correction.
+static const uint nSmootherSweeps = 2;
+//! Number of smoother sweeps on coarsest level if it is too large to be solved directly.
+static const uint nCoarseSmootherSweeps = 20;
+//! Strength of connection threshold on finest level (halved on each coarser level).
+static const double fineStrengthThreshold = 0.08;
+//! Number of power iterations used to estimate spectral radius.
+static const uint nPowerIterations = 10;
+
+void RAlgebraicMultigrid::_init(const RAlgebraicMultigrid *pAlgebraicMultigrid)
+{
+    if (pAlgebraicMultigrid)
+    {
+        this->pMatrix = pAlgebraicMultigrid->pMatrix;
+        this->coarseMatrices = pAlgebraicMultigrid->coarseMatrices;
+        this->prolongators = pAlgebraicMultigrid->prolongators;
+        this->restrictors = pAlgebraicMultigrid->restrictors;
+        this->smootherWeights = pAlgebraicMultigrid->smootherWeights;
+        this->coarseLU = pAlgebraicMultigrid->coarseLU;
+        this->coarsePivots = pAlgebraicMultigrid->coarsePivots;
+        this->levelB = pAlgebraicMultigrid->levelB;
+        this->levelX = pAlgebraicMultigrid->levelX;
+        this->levelR = pAlgebraicMultigrid->levelR;
+    }
+}
+
+RAlgebraicMultigrid::RAlgebraicMultigrid()
+    : pMatrix(nullptr)
+{
+    this->_init();
+}
+
+RAlgebraicMultigrid::RAlgebraicMultigrid(const RAlgebraicMultigrid &algebraicMultigrid)
+{
+    this->_init(&algebraicMultigrid);
+}
+
+RAlgebraicMultigrid::~RAlgebraicMultigrid()
+{
+}
+
+RAlgebraicMultigrid &RAlgebraicMultigrid::operator =(const RAlgebraicMultigrid &algebraicMultigrid)
+{
+    this->_init(&algebraicMultigrid);
+    return (*this);
+}
+
+void RAlgebraicMultigrid::build(const RSparseMatrixCSR &matrix, unsigned int blockSize, const std::vector<RRVector> &nearNullSpace, const std::vector<uint> &rowBlockIndexes)
+{
+    uint nRows = matrix.getNRows();
+
+    if (blockSize == 0)
+    {
+        blockSize = 1;
+    }
+
+    this->pMatrix = &matrix;
+    this->coarseMatrices.clear();
+    this->prolongators.clear();
+    this->restrictors.clear();
+    this->smootherWeights.clear();
+
+    // Assign rows to blocks.
+    std::vector<uint> blocks(rowBlockIndexes);
+    if (blocks.empty())
+    {
+        blocks.resize(nRows);
+        for (uint i=0;i<nRows;i++)
+        {
+            blocks[i] = i / blockSize;
+        }
+    }
+    if (blocks.size() != nRows)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Number of row block indexes (%u) differs from number of matrix rows (%u).",uint(blocks.size()),nRows);
+    }
+
+    // Near null space.
+    std::vector<RRVector> B(nearNullSpace);
+    if (B.empty())
+    {
+        B.resize(blockSize,RRVector(nRows,0.0));
+        for (uint i=0;i<nRows;i++)
+        {
+            B[i % blockSize][i] = 1.0;
+        }
+    }
+    for (uint k=0;k<B.size();k++)
+    {
+        if (B[k].size() != nRows)
+        {
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Size of near null space vector (%u) differs from number of matrix rows (%u).",B[k].getNRows(),nRows);
+        }
+    }
+
+    double strengthThreshold = fineStrengthThreshold;
+
+    for (uint level=0;;level++)
+    {
+        const RSparseMatrixCSR &A = this->getMatrix(level);
+        uint n = A.getNRows();
+
+        RRVector invDiagonal(A.getDiagonal());
+        for (uint i=0;i<n;i++)
+        {
+            invDiagonal[i] = (invDiagonal[i] == 0.0) ? 0.0 : 1.0 / invDiagonal[i];
+        }
+
+        double rho = RAlgebraicMultigrid::estimateSpectralRadius(A,invDiagonal);
+        double omega = (rho > 0.0) ? 4.0 / (3.0 * rho) : 1.0;
+
+        RRVector weights(invDiagonal);
+        weights *= omega;
+        this->smootherWeights.push_back(weights);
+
+        RLogger::info("Algebraic multigrid level %u: %u rows, %u values\n",level,n,A.getNValues());
+
+        if (n <= coarseNRows || level + 1 >= maxNLevels)
+        {
+            break;
+        }
+
+        // Renumber blocks so that there are no gaps in block indexes.
+        std::vector<uint> blockMap(*std::max_element(blocks.begin(),blocks.end())+1,RConstants::eod);
+        uint nBlocks = 0;
+        for (uint i=0;i<n;i++)
+        {
+            if (blockMap[blocks[i]] == RConstants::eod)
+            {
+                blockMap[blocks[i]] = nBlocks++;
+            }
+            blocks[i] = blockMap[blocks[i]];
+        }
+
+        std::vector<uint> blockAggregates;
+        uint nAggregates = RAlgebraicMultigrid::findAggregates(A,blocks,nBlocks,strengthThreshold,blockAggregates);
+        uint nCoarse = nAggregates * uint(B.size());
+
+        if (nAggregates == 0 || nCoarse >= n)
+        {
+            break;
+        }
+
+        RSparseMatrixCSR tentativeProlongator;
+        std::vector<RRVector> coarseB;
+        RAlgebraicMultigrid::buildTentativeProlongator(B,blocks,blockAggregates,nAggregates,tentativeProlongator,coarseB);
+
+        // Prolongator smoother S = I - omega*D^-1*A
+        RSparseMatrixCSR S(A);
+#pragma omp parallel for default(shared)
+        for (int64_t i=0;i<int64_t(n);i++)
+        {
+            for (uint k=S.getRowBegin(uint(i));k<S.getRowEnd(uint(i));k++)
+            {
+                S.getValue(k) *= -omega * invDiagonal[i];
+                if (S.getColumnIndex(k) == uint(i))
+                {
+                    S.getValue(k) += 1.0;
+                }
+            }
+        }
+
+        RSparseMatrixCSR P;
+        RSparseMatrixCSR::mlt(S,tentativeProlongator,P);
+        S.clear();
+        tentativeProlongator.clear();
+
+        RSparseMatrixCSR R;
+        RSparseMatrixCSR::transpose(P,nCoarse,R);
+
+        RSparseMatrixCSR AP;
+        RSparseMatrixCSR::mlt(A,P,AP);
+
+        RSparseMatrixCSR Ac;
+        RSparseMatrixCSR::mlt(R,AP,Ac);
+        AP.clear();
+
+        this->prolongators.push_back(P);
+        this->restrictors.push_back(R);
+        this->coarseMatrices.push_back(Ac);
+
+        // Each aggregate forms one block on coarse level.
+        blocks.resize(nCoarse);
+        for (uint i=0;i<nCoarse;i++)
+        {
+            blocks[i] = i / uint(B.size());
+        }
+        B = coarseB;
+
+        strengthThreshold *= 0.5;
+    }
+
+    this->factorizeCoarseMatrix();
+
+    uint nLevels = this->getNLevels();
+    this->levelB.resize(nLevels);
+    this->levelX.resize(nLevels);
+    this->levelR.resize(nLevels);
+    for (uint level=0;level<nLevels;level++)
+    {
+        uint n = this->getMatrix(level).getNRows();
+        this->levelB[level].resize(n,0.0);
+        this->levelX[level].resize(n,0.0);
+        this->levelR[level].resize(n,0.0);
+    }
+}
+
+uint RAlgebraicMultigrid::getNLevels(void) const
+{
+    return uint(this->smootherWeights.size());
+}
+
+void RAlgebraicMultigrid::compute(const RRVector &b, RRVector &x) const
+{
+    if (!this->pMatrix)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Algebraic multigrid hierarchy has not been built.");
+    }
+
+#pragma omp single
+    x.resize(this->pMatrix->getNRows());
+
+    this->cycle(0,b,x);
+}
+
+const RSparseMatrixCSR &RAlgebraicMultigrid::getMatrix(uint level) const
+{
+    if (level == 0)
+    {
+        return (*this->pMatrix);
+    }
+    return this->coarseMatrices[level-1];
+}
+
+uint RAlgebraicMultigrid::findAggregates(const RSparseMatrixCSR &matrix, const std::vector<uint> &rowBlockIndexes, uint nBlocks, double strengthThreshold, std::vector<uint> &blockAggregates)
+{
+    uint nRows = matrix.getNRows();
+
+    // Rows of each block.
+    std::vector<uint> blockRowPointers(nBlocks+1,0);
+    for (uint i=0;i<nRows;i++)
+    {
+        blockRowPointers[rowBlockIndexes[i]+1]++;
+    }
+    for (uint i=0;i<nBlocks;i++)
+    {
+        blockRowPointers[i+1] += blockRowPointers[i];
+    }
+    std::vector<uint> blockRows(nRows);
+    std::vector<uint> blockPositions(blockRowPointers.begin(),blockRowPointers.end()-1);
+    for (uint i=0;i<nRows;i++)
+    {
+        blockRows[blockPositions[rowBlockIndexes[i]]++] = i;
+    }
+
+    // Squared Frobenius norms of diagonal blocks and strong connections between blocks.
+    std::vector<double> diagonalNorms(nBlocks,0.0);
+    std::vector<uint> strongPointers(nBlocks+1,0);
+    std::vector<uint> strongBlocks;
+    std::vector<double> strongValues;
+
+    double threshold2 = strengthThreshold * strengthThreshold;
+
+#pragma omp parallel default(shared)
+    {
+        std::vector<double> norms(nBlocks,0.0);
+        std::vector<uint> marks(nBlocks,RConstants::eod);
+        std::vector<uint> touched;
+
+        for (uint pass=0;pass<3;pass++)
+        {
+#pragma omp for schedule(static)
+            for (int64_t I=0;I<int64_t(nBlocks);I++)
+            {
+                touched.clear();
+                for (uint p=blockRowPointers[I];p<blockRowPointers[I+1];p++)
+                {
+                    uint i = blockRows[p];
+                    for (uint k=matrix.getRowBegin(i);k<matrix.getRowEnd(i);k++)
+                    {
+                        uint J = rowBlockIndexes[matrix.getColumnIndex(k)];
+                        if (marks[J] != uint(I))
+                        {
+                            marks[J] = uint(I);
+                            touched.push_back(J);
+                        }
+                        norms[J] += std::pow(matrix.getValue(k),2);
+                    }
+                }
+
+                if (pass == 0)
+                {
+                    diagonalNorms[I] = norms[I];
+                }
+                else
+                {
+                    uint nStrong = 0;
+                    for (uint t=0;t<touched.size();t++)
+                    {
+                        uint J = touched[t];
+                        if (J != uint(I) && norms[J] >= threshold2 * std::sqrt(diagonalNorms[I] * diagonalNorms[J]))
+                        {
+                            if (pass == 2)
+                            {
+                                strongBlocks[strongPointers[I]+nStrong] = J;
+                                strongValues[strongPointers[I]+nStrong] = norms[J];
+                            }
+                            nStrong++;
+                        }
+                    }
+                    if (pass == 1)
+                    {
+                        strongPointers[I+1] = nStrong;
+                    }
+                }
+
+                for (uint t=0;t<touched.size();t++)
+                {
+                    norms[touched[t]] = 0.0;
+                    marks[touched[t]] = RConstants::eod;
+                }
+            }
+
+            if (pass == 1)
+            {
+#pragma omp single
+                {
+                    for (uint I=0;I<nBlocks;I++)
+                    {
+                        strongPointers[I+1] += strongPointers[I];
+                    }
+                    strongBlocks.resize(strongPointers[nBlocks]);
+                    strongValues.resize(strongPointers[nBlocks]);
+                }
+            }
+        }
+    }
+
+    blockAggregates.assign(nBlocks,RConstants::eod);
+    uint nAggregates = 0;
+
+    // Phase 1: blocks whose strong neighbors are all free form new aggregates.
+    for (uint I=0;I<nBlocks;I++)
+    {
+        if (blockAggregates[I] != RConstants::eod || strongPointers[I] == strongPointers[I+1])
+        {
+            continue;
+        }
+        bool free = true;
+        for (uint p=strongPointers[I];p<strongPointers[I+1];p++)
+        {
+            if (blockAggregates[strongBlocks[p]] != RConstants::eod)
+            {
+                free = false;
+                break;
+            }
+        }
+        if (!free)
+        {
+            continue;
+        }
+        blockAggregates[I] = nAggregates;
+        for (uint p=strongPointers[I];p<strongPointers[I+1];p++)
+        {
+            blockAggregates[strongBlocks[p]] = nAggregates;
+        }
+        nAggregates++;
+    }
+
+    // Phase 2: remaining blocks join most strongly connected aggregate from phase 1.
+    std::vector<uint> phase1Aggregates(blockAggregates);
+    for (uint I=0;I<nBlocks;I++)
+    {
+        if (blockAggregates[I] != RConstants::eod)
+        {
+            continue;
+        }
+        double maxValue = 0.0;
+        for (uint p=strongPointers[I];p<strongPointers[I+1];p++)
+        {
+            uint aggregate = phase1Aggregates[strongBlocks[p]];
+            if (aggregate != RConstants::eod && strongValues[p] > maxValue)
+            {
+                maxValue = strongValues[p];
+                blockAggregates[I] = aggregate;
+            }
+        }
+    }
+
+    // Phase 3: still unaggregated blocks form aggregates with their free strong neighbors.
+    for (uint I=0;I<nBlocks;I++)
+    {
+        if (blockAggregates[I] != RConstants::eod || strongPointers[I] == strongPointers[I+1])
+        {
+            continue;
+        }
+        blockAggregates[I] = nAggregates;
+        for (uint p=strongPointers[I];p<strongPointers[I+1];p++)
+        {
+            if (blockAggregates[strongBlocks[p]] == RConstants::eod)
+            {
+                blockAggregates[strongBlocks[p]] = nAggregates;
+            }
+        }
+        nAggregates++;
+    }
+
+    return nAggregates;
+}
+
+void RAlgebraicMultigrid::buildTentativeProlongator(const std::vector<RRVector> &nearNullSpace,
+                                                    const std::vector<uint> &rowBlockIndexes,
+                                                    const std::vector<uint> &blockAggregates,
+                                                    uint nAggregates,
+                                                    RSparseMatrixCSR &tentativeProlongator,
+                                                    std::vector<RRVector> &coarseNearNullSpace)
+{
+    uint nRows = uint(rowBlockIndexes.size());
+    uint nNull = uint(nearNullSpace.size());
+
+    // Rows of each aggregate.
+    std::vector<uint> aggregateRowPointers(nAggregates+1,0);
+    for (uint i=0;i<nRows;i++)
+    {
+        uint aggregate = blockAggregates[rowBlockIndexes[i]];
+        if (aggregate != RConstants::eod)
+        {
+            aggregateRowPointers[aggregate+1]++;
+        }
+    }
+    for (uint a=0;a<nAggregates;a++)
+    {
+        aggregateRowPointers[a+1] += aggregateRowPointers[a];
+    }
+    std::vector<uint> aggregateRows(aggregateRowPointers[nAggregates]);
+    std::vector<uint> rowPositions(nRows,RConstants::eod);
+    std::vector<uint> aggregatePositions(aggregateRowPointers.begin(),aggregateRowPointers.end()-1);
+    for (uint i=0;i<nRows;i++)
+    {
+        uint aggregate = blockAggregates[rowBlockIndexes[i]];
+        if (aggregate != RConstants::eod)
+        {
+            rowPositions[i] = aggregatePositions[aggregate]++;
+            aggregateRows[rowPositions[i]] = i;
+        }
+    }
+
+    // Orthonormalize near null space on each aggregate (modified Gram-Schmidt QR).
+    std::vector<double> Q(aggregateRows.size()*nNull,0.0);
+    coarseNearNullSpace.assign(nNull,RRVector(nAggregates*nNull,0.0));
+
+#pragma omp parallel for default(shared)
+    for (int64_t a=0;a<int64_t(nAggregates);a++)
+    {
+        uint begin = aggregateRowPointers[a];
+        uint end = aggregateRowPointers[a+1];
+
+        for (uint k=0;k<nNull;k++)
+        {
+            double originalNorm = 0.0;
+            for (uint p=begin;p<end;p++)
+            {
+                Q[p*nNull+k] = nearNullSpace[k][aggregateRows[p]];
+                originalNorm += std::pow(Q[p*nNull+k],2);
+            }
+            originalNorm = std::sqrt(originalNorm);
+
+            for (uint j=0;j<k;j++)
+            {
+                double r = 0.0;
+                for (uint p=begin;p<end;p++)
+                {
+                    r += Q[p*nNull+j] * Q[p*nNull+k];
+                }
+                for (uint p=begin;p<end;p++)
+                {
+                    Q[p*nNull+k] -= r * Q[p*nNull+j];
+                }
+                coarseNearNullSpace[k][a*nNull+j] = r;
+            }
+
+            double norm = 0.0;
+            for (uint p=begin;p<end;p++)
+            {
+                norm += std::pow(Q[p*nNull+k],2);
+            }
+            norm = std::sqrt(norm);
+
+            // Linearly dependent vector is dropped.
+            if (norm <= 1.0e-10 * originalNorm || norm == 0.0)
+            {
+                norm = 0.0;
+            }
+            for (uint p=begin;p<end;p++)
+            {
+                Q[p*nNull+k] = (norm == 0.0) ? 0.0 : Q[p*nNull+k] / norm;
+            }
+            coarseNearNullSpace[k][a*nNull+k] = norm;
+        }
+    }
+
+    // Assemble tentative prolongator.
+    std::vector<uint> rowPointers(nRows+1,0);
+    for (uint i=0;i<nRows;i++)
+    {
+        uint nValues = 0;
+        if (rowPositions[i] != RConstants::eod)
+        {
+            for (uint k=0;k<nNull;k++)
+            {
+                if (Q[rowPositions[i]*nNull+k] != 0.0)
+                {
+                    nValues++;
+                }
+            }
+        }
+        rowPointers[i+1] = rowPointers[i] + nValues;
+    }
+
+    std::vector<uint> columnIndexes(rowPointers[nRows]);
+    std::vector<double> values(rowPointers[nRows]);
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nRows);i++)
+    {
+        if (rowPositions[i] == RConstants::eod)
+        {
+            continue;
+        }
+        uint aggregate = blockAggregates[rowBlockIndexes[i]];
+        uint position = rowPointers[i];
+        for (uint k=0;k<nNull;k++)
+        {
+            double value = Q[rowPositions[i]*nNull+k];
+            if (value != 0.0)
+            {
+                columnIndexes[position] = aggregate*nNull + k;
+                values[position] = value;
+                position++;
+            }
+        }
+    }
+
+    tentativeProlongator.build(rowPointers,columnIndexes,values);
+}
+
+double RAlgebraicMultigrid::estimateSpectralRadius(const RSparseMatrixCSR &matrix, const RRVector &invDiagonal)
+{
+    uint nRows = matrix.getNRows();
+
+    if (nRows == 0)
+    {
+        return 0.0;
+    }
+
+    RRVector v(nRows);
+    RRVector w(nRows);
+
+    // Deterministic pseudo-random start vector.
+    for (uint i=0;i<nRows;i++)
+    {
+        v[i] = 0.5 + double((uint64_t(i) * 2654435761u) % 1000) / 1000.0;
+    }
+
+    double rho = 0.0;
+
+    for (uint iteration=0;iteration<nPowerIterations;iteration++)
+    {
+        double vn = 0.0;
+        double wn = 0.0;
+
+#pragma omp parallel for default(shared) reduction(+:vn,wn)
+        for (int64_t i=0;i<int64_t(nRows);i++)
+        {
+            w[i] = invDiagonal[i] * matrix.mltRow(uint(i),v);
+            vn += v[i]*v[i];
+            wn += w[i]*w[i];
+        }
+
+        if (vn == 0.0 || wn == 0.0)
+        {
+            break;
+        }
+
+        rho = std::sqrt(wn/vn);
+
+        double scale = 1.0 / std::sqrt(wn);
+#pragma omp parallel for default(shared)
+        for (int64_t i=0;i<int64_t(nRows);i++)
+        {
+            v[i] = w[i] * scale;
+        }
+    }
+
+    return rho;
+}
+
+void RAlgebraicMultigrid::factorizeCoarseMatrix(void)
+{
+    const RSparseMatrixCSR &A = this->getMatrix(this->getNLevels()-1);
+    uint n = A.getNRows();
+
+    if (n > maxDirectNRows)
+    {
+        RLogger::warning("Coarsest multigrid level has %u rows and will be solved approximately by smoother.\n",n);
+        this->coarseLU.resize(0,0);
+        this->coarsePivots.clear();
+        return;
+    }
+
+    this->coarseLU.resize(n,n,0.0);
+    for (uint i=0;i<n;i++)
+    {
+        for (uint k=A.getRowBegin(i);k<A.getRowEnd(i);k++)
+        {
+            this->coarseLU[i][A.getColumnIndex(k)] = A.getValue(k);
+        }
+    }
+
+    // LU factorization with partial pivoting.
+    this->coarsePivots.resize(n);
+    for (uint i=0;i<n;i++)
+    {
+        this->coarsePivots[i] = i;
+    }
+
+    for (uint k=0;k<n;k++)
+    {
+        uint p = k;
+        for (uint i=k+1;i<n;i++)
+        {
+            if (std::abs(this->coarseLU[i][k]) > std::abs(this->coarseLU[p][k]))
+            {
+                p = i;
+            }
+        }
+        if (p != k)
+        {
+            std::swap(this->coarseLU[p],this->coarseLU[k]);
+            std::swap(this->coarsePivots[p],this->coarsePivots[k]);
+        }
+
+        // Rows which are not connected to any aggregate have zero pivot.
+        if (std::abs(this->coarseLU[k][k]) < RConstants::eps)
+        {
+            this->coarseLU[k][k] = (this->coarseLU[k][k] < 0.0) ? -RConstants::eps : RConstants::eps;
+        }
+
+        double pivot = this->coarseLU[k][k];
+        const double *rowK = this->coarseLU[k].data();
+
+#pragma omp parallel for default(shared)
+        for (int64_t i=k+1;i<int64_t(n);i++)
+        {
+            double *rowI = this->coarseLU[uint(i)].data();
+            double lik = rowI[k] / pivot;
+            rowI[k] = lik;
+            if (lik != 0.0)
+            {
+                for (uint j=k+1;j<n;j++)
+                {
+                    rowI[j] -= lik * rowK[j];
+                }
+            }
+        }
+    }
+}
+
+void RAlgebraicMultigrid::cycle(uint level, const RRVector &b, RRVector &x) const
+{
+    if (level + 1 == this->getNLevels())
+    {
+        this->solveCoarse(b,x);
+        return;
+    }
+
+    const RSparseMatrixCSR &A = this->getMatrix(level);
+    const RSparseMatrixCSR &P = this->prolongators[level];
+    RRVector &r = this->levelR[level];
+    const RRVector &xc = this->levelX[level+1];
+
+    this->smooth(level,b,x,nSmootherSweeps,true);
+
+#pragma omp for
+    for (int64_t i=0;i<int64_t(A.getNRows());i++)
+    {
+        r[i] = b[i] - A.mltRow(uint(i),x);
+    }
+
+    RSparseMatrixCSR::mlt(this->restrictors[level],r,this->levelB[level+1]);
+
+    this->cycle(level+1,this->levelB[level+1],this->levelX[level+1]);
+
+#pragma omp for
+    for (int64_t i=0;i<int64_t(P.getNRows());i++)
+    {
+        x[i] += P.mltRow(uint(i),xc);
+    }
+
+    this->smooth(level,b,x,nSmootherSweeps,false);
+}
+
+void RAlgebraicMultigrid::smooth(uint level, const RRVector &b, RRVector &x, uint nSweeps, bool zeroInitialGuess) const
+{
+    const RSparseMatrixCSR &A = this->getMatrix(level);
+    const RRVector &w = this->smootherWeights[level];
+    RRVector &r = this->levelR[level];
+    uint nRows = A.getNRows();
+
+    uint sweep = 0;
+
+    if (zeroInitialGuess)
+    {
+#pragma omp for
+        for (int64_t i=0;i<int64_t(nRows);i++)
+        {
+            x[i] = w[i] * b[i];
+        }
+        sweep++;
+    }
+
+    for (;sweep<nSweeps;sweep++)
+    {
+#pragma omp for
+        for (int64_t i=0;i<int64_t(nRows);i++)
+        {
+            r[i] = b[i] - A.mltRow(uint(i),x);
+        }
+#pragma omp for
+        for (int64_t i=0;i<int64_t(nRows);i++)
+        {
+            x[i] += w[i] * r[i];
+        }
+    }
+}
+
+void RAlgebraicMultigrid::solveCoarse(const RRVector &b, RRVector &x) const
+{
+    uint level = this->getNLevels() - 1;
+
+    if (this->coarsePivots.empty())
+    {
+        this->smooth(level,b,x,nCoarseSmootherSweeps,true);
+        return;
+    }
+
+#pragma omp single
+    {
+        uint n = uint(this->coarsePivots.size());
+
+        // Forward substitution L*w = P*b
+        for (uint i=0;i<n;i++)
+        {
+            const double *rowI = this->coarseLU[i].data();
+            double value = b[this->coarsePivots[i]];
+            for (uint j=0;j<i;j++)
+            {
+                value -= rowI[j] * x[j];
+            }
+            x[i] = value;
+        }
+
+        // Backward substitution U*x = w
+        for (uint i=n;i>0;i--)
+        {
+            const double *rowI = this->coarseLU[i-1].data();
+            double value = x[i-1];
+            for (uint j=i;j<n;j++)
+            {
+                value -= rowI[j] * x[j];
+            }
+            x[i-1] = value / rowI[i-1];
+        }
+    }
+}
@@ -139,6 +139,9 @@ void REigenValueSolver::solveLanczos(const RSparseMatrix &M, const RSparseMatrix
     }
     v.normalize();
 
+    RSparseMatrixCSR Mc(M);
+    RSparseMatrixCSR Kc(K);
+
     RMatrixSolver solver(this->matrixSolverConf);
 
     uint ne = std::min(this->eigenValueSolverConf.getNEigenValues(),K.getNRows());
@@ -158,12 +161,12 @@ void REigenValueSolver::solveLanczos(const RSparseMatrix &M, const RSparseMatrix
 
         RRVector b;
 
-        RSparseMatrix::mlt(M,v,b);
+        RSparseMatrixCSR::mlt(Mc,v,b);
 
         if (i > 0)
         {
             RRVector bTmp;
-            RSparseMatrix::mlt(K,vo,bTmp);
+            RSparseMatrixCSR::mlt(Kc,vo,bTmp);
             bTmp *= e[i];
             for (uint j=0;j<b.size();j++)
             {
@@ -173,7 +176,7 @@ void REigenValueSolver::solveLanczos(const RSparseMatrix &M, const RSparseMatrix
 
         try
         {
-            solver.solve(K,b,w,R_MATRIX_PRECONDITIONER_JACOBI);
+            solver.solve(Kc,b,w,this->matrixSolverConf.getPreconditionerType());
         }
         catch (const RError &error)
         {
@@ -239,6 +242,9 @@ void REigenValueSolver::solveArnoldi(const RSparseMatrix &M, const RSparseMatrix
         Qa[i][0] = q[i];
     }
 
+    RSparseMatrixCSR Mc(M);
+    RSparseMatrixCSR Kc(K);
+
     RMatrixSolver solver(this->matrixSolverConf);
 
     // Arnoldi iteration
@@ -254,10 +260,10 @@ void REigenValueSolver::solveArnoldi(const RSparseMatrix &M, const RSparseMatrix
 
         // K*q = M*qo
         RRVector f;
-        RSparseMatrix::mlt(M,qo,f);
+        RSparseMatrixCSR::mlt(Mc,qo,f);
         try
         {
-            solver.solve(K,f,q,R_MATRIX_PRECONDITIONER_JACOBI);
+            solver.solve(Kc,f,q,this->matrixSolverConf.getPreconditionerType());
         }
         catch (const RError &error)
         {
@@ -340,7 +346,14 @@ void REigenValueSolver::solveRayleigh(const RSparseMatrix &M, const RSparseMatri
         kIndexes[i] = K.getRowIndexes(i);
     }
 
-    RMatrixSolver solver(this->matrixSolverConf);
+    RSparseMatrixCSR Mc(M);
+    RSparseMatrixCSR Kc(K);
+
+    // Separate solver for each matrix so that sparse direct solver keeps its factorization.
+    // Only values of M2 change between iterations.
+    RMatrixSolver solverM2(this->matrixSolverConf);
+    RMatrixSolver solverMc(this->matrixSolverConf);
+    RMatrixSolver solverKc(this->matrixSolverConf);
 
     for (uint it=0;it<nIterations;it++)
     {
@@ -366,7 +379,7 @@ void REigenValueSolver::solveRayleigh(const RSparseMatrix &M, const RSparseMatri
         }
 
         // (M + K*ui)*ci = K*bi
-        solver.solve(M2,f,c,R_MATRIX_PRECONDITIONER_JACOBI);
+        solverM2.solve(M2,f,c,this->matrixSolverConf.getPreconditionerType());
 
         // K*bi/||ci||
         double norm = RRVector::norm(c);
@@ -374,7 +387,7 @@ void REigenValueSolver::solveRayleigh(const RSparseMatrix &M, const RSparseMatri
         f *= 1.0 / norm;
 
         // (M + K*ui)*b(i+1) = K*bi/||ci||
-        solver.solve(M,f,b,R_MATRIX_PRECONDITIONER_JACOBI);
+        solverMc.solve(Mc,f,b,this->matrixSolverConf.getPreconditionerType());
 
         // Remove K*mu from M
         for (uint i=0;i<n;i++)
@@ -401,7 +414,7 @@ void REigenValueSolver::solveRayleigh(const RSparseMatrix &M, const RSparseMatri
         }
 
         // K*di = M*bi
-        solver.solve(K,f,d,R_MATRIX_PRECONDITIONER_JACOBI);
+        solverKc.solve(Kc,f,d,this->matrixSolverConf.getPreconditionerType());
 
         // mui = bi dot di / ( bi * bi)
         double bDot = RRVector::dot(b,b);
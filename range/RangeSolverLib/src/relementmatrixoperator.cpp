@@ -0,0 +1,308 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   relementmatrixoperator.cpp                               *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Element matrix operator class definition            *
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include "relementmatrixoperator.h"
+
+void RElementMatrixOperator::_init(const RElementMatrixOperator *pElementMatrixOperator)
+{
+    if (pElementMatrixOperator)
+    {
+        this->nRows = pElementMatrixOperator->nRows;
+        this->symmetric = pElementMatrixOperator->symmetric;
+        this->batchPointers = pElementMatrixOperator->batchPointers;
+        this->batchElements = pElementMatrixOperator->batchElements;
+        this->positionOffsets = pElementMatrixOperator->positionOffsets;
+        this->valueOffsets = pElementMatrixOperator->valueOffsets;
+        this->positions = pElementMatrixOperator->positions;
+        this->values = pElementMatrixOperator->values;
+    }
+}
+
+RElementMatrixOperator::RElementMatrixOperator()
+    : nRows(0)
+    , symmetric(false)
+{
+    this->_init();
+}
+
+RElementMatrixOperator::RElementMatrixOperator(const RElementMatrixOperator &elementMatrixOperator)
+    : RMatrixOperator()
+{
+    this->_init(&elementMatrixOperator);
+}
+
+RElementMatrixOperator::~RElementMatrixOperator()
+{
+}
+
+RElementMatrixOperator &RElementMatrixOperator::operator =(const RElementMatrixOperator &elementMatrixOperator)
+{
+    this->_init(&elementMatrixOperator);
+    return (*this);
+}
+
+void RElementMatrixOperator::build(uint nRows,
+                                   const std::vector<uint> &elementSizes,
+                                   const std::vector<std::vector<uint> > &elementBatches,
+                                   bool symmetric)
+{
+    uint nElements = uint(elementSizes.size());
+
+    this->nRows = nRows;
+    this->symmetric = symmetric;
+
+    this->positionOffsets.resize(nElements+1);
+    this->valueOffsets.resize(nElements+1);
+    this->positionOffsets[0] = 0;
+    this->valueOffsets[0] = 0;
+
+    for (uint i=0;i<nElements;i++)
+    {
+        quint64 n = elementSizes[i];
+        R_ERROR_ASSERT(n <= R_SMALL_MATRIX_MAX_SIZE);
+        this->positionOffsets[i+1] = this->positionOffsets[i] + uint(n);
+        this->valueOffsets[i+1] = this->valueOffsets[i] + (symmetric ? (n*(n+1))/2 : n*n);
+    }
+
+    this->positions.assign(this->positionOffsets[nElements],RConstants::eod);
+    this->values.assign(this->valueOffsets[nElements],0.0);
+
+    this->batchPointers.clear();
+    this->batchElements.clear();
+    this->batchPointers.push_back(0);
+    for (uint i=0;i<elementBatches.size();i++)
+    {
+        for (uint j=0;j<elementBatches[i].size();j++)
+        {
+            uint elementID = elementBatches[i][j];
+            R_ERROR_ASSERT(elementID < nElements);
+            if (elementSizes[elementID] > 0)
+            {
+                this->batchElements.push_back(elementID);
+            }
+        }
+        if (this->batchElements.size() > this->batchPointers.back())
+        {
+            this->batchPointers.push_back(uint(this->batchElements.size()));
+        }
+    }
+}
+
+void RElementMatrixOperator::clear(void)
+{
+    this->nRows = 0;
+    this->batchPointers.clear();
+    this->batchElements.clear();
+    this->positionOffsets.clear();
+    this->valueOffsets.clear();
+    this->positions.clear();
+    this->values.clear();
+    this->batchPointers.shrink_to_fit();
+    this->batchElements.shrink_to_fit();
+    this->positionOffsets.shrink_to_fit();
+    this->valueOffsets.shrink_to_fit();
+    this->positions.shrink_to_fit();
+    this->values.shrink_to_fit();
+}
+
+void RElementMatrixOperator::clearValues(void)
+{
+    std::fill(this->values.begin(),this->values.end(),0.0);
+}
+
+uint RElementMatrixOperator::getNElements(void) const
+{
+    return this->positionOffsets.empty() ? 0 : uint(this->positionOffsets.size() - 1);
+}
+
+quint64 RElementMatrixOperator::getMemorySize(void) const
+{
+    return quint64(this->batchPointers.size() + this->batchElements.size() + this->positionOffsets.size() + this->positions.size()) * sizeof(uint)
+         + quint64(this->valueOffsets.size()) * sizeof(quint64)
+         + quint64(this->values.size()) * sizeof(double);
+}
+
+void RElementMatrixOperator::setElementMatrix(uint elementID, const uint *elementPositions, const RRSmallMatrix &Ae)
+{
+    R_ERROR_ASSERT(elementID < this->getNElements());
+
+    uint n = this->positionOffsets[elementID+1] - this->positionOffsets[elementID];
+
+    R_ERROR_ASSERT(Ae.getNRows() == n && Ae.getNColumns() == n);
+
+    uint *pPositions = this->positions.data() + this->positionOffsets[elementID];
+    double *pValues = this->values.data() + this->valueOffsets[elementID];
+
+    for (uint m=0;m<n;m++)
+    {
+        pPositions[m] = elementPositions[m];
+        for (uint l=(this->symmetric ? m : 0);l<n;l++)
+        {
+            *pValues++ = Ae[m][l];
+        }
+    }
+}
+
+uint RElementMatrixOperator::getNRows(void) const
+{
+    return this->nRows;
+}
+
+void RElementMatrixOperator::mlt(const RRVector &x, RRVector &y) const
+{
+#pragma omp single
+    y.resize(this->nRows,0.0);
+
+    const double *pX = x.data();
+    double *pY = y.data();
+
+#pragma omp for
+    for (int64_t i=0;i<int64_t(this->nRows);i++)
+    {
+        pY[i] = 0.0;
+    }
+
+    for (uint c=0;c+1<this->batchPointers.size();c++)
+    {
+#pragma omp for
+        for (int64_t j=int64_t(this->batchPointers[c]);j<int64_t(this->batchPointers[c+1]);j++)
+        {
+            this->mltElement(this->batchElements[j],pX,pY);
+        }
+    }
+}
+
+void RElementMatrixOperator::findDiagonal(RRVector &d) const
+{
+    d.resize(this->nRows);
+    d.fill(0.0);
+
+    for (uint c=0;c+1<this->batchPointers.size();c++)
+    {
+#pragma omp parallel for default(shared)
+        for (int64_t j=int64_t(this->batchPointers[c]);j<int64_t(this->batchPointers[c+1]);j++)
+        {
+            uint elementID = this->batchElements[j];
+            uint n = this->positionOffsets[elementID+1] - this->positionOffsets[elementID];
+            const uint *pPositions = this->positions.data() + this->positionOffsets[elementID];
+            const double *pValues = this->values.data() + this->valueOffsets[elementID];
+
+            for (uint m=0;m<n;m++)
+            {
+                uint diagonalPosition = this->symmetric ? 0 : m;
+                if (pPositions[m] != RConstants::eod)
+                {
+                    d[pPositions[m]] += pValues[diagonalPosition];
+                }
+                pValues += this->symmetric ? (n - m) : n;
+            }
+        }
+    }
+}
+
+double RElementMatrixOperator::findNorm(void) const
+{
+    RRVector x(this->nRows,1.0);
+    RRVector y(this->nRows,0.0);
+    double norm = 0.0;
+
+#pragma omp parallel default(shared)
+    {
+        this->mlt(x,y);
+#pragma omp for reduction(+:norm)
+        for (int64_t i=0;i<int64_t(this->nRows);i++)
+        {
+            norm += y[i]*y[i];
+        }
+    }
+
+    return std::sqrt(norm);
+}
+
+double RElementMatrixOperator::findFrobeniusNorm(void) const
+{
+    uint nElements = this->getNElements();
+    double norm = 0.0;
+
+#pragma omp parallel for default(shared) reduction(+:norm)
+    for (int64_t i=0;i<int64_t(nElements);i++)
+    {
+        uint n = this->positionOffsets[i+1] - this->positionOffsets[i];
+        const uint *pPositions = this->positions.data() + this->positionOffsets[i];
+        const double *pValues = this->values.data() + this->valueOffsets[i];
+
+        for (uint m=0;m<n;m++)
+        {
+            for (uint l=(this->symmetric ? m : 0);l<n;l++)
+            {
+                double value = *pValues++;
+                if (pPositions[m] == RConstants::eod || pPositions[l] == RConstants::eod)
+                {
+                    continue;
+                }
+                norm += ((this->symmetric && l != m) ? 2.0 : 1.0) * value * value;
+            }
+        }
+    }
+
+    return std::sqrt(norm);
+}
+
+void RElementMatrixOperator::mltElement(uint elementID, const double *x, double *y) const
+{
+    uint n = this->positionOffsets[elementID+1] - this->positionOffsets[elementID];
+    const uint *pPositions = this->positions.data() + this->positionOffsets[elementID];
+    const double *pValues = this->values.data() + this->valueOffsets[elementID];
+
+    double xe[R_SMALL_MATRIX_MAX_SIZE];
+    double ye[R_SMALL_MATRIX_MAX_SIZE];
+
+    for (uint m=0;m<n;m++)
+    {
+        xe[m] = (pPositions[m] == RConstants::eod) ? 0.0 : x[pPositions[m]];
+        ye[m] = 0.0;
+    }
+
+    if (this->symmetric)
+    {
+        for (uint m=0;m<n;m++)
+        {
+            ye[m] += pValues[0] * xe[m];
+            for (uint l=m+1;l<n;l++)
+            {
+                ye[m] += pValues[l-m] * xe[l];
+                ye[l] += pValues[l-m] * xe[m];
+            }
+            pValues += n - m;
+        }
+    }
+    else
+    {
+        for (uint m=0;m<n;m++)
+        {
+            for (uint l=0;l<n;l++)
+            {
+                ye[m] += pValues[l] * xe[l];
+            }
+            pValues += n;
+        }
+    }
+
+    for (uint m=0;m<n;m++)
+    {
+        if (pPositions[m] != RConstants::eod)
+        {
+            y[pPositions[m]] += ye[m];
+        }
+    }
+}
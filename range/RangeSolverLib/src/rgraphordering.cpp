@@ -0,0 +1,356 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rgraphordering.cpp                                       *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Graph ordering class definition                     *
+ *********************************************************************/
+
+#include <algorithm>
+
+#include "rgraphordering.h"
+
+//! Subgraphs with less vertices are not dissected any further.
+static const uint nestedDissectionLeafSize = 64;
+//! Maximum number of breadth first searches used to find pseudo-peripheral vertex.
+static const uint nPseudoPeripheralSearches = 5;
+
+//! Breadth first search within part of graph. Returns number of levels, visited vertices are stored in given order.
+static uint findLevelStructure(const std::vector<uint> &adjacencyPointers,
+                               const std::vector<uint> &adjacency,
+                               const std::vector<uint> &parts,
+                               uint part,
+                               uint start,
+                               std::vector<uint> &levels,
+                               std::vector<uint> &visited)
+{
+    visited.clear();
+    visited.push_back(start);
+    levels[start] = 0;
+    uint nLevels = 1;
+    for (uint k=0;k<visited.size();k++)
+    {
+        uint v = visited[k];
+        for (uint p=adjacencyPointers[v];p<adjacencyPointers[v+1];p++)
+        {
+            uint w = adjacency[p];
+            if (parts[w] == part && levels[w] == RConstants::eod)
+            {
+                levels[w] = levels[v] + 1;
+                nLevels = std::max(nLevels,levels[w]+1);
+                visited.push_back(w);
+            }
+        }
+    }
+    return nLevels;
+}
+
+//! Reset levels of visited vertices.
+static void resetLevels(const std::vector<uint> &visited, std::vector<uint> &levels)
+{
+    for (uint k=0;k<visited.size();k++)
+    {
+        levels[visited[k]] = RConstants::eod;
+    }
+}
+
+//! Replace level structure by one rooted at pseudo-peripheral vertex (George-Liu).
+//! Level structure of visited vertices must be set, returns new number of levels.
+static uint findPseudoPeripheralLevelStructure(const std::vector<uint> &adjacencyPointers,
+                                               const std::vector<uint> &adjacency,
+                                               const std::vector<uint> &parts,
+                                               uint part,
+                                               uint nLevels,
+                                               std::vector<uint> &levels,
+                                               std::vector<uint> &visited)
+{
+    for (uint search=0;search<nPseudoPeripheralSearches;search++)
+    {
+        uint start = visited.back();
+        uint minDegree = RConstants::eod;
+        for (uint k=visited.size();k>0;k--)
+        {
+            uint v = visited[k-1];
+            if (levels[v] + 1 != nLevels)
+            {
+                break;
+            }
+            uint degree = adjacencyPointers[v+1] - adjacencyPointers[v];
+            if (degree < minDegree)
+            {
+                minDegree = degree;
+                start = v;
+            }
+        }
+        resetLevels(visited,levels);
+        uint nNewLevels = findLevelStructure(adjacencyPointers,adjacency,parts,part,start,levels,visited);
+        if (nNewLevels <= nLevels)
+        {
+            return nNewLevels;
+        }
+        nLevels = nNewLevels;
+    }
+    return nLevels;
+}
+
+//! Recursively dissect part of graph, separators are numbered after both halves.
+static void dissectGraph(const std::vector<uint> &adjacencyPointers,
+                         const std::vector<uint> &adjacency,
+                         const std::vector<uint> &vertices,
+                         uint part,
+                         std::vector<uint> &parts,
+                         uint &nParts,
+                         std::vector<uint> &levels,
+                         std::vector<uint> &permutation,
+                         uint &nOrdered)
+{
+    if (vertices.size() <= nestedDissectionLeafSize)
+    {
+        for (uint k=0;k<vertices.size();k++)
+        {
+            permutation[nOrdered++] = vertices[k];
+        }
+        return;
+    }
+
+    std::vector<uint> visited;
+    uint nLevels = findLevelStructure(adjacencyPointers,adjacency,parts,part,vertices[0],levels,visited);
+
+    if (visited.size() < vertices.size())
+    {
+        // Part is not connected - dissect each component separately.
+        std::vector< std::vector<uint> > components;
+        components.push_back(visited);
+        for (uint k=0;k<vertices.size();k++)
+        {
+            if (levels[vertices[k]] == RConstants::eod)
+            {
+                findLevelStructure(adjacencyPointers,adjacency,parts,part,vertices[k],levels,visited);
+                components.push_back(visited);
+            }
+        }
+        resetLevels(vertices,levels);
+        for (uint c=0;c<components.size();c++)
+        {
+            uint componentPart = nParts++;
+            for (uint k=0;k<components[c].size();k++)
+            {
+                parts[components[c][k]] = componentPart;
+            }
+        }
+        for (uint c=0;c<components.size();c++)
+        {
+            dissectGraph(adjacencyPointers,adjacency,components[c],parts[components[c][0]],parts,nParts,levels,permutation,nOrdered);
+        }
+        return;
+    }
+
+    nLevels = findPseudoPeripheralLevelStructure(adjacencyPointers,adjacency,parts,part,nLevels,levels,visited);
+
+    if (nLevels < 3)
+    {
+        resetLevels(visited,levels);
+        for (uint k=0;k<visited.size();k++)
+        {
+            permutation[nOrdered++] = visited[k];
+        }
+        return;
+    }
+
+    // Separator is the smallest level close to the middle of level structure.
+    std::vector<uint> levelSizes(nLevels,0);
+    for (uint k=0;k<visited.size();k++)
+    {
+        levelSizes[levels[visited[k]]]++;
+    }
+    uint middle = 0;
+    uint count = 0;
+    while (middle + 1 < nLevels && 2 * (count + levelSizes[middle]) < visited.size())
+    {
+        count += levelSizes[middle++];
+    }
+    uint window = std::max(1u,nLevels/10);
+    uint separatorLevel = std::min(std::max(middle,1u),nLevels-2);
+    uint lowerLevel = (middle > window) ? middle - window : 1;
+    uint upperLevel = std::min(middle + window,nLevels-2);
+    for (uint l=lowerLevel;l<=upperLevel;l++)
+    {
+        if (levelSizes[l] < levelSizes[separatorLevel])
+        {
+            separatorLevel = l;
+        }
+    }
+
+    std::vector<uint> partA;
+    std::vector<uint> partB;
+    std::vector<uint> separator;
+    for (uint k=0;k<visited.size();k++)
+    {
+        uint v = visited[k];
+        if (levels[v] < separatorLevel)
+        {
+            partA.push_back(v);
+        }
+        else if (levels[v] > separatorLevel)
+        {
+            partB.push_back(v);
+        }
+        else
+        {
+            // Separator vertex without neighbor in upper part is moved to lower part.
+            bool needed = false;
+            for (uint p=adjacencyPointers[v];p<adjacencyPointers[v+1];p++)
+            {
+                uint w = adjacency[p];
+                if (parts[w] == part && levels[w] == separatorLevel + 1)
+                {
+                    needed = true;
+                    break;
+                }
+            }
+            if (needed)
+            {
+                separator.push_back(v);
+            }
+            else
+            {
+                partA.push_back(v);
+            }
+        }
+    }
+    resetLevels(visited,levels);
+
+    uint partIdA = nParts++;
+    uint partIdB = nParts++;
+    uint partIdS = nParts++;
+    for (uint k=0;k<partA.size();k++)
+    {
+        parts[partA[k]] = partIdA;
+    }
+    for (uint k=0;k<partB.size();k++)
+    {
+        parts[partB[k]] = partIdB;
+    }
+    for (uint k=0;k<separator.size();k++)
+    {
+        parts[separator[k]] = partIdS;
+    }
+
+    dissectGraph(adjacencyPointers,adjacency,partA,partIdA,parts,nParts,levels,permutation,nOrdered);
+    dissectGraph(adjacencyPointers,adjacency,partB,partIdB,parts,nParts,levels,permutation,nOrdered);
+    for (uint k=0;k<separator.size();k++)
+    {
+        permutation[nOrdered++] = separator[k];
+    }
+}
+
+void RGraphOrdering::findNestedDissection(const std::vector<uint> &adjacencyPointers, const std::vector<uint> &adjacency, std::vector<uint> &permutation)
+{
+    uint n = uint(adjacencyPointers.size()) - 1;
+
+    permutation.resize(n);
+
+    std::vector<uint> parts(n,0);
+    std::vector<uint> levels(n,RConstants::eod);
+    std::vector<uint> vertices(n);
+    for (uint i=0;i<n;i++)
+    {
+        vertices[i] = i;
+    }
+
+    uint nParts = 1;
+    uint nOrdered = 0;
+    dissectGraph(adjacencyPointers,adjacency,vertices,0,parts,nParts,levels,permutation,nOrdered);
+}
+
+void RGraphOrdering::findReverseCuthillMcKee(const std::vector<uint> &adjacencyPointers, const std::vector<uint> &adjacency, std::vector<uint> &permutation)
+{
+    uint n = uint(adjacencyPointers.size()) - 1;
+
+    permutation.resize(n);
+
+    // Ordered vertices are moved from part 0 to part 1.
+    std::vector<uint> parts(n,0);
+    std::vector<uint> levels(n,RConstants::eod);
+    std::vector<uint> visited;
+    std::vector<uint> neighbors;
+
+    uint nOrdered = 0;
+    for (uint i=0;i<n;i++)
+    {
+        if (parts[i] != 0)
+        {
+            continue;
+        }
+
+        // Each connected component starts from its pseudo-peripheral vertex.
+        uint nLevels = findLevelStructure(adjacencyPointers,adjacency,parts,0,i,levels,visited);
+        findPseudoPeripheralLevelStructure(adjacencyPointers,adjacency,parts,0,nLevels,levels,visited);
+        uint start = visited[0];
+        resetLevels(visited,levels);
+
+        uint head = nOrdered;
+        permutation[nOrdered++] = start;
+        parts[start] = 1;
+
+        // Cuthill-McKee - breadth first search, neighbors are visited in order of increasing degree.
+        while (head < nOrdered)
+        {
+            uint v = permutation[head++];
+
+            neighbors.clear();
+            for (uint p=adjacencyPointers[v];p<adjacencyPointers[v+1];p++)
+            {
+                uint w = adjacency[p];
+                if (parts[w] == 0)
+                {
+                    parts[w] = 1;
+                    neighbors.push_back(w);
+                }
+            }
+            for (uint k=1;k<neighbors.size();k++)
+            {
+                uint w = neighbors[k];
+                uint degree = adjacencyPointers[w+1] - adjacencyPointers[w];
+                uint l = k;
+                while (l > 0 && adjacencyPointers[neighbors[l-1]+1] - adjacencyPointers[neighbors[l-1]] > degree)
+                {
+                    neighbors[l] = neighbors[l-1];
+                    l--;
+                }
+                neighbors[l] = w;
+            }
+            for (uint k=0;k<neighbors.size();k++)
+            {
+                permutation[nOrdered++] = neighbors[k];
+            }
+        }
+    }
+
+    std::reverse(permutation.begin(),permutation.end());
+}
+
+uint RGraphOrdering::findBandwidth(const std::vector<uint> &adjacencyPointers, const std::vector<uint> &adjacency, const std::vector<uint> &permutation)
+{
+    uint n = uint(adjacencyPointers.size()) - 1;
+
+    std::vector<uint> positions(n);
+    for (uint i=0;i<n;i++)
+    {
+        positions[permutation.empty() ? i : permutation[i]] = i;
+    }
+
+    uint bandwidth = 0;
+    for (uint i=0;i<n;i++)
+    {
+        for (uint p=adjacencyPointers[i];p<adjacencyPointers[i+1];p++)
+        {
+            uint pi = positions[i];
+            uint pj = positions[adjacency[p]];
+            bandwidth = std::max(bandwidth,(pi > pj) ? pi - pj : pj - pi);
+        }
+    }
+    return bandwidth;
+}
@@ -12,50 +12,16 @@
 
 #include "rhemicube.h"
 
-class RHemicubeTriangle
-{
-    protected:
-
-        RTriangle triangle;
-        uint color;
-
-    public:
-
-        RHemicubeTriangle(const RTriangle &triangle, uint color) : triangle(triangle), color(color) {}
-
-        const RTriangle &getTriangle(void) const { return this->triangle; }
-
-        uint getColor(void) const { return this->color; }
-};
-
-class RHemicubeTriangleComp
-{
-    protected:
-
-        RR3Vector eye;
-
-    public:
-
-        RHemicubeTriangleComp(const RR3Vector &eye) : eye(eye) {}
-
-        bool operator() (const RHemicubeTriangle &t1,const RHemicubeTriangle &t2)
-        {
-            double d1 = RSegment::findLength(RNode(this->eye),t1.getTriangle().getNode1());
-            d1 = std::min(d1,RSegment::findLength(RNode(this->eye),t1.getTriangle().getNode2()));
-            d1 = std::min(d1,RSegment::findLength(RNode(this->eye),t1.getTriangle().getNode3()));
-
-            double d2 = RSegment::findLength(RNode(this->eye),t2.getTriangle().getNode1());
-            d2 = std::min(d2,RSegment::findLength(RNode(this->eye),t2.getTriangle().getNode2()));
-            d2 = std::min(d2,RSegment::findLength(RNode(this->eye),t2.getTriangle().getNode3()));
-
-            return (d1 < d2);
-        }
-};
+//! Maximum number of view-factor closure iterations.
+#define R_HEMICUBE_CLOSURE_MAX_ITERATIONS 100
+//! View-factor closure tolerance (maximum row sum error).
+#define R_HEMICUBE_CLOSURE_TOLERANCE 1.0e-6
 
 void RHemiCube::_init(const RHemiCube *pHemiCube)
 {
     if (pHemiCube)
     {
+        this->eyePosition = pHemiCube->eyePosition;
         this->eyeDirection = pHemiCube->eyeDirection;
         this->sectors.resize(pHemiCube->sectors.size());
         for (uint i=0;i<pHemiCube->sectors.size();i++)
@@ -66,7 +32,8 @@ void RHemiCube::_init(const RHemiCube *pHemiCube)
 }
 
 RHemiCube::RHemiCube(const RR3Vector &eyePosition, const RR3Vector &eyeDirection, uint resolution, double size)
-    : eyeDirection(eyeDirection)
+    : eyePosition(eyePosition)
+    , eyeDirection(eyeDirection)
 {
     this->_init();
     this->generate(eyePosition,eyeDirection,resolution,size);
@@ -100,6 +67,14 @@ void RHemiCube::rayTraceTriangle(const RTriangle &triangle, uint color)
     }
 }
 
+void RHemiCube::rayTraceScene(const RHemiCubeScene &scene, uint skipColor)
+{
+    for (uint i=0;i<this->sectors.size();i++)
+    {
+        scene.rayTrace(*this->sectors[i],this->eyePosition,skipColor);
+    }
+}
+
 std::map<uint, double> RHemiCube::getViewFactors(void) const
 {
 
@@ -150,6 +125,199 @@ double RHemiCube::getFillRatio(void) const
 }
 
 void RHemiCube::calculateViewFactors(const RModel &model, RViewFactorMatrix &rViewFactorMatrix)
+{
+    std::vector<bool> rowFlags(rViewFactorMatrix.getPatchBook().getNPatches(),true);
+    RHemiCube::calculateViewFactors(model,rViewFactorMatrix,rowFlags);
+}
+
+void RHemiCube::updateViewFactors(const RModel &model, const RViewFactorMatrix &oldViewFactorMatrix, RViewFactorMatrix &rViewFactorMatrix)
+{
+    const RPatchBook &rOldPatchBook = oldViewFactorMatrix.getPatchBook();
+    const std::vector<RPatchInput> &rOldPatchInput = oldViewFactorMatrix.getHeader().getPatchInput();
+    const std::vector<quint64> &rOldPatchHashes = oldViewFactorMatrix.getHeader().getPatchHashes();
+
+    const RPatchBook &rPatchBook = rViewFactorMatrix.getPatchBook();
+    const std::vector<RPatchInput> &rPatchInput = rViewFactorMatrix.getHeader().getPatchInput();
+
+    uint nOldPatches = rOldPatchBook.getNPatches();
+    uint nPatches = rPatchBook.getNPatches();
+
+    if (rOldPatchHashes.size() != nOldPatches
+        || oldViewFactorMatrix.size() != nOldPatches
+        || oldViewFactorMatrix.getHeader().getHemicubeResolution() != model.getProblemSetup().getRadiationSetup().getResolution()
+        || oldViewFactorMatrix.getHeader().getViewFactorMethod() != model.getProblemSetup().getRadiationSetup().getViewFactorMethod()
+        || oldViewFactorMatrix.getHeader().getViewFactorCorrection() != model.getProblemSetup().getRadiationSetup().getViewFactorCorrection()
+        || oldViewFactorMatrix.getHeader().getViewFactorThreshold() != model.getProblemSetup().getRadiationSetup().getViewFactorThreshold())
+    {
+        RHemiCube::calculateViewFactors(model,rViewFactorMatrix);
+        return;
+    }
+
+    // Post-processing couples all rows, stored rows are already corrected and cannot be reused.
+    if (model.getProblemSetup().getRadiationSetup().getViewFactorCorrection()
+        || model.getProblemSetup().getRadiationSetup().getViewFactorThreshold() > 0.0)
+    {
+        RLogger::info("View-factor correction is enabled, recalculating all view-factor rows.\n");
+        RHemiCube::calculateViewFactors(model,rViewFactorMatrix);
+        return;
+    }
+
+    std::vector<quint64> patchHashes;
+    model.generatePatchHashes(rPatchBook,patchHashes);
+
+    // Match new patches to old ones by geometry hash.
+    std::map<quint64,uint> oldPatchMap;
+    for (uint i=0;i<nOldPatches;i++)
+    {
+        oldPatchMap[rOldPatchHashes[i]] = i;
+    }
+
+    std::vector<uint> newToOld(nPatches,RConstants::eod);
+    std::vector<bool> oldChanged(nOldPatches,true);
+    std::vector<bool> newChanged(nPatches,true);
+    std::vector<bool> rowFlags(nPatches,true);
+
+    for (uint i=0;i<nPatches;i++)
+    {
+        std::map<quint64,uint>::const_iterator iter = oldPatchMap.find(patchHashes[i]);
+        if (iter == oldPatchMap.end())
+        {
+            continue;
+        }
+        uint oldPatchID = iter->second;
+        const RPatchInput &rInput = rPatchInput[rPatchBook.getPatch(i).getSurfaceID()];
+        const RPatchInput &rOldInput = rOldPatchInput[rOldPatchBook.getPatch(oldPatchID).getSurfaceID()];
+
+        newToOld[i] = oldPatchID;
+        // Patch with changed receiver flag appears in (or disappears from) other rows.
+        newChanged[i] = oldChanged[oldPatchID] = (rInput.getReceiver() != rOldInput.getReceiver());
+        // Patch with changed emitter flag has different row.
+        rowFlags[i] = (rInput.getEmitter() != rOldInput.getEmitter());
+    }
+
+    // Elements of changed receiving patches which may become visible.
+    std::vector<uint> changedElementIDs;
+    for (uint i=0;i<nPatches;i++)
+    {
+        if (newChanged[i] && rPatchInput[rPatchBook.getPatch(i).getSurfaceID()].getReceiver())
+        {
+            const RUVector &rElementIDs = rPatchBook.getPatch(i).getElementIDs();
+            for (uint j=0;j<rElementIDs.size();j++)
+            {
+                changedElementIDs.push_back(rElementIDs[j]);
+            }
+        }
+    }
+
+    // Separate array is used because std::vector<bool> can not be written in parallel.
+    std::vector<char> seesChange(nPatches,0);
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nPatches);i++)
+    {
+        if (rowFlags[i])
+        {
+            continue;
+        }
+        const RPatch &rPatch = rPatchBook.getPatch(uint(i));
+        if (!rPatchInput[rPatch.getSurfaceID()].getEmitter())
+        {
+            continue;
+        }
+
+        // Row has seen patch which has changed.
+        const RSparseVector<double> &rOldViewFactors = oldViewFactorMatrix.getRow(newToOld[i]).getViewFactors();
+        for (uint j=0;j<rOldViewFactors.size();j++)
+        {
+            if (oldChanged[rOldViewFactors.getIndex(j)])
+            {
+                seesChange[i] = 1;
+                break;
+            }
+        }
+        if (seesChange[i])
+        {
+            continue;
+        }
+
+        // Changed element is in front of the patch and faces it.
+        RR3Vector c, n;
+        model.findPatchCenter(rPatch,c[0],c[1],c[2]);
+        model.findPatchNormal(rPatch,n[0],n[1],n[2]);
+
+        for (uint j=0;j<changedElementIDs.size();j++)
+        {
+            const RElement &rElement = model.getElement(changedElementIDs[j]);
+
+            bool inFront = false;
+            for (uint k=0;k<rElement.size();k++)
+            {
+                const RNode &rNode = model.getNode(rElement.getNodeId(k));
+                if (n[0]*(rNode.getX()-c[0]) + n[1]*(rNode.getY()-c[1]) + n[2]*(rNode.getZ()-c[2]) > 0.0)
+                {
+                    inFront = true;
+                    break;
+                }
+            }
+            if (!inFront)
+            {
+                continue;
+            }
+
+            double ex, ey, ez, enx, eny, enz;
+            rElement.findCenter(model.getNodes(),ex,ey,ez);
+            rElement.findNormal(model.getNodes(),enx,eny,enz);
+            if (enx*(c[0]-ex) + eny*(c[1]-ey) + enz*(c[2]-ez) > 0.0)
+            {
+                seesChange[i] = 1;
+                break;
+            }
+        }
+    }
+
+    for (uint i=0;i<nPatches;i++)
+    {
+        if (seesChange[i])
+        {
+            rowFlags[i] = true;
+        }
+    }
+
+    // Copy rows which are still valid, old column IDs are mapped to new ones.
+    std::vector<uint> oldToNew(nOldPatches,RConstants::eod);
+    for (uint i=0;i<nPatches;i++)
+    {
+        if (newToOld[i] != RConstants::eod)
+        {
+            oldToNew[newToOld[i]] = i;
+        }
+    }
+
+    rViewFactorMatrix.resize(nPatches);
+
+    uint nRecalculate = 0;
+    for (uint i=0;i<nPatches;i++)
+    {
+        RSparseVector<double> &rViewFactors = rViewFactorMatrix.getRow(i).getViewFactors();
+        rViewFactors.clear();
+        if (rowFlags[i])
+        {
+            nRecalculate++;
+            continue;
+        }
+        const RSparseVector<double> &rOldViewFactors = oldViewFactorMatrix.getRow(newToOld[i]).getViewFactors();
+        for (uint j=0;j<rOldViewFactors.size();j++)
+        {
+            rViewFactors.addValue(oldToNew[rOldViewFactors.getIndex(j)],rOldViewFactors.getValue(j));
+        }
+    }
+
+    RLogger::info("Recalculating %u of %u view-factor rows.\n",nRecalculate,nPatches);
+
+    RHemiCube::calculateViewFactors(model,rViewFactorMatrix,rowFlags);
+}
+
+void RHemiCube::calculateViewFactors(const RModel &model, RViewFactorMatrix &rViewFactorMatrix, const std::vector<bool> &rowFlags)
 {
     RPatchBook &rPatchBook = rViewFactorMatrix.getPatchBook();
     std::vector<RPatchInput> &rPatchInput = rViewFactorMatrix.getHeader().getPatchInput();
@@ -157,18 +325,42 @@ void RHemiCube::calculateViewFactors(const RModel &model, RViewFactorMatrix &rVi
 
     rViewFactorMatrix.getHeader().setNElements(model.getNElements());
     rViewFactorMatrix.getHeader().setHemicubeResolution(model.getProblemSetup().getRadiationSetup().getResolution());
+    rViewFactorMatrix.getHeader().setViewFactorMethod(model.getProblemSetup().getRadiationSetup().getViewFactorMethod());
+    rViewFactorMatrix.getHeader().setViewFactorCorrection(model.getProblemSetup().getRadiationSetup().getViewFactorCorrection());
+    rViewFactorMatrix.getHeader().setViewFactorThreshold(model.getProblemSetup().getRadiationSetup().getViewFactorThreshold());
+    model.generatePatchHashes(rPatchBook,rViewFactorMatrix.getHeader().getPatchHashes());
 
     rViewFactorMatrix.resize(rPatchBook.getNPatches());
 
-    RLogger::info("Calculating view-factors.\n");
+    uint nRows = 0;
+    for (uint i=0;i<rowFlags.size();i++)
+    {
+        if (rowFlags[i])
+        {
+            nRows++;
+        }
+    }
+
+    RViewFactorMethod viewFactorMethod = rViewFactorMatrix.getHeader().getViewFactorMethod();
+    const std::vector<quint64> &rPatchHashes = rViewFactorMatrix.getHeader().getPatchHashes();
+
+    RLogger::info("Calculating view-factors (%s).\n",RRadiationSetup::getViewFactorMethodText(viewFactorMethod).toUtf8().constData());
     RLogger::indent();
 
+    // Scene is built once and shared by all eyes.
+    RHemiCubeScene scene(model,rPatchBook,rPatchInput);
+
     uint nPatchesProcessed = 0;
 
     RProgressInitialize("Calculating view-factors");
     #pragma omp parallel for default(shared)
     for (int64_t eyePatchID=0;eyePatchID<int64_t(rPatchBook.getNPatches());eyePatchID++)
     {
+        if (!rowFlags[eyePatchID])
+        {
+            continue;
+        }
+
         RViewFactorRow &rViewFactorRow = rViewFactorMatrix.getRow(eyePatchID);
         rViewFactorRow.getViewFactors().clear();
 
@@ -176,56 +368,33 @@ void RHemiCube::calculateViewFactors(const RModel &model, RViewFactorMatrix &rVi
         uint surfaceID = rPatch.getSurfaceID();
         if (rPatchInput[surfaceID].getEmitter())
         {
-            RR3Vector eyePosition;
-            RR3Vector eyeDirection;
-
-            model.findPatchCenter(rPatch,eyePosition[0],eyePosition[1],eyePosition[2]);
-            model.findPatchNormal(rPatch,eyeDirection[0],eyeDirection[1],eyeDirection[2]);
+            std::map<uint,double> viewFactorMap;
 
-            RHemiCube hemiCube(eyePosition,eyeDirection,rViewFactorMatrix.getHeader().getHemicubeResolution(),100);
-
-            RHemicubeTriangleComp hemiCubeTriangleComp(eyePosition);
+            if (viewFactorMethod == R_VIEW_FACTOR_METHOD_MONTE_CARLO)
+            {
+                // Seed depends only on patch geometry so that recalculated rows do not depend on other rows.
+                RViewFactorRayTracer rayTracer(model,rPatch,rPatchHashes[eyePatchID] ^ Q_UINT64_C(0x9E3779B97F4A7C15));
 
-            std::vector<RHemicubeTriangle> hemiCubeTriangles;
-            hemiCubeTriangles.reserve(rPatchBook.getNPatches()*2);
+                rayTracer.rayTraceScene(scene,uint(eyePatchID),rViewFactorMatrix.getHeader().getHemicubeResolution());
 
-            // Fill vector of triangles to be rendered / ray-traced.
-            for (uint patchID=0;patchID<rPatchBook.getNPatches();patchID++)
+                viewFactorMap = rayTracer.getViewFactors();
+            }
+            else
             {
-                if (eyePatchID == patchID)
-                {
-                    continue;
-                }
-                if (!rPatchInput[rPatchBook.getPatch(patchID).getSurfaceID()].getReceiver())
-                {
-                    continue;
-                }
+                RR3Vector eyePosition;
+                RR3Vector eyeDirection;
 
-                const RUVector &rElementIDs = rPatchBook.getPatch(patchID).getElementIDs();
-                for (uint j=0;j<rElementIDs.size();j++)
-                {
-                    const RElement &rElement = model.getElement(rElementIDs[j]);
-                    QList<RTriangle> triangles = rElement.triangulate(model.getNodes());
-                    for (uint k=0;k<triangles.size();k++)
-                    {
-                        hemiCubeTriangles.push_back(RHemicubeTriangle(triangles[k],patchID));
-                    }
-                }
-            }
+                model.findPatchCenter(rPatch,eyePosition[0],eyePosition[1],eyePosition[2]);
+                model.findPatchNormal(rPatch,eyeDirection[0],eyeDirection[1],eyeDirection[2]);
 
-            // Sort vector of triangles by distance.
-            // This way closest triangles will be rendered first and those which are at the back
-            // will not waste computatuional time.
-            std::sort(hemiCubeTriangles.begin(),hemiCubeTriangles.end(),hemiCubeTriangleComp);
+                RHemiCube hemiCube(eyePosition,eyeDirection,rViewFactorMatrix.getHeader().getHemicubeResolution(),100);
 
-            // Raytrace triangles.
-            for (uint i=0;i<hemiCubeTriangles.size();i++)
-            {
-                hemiCube.rayTraceTriangle(hemiCubeTriangles[i].getTriangle(),hemiCubeTriangles[i].getColor());
+                hemiCube.rayTraceScene(scene,uint(eyePatchID));
+
+                viewFactorMap = hemiCube.getViewFactors();
             }
 
-            // Transfer view-factors from hemi-cube to view-factor row storage.
-            std::map<uint,double> viewFactorMap = hemiCube.getViewFactors();
+            // Transfer view-factors to view-factor row storage.
             std::map<uint,double>::const_iterator iter;
             for (iter = viewFactorMap.begin(); iter != viewFactorMap.end(); ++iter)
             {
@@ -245,12 +414,198 @@ void RHemiCube::calculateViewFactors(const RModel &model, RViewFactorMatrix &rVi
 
 #pragma omp critical
         {
-            RProgressPrint(++nPatchesProcessed,rPatchBook.getNPatches());
-            RLogger::info("[%9u of %-9u] Patch %9u: row sum = %g\n",nPatchesProcessed,rPatchBook.getNPatches(),eyePatchID+1,vfRowSum);
+            RProgressPrint(++nPatchesProcessed,nRows);
+            RLogger::info("[%9u of %-9u] Patch %9u: row sum = %g\n",nPatchesProcessed,nRows,eyePatchID+1,vfRowSum);
         }
     }
     RProgressFinalize("Done");
     RLogger::unindent();
+
+    RHemiCube::postProcessViewFactors(model,rViewFactorMatrix);
+}
+
+void RHemiCube::postProcessViewFactors(const RModel &model, RViewFactorMatrix &rViewFactorMatrix)
+{
+    const RRadiationSetup &rRadiationSetup = model.getProblemSetup().getRadiationSetup();
+    double threshold = rRadiationSetup.getViewFactorThreshold();
+    bool correction = rRadiationSetup.getViewFactorCorrection();
+
+    if (threshold <= 0.0 && !correction)
+    {
+        return;
+    }
+
+    const RPatchBook &rPatchBook = rViewFactorMatrix.getPatchBook();
+    const std::vector<RPatchInput> &rPatchInput = rViewFactorMatrix.getHeader().getPatchInput();
+    uint nPatches = uint(rViewFactorMatrix.size());
+
+    RLogger::info("Post-processing view-factors.\n");
+    RLogger::indent();
+
+    // Original row sums are closure targets.
+    std::vector<double> rowTargets(nPatches,0.0);
+    for (uint i=0;i<nPatches;i++)
+    {
+        const RSparseVector<double> &rViewFactors = rViewFactorMatrix.getRow(i).getViewFactors();
+        for (uint j=0;j<rViewFactors.size();j++)
+        {
+            rowTargets[i] += rViewFactors.getValue(j);
+        }
+        rowTargets[i] = std::min(rowTargets[i],1.0);
+    }
+
+    uint nDropped = 0;
+    for (uint i=0;i<nPatches;i++)
+    {
+        RSparseVector<double> &rViewFactors = rViewFactorMatrix.getRow(i).getViewFactors();
+        RSparseVector<double> viewFactors;
+        viewFactors.reserve(rViewFactors.size());
+        for (uint j=0;j<rViewFactors.size();j++)
+        {
+            if (rViewFactors.getValue(j) < threshold)
+            {
+                nDropped++;
+            }
+            else
+            {
+                viewFactors.addValue(rViewFactors.getIndex(j),rViewFactors.getValue(j));
+            }
+        }
+        rViewFactors = viewFactors;
+    }
+
+    RLogger::info("Dropped %u view-factors below threshold %g.\n",nDropped,threshold);
+
+    if (!correction)
+    {
+        RLogger::unindent();
+        return;
+    }
+
+    std::vector<double> areas(nPatches,0.0);
+    std::vector<bool> emitters(nPatches,false);
+    for (uint i=0;i<nPatches;i++)
+    {
+        const RPatch &rPatch = rPatchBook.getPatch(i);
+        model.findPatchArea(rPatch,areas[i]);
+        emitters[i] = (rPatchInput[rPatch.getSurfaceID()].getEmitter() && areas[i] > 0.0);
+    }
+
+    // Exchange areas G_ij = A_i*F_ij, pairs of emitting patches are averaged.
+    // Entries pointing to patches without own row can not be made reciprocal.
+    std::vector< RSparseVector<double> > exchangeAreas(nPatches);
+    double maxReciprocityError = 0.0;
+    for (uint i=0;i<nPatches;i++)
+    {
+        if (!emitters[i])
+        {
+            continue;
+        }
+        const RSparseVector<double> &rViewFactors = rViewFactorMatrix.getRow(i).getViewFactors();
+        for (uint j=0;j<rViewFactors.size();j++)
+        {
+            uint patchID = rViewFactors.getIndex(j);
+            double gij = areas[i] * rViewFactors.getValue(j);
+            if (patchID == i || patchID >= nPatches || !emitters[patchID])
+            {
+                exchangeAreas[i].addValue(patchID,gij);
+                continue;
+            }
+
+            uint position;
+            const RSparseVector<double> &rOtherViewFactors = rViewFactorMatrix.getRow(patchID).getViewFactors();
+            bool found = rOtherViewFactors.findPosition(i,position);
+            if (found && patchID < i)
+            {
+                // Pair has been processed already.
+                continue;
+            }
+            double gji = found ? areas[patchID] * rOtherViewFactors.getValue(position) : 0.0;
+
+            if (gij + gji > 0.0)
+            {
+                maxReciprocityError = std::max(maxReciprocityError,std::abs(gij - gji) / std::max(gij,gji));
+            }
+
+            double g = 0.5 * (gij + gji);
+            exchangeAreas[i].addValue(patchID,g);
+            exchangeAreas[patchID].addValue(i,g);
+        }
+    }
+
+    RLogger::info("Maximum relative reciprocity error before correction: %g\n",maxReciprocityError);
+
+    // Closure is enforced by iterative scaling of rows, reciprocal pairs are scaled symmetrically.
+    std::vector<double> rowScales(nPatches,1.0);
+    double maxClosureError = 0.0;
+    uint nIterations = 0;
+    for (nIterations=0;nIterations<R_HEMICUBE_CLOSURE_MAX_ITERATIONS;nIterations++)
+    {
+        maxClosureError = 0.0;
+        for (uint i=0;i<nPatches;i++)
+        {
+            rowScales[i] = 1.0;
+            if (!emitters[i] || rowTargets[i] <= 0.0)
+            {
+                continue;
+            }
+            double rowSum = 0.0;
+            for (uint j=0;j<exchangeAreas[i].size();j++)
+            {
+                rowSum += exchangeAreas[i].getValue(j);
+            }
+            rowSum /= areas[i];
+            if (rowSum <= 0.0)
+            {
+                continue;
+            }
+            rowScales[i] = rowTargets[i] / rowSum;
+            maxClosureError = std::max(maxClosureError,std::abs(rowSum - rowTargets[i]));
+        }
+
+        if (maxClosureError < R_HEMICUBE_CLOSURE_TOLERANCE)
+        {
+            break;
+        }
+
+        #pragma omp parallel for default(shared)
+        for (int64_t i=0;i<int64_t(nPatches);i++)
+        {
+            RSparseVector<double> &rExchangeAreas = exchangeAreas[i];
+            RSparseVector<double> scaledExchangeAreas;
+            scaledExchangeAreas.reserve(rExchangeAreas.size());
+            for (uint j=0;j<rExchangeAreas.size();j++)
+            {
+                uint patchID = rExchangeAreas.getIndex(j);
+                double scale = rowScales[i];
+                if (patchID != uint(i) && patchID < nPatches && emitters[patchID])
+                {
+                    scale = std::sqrt(rowScales[i]*rowScales[patchID]);
+                }
+                scaledExchangeAreas.addValue(patchID,scale*rExchangeAreas.getValue(j));
+            }
+            rExchangeAreas = scaledExchangeAreas;
+        }
+    }
+
+    RLogger::info("Maximum closure error after %u iterations: %g\n",nIterations,maxClosureError);
+
+    for (uint i=0;i<nPatches;i++)
+    {
+        if (!emitters[i])
+        {
+            continue;
+        }
+        RSparseVector<double> &rViewFactors = rViewFactorMatrix.getRow(i).getViewFactors();
+        rViewFactors.clear();
+        rViewFactors.reserve(exchangeAreas[i].size());
+        for (uint j=0;j<exchangeAreas[i].size();j++)
+        {
+            rViewFactors.addValue(exchangeAreas[i].getIndex(j),exchangeAreas[i].getValue(j)/areas[i]);
+        }
+    }
+
+    RLogger::unindent();
 }
 
 void RHemiCube::generate(const RR3Vector &eyePosition, const RR3Vector &eyeDirection, uint resolution, double size)
@@ -0,0 +1,625 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rhemicubescene.cpp                                       *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: View-factor hemi-cube scene class definition        *
+ *********************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include "rhemicubescene.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define R_HEMICUBE_SCENE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+//! Maximum number of triangles in leaf node.
+#define R_HEMICUBE_SCENE_LEAF_SIZE 4
+//! Number of triangles in one block.
+#define R_HEMICUBE_SCENE_BLOCK_SIZE 4
+//! Number of values in one block (3 coordinates of vertex and two edges).
+#define R_HEMICUBE_SCENE_BLOCK_LENGTH (9*R_HEMICUBE_SCENE_BLOCK_SIZE)
+//! Minimum ray intersection distance relative to scene size.
+#define R_HEMICUBE_SCENE_MIN_DISTANCE_RATIO 1.0e-9
+
+typedef void (*RHemiCubeSceneBlockKernel)(const double *block, const double *origin, const double *direction, double minDistance, double *distances);
+
+// Moller-Trumbore ray-triangle test of one block.
+// Distance is set to maximum double value for triangles which are not hit.
+static void intersectBlockGeneric(const double *block, const double *origin, const double *direction, double minDistance, double *distances)
+{
+    const double *v0x = block;
+    const double *v0y = block + 4;
+    const double *v0z = block + 8;
+    const double *e1x = block + 12;
+    const double *e1y = block + 16;
+    const double *e1z = block + 20;
+    const double *e2x = block + 24;
+    const double *e2y = block + 28;
+    const double *e2z = block + 32;
+
+    for (uint i=0;i<R_HEMICUBE_SCENE_BLOCK_SIZE;i++)
+    {
+        distances[i] = std::numeric_limits<double>::max();
+
+        double px = direction[1]*e2z[i] - direction[2]*e2y[i];
+        double py = direction[2]*e2x[i] - direction[0]*e2z[i];
+        double pz = direction[0]*e2y[i] - direction[1]*e2x[i];
+        double det = e1x[i]*px + e1y[i]*py + e1z[i]*pz;
+        if (det == 0.0)
+        {
+            continue;
+        }
+        double invDet = 1.0 / det;
+
+        double tx = origin[0] - v0x[i];
+        double ty = origin[1] - v0y[i];
+        double tz = origin[2] - v0z[i];
+        double u = (tx*px + ty*py + tz*pz) * invDet;
+
+        double qx = ty*e1z[i] - tz*e1y[i];
+        double qy = tz*e1x[i] - tx*e1z[i];
+        double qz = tx*e1y[i] - ty*e1x[i];
+        double v = (direction[0]*qx + direction[1]*qy + direction[2]*qz) * invDet;
+        double t = (e2x[i]*qx + e2y[i]*qy + e2z[i]*qz) * invDet;
+
+        if (u >= 0.0 && v >= 0.0 && u + v <= 1.0 && t > minDistance)
+        {
+            distances[i] = t;
+        }
+    }
+}
+
+#ifdef R_HEMICUBE_SCENE_SIMD_X86
+
+// Same operations as generic kernel (no fused multiply-add) so that both give identical results.
+__attribute__((target("avx2")))
+static void intersectBlockAvx2(const double *block, const double *origin, const double *direction, double minDistance, double *distances)
+{
+    __m256d v0x = _mm256_loadu_pd(block);
+    __m256d v0y = _mm256_loadu_pd(block+4);
+    __m256d v0z = _mm256_loadu_pd(block+8);
+    __m256d e1x = _mm256_loadu_pd(block+12);
+    __m256d e1y = _mm256_loadu_pd(block+16);
+    __m256d e1z = _mm256_loadu_pd(block+20);
+    __m256d e2x = _mm256_loadu_pd(block+24);
+    __m256d e2y = _mm256_loadu_pd(block+28);
+    __m256d e2z = _mm256_loadu_pd(block+32);
+
+    __m256d dx = _mm256_set1_pd(direction[0]);
+    __m256d dy = _mm256_set1_pd(direction[1]);
+    __m256d dz = _mm256_set1_pd(direction[2]);
+
+    __m256d px = _mm256_sub_pd(_mm256_mul_pd(dy,e2z),_mm256_mul_pd(dz,e2y));
+    __m256d py = _mm256_sub_pd(_mm256_mul_pd(dz,e2x),_mm256_mul_pd(dx,e2z));
+    __m256d pz = _mm256_sub_pd(_mm256_mul_pd(dx,e2y),_mm256_mul_pd(dy,e2x));
+    __m256d det = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(e1x,px),_mm256_mul_pd(e1y,py)),_mm256_mul_pd(e1z,pz));
+    __m256d invDet = _mm256_div_pd(_mm256_set1_pd(1.0),det);
+
+    __m256d tx = _mm256_sub_pd(_mm256_set1_pd(origin[0]),v0x);
+    __m256d ty = _mm256_sub_pd(_mm256_set1_pd(origin[1]),v0y);
+    __m256d tz = _mm256_sub_pd(_mm256_set1_pd(origin[2]),v0z);
+    __m256d u = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(tx,px),_mm256_mul_pd(ty,py)),_mm256_mul_pd(tz,pz)),invDet);
+
+    __m256d qx = _mm256_sub_pd(_mm256_mul_pd(ty,e1z),_mm256_mul_pd(tz,e1y));
+    __m256d qy = _mm256_sub_pd(_mm256_mul_pd(tz,e1x),_mm256_mul_pd(tx,e1z));
+    __m256d qz = _mm256_sub_pd(_mm256_mul_pd(tx,e1y),_mm256_mul_pd(ty,e1x));
+    __m256d v = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx,qx),_mm256_mul_pd(dy,qy)),_mm256_mul_pd(dz,qz)),invDet);
+    __m256d t = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(e2x,qx),_mm256_mul_pd(e2y,qy)),_mm256_mul_pd(e2z,qz)),invDet);
+
+    __m256d zero = _mm256_setzero_pd();
+    __m256d mask = _mm256_cmp_pd(det,zero,_CMP_NEQ_OQ);
+    mask = _mm256_and_pd(mask,_mm256_cmp_pd(u,zero,_CMP_GE_OQ));
+    mask = _mm256_and_pd(mask,_mm256_cmp_pd(v,zero,_CMP_GE_OQ));
+    mask = _mm256_and_pd(mask,_mm256_cmp_pd(_mm256_add_pd(u,v),_mm256_set1_pd(1.0),_CMP_LE_OQ));
+    mask = _mm256_and_pd(mask,_mm256_cmp_pd(t,_mm256_set1_pd(minDistance),_CMP_GT_OQ));
+
+    _mm256_storeu_pd(distances,_mm256_blendv_pd(_mm256_set1_pd(std::numeric_limits<double>::max()),t,mask));
+}
+
+#endif // R_HEMICUBE_SCENE_SIMD_X86
+
+static RHemiCubeSceneBlockKernel findBlockKernel(void)
+{
+#ifdef R_HEMICUBE_SCENE_SIMD_X86
+    if (RSimd::getInstructionSet() >= RSimd::AVX2)
+    {
+        return intersectBlockAvx2;
+    }
+#endif
+    return intersectBlockGeneric;
+}
+
+// Find distance at which ray enters the box.
+// Return false if ray misses the box or enters it beyond maximum distance.
+static bool findRayBoxEntry(const RLimitBox &box, const double *origin, const double *direction, const double *invDirection, double maxDistance, double &entry)
+{
+    double ll[3], ul[3];
+    box.getLimits(ll[0],ul[0],ll[1],ul[1],ll[2],ul[2]);
+
+    double tMin = 0.0;
+    double tMax = maxDistance;
+    for (uint i=0;i<3;i++)
+    {
+        if (direction[i] == 0.0)
+        {
+            if (origin[i] < ll[i] || origin[i] > ul[i])
+            {
+                return false;
+            }
+            continue;
+        }
+        double t1 = (ll[i] - origin[i]) * invDirection[i];
+        double t2 = (ul[i] - origin[i]) * invDirection[i];
+        tMin = std::max(tMin,std::min(t1,t2));
+        tMax = std::min(tMax,std::max(t1,t2));
+        if (tMin > tMax)
+        {
+            return false;
+        }
+    }
+    entry = tMin;
+    return true;
+}
+
+class RHemiCubeSceneTriangleComp
+{
+    protected:
+
+        const std::vector<RR3Vector> &centers;
+        uint axis;
+
+    public:
+
+        RHemiCubeSceneTriangleComp(const std::vector<RR3Vector> &centers, uint axis) : centers(centers), axis(axis) {}
+
+        bool operator() (uint t1, uint t2) const
+        {
+            return (this->centers[t1][this->axis] < this->centers[t2][this->axis]);
+        }
+};
+
+void RHemiCubeScene::_init(const RHemiCubeScene *pHemiCubeScene)
+{
+    if (pHemiCubeScene)
+    {
+        this->triangles = pHemiCubeScene->triangles;
+        this->colors = pHemiCubeScene->colors;
+        this->nodes = pHemiCubeScene->nodes;
+        this->nodeBlocks = pHemiCubeScene->nodeBlocks;
+        this->blocks = pHemiCubeScene->blocks;
+        this->minDistance = pHemiCubeScene->minDistance;
+    }
+}
+
+RHemiCubeScene::RHemiCubeScene(const RModel &model, const RPatchBook &patchBook, const std::vector<RPatchInput> &patchInput)
+    : minDistance(0.0)
+{
+    this->_init();
+
+    for (uint patchID=0;patchID<patchBook.getNPatches();patchID++)
+    {
+        const RPatch &rPatch = patchBook.getPatch(patchID);
+        if (!patchInput[rPatch.getSurfaceID()].getReceiver())
+        {
+            continue;
+        }
+
+        const RUVector &rElementIDs = rPatch.getElementIDs();
+        for (uint j=0;j<rElementIDs.size();j++)
+        {
+            QList<RTriangle> elementTriangles = model.getElement(rElementIDs[j]).triangulate(model.getNodes());
+            for (int k=0;k<elementTriangles.size();k++)
+            {
+                this->triangles.push_back(elementTriangles[k]);
+                this->colors.push_back(patchID);
+            }
+        }
+    }
+
+    this->build();
+}
+
+RHemiCubeScene::RHemiCubeScene(const RHemiCubeScene &hemiCubeScene)
+{
+    this->_init(&hemiCubeScene);
+}
+
+RHemiCubeScene::~RHemiCubeScene()
+{
+
+}
+
+RHemiCubeScene &RHemiCubeScene::operator =(const RHemiCubeScene &hemiCubeScene)
+{
+    this->_init(&hemiCubeScene);
+    return (*this);
+}
+
+uint RHemiCubeScene::getNTriangles(void) const
+{
+    return uint(this->triangles.size());
+}
+
+uint RHemiCubeScene::getNNodes(void) const
+{
+    return uint(this->nodes.size());
+}
+
+void RHemiCubeScene::rayTrace(RHemiCubeSector &sector, const RR3Vector &eyePosition, uint skipColor) const
+{
+    if (this->nodes.empty())
+    {
+        return;
+    }
+
+    std::vector<uint> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        const RHemiCubeSceneNode &rNode = this->nodes[stack.back()];
+        stack.pop_back();
+
+        if (!sector.testVisibility(rNode.box))
+        {
+            continue;
+        }
+        if (RHemiCubeScene::findDistance(rNode.box,eyePosition) > sector.getCoverDistance())
+        {
+            // Everything in this node is hidden behind already colored pixels.
+            continue;
+        }
+
+        if (rNode.nTriangles > 0)
+        {
+            for (uint i=rNode.first;i<rNode.first+rNode.nTriangles;i++)
+            {
+                if (this->colors[i] != skipColor)
+                {
+                    sector.rayTraceTriangle(this->triangles[i],this->colors[i]);
+                }
+            }
+            continue;
+        }
+
+        // Push farther child first so that the nearer one is processed first.
+        double d1 = RHemiCubeScene::findDistance(this->nodes[rNode.first].box,eyePosition);
+        double d2 = RHemiCubeScene::findDistance(this->nodes[rNode.first+1].box,eyePosition);
+        if (d1 < d2)
+        {
+            stack.push_back(rNode.first+1);
+            stack.push_back(rNode.first);
+        }
+        else
+        {
+            stack.push_back(rNode.first);
+            stack.push_back(rNode.first+1);
+        }
+    }
+}
+
+void RHemiCubeScene::build(void)
+{
+    this->nodes.clear();
+
+    uint nTriangles = uint(this->triangles.size());
+    if (nTriangles == 0)
+    {
+        return;
+    }
+
+    std::vector<uint> order(nTriangles);
+    std::vector<RR3Vector> centers(nTriangles);
+    for (uint i=0;i<nTriangles;i++)
+    {
+        order[i] = i;
+        this->triangles[i].findCenter(centers[i]);
+    }
+
+    RHemiCubeSceneNode rootNode;
+    rootNode.first = 0;
+    rootNode.nTriangles = nTriangles;
+    this->nodes.reserve(2*(nTriangles/R_HEMICUBE_SCENE_LEAF_SIZE+1));
+    this->nodes.push_back(rootNode);
+
+    // Split nodes at median of the longest extent of triangle centers.
+    std::vector<uint> stack;
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        uint nodeID = stack.back();
+        stack.pop_back();
+
+        uint first = this->nodes[nodeID].first;
+        uint n = this->nodes[nodeID].nTriangles;
+        if (n <= R_HEMICUBE_SCENE_LEAF_SIZE)
+        {
+            continue;
+        }
+
+        double ll[3] = { centers[order[first]][0], centers[order[first]][1], centers[order[first]][2] };
+        double ul[3] = { ll[0], ll[1], ll[2] };
+        for (uint i=first+1;i<first+n;i++)
+        {
+            for (uint j=0;j<3;j++)
+            {
+                ll[j] = std::min(ll[j],centers[order[i]][j]);
+                ul[j] = std::max(ul[j],centers[order[i]][j]);
+            }
+        }
+
+        uint axis = 0;
+        for (uint j=1;j<3;j++)
+        {
+            if (ul[j] - ll[j] > ul[axis] - ll[axis])
+            {
+                axis = j;
+            }
+        }
+        if (ul[axis] - ll[axis] <= 0.0)
+        {
+            // All centers coincide, keep as leaf.
+            continue;
+        }
+
+        uint nLeft = n / 2;
+        std::nth_element(order.begin()+first,
+                         order.begin()+first+nLeft,
+                         order.begin()+first+n,
+                         RHemiCubeSceneTriangleComp(centers,axis));
+
+        RHemiCubeSceneNode leftNode;
+        leftNode.first = first;
+        leftNode.nTriangles = nLeft;
+
+        RHemiCubeSceneNode rightNode;
+        rightNode.first = first + nLeft;
+        rightNode.nTriangles = n - nLeft;
+
+        uint leftID = uint(this->nodes.size());
+        this->nodes.push_back(leftNode);
+        this->nodes.push_back(rightNode);
+
+        this->nodes[nodeID].first = leftID;
+        this->nodes[nodeID].nTriangles = 0;
+
+        stack.push_back(leftID);
+        stack.push_back(leftID+1);
+    }
+
+    // Store triangles in hierarchy order.
+    std::vector<RTriangle> sortedTriangles;
+    std::vector<uint> sortedColors(nTriangles);
+    sortedTriangles.reserve(nTriangles);
+    for (uint i=0;i<nTriangles;i++)
+    {
+        sortedTriangles.push_back(this->triangles[order[i]]);
+        sortedColors[i] = this->colors[order[i]];
+    }
+    this->triangles.swap(sortedTriangles);
+    this->colors.swap(sortedColors);
+
+    // Children are always stored after their parent.
+    for (uint i=uint(this->nodes.size());i>0;i--)
+    {
+        RHemiCubeSceneNode &rNode = this->nodes[i-1];
+        if (rNode.nTriangles > 0)
+        {
+            rNode.box = this->findLimitBox(rNode.first,rNode.nTriangles);
+        }
+        else
+        {
+            rNode.box = this->nodes[rNode.first].box;
+            rNode.box.merge(this->nodes[rNode.first+1].box);
+        }
+    }
+
+    this->buildBlocks();
+}
+
+bool RHemiCubeScene::findIntersection(const RR3Vector &origin, const RR3Vector &direction, uint skipColor, double &distance, uint &color) const
+{
+    if (this->nodes.empty())
+    {
+        return false;
+    }
+
+    RHemiCubeSceneBlockKernel intersectBlock = findBlockKernel();
+
+    double o[3] = { origin[0], origin[1], origin[2] };
+    double d[3] = { direction[0], direction[1], direction[2] };
+    double invD[3];
+    for (uint i=0;i<3;i++)
+    {
+        invD[i] = (d[i] == 0.0) ? 0.0 : 1.0 / d[i];
+    }
+
+    double bestDistance = std::numeric_limits<double>::max();
+    uint bestColor = RConstants::eod;
+
+    double distances[R_HEMICUBE_SCENE_BLOCK_SIZE];
+    double entry1, entry2;
+
+    std::vector<uint> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        uint nodeID = stack.back();
+        stack.pop_back();
+        const RHemiCubeSceneNode &rNode = this->nodes[nodeID];
+
+        if (!findRayBoxEntry(rNode.box,o,d,invD,bestDistance,entry1))
+        {
+            continue;
+        }
+
+        if (rNode.nTriangles > 0)
+        {
+            uint nBlocks = (rNode.nTriangles + R_HEMICUBE_SCENE_BLOCK_SIZE - 1) / R_HEMICUBE_SCENE_BLOCK_SIZE;
+            for (uint i=0;i<nBlocks;i++)
+            {
+                intersectBlock(&this->blocks[(this->nodeBlocks[nodeID]+i)*R_HEMICUBE_SCENE_BLOCK_LENGTH],o,d,this->minDistance,distances);
+                for (uint j=0;j<R_HEMICUBE_SCENE_BLOCK_SIZE;j++)
+                {
+                    uint triangleID = rNode.first + i*R_HEMICUBE_SCENE_BLOCK_SIZE + j;
+                    if (triangleID >= rNode.first + rNode.nTriangles
+                        || distances[j] == std::numeric_limits<double>::max()
+                        || this->colors[triangleID] == skipColor)
+                    {
+                        continue;
+                    }
+                    // Equal distances are resolved by color so that result does not depend on traversal order.
+                    if (distances[j] < bestDistance || (distances[j] == bestDistance && this->colors[triangleID] < bestColor))
+                    {
+                        bestDistance = distances[j];
+                        bestColor = this->colors[triangleID];
+                    }
+                }
+            }
+            continue;
+        }
+
+        // Push farther child first so that the nearer one is processed first.
+        bool hit1 = findRayBoxEntry(this->nodes[rNode.first].box,o,d,invD,bestDistance,entry1);
+        bool hit2 = findRayBoxEntry(this->nodes[rNode.first+1].box,o,d,invD,bestDistance,entry2);
+        if (hit1 && hit2)
+        {
+            if (entry1 < entry2)
+            {
+                stack.push_back(rNode.first+1);
+                stack.push_back(rNode.first);
+            }
+            else
+            {
+                stack.push_back(rNode.first);
+                stack.push_back(rNode.first+1);
+            }
+        }
+        else if (hit1)
+        {
+            stack.push_back(rNode.first);
+        }
+        else if (hit2)
+        {
+            stack.push_back(rNode.first+1);
+        }
+    }
+
+    if (bestColor == RConstants::eod)
+    {
+        return false;
+    }
+
+    distance = bestDistance;
+    color = bestColor;
+    return true;
+}
+
+void RHemiCubeScene::buildBlocks(void)
+{
+    this->nodeBlocks.assign(this->nodes.size(),0);
+    this->blocks.clear();
+
+    uint nBlocks = 0;
+    for (uint i=0;i<this->nodes.size();i++)
+    {
+        if (this->nodes[i].nTriangles > 0)
+        {
+            this->nodeBlocks[i] = nBlocks;
+            nBlocks += (this->nodes[i].nTriangles + R_HEMICUBE_SCENE_BLOCK_SIZE - 1) / R_HEMICUBE_SCENE_BLOCK_SIZE;
+        }
+    }
+
+    // Unused positions have zero edges and can never be hit.
+    this->blocks.assign(std::size_t(nBlocks)*R_HEMICUBE_SCENE_BLOCK_LENGTH,0.0);
+
+    for (uint i=0;i<this->nodes.size();i++)
+    {
+        const RHemiCubeSceneNode &rNode = this->nodes[i];
+        for (uint j=0;j<rNode.nTriangles;j++)
+        {
+            const RTriangle &rTriangle = this->triangles[rNode.first+j];
+            const RNode &rNode1 = rTriangle.getNode1();
+            const RNode &rNode2 = rTriangle.getNode2();
+            const RNode &rNode3 = rTriangle.getNode3();
+
+            double *block = &this->blocks[(this->nodeBlocks[i] + j/R_HEMICUBE_SCENE_BLOCK_SIZE)*R_HEMICUBE_SCENE_BLOCK_LENGTH];
+            uint k = j % R_HEMICUBE_SCENE_BLOCK_SIZE;
+
+            block[k]    = rNode1.getX();
+            block[4+k]  = rNode1.getY();
+            block[8+k]  = rNode1.getZ();
+            block[12+k] = rNode2.getX() - rNode1.getX();
+            block[16+k] = rNode2.getY() - rNode1.getY();
+            block[20+k] = rNode2.getZ() - rNode1.getZ();
+            block[24+k] = rNode3.getX() - rNode1.getX();
+            block[28+k] = rNode3.getY() - rNode1.getY();
+            block[32+k] = rNode3.getZ() - rNode1.getZ();
+        }
+    }
+
+    double xl, xu, yl, yu, zl, zu;
+    this->nodes[0].box.getLimits(xl,xu,yl,yu,zl,zu);
+    this->minDistance = R_HEMICUBE_SCENE_MIN_DISTANCE_RATIO * std::sqrt((xu-xl)*(xu-xl) + (yu-yl)*(yu-yl) + (zu-zl)*(zu-zl));
+}
+
+RLimitBox RHemiCubeScene::findLimitBox(uint first, uint nTriangles) const
+{
+    double ll[3] = { 0.0, 0.0, 0.0 };
+    double ul[3] = { 0.0, 0.0, 0.0 };
+
+    for (uint i=first;i<first+nTriangles;i++)
+    {
+        const RNode *nodes[3] = { &this->triangles[i].getNode1(), &this->triangles[i].getNode2(), &this->triangles[i].getNode3() };
+        for (uint j=0;j<3;j++)
+        {
+            double x[3] = { nodes[j]->getX(), nodes[j]->getY(), nodes[j]->getZ() };
+            for (uint k=0;k<3;k++)
+            {
+                if (i == first && j == 0)
+                {
+                    ll[k] = ul[k] = x[k];
+                }
+                else
+                {
+                    ll[k] = std::min(ll[k],x[k]);
+                    ul[k] = std::max(ul[k],x[k]);
+                }
+            }
+        }
+    }
+
+    return RLimitBox(ll[0],ul[0],ll[1],ul[1],ll[2],ul[2]);
+}
+
+double RHemiCubeScene::findDistance(const RLimitBox &box, const RR3Vector &position)
+{
+    double ll[3], ul[3];
+    box.getLimits(ll[0],ul[0],ll[1],ul[1],ll[2],ul[2]);
+
+    double distance = 0.0;
+    for (uint i=0;i<3;i++)
+    {
+        double d = 0.0;
+        if (position[i] < ll[i])
+        {
+            d = ll[i] - position[i];
+        }
+        else if (position[i] > ul[i])
+        {
+            d = position[i] - ul[i];
+        }
+        distance += d * d;
+    }
+
+    return std::sqrt(distance);
+}
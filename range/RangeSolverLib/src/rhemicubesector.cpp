@@ -8,6 +8,8 @@
  *  DESCRIPTION: View-factor hemi-cube sector class definition       *
  *********************************************************************/
 
+#include <cfloat>
+
 #include "rhemicubesector.h"
 
 void RHemiCubeSector::_init(const RHemiCubeSector *pHemiCubeSector)
@@ -15,10 +17,13 @@ void RHemiCubeSector::_init(const RHemiCubeSector *pHemiCubeSector)
     if (pHemiCubeSector)
     {
         this->limitPolygon = pHemiCubeSector->limitPolygon;
+        this->frustumNormals = pHemiCubeSector->frustumNormals;
         this->resolution = pHemiCubeSector->resolution;
         this->eyePosition = pHemiCubeSector->eyePosition;
         this->eyeDirection = pHemiCubeSector->eyeDirection;
         this->pixels = pHemiCubeSector->pixels;
+        this->nColoredPixels = pHemiCubeSector->nColoredPixels;
+        this->coverDistance = pHemiCubeSector->coverDistance;
     }
 }
 
@@ -30,12 +35,15 @@ RHemiCubeSector::RHemiCubeSector(const RR3Vector &eyePosition,
     : resolution(resolution)
     , eyePosition(eyePosition)
     , eyeDirection(eyeDirection)
+    , nColoredPixels(0)
+    , coverDistance(0.0)
 {
     this->_init();
     uint sectorSize = resolution * resolution;
     this->pixels.resize(sectorSize);
     this->generate(resolution,iSubIndex,jSubIndex,nSubIndexes,size,type);
     this->limitPolygon = this->findLimitPolygon();
+    this->frustumNormals = this->findFrustumNormals();
 }
 
 RHemiCubeSector::RHemiCubeSector(const RHemiCubeSector &hemiCubeSector)
@@ -75,44 +83,69 @@ void RHemiCubeSector::rayTraceTriangle(const RTriangle &triangle, uint color)
         return;
     }
 
-    double shortestDistance = RSegment::findLength(RNode(this->eyePosition),triangle.getNode1());
-    shortestDistance = std::min(shortestDistance,RSegment::findLength(RNode(this->eyePosition),triangle.getNode2()));
-    shortestDistance = std::min(shortestDistance,RSegment::findLength(RNode(this->eyePosition),triangle.getNode3()));
+    uint iFirst, iLast, jFirst, jLast;
+    if (!this->findPixelRange(triangle,iFirst,iLast,jFirst,jLast))
+    {
+        return;
+    }
 
-    RR3Vector rayDirection;
-    RR3Vector x;
-    double u;
+    // Triangle edges and eye position relative to first node are same for all pixels.
+    const RNode &n1 = triangle.getNode1();
+    const RNode &n2 = triangle.getNode2();
+    const RNode &n3 = triangle.getNode3();
+    double e1[3] = { n2.getX() - n1.getX(), n2.getY() - n1.getY(), n2.getZ() - n1.getZ() };
+    double e2[3] = { n3.getX() - n1.getX(), n3.getY() - n1.getY(), n3.getZ() - n1.getZ() };
+    double s[3] = { this->eyePosition[0] - n1.getX(), this->eyePosition[1] - n1.getY(), this->eyePosition[2] - n1.getZ() };
+    double q[3] = { s[1]*e1[2] - s[2]*e1[1], s[2]*e1[0] - s[0]*e1[2], s[0]*e1[1] - s[1]*e1[0] };
+    double e2q = e2[0]*q[0] + e2[1]*q[1] + e2[2]*q[2];
 
     bool iPrevFound = false;
-    for (uint i=0;i<this->resolution;i++)
+    for (uint i=iFirst;i<=iLast;i++)
     {
         bool jPrevFound = false;
         bool iCurrFound = false;
 
-        for (uint j=0;j<this->resolution;j++)
+        for (uint j=jFirst;j<=jLast;j++)
         {
             uint pixelId = i * this->resolution + j;
-            if (this->pixels[pixelId].getColor() != RConstants::eod && this->pixels[i].getDepth() < shortestDistance)
-            {
-                continue;
-            }
-            rayDirection[0] = this->pixels[pixelId].getPosition()[0] - this->eyePosition[0];
-            rayDirection[1] = this->pixels[pixelId].getPosition()[1] - this->eyePosition[1];
-            rayDirection[2] = this->pixels[pixelId].getPosition()[2] - this->eyePosition[2];
+            const RR3Vector &pixelPosition = this->pixels[pixelId].getPosition();
+            double d[3] = { pixelPosition[0] - this->eyePosition[0],
+                            pixelPosition[1] - this->eyePosition[1],
+                            pixelPosition[2] - this->eyePosition[2] };
 
             bool jCurrFound = false;
-            if (triangle.findLineIntersection(this->eyePosition,rayDirection,x,u))
+
+            // Barycentric ray-triangle intersection.
+            double p[3] = { d[1]*e2[2] - d[2]*e2[1], d[2]*e2[0] - d[0]*e2[2], d[0]*e2[1] - d[1]*e2[0] };
+            double det = e1[0]*p[0] + e1[1]*p[1] + e1[2]*p[2];
+            if (std::fabs(det) > RConstants::eps * RConstants::eps)
             {
-                if (u > 0.0)
+                double b1 = (s[0]*p[0] + s[1]*p[1] + s[2]*p[2]) / det;
+                double b2 = (d[0]*q[0] + d[1]*q[1] + d[2]*q[2]) / det;
+                double u = e2q / det;
+                if (b1 >= -RConstants::eps && b2 >= -RConstants::eps && b1 + b2 <= 1.0 + RConstants::eps && u > 0.0)
                 {
                     iPrevFound = true;
                     iCurrFound = true;
                     jPrevFound = true;
                     jCurrFound = true;
-                    if (u < this->pixels[pixelId].getDepth() || this->pixels[pixelId].getColor() == RConstants::eod)
+                    // Depth is stored as distance from eye position.
+                    double depth = u * std::sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+                    if (this->pixels[pixelId].getColor() == RConstants::eod)
+                    {
+                        this->nColoredPixels++;
+                    }
+                    // Pixels on shared edges are hit by several triangles at the same depth,
+                    // lower color wins so that result does not depend on rendering order.
+                    double pixelDepth = this->pixels[pixelId].getDepth();
+                    double tolerance = RConstants::eps * depth;
+                    if (depth < pixelDepth - tolerance
+                        || (depth <= pixelDepth + tolerance && color < this->pixels[pixelId].getColor()))
                     {
-                        this->pixels[pixelId].setDepth(u);
+                        this->pixels[pixelId].setDepth(depth);
                         this->pixels[pixelId].setColor(color);
+                        // Pixel depths only decrease, maximum written depth is an upper bound.
+                        this->coverDistance = std::max(this->coverDistance,depth);
                     }
                 }
             }
@@ -132,6 +165,50 @@ void RHemiCubeSector::rayTraceTriangle(const RTriangle &triangle, uint color)
     }
 }
 
+bool RHemiCubeSector::testVisibility(const RLimitBox &box) const
+{
+    double xl, xu, yl, yu, zl, zu;
+    box.getLimits(xl,xu,yl,yu,zl,zu);
+
+    double corners[8][3] = { { xl, yl, zl }, { xu, yl, zl }, { xl, yu, zl }, { xu, yu, zl },
+                             { xl, yl, zu }, { xu, yl, zu }, { xl, yu, zu }, { xu, yu, zu } };
+
+    // Box is invisible if all its corners are outside of any frustum plane.
+    // Triangles touching the frustum are kept because pixels on sector boundary
+    // are hit with a tolerance.
+    for (uint i=0;i<this->frustumNormals.size();i++)
+    {
+        const RR3Vector &n = this->frustumNormals[i];
+        bool outside = true;
+        for (uint j=0;j<8;j++)
+        {
+            double dx = corners[j][0] - this->eyePosition[0];
+            double dy = corners[j][1] - this->eyePosition[1];
+            double dz = corners[j][2] - this->eyePosition[2];
+            double tolerance = RConstants::eps * (std::fabs(dx) + std::fabs(dy) + std::fabs(dz));
+            if (n[0] * dx + n[1] * dy + n[2] * dz >= -tolerance)
+            {
+                outside = false;
+                break;
+            }
+        }
+        if (outside)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+double RHemiCubeSector::getCoverDistance(void) const
+{
+    if (this->nColoredPixels < this->pixels.size())
+    {
+        return DBL_MAX;
+    }
+    return this->coverDistance;
+}
+
 bool RHemiCubeSector::testVisibility(const RTriangle &triangle) const
 {
     // Check if triangle's normal is opposite to eye direction.
@@ -240,6 +317,16 @@ void RHemiCubeSector::generate(uint resolution, uint iSubIndex, uint jSubIndex,
     RRMatrix R;
     this->eyeDirection.findRotationMatrix(R);
 
+    // Copy rotation matrix to avoid temporary vectors in pixel loop.
+    double r[3][3];
+    for (uint i=0;i<3;i++)
+    {
+        for (uint j=0;j<3;j++)
+        {
+            r[i][j] = R[i][j];
+        }
+    }
+
     RR3Vector v;
 
     uint totalResolution = resolution * nSubIndexes;
@@ -325,11 +412,11 @@ void RHemiCubeSector::generate(uint resolution, uint iSubIndex, uint jSubIndex,
                 z = -sk;
             }
 
-            double weight = x / (RConstants::pi * std::pow(x*x+y*y+z*z,2));
-            RRMatrix::mlt(R,RR3Vector(x,y,z),v);
-            v[0] += this->eyePosition[0];
-            v[1] += this->eyePosition[1];
-            v[2] += this->eyePosition[2];
+            double r2 = x*x+y*y+z*z;
+            double weight = x / (RConstants::pi * r2 * r2);
+            v[0] = r[0][0]*x + r[0][1]*y + r[0][2]*z + this->eyePosition[0];
+            v[1] = r[1][0]*x + r[1][1]*y + r[1][2]*z + this->eyePosition[1];
+            v[2] = r[2][0]*x + r[2][1]*y + r[2][2]*z + this->eyePosition[2];
             this->pixels[i*resolution+j].setPosition(v);
             this->pixels[i*resolution+j].setWeight(weight);
         }
@@ -348,6 +435,119 @@ std::vector<RR3Vector> RHemiCubeSector::findLimitPolygon(void) const
     return polygon;
 }
 
+std::vector<RR3Vector> RHemiCubeSector::findFrustumNormals(void) const
+{
+    std::vector<RR3Vector> normals;
+
+    RR3Vector axis(0.0,0.0,0.0);
+    std::vector<RR3Vector> directions(this->limitPolygon.size());
+    for (uint i=0;i<this->limitPolygon.size();i++)
+    {
+        RR3Vector::subtract(this->limitPolygon[i],this->eyePosition,directions[i]);
+        axis[0] += directions[i][0];
+        axis[1] += directions[i][1];
+        axis[2] += directions[i][2];
+    }
+
+    // Side planes.
+    for (uint i=0;i<directions.size();i++)
+    {
+        RR3Vector normal;
+        RR3Vector::cross(directions[i],directions[(i+1)%directions.size()],normal);
+        if (normal.normalize() < RConstants::eps)
+        {
+            // Degenerated sector (single pixel row or column).
+            continue;
+        }
+        if (RR3Vector::dot(normal,axis) < 0.0)
+        {
+            normal *= -1.0;
+        }
+        normals.push_back(normal);
+    }
+
+    // Plane separating sector from its mirror image behind the eye.
+    axis.normalize();
+    normals.push_back(axis);
+
+    return normals;
+}
+
+bool RHemiCubeSector::findPixelRange(const RTriangle &triangle, uint &iFirst, uint &iLast, uint &jFirst, uint &jLast) const
+{
+    iFirst = jFirst = 0;
+    iLast = jLast = this->resolution - 1;
+
+    if (this->resolution < 2)
+    {
+        return true;
+    }
+
+    // Pixels form regular grid: position = origin + i * di + j * dj.
+    const RR3Vector &origin = this->pixels[0].getPosition();
+    RR3Vector di, dj, normal, eyeOrigin;
+    RR3Vector::subtract(this->pixels[this->resolution].getPosition(),origin,di);
+    RR3Vector::subtract(this->pixels[1].getPosition(),origin,dj);
+    RR3Vector::subtract(origin,this->eyePosition,eyeOrigin);
+    RR3Vector::cross(di,dj,normal);
+
+    double ddi = RR3Vector::dot(di,di);
+    double ddj = RR3Vector::dot(dj,dj);
+    double nd = RR3Vector::dot(normal,eyeOrigin);
+    if (ddi == 0.0 || ddj == 0.0 || nd == 0.0)
+    {
+        return true;
+    }
+
+    const RNode *nodes[3] = { &triangle.getNode1(), &triangle.getNode2(), &triangle.getNode3() };
+    double il = 0.0, iu = 0.0, jl = 0.0, ju = 0.0;
+
+    for (uint k=0;k<3;k++)
+    {
+        RR3Vector d(nodes[k]->getX() - this->eyePosition[0],
+                    nodes[k]->getY() - this->eyePosition[1],
+                    nodes[k]->getZ() - this->eyePosition[2]);
+        double t = RR3Vector::dot(normal,d) / nd;
+        if (t <= 0.0)
+        {
+            // Node is not in front of the eye, projection is not bounded.
+            return true;
+        }
+        // Project node to pixel plane.
+        RR3Vector p(d[0] / t - eyeOrigin[0],
+                    d[1] / t - eyeOrigin[1],
+                    d[2] / t - eyeOrigin[2]);
+        double pi = RR3Vector::dot(p,di) / ddi;
+        double pj = RR3Vector::dot(p,dj) / ddj;
+        if (k == 0)
+        {
+            il = iu = pi;
+            jl = ju = pj;
+        }
+        else
+        {
+            il = std::min(il,pi);
+            iu = std::max(iu,pi);
+            jl = std::min(jl,pj);
+            ju = std::max(ju,pj);
+        }
+    }
+
+    double n = double(this->resolution - 1);
+    if (iu < -1.0 || ju < -1.0 || il > n + 1.0 || jl > n + 1.0)
+    {
+        return false;
+    }
+
+    // Extend range by one pixel to be safe against round-off.
+    iFirst = uint(std::max(0.0,std::floor(il) - 1.0));
+    iLast = uint(std::min(n,std::ceil(iu) + 1.0));
+    jFirst = uint(std::max(0.0,std::floor(jl) - 1.0));
+    jLast = uint(std::min(n,std::ceil(ju) + 1.0));
+
+    return true;
+}
+
 RLimitBox RHemiCubeSector::findLimitBox(void) const
 {
     double xl = 0.0, yl = 0.0, zl = 0.0;
@@ -65,6 +65,11 @@ void RIterationInfo::setNIterations(unsigned int nIterations)
     this->nIterations = nIterations;
 }
 
+unsigned int RIterationInfo::getOutputFrequency(void) const
+{
+    return this->outputFrequency;
+}
+
 void RIterationInfo::setOutputFrequency(unsigned int outputFrequency)
 {
     this->outputFrequency = outputFrequency;
@@ -75,11 +80,21 @@ void RIterationInfo::setConvergenceValue(double convergenceValue)
     this->convergenceValue = convergenceValue;
 }
 
+unsigned int RIterationInfo::getIteration(void) const
+{
+    return this->iteration;
+}
+
 void RIterationInfo::setIteration(unsigned int iteration)
 {
     this->iteration = iteration;
 }
 
+double RIterationInfo::getError(void) const
+{
+    return this->error;
+}
+
 void RIterationInfo::setError(double error)
 {
     this->trend = error - this->error;
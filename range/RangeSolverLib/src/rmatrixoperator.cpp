@@ -0,0 +1,20 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rmatrixoperator.cpp                                      *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Matrix operator class definition                    *
+ *********************************************************************/
+
+#include "rmatrixoperator.h"
+
+RMatrixOperator::~RMatrixOperator()
+{
+}
+
+void RMatrixOperator::findSolutionNormWeights(RRVector &weights) const
+{
+    weights.clear();
+}
@@ -8,11 +8,15 @@
  *  DESCRIPTION: Matrix preconditioner class definition              *
  *********************************************************************/
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <queue>
 
 #include <omp.h>
 
 #include "rmatrixpreconditioner.h"
+#include "rsingleprecisionmatrixoperator.h"
 
 void RMatrixPreconditioner::_init(const RMatrixPreconditioner *pMatrixPreconditioner)
 {
@@ -20,27 +24,76 @@ void RMatrixPreconditioner::_init(const RMatrixPreconditioner *pMatrixPreconditi
     {
         this->matrixPreconditionerType = pMatrixPreconditioner->matrixPreconditionerType;
         this->data = pMatrixPreconditioner->data;
+        this->inverseBlockDiagonal = pMatrixPreconditioner->inverseBlockDiagonal;
+        this->LU = pMatrixPreconditioner->LU;
+        this->diagonalPositions = pMatrixPreconditioner->diagonalPositions;
+        this->singleLUValues = pMatrixPreconditioner->singleLUValues;
+        this->lowerLevelPointers = pMatrixPreconditioner->lowerLevelPointers;
+        this->lowerLevelRows = pMatrixPreconditioner->lowerLevelRows;
+        this->upperLevelPointers = pMatrixPreconditioner->upperLevelPointers;
+        this->upperLevelRows = pMatrixPreconditioner->upperLevelRows;
+        this->multigrid = pMatrixPreconditioner->multigrid;
     }
 }
 
-RMatrixPreconditioner::RMatrixPreconditioner(const RSparseMatrix &matrix, RMatrixPreconditionerType matrixPreconditionerType, unsigned int blockSize)
+RMatrixPreconditioner::RMatrixPreconditioner(const RSparseMatrixCSR &matrix,
+                                             RMatrixPreconditionerType matrixPreconditionerType,
+                                             unsigned int blockSize,
+                                             const std::vector<RRVector> &nearNullSpace,
+                                             const std::vector<uint> &rowBlockIndexes,
+                                             const RSparseMatrixBSR *pBlockMatrix)
     : matrixPreconditionerType(matrixPreconditionerType)
 {
     this->_init();
 
     switch (matrixPreconditionerType)
     {
+        case R_MATRIX_PRECONDITIONER_NONE:
+            break;
         case R_MATRIX_PRECONDITIONER_JACOBI:
             this->constructJacobi(matrix);
             break;
         case R_MATRIX_PRECONDITIONER_BLOCK_JACOBI:
-            this->constructBlockJacobi(matrix,blockSize);
+            this->constructBlockJacobi(matrix,blockSize,rowBlockIndexes,pBlockMatrix);
+            break;
+        case R_MATRIX_PRECONDITIONER_INCOMPLETE_CHOLESKY:
+            this->constructIncompleteCholesky(matrix);
+            break;
+        case R_MATRIX_PRECONDITIONER_INCOMPLETE_LU:
+            this->constructIncompleteLU(matrix);
+            break;
+        case R_MATRIX_PRECONDITIONER_ALGEBRAIC_MULTIGRID:
+            this->multigrid.build(matrix,blockSize,nearNullSpace,rowBlockIndexes);
+            break;
+        case R_MATRIX_PRECONDITIONER_INCOMPLETE_LU_THRESHOLD:
+            this->constructIncompleteLUThreshold(matrix);
             break;
         default:
             throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Invalid matrix preconditioner type \'%d\'",matrixPreconditionerType);
     }
 }
 
+RMatrixPreconditioner::RMatrixPreconditioner(const RMatrixOperator &matrixOperator, RMatrixPreconditionerType matrixPreconditionerType)
+    : matrixPreconditionerType(matrixPreconditionerType)
+{
+    this->_init();
+
+    switch (matrixPreconditionerType)
+    {
+        case R_MATRIX_PRECONDITIONER_NONE:
+            break;
+        case R_MATRIX_PRECONDITIONER_JACOBI:
+        {
+            RRVector diagonal;
+            matrixOperator.findDiagonal(diagonal);
+            this->constructJacobi(diagonal);
+            break;
+        }
+        default:
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Matrix preconditioner type \'%d\' requires assembled matrix",matrixPreconditionerType);
+    }
+}
+
 RMatrixPreconditioner::RMatrixPreconditioner(const RMatrixPreconditioner &matrixPreconditioner)
 {
     this->_init(&matrixPreconditioner);
@@ -60,18 +113,55 @@ void RMatrixPreconditioner::compute(const RRVector &x, RRVector &y) const
 {
     switch (matrixPreconditionerType)
     {
+        case R_MATRIX_PRECONDITIONER_NONE:
+#pragma omp single
+            y = x;
+            break;
         case R_MATRIX_PRECONDITIONER_JACOBI:
             this->computeJacobi(x,y);
             break;
         case R_MATRIX_PRECONDITIONER_BLOCK_JACOBI:
             this->computeBlockJacobi(x,y);
             break;
+        case R_MATRIX_PRECONDITIONER_INCOMPLETE_CHOLESKY:
+        case R_MATRIX_PRECONDITIONER_INCOMPLETE_LU:
+        case R_MATRIX_PRECONDITIONER_INCOMPLETE_LU_THRESHOLD:
+            this->computeIncompleteFactorization(x,y);
+            break;
+        case R_MATRIX_PRECONDITIONER_ALGEBRAIC_MULTIGRID:
+            this->multigrid.compute(x,y);
+            break;
         default:
             throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Invalid matrix preconditioner type \'%d\'",matrixPreconditionerType);
     }
 }
 
-void RMatrixPreconditioner::constructJacobi(const RSparseMatrix &matrix)
+void RMatrixPreconditioner::convertToSinglePrecision(void)
+{
+    if (this->matrixPreconditionerType != R_MATRIX_PRECONDITIONER_INCOMPLETE_CHOLESKY &&
+        this->matrixPreconditionerType != R_MATRIX_PRECONDITIONER_INCOMPLETE_LU &&
+        this->matrixPreconditionerType != R_MATRIX_PRECONDITIONER_INCOMPLETE_LU_THRESHOLD)
+    {
+        return;
+    }
+
+    const std::vector<double> &values = this->LU.getValues();
+
+    if (!RSinglePrecisionMatrixOperator::isInRange(values))
+    {
+        RLogger::warning("Incomplete factorization values are out of single precision range, double precision is used instead.\n");
+        this->singleLUValues.clear();
+        return;
+    }
+
+    this->singleLUValues.resize(values.size());
+    for (uint i=0;i<values.size();i++)
+    {
+        this->singleLUValues[i] = float(values[i]);
+    }
+}
+
+void RMatrixPreconditioner::constructJacobi(const RSparseMatrixCSR &matrix)
 {
     unsigned int nRows = matrix.getNRows();
 
@@ -80,54 +170,444 @@ void RMatrixPreconditioner::constructJacobi(const RSparseMatrix &matrix)
 
     for (unsigned int i=0;i<nRows;i++)
     {
-        unsigned int columnPosition = 0;
-        if (matrix.findColumnPosition(i,i,columnPosition))
+        this->data[i][0] = matrix.findValue(i,i);
+    }
+}
+
+void RMatrixPreconditioner::constructJacobi(const RRVector &diagonal)
+{
+    unsigned int nRows = diagonal.getNRows();
+
+    this->data.resize(nRows,1);
+
+    for (unsigned int i=0;i<nRows;i++)
+    {
+        this->data[i][0] = diagonal[i];
+    }
+}
+
+void RMatrixPreconditioner::constructBlockJacobi(const RSparseMatrixCSR &matrix, unsigned int blockSize, const std::vector<uint> &rowBlockIndexes, const RSparseMatrixBSR *pBlockMatrix)
+{
+    blockSize = std::max(blockSize,1u);
+
+    if (pBlockMatrix && pBlockMatrix->getBlockSize() == blockSize && pBlockMatrix->getNRows() == matrix.getNRows())
+    {
+        pBlockMatrix->findInverseBlockDiagonal(this->inverseBlockDiagonal);
+        return;
+    }
+
+    RSparseMatrixBSR blockMatrix(matrix,blockSize,rowBlockIndexes);
+    blockMatrix.findInverseBlockDiagonal(this->inverseBlockDiagonal);
+}
+
+void RMatrixPreconditioner::constructIncompleteCholesky(const RSparseMatrixCSR &matrix)
+{
+    unsigned int nRows = matrix.getNRows();
+    unsigned int nAttempts = 10;
+    double shift = 0.0;
+
+    for (unsigned int attempt=0;attempt<nAttempts;attempt++)
+    {
+        this->LU = matrix;
+        this->findDiagonalPositions();
+
+        bool breakDown = false;
+
+        // Compute lower triangular factor L (L*L^T = A) in place of lower part of matrix.
+        for (unsigned int i=0;i<nRows;i++)
         {
-            this->data[i][0] = matrix.getValue(i,columnPosition);
+            unsigned int di = this->diagonalPositions[i];
+
+            for (unsigned int p=this->LU.getRowBegin(i);p<di;p++)
+            {
+                unsigned int k = this->LU.getColumnIndex(p);
+                unsigned int dk = this->diagonalPositions[k];
+
+                // Sum of l(i,j)*l(k,j) for j < k.
+                double sum = 0.0;
+                unsigned int pi = this->LU.getRowBegin(i);
+                unsigned int pk = this->LU.getRowBegin(k);
+                while (pi < p && pk < dk)
+                {
+                    unsigned int ci = this->LU.getColumnIndex(pi);
+                    unsigned int ck = this->LU.getColumnIndex(pk);
+                    if (ci == ck)
+                    {
+                        sum += this->LU.getValue(pi) * this->LU.getValue(pk);
+                        pi++;
+                        pk++;
+                    }
+                    else if (ci < ck)
+                    {
+                        pi++;
+                    }
+                    else
+                    {
+                        pk++;
+                    }
+                }
+                this->LU.getValue(p) = (this->LU.getValue(p) - sum) / this->LU.getValue(dk);
+            }
+
+            double sum = 0.0;
+            for (unsigned int p=this->LU.getRowBegin(i);p<di;p++)
+            {
+                sum += std::pow(this->LU.getValue(p),2);
+            }
+            double d = this->LU.getValue(di) * (1.0 + shift) - sum;
+            if (d <= 0.0)
+            {
+                breakDown = true;
+                break;
+            }
+            this->LU.getValue(di) = std::sqrt(d);
         }
+
+        if (!breakDown)
+        {
+            break;
+        }
+
+        if (attempt + 1 == nAttempts)
+        {
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Incomplete Cholesky factorization failed. Matrix is not positive definite.");
+        }
+
+        shift = (shift == 0.0) ? 1.0e-3 : 2.0 * shift;
+        RLogger::warning("Incomplete Cholesky factorization broke down. Restarting with diagonal shift %g\n",shift);
     }
+
+    // Convert L*L^T into unit lower and upper factor: L*L^T = (L*D^-1)*(D*L^T), where D = diag(L).
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nRows);i++)
+    {
+        unsigned int di = this->diagonalPositions[i];
+        for (unsigned int p=this->LU.getRowBegin(uint(i));p<di;p++)
+        {
+            unsigned int k = this->LU.getColumnIndex(p);
+            double lik = this->LU.getValue(p);
+            double lkk = this->LU.getValue(this->diagonalPositions[k]);
+
+            unsigned int q = 0;
+            if (this->LU.findPosition(k,uint(i),q))
+            {
+                this->LU.getValue(q) = lkk * lik;
+            }
+            this->LU.getValue(p) = lik / lkk;
+        }
+    }
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nRows);i++)
+    {
+        double &value = this->LU.getValue(this->diagonalPositions[i]);
+        value *= value;
+    }
+
+    this->findLevelSchedule();
 }
 
-void RMatrixPreconditioner::constructBlockJacobi(const RSparseMatrix &matrix, unsigned int blockSize)
+void RMatrixPreconditioner::constructIncompleteLU(const RSparseMatrixCSR &matrix)
 {
-    unsigned int width = blockSize;
-
-    // Matrix mus be dividable by block size.
     unsigned int nRows = matrix.getNRows();
-    while (nRows % width != 0)
+
+    this->LU = matrix;
+    this->findDiagonalPositions();
+
+    // Position of column value in currently processed row.
+    std::vector<uint> positions(nRows,RConstants::eod);
+
+    for (unsigned int i=0;i<nRows;i++)
     {
-        width --;
+        unsigned int di = this->diagonalPositions[i];
+
+        for (unsigned int p=this->LU.getRowBegin(i);p<this->LU.getRowEnd(i);p++)
+        {
+            positions[this->LU.getColumnIndex(p)] = p;
+        }
+
+        for (unsigned int p=this->LU.getRowBegin(i);p<di;p++)
+        {
+            unsigned int k = this->LU.getColumnIndex(p);
+            unsigned int dk = this->diagonalPositions[k];
+
+            double lik = this->LU.getValue(p) / this->LU.getValue(dk);
+            this->LU.getValue(p) = lik;
+
+            for (unsigned int q=dk+1;q<this->LU.getRowEnd(k);q++)
+            {
+                unsigned int position = positions[this->LU.getColumnIndex(q)];
+                if (position != RConstants::eod)
+                {
+                    this->LU.getValue(position) -= lik * this->LU.getValue(q);
+                }
+            }
+        }
+
+        double &pivot = this->LU.getValue(di);
+        if (std::abs(pivot) < RConstants::eps)
+        {
+            pivot = (pivot < 0.0) ? -RConstants::eps : RConstants::eps;
+        }
+
+        for (unsigned int p=this->LU.getRowBegin(i);p<this->LU.getRowEnd(i);p++)
+        {
+            positions[this->LU.getColumnIndex(p)] = RConstants::eod;
+        }
     }
 
-    this->data.resize(nRows,width,0.0);
+    this->findLevelSchedule();
+}
 
-    unsigned int nBlocks = nRows/width;
+//! Sort column indexes by decreasing magnitude of their working row values.
+class RIncompleteLUThresholdMagnitudeGreater
+{
+    protected:
+
+        const std::vector<double> &w;
+
+    public:
+
+        RIncompleteLUThresholdMagnitudeGreater(const std::vector<double> &w) : w(w) { }
 
-    for (unsigned int i=0;i<nBlocks;i++)
+        bool operator ()(uint a, uint b) const
+        {
+            return std::abs(this->w[a]) > std::abs(this->w[b]);
+        }
+};
+
+//! Drop all but maxValues largest values from column indexes and sort remaining indexes in ascending order.
+static void keepLargestValues(std::vector<uint> &columns, const std::vector<double> &w, uint maxValues)
+{
+    if (columns.size() > maxValues)
     {
-        for (unsigned int k=0;k<width;k++)
+        std::nth_element(columns.begin(),columns.begin()+maxValues,columns.end(),RIncompleteLUThresholdMagnitudeGreater(w));
+        columns.resize(maxValues);
+    }
+    std::sort(columns.begin(),columns.end());
+}
+
+void RMatrixPreconditioner::constructIncompleteLUThreshold(const RSparseMatrixCSR &matrix, double dropTolerance, unsigned int fillFactor)
+{
+    unsigned int nRows = matrix.getNRows();
+
+    std::vector<uint> rowPointers(nRows+1,0);
+    std::vector<uint> columnIndexes;
+    std::vector<double> values;
+    std::vector<uint> factorDiagonalPositions(nRows,0);
+
+    columnIndexes.reserve(size_t(fillFactor) * matrix.getNValues());
+    values.reserve(size_t(fillFactor) * matrix.getNValues());
+
+    // Working row values and flag whether column is present in working row.
+    std::vector<double> w(nRows,0.0);
+    std::vector<char> isPresent(nRows,0);
+    std::vector<uint> rowColumns;
+    std::vector<uint> lowerColumns;
+    std::vector<uint> upperColumns;
+
+    for (unsigned int i=0;i<nRows;i++)
+    {
+        // Lower columns are eliminated in ascending order, fill-in may add new lower columns.
+        std::priority_queue< uint,std::vector<uint>,std::greater<uint> > lowerQueue;
+
+        rowColumns.clear();
+        double rowNorm = 0.0;
+        uint nLower = 0;
+        uint nUpper = 0;
+
+        for (unsigned int p=matrix.getRowBegin(i);p<matrix.getRowEnd(i);p++)
         {
-            unsigned int m = i*width + k;
-            for (unsigned int l=0;l<width;l++)
+            unsigned int j = matrix.getColumnIndex(p);
+            w[j] += matrix.getValue(p);
+            rowNorm += std::pow(matrix.getValue(p),2);
+            if (!isPresent[j])
             {
-                unsigned int n = i*width + l;
-                unsigned int columnPosition = 0;
-                if (matrix.findColumnPosition(m,n,columnPosition))
+                isPresent[j] = 1;
+                rowColumns.push_back(j);
+                if (j < i)
+                {
+                    lowerQueue.push(j);
+                    nLower++;
+                }
+                else if (j > i)
                 {
-                    this->data[m][l] = matrix.getValue(m,columnPosition);
+                    nUpper++;
                 }
             }
         }
+        if (!isPresent[i])
+        {
+            isPresent[i] = 1;
+            rowColumns.push_back(i);
+        }
+
+        double tolerance = dropTolerance * std::sqrt(rowNorm);
+
+        while (!lowerQueue.empty())
+        {
+            unsigned int k = lowerQueue.top();
+            lowerQueue.pop();
+
+            unsigned int dk = factorDiagonalPositions[k];
+            w[k] /= values[dk];
+            if (std::abs(w[k]) < tolerance)
+            {
+                w[k] = 0.0;
+                continue;
+            }
+
+            for (unsigned int q=dk+1;q<rowPointers[k+1];q++)
+            {
+                unsigned int j = columnIndexes[q];
+                if (!isPresent[j])
+                {
+                    isPresent[j] = 1;
+                    rowColumns.push_back(j);
+                    if (j < i)
+                    {
+                        lowerQueue.push(j);
+                    }
+                }
+                w[j] -= w[k] * values[q];
+            }
+        }
+
+        lowerColumns.clear();
+        upperColumns.clear();
+        for (uint p=0;p<rowColumns.size();p++)
+        {
+            unsigned int j = rowColumns[p];
+            if (j != i && w[j] != 0.0 && std::abs(w[j]) >= tolerance)
+            {
+                if (j < i)
+                {
+                    lowerColumns.push_back(j);
+                }
+                else
+                {
+                    upperColumns.push_back(j);
+                }
+            }
+        }
+        keepLargestValues(lowerColumns,w,fillFactor*nLower);
+        keepLargestValues(upperColumns,w,fillFactor*nUpper);
+
+        for (uint p=0;p<lowerColumns.size();p++)
+        {
+            columnIndexes.push_back(lowerColumns[p]);
+            values.push_back(w[lowerColumns[p]]);
+        }
+
+        double pivot = w[i];
+        if (std::abs(pivot) < RConstants::eps)
+        {
+            // Zero pivot is replaced by drop tolerance to keep factor regular.
+            double shift = std::max(tolerance,RConstants::eps);
+            pivot = (pivot < 0.0) ? -shift : shift;
+        }
+        factorDiagonalPositions[i] = uint(values.size());
+        columnIndexes.push_back(i);
+        values.push_back(pivot);
+
+        for (uint p=0;p<upperColumns.size();p++)
+        {
+            columnIndexes.push_back(upperColumns[p]);
+            values.push_back(w[upperColumns[p]]);
+        }
+
+        rowPointers[i+1] = uint(values.size());
+
+        for (uint p=0;p<rowColumns.size();p++)
+        {
+            w[rowColumns[p]] = 0.0;
+            isPresent[rowColumns[p]] = 0;
+        }
+    }
+
+    this->LU.build(rowPointers,columnIndexes,values);
+    this->diagonalPositions = factorDiagonalPositions;
+
+    this->findLevelSchedule();
+}
+
+void RMatrixPreconditioner::findDiagonalPositions(void)
+{
+    unsigned int nRows = this->LU.getNRows();
+
+    this->diagonalPositions.resize(nRows);
+
+    for (unsigned int i=0;i<nRows;i++)
+    {
+        if (!this->LU.findPosition(i,i,this->diagonalPositions[i]))
+        {
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Matrix has no diagonal value in row %u.",i);
+        }
+    }
+}
+
+static void groupRowsByLevel(const std::vector<uint> &rowLevels, uint nLevels, std::vector<uint> &levelPointers, std::vector<uint> &levelRows)
+{
+    levelPointers.assign(nLevels+1,0);
+    for (uint i=0;i<rowLevels.size();i++)
+    {
+        levelPointers[rowLevels[i]+1]++;
+    }
+    for (uint i=0;i<nLevels;i++)
+    {
+        levelPointers[i+1] += levelPointers[i];
+    }
+    levelRows.resize(rowLevels.size());
+    std::vector<uint> levelPositions(levelPointers.begin(),levelPointers.end()-1);
+    for (uint i=0;i<rowLevels.size();i++)
+    {
+        levelRows[levelPositions[rowLevels[i]]++] = i;
+    }
+}
+
+void RMatrixPreconditioner::findLevelSchedule(void)
+{
+    unsigned int nRows = this->LU.getNRows();
+
+    std::vector<uint> rowLevels(nRows,0);
+    unsigned int nLevels = 0;
+
+    // Forward substitution - row depends on rows with lower index.
+    for (unsigned int i=0;i<nRows;i++)
+    {
+        unsigned int level = 0;
+        for (unsigned int p=this->LU.getRowBegin(i);p<this->diagonalPositions[i];p++)
+        {
+            level = std::max(level,rowLevels[this->LU.getColumnIndex(p)]+1);
+        }
+        rowLevels[i] = level;
+        nLevels = std::max(nLevels,level+1);
+    }
+    groupRowsByLevel(rowLevels,nLevels,this->lowerLevelPointers,this->lowerLevelRows);
+
+    // Backward substitution - row depends on rows with higher index.
+    nLevels = 0;
+    for (unsigned int i=nRows;i>0;i--)
+    {
+        unsigned int level = 0;
+        for (unsigned int p=this->diagonalPositions[i-1]+1;p<this->LU.getRowEnd(i-1);p++)
+        {
+            level = std::max(level,rowLevels[this->LU.getColumnIndex(p)]+1);
+        }
+        rowLevels[i-1] = level;
+        nLevels = std::max(nLevels,level+1);
     }
+    groupRowsByLevel(rowLevels,nLevels,this->upperLevelPointers,this->upperLevelRows);
 }
 
 void RMatrixPreconditioner::computeJacobi(const RRVector &x, RRVector &y) const
 {
     unsigned int nRows = this->data.getNRows();
 
+#pragma omp single
     y.resize(nRows);
 
-    for (unsigned int i=0;i<nRows;i++)
+#pragma omp for
+    for (int64_t i=0;i<int64_t(nRows);i++)
     {
         y[i] = (this->data[i][0] == 0.0) ? 0.0 : x[i] / this->data[i][0];
     }
@@ -135,35 +615,63 @@ void RMatrixPreconditioner::computeJacobi(const RRVector &x, RRVector &y) const
 
 void RMatrixPreconditioner::computeBlockJacobi(const RRVector &x, RRVector &y) const
 {
-    unsigned int nRows = this->data.getNRows();
-    unsigned int width = this->data.getNColumns();
+    RSparseMatrixBSR::mlt(this->inverseBlockDiagonal,x,y);
+}
 
-    y.resize(nRows);
+template <typename T>
+void RMatrixPreconditioner::computeIncompleteFactorization(const T *pValue, const RRVector &x, RRVector &y) const
+{
+    unsigned int nRows = this->LU.getNRows();
 
-    RRMatrix As(width,width);
-    RRVector xs(width);
-    RRVector ys(width);
+#pragma omp single
+    y.resize(nRows);
 
-    unsigned int nBlocks = nRows/width;
+    const uint *pIndex = this->LU.getColumnIndexes().data();
+    const double *pX = x.data();
+    double *pY = y.data();
 
-    for (unsigned int i=0;i<nBlocks;i++)
+    // Forward substitution L*w = x
+    for (unsigned int l=0;l+1<this->lowerLevelPointers.size();l++)
     {
-        for (unsigned int k=0;k<width;k++)
+#pragma omp for
+        for (int64_t j=this->lowerLevelPointers[l];j<int64_t(this->lowerLevelPointers[l+1]);j++)
         {
-            unsigned int m = i*width + k;
-            for (unsigned int l=0;l<width;l++)
+            unsigned int i = this->lowerLevelRows[j];
+            double value = pX[i];
+            for (unsigned int k=this->LU.getRowBegin(i);k<this->diagonalPositions[i];k++)
             {
-                As[k][l] = this->data[m][l];
+                value -= double(pValue[k]) * pY[pIndex[k]];
             }
-            xs[k] = x[m];
+            pY[i] = value;
         }
+    }
 
-        RRMatrix::solveLU(As,xs,ys);
-
-        for (unsigned int k=0;k<width;k++)
+    // Backward substitution U*y = w
+    for (unsigned int l=0;l+1<this->upperLevelPointers.size();l++)
+    {
+#pragma omp for
+        for (int64_t j=this->upperLevelPointers[l];j<int64_t(this->upperLevelPointers[l+1]);j++)
         {
-            unsigned int m = i*width + k;
-            y[m] = ys[k];
+            unsigned int i = this->upperLevelRows[j];
+            unsigned int di = this->diagonalPositions[i];
+            double value = pY[i];
+            for (unsigned int k=di+1;k<this->LU.getRowEnd(i);k++)
+            {
+                value -= double(pValue[k]) * pY[pIndex[k]];
+            }
+            pY[i] = value / double(pValue[di]);
         }
     }
 }
+
+void RMatrixPreconditioner::computeIncompleteFactorization(const RRVector &x, RRVector &y) const
+{
+    if (this->singleLUValues.empty())
+    {
+        this->computeIncompleteFactorization(this->LU.getValues().data(),x,y);
+    }
+    else
+    {
+        this->computeIncompleteFactorization(this->singleLUValues.data(),x,y);
+    }
+}
@@ -8,6 +8,7 @@
  *  DESCRIPTION: Matrix solver class definition                      *
  *********************************************************************/
 
+#include <algorithm>
 #include <string>
 #include <cmath>
 
@@ -15,6 +16,28 @@
 
 #include "rmatrixsolver.h"
 
+//! Maximum number of iterative refinement steps of direct solution with perturbed pivots.
+static const uint directSolverMaxRefinements = 10;
+
+//! Compute residual r = b - A*x and return relative residual norm.
+static double findRelativeResidual(const RSparseMatrixCSR &A, const RRVector &b, const RRVector &x, RRVector &r)
+{
+    double rn = 0.0;
+    double bn = 0.0;
+
+    r.resize(A.getNRows());
+
+#pragma omp parallel for default(shared) reduction(+:rn,bn)
+    for (int64_t i=0;i<int64_t(A.getNRows());i++)
+    {
+        r[i] = b[i] - A.mltRow(uint(i),x);
+        rn += r[i]*r[i];
+        bn += b[i]*b[i];
+    }
+
+    return (bn > 0.0) ? std::sqrt(rn/bn) : std::sqrt(rn);
+}
+
 void RMatrixSolver::_init(const RMatrixSolver *pMatrixSolver)
 {
     this->iterationInfo.setConvergenceValue(this->matrixSolverConf.getSolverCvgValue());
@@ -26,11 +49,20 @@ void RMatrixSolver::_init(const RMatrixSolver *pMatrixSolver)
     {
         this->matrixSolverConf = pMatrixSolver->matrixSolverConf;
         this->iterationInfo = pMatrixSolver->iterationInfo;
+        this->nearNullSpace = pMatrixSolver->nearNullSpace;
+        this->rowBlockIndexes = pMatrixSolver->rowBlockIndexes;
+        this->directSolver = pMatrixSolver->directSolver;
+        this->pExternalDirectSolver = pMatrixSolver->pExternalDirectSolver;
+        this->blockMatrix = pMatrixSolver->blockMatrix;
+        this->blockMatrixRowPointers = pMatrixSolver->blockMatrixRowPointers;
+        this->blockMatrixColumnIndexes = pMatrixSolver->blockMatrixColumnIndexes;
+        this->blockMatrixRowBlockIndexes = pMatrixSolver->blockMatrixRowBlockIndexes;
     }
 }
 
 RMatrixSolver::RMatrixSolver(const RMatrixSolverConf &matrixSolverConf)
     : matrixSolverConf(matrixSolverConf)
+    , pExternalDirectSolver(nullptr)
 {
     this->_init();
 }
@@ -52,24 +84,169 @@ RMatrixSolver & RMatrixSolver::operator =(const RMatrixSolver &matrixSolver)
 
 void RMatrixSolver::solve(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType, unsigned int blockSize)
 {
-    RMatrixPreconditioner P(A,matrixPreconditionerType,blockSize);
-    RRVector y(b);
+    this->solve(RSparseMatrixCSR(A),b,x,matrixPreconditionerType,blockSize);
+}
 
-    double An = A.findNorm();
-    double bn = RRVector::norm(b);
-    double equationScale = 1.0;
+void RMatrixSolver::solve(const RSparseMatrixCSR &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType, unsigned int blockSize)
+{
+    this->writeSystem(A,b,x,matrixPreconditionerType,blockSize);
 
-    if (bn != 0.0 && An != 0.0)
+    if (this->matrixSolverConf.getDirectSolver())
     {
-        equationScale = 1.0e9 / std::abs(bn/An);
+        this->solveDirect(A,b,x);
+        return;
+    }
+
+    const RSparseMatrixBSR *pBlockMatrix = nullptr;
+    if (blockSize > 1)
+    {
+        this->prepareBlockMatrix(A,blockSize);
+        pBlockMatrix = &this->blockMatrix;
+        RLogger::info("Block size = %u, blocks = %u\n",this->blockMatrix.getBlockSize(),this->blockMatrix.getNBlocks());
+    }
+
+    RMatrixPreconditioner P(A,matrixPreconditionerType,blockSize,this->nearNullSpace,this->rowBlockIndexes,pBlockMatrix);
+
+    if (this->matrixSolverConf.getMixedPrecision())
+    {
+        if (RSinglePrecisionMatrixOperator::isInRange(A.getValues()))
+        {
+            this->solveMixedPrecision(A,b,x,P);
+            return;
+        }
+        RLogger::warning("Matrix values are out of single precision range, double precision is used instead.\n");
+    }
+
+    this->solveIterative(RSparseMatrixOperator(A,pBlockMatrix),b,x,P);
+}
+
+void RMatrixSolver::solve(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType)
+{
+    if (this->matrixSolverConf.getDirectSolver())
+    {
+        RLogger::warning("Sparse direct solver requires assembled matrix, iterative solver is used instead.\n");
+    }
+
+    if (this->matrixSolverConf.getMixedPrecision())
+    {
+        RLogger::warning("Mixed precision solver requires assembled matrix, double precision is used instead.\n");
+    }
+
+    if (matrixPreconditionerType != R_MATRIX_PRECONDITIONER_NONE && matrixPreconditionerType != R_MATRIX_PRECONDITIONER_JACOBI)
+    {
+        RLogger::warning("%s preconditioner requires assembled matrix, %s preconditioner is used instead.\n",
+                         RMatrixSolverConf::getPreconditionerName(matrixPreconditionerType).toUtf8().constData(),
+                         RMatrixSolverConf::getPreconditionerName(R_MATRIX_PRECONDITIONER_JACOBI).toUtf8().constData());
+        matrixPreconditionerType = R_MATRIX_PRECONDITIONER_JACOBI;
+    }
+
+    RLogger::info("Matrix free solver\n");
+
+    RMatrixPreconditioner P(A,matrixPreconditionerType);
+
+    this->solveIterative(A,b,x,P);
+}
+
+void RMatrixSolver::setNearNullSpace(const std::vector<RRVector> &nearNullSpace, const std::vector<uint> &rowBlockIndexes)
+{
+    this->nearNullSpace = nearNullSpace;
+    this->rowBlockIndexes = rowBlockIndexes;
+}
+
+void RMatrixSolver::setRowBlockIndexes(const std::vector<uint> &rowBlockIndexes)
+{
+    this->rowBlockIndexes = rowBlockIndexes;
+}
+
+void RMatrixSolver::setDirectSolver(RSparseDirectSolver *pDirectSolver)
+{
+    this->pExternalDirectSolver = pDirectSolver;
+}
+
+const RIterationInfo &RMatrixSolver::getIterationInfo(void) const
+{
+    return this->iterationInfo;
+}
+
+QString RMatrixSolver::findSystemFileName(void) const
+{
+    if (!this->matrixSolverConf.getSystemFileName().isEmpty())
+    {
+        return this->matrixSolverConf.getSystemFileName();
+    }
+    return qEnvironmentVariable("RANGE_MATRIX_SYSTEM_FILE");
+}
+
+void RMatrixSolver::writeSystem(const RSparseMatrixCSR &A, const RRVector &b, const RRVector &x, RMatrixPreconditionerType matrixPreconditionerType, unsigned int blockSize) const
+{
+    QString fileName = this->findSystemFileName();
+    if (fileName.isEmpty())
+    {
+        return;
     }
 
+    // Each solved system gets its own number so that all systems of a transient or nonlinear run are kept.
+    static unsigned int systemCounter = 0;
+    unsigned int systemNumber = 0;
+#pragma omp atomic capture
+    systemNumber = systemCounter++;
+
+    fileName = RFileManager::getFileNameWithSuffix(fileName,QString("%1").arg(systemNumber,4,10,QChar('0')));
+
+    RMatrixSystem matrixSystem;
+    matrixSystem.setMatrixSolverConf(this->matrixSolverConf);
+    matrixSystem.setPreconditionerType(matrixPreconditionerType);
+    matrixSystem.setBlockSize(blockSize);
+    matrixSystem.setMatrix(A);
+    matrixSystem.setRhs(b);
+    matrixSystem.setInitialGuess(x);
+    matrixSystem.setRowBlockIndexes(this->rowBlockIndexes);
+    matrixSystem.setNearNullSpace(this->nearNullSpace);
+
+    RLogger::info("Writing matrix system to file \'%s\'\n",fileName.toUtf8().constData());
+    try
+    {
+        matrixSystem.write(fileName);
+    }
+    catch (const RError &error)
+    {
+        // Failed dump must not stop the solver.
+        RLogger::warning("Failed to write matrix system. %s\n",error.getMessage().toUtf8().constData());
+    }
+}
+
+void RMatrixSolver::disableConvergenceLogFile(void)
+{
+    this->iterationInfo.setOutputFileName(QString());
+}
+
+void RMatrixSolver::solveIterative(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P)
+{
+    double An = A.findNorm();
+
     RLogger::info("Unknowns = %u\n",b.size());
     RLogger::info("||A|| = %13e\n",An);
-    RLogger::info("||b|| = %13e\n",bn);
+    RLogger::info("||b|| = %13e\n",RRVector::norm(b));
 
     this->iterationInfo.printHeader(RMatrixSolverConf::getName(this->matrixSolverConf.getType()));
 
+    this->solveIterativeScaled(A,An,b,x,P);
+
+    this->iterationInfo.printFooter();
+}
+
+void RMatrixSolver::solveIterativeScaled(const RMatrixOperator &A, double An, const RRVector &b, RRVector &x, RMatrixPreconditioner &P)
+{
+    RRVector y(b);
+
+    double bn = RRVector::norm(b);
+    double equationScale = 1.0;
+
+    if (bn != 0.0 && An != 0.0)
+    {
+        equationScale = 1.0e9 / std::abs(bn/An);
+    }
+
     this->iterationInfo.setEquationScale(equationScale);
 
     x.resize(b.getNRows(),0.0);
@@ -80,7 +257,14 @@ void RMatrixSolver::solve(const RSparseMatrix &A, const RRVector &b, RRVector &x
     switch (this->matrixSolverConf.getType())
     {
         case RMatrixSolverConf::CG:
-            this->solveCG(A,y,x,P);
+            if (this->matrixSolverConf.getPipelined())
+            {
+                this->solvePipelinedCG(A,y,x,P);
+            }
+            else
+            {
+                this->solveCG(A,y,x,P);
+            }
             break;
         case RMatrixSolverConf::GMRES:
             this->solveGMRES(A,y,x,P);
@@ -90,16 +274,117 @@ void RMatrixSolver::solve(const RSparseMatrix &A, const RRVector &b, RRVector &x
     }
 
     x *= 1.0/equationScale;
-
-    this->iterationInfo.printFooter();
 }
 
-void RMatrixSolver::disableConvergenceLogFile(void)
+void RMatrixSolver::solveMixedPrecision(const RSparseMatrixCSR &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P)
 {
-    this->iterationInfo.setOutputFileName(QString());
+    // Maximum number of refinement steps.
+    const unsigned int nRefinements = 10;
+
+    unsigned int m = A.getNRows();
+    double cvgValue = this->matrixSolverConf.getSolverCvgValue();
+
+    RLogger::info("Mixed precision solver (single precision matrix and preconditioner)\n");
+
+    RSinglePrecisionMatrixOperator As(A);
+    P.convertToSinglePrecision();
+
+    // Residual is measured with the same matrix norm as used by inner solver.
+    double An = (this->matrixSolverConf.getType() == RMatrixSolverConf::CG) ? As.findFrobeniusNorm() : As.findNorm();
+    double bn = RRVector::norm(b);
+    // Equation scaling norm is computed once for all refinements.
+    double AsNorm = As.findNorm();
+    double error = 0.0;
+    double errorOld = 0.0;
+    unsigned int nInnerIterations = 0;
+
+    RLogger::info("Unknowns = %u\n",b.size());
+    RLogger::info("||A|| = %13e\n",AsNorm);
+    RLogger::info("||b|| = %13e\n",bn);
+
+    this->iterationInfo.printHeader(RMatrixSolverConf::getName(this->matrixSolverConf.getType()) + " - mixed precision");
+
+    // Inner solver iterations are not printed, only one line per refinement.
+    unsigned int outputFrequency = this->iterationInfo.getOutputFrequency();
+
+    x.resize(m,0.0);
+
+    RRVector r(m,0.0);
+    RRVector y(m,0.0);
+
+    for (unsigned int it=0;it<=nRefinements;it++)
+    {
+        double rn = 0.0;
+        double xn = 0.0;
+
+        // Residual is computed in double precision.
+#pragma omp parallel default(shared)
+        {
+            RSparseMatrixCSR::mlt(A,x,r);
+#pragma omp for reduction(+:rn,xn)
+            for (int64_t i=0;i<int64_t(m);i++)
+            {
+                r[i] = b[i] - r[i];
+                rn += r[i]*r[i];
+                xn += x[i]*x[i];
+            }
+        }
+
+        double norm = An * std::sqrt(xn) + bn;
+        if (std::abs(norm) < RConstants::eps)
+        {
+            norm = RConstants::eps;
+        }
+        error = std::sqrt(rn) / norm;
+
+        if (outputFrequency > 0)
+        {
+            RLogger::info("> Refinement %2u   |% 12e | Total iterations: %u\n",it,error,nInnerIterations);
+        }
+
+        if (error < cvgValue || it == nRefinements)
+        {
+            break;
+        }
+        if (it > 0 && error >= errorOld)
+        {
+            RLogger::warning("Mixed precision refinement does not reduce residual.\n");
+            break;
+        }
+        errorOld = error;
+
+        // Right hand side y = As*x + r, solution of As*x' = y is x' = x + As^-1*r.
+        // Solving for updated solution (instead of correction) keeps convergence criterion of inner
+        // solver relative to solution norm and previous solution serves as initial guess.
+#pragma omp parallel default(shared)
+        {
+            As.mlt(x,y);
+#pragma omp for
+            for (int64_t i=0;i<int64_t(m);i++)
+            {
+                y[i] += r[i];
+            }
+        }
+
+        this->iterationInfo.setOutputFrequency(0);
+        this->solveIterativeScaled(As,AsNorm,y,x,P);
+        this->iterationInfo.setOutputFrequency(outputFrequency);
+        nInnerIterations += this->iterationInfo.getIteration() + 1;
+    }
+
+    // Iteration info reports double precision residual of returned solution.
+    this->iterationInfo.setIteration(nInnerIterations);
+    this->iterationInfo.setError(error);
+
+    this->iterationInfo.printFooter();
+
+    if (error >= cvgValue)
+    {
+        RLogger::warning("Mixed precision solver did not converge, residual = %13e (convergence value = %13e).\n",error,cvgValue);
+    }
 }
 
-void RMatrixSolver::solveCG(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P)
+void RMatrixSolver::solveCG(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P)
 {
     unsigned int m = A.getNRows();
 
@@ -113,62 +398,53 @@ void RMatrixSolver::solveCG(const RSparseMatrix &A, const RRVector &b, RRVector
     p.fill(0.0);
     q.fill(0.0);
 
-    double An = 0.0;
+    double An = A.findFrobeniusNorm();
     double bn = 0.0;
-    double ro[] = {0.0,0.0};
-    double beta = 0.0;
-    double dot = 0.0;
-    std::vector< std::vector<unsigned int> > index(m);
+    double xn = 0.0;
+    double rn = 0.0;
+    double rz = 0.0;
+    double rzOld = 0.0;
+    double pq = 0.0;
 
 #pragma omp parallel default(shared)
     {
         // Compute initial residual.
-#pragma omp for reduction(+:An,bn)
+        A.mlt(x,q);
+#pragma omp for reduction(+:bn)
         for (int64_t i=0;i<int64_t(m);i++)
         {
-            r[i] = b[i];
+            r[i] = b[i] - q[i];
             bn = bn + (b[i]*b[i]);
-            index[i] = A.getRowIndexes(i);
-            for (unsigned int j=0;j<index[i].size();j++)
-            {
-                double value = A.getValue(i,j);
-                An = An + std::pow(value,2);
-                if (value != 0.0)
-                {
-                    if (x[index[i][j]] != 0.0)
-                    {
-                        r[i] -= value * x[index[i][j]];
-                    }
-                }
-            }
         }
-#pragma omp barrier
-#pragma omp master
+#pragma omp single
         {
-            An = std::sqrt(An);
             bn = std::sqrt(bn);
         }
 
         // Iterate and look for the solution
         for (unsigned int it=0;it<this->matrixSolverConf.getNOuterIterations();it++)
         {
-#pragma omp barrier
-#pragma omp master
+#pragma omp single
             {
                 this->iterationInfo.setIteration(it);
 
-                P.compute(r,z);
+                rz = 0.0;
+                pq = 0.0;
+                xn = 0.0;
+                rn = 0.0;
+            }
 
-                ro[0] = RRVector::dot(r,z);
+            // z = P^-1*r
+            P.compute(r,z);
 
-                if (it > 0)
-                {
-                    beta = ro[0] / ro[1];
-                    ro[1]= std::max(ro[1],RConstants::eps);
-                }
+#pragma omp for reduction(+:rz)
+            for (int64_t i=0;i<int64_t(m);i++)
+            {
+                rz = rz + r[i]*z[i];
             }
 
-#pragma omp barrier
+            double beta = (it > 0) ? rz / rzOld : 0.0;
+
 #pragma omp for
             for (int64_t i=0;i<int64_t(m);i++)
             {
@@ -183,108 +459,268 @@ void RMatrixSolver::solveCG(const RSparseMatrix &A, const RRVector &b, RRVector
             }
 
             // q = A*p
-#pragma omp master
-            dot = 0.0;
-#pragma omp barrier
-#pragma omp for reduction(+:dot)
+            A.mlt(p,q);
+#pragma omp for reduction(+:pq)
             for (int64_t i=0;i<int64_t(m);i++)
             {
-                q[i] = 0.0;
-                for (unsigned int j=0;j<index[i].size();j++)
-                {
-                    double value = A.getValue(i,j);
-                    if (value != 0.0)
-                    {
-                        q[i] += value * p[index[i][j]];
-                    }
-                }
-                dot = dot + p[i]*q[i];
+                pq = pq + p[i]*q[i];
             }
 
-#pragma omp master
+            double dot = pq;
+            if (dot > 0.0)
             {
-                if (dot > 0.0)
-                {
-                    dot = std::max(dot,RConstants::eps);
-                }
-                else if (dot < 0.0)
-                {
-                    dot = std::min(dot,-RConstants::eps);
-                }
-                else
+                dot = std::max(dot,RConstants::eps);
+            }
+            else if (dot < 0.0)
+            {
+                dot = std::min(dot,-RConstants::eps);
+            }
+            else
+            {
+                dot = RConstants::eps;
+            }
+
+            double alpha = rz / dot;
+
+            // x += alpha*p
+            // r -= alpha*q
+#pragma omp for reduction(+:xn,rn)
+            for (int64_t i=0;i<int64_t(m);i++)
+            {
+                x[i] += alpha * p[i];
+                r[i] -= alpha * q[i];
+                xn = xn + x[i]*x[i];
+                rn = rn + r[i]*r[i];
+            }
+
+#pragma omp single
+            {
+                rzOld = rz;
+
+                double norm = An * std::sqrt(xn) + bn;
+                if (std::abs(norm) < RConstants::eps)
                 {
-                    dot = RConstants::eps;
+                    norm = RConstants::eps;
                 }
 
-                double alpha = ro[0] / dot;
-                ro[1] = ro[0];
+                this->iterationInfo.setError(std::sqrt(rn) / norm);
+                this->iterationInfo.printIteration();
+            }
+
+            if (this->iterationInfo.hasConverged())
+            {
+                break;
+            }
+        }
+    }
+}
+
+void RMatrixSolver::solvePipelinedCG(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P)
+{
+    unsigned int m = A.getNRows();
+
+    RRVector r(m,0.0);
+    RRVector u(m,0.0);
+    RRVector w(m,0.0);
+    RRVector mv(m,0.0);
+    RRVector nv(m,0.0);
+    RRVector z(m,0.0);
+    RRVector q(m,0.0);
+    RRVector s(m,0.0);
+    RRVector p(m,0.0);
+
+    // Number of fused dot products: (r,u), (w,u), (r,r), (x,x).
+    const unsigned int nDots = 4;
+    // Each thread owns one cache line of partial sums.
+    const unsigned int partialStride = 8;
+    std::vector<double> partials(partialStride*std::max(omp_get_max_threads(),1),0.0);
+
+    double An = A.findFrobeniusNorm();
+    double bn = RRVector::norm(b);
+
+#pragma omp parallel default(shared)
+    {
+        unsigned int threadID = omp_get_thread_num();
+        unsigned int nThreads = omp_get_num_threads();
+
+        double alpha = 0.0;
+        double gammaOld = 0.0;
 
-                // x += alpha*p
-                // r -= alpha*q
-                for (unsigned int i=0;i<m;i++)
+        // r = b - A*x
+        A.mlt(x,r);
+#pragma omp for
+        for (int64_t i=0;i<int64_t(m);i++)
+        {
+            r[i] = b[i] - r[i];
+        }
+        // u = P^-1*r
+        P.compute(r,u);
+        // w = A*u
+        A.mlt(u,w);
+
+        // Vectors are accessed through raw pointers so that fused loop vectorizes (no bounds checks).
+        double *pr = r.data();
+        double *pu = u.data();
+        double *pw = w.data();
+        double *pz = z.data();
+        double *pq = q.data();
+        double *ps = s.data();
+        double *pp = p.data();
+        double *px = x.data();
+
+        double dots[nDots] = { 0.0, 0.0, 0.0, 0.0 };
+#pragma omp for nowait
+        for (int64_t i=0;i<int64_t(m);i++)
+        {
+            dots[0] += pr[i]*pu[i];
+            dots[1] += pw[i]*pu[i];
+            dots[2] += pr[i]*pr[i];
+            dots[3] += px[i]*px[i];
+        }
+        std::copy(dots,dots+nDots,partials.data()+threadID*partialStride);
+#pragma omp barrier
+
+        for (unsigned int it=0;it<this->matrixSolverConf.getNOuterIterations();it++)
+        {
+            // Partial sums are added in thread order so that all threads get identical values.
+            std::fill(dots,dots+nDots,0.0);
+            for (unsigned int t=0;t<nThreads;t++)
+            {
+                for (unsigned int k=0;k<nDots;k++)
                 {
-                    x[i] += alpha * p[i];
-                    r[i] -= alpha * q[i];
+                    dots[k] += partials[t*partialStride+k];
                 }
+            }
+            double gamma = dots[0];
+            double delta = dots[1];
 
-                double xn = RRVector::norm(x);
-                double rn = RRVector::norm(r);
+            // Implicit barrier at the end of single makes updated iteration info visible to all threads.
+#pragma omp single
+            {
+                this->iterationInfo.setIteration(it);
 
-                double norm = An * xn + bn;
+                double norm = An * std::sqrt(dots[3]) + bn;
                 if (std::abs(norm) < RConstants::eps)
                 {
-                    norm = RConstants::eps;;
+                    norm = RConstants::eps;
                 }
 
-                this->iterationInfo.setError(rn / norm);
+                this->iterationInfo.setError(std::sqrt(dots[2]) / norm);
                 this->iterationInfo.printIteration();
             }
 
-#pragma omp barrier
             if (this->iterationInfo.hasConverged())
             {
                 break;
             }
+
+            // m = P^-1*w
+            P.compute(w,mv);
+
+            // n = A*m
+            A.mlt(mv,nv);
+
+            double beta = (it > 0) ? gamma / gammaOld : 0.0;
+            double dot = (it > 0) ? (delta - beta * gamma / alpha) : delta;
+            if (dot > 0.0)
+            {
+                dot = std::max(dot,RConstants::eps);
+            }
+            else if (dot < 0.0)
+            {
+                dot = std::min(dot,-RConstants::eps);
+            }
+            else
+            {
+                dot = RConstants::eps;
+            }
+            alpha = gamma / dot;
+            gammaOld = gamma;
+
+            const double *pm = mv.data();
+            const double *pn = nv.data();
+
+            std::fill(dots,dots+nDots,0.0);
+#pragma omp for nowait
+            for (int64_t i=0;i<int64_t(m);i++)
+            {
+                pz[i] = pn[i] + beta * pz[i];
+                pq[i] = pm[i] + beta * pq[i];
+                ps[i] = pw[i] + beta * ps[i];
+                pp[i] = pu[i] + beta * pp[i];
+                px[i] += alpha * pp[i];
+                pr[i] -= alpha * ps[i];
+                pu[i] -= alpha * pq[i];
+                pw[i] -= alpha * pz[i];
+                dots[0] += pr[i]*pu[i];
+                dots[1] += pw[i]*pu[i];
+                dots[2] += pr[i]*pr[i];
+                dots[3] += px[i]*px[i];
+            }
+            std::copy(dots,dots+nDots,partials.data()+threadID*partialStride);
+            // All four dot products are fused into one pass and one reduction.
+#pragma omp barrier
         }
     }
 }
 
-void RMatrixSolver::solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P)
+void RMatrixSolver::solveGMRES(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P)
 {
     uint mA = A.getNRows();
     uint nouter = this->matrixSolverConf.getNOuterIterations();
-    uint ninner = this->matrixSolverConf.getNInnerIterations();
+    uint ninner = std::max(this->matrixSolverConf.getNInnerIterations(),1u);
+    // Restart length is increased up to this value if convergence stagnates.
+    uint ninnerMax = std::max(std::min(4*ninner,mA),ninner);
 
     RRVector ro(mA,0.0);
     RRVector w(mA,0.0);
-    RRVector p(ninner+1,0.0);
-    RRVector y(ninner,0.0);
-    RRVector c(ninner,0.0);
-    RRVector s(ninner,0.0);
+    RRVector p(ninnerMax+1,0.0);
+    RRVector y(ninnerMax,0.0);
+    RRVector c(ninnerMax,0.0);
+    RRVector s(ninnerMax,0.0);
+    // Krylov vectors and preconditioned vectors are allocated for current restart length only.
     RRMatrix v(ninner+1,mA,0.0);
-    RRMatrix z(ninner+1,mA,0.0);
-    RRMatrix h(ninner+1,ninner,0.0);
+    RRMatrix z(ninner,mA,0.0);
+    RRMatrix h(ninnerMax+1,ninnerMax,0.0);
 
-    std::vector< std::vector<uint> > indexes;
-    for (uint i=0;i<mA;i++)
-    {
-        indexes.push_back(A.getRowIndexes(i));
-    }
+    // Each thread owns cache-line aligned block of partial projections.
+    const uint partialStride = 8*((ninnerMax+2+7)/8);
+    std::vector<double> partials(partialStride*std::max(omp_get_max_threads(),1),0.0);
 
     double An = A.findNorm();
     double bn = RRVector::norm(b);
+    double cvgValue = this->matrixSolverConf.getSolverCvgValue();
 
     double beta = 0.0;
+    double betaOld = 0.0;
     double xn = 0.0;
+    double norm = 0.0;
+    uint nRestart = ninner;
+
+    // Assembled matrices weight solution by number of values in each column.
+    RRVector xWeights;
+    A.findSolutionNormWeights(xWeights);
+    bool weightedSolutionNorm = !xWeights.empty();
 
 #pragma omp parallel default(shared)
     {
+        uint threadID = omp_get_thread_num();
+        uint nThreads = omp_get_num_threads();
+        // Rows of Krylov vectors processed by this thread.
+        int64_t jb = (int64_t(mA)*threadID)/nThreads;
+        int64_t je = (int64_t(mA)*(threadID+1))/nThreads;
+
+        // Projections and norm found by reduction (identical in all threads).
+        std::vector<double> hw(ninnerMax+2,0.0);
+        // Column of Hessenberg matrix.
+        std::vector<double> hc(ninnerMax+1,0.0);
+
         uint iti = 0;
 
         // Outer iteration
         for (uint ito=0;ito<nouter;ito++)
         {
-#pragma omp master
+#pragma omp single
             {
                 this->iterationInfo.setIteration(ito);
 
@@ -295,35 +731,43 @@ void RMatrixSolver::solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVect
                 beta = 0.0;
                 xn = 0.0;
             }
+            A.mlt(x,ro);
 #pragma omp for reduction(+:xn,beta)
             for (int64_t i=0;i<int64_t(mA);i++)
             {
-                ro[i] = b[i];
-                double lxn = 0.0;
-                for (uint j=0;j<indexes[i].size();j++)
-                {
-                    ro[i] -= A.getValue(i,j) * x[indexes[i][j]];
-                    lxn += std::pow(x[indexes[i][j]],2);
-                }
-                xn += lxn;
+                ro[i] = b[i] - ro[i];
+                xn += (weightedSolutionNorm ? xWeights[i] : 1.0) * x[i] * x[i];
                 beta += std::pow(ro[i],2);
             }
 
-#pragma omp master
+#pragma omp single
             {
                 xn = std::sqrt(xn);
                 beta = std::sqrt(beta);
 
                 // Check convergence
-                double norm = An * xn + bn;
+                norm = An * xn + bn;
                 if (std::fabs(norm) < RConstants::eps)
                 {
                     norm = RConstants::eps;
                 }
                 this->iterationInfo.setError(beta / norm);
                 this->iterationInfo.printIteration();
+
+                // Residual reduced by less than cos(8 deg) over whole restart cycle - increase restart length.
+                if (ito > 0 && !this->iterationInfo.hasConverged() && nRestart < ninnerMax && beta > 0.99 * betaOld)
+                {
+                    nRestart = std::min(2*nRestart,ninnerMax);
+                    v.resize(nRestart+1,mA,0.0);
+                    z.resize(nRestart,mA,0.0);
+                    RLogger::info("GMRES restart length increased to %u\n",nRestart);
+                }
+                betaOld = beta;
+
+                // Initial rhs define p
+                p.fill(0.0);
+                p[0] = beta;
             }
-#pragma omp barrier
             if (this->iterationInfo.hasConverged())
             {
                 break;
@@ -335,63 +779,55 @@ void RMatrixSolver::solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVect
             {
                 v[0][i] = (beta == 0.0) ? 0.0 : ro[i] / beta;
             }
-#pragma omp master
-            {
-                // Initial rhs define p
-                p.fill(0.0);
-                p[0] = beta;
-            }
             // Inner iteration
-            for (iti=0;iti<ninner;iti++)
+            for (iti=0;iti<nRestart;iti++)
             {
-#pragma omp barrier
-#pragma omp master
-                {
-                    // Preconditioning
-                    P.compute(v[iti],z[iti]);
-//                    RLogger::warning("%u v %13g\n",iti,RRVector::norm(v[iti])-1.0);
-//                    RLogger::warning("%u z %13g\n",iti,RRVector::norm(z[iti]));
-                }
-#pragma omp barrier
+                // Flexible preconditioning - preconditioned vectors are kept so that preconditioner may vary.
+                P.compute(v[iti],z[iti]);
                 // A multiplied by the last krylov vector at present
-#pragma omp for
-                for (int64_t i=0;i<int64_t(mA);i++)
+                A.mlt(z[iti],w);
+                // Krylov vectors are accessed through raw pointers so that loops vectorize (no bounds checks).
+                double *pw = w.data();
+
+                // Classical Gram-Schmidt - projections to all krylov vectors and norm of w in one reduction
+                RMatrixSolver::findProjections(v,iti+1,pw,jb,je,partials,partialStride,threadID,nThreads,hw);
+                double wn0 = hw[iti+1];
+                double wn = wn0;
+                for (uint i=0;i<=iti;i++)
                 {
-                    w[i] = 0.0;
-                    for (uint j=0;j<indexes[i].size();j++)
-                    {
-                        w[i] += A.getValue(i,j) * z[iti][indexes[i][j]];
-                    }
+                    hc[i] = hw[i];
+                    wn -= hw[i] * hw[i];
                 }
-#pragma omp barrier
-                // of potential krylov vector with existing subtract dot prod to get orthogonal
-#pragma omp master
+                RMatrixSolver::subtractProjections(v,iti+1,hw,pw,jb,je);
+
+                // Selective reorthogonalization - repeat projection if norm of w dropped below 1/sqrt(2) of its original value (squared norms compared)
+                if (wn < 0.5 * wn0)
                 {
+                    RMatrixSolver::findProjections(v,iti+1,pw,jb,je,partials,partialStride,threadID,nThreads,hw);
+                    wn = hw[iti+1];
                     for (uint i=0;i<=iti;i++)
                     {
-                        for (uint j=0;j<mA;j++)
-                        {
-                            h[i][iti] += w[j] * v[i][j];
-                        }
-                        for (uint j=0;j<mA;j++)
-                        {
-                            w[j] -= h[i][iti] * v[i][j];
-                        }
+                        hc[i] += hw[i];
+                        wn -= hw[i] * hw[i];
                     }
-                    // Finding norm of the krylov vector
-                    h[iti+1][iti] = RRVector::norm(w);
-//                    RLogger::warning("%u w %13g\n",iti,RRVector::norm(w));
+                    RMatrixSolver::subtractProjections(v,iti+1,hw,pw,jb,je);
                 }
-#pragma omp barrier
+                wn = std::sqrt(std::max(wn,0.0));
+                hc[iti+1] = wn;
+
                 // New krylov vector formed
-#pragma omp for
-                for (int64_t i=0;i<int64_t(mA);i++)
+                double *pvNew = v[iti+1].data();
+                double wnInv = (wn == 0.0) ? 0.0 : 1.0 / wn;
+                for (int64_t i=jb;i<je;i++)
                 {
-                    v[iti+1][i] = (h[iti+1][iti] == 0.0) ? 0.0 : w[i] / h[iti+1][iti];
+                    pvNew[i] = pw[i] * wnInv;
                 }
-#pragma omp barrier
-#pragma omp master
+#pragma omp single
                 {
+                    for (uint i=0;i<=iti+1;i++)
+                    {
+                        h[i][iti] = hc[i];
+                    }
                     for (uint i=1;i<=iti;i++)
                     {
                         double hsave = h[i-1][iti];
@@ -401,7 +837,6 @@ void RMatrixSolver::solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVect
 
                     double g = std::sqrt(  h[iti][iti]   * h[iti][iti]
                                          + h[iti+1][iti] * h[iti+1][iti]);
-//                    RLogger::warning("%u g %13g\n",iti,g);
                     if (g == 0.0)
                     {
                         c[iti] = s[iti] = 0.0;
@@ -416,17 +851,16 @@ void RMatrixSolver::solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVect
                     p[iti+1]      = -s[iti]*p[iti];
                     p[iti]        =  c[iti]*p[iti];
                 }
-#pragma omp barrier
-                if (fabs(p[iti+1]) < beta*1.0e-4)
+                // Estimated residual satisfies convergence criterion
+                if (std::fabs(p[iti+1]) < cvgValue * norm)
                 {
                     iti++;
                     break;
                 }
             } // inner iteration
 
-#pragma omp barrier
             // Backward substitution
-#pragma omp master
+#pragma omp single
             {
                 y[iti-1] = (h[iti-1][iti-1] == 0.0) ? 0.0 : p[iti-1] / h[iti-1][iti-1];
                 for (int i=iti-2;i>=0;i--)
@@ -436,11 +870,9 @@ void RMatrixSolver::solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVect
                         p[i] -= y[j] * h[i][j];
                     }
                     y[i] = (h[i][i] == 0.0) ? 0.0 : p[i] / h[i][i];
-//                    RLogger::warning("%u %u y %13g\n",iti,i,y[i]);
                 }
             }
 
-#pragma omp barrier
             // Update prod
 #pragma omp for
             for (int64_t i=0;i<int64_t(mA);i++)
@@ -453,3 +885,111 @@ void RMatrixSolver::solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVect
         } // outer iteration
     }
 }
+
+void RMatrixSolver::findProjections(const RRMatrix &v, uint nv, const double *pw, int64_t jb, int64_t je, std::vector<double> &partials, uint partialStride, uint threadID, uint nThreads, std::vector<double> &hw)
+{
+    // Previous reduction must be finished by all threads before partial sums are overwritten.
+#pragma omp barrier
+
+    double *pPartial = partials.data() + threadID*partialStride;
+    for (uint k=0;k<nv;k++)
+    {
+        const double *pv = v[k].data();
+        double value = 0.0;
+        for (int64_t j=jb;j<je;j++)
+        {
+            value += pv[j] * pw[j];
+        }
+        pPartial[k] = value;
+    }
+    double value = 0.0;
+    for (int64_t j=jb;j<je;j++)
+    {
+        value += pw[j] * pw[j];
+    }
+    pPartial[nv] = value;
+
+#pragma omp barrier
+
+    // Partial sums are added in thread order so that all threads get identical values.
+    std::fill(hw.begin(),hw.begin()+nv+1,0.0);
+    for (uint t=0;t<nThreads;t++)
+    {
+        for (uint k=0;k<=nv;k++)
+        {
+            hw[k] += partials[t*partialStride+k];
+        }
+    }
+}
+
+void RMatrixSolver::subtractProjections(const RRMatrix &v, uint nv, const std::vector<double> &hw, double *pw, int64_t jb, int64_t je)
+{
+    for (uint k=0;k<nv;k++)
+    {
+        const double *pv = v[k].data();
+        double hk = hw[k];
+        for (int64_t j=jb;j<je;j++)
+        {
+            pw[j] -= hk * pv[j];
+        }
+    }
+}
+
+void RMatrixSolver::prepareBlockMatrix(const RSparseMatrixCSR &A, unsigned int blockSize)
+{
+    if (this->blockMatrix.getBlockSize() == blockSize &&
+        this->blockMatrix.getNRows() == A.getNRows() &&
+        this->blockMatrixRowBlockIndexes == this->rowBlockIndexes &&
+        this->blockMatrixRowPointers == A.getRowPointers() &&
+        this->blockMatrixColumnIndexes == A.getColumnIndexes())
+    {
+        this->blockMatrix.updateValues(A);
+        return;
+    }
+
+    this->blockMatrix.build(A,blockSize,this->rowBlockIndexes);
+    this->blockMatrixRowPointers = A.getRowPointers();
+    this->blockMatrixColumnIndexes = A.getColumnIndexes();
+    this->blockMatrixRowBlockIndexes = this->rowBlockIndexes;
+}
+
+void RMatrixSolver::solveDirect(const RSparseMatrixCSR &A, const RRVector &b, RRVector &x)
+{
+    RSparseDirectSolver &sparseDirectSolver = this->pExternalDirectSolver ? (*this->pExternalDirectSolver) : this->directSolver;
+    bool symmetric = (this->matrixSolverConf.getType() == RMatrixSolverConf::CG);
+
+    RLogger::info("Unknowns = %u\n",b.getNRows());
+    RLogger::info("Sparse direct solver - %s factorization\n",symmetric ? "Cholesky" : "LU");
+
+    sparseDirectSolver.factorize(A,symmetric);
+    sparseDirectSolver.solve(b,x);
+
+    RRVector r;
+    double residual = findRelativeResidual(A,b,x,r);
+
+    RLogger::info("Relative residual = %13e\n",residual);
+
+    if (sparseDirectSolver.getNPerturbedPivots() == 0)
+    {
+        return;
+    }
+
+    // Perturbed pivots make factorization inexact - refine solution x += (LU)^-1*(b - A*x).
+    double cvgValue = this->matrixSolverConf.getSolverCvgValue();
+    RRVector dx;
+    for (uint i=0;i<directSolverMaxRefinements && residual > cvgValue;i++)
+    {
+        sparseDirectSolver.solve(r,dx);
+        for (uint j=0;j<x.size();j++)
+        {
+            x[j] += dx[j];
+        }
+        residual = findRelativeResidual(A,b,x,r);
+        RLogger::info("Iterative refinement %u: relative residual = %13e\n",i+1,residual);
+    }
+
+    if (residual > cvgValue)
+    {
+        RLogger::warning("Sparse direct solver did not reach requested accuracy (relative residual = %13e > %13e).\n",residual,cvgValue);
+    }
+}
@@ -0,0 +1,169 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsingleprecisionmatrixoperator.cpp                       *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Single precision matrix operator class definition   *
+ *********************************************************************/
+
+#include <cfloat>
+#include <cmath>
+
+#include "rsingleprecisionmatrixoperator.h"
+
+void RSinglePrecisionMatrixOperator::_init(const RSinglePrecisionMatrixOperator *pSinglePrecisionMatrixOperator)
+{
+    if (pSinglePrecisionMatrixOperator)
+    {
+        this->pMatrix = pSinglePrecisionMatrixOperator->pMatrix;
+        this->values = pSinglePrecisionMatrixOperator->values;
+    }
+}
+
+RSinglePrecisionMatrixOperator::RSinglePrecisionMatrixOperator(const RSparseMatrixCSR &matrix)
+    : pMatrix(&matrix)
+{
+    this->_init();
+
+    const std::vector<double> &matrixValues = matrix.getValues();
+
+    if (!RSinglePrecisionMatrixOperator::isInRange(matrixValues))
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Matrix values are out of single precision range.");
+    }
+
+    this->values.resize(matrixValues.size());
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(matrixValues.size());i++)
+    {
+        this->values[i] = float(matrixValues[i]);
+    }
+}
+
+RSinglePrecisionMatrixOperator::RSinglePrecisionMatrixOperator(const RSinglePrecisionMatrixOperator &singlePrecisionMatrixOperator)
+    : RMatrixOperator()
+{
+    this->_init(&singlePrecisionMatrixOperator);
+}
+
+RSinglePrecisionMatrixOperator::~RSinglePrecisionMatrixOperator()
+{
+}
+
+RSinglePrecisionMatrixOperator &RSinglePrecisionMatrixOperator::operator =(const RSinglePrecisionMatrixOperator &singlePrecisionMatrixOperator)
+{
+    this->_init(&singlePrecisionMatrixOperator);
+    return (*this);
+}
+
+uint RSinglePrecisionMatrixOperator::getNRows(void) const
+{
+    return this->pMatrix->getNRows();
+}
+
+void RSinglePrecisionMatrixOperator::mlt(const RRVector &x, RRVector &y) const
+{
+    uint nRows = this->pMatrix->getNRows();
+
+#pragma omp single
+    y.resize(nRows,0.0);
+
+    const uint *pRow = this->pMatrix->getRowPointers().data();
+    const uint *pIndex = this->pMatrix->getColumnIndexes().data();
+    const float *pValue = this->values.data();
+    const double *pX = x.data();
+    double *pY = y.data();
+
+#pragma omp for
+    for (int64_t i=0;i<int64_t(nRows);i++)
+    {
+        double value = 0.0;
+        for (uint k=pRow[i];k<pRow[i+1];k++)
+        {
+            value += double(pValue[k]) * pX[pIndex[k]];
+        }
+        pY[i] = value;
+    }
+}
+
+void RSinglePrecisionMatrixOperator::findDiagonal(RRVector &d) const
+{
+    uint nRows = this->pMatrix->getNRows();
+
+    d.resize(nRows);
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nRows);i++)
+    {
+        uint position = 0;
+        d[i] = this->pMatrix->findPosition(uint(i),uint(i),position) ? double(this->values[position]) : 0.0;
+    }
+}
+
+double RSinglePrecisionMatrixOperator::findNorm(void) const
+{
+    uint nRows = this->pMatrix->getNRows();
+    double norm = 0.0;
+
+#pragma omp parallel for default(shared) reduction(+:norm)
+    for (int64_t i=0;i<int64_t(nRows);i++)
+    {
+        double rowSum = 0.0;
+        for (uint k=this->pMatrix->getRowBegin(uint(i));k<this->pMatrix->getRowEnd(uint(i));k++)
+        {
+            rowSum += double(this->values[k]);
+        }
+        norm += rowSum * rowSum;
+    }
+
+    return std::sqrt(norm);
+}
+
+double RSinglePrecisionMatrixOperator::findFrobeniusNorm(void) const
+{
+    uint nRows = this->pMatrix->getNRows();
+    double norm = 0.0;
+
+#pragma omp parallel for default(shared) reduction(+:norm)
+    for (int64_t i=0;i<int64_t(nRows);i++)
+    {
+        for (uint k=this->pMatrix->getRowBegin(uint(i));k<this->pMatrix->getRowEnd(uint(i));k++)
+        {
+            double value = double(this->values[k]);
+            norm += value*value;
+        }
+    }
+
+    return std::sqrt(norm);
+}
+
+void RSinglePrecisionMatrixOperator::findSolutionNormWeights(RRVector &weights) const
+{
+    weights.resize(this->pMatrix->getNRows());
+    weights.fill(0.0);
+
+    for (uint k=0;k<this->pMatrix->getNValues();k++)
+    {
+        weights[this->pMatrix->getColumnIndex(k)] += 1.0;
+    }
+}
+
+bool RSinglePrecisionMatrixOperator::isInRange(const std::vector<double> &values)
+{
+    uint nOutOfRange = 0;
+
+#pragma omp parallel for default(shared) reduction(+:nOutOfRange)
+    for (int64_t i=0;i<int64_t(values.size());i++)
+    {
+        double value = std::abs(values[i]);
+        if (value > double(FLT_MAX) || (value != 0.0 && value < double(FLT_MIN)))
+        {
+            nOutOfRange++;
+        }
+    }
+
+    return (nOutOfRange == 0);
+}
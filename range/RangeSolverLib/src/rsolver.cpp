@@ -239,6 +239,7 @@ bool RSolver::runProblemTask(const RProblemTaskItem &problemTaskItem, uint taskI
             converged = this->solvers[problemTaskItem.getProblemType()]->hasConverged();
             if (this->solvers[problemTaskItem.getProblemType()]->getMeshChanged())
             {
+                this->sharedData.getGeometryCache().invalidate();
                 RProblemTypeMask problemTypeMask = this->pModel->getProblemTaskTree().getProblemTypeMask();
                 std::vector<RProblemType> problemTypes = RProblem::getTypes(problemTypeMask);
                 for (uint i=0;i<problemTypes.size();i++)
@@ -152,73 +152,87 @@ void RSolverAcoustic::prepare(void)
     this->b.resize(this->nodeBook.getNEnabled());
     this->x.resize(this->nodeBook.getNEnabled());
 
-    this->A.clear();
+    this->matrixFree = this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG).getMatrixFree();
+    if (this->matrixFree)
+    {
+        // Matrix is symmetric (solved by CG).
+        this->prepareElementMatrixOperator(true);
+    }
+    else
+    {
+        this->prepareMatrixPattern();
+    }
     this->b.fill(0.0);
     this->x.fill(0.0);
 
+    const RElementGeometryCache &geometryCache = this->getGeometryCache();
+
     // Prepare point elements.
     for (uint i=0;i<this->pModel->getNPoints();i++)
     {
         RPoint &point = this->pModel->getPoint(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(point);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(point.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = point.get(j);
-
-                if (!this->computableElements[elementID])
+                try
                 {
-                    continue;
-                }
+                    uint elementID = elementIDs[j];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ce(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                Me.fill(0.0);
-                Ce.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRSmallMatrix Me(element.size(),element.size());
+                    RRSmallMatrix Ce(element.size(),element.size());
+                    RRSmallMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    Me.fill(0.0);
+                    Ce.fill(0.0);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                    for (uint m=0;m<element.size();m++)
+                    for (uint k=0;k<nInp;k++)
                     {
-                        for (uint n=0;n<element.size();n++)
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        RRMatrix J, Rt;
+                        double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+
+                        for (uint m=0;m<element.size();m++)
                         {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
+                            for (uint n=0;n<element.size();n++)
                             {
-                                Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * point.getVolume();
+                                // Mass
+                                if (this->pModel->getTimeSolver().getEnabled())
+                                {
+                                    Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * point.getVolume();
+                                }
                             }
+                            // Velocity / force
+                            fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                         }
-                        // Velocity / force
-                        fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -233,77 +247,72 @@ void RSolverAcoustic::prepare(void)
     {
         RLine &line = this->pModel->getLine(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(line);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(line.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = line.get(j);
-
-                if (!this->computableElements[elementID])
+                try
                 {
-                    continue;
-                }
+                    uint elementID = elementIDs[j];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ce(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),1);
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                Me.fill(0.0);
-                Ce.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRSmallMatrix Me(element.size(),element.size());
+                    RRSmallMatrix Ce(element.size(),element.size());
+                    RRSmallMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
+                    RRSmallMatrix B(element.size(),1);
 
-                double c = std::sqrt(this->elementElasticityModulus[elementID]/this->elementDensity[elementID]);
+                    Me.fill(0.0);
+                    Ce.fill(0.0);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    double c = std::sqrt(this->elementElasticityModulus[elementID]/this->elementDensity[elementID]);
 
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    for (uint k=0;k<nInp;k++)
                     {
-                        B[m][0] += dN[m][0]*J[0][0];
-                    }
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        double detJ = geometryCache.findShapeDerivatives(elementID,k,B);
 
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        for (uint n=0;n<element.size();n++)
+                        for (uint m=0;m<element.size();m++)
                         {
-                            // Stiffness
-                            Ke[m][n] += (B[m][0]*B[n][0]) * line.getCrossArea() * c * c * detJ * shapeFunc.getW();
-
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
+                            for (uint n=0;n<element.size();n++)
                             {
-                                Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * line.getCrossArea();
+                                // Stiffness
+                                Ke[m][n] += (B[m][0]*B[n][0]) * line.getCrossArea() * c * c * detJ * shapeFunc.getW();
+
+                                // Mass
+                                if (this->pModel->getTimeSolver().getEnabled())
+                                {
+                                    Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * line.getCrossArea();
+                                }
                             }
+                            // Velocity / force
+                            fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                         }
-                        // Velocity / force
-                        fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -318,78 +327,72 @@ void RSolverAcoustic::prepare(void)
     {
         RSurface &surface = this->pModel->getSurface(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(surface);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(surface.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = surface.get(j);
-
-                if (!this->computableElements[elementID])
+                try
                 {
-                    continue;
-                }
+                    uint elementID = elementIDs[j];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ce(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),2);
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                Me.fill(0.0);
-                Ce.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRSmallMatrix Me(element.size(),element.size());
+                    RRSmallMatrix Ce(element.size(),element.size());
+                    RRSmallMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
+                    RRSmallMatrix B(element.size(),2);
 
-                double c = std::sqrt(this->elementElasticityModulus[elementID]/this->elementDensity[elementID]);
+                    Me.fill(0.0);
+                    Ce.fill(0.0);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    double c = std::sqrt(this->elementElasticityModulus[elementID]/this->elementDensity[elementID]);
 
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    for (uint k=0;k<nInp;k++)
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
-                    }
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        double detJ = geometryCache.findShapeDerivatives(elementID,k,B);
 
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        for (uint n=0;n<element.size();n++)
+                        for (uint m=0;m<element.size();m++)
                         {
-                            // Stiffness
-                            Ke[m][n] += (B[m][0]*B[n][0]+B[m][1]*B[n][1]) * surface.getThickness() * c * c * detJ * shapeFunc.getW();
-
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
+                            for (uint n=0;n<element.size();n++)
                             {
-                                Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * surface.getThickness();
+                                // Stiffness
+                                Ke[m][n] += (B[m][0]*B[n][0]+B[m][1]*B[n][1]) * surface.getThickness() * c * c * detJ * shapeFunc.getW();
+
+                                // Mass
+                                if (this->pModel->getTimeSolver().getEnabled())
+                                {
+                                    Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * surface.getThickness();
+                                }
                             }
+                            // Velocity / force
+                            fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                         }
-                        // Velocity / force
-                        fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -404,86 +407,79 @@ void RSolverAcoustic::prepare(void)
     {
         RVolume &volume = this->pModel->getVolume(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(volume);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = volume.get(j);
-
-                if (!this->computableElements[elementID])
+                #pragma omp flush (abort)
+                if (abort)
                 {
                     continue;
                 }
+                try
+                {
+                    uint elementID = elementIDs[j];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ce(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),3);
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                Me.fill(0.0);
-                Ce.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRSmallMatrix Me(element.size(),element.size());
+                    RRSmallMatrix Ce(element.size(),element.size());
+                    RRSmallMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
+                    RRSmallMatrix B(element.size(),3);
 
-                double c = std::sqrt(this->elementElasticityModulus[elementID]/this->elementDensity[elementID]);
+                    Me.fill(0.0);
+                    Ce.fill(0.0);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                // Conduction
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    double c = std::sqrt(this->elementElasticityModulus[elementID]/this->elementDensity[elementID]);
 
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    // Conduction
+                    for (uint k=0;k<nInp;k++)
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
-                    }
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        double detJ = geometryCache.findShapeDerivatives(elementID,k,B);
 
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        for (uint n=0;n<element.size();n++)
+                        for (uint m=0;m<element.size();m++)
                         {
-                            // Stiffness
-                            Ke[m][n] += (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2])
-                                     * c * c
-                                     * detJ
-                                     * shapeFunc.getW();
-
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
+                            for (uint n=0;n<element.size();n++)
                             {
-                                Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW();
+                                // Stiffness
+                                Ke[m][n] += (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2])
+                                         * c * c
+                                         * detJ
+                                         * shapeFunc.getW();
+
+                                // Mass
+                                if (this->pModel->getTimeSolver().getEnabled())
+                                {
+                                    Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW();
+                                }
                             }
                         }
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -499,8 +495,17 @@ void RSolverAcoustic::solve(void)
     try
     {
         RLogger::indent();
-        RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        const RMatrixSolverConf &matrixSolverConf = this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG);
+        RMatrixSolver matrixSolver(matrixSolverConf);
+        matrixSolver.setDirectSolver(&this->directSolver);
+        if (this->matrixFree)
+        {
+            matrixSolver.solve(this->elementMatrixOperator,this->b,this->x,matrixSolverConf.getPreconditionerType());
+        }
+        else
+        {
+            matrixSolver.solve(this->A,this->b,this->x,matrixSolverConf.getPreconditionerType(),1);
+        }
         RLogger::unindent();
     }
     catch (RError error)
@@ -653,6 +658,8 @@ void RSolverAcoustic::processAcousticParticleVelocity(void)
     this->elementAcousticParticleVelocity.y.resize(this->pModel->getNElements(),0.0);
     this->elementAcousticParticleVelocity.z.resize(this->pModel->getNElements(),0.0);
 
+    const RElementGeometryCache &geometryCache = this->getGeometryCache();
+
     // Process line elements.
     for (uint i=0;i<this->pModel->getNLines();i++)
     {
@@ -680,6 +687,7 @@ void RSolverAcoustic::processAcousticParticleVelocity(void)
                 R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
                 uint nInp = RElement::getNIntegrationPoints(element.getType());
                 RRVector B(element.size());
+                RRSmallMatrix Bk, R;
 
                 RR3Vector ve(0.0,0.0,0.0);
 
@@ -689,16 +697,14 @@ void RSolverAcoustic::processAcousticParticleVelocity(void)
 
                     for (uint k=0;k<nInp;k++)
                     {
-                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                        const RRMatrix &dN = shapeFunc.getDN();
-                        RRMatrix J, Rt;
-                        double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                        double detJ = geometryCache.findShapeDerivatives(elementID,k,Bk);
+                        geometryCache.findRotation(elementID,R);
 
                         if (line.getCrossArea() != 0.0)
                         {
-                            for (uint m=0;m<dN.getNRows();m++)
+                            for (uint m=0;m<element.size();m++)
                             {
-                                B[m] += dN[m][0] * J[0][0] * detJ / double(nInp);
+                                B[m] += Bk[m][0] * detJ / double(nInp);
                             }
                         }
                     }
@@ -710,10 +716,6 @@ void RSolverAcoustic::processAcousticParticleVelocity(void)
                         vi -= B[k] * this->nodeVelocityPotential[nodeID];
                     }
 
-                    RRMatrix R;
-                    RRVector t;
-                    this->pModel->getElement(elementID).findTransformationMatrix(this->pModel->getNodes(),R,t);
-
                     ve[0] += R[0][0]*vi;
                     ve[1] += R[1][0]*vi;
                     ve[2] += R[2][0]*vi;
@@ -764,7 +766,8 @@ void RSolverAcoustic::processAcousticParticleVelocity(void)
                 const RElement &element = this->pModel->getElement(elementID);
                 R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
                 uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix B(element.size(),2);
+                RRSmallMatrix B(element.size(),2);
+                RRSmallMatrix Bk, R;
 
                 RR3Vector ve(0.0,0.0,0.0);
 
@@ -775,17 +778,15 @@ void RSolverAcoustic::processAcousticParticleVelocity(void)
 
                     for (uint k=0;k<nInp;k++)
                     {
-                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                        const RRMatrix &dN = shapeFunc.getDN();
-                        RRMatrix J, Rt;
-                        double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                        double detJ = geometryCache.findShapeDerivatives(elementID,k,Bk);
+                        geometryCache.findRotation(elementID,R);
 
                         if (surface.getThickness() != 0.0)
                         {
-                            for (uint m=0;m<dN.getNRows();m++)
+                            for (uint m=0;m<element.size();m++)
                             {
-                                B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]) * detJ / double(nInp);
-                                B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]) * detJ / double(nInp);
+                                B[m][0] += Bk[m][0] * detJ / double(nInp);
+                                B[m][1] += Bk[m][1] * detJ / double(nInp);
                             }
                         }
                     }
@@ -798,10 +799,6 @@ void RSolverAcoustic::processAcousticParticleVelocity(void)
                         vj -= B[k][1] * this->nodeVelocityPotential[nodeID];
                     }
 
-                    RRMatrix R;
-                    RRVector t;
-                    this->pModel->getElement(elementID).findTransformationMatrix(this->pModel->getNodes(),R,t);
-
                     ve[0] += R[0][0]*vi + R[0][1]*vj;
                     ve[1] += R[1][0]*vi + R[1][1]*vj;
                     ve[2] += R[2][0]*vi + R[2][1]*vj;
@@ -852,22 +849,20 @@ void RSolverAcoustic::processAcousticParticleVelocity(void)
                 const RElement &element = this->pModel->getElement(elementID);
                 R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
                 uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix B(element.size(),3);
+                RRSmallMatrix B(element.size(),3);
+                RRSmallMatrix Bk;
                 RR3Vector ve(0.0,0.0,0.0);
 
                 for (uint k=0;k<nInp;k++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    double detJ = geometryCache.findShapeDerivatives(elementID,k,Bk);
 
                     B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    for (uint m=0;m<element.size();m++)
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]) * detJ / double(nInp);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]) * detJ / double(nInp);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]) * detJ / double(nInp);
+                        B[m][0] += Bk[m][0] * detJ / double(nInp);
+                        B[m][1] += Bk[m][1] * detJ / double(nInp);
+                        B[m][2] += Bk[m][2] * detJ / double(nInp);
                     }
                 }
 
@@ -1225,7 +1220,7 @@ std::vector<RR3Vector> RSolverAcoustic::findAbsorbingBoundaryNormals(const std::
     return normals;
 }
 
-void RSolverAcoustic::assemblyMatrix(uint elementID, const RRMatrix &Me, const RRMatrix &Ce, const RRMatrix &Ke, const RRVector &fe)
+void RSolverAcoustic::assemblyMatrix(uint elementID, const RRSmallMatrix &Me, const RRSmallMatrix &Ce, const RRSmallMatrix &Ke, const RRVector &fe)
 {
     double alpha = 1.0 / 2.0;
     double beta = this->pModel->getTimeSolver().getTimeMarchApproximationCoefficient() / 2.0;
@@ -1233,7 +1228,7 @@ void RSolverAcoustic::assemblyMatrix(uint elementID, const RRMatrix &Me, const R
 
     const RElement &element = this->pModel->getElement(elementID);
 
-    RRMatrix Ae(element.size(),element.size());
+    RRSmallMatrix Ae(element.size(),element.size());
     RRVector be(element.size());
 
     Ae.fill(0.0);
@@ -1284,6 +1279,10 @@ void RSolverAcoustic::assemblyMatrix(uint elementID, const RRMatrix &Me, const R
 
 
     // Assembly final matrix system
+    if (this->matrixFree)
+    {
+        this->assemblyElementMatrix(elementID,Ae);
+    }
     for (uint m=0;m<element.size();m++)
     {
         uint mp;
@@ -1291,6 +1290,10 @@ void RSolverAcoustic::assemblyMatrix(uint elementID, const RRMatrix &Me, const R
         if (this->nodeBook.getValue(element.getNodeId(m),mp))
         {
             this->b[mp] += be[m];
+            if (this->matrixFree)
+            {
+                continue;
+            }
             for (uint n=0;n<element.size();n++)
             {
                 uint np = 0;
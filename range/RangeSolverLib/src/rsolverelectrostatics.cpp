@@ -93,7 +93,7 @@ void RSolverElectrostatics::prepare(void)
     this->b.resize(this->nodeBook.getNEnabled());
     this->x.resize(this->nodeBook.getNEnabled());
 
-    this->A.clear();
+    this->prepareMatrixPattern();
     this->b.fill(0.0);
     this->x.fill(0.0);
 
@@ -102,52 +102,55 @@ void RSolverElectrostatics::prepare(void)
     {
         RPoint &point = this->pModel->getPoint(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(point);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(point.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = point.get(j);
-
-                if (!this->computableElements[elementID])
+                try
                 {
-                    continue;
-                }
+                    uint elementID = elementIDs[j];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                    for (unsigned m=0;m<element.size();m++)
+                    for (uint k=0;k<nInp;k++)
                     {
-                        // Force
-                        fe[m] += elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        RRMatrix J, Rt;
+                        double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+
+                        for (unsigned m=0;m<element.size();m++)
+                        {
+                            // Force
+                            fe[m] += elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
+                        }
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -162,70 +165,73 @@ void RSolverElectrostatics::prepare(void)
     {
         RLine &line = this->pModel->getLine(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(line);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(line.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = line.get(j);
-
-                if (!this->computableElements[elementID])
+                try
                 {
-                    continue;
-                }
+                    uint elementID = elementIDs[j];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                RRMatrix B(element.size(),1);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
 
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    RRMatrix B(element.size(),1);
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                    for (uint m=0;m<dN.getNRows();m++)
+                    for (uint k=0;k<nInp;k++)
                     {
-                        B[m][0] += dN[m][0]*J[0][0];
-                    }
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        const RRMatrix &dN = shapeFunc.getDN();
+                        RRMatrix J, Rt;
+                        double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
 
-                    for (unsigned m=0;m<element.size();m++)
-                    {
-                        for (unsigned n=0;n<element.size();n++)
+                        for (uint m=0;m<dN.getNRows();m++)
                         {
-                            // Conduction
-                            Ke[m][n] += B[m][0] * B[n][0]
-                                     * this->elementRelativePermittivity[elementID]
-                                     * RSolverGeneric::e0
-                                     * detJ
-                                     * shapeFunc.getW()
-                                     * line.getCrossArea();
+                            B[m][0] += dN[m][0]*J[0][0];
+                        }
+
+                        for (unsigned m=0;m<element.size();m++)
+                        {
+                            for (unsigned n=0;n<element.size();n++)
+                            {
+                                // Conduction
+                                Ke[m][n] += B[m][0] * B[n][0]
+                                         * this->elementRelativePermittivity[elementID]
+                                         * RSolverGeneric::e0
+                                         * detJ
+                                         * shapeFunc.getW()
+                                         * line.getCrossArea();
+                            }
+                            // Force
+                            fe[m] -= elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
                         }
-                        // Force
-                        fe[m] -= elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -240,71 +246,74 @@ void RSolverElectrostatics::prepare(void)
     {
         RSurface &surface = this->pModel->getSurface(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(surface);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(surface.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = surface.get(j);
-
-                if (!this->computableElements[elementID])
+                try
                 {
-                    continue;
-                }
+                    uint elementID = elementIDs[j];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),2);
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
+                    RRMatrix B(element.size(),2);
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    for (uint k=0;k<nInp;k++)
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
-                    }
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        const RRMatrix &dN = shapeFunc.getDN();
+                        RRMatrix J, Rt;
+                        double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
 
-                    for (unsigned m=0;m<element.size();m++)
-                    {
-                        for (unsigned n=0;n<element.size();n++)
+                        B.fill(0.0);
+                        for (uint m=0;m<dN.getNRows();m++)
                         {
-                            // Conduction
-                            Ke[m][n] += (B[m][0] * B[n][0] + B[m][1] * B[n][1])
-                                     * this->elementRelativePermittivity[elementID]
-                                     * RSolverGeneric::e0
-                                     * surface.getThickness()
-                                     * detJ
-                                     * shapeFunc.getW();
+                            B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
+                            B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
+                        }
+
+                        for (unsigned m=0;m<element.size();m++)
+                        {
+                            for (unsigned n=0;n<element.size();n++)
+                            {
+                                // Conduction
+                                Ke[m][n] += (B[m][0] * B[n][0] + B[m][1] * B[n][1])
+                                         * this->elementRelativePermittivity[elementID]
+                                         * RSolverGeneric::e0
+                                         * surface.getThickness()
+                                         * detJ
+                                         * shapeFunc.getW();
+                            }
+                            // Force
+                            fe[m] -= elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
                         }
-                        // Force
-                        fe[m] -= elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -319,77 +328,80 @@ void RSolverElectrostatics::prepare(void)
     {
         RVolume &volume = this->pModel->getVolume(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(volume);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            #pragma omp flush (abort)
-            if (abort)
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                continue;
-            }
-            try
-            {
-                uint elementID = volume.get(j);
-
-                if (!this->computableElements[elementID])
+                #pragma omp flush (abort)
+                if (abort)
                 {
                     continue;
                 }
-
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),3);
-
-                Ke.fill(0.0);
-                fe.fill(0.0);
-
-                // Conduction
-                for (uint k=0;k<nInp;k++)
+                try
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    uint elementID = elementIDs[j];
 
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    if (!this->computableElements[elementID])
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
+                        continue;
                     }
 
-                    for (unsigned m=0;m<element.size();m++)
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
+                    RRMatrix B(element.size(),3);
+
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
+
+                    // Conduction
+                    for (uint k=0;k<nInp;k++)
                     {
-                        for (unsigned n=0;n<element.size();n++)
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        const RRMatrix &dN = shapeFunc.getDN();
+                        RRMatrix J, Rt;
+                        double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+
+                        B.fill(0.0);
+                        for (uint m=0;m<dN.getNRows();m++)
+                        {
+                            B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
+                            B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
+                            B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
+                        }
+
+                        for (unsigned m=0;m<element.size();m++)
                         {
-                            // Conduction
-                            Ke[m][n] += (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2])
-                                     * this->elementRelativePermittivity[elementID]
-                                     * RSolverGeneric::e0
-                                     * detJ
-                                     * shapeFunc.getW();
+                            for (unsigned n=0;n<element.size();n++)
+                            {
+                                // Conduction
+                                Ke[m][n] += (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2])
+                                         * this->elementRelativePermittivity[elementID]
+                                         * RSolverGeneric::e0
+                                         * detJ
+                                         * shapeFunc.getW();
+                            }
+                            // Force
+                            fe[m] -= elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
                         }
-                        // Force
-                        fe[m] -= elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -405,8 +417,10 @@ void RSolverElectrostatics::solve(void)
     try
     {
         RLogger::indent();
-        RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        const RMatrixSolverConf &matrixSolverConf = this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG);
+        RMatrixSolver matrixSolver(matrixSolverConf);
+        matrixSolver.setDirectSolver(&this->directSolver);
+        matrixSolver.solve(this->A,this->b,this->x,matrixSolverConf.getPreconditionerType(),1);
         RLogger::unindent();
     }
     catch (RError error)
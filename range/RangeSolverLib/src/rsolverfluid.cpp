@@ -13,8 +13,6 @@
 #include "rsolverfluid.h"
 #include "rmatrixsolver.h"
 
-//#define _OPTIMAL_ASSEMBLY_
-
 static const double inv6 = 1.0 / 6.0;
 
 class FluidMatrixContainer
@@ -342,30 +340,13 @@ void RSolverFluid::prepare(void)
     RBVector elementFreePressureSetValues;
     this->computeElementFreePressure(elementFreePressure,elementFreePressureSetValues);
 
-    this->A.clear();
-    this->A.setNRows(this->nodeBook.getNEnabled());
-    this->A.reserveNColumns(100);
+    this->prepareMatrixPattern(4);
     this->b.resize(this->nodeBook.getNEnabled());
     this->b.fill(0.0);
     this->x.resize(this->nodeBook.getNEnabled());
     this->x.fill(0.0);
 
-#ifdef _OPTIMAL_ASSEMBLY_
-    int np = omp_get_max_threads();
-
-    QVector<RSparseMatrix> Ap;
-    Ap.resize(np);
-    QVector<RRVector> bp;
-    bp.resize(np);
-
-    for (int i=0;i<np;i++)
-    {
-        Ap[i].setNRows(this->nodeBook.getNEnabled());
-        Ap[i].reserveNColumns(100);
-        bp[i].resize(this->nodeBook.getNEnabled());
-        bp[i].fill(0.0);
-    }
-#endif /* _OPTIMAL_ASSEMBLY_ */
+    std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches();
 
     bool abort = false;
 
@@ -380,109 +361,97 @@ void RSolverFluid::prepare(void)
     this->buildStopWatch.resume();
 
     // Compute element matrices
-    #pragma omp parallel for default(shared) private(matrixManager)
-    for (int64_t i=0;i<int64_t(this->pModel->getNElements());i++)
+    for (uint c=0;c<elementBatches.size();c++)
     {
-        uint elementID = uint(i);
-
-        const RElement &element = this->pModel->getElement(elementID);
-
-        #pragma omp flush (abort)
-        if (abort)
+        const std::vector<uint> &elementIDs = elementBatches[c];
+        #pragma omp parallel for default(shared) private(matrixManager)
+        for (int64_t i=0;i<int64_t(elementIDs.size());i++)
         {
-            continue;
-        }
-        try
-        {
-            uint nen = element.size();
-            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            uint elementID = elementIDs[i];
 
-            RRMatrix Ae(nen*4,nen*4,0.0);
-            RRVector be(nen*4,0.0);
+            const RElement &element = this->pModel->getElement(elementID);
 
-            if (R_ELEMENT_TYPE_IS_SURFACE(element.getType()))
+            #pragma omp flush (abort)
+            if (abort)
             {
-                if (!elementFreePressureSetValues[elementID])
-                {
-                    continue;
-                }
+                continue;
+            }
+            try
+            {
+                uint nen = element.size();
+                uint nInp = RElement::getNIntegrationPoints(element.getType());
+
+                RRMatrix Ae(nen*4,nen*4,0.0);
+                RRVector be(nen*4,0.0);
 
-                RR3Vector &normal = this->elementNormals[elementID];
-                if (this->meshChanged)
+                if (R_ELEMENT_TYPE_IS_SURFACE(element.getType()))
                 {
-                    // no need to recalculate if mesh does not change !!!
-                    element.findNormal(this->pModel->getNodes(),normal[0],normal[1],normal[2]);
-                    this->elementGravityMagnitude[elementID] = std::sqrt(  std::pow(elementGravity.x[elementID],2)
-                                                                         + std::pow(elementGravity.y[elementID],2)
-                                                                         + std::pow(elementGravity.z[elementID],2));
-                }
+                    if (!elementFreePressureSetValues[elementID])
+                    {
+                        continue;
+                    }
 
-                double ro = this->elementDensity[elementID];
+                    RR3Vector &normal = this->elementNormals[elementID];
+                    if (this->meshChanged)
+                    {
+                        // no need to recalculate if mesh does not change !!!
+                        element.findNormal(this->pModel->getNodes(),normal[0],normal[1],normal[2]);
+                        this->elementGravityMagnitude[elementID] = std::sqrt(  std::pow(elementGravity.x[elementID],2)
+                                                                             + std::pow(elementGravity.y[elementID],2)
+                                                                             + std::pow(elementGravity.z[elementID],2));
+                    }
 
-                double fp = elementFreePressure[elementID];
-                double gm = this->elementGravityMagnitude[elementID];
+                    double ro = this->elementDensity[elementID];
 
-                for (uint intPoint=0;intPoint<nInp;intPoint++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),intPoint);
-                    const RRVector &N = shapeFunc.getN();
-                    double detJ = this->shapeDerivations[elementID]->getJacobian(intPoint);
-                    double integValue = detJ * shapeFunc.getW();
+                    double fp = elementFreePressure[elementID];
+                    double gm = this->elementGravityMagnitude[elementID];
 
-                    for (uint m=0;m<element.size();m++)
+                    for (uint intPoint=0;intPoint<nInp;intPoint++)
                     {
-                        double nh = this->freePressureNodeHeight[element.getNodeId(m)];
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),intPoint);
+                        const RRVector &N = shapeFunc.getN();
+                        double detJ = this->shapeDerivations[elementID]->getJacobian(intPoint);
+                        double integValue = detJ * shapeFunc.getW();
 
-                        // Pressure vector
-                        double value = N[m] * (fp + ro * gm * nh) * integValue;
-                        be[4*m+0] -= value * normal[0];
-                        be[4*m+1] -= value * normal[1];
-                        be[4*m+2] -= value * normal[2];
+                        for (uint m=0;m<element.size();m++)
+                        {
+                            double nh = this->freePressureNodeHeight[element.getNodeId(m)];
+
+                            // Pressure vector
+                            double value = N[m] * (fp + ro * gm * nh) * integValue;
+                            be[4*m+0] -= value * normal[0];
+                            be[4*m+1] -= value * normal[1];
+                            be[4*m+2] -= value * normal[2];
+                        }
+                    }
+                    if (this->pModel->getTimeSolver().getEnabled())
+                    {
+                        be *= this->pModel->getTimeSolver().getCurrentTimeStepSize();
                     }
                 }
-                if (this->pModel->getTimeSolver().getEnabled())
+
+                if (R_ELEMENT_TYPE_IS_VOLUME(element.getType()))
                 {
-                    be *= this->pModel->getTimeSolver().getCurrentTimeStepSize();
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
+                    this->computeElement(elementID,Ae,be,matrixManager);
                 }
+                this->applyLocalRotations(elementID,Ae);
+                this->assemblyMatrix(elementID,Ae,be);
             }
-
-            if (R_ELEMENT_TYPE_IS_VOLUME(element.getType()))
+            catch (const RError &rError)
             {
-                if (!this->computableElements[elementID])
+                #pragma omp critical
                 {
-                    continue;
+                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                    abort = true;
                 }
-                this->computeElement(elementID,Ae,be,matrixManager);
+                #pragma omp flush (abort)
             }
-            this->applyLocalRotations(elementID,Ae);
-#ifdef _OPTIMAL_ASSEMBLY_
-            this->assemblyMatrix(elementID,Ae,be,Ap[omp_get_thread_num()],bp[omp_get_thread_num()]);
-#else
-            this->assemblyMatrix(elementID,Ae,be);
-#endif
-        }
-        catch (const RError &rError)
-        {
-            #pragma omp critical
-            {
-                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                abort = true;
-            }
-            #pragma omp flush (abort)
-        }
-    }
-
-#ifdef _OPTIMAL_ASSEMBLY_
-#pragma omp parallel for default(shared)
-    for (int64_t i=0;i<int64_t(this->A.getNRows());i++)
-    {
-        for (int j=0;j<np;j++)
-        {
-            A.getVector(uint(i)).addVector(Ap[j].getVector(uint(i)));
-            this->b[uint(i)] += bp[j][uint(i)];
         }
     }
-#endif
 
     this->buildStopWatch.pause();
 
@@ -506,8 +475,13 @@ void RSolverFluid::solve(void)
     try
     {
         RLogger::indent();
-        RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::GMRES));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        const RMatrixSolverConf &matrixSolverConf = this->pModel->getMatrixSolverConf(RMatrixSolverConf::GMRES);
+        RMatrixSolver matrixSolver(matrixSolverConf);
+        matrixSolver.setDirectSolver(&this->directSolver);
+        std::vector<uint> rowBlockIndexes;
+        this->findRowBlockIndexes(4,rowBlockIndexes);
+        matrixSolver.setRowBlockIndexes(rowBlockIndexes);
+        matrixSolver.solve(this->A,this->b,this->x,matrixSolverConf.getPreconditionerType(),4);
         RLogger::unindent();
     }
     catch (RError error)
@@ -1142,19 +1116,19 @@ void RSolverFluid::generateNodeBook(void)
                 uint nodeId = rElement.getNodeId(k);
                 if (elementHasVelocityX)
                 {
-                    this->nodeBook.disable(4*nodeId+0,true);
+                    this->nodeBook.disable(4*nodeId+0,false);
                 }
                 if (elementHasVelocityY)
                 {
-                    this->nodeBook.disable(4*nodeId+1,true);
+                    this->nodeBook.disable(4*nodeId+1,false);
                 }
                 if (elementHasVelocityZ)
                 {
-                    this->nodeBook.disable(4*nodeId+2,true);
+                    this->nodeBook.disable(4*nodeId+2,false);
                 }
                 if (hasPressure)
                 {
-                    this->nodeBook.disable(4*nodeId+3,true);
+                    this->nodeBook.disable(4*nodeId+3,false);
                 }
             }
         }
@@ -1175,12 +1149,14 @@ void RSolverFluid::generateNodeBook(void)
     {
         if (!computableNodes[i])
         {
-            this->nodeBook.disable(4*i+0,true);
-            this->nodeBook.disable(4*i+1,true);
-            this->nodeBook.disable(4*i+2,true);
-            this->nodeBook.disable(4*i+3,true);
+            this->nodeBook.disable(4*i+0,false);
+            this->nodeBook.disable(4*i+1,false);
+            this->nodeBook.disable(4*i+2,false);
+            this->nodeBook.disable(4*i+3,false);
         }
     }
+
+    this->renumberNodeBook(4);
 }
 
 void RSolverFluid::computeFreePressureNodeHeight(void)
@@ -2425,50 +2401,16 @@ void RSolverFluid::assemblyMatrix(uint elementID, const RRMatrix &Ae, const RRVe
             if (this->nodeBook.getValue(dims*rElement.getNodeId(m)+i,mp))
             {
                 uint row = dims*m+i;
-#pragma omp atomic
                 this->b[mp] += fe[row];
-#pragma omp critical
-                {
-                    for (uint n=0;n<rElement.size();n++)
-                    {
-                        for (uint j=0;j<dims;j++)
-                        {
-                            uint np = 0;
-
-                            if (this->nodeBook.getValue(dims*rElement.getNodeId(n)+j,np))
-                            {
-                                this->A.addValue(mp,np,Ae[row][dims*n+j]);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-}
-
-void RSolverFluid::assemblyMatrix(unsigned int elementID, const RRMatrix &Ae, const RRVector &fe, RSparseMatrix &Ap, RRVector &bp)
-{
-    const RElement &rElement = this->pModel->getElement(elementID);
-
-    // Assembly final matrix system
-    uint dims = 4;
-    for (uint m=0;m<rElement.size();m++)
-    {
-        for (uint i=0;i<dims;i++)
-        {
-            uint mp = 0;
-            if (this->nodeBook.getValue(dims*rElement.getNodeId(m)+i,mp))
-            {
-                bp[mp] += fe[dims*m+i];
                 for (uint n=0;n<rElement.size();n++)
                 {
                     for (uint j=0;j<dims;j++)
                     {
                         uint np = 0;
+
                         if (this->nodeBook.getValue(dims*rElement.getNodeId(n)+j,np))
                         {
-                            Ap.addValue(mp,np,Ae[dims*m+i][dims*n+j]);
+                            this->A.addValue(mp,np,Ae[row][dims*n+j]);
                         }
                     }
                 }
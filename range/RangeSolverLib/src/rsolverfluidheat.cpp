@@ -229,68 +229,79 @@ void RSolverFluidHeat::prepare(void)
     this->b.resize(this->nodeBook.getNEnabled());
     this->x.resize(this->nodeBook.getNEnabled());
 
-    this->A.clear();
-    this->A.setNRows(this->nodeBook.getNEnabled());
+    this->prepareMatrixPattern();
     this->b.fill(0.0);
     this->x.fill(0.0);
 
+    std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches();
+
     bool abort = false;
 
     RMatrixManager<FluidHeatMatrixContainer> matrixManager;
 
+    qint64 buildTime = 0;
+    qint64 assemblyTime = 0;
+
     // Compute element matrices
-    #pragma omp parallel for default(shared) private(matrixManager)
-    for (int64_t i=0;i<int64_t(this->pModel->getNElements());i++)
+    for (uint c=0;c<elementBatches.size();c++)
     {
-        uint elementID = i;
+        const std::vector<uint> &elementIDs = elementBatches[c];
+        #pragma omp parallel for default(shared) private(matrixManager) reduction(+:buildTime,assemblyTime)
+        for (int64_t i=0;i<int64_t(elementIDs.size());i++)
+        {
+            uint elementID = elementIDs[i];
 
-        const RElement &element = this->pModel->getElement(elementID);
+            const RElement &element = this->pModel->getElement(elementID);
 
-        #pragma omp flush (abort)
-        if (abort)
-        {
-            continue;
-        }
-        try
-        {
-            uint nen = element.size();
+            #pragma omp flush (abort)
+            if (abort)
+            {
+                continue;
+            }
+            try
+            {
+                uint nen = element.size();
 
-            RRMatrix Ae(nen,nen,0.0);
-            RRVector be(nen,0.0);
+                RRMatrix Ae(nen,nen,0.0);
+                RRVector be(nen,0.0);
 
-            RStopWatch localStopWatch;
-            localStopWatch.reset();
+                RStopWatch localStopWatch;
+                localStopWatch.reset();
 
-            if (R_ELEMENT_TYPE_IS_VOLUME(element.getType()))
-            {
-                if (!this->computableElements[elementID])
+                if (R_ELEMENT_TYPE_IS_VOLUME(element.getType()))
                 {
-                    continue;
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
+                    localStopWatch.resume();
+                    this->computeElement(elementID,Ae,be,matrixManager);
+                    localStopWatch.pause();
                 }
+                buildTime += localStopWatch.getMiliSeconds();
+
+                localStopWatch.reset();
                 localStopWatch.resume();
-                this->computeElement(elementID,Ae,be,matrixManager);
+                this->assemblyMatrix(elementID,Ae,be);
                 localStopWatch.pause();
-            }
-            #pragma omp critical
-            {
-                this->buildStopWatch.addElapsedTime(localStopWatch.getMiliSeconds());
 
-                this->assemblyStopWatch.resume();
-                this->assemblyMatrix(elementID,Ae,be);
-                this->assemblyStopWatch.pause();
+                assemblyTime += localStopWatch.getMiliSeconds();
             }
-        }
-        catch (const RError &rError)
-        {
-            #pragma omp critical
+            catch (const RError &rError)
             {
-                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                abort = true;
+                #pragma omp critical
+                {
+                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                    abort = true;
+                }
+                #pragma omp flush (abort)
             }
-            #pragma omp flush (abort)
         }
     }
 
+    this->buildStopWatch.addElapsedTime(buildTime);
+    this->assemblyStopWatch.addElapsedTime(assemblyTime);
+
     if (abort)
     {
         RLogger::unindent();
@@ -311,8 +322,10 @@ void RSolverFluidHeat::solve(void)
     try
     {
         RLogger::indent();
-        RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::GMRES));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        const RMatrixSolverConf &matrixSolverConf = this->pModel->getMatrixSolverConf(RMatrixSolverConf::GMRES);
+        RMatrixSolver matrixSolver(matrixSolverConf);
+        matrixSolver.setDirectSolver(&this->directSolver);
+        matrixSolver.solve(this->A,this->b,this->x,matrixSolverConf.getPreconditionerType(),1);
         RLogger::unindent();
     }
     catch (RError error)
@@ -9,6 +9,7 @@
  *********************************************************************/
 
 #include <QFile>
+#include <algorithm>
 #include <cstdio>
 
 #include "rsolvergeneric.h"
@@ -26,10 +27,17 @@ void RSolverGeneric::_init(const RSolverGeneric *pGenericSolver)
         this->pModel = pGenericSolver->pModel;
         this->M = pGenericSolver->M;
         this->A = pGenericSolver->A;
+        this->elementMatrixOperator = pGenericSolver->elementMatrixOperator;
+        this->matrixFree = pGenericSolver->matrixFree;
         this->x = pGenericSolver->x;
         this->b = pGenericSolver->b;
         this->nodeBook = pGenericSolver->nodeBook;
+        this->matrixPatternNodeBook = pGenericSolver->matrixPatternNodeBook;
+        this->nodeOrder = pGenericSolver->nodeOrder;
+        this->nodeOrderType = pGenericSolver->nodeOrderType;
+        this->elementColors = pGenericSolver->elementColors;
         this->localRotations = pGenericSolver->localRotations;
+        this->directSolver = pGenericSolver->directSolver;
         this->elementTemperature = pGenericSolver->elementTemperature;
         this->pSharedData = pGenericSolver->pSharedData;
         this->firstRun = pGenericSolver->firstRun;
@@ -44,6 +52,8 @@ RSolverGeneric::RSolverGeneric(RModel *pModel, const QString &modelFileName, con
     , pModel(pModel)
     , modelFileName(modelFileName)
     , convergenceFileName(convergenceFileName)
+    , matrixFree(false)
+    , nodeOrderType(R_NODE_ORDERING_NONE)
     , pSharedData(&sharedData)
     , firstRun(false)
     , taskIteration(0)
@@ -467,6 +477,26 @@ void RSolverGeneric::recoverSharedData(void)
     }
 }
 
+const RElementGeometryCache &RSolverGeneric::getGeometryCache(void)
+{
+    RElementGeometryCache &geometryCache = this->pSharedData->getGeometryCache();
+    if (geometryCache.update(this->pModel->getNodes(),this->pModel->getElements()))
+    {
+        RLogger::info("Element geometry cache updated\n");
+    }
+    return geometryCache;
+}
+
+const RMeshView &RSolverGeneric::getMeshView(void)
+{
+    RMeshView &meshView = this->pSharedData->getMeshView();
+    if (meshView.update(this->pModel->getNodes(),this->pModel->getElements()))
+    {
+        RLogger::info("Mesh view updated (%.1f MB)\n",double(meshView.getMemorySize())/(1024.0*1024.0));
+    }
+    return meshView;
+}
+
 void RSolverGeneric::writeResults(void)
 {
     if (this->modelFileName.isEmpty())
@@ -571,30 +601,358 @@ void RSolverGeneric::generateNodeBook(RProblemType problemType)
                 const RElement &element = this->pModel->getElement(pElementGroup->get(j));
                 for (unsigned int k=0;k<element.size();k++)
                 {
-                    this->nodeBook.disable(element.getNodeId(k),true);
+                    this->nodeBook.disable(element.getNodeId(k),false);
                 }
             }
         }
     }
-    RBVector computableNodes(this->pModel->getNNodes(),false);
-    for (uint i=0;i<this->pModel->getNElements();i++)
+    const RMeshView &meshView = this->getMeshView();
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(meshView.getNNodes());i++)
+    {
+        // Node is computable if it belongs to at least one computable element.
+        const uint *nodeElements = meshView.getNodeElements(uint(i));
+        bool computable = false;
+        for (uint j=0;j<meshView.getNNodeElements(uint(i));j++)
+        {
+            if (this->computableElements[nodeElements[j]])
+            {
+                computable = true;
+                break;
+            }
+        }
+        if (!computable)
+        {
+            this->nodeBook.disable(uint(i),false);
+        }
+    }
+
+    this->renumberNodeBook(1);
+}
+
+void RSolverGeneric::renumberNodeBook(uint nVariables)
+{
+    uint nNodes = this->pModel->getNNodes();
+
+    R_ERROR_ASSERT(this->nodeBook.size() == nNodes*nVariables);
+
+    // Node ordering is set alike for all matrix solvers.
+    RNodeOrderingType nodeOrdering = this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG).getNodeOrdering();
+
+    if (nodeOrdering == R_NODE_ORDERING_NONE)
+    {
+        this->nodeOrder.clear();
+    }
+    else if (this->meshChanged || this->nodeOrderType != nodeOrdering || this->nodeOrder.size() != nNodes)
+    {
+        // Node adjacency graph.
+        const RMeshView &meshView = this->getMeshView();
+
+        std::vector< std::vector<uint> > nodeNeighbors(nNodes);
+
+        #pragma omp parallel for default(shared)
+        for (int64_t i=0;i<int64_t(nNodes);i++)
+        {
+            std::vector<uint> &neighbors = nodeNeighbors[i];
+            const uint *nodeElements = meshView.getNodeElements(uint(i));
+            for (uint j=0;j<meshView.getNNodeElements(uint(i));j++)
+            {
+                uint elementID = nodeElements[j];
+                if (!this->computableElements[elementID])
+                {
+                    continue;
+                }
+                const uint *elementNodes = meshView.getElementNodes(elementID);
+                for (uint n=0;n<meshView.getNElementNodes(elementID);n++)
+                {
+                    if (elementNodes[n] != uint(i))
+                    {
+                        neighbors.push_back(elementNodes[n]);
+                    }
+                }
+            }
+            std::sort(neighbors.begin(),neighbors.end());
+            neighbors.erase(std::unique(neighbors.begin(),neighbors.end()),neighbors.end());
+        }
+
+        std::vector<uint> adjacencyPointers(nNodes+1,0);
+        for (uint i=0;i<nNodes;i++)
+        {
+            adjacencyPointers[i+1] = adjacencyPointers[i] + uint(nodeNeighbors[i].size());
+        }
+        std::vector<uint> adjacency(adjacencyPointers[nNodes]);
+        for (uint i=0;i<nNodes;i++)
+        {
+            std::copy(nodeNeighbors[i].begin(),nodeNeighbors[i].end(),adjacency.begin()+adjacencyPointers[i]);
+            std::vector<uint>().swap(nodeNeighbors[i]);
+        }
+
+        if (nodeOrdering == R_NODE_ORDERING_NESTED_DISSECTION)
+        {
+            RGraphOrdering::findNestedDissection(adjacencyPointers,adjacency,this->nodeOrder);
+        }
+        else
+        {
+            RGraphOrdering::findReverseCuthillMcKee(adjacencyPointers,adjacency,this->nodeOrder);
+        }
+        this->nodeOrderType = nodeOrdering;
+
+        uint originalBandwidth = RGraphOrdering::findBandwidth(adjacencyPointers,adjacency,std::vector<uint>());
+        uint bandwidth = RGraphOrdering::findBandwidth(adjacencyPointers,adjacency,this->nodeOrder);
+
+        RLogger::info("Node ordering: %s (bandwidth %u -> %u)\n",
+                      RMatrixSolverConf::getNodeOrderingName(nodeOrdering).toUtf8().constData(),
+                      originalBandwidth,
+                      bandwidth);
+
+        if (nodeOrdering == R_NODE_ORDERING_REVERSE_CUTHILL_MCKEE && bandwidth >= originalBandwidth)
+        {
+            // Mesh is already well numbered (e.g. structured mesh).
+            RLogger::info("Original node order is kept\n");
+            for (uint i=0;i<nNodes;i++)
+            {
+                this->nodeOrder[i] = i;
+            }
+        }
+    }
+
+    uint position = 0;
+    for (uint i=0;i<nNodes;i++)
+    {
+        uint nodeID = this->nodeOrder.empty() ? i : this->nodeOrder[i];
+        for (uint k=0;k<nVariables;k++)
+        {
+            uint value = 0;
+            if (this->nodeBook.getValue(nVariables*nodeID+k,value))
+            {
+                this->nodeBook.setValue(nVariables*nodeID+k,position++);
+            }
+        }
+    }
+}
+
+void RSolverGeneric::prepareMatrixPattern(uint nVariables, uint blockSize)
+{
+    uint nRows = blockSize * this->nodeBook.getNEnabled();
+
+    if (!this->meshChanged && this->A.getNRows() == nRows && this->matrixPatternNodeBook == this->nodeBook)
+    {
+        this->A.clearValues();
+        return;
+    }
+
+    RLogger::info("Generating matrix sparsity pattern\n");
+
+    this->elementMatrixOperator.clear();
+
+    const RMeshView &meshView = this->getMeshView();
+
+    this->A.clear();
+    this->A.setNRows(nRows);
+
+    // Rows of each node are filled only from elements connected to that node.
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(meshView.getNNodes());i++)
+    {
+        std::vector<uint> indexes;
+        const uint *nodeElements = meshView.getNodeElements(uint(i));
+        for (uint k=0;k<nVariables;k++)
+        {
+            uint mp = 0;
+            if (!this->nodeBook.getValue(nVariables*uint(i)+k,mp))
+            {
+                continue;
+            }
+            indexes.clear();
+            for (uint j=0;j<meshView.getNNodeElements(uint(i));j++)
+            {
+                uint elementID = nodeElements[j];
+                if (!this->computableElements[elementID])
+                {
+                    continue;
+                }
+                const uint *elementNodes = meshView.getElementNodes(elementID);
+                for (uint n=0;n<meshView.getNElementNodes(elementID);n++)
+                {
+                    for (uint l=0;l<nVariables;l++)
+                    {
+                        uint np = 0;
+                        if (!this->nodeBook.getValue(nVariables*elementNodes[n]+l,np))
+                        {
+                            continue;
+                        }
+                        for (uint q=0;q<blockSize;q++)
+                        {
+                            indexes.push_back(blockSize*np+q);
+                        }
+                    }
+                }
+            }
+            std::sort(indexes.begin(),indexes.end());
+            indexes.erase(std::unique(indexes.begin(),indexes.end()),indexes.end());
+            for (uint p=0;p<blockSize;p++)
+            {
+                this->A.getVector(blockSize*mp+p).setIndexes(indexes);
+            }
+        }
+    }
+
+    this->matrixPatternNodeBook = this->nodeBook;
+
+    this->generateElementColors();
+}
+
+void RSolverGeneric::prepareElementMatrixOperator(bool symmetric)
+{
+    uint nRows = this->nodeBook.getNEnabled();
+
+    if (!this->meshChanged && this->elementMatrixOperator.getNRows() == nRows && this->matrixPatternNodeBook == this->nodeBook)
+    {
+        this->elementMatrixOperator.clearValues();
+        return;
+    }
+
+    RLogger::info("Generating element matrix operator\n");
+
+    this->A.clear();
+
+    this->generateElementColors();
+
+    const RMeshView &meshView = this->getMeshView();
+
+    std::vector<uint> elementSizes(meshView.getNElements(),0);
+    for (uint i=0;i<meshView.getNElements();i++)
     {
         if (this->computableElements[i])
         {
-            const RElement &rElement = this->pModel->getElement(i);
-            for (uint j=0;j<rElement.size();j++)
+            elementSizes[i] = meshView.getNElementNodes(i);
+        }
+    }
+
+    this->elementMatrixOperator.build(nRows,elementSizes,this->findElementColorBatches(),symmetric);
+
+    this->matrixPatternNodeBook = this->nodeBook;
+
+    RLogger::info("Element matrix operator size = %.1f MB\n",double(this->elementMatrixOperator.getMemorySize())/(1024.0*1024.0));
+}
+
+void RSolverGeneric::assemblyElementMatrix(uint elementID, const RRSmallMatrix &Ae)
+{
+    // Mesh view was updated when element matrix operator was prepared.
+    const RMeshView &meshView = this->pSharedData->getMeshView();
+    const uint *elementNodes = meshView.getElementNodes(elementID);
+
+    uint positions[R_SMALL_MATRIX_MAX_SIZE];
+    for (uint m=0;m<meshView.getNElementNodes(elementID);m++)
+    {
+        if (!this->nodeBook.getValue(elementNodes[m],positions[m]))
+        {
+            positions[m] = RConstants::eod;
+        }
+    }
+
+    this->elementMatrixOperator.setElementMatrix(elementID,positions,Ae);
+}
+
+void RSolverGeneric::findRowBlockIndexes(uint nVariables, std::vector<uint> &rowBlockIndexes) const
+{
+    rowBlockIndexes.assign(this->nodeBook.getNEnabled(),0);
+
+    for (uint i=0;i<this->pModel->getNNodes();i++)
+    {
+        for (uint k=0;k<nVariables;k++)
+        {
+            uint position;
+            if (this->nodeBook.getValue(nVariables*i+k,position))
             {
-                computableNodes[rElement.getNodeId(j)] = true;
+                rowBlockIndexes[position] = i;
+            }
+        }
+    }
+}
+
+void RSolverGeneric::generateElementColors(void)
+{
+    const RMeshView &meshView = this->getMeshView();
+    uint nElements = meshView.getNElements();
+
+    // Greedy coloring - each element gets lowest color not used by any of its neighbors.
+    this->elementColors.assign(nElements,RConstants::eod);
+    std::vector<uint> colorMarks;
+
+    for (uint i=0;i<nElements;i++)
+    {
+        const uint *elementNodes = meshView.getElementNodes(i);
+        for (uint j=0;j<meshView.getNElementNodes(i);j++)
+        {
+            const uint *nodeElements = meshView.getNodeElements(elementNodes[j]);
+            for (uint k=0;k<meshView.getNNodeElements(elementNodes[j]);k++)
+            {
+                uint color = this->elementColors[nodeElements[k]];
+                if (color != RConstants::eod)
+                {
+                    colorMarks[color] = i;
+                }
             }
         }
+        uint color = 0;
+        while (color < colorMarks.size() && colorMarks[color] == i)
+        {
+            color++;
+        }
+        if (color == colorMarks.size())
+        {
+            colorMarks.push_back(RConstants::eod);
+        }
+        this->elementColors[i] = color;
+    }
+
+    RLogger::info("Number of element colors: %u\n",uint(colorMarks.size()));
+}
+
+std::vector< std::vector<uint> > RSolverGeneric::findElementColorBatches(const RElementGroup &elementGroup) const
+{
+    std::vector< std::vector<uint> > elementBatches;
+
+    for (uint i=0;i<elementGroup.size();i++)
+    {
+        uint elementID = elementGroup.get(i);
+        if (elementID >= this->elementColors.size())
+        {
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Element colors were not generated for element %u.",elementID);
+        }
+        uint color = this->elementColors[elementID];
+        if (color >= elementBatches.size())
+        {
+            elementBatches.resize(color+1);
+        }
+        elementBatches[color].push_back(elementID);
     }
-    for (uint i=0;i<computableNodes.size();i++)
+
+    return elementBatches;
+}
+
+std::vector< std::vector<uint> > RSolverGeneric::findElementColorBatches(void) const
+{
+    std::vector< std::vector<uint> > elementBatches;
+
+    if (this->elementColors.size() != this->pModel->getNElements())
     {
-        if (!computableNodes[i])
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Element colors were not generated.");
+    }
+
+    for (uint i=0;i<this->elementColors.size();i++)
+    {
+        uint color = this->elementColors[i];
+        if (color >= elementBatches.size())
         {
-            this->nodeBook.disable(i,true);
+            elementBatches.resize(color+1);
         }
+        elementBatches[color].push_back(i);
     }
+
+    return elementBatches;
 }
 
 void RSolverGeneric::generateMaterialVecor(RMaterialPropertyType materialPropertyType, RRVector &materialPropertyValues) const
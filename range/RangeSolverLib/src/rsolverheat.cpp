@@ -117,76 +117,90 @@ void RSolverHeat::prepare(void)
     this->b.resize(this->nodeBook.getNEnabled());
     this->x.resize(this->nodeBook.getNEnabled());
 
-    this->A.clear();
+    this->matrixFree = this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG).getMatrixFree();
+    if (this->matrixFree)
+    {
+        // Matrix is symmetric (solved by CG).
+        this->prepareElementMatrixOperator(true);
+    }
+    else
+    {
+        this->prepareMatrixPattern();
+    }
     this->b.fill(0.0);
     this->x.fill(0.0);
 
+    const RElementGeometryCache &geometryCache = this->getGeometryCache();
+
     // Prepare point elements.
     for (uint i=0;i<this->pModel->getNPoints();i++)
     {
         RPoint &point = this->pModel->getPoint(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(point);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(point.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = point.get(j);
-
-                if (!this->computableElements[elementID])
+                try
                 {
-                    continue;
-                }
+                    uint elementID = elementIDs[j];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRSmallMatrix Me(element.size(),element.size());
+                    RRSmallMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    Me.fill(0.0);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                    for (unsigned m=0;m<element.size();m++)
+                    for (uint k=0;k<nInp;k++)
                     {
-                        for (unsigned n=0;n<element.size();n++)
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        RRMatrix J, Rt;
+                        double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+
+                        for (unsigned m=0;m<element.size();m++)
                         {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
+                            for (unsigned n=0;n<element.size();n++)
                             {
-                                Me[m][n] += N[m] * N[n]
-                                         * this->elementDensity[elementID]
-                                         * this->elementCapacity[elementID]
-                                         * detJ
-                                         * shapeFunc.getW()
-                                         * point.getVolume();
+                                // Mass
+                                if (this->pModel->getTimeSolver().getEnabled())
+                                {
+                                    Me[m][n] += N[m] * N[n]
+                                             * this->elementDensity[elementID]
+                                             * this->elementCapacity[elementID]
+                                             * detJ
+                                             * shapeFunc.getW()
+                                             * point.getVolume();
+                                }
                             }
+                            // Force
+                            fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                         }
-                        // Force
-                        fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -201,80 +215,76 @@ void RSolverHeat::prepare(void)
     {
         RLine &line = this->pModel->getLine(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(line);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(line.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = line.get(j);
-
-                if (!this->computableElements[elementID])
+                try
                 {
-                    continue;
-                }
+                    uint elementID = elementIDs[j];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                RRMatrix B(element.size(),1);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRSmallMatrix Me(element.size(),element.size());
+                    RRSmallMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
 
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    RRSmallMatrix B(element.size(),1);
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    Me.fill(0.0);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                    for (uint m=0;m<dN.getNRows();m++)
+                    for (uint k=0;k<nInp;k++)
                     {
-                        B[m][0] += dN[m][0]*J[0][0];
-                    }
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        double detJ = geometryCache.findShapeDerivatives(elementID,k,B);
 
-                    for (unsigned m=0;m<element.size();m++)
-                    {
-                        for (unsigned n=0;n<element.size();n++)
+                        for (unsigned m=0;m<element.size();m++)
                         {
-                            // Conduction
-                            double kcnd = (B[m][0]*B[n][0]) * line.getCrossArea() * this->elementConduction[elementID];
-
-                            Ke[m][n] += kcnd * detJ * shapeFunc.getW();
-
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
+                            for (unsigned n=0;n<element.size();n++)
                             {
-                                Me[m][n] += N[m] * N[n]
-                                         * this->elementDensity[elementID]
-                                         * this->elementCapacity[elementID]
-                                         * detJ
-                                         * shapeFunc.getW()
-                                         * line.getCrossArea();
+                                // Conduction
+                                double kcnd = (B[m][0]*B[n][0]) * line.getCrossArea() * this->elementConduction[elementID];
+
+                                Ke[m][n] += kcnd * detJ * shapeFunc.getW();
+
+                                // Mass
+                                if (this->pModel->getTimeSolver().getEnabled())
+                                {
+                                    Me[m][n] += N[m] * N[n]
+                                             * this->elementDensity[elementID]
+                                             * this->elementCapacity[elementID]
+                                             * detJ
+                                             * shapeFunc.getW()
+                                             * line.getCrossArea();
+                                }
                             }
+                            // Force
+                            fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                         }
-                        // Force
-                        fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -295,95 +305,89 @@ void RSolverHeat::prepare(void)
         this->getSimpleConvection(surface,htc,htt);
         this->getForcedConvection(surface,htc,htt);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(surface);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(surface.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = surface.get(j);
-
-                if (!this->computableElements[elementID])
+                try
                 {
-                    continue;
-                }
+                    uint elementID = elementIDs[j];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),2);
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                this->getNaturalConvection(surface,elementID,htc,htt);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRSmallMatrix Me(element.size(),element.size());
+                    RRSmallMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
+                    RRSmallMatrix B(element.size(),2);
 
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    this->getNaturalConvection(surface,elementID,htc,htt);
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
-                    {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
-                    }
+                    Me.fill(0.0);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                    for (unsigned m=0;m<element.size();m++)
+                    for (uint k=0;k<nInp;k++)
                     {
-                        for (unsigned n=0;n<element.size();n++)
-                        {
-                            // Conduction
-                            double kcnd = (B[m][0]*B[n][0]+B[m][1]*B[n][1]) * surface.getThickness() * this->elementConduction[elementID];
-                            // Convection
-                            double kcnv = N[m] * N[n] * htc;
-
-                            Ke[m][n] += (kcnd + kcnv) * detJ * shapeFunc.getW();
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        double detJ = geometryCache.findShapeDerivatives(elementID,k,B);
 
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
+                        for (unsigned m=0;m<element.size();m++)
+                        {
+                            for (unsigned n=0;n<element.size();n++)
                             {
-                                Me[m][n] += N[m] * N[n]
-                                         * this->elementDensity[elementID]
-                                         * this->elementCapacity[elementID]
-                                         * detJ
-                                         * shapeFunc.getW()
-                                         * surface.getThickness();
+                                // Conduction
+                                double kcnd = (B[m][0]*B[n][0]+B[m][1]*B[n][1]) * surface.getThickness() * this->elementConduction[elementID];
+                                // Convection
+                                double kcnv = N[m] * N[n] * htc;
+
+                                Ke[m][n] += (kcnd + kcnv) * detJ * shapeFunc.getW();
+
+                                // Mass
+                                if (this->pModel->getTimeSolver().getEnabled())
+                                {
+                                    Me[m][n] += N[m] * N[n]
+                                             * this->elementDensity[elementID]
+                                             * this->elementCapacity[elementID]
+                                             * detJ
+                                             * shapeFunc.getW()
+                                             * surface.getThickness();
+                                }
                             }
+                            // Force
+                            fe[m] += (this->elementHeat[elementID] + this->elementRadiativeHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                         }
-                        // Force
-                        fe[m] += (this->elementHeat[elementID] + this->elementRadiativeHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                     }
-                }
 
-                // Convection force
-                double elementArea = 0.0;
-                if (element.findArea(this->pModel->getNodes(),elementArea))
-                {
-                    for (unsigned m=0;m<element.size();m++)
+                    // Convection force
+                    double elementArea = 0.0;
+                    if (element.findArea(this->pModel->getNodes(),elementArea))
                     {
-                        fe[m] += htc * htt * elementArea / element.size();
+                        for (unsigned m=0;m<element.size();m++)
+                        {
+                            fe[m] += htc * htt * elementArea / element.size();
+                        }
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -398,88 +402,81 @@ void RSolverHeat::prepare(void)
     {
         RVolume &volume = this->pModel->getVolume(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(volume);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = volume.get(j);
-
-                if (!this->computableElements[elementID])
+                #pragma omp flush (abort)
+                if (abort)
                 {
                     continue;
                 }
-
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),3);
-
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
-
-                // Conduction
-                for (uint k=0;k<nInp;k++)
+                try
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    uint elementID = elementIDs[j];
+
+                    if (!this->computableElements[elementID])
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
+                        continue;
                     }
 
-                    for (unsigned m=0;m<element.size();m++)
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRSmallMatrix Me(element.size(),element.size());
+                    RRSmallMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
+                    RRSmallMatrix B(element.size(),3);
+
+                    Me.fill(0.0);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
+
+                    // Conduction
+                    for (uint k=0;k<nInp;k++)
                     {
-                        for (unsigned n=0;n<element.size();n++)
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        double detJ = geometryCache.findShapeDerivatives(elementID,k,B);
+
+                        for (unsigned m=0;m<element.size();m++)
                         {
-                            // Conduction
-                            Ke[m][n] += (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2])
-                                     * this->elementConduction[elementID]
-                                     * detJ
-                                     * shapeFunc.getW();
-
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
+                            for (unsigned n=0;n<element.size();n++)
                             {
-                                Me[m][n] += N[m] * N[n]
-                                         * this->elementDensity[elementID]
-                                         * this->elementCapacity[elementID]
+                                // Conduction
+                                Ke[m][n] += (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2])
+                                         * this->elementConduction[elementID]
                                          * detJ
                                          * shapeFunc.getW();
+
+                                // Mass
+                                if (this->pModel->getTimeSolver().getEnabled())
+                                {
+                                    Me[m][n] += N[m] * N[n]
+                                             * this->elementDensity[elementID]
+                                             * this->elementCapacity[elementID]
+                                             * detJ
+                                             * shapeFunc.getW();
+                                }
                             }
+                            // Force
+                            fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                         }
-                        // Force
-                        fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -495,8 +492,17 @@ void RSolverHeat::solve(void)
     try
     {
         RLogger::indent();
-        RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        const RMatrixSolverConf &matrixSolverConf = this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG);
+        RMatrixSolver matrixSolver(matrixSolverConf);
+        matrixSolver.setDirectSolver(&this->directSolver);
+        if (this->matrixFree)
+        {
+            matrixSolver.solve(this->elementMatrixOperator,this->b,this->x,matrixSolverConf.getPreconditionerType());
+        }
+        else
+        {
+            matrixSolver.solve(this->A,this->b,this->x,matrixSolverConf.getPreconditionerType(),1);
+        }
         RLogger::unindent();
     }
     catch (RError error)
@@ -527,6 +533,8 @@ void RSolverHeat::process(void)
     // Initialize heat flux vector vector
     this->elementHeatFlux.resize(this->pModel->getNElements(),RR3Vector(0.0,0.0,0.0));
 
+    const RElementGeometryCache &geometryCache = this->getGeometryCache();
+
     // Process line elements.
     for (uint i=0;i<this->pModel->getNLines();i++)
     {
@@ -544,6 +552,7 @@ void RSolverHeat::process(void)
             const RElement &element = this->pModel->getElement(elementID);
             uint nInp = RElement::getNIntegrationPoints(element.getType());
             RRVector B(element.size());
+            RRSmallMatrix Bk, R;
 
             Qx = Qy = Qz = 0.0;
 
@@ -554,16 +563,14 @@ void RSolverHeat::process(void)
 
                 for (uint k=0;k<nInp;k++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    double detJ = geometryCache.findShapeDerivatives(elementID,k,Bk);
+                    geometryCache.findRotation(elementID,R);
 
                     if (line.getCrossArea() != 0.0)
                     {
-                        for (uint m=0;m<dN.getNRows();m++)
+                        for (uint m=0;m<element.size();m++)
                         {
-                            B[m] += dN[m][0] * J[0][0] * detJ / double(nInp);
+                            B[m] += Bk[m][0] * detJ / double(nInp);
                         }
                     }
                 }
@@ -575,10 +582,6 @@ void RSolverHeat::process(void)
                     Qi -= B[k] * this->elementConduction[elementID] * this->nodeTemperature[nodeID];
                 }
 
-                RRMatrix R;
-                RRVector t;
-                this->pModel->getElement(elementID).findTransformationMatrix(this->pModel->getNodes(),R,t);
-
                 Qx += R[0][0]*Qi;
                 Qy += R[1][0]*Qi;
                 Qz += R[2][0]*Qi;
@@ -612,7 +615,8 @@ void RSolverHeat::process(void)
 
             const RElement &element = this->pModel->getElement(elementID);
             uint nInp = RElement::getNIntegrationPoints(element.getType());
-            RRMatrix B(element.size(),2);
+            RRSmallMatrix B(element.size(),2);
+            RRSmallMatrix Bk, R;
 
             this->getNaturalConvection(surface,elementID,htc,htt);
 
@@ -626,17 +630,15 @@ void RSolverHeat::process(void)
 
                 for (uint k=0;k<nInp;k++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    double detJ = geometryCache.findShapeDerivatives(elementID,k,Bk);
+                    geometryCache.findRotation(elementID,R);
 
                     if (surface.getThickness() != 0.0)
                     {
-                        for (uint m=0;m<dN.getNRows();m++)
+                        for (uint m=0;m<element.size();m++)
                         {
-                            B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]) * detJ / double(nInp);
-                            B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]) * detJ / double(nInp);
+                            B[m][0] += Bk[m][0] * detJ / double(nInp);
+                            B[m][1] += Bk[m][1] * detJ / double(nInp);
                         }
                     }
                 }
@@ -649,10 +651,6 @@ void RSolverHeat::process(void)
                     Qj -= B[k][1] * this->elementConduction[elementID] * this->nodeTemperature[nodeID];
                 }
 
-                RRMatrix R;
-                RRVector t;
-                this->pModel->getElement(elementID).findTransformationMatrix(this->pModel->getNodes(),R,t);
-
                 Qx += R[0][0]*Qi + R[0][1]*Qj;
                 Qy += R[1][0]*Qi + R[1][1]*Qj;
                 Qz += R[2][0]*Qi + R[2][1]*Qj;
@@ -696,25 +694,21 @@ void RSolverHeat::process(void)
 
             const RElement &element = this->pModel->getElement(elementID);
             uint nInp = RElement::getNIntegrationPoints(element.getType());
-            RRMatrix B(element.size(),3);
+            RRSmallMatrix B(element.size(),3);
+            RRSmallMatrix Bk;
 
             Qx = Qy = Qz = 0.0;
 
-            B.fill(0.0);
-
             // Conduction
             for (uint k=0;k<nInp;k++)
             {
-                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                const RRMatrix &dN = shapeFunc.getDN();
-                RRMatrix J, Rt;
-                double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                double detJ = geometryCache.findShapeDerivatives(elementID,k,Bk);
 
-                for (uint m=0;m<dN.getNRows();m++)
+                for (uint m=0;m<element.size();m++)
                 {
-                    B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]) * detJ / double(nInp);
-                    B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]) * detJ / double(nInp);
-                    B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]) * detJ / double(nInp);
+                    B[m][0] += Bk[m][0] * detJ / double(nInp);
+                    B[m][1] += Bk[m][1] * detJ / double(nInp);
+                    B[m][2] += Bk[m][2] * detJ / double(nInp);
                 }
             }
 
@@ -787,14 +781,14 @@ void RSolverHeat::statistics(void)
     this->processMonitoringPoints();
 }
 
-void RSolverHeat::assemblyMatrix(uint elementID, const RRMatrix &Me, const RRMatrix &Ke, const RRVector &fe)
+void RSolverHeat::assemblyMatrix(uint elementID, const RRSmallMatrix &Me, const RRSmallMatrix &Ke, const RRVector &fe)
 {
     double alpha = this->pModel->getTimeSolver().getTimeMarchApproximationCoefficient();
     double dt = this->pModel->getTimeSolver().getCurrentTimeStepSize();
 
     const RElement &element = this->pModel->getElement(elementID);
 
-    RRMatrix Ae(element.size(),element.size());
+    RRSmallMatrix Ae(element.size(),element.size());
     RRVector be(element.size());
 
     Ae.fill(0.0);
@@ -834,6 +828,10 @@ void RSolverHeat::assemblyMatrix(uint elementID, const RRMatrix &Me, const RRMat
 
 
     // Assembly final matrix system
+    if (this->matrixFree)
+    {
+        this->assemblyElementMatrix(elementID,Ae);
+    }
     for (uint m=0;m<element.size();m++)
     {
         uint mp;
@@ -841,6 +839,10 @@ void RSolverHeat::assemblyMatrix(uint elementID, const RRMatrix &Me, const RRMat
         if (this->nodeBook.getValue(element.getNodeId(m),mp))
         {
             this->b[mp] += be[m];
+            if (this->matrixFree)
+            {
+                continue;
+            }
             for (uint n=0;n<element.size();n++)
             {
                 uint np = 0;
@@ -77,7 +77,7 @@ void RSolverMagnetostatics::prepare(void)
     this->b.resize(3*this->nodeBook.getNEnabled());
     this->x.resize(3*this->nodeBook.getNEnabled());
 
-    this->A.clear();
+    this->prepareMatrixPattern(1,3);
     this->b.fill(0.0);
     this->x.fill(0.0);
 
@@ -86,83 +86,86 @@ void RSolverMagnetostatics::prepare(void)
     {
         RVolume &volume = this->pModel->getVolume(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(volume);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = volume.get(j);
-
-                if (!this->computableElements[elementID])
+                #pragma omp flush (abort)
+                if (abort)
                 {
                     continue;
                 }
-
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Ke(element.size()*3,element.size()*3);
-                RRVector fe(element.size()*3);
-                RRMatrix B(element.size(),3);
-
-                Ke.fill(0.0);
-                fe.fill(0.0);
-
-                // Conduction
-                for (uint k=0;k<nInp;k++)
+                try
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    uint elementID = elementIDs[j];
+
+                    if (!this->computableElements[elementID])
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
+                        continue;
                     }
 
-                    for (unsigned m=0;m<element.size();m++)
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRMatrix Ke(element.size()*3,element.size()*3);
+                    RRVector fe(element.size()*3);
+                    RRMatrix B(element.size(),3);
+
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
+
+                    // Conduction
+                    for (uint k=0;k<nInp;k++)
                     {
-                        uint nodeID = element.getNodeId(m);
-                        for (unsigned n=0;n<element.size();n++)
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        const RRMatrix &dN = shapeFunc.getDN();
+                        RRMatrix J, Rt;
+                        double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+
+                        B.fill(0.0);
+                        for (uint m=0;m<dN.getNRows();m++)
                         {
-                            double KeValue = (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2]) * detJ * shapeFunc.getW();
-                            Ke[3*m+0][3*n+0] -= KeValue;
-                            Ke[3*m+1][3*n+1] -= KeValue;
-                            Ke[3*m+2][3*n+2] -= KeValue;
+                            B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
+                            B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
+                            B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
                         }
-                        double feValue = N[m] * detJ * shapeFunc.getW() * RSolverGeneric::e0;
 
-                        double jsx = - B[m][2] * this->nodeCurrentDensity.y[nodeID] + B[m][1] * this->nodeCurrentDensity.z[nodeID];
-                        double jsy =   B[m][2] * this->nodeCurrentDensity.x[nodeID] - B[m][0] * this->nodeCurrentDensity.z[nodeID];
-                        double jsz = - B[m][1] * this->nodeCurrentDensity.x[nodeID] + B[m][0] * this->nodeCurrentDensity.y[nodeID];
-
-                        fe[3*m+0] += feValue * jsx;
-                        fe[3*m+1] += feValue * jsy;
-                        fe[3*m+2] += feValue * jsz;
+                        for (unsigned m=0;m<element.size();m++)
+                        {
+                            uint nodeID = element.getNodeId(m);
+                            for (unsigned n=0;n<element.size();n++)
+                            {
+                                double KeValue = (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2]) * detJ * shapeFunc.getW();
+                                Ke[3*m+0][3*n+0] -= KeValue;
+                                Ke[3*m+1][3*n+1] -= KeValue;
+                                Ke[3*m+2][3*n+2] -= KeValue;
+                            }
+                            double feValue = N[m] * detJ * shapeFunc.getW() * RSolverGeneric::e0;
+
+                            double jsx = - B[m][2] * this->nodeCurrentDensity.y[nodeID] + B[m][1] * this->nodeCurrentDensity.z[nodeID];
+                            double jsy =   B[m][2] * this->nodeCurrentDensity.x[nodeID] - B[m][0] * this->nodeCurrentDensity.z[nodeID];
+                            double jsz = - B[m][1] * this->nodeCurrentDensity.x[nodeID] + B[m][0] * this->nodeCurrentDensity.y[nodeID];
+
+                            fe[3*m+0] += feValue * jsx;
+                            fe[3*m+1] += feValue * jsy;
+                            fe[3*m+2] += feValue * jsz;
+                        }
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
                 }
             }
         }
@@ -178,8 +181,10 @@ void RSolverMagnetostatics::solve(void)
     try
     {
         RLogger::indent();
-        RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        const RMatrixSolverConf &matrixSolverConf = this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG);
+        RMatrixSolver matrixSolver(matrixSolverConf);
+        matrixSolver.setDirectSolver(&this->directSolver);
+        matrixSolver.solve(this->A,this->b,this->x,matrixSolverConf.getPreconditionerType(),3);
         RLogger::unindent();
     }
     catch (RError error)
@@ -99,6 +99,9 @@ void RSolverRadiativeHeat::prepareViewFactors(void)
 
     bool reculateViewFactors = false;
 
+    // Previously calculated view-factors whose valid rows will be reused.
+    RViewFactorMatrix oldViewFactorMatrix;
+
     QString viewFactorMatrixFile = this->pModel->getProblemSetup().getRadiationSetup().getViewFactorMatrixFile();
     if (viewFactorMatrixFile.isEmpty())
     {
@@ -130,6 +133,20 @@ void RSolverRadiativeHeat::prepareViewFactors(void)
         if (!this->checkViewFactorHeader(viewFactorMatrixHeader))
         {
             reculateViewFactors = true;
+            if (!viewFactorMatrixHeader.getPatchHashes().empty())
+            {
+                try
+                {
+                    oldViewFactorMatrix.read(recentViewFactorMatrixFile);
+                }
+                catch (const RError &error)
+                {
+                    throw RError(R_ERROR_APPLICATION,R_ERROR_REF,
+                                 "Failed to read view factor matrix from file \'%s\'. %s",
+                                 recentViewFactorMatrixFile.toUtf8().constData(),
+                                 error.getMessage().toUtf8().constData());
+                }
+            }
         }
         else
         {
@@ -140,6 +157,11 @@ void RSolverRadiativeHeat::prepareViewFactors(void)
                 {
                     reculateViewFactors = true;
                 }
+                else if (!this->checkViewFactorGeometry(this->viewFactorMatrix))
+                {
+                    reculateViewFactors = true;
+                    oldViewFactorMatrix = this->viewFactorMatrix;
+                }
             }
             catch (const RError &error)
             {
@@ -159,7 +181,15 @@ void RSolverRadiativeHeat::prepareViewFactors(void)
                                            this->viewFactorMatrix.getPatchBook());
 
         // Calculate view-factors
-        RHemiCube::calculateViewFactors(*this->pModel,this->viewFactorMatrix);
+        if (oldViewFactorMatrix.size() > 0)
+        {
+            // Only rows affected by changed patches are recalculated.
+            RHemiCube::updateViewFactors(*this->pModel,oldViewFactorMatrix,this->viewFactorMatrix);
+        }
+        else
+        {
+            RHemiCube::calculateViewFactors(*this->pModel,this->viewFactorMatrix);
+        }
 
         // Write view-factor matrix to file
         viewFactorMatrixFile = this->pModel->writeViewFactorMatrix(this->viewFactorMatrix,viewFactorMatrixFile);
@@ -227,39 +257,75 @@ void RSolverRadiativeHeat::prepare(void)
         }
     }
 
+    RSolverRadiativeHeat::assemblyRadiationSystem(this->viewFactorMatrix,patchEmissivity,patchTemperature,patchAmbientTemperature,this->A,this->b);
+    // Subtract resulting heat from convection-conduction equation to ensure energy balance
+//    for (uint i=0;i<this->b.size();i++) this->b[i] -= this->patchHeat[i];
+}
+
+void RSolverRadiativeHeat::assemblyRadiationSystem(const RViewFactorMatrix &viewFactorMatrix,
+                                                   const RRVector &patchEmissivity,
+                                                   const RRVector &patchTemperature,
+                                                   const RRVector &patchAmbientTemperature,
+                                                   RSparseMatrix &A,
+                                                   RRVector &b)
+{
+    uint nPatches = viewFactorMatrix.size();
+
+    // Black body emissive power of patches.
+    RRVector patchEmissivePower(nPatches,0.0);
+    RRVector patchAmbientEmissivePower(nPatches,0.0);
+    for (uint i=0;i<nPatches;i++)
+    {
+        patchEmissivePower[i] = RSolverGeneric::sigma * std::pow(patchTemperature[i],4);
+        patchAmbientEmissivePower[i] = RSolverGeneric::sigma * std::pow(patchAmbientTemperature[i],4);
+    }
+
+    // Column sums of view-factor matrix (sum over i of Fij).
+    RRVector viewFactorColumnSums(nPatches,0.0);
+    for (uint i=0;i<nPatches;i++)
+    {
+        const RSparseVector<double> &viewFactors = viewFactorMatrix.getRow(i).getViewFactors();
+        for (uint k=0;k<viewFactors.size();k++)
+        {
+            viewFactorColumnSums[viewFactors.getIndex(k)] += viewFactors.getValue(k);
+        }
+    }
+
+    A.clear();
+    A.setNRows(nPatches);
+    b.resize(nPatches);
+    b.fill(0.0);
+
     // Prepare patch elements.
+    // Each row is assembled from non-zero view-factors only and is owned by a single thread.
+    //   Aij = dij/Ej - Fij*(1-Ej)/Ej
+    //   bj -= sum over i of (dij-Fij)*sigma*Tj^4
     #pragma omp parallel for default(shared)
-    for (int64_t i=0;i<int64_t(rPatchBook.getNPatches());i++)
+    for (int64_t i=0;i<int64_t(nPatches);i++)
     {
-        RRVector viewFactors = this->viewFactorMatrix.getRow(i).getViewFactors().getValues(rPatchBook.getNPatches());
+        const RSparseVector<double> &viewFactors = viewFactorMatrix.getRow(i).getViewFactors();
+
+        double Ei = patchEmissivity[i];
+        A.addValue(uint(i),uint(i),(Ei != 0.0) ? 1.0/Ei : 0.0);
 
         double Fsum = 0.0;
-        for (uint j=0;j<rPatchBook.getNPatches();j++)
+        for (uint k=0;k<viewFactors.size();k++)
         {
-            double dij = (i == j ? 1.0 : 0.0);
-
-            double Fij = viewFactors[j];
+            uint j = viewFactors.getIndex(k);
+            double Fij = viewFactors.getValue(k);
             double Ej = patchEmissivity[j];
             Fsum += Fij;
 
-            double Aij = 0.0;
             if (Ej != 0.0)
             {
-                Aij = dij/Ej - Fij*(1.0-Ej)/Ej;
-            }
-            double Bij = (dij-Fij)*RSolverGeneric::sigma;
-
-            #pragma omp critical
-            {
-                this->A.addValue(i,j,Aij);
-                this->b[j] -= Bij * std::pow(patchTemperature[j],4);
+                A.addValue(uint(i),j,-Fij*(1.0-Ej)/Ej);
             }
         }
 
+        b[i] = -(1.0 - viewFactorColumnSums[i]) * patchEmissivePower[i];
+
         // Ambient radiative heat flux
-        this->b[i] += (1.0 - Fsum) * RSolverGeneric::sigma * std::pow(patchAmbientTemperature[i],4);
-        // Subtract resulting heat from convection-conduction equation to ensure energy balance
-//        this->b[i] -= this->patchHeat[i];
+        b[i] += (1.0 - Fsum) * patchAmbientEmissivePower[i];
     }
 }
 
@@ -268,7 +334,10 @@ void RSolverRadiativeHeat::solve(void)
     try
     {
         RLogger::indent();
-        RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
+        RMatrixSolverConf matrixSolverConf(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
+        // View-factor matrix is dense, factorization would be too expensive.
+        matrixSolverConf.setDirectSolver(false);
+        RMatrixSolver matrixSolver(matrixSolverConf);
         matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
         RLogger::unindent();
     }
@@ -365,6 +434,18 @@ bool RSolverRadiativeHeat::checkViewFactorHeader(const RViewFactorMatrixHeader &
     {
         return false;
     }
+    if (viewFactorMatrixHeader.getViewFactorMethod() != this->pModel->getProblemSetup().getRadiationSetup().getViewFactorMethod())
+    {
+        return false;
+    }
+    if (viewFactorMatrixHeader.getViewFactorCorrection() != this->pModel->getProblemSetup().getRadiationSetup().getViewFactorCorrection())
+    {
+        return false;
+    }
+    if (viewFactorMatrixHeader.getViewFactorThreshold() != this->pModel->getProblemSetup().getRadiationSetup().getViewFactorThreshold())
+    {
+        return false;
+    }
     std::vector<RPatchInput> patchInput;
     this->pModel->generatePatchInputVector(patchInput);
     if (viewFactorMatrixHeader.getPatchInput() != patchInput)
@@ -373,3 +454,20 @@ bool RSolverRadiativeHeat::checkViewFactorHeader(const RViewFactorMatrixHeader &
     }
     return true;
 }
+
+bool RSolverRadiativeHeat::checkViewFactorGeometry(const RViewFactorMatrix &viewFactorMatrix) const
+{
+    const std::vector<quint64> &rPatchHashes = viewFactorMatrix.getHeader().getPatchHashes();
+    if (rPatchHashes.empty())
+    {
+        return true;
+    }
+
+    RPatchBook patchBook;
+    this->pModel->generatePatchSurface(viewFactorMatrix.getHeader().getPatchInput(),patchBook);
+
+    std::vector<quint64> patchHashes;
+    this->pModel->generatePatchHashes(patchBook,patchHashes);
+
+    return (patchHashes == rPatchHashes);
+}
@@ -15,6 +15,8 @@ void RSolverSharedData::_init(const RSolverSharedData *pSolverSharedData)
     if (pSolverSharedData)
     {
         this->data = pSolverSharedData->data;
+        this->geometryCache = pSolverSharedData->geometryCache;
+        this->meshView = pSolverSharedData->meshView;
     }
 }
 
@@ -63,3 +65,22 @@ void RSolverSharedData::clearData(void)
     this->data.clear();
 }
 
+const RElementGeometryCache &RSolverSharedData::getGeometryCache(void) const
+{
+    return this->geometryCache;
+}
+
+RElementGeometryCache &RSolverSharedData::getGeometryCache(void)
+{
+    return this->geometryCache;
+}
+
+const RMeshView &RSolverSharedData::getMeshView(void) const
+{
+    return this->meshView;
+}
+
+RMeshView &RSolverSharedData::getMeshView(void)
+{
+    return this->meshView;
+}
@@ -159,8 +159,17 @@ void RSolverStress::prepare(void)
     this->b.resize(this->nodeBook.getNEnabled());
     this->x.resize(this->nodeBook.getNEnabled());
 
-    this->M.clear();
-    this->A.clear();
+    this->prepareMatrixPattern(3);
+    if (this->problemType == R_PROBLEM_STRESS_MODAL)
+    {
+        // Mass matrix has the same pattern as stiffness matrix.
+        // All rows must exist before elements are assembled in parallel.
+        this->M = this->A;
+    }
+    else
+    {
+        this->M.clear();
+    }
     this->b.fill(0.0);
     this->x.fill(0.0);
 
@@ -208,75 +217,80 @@ void RSolverStress::prepare(void)
         }
     }
 
+    const RElementGeometryCache &geometryCache = this->getGeometryCache();
+
     // Prepare point elements.
     for (uint i=0;i<this->pModel->getNPoints();i++)
     {
         RPoint &point = this->pModel->getPoint(i);
         double pointVolume = point.getVolume();
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(point);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(point.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            #pragma omp flush (abort)
-            if (abort)
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                continue;
-            }
-            try
-            {
-                uint elementID = point.get(uint(j));
-
-                if (!this->computableElements[elementID])
+                #pragma omp flush (abort)
+                if (abort)
                 {
                     continue;
                 }
-
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(this->pModel->getElement(elementID).getType()));
-                RRMatrix Me(3,3);
-                RRMatrix Ke(3,3);
-                RRVector fe(3);
-
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
-
-                // Force
-                fe[0] += elementForce.x[elementID];
-                fe[1] += elementForce.y[elementID];
-                fe[2] += elementForce.z[elementID];
-                // Weight
-                fe[0] += elementWeight[elementID] * elementGravity.x[elementID];
-                fe[1] += elementWeight[elementID] * elementGravity.y[elementID];
-                fe[2] += elementWeight[elementID] * elementGravity.z[elementID];
-                // Own weight
-                if (pointVolume > 0.0)
+                try
                 {
-                    fe[0] += elementGravity.x[elementID] * this->elementDensity[elementID] * pointVolume;
-                    fe[1] += elementGravity.y[elementID] * this->elementDensity[elementID] * pointVolume;
-                    fe[2] += elementGravity.z[elementID] * this->elementDensity[elementID] * pointVolume;
-                }
+                    uint elementID = point.get(uint(j));
 
-                // Mass
-                if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
-                {
-                    Me.setIdentity(3);
-                    Me *= this->elementDensity[elementID] * pointVolume;
-                }
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
+
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(this->pModel->getElement(elementID).getType()));
+                    RRMatrix Me(3,3);
+                    RRMatrix Ke(3,3);
+                    RRVector fe(3);
+
+                    Me.fill(0.0);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
+
+                    // Force
+                    fe[0] += elementForce.x[elementID];
+                    fe[1] += elementForce.y[elementID];
+                    fe[2] += elementForce.z[elementID];
+                    // Weight
+                    fe[0] += elementWeight[elementID] * elementGravity.x[elementID];
+                    fe[1] += elementWeight[elementID] * elementGravity.y[elementID];
+                    fe[2] += elementWeight[elementID] * elementGravity.z[elementID];
+                    // Own weight
+                    if (pointVolume > 0.0)
+                    {
+                        fe[0] += elementGravity.x[elementID] * this->elementDensity[elementID] * pointVolume;
+                        fe[1] += elementGravity.y[elementID] * this->elementDensity[elementID] * pointVolume;
+                        fe[2] += elementGravity.z[elementID] * this->elementDensity[elementID] * pointVolume;
+                    }
+
+                    // Mass
+                    if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
+                    {
+                        Me.setIdentity(3);
+                        Me *= this->elementDensity[elementID] * pointVolume;
+                    }
 
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
+                    #pragma omp flush (abort)
                 }
-                #pragma omp flush (abort)
             }
         }
         if (abort)
@@ -291,126 +305,129 @@ void RSolverStress::prepare(void)
         RLine &line = this->pModel->getLine(i);
         double lineCrossArea = line.getCrossArea();
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(line);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(line.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = line.get(uint(j));
-
-                if (!this->computableElements[elementID])
+                #pragma omp flush (abort)
+                if (abort)
                 {
                     continue;
                 }
+                try
+                {
+                    uint elementID = line.get(uint(j));
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size()*3,element.size()*3,0.0);
-                RRMatrix Ke(element.size()*3,element.size()*3,0.0);
-                RRVector fe(element.size()*3,0.0);
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                RRMatrix Be(3*element.size(),1);
-                RRMatrix BeT(1,3*element.size());
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRMatrix Me(element.size()*3,element.size()*3,0.0);
+                    RRMatrix Ke(element.size()*3,element.size()*3,0.0);
+                    RRVector fe(element.size()*3,0.0);
 
-                double lineLength = 0.0;
-                element.findLength(this->pModel->getNodes(),lineLength);
+                    RRMatrix Be(3*element.size(),1);
+                    RRMatrix BeT(1,3*element.size());
 
-                double E = this->elementElasticityModulus[elementID];
-                double De = E * lineCrossArea;
+                    double lineLength = 0.0;
+                    element.findLength(this->pModel->getNodes(),lineLength);
 
-                double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
+                    double E = this->elementElasticityModulus[elementID];
+                    double De = E * lineCrossArea;
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
-                    if (lineCrossArea > 0.0)
+                    double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
+
+                    for (uint k=0;k<nInp;k++)
                     {
-                        Be.fill(0.0);
-                        for (uint m=0;m<dN.getNRows();m++)
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        const RRMatrix &dN = shapeFunc.getDN();
+                        RRMatrix J, Rt;
+                        double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
+                        if (lineCrossArea > 0.0)
                         {
-                            Be[3*m+0][0] += Rt[3*m+0][0]*dN[m][0]*J[0][0];
-                            Be[3*m+1][0] += Rt[3*m+1][0]*dN[m][0]*J[0][0];
-                            Be[3*m+2][0] += Rt[3*m+2][0]*dN[m][0]*J[0][0];
+                            Be.fill(0.0);
+                            for (uint m=0;m<dN.getNRows();m++)
+                            {
+                                Be[3*m+0][0] += Rt[3*m+0][0]*dN[m][0]*J[0][0];
+                                Be[3*m+1][0] += Rt[3*m+1][0]*dN[m][0]*J[0][0];
+                                Be[3*m+2][0] += Rt[3*m+2][0]*dN[m][0]*J[0][0];
+                            }
+                            BeT.transpose(Be);
+                            Be *= De;
+                            RRMatrix::mlt(Be,BeT,Ke);
                         }
-                        BeT.transpose(Be);
-                        Be *= De;
-                        RRMatrix::mlt(Be,BeT,Ke);
-                    }
 
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        if (lineCrossArea > 0.0)
+                        for (uint m=0;m<element.size();m++)
                         {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
+                            if (lineCrossArea > 0.0)
                             {
-                                for (uint n=0;n<element.size();n++)
+                                // Mass
+                                if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
                                 {
-                                    double value = N[m] * N[n]
-                                                 * this->elementDensity[elementID]
-                                                 * detJ
-                                                 * shapeFunc.getW()
-                                                 * lineCrossArea;
-                                    Me[3*m+0][3*n+0] += std::pow(Rt[0][0],2.0)*value;
-                                    Me[3*m+1][3*n+1] += std::pow(Rt[1][0],2.0)*value;
-                                    Me[3*m+2][3*n+2] += std::pow(Rt[2][0],2.0)*value;
+                                    for (uint n=0;n<element.size();n++)
+                                    {
+                                        double value = N[m] * N[n]
+                                                     * this->elementDensity[elementID]
+                                                     * detJ
+                                                     * shapeFunc.getW()
+                                                     * lineCrossArea;
+                                        Me[3*m+0][3*n+0] += std::pow(Rt[0][0],2.0)*value;
+                                        Me[3*m+1][3*n+1] += std::pow(Rt[1][0],2.0)*value;
+                                        Me[3*m+2][3*n+2] += std::pow(Rt[2][0],2.0)*value;
+                                    }
                                 }
                             }
-                        }
 
-                        double integValue = N[m] * detJ * shapeFunc.getW();
-
-                        // Force
-                        fe[3*m+0] += (elementForce.x[elementID] / lineLength) * integValue;
-                        fe[3*m+1] += (elementForce.y[elementID] / lineLength) * integValue;
-                        fe[3*m+2] += (elementForce.z[elementID] / lineLength) * integValue;
-                        // Weight
-                        fe[3*m+0] += (elementWeight[elementID] * elementGravity.x[elementID] / lineLength) * integValue;
-                        fe[3*m+1] += (elementWeight[elementID] * elementGravity.y[elementID] / lineLength) * integValue;
-                        fe[3*m+2] += (elementWeight[elementID] * elementGravity.z[elementID] / lineLength) * integValue;
-                        // Own weight
-                        if (lineCrossArea > 0.0)
-                        {
-                            fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
-                            fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
-                            fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
-                        }
+                            double integValue = N[m] * detJ * shapeFunc.getW();
+
+                            // Force
+                            fe[3*m+0] += (elementForce.x[elementID] / lineLength) * integValue;
+                            fe[3*m+1] += (elementForce.y[elementID] / lineLength) * integValue;
+                            fe[3*m+2] += (elementForce.z[elementID] / lineLength) * integValue;
+                            // Weight
+                            fe[3*m+0] += (elementWeight[elementID] * elementGravity.x[elementID] / lineLength) * integValue;
+                            fe[3*m+1] += (elementWeight[elementID] * elementGravity.y[elementID] / lineLength) * integValue;
+                            fe[3*m+2] += (elementWeight[elementID] * elementGravity.z[elementID] / lineLength) * integValue;
+                            // Own weight
+                            if (lineCrossArea > 0.0)
+                            {
+                                fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
+                                fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
+                                fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
+                            }
 
-                        // Thermal expansion
-                        if (lineCrossArea > 0.0)
-                        {
-                            double fet = this->elementThermalExpansion[elementID] * dT * De * Be[m][0] * lineCrossArea * detJ * shapeFunc.getW();
+                            // Thermal expansion
+                            if (lineCrossArea > 0.0)
+                            {
+                                double fet = this->elementThermalExpansion[elementID] * dT * De * Be[m][0] * lineCrossArea * detJ * shapeFunc.getW();
 
-                            fe[3*m+0] += Rt[3*m+0][0]*fet;
-                            fe[3*m+1] += Rt[3*m+1][0]*fet;
-                            fe[3*m+2] += Rt[3*m+2][0]*fet;
+                                fe[3*m+0] += Rt[3*m+0][0]*fet;
+                                fe[3*m+1] += Rt[3*m+1][0]*fet;
+                                fe[3*m+2] += Rt[3*m+2][0]*fet;
+                            }
                         }
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
+                    #pragma omp flush (abort)
                 }
-                #pragma omp flush (abort)
             }
         }
         if (abort)
@@ -426,180 +443,183 @@ void RSolverStress::prepare(void)
         double surfaceArea = surface.findArea(this->pModel->getNodes(),this->pModel->getElements());
         double surfaceThickness = surface.getThickness();
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(surface);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(surface.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            #pragma omp flush (abort)
-            if (abort)
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                continue;
-            }
-            try
-            {
-                uint elementID = surface.get(uint(j));
-
-                if (!this->computableElements[elementID] && !this->includableElements[elementID])
+                #pragma omp flush (abort)
+                if (abort)
                 {
                     continue;
                 }
+                try
+                {
+                    uint elementID = surface.get(uint(j));
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size()*3,element.size()*3);
-                RRMatrix Ke(element.size()*3,element.size()*3);
-                RRVector fe(element.size()*3);
+                    if (!this->computableElements[elementID] && !this->includableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRMatrix Me(element.size()*3,element.size()*3);
+                    RRMatrix Ke(element.size()*3,element.size()*3);
+                    RRVector fe(element.size()*3);
 
-                RRMatrix B(element.size(),3);
-                RRMatrix Be(element.size()*2,3);
-                RRMatrix BeT(3,element.size()*2);
-                RRMatrix BeD(element.size()*2,3);
-                RRMatrix Met(element.size()*2,element.size()*2);
-                RRMatrix MeRt(element.size()*3,element.size()*2);
-                RRMatrix Ket(element.size()*2,element.size()*2);
-                RRMatrix KeRt(element.size()*3,element.size()*2);
-                RRVector fet(element.size()*2);
+                    Me.fill(0.0);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                RRMatrix De(3,3,0.0);
+                    RRMatrix B(element.size(),3);
+                    RRMatrix Be(element.size()*2,3);
+                    RRMatrix BeT(3,element.size()*2);
+                    RRMatrix BeD(element.size()*2,3);
+                    RRMatrix Met(element.size()*2,element.size()*2);
+                    RRMatrix MeRt(element.size()*3,element.size()*2);
+                    RRMatrix Ket(element.size()*2,element.size()*2);
+                    RRMatrix KeRt(element.size()*3,element.size()*2);
+                    RRVector fet(element.size()*2);
 
-                double E = this->elementElasticityModulus[elementID];
-                double v = this->elementPoissonRatio[elementID];
+                    RRMatrix De(3,3,0.0);
 
-                De[0][0] = 1-v;   De[0][1] = v;
-                De[1][0] = v;     De[1][1] = 1-v;
-                De[2][2] = (1-2*v)/2;
-                De *= E/((1+v)*(1-2*v));
+                    double E = this->elementElasticityModulus[elementID];
+                    double v = this->elementPoissonRatio[elementID];
 
-                double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
+                    De[0][0] = 1-v;   De[0][1] = v;
+                    De[1][0] = v;     De[1][1] = 1-v;
+                    De[2][2] = (1-2*v)/2;
+                    De *= E/((1+v)*(1-2*v));
 
-                RR3Vector normal;
-                element.findNormal(this->pModel->getNodes(),normal[0],normal[1],normal[2]);
+                    double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt, RtT;
-                    double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
-                    RtT.transpose(Rt);
+                    RR3Vector normal;
+                    element.findNormal(this->pModel->getNodes(),normal[0],normal[1],normal[2]);
 
-                    if (surfaceThickness > 0.0)
+                    for (uint k=0;k<nInp;k++)
                     {
-                        B.fill(0.0);
-                        for (uint m=0;m<dN.getNRows();m++)
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        const RRMatrix &dN = shapeFunc.getDN();
+                        RRMatrix J, Rt, RtT;
+                        double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
+                        RtT.transpose(Rt);
+
+                        if (surfaceThickness > 0.0)
                         {
-                            B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
-                            B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
+                            B.fill(0.0);
+                            for (uint m=0;m<dN.getNRows();m++)
+                            {
+                                B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
+                                B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
+                            }
+
+                            for (uint m=0;m<element.size();m++)
+                            {
+                                Be[2*m][0] = B[m][0];   Be[2*m+1][0] = 0.0;
+                                Be[2*m][1] = 0.0;       Be[2*m+1][1] = B[m][1];
+                                Be[2*m][2] = B[m][1];   Be[2*m+1][2] = B[m][0];
+                            }
+                            BeT.transpose(Be);
+
+                            RRMatrix::mlt(Be,De,BeD);
+                            RRMatrix::mlt(BeD,BeT,Ket);
+                            RRMatrix::mlt(Rt,Ket,KeRt);
+                            RRMatrix::mlt(KeRt,RtT,Ke);
+                            Ke *= detJ * shapeFunc.getW();
                         }
 
                         for (uint m=0;m<element.size();m++)
                         {
-                            Be[2*m][0] = B[m][0];   Be[2*m+1][0] = 0.0;
-                            Be[2*m][1] = 0.0;       Be[2*m+1][1] = B[m][1];
-                            Be[2*m][2] = B[m][1];   Be[2*m+1][2] = B[m][0];
-                        }
-                        BeT.transpose(Be);
+                            if (surfaceThickness > 0.0)
+                            {
+                                // Mass
+                                if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
+                                {
+                                    for (uint n=0;n<element.size();n++)
+                                    {
+                                        double value = N[m] * N[n]
+                                                     * this->elementDensity[elementID]
+                                                     * detJ
+                                                     * shapeFunc.getW()
+                                                     * surfaceThickness;
+                                        Met[2*m+0][2*n+0] += value;
+                                        Met[2*m+1][2*n+1] += value;
+                                    }
+                                }
+                            }
 
-                        RRMatrix::mlt(Be,De,BeD);
-                        RRMatrix::mlt(BeD,BeT,Ket);
-                        RRMatrix::mlt(Rt,Ket,KeRt);
-                        RRMatrix::mlt(KeRt,RtT,Ke);
-                        Ke *= detJ * shapeFunc.getW();
-                    }
+                            double integValue = N[m] * detJ * shapeFunc.getW();
+
+                            // Pressure vector
+                            fe[3*m+0] += elementPressure[elementID] * normal[0] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
+                            fe[3*m+1] += elementPressure[elementID] * normal[1] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
+                            fe[3*m+2] += elementPressure[elementID] * normal[2] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
+                            // Force per unit area
+                            fe[3*m+0] += elementForceUnitArea.x[elementID] * integValue;
+                            fe[3*m+1] += elementForceUnitArea.y[elementID] * integValue;
+                            fe[3*m+2] += elementForceUnitArea.z[elementID] * integValue;
+                            // Force
+                            fe[3*m+0] += (elementForce.x[elementID] / surfaceArea) * integValue;
+                            fe[3*m+1] += (elementForce.y[elementID] / surfaceArea) * integValue;
+                            fe[3*m+2] += (elementForce.z[elementID] / surfaceArea) * integValue;
+                            // Weight
+                            fe[3*m+0] += (elementWeight[elementID] * elementGravity.x[elementID] / surfaceArea) * integValue;
+                            fe[3*m+1] += (elementWeight[elementID] * elementGravity.y[elementID] / surfaceArea) * integValue;
+                            fe[3*m+2] += (elementWeight[elementID] * elementGravity.z[elementID] / surfaceArea) * integValue;
+                            // Own weight
+                            if (surfaceThickness > 0.0)
+                            {
+                                fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
+                                fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
+                                fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
+                            }
 
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        if (surfaceThickness > 0.0)
-                        {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
+                            // Thermal expansion
+                            if (surfaceThickness > 0.0)
                             {
-                                for (uint n=0;n<element.size();n++)
+                                fet.fill(0.0);
+                                for (uint n=0;n<3;n++)
                                 {
-                                    double value = N[m] * N[n]
-                                                 * this->elementDensity[elementID]
-                                                 * detJ
-                                                 * shapeFunc.getW()
-                                                 * surfaceThickness;
-                                    Met[2*m+0][2*n+0] += value;
-                                    Met[2*m+1][2*n+1] += value;
+                                    fet[2*m+0] += this->elementThermalExpansion[elementID] * dT * BeD[2*m+0][n] * surfaceThickness * detJ * shapeFunc.getW();
+                                    fet[2*m+1] += this->elementThermalExpansion[elementID] * dT * BeD[2*m+1][n] * surfaceThickness * detJ * shapeFunc.getW();
                                 }
+
+                                fe[3*m+0] += Rt[3*m+0][0]*fet[2*m+0] + Rt[3*m+0][1]*fet[2*m+1];
+                                fe[3*m+1] += Rt[3*m+1][0]*fet[2*m+0] + Rt[3*m+1][1]*fet[2*m+1];
+                                fe[3*m+2] += Rt[3*m+2][0]*fet[2*m+0] + Rt[3*m+2][1]*fet[2*m+1];
                             }
                         }
 
-                        double integValue = N[m] * detJ * shapeFunc.getW();
-
-                        // Pressure vector
-                        fe[3*m+0] += elementPressure[elementID] * normal[0] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
-                        fe[3*m+1] += elementPressure[elementID] * normal[1] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
-                        fe[3*m+2] += elementPressure[elementID] * normal[2] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
-                        // Force per unit area
-                        fe[3*m+0] += elementForceUnitArea.x[elementID] * integValue;
-                        fe[3*m+1] += elementForceUnitArea.y[elementID] * integValue;
-                        fe[3*m+2] += elementForceUnitArea.z[elementID] * integValue;
-                        // Force
-                        fe[3*m+0] += (elementForce.x[elementID] / surfaceArea) * integValue;
-                        fe[3*m+1] += (elementForce.y[elementID] / surfaceArea) * integValue;
-                        fe[3*m+2] += (elementForce.z[elementID] / surfaceArea) * integValue;
-                        // Weight
-                        fe[3*m+0] += (elementWeight[elementID] * elementGravity.x[elementID] / surfaceArea) * integValue;
-                        fe[3*m+1] += (elementWeight[elementID] * elementGravity.y[elementID] / surfaceArea) * integValue;
-                        fe[3*m+2] += (elementWeight[elementID] * elementGravity.z[elementID] / surfaceArea) * integValue;
-                        // Own weight
-                        if (surfaceThickness > 0.0)
+                        // Mass
+                        if (surfaceThickness > 0.0 && (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL))
                         {
-                            fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
-                            fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
-                            fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
+                            RRMatrix::mlt(Rt,Met,MeRt);
+                            RRMatrix::mlt(MeRt,RtT,Me,true);
                         }
-
-                        // Thermal expansion
-                        if (surfaceThickness > 0.0)
+                        if (!this->computableElements[elementID])
                         {
-                            fet.fill(0.0);
-                            for (uint n=0;n<3;n++)
-                            {
-                                fet[2*m+0] += this->elementThermalExpansion[elementID] * dT * BeD[2*m+0][n] * surfaceThickness * detJ * shapeFunc.getW();
-                                fet[2*m+1] += this->elementThermalExpansion[elementID] * dT * BeD[2*m+1][n] * surfaceThickness * detJ * shapeFunc.getW();
-                            }
-
-                            fe[3*m+0] += Rt[3*m+0][0]*fet[2*m+0] + Rt[3*m+0][1]*fet[2*m+1];
-                            fe[3*m+1] += Rt[3*m+1][0]*fet[2*m+0] + Rt[3*m+1][1]*fet[2*m+1];
-                            fe[3*m+2] += Rt[3*m+2][0]*fet[2*m+0] + Rt[3*m+2][1]*fet[2*m+1];
+                            Me.fill(0.0);
+                            Ke.fill(0.0);
                         }
                     }
-
-                    // Mass
-                    if (surfaceThickness > 0.0 && (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL))
-                    {
-                        RRMatrix::mlt(Rt,Met,MeRt);
-                        RRMatrix::mlt(MeRt,RtT,Me,true);
-                    }
-                    if (!this->computableElements[elementID])
-                    {
-                        Me.fill(0.0);
-                        Ke.fill(0.0);
-                    }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
+                    #pragma omp flush (abort)
                 }
-                #pragma omp flush (abort)
             }
         }
         if (abort)
@@ -613,137 +633,143 @@ void RSolverStress::prepare(void)
     {
         RVolume &volume = this->pModel->getVolume(i);
 
+        std::vector< std::vector<uint> > elementBatches = this->findElementColorBatches(volume);
+
         bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        for (uint c=0;c<elementBatches.size();c++)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
+            const std::vector<uint> &elementIDs = elementBatches[c];
+            #pragma omp parallel for default(shared)
+            for (int64_t j=0;j<int64_t(elementIDs.size());j++)
             {
-                uint elementID = volume.get(uint(j));
-
-                if (!this->computableElements[elementID])
+                #pragma omp flush (abort)
+                if (abort)
                 {
                     continue;
                 }
+                try
+                {
+                    uint elementID = volume.get(uint(j));
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size()*3,element.size()*3);
-                RRMatrix Ke(element.size()*3,element.size()*3);
-                RRVector fe(element.size()*3);
+                    if (!this->computableElements[elementID])
+                    {
+                        continue;
+                    }
 
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+                    const RElement &element = this->pModel->getElement(elementID);
+                    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
+                    uint nInp = RElement::getNIntegrationPoints(element.getType());
+                    RRMatrix Me(element.size()*3,element.size()*3);
+                    RRMatrix Ke(element.size()*3,element.size()*3);
+                    RRVector fe(element.size()*3);
 
-                RRMatrix B(element.size(),3);
-                RRMatrix Be(element.size()*3,6);
-                RRMatrix BeT(6,element.size()*3);
-                RRMatrix BeD(element.size()*3,6);
-                RRMatrix Ket(element.size()*3,element.size()*3);
+                    Me.fill(0.0);
+                    Ke.fill(0.0);
+                    fe.fill(0.0);
 
-                RRMatrix De(6,6);
-                De.fill(0.0);
+                    RRSmallMatrix B(element.size(),3);
+                    RRSmallMatrix Be(element.size()*3,6);
+                    RRSmallMatrix BeD(element.size()*3,6);
 
-                double E = this->elementElasticityModulus[elementID];
-                double v = this->elementPoissonRatio[elementID];
+                    RRSmallMatrix De(6,6);
+                    De.fill(0.0);
 
-                De[0][0] = 1.0-v; De[0][1] = v;     De[0][2] = v;
-                De[1][0] = v;     De[1][1] = 1.0-v; De[1][2] = v;
-                De[2][0] = v;     De[2][1] = v;     De[2][2] = 1.0-v;
-                De[3][3] = De[4][4] = De[5][5] = (1.0-2.0*v)/2.0;
-                De *= E/((1.0+v)*(1.0-2.0*v));
+                    double E = this->elementElasticityModulus[elementID];
+                    double v = this->elementPoissonRatio[elementID];
 
-                double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
+                    De[0][0] = 1.0-v; De[0][1] = v;     De[0][2] = v;
+                    De[1][0] = v;     De[1][1] = 1.0-v; De[1][2] = v;
+                    De[2][0] = v;     De[2][1] = v;     De[2][2] = 1.0-v;
+                    De[3][3] = De[4][4] = De[5][5] = (1.0-2.0*v)/2.0;
+                    De *= E/((1.0+v)*(1.0-2.0*v));
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
 
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    for (uint k=0;k<nInp;k++)
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
-                    }
-
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        Be[3*m+0][0] = B[m][0];   Be[3*m+1][0] = 0.0;       Be[3*m+2][0] = 0.0;
-                        Be[3*m+0][1] = 0.0;       Be[3*m+1][1] = B[m][1];   Be[3*m+2][1] = 0.0;
-                        Be[3*m+0][2] = 0.0;       Be[3*m+1][2] = 0.0;       Be[3*m+2][2] = B[m][2];
-                        Be[3*m+0][3] = 0.0;       Be[3*m+1][3] = B[m][2];   Be[3*m+2][3] = B[m][1];
-                        Be[3*m+0][4] = B[m][2];   Be[3*m+1][4] = 0.0;       Be[3*m+2][4] = B[m][0];
-                        Be[3*m+0][5] = B[m][1];   Be[3*m+1][5] = B[m][0];   Be[3*m+2][5] = 0.0;
-                    }
-                    BeT.transpose(Be);
+                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                        const RRVector &N = shapeFunc.getN();
+                        double detJ = geometryCache.findShapeDerivatives(elementID,k,B);
 
-                    RRMatrix::mlt(Be,De,BeD);
-                    RRMatrix::mlt(BeD,BeT,Ket);
-                    for (uint m=0;m<3*element.size();m++)
-                    {
-                        for (uint n=0;n<3*element.size();n++)
+                        for (uint m=0;m<element.size();m++)
                         {
-                            // Stiffness matrix
-                            Ke[m][n] += Ket[m][n] * detJ * shapeFunc.getW();
+                            Be[3*m+0][0] = B[m][0];   Be[3*m+1][0] = 0.0;       Be[3*m+2][0] = 0.0;
+                            Be[3*m+0][1] = 0.0;       Be[3*m+1][1] = B[m][1];   Be[3*m+2][1] = 0.0;
+                            Be[3*m+0][2] = 0.0;       Be[3*m+1][2] = 0.0;       Be[3*m+2][2] = B[m][2];
+                            Be[3*m+0][3] = 0.0;       Be[3*m+1][3] = B[m][2];   Be[3*m+2][3] = B[m][1];
+                            Be[3*m+0][4] = B[m][2];   Be[3*m+1][4] = 0.0;       Be[3*m+2][4] = B[m][0];
+                            Be[3*m+0][5] = B[m][1];   Be[3*m+1][5] = B[m][0];   Be[3*m+2][5] = 0.0;
                         }
-                    }
 
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        for (uint n=0;n<element.size();n++)
+                        // BeD = Be * De
+                        for (uint m=0;m<3*element.size();m++)
                         {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
+                            for (uint n=0;n<6;n++)
                             {
-                                double value = N[m] * N[n]
-                                             * this->elementDensity[elementID]
-                                             * detJ
-                                             * shapeFunc.getW();
-                                Me[3*m+0][3*n+0] += value;
-                                Me[3*m+1][3*n+1] += value;
-                                Me[3*m+2][3*n+2] += value;
+                                double value = 0.0;
+                                for (uint l=0;l<6;l++)
+                                {
+                                    value += Be[m][l] * De[l][n];
+                                }
+                                BeD[m][n] = value;
+                            }
+                        }
+                        // Stiffness matrix Ke += BeD * Be^T
+                        for (uint m=0;m<3*element.size();m++)
+                        {
+                            for (uint n=0;n<3*element.size();n++)
+                            {
+                                double value = 0.0;
+                                for (uint l=0;l<6;l++)
+                                {
+                                    value += BeD[m][l] * Be[n][l];
+                                }
+                                Ke[m][n] += value * detJ * shapeFunc.getW();
                             }
                         }
 
-                        // Own weight
-                        fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * N[m] * detJ * shapeFunc.getW();
-                        fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * N[m] * detJ * shapeFunc.getW();
-                        fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * N[m] * detJ * shapeFunc.getW();
-
-                        // Thermal expansion
-                        for (uint n=0;n<3;n++)
+                        for (uint m=0;m<element.size();m++)
                         {
-                            fe[3*m+0] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+0][n] * detJ * shapeFunc.getW();
-                            fe[3*m+1] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+1][n] * detJ * shapeFunc.getW();
-                            fe[3*m+2] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+2][n] * detJ * shapeFunc.getW();
+                            for (uint n=0;n<element.size();n++)
+                            {
+                                // Mass
+                                if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
+                                {
+                                    double value = N[m] * N[n]
+                                                 * this->elementDensity[elementID]
+                                                 * detJ
+                                                 * shapeFunc.getW();
+                                    Me[3*m+0][3*n+0] += value;
+                                    Me[3*m+1][3*n+1] += value;
+                                    Me[3*m+2][3*n+2] += value;
+                                }
+                            }
+
+                            // Own weight
+                            fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * N[m] * detJ * shapeFunc.getW();
+                            fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * N[m] * detJ * shapeFunc.getW();
+                            fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * N[m] * detJ * shapeFunc.getW();
+
+                            // Thermal expansion
+                            for (uint n=0;n<3;n++)
+                            {
+                                fe[3*m+0] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+0][n] * detJ * shapeFunc.getW();
+                                fe[3*m+1] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+1][n] * detJ * shapeFunc.getW();
+                                fe[3*m+2] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+2][n] * detJ * shapeFunc.getW();
+                            }
                         }
                     }
-                }
-                #pragma omp critical
-                {
                     this->assemblyMatrix(elementID,Me,Ke,fe);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                catch (const RError &rError)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    #pragma omp critical
+                    {
+                        RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                        abort = true;
+                    }
+                    #pragma omp flush (abort)
                 }
-                #pragma omp flush (abort)
             }
         }
         if (abort)
@@ -787,8 +813,23 @@ void RSolverStress::solveStressStrain(void)
     try
     {
         RLogger::indent();
-        RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,3);
+        const RMatrixSolverConf &matrixSolverConf = this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG);
+        RMatrixSolver matrixSolver(matrixSolverConf);
+        matrixSolver.setDirectSolver(&this->directSolver);
+        if (matrixSolverConf.getPreconditionerType() == R_MATRIX_PRECONDITIONER_ALGEBRAIC_MULTIGRID)
+        {
+            std::vector<RRVector> rigidBodyModes;
+            std::vector<uint> rowBlockIndexes;
+            this->findRigidBodyModes(rigidBodyModes,rowBlockIndexes);
+            matrixSolver.setNearNullSpace(rigidBodyModes,rowBlockIndexes);
+        }
+        else
+        {
+            std::vector<uint> rowBlockIndexes;
+            this->findRowBlockIndexes(3,rowBlockIndexes);
+            matrixSolver.setRowBlockIndexes(rowBlockIndexes);
+        }
+        matrixSolver.solve(this->A,this->b,this->x,matrixSolverConf.getPreconditionerType(),3);
         RLogger::unindent();
     }
     catch (const RError &error)
@@ -1271,6 +1312,8 @@ void RSolverStress::process(void)
         }
     }
 
+    const RElementGeometryCache &geometryCache = this->getGeometryCache();
+
     // Process volume elements.
     for (uint i=0;i<this->pModel->getNVolumes();i++)
     {
@@ -1304,7 +1347,7 @@ void RSolverStress::process(void)
                 RRVector xe(element.size()*3,0.0);
                 RRVector Qe(6,0.0);
 
-                RRMatrix B(element.size(),3);
+                RRSmallMatrix B(element.size(),3);
                 RRMatrix Be(element.size()*3,6);
                 RRMatrix BeT(6,element.size()*3);
                 RRMatrix BeD(element.size()*3,6);
@@ -1338,17 +1381,7 @@ void RSolverStress::process(void)
                 {
                     const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
                     const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
-                    {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
-                    }
+                    double detJ = geometryCache.findShapeDerivatives(elementID,k,B);
 
                     for (uint m=0;m<element.size();m++)
                     {
@@ -1651,15 +1684,15 @@ void RSolverStress::generateNodeBook(void)
                 uint nodeId = element.getNodeId(k);
                 if (hasDisplacementX)
                 {
-                    this->nodeBook.disable(3*nodeId+0,true);
+                    this->nodeBook.disable(3*nodeId+0,false);
                 }
                 if (hasDisplacementY)
                 {
-                    this->nodeBook.disable(3*nodeId+1,true);
+                    this->nodeBook.disable(3*nodeId+1,false);
                 }
                 if (hasDisplacementZ)
                 {
-                    this->nodeBook.disable(3*nodeId+2,true);
+                    this->nodeBook.disable(3*nodeId+2,false);
                 }
             }
         }
@@ -1680,11 +1713,13 @@ void RSolverStress::generateNodeBook(void)
     {
         if (!computableNodes[i])
         {
-            this->nodeBook.disable(3*i+0,true);
-            this->nodeBook.disable(3*i+1,true);
-            this->nodeBook.disable(3*i+2,true);
+            this->nodeBook.disable(3*i+0,false);
+            this->nodeBook.disable(3*i+1,false);
+            this->nodeBook.disable(3*i+2,false);
         }
     }
+
+    this->renumberNodeBook(3);
 }
 
 void RSolverStress::assemblyMatrix(uint elementID, const RRMatrix &Me, const RRMatrix &Ke, const RRVector &fe)
@@ -1867,3 +1902,66 @@ void RSolverStress::applyLocalRotations(unsigned int elementID, RRVector &fe)
         fe = fetmp;
     }
 }
+
+void RSolverStress::findRigidBodyModes(std::vector<RRVector> &rigidBodyModes, std::vector<uint> &rowBlockIndexes) const
+{
+    uint nNodes = this->pModel->getNNodes();
+    uint nRows = this->nodeBook.getNEnabled();
+
+    // Rotations are taken around center of nodes to keep modes well scaled.
+    RR3Vector center(0.0,0.0,0.0);
+    for (uint i=0;i<nNodes;i++)
+    {
+        center[0] += this->pModel->getNode(i).getX();
+        center[1] += this->pModel->getNode(i).getY();
+        center[2] += this->pModel->getNode(i).getZ();
+    }
+    if (nNodes > 0)
+    {
+        center[0] /= double(nNodes);
+        center[1] /= double(nNodes);
+        center[2] /= double(nNodes);
+    }
+
+    rigidBodyModes.assign(6,RRVector(nRows,0.0));
+    rowBlockIndexes.assign(nRows,0);
+
+    for (uint i=0;i<nNodes;i++)
+    {
+        double x = this->pModel->getNode(i).getX() - center[0];
+        double y = this->pModel->getNode(i).getY() - center[1];
+        double z = this->pModel->getNode(i).getZ() - center[2];
+
+        // Node displacement for translations in x, y, z and rotations around x, y, z.
+        double u[6][3] = { { 1.0, 0.0, 0.0 },
+                           { 0.0, 1.0, 0.0 },
+                           { 0.0, 0.0, 1.0 },
+                           { 0.0,  -z,   y },
+                           {   z, 0.0,  -x },
+                           {  -y,   x, 0.0 } };
+
+        for (uint m=0;m<6;m++)
+        {
+            RR3Vector du(u[m][0],u[m][1],u[m][2]);
+
+            if (this->localRotations[i].isActive())
+            {
+                const RRMatrix &iR = this->localRotations[i].getInverseR();
+                for (uint j=0;j<3;j++)
+                {
+                    du[j] = iR[j][0] * u[m][0] + iR[j][1] * u[m][1] + iR[j][2] * u[m][2];
+                }
+            }
+
+            for (uint j=0;j<3;j++)
+            {
+                uint position;
+                if (this->nodeBook.getValue(3*i+j,position))
+                {
+                    rigidBodyModes[m][position] = du[j];
+                    rowBlockIndexes[position] = i;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,807 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsparsedirectsolver.cpp                                  *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Sparse direct solver class definition               *
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <omp.h>
+
+#include "rsparsedirectsolver.h"
+
+//! Minimum size of update matrix for which its computation is parallelized.
+static const uint parallelUpdateSize = 128;
+//! Relative size of LU pivot below which pivot is perturbed.
+static const double pivotPerturbation = 1.0e-8;
+
+void RSparseDirectSolver::_init(const RSparseDirectSolver *pSparseDirectSolver)
+{
+    if (pSparseDirectSolver)
+    {
+        this->symmetric = pSparseDirectSolver->symmetric;
+        this->nPerturbedPivots = pSparseDirectSolver->nPerturbedPivots;
+        this->matrix = pSparseDirectSolver->matrix;
+        this->factorized = pSparseDirectSolver->factorized;
+        this->permutation = pSparseDirectSolver->permutation;
+        this->inversePermutation = pSparseDirectSolver->inversePermutation;
+        this->supernodePointers = pSparseDirectSolver->supernodePointers;
+        this->levelPointers = pSparseDirectSolver->levelPointers;
+        this->levelSupernodes = pSparseDirectSolver->levelSupernodes;
+        this->supernodeParents = pSparseDirectSolver->supernodeParents;
+        this->childPointers = pSparseDirectSolver->childPointers;
+        this->children = pSparseDirectSolver->children;
+        this->rowIndexPointers = pSparseDirectSolver->rowIndexPointers;
+        this->rowIndexes = pSparseDirectSolver->rowIndexes;
+        this->valuePointers = pSparseDirectSolver->valuePointers;
+        this->lValues = pSparseDirectSolver->lValues;
+        this->uValues = pSparseDirectSolver->uValues;
+    }
+}
+
+RSparseDirectSolver::RSparseDirectSolver()
+    : symmetric(true)
+    , nPerturbedPivots(0)
+    , factorized(false)
+{
+    this->_init();
+}
+
+RSparseDirectSolver::RSparseDirectSolver(const RSparseDirectSolver &sparseDirectSolver)
+{
+    this->_init(&sparseDirectSolver);
+}
+
+RSparseDirectSolver::~RSparseDirectSolver()
+{
+}
+
+RSparseDirectSolver &RSparseDirectSolver::operator =(const RSparseDirectSolver &sparseDirectSolver)
+{
+    this->_init(&sparseDirectSolver);
+    return (*this);
+}
+
+void RSparseDirectSolver::factorize(const RSparseMatrixCSR &A, bool symmetric)
+{
+    if (this->isFactorized(A,symmetric))
+    {
+        RLogger::info("Reusing matrix factorization.\n");
+        return;
+    }
+
+    bool reuseAnalysis = (!this->supernodePointers.empty() && this->hasSamePattern(A));
+
+    this->matrix = A;
+    this->symmetric = symmetric;
+    this->factorized = false;
+
+    if (reuseAnalysis)
+    {
+        RLogger::info("Reusing symbolic factorization.\n");
+    }
+    else
+    {
+        this->analyze();
+    }
+
+    if (!this->computeNumeric())
+    {
+        RLogger::warning("Cholesky factorization failed, matrix is not positive definite. Switching to LU factorization.\n");
+        this->symmetric = false;
+        this->computeNumeric();
+    }
+
+    this->factorized = true;
+
+    RLogger::info("Factor values = %.0f\n",double(this->getNFactorValues()));
+}
+
+bool RSparseDirectSolver::isFactorized(const RSparseMatrixCSR &A, bool symmetric) const
+{
+    // LU factorization is valid for both symmetric and unsymmetric request.
+    if (!this->factorized || (symmetric != this->symmetric && this->symmetric))
+    {
+        return false;
+    }
+    return (this->hasSamePattern(A) && A.getValues() == this->matrix.getValues());
+}
+
+void RSparseDirectSolver::solve(const RRVector &b, RRVector &x) const
+{
+    if (!this->factorized)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Matrix has not been factorized.");
+    }
+
+    uint n = uint(this->permutation.size());
+    uint nSupernodes = uint(this->supernodePointers.size()) - 1;
+
+    if (b.size() != n)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Size of right hand side vector (%u) differs from number of matrix rows (%u).",b.getNRows(),n);
+    }
+
+    RRVector y(n);
+    for (uint i=0;i<n;i++)
+    {
+        y[i] = b[this->permutation[i]];
+    }
+
+    // Forward substitution L*z = y
+    for (uint s=0;s<nSupernodes;s++)
+    {
+        uint first = this->supernodePointers[s];
+        uint ns = this->supernodePointers[s+1] - first;
+        uint nf = this->rowIndexPointers[s+1] - this->rowIndexPointers[s];
+        const uint *rows = this->rowIndexes.data() + this->rowIndexPointers[s];
+        const double *L = this->lValues.data() + this->valuePointers[s];
+
+        for (uint k=0;k<ns;k++)
+        {
+            const double *Lk = L + size_t(k)*nf;
+            if (this->symmetric)
+            {
+                y[first+k] /= Lk[k];
+            }
+            double value = y[first+k];
+            if (value != 0.0)
+            {
+                for (uint i=k+1;i<nf;i++)
+                {
+                    y[rows[i]] -= Lk[i] * value;
+                }
+            }
+        }
+    }
+
+    // Backward substitution U*x = z
+    for (uint s=nSupernodes;s>0;s--)
+    {
+        uint first = this->supernodePointers[s-1];
+        uint ns = this->supernodePointers[s] - first;
+        uint nf = this->rowIndexPointers[s] - this->rowIndexPointers[s-1];
+        const uint *rows = this->rowIndexes.data() + this->rowIndexPointers[s-1];
+        const double *U = (this->symmetric ? this->lValues.data() : this->uValues.data()) + this->valuePointers[s-1];
+
+        for (uint k=ns;k>0;k--)
+        {
+            const double *Uk = U + size_t(k-1)*nf;
+            double value = y[first+k-1];
+            for (uint i=k;i<nf;i++)
+            {
+                value -= Uk[i] * y[rows[i]];
+            }
+            y[first+k-1] = value / Uk[k-1];
+        }
+    }
+
+    x.resize(n);
+    for (uint i=0;i<n;i++)
+    {
+        x[this->permutation[i]] = y[i];
+    }
+}
+
+uint RSparseDirectSolver::getNPerturbedPivots(void) const
+{
+    return this->nPerturbedPivots;
+}
+
+size_t RSparseDirectSolver::getNFactorValues(void) const
+{
+    return this->lValues.size() + this->uValues.size();
+}
+
+void RSparseDirectSolver::clear(void)
+{
+    this->matrix.clear();
+    this->nPerturbedPivots = 0;
+    this->factorized = false;
+    this->permutation.clear();
+    this->inversePermutation.clear();
+    this->supernodePointers.clear();
+    this->levelPointers.clear();
+    this->levelSupernodes.clear();
+    this->supernodeParents.clear();
+    this->childPointers.clear();
+    this->children.clear();
+    this->rowIndexPointers.clear();
+    this->rowIndexes.clear();
+    this->valuePointers.clear();
+    this->lValues.clear();
+    this->uValues.clear();
+}
+
+bool RSparseDirectSolver::hasSamePattern(const RSparseMatrixCSR &A) const
+{
+    return (A.getRowPointers() == this->matrix.getRowPointers() && A.getColumnIndexes() == this->matrix.getColumnIndexes());
+}
+
+void RSparseDirectSolver::analyze(void)
+{
+    uint n = this->matrix.getNRows();
+
+    // Graph of A+A^T without diagonal.
+    RSparseMatrixCSR T;
+    RSparseMatrixCSR::transpose(this->matrix,n,T);
+
+    std::vector<uint> adjacencyPointers(n+1,0);
+    std::vector<uint> adjacency;
+
+    for (uint pass=0;pass<2;pass++)
+    {
+#pragma omp parallel for default(shared)
+        for (int64_t i=0;i<int64_t(n);i++)
+        {
+            uint p = this->matrix.getRowBegin(uint(i));
+            uint q = T.getRowBegin(uint(i));
+            uint nValues = 0;
+            while (p < this->matrix.getRowEnd(uint(i)) || q < T.getRowEnd(uint(i)))
+            {
+                uint j;
+                if (q >= T.getRowEnd(uint(i)) || (p < this->matrix.getRowEnd(uint(i)) && this->matrix.getColumnIndex(p) < T.getColumnIndex(q)))
+                {
+                    j = this->matrix.getColumnIndex(p++);
+                }
+                else if (p >= this->matrix.getRowEnd(uint(i)) || T.getColumnIndex(q) < this->matrix.getColumnIndex(p))
+                {
+                    j = T.getColumnIndex(q++);
+                }
+                else
+                {
+                    j = this->matrix.getColumnIndex(p++);
+                    q++;
+                }
+                if (j != uint(i))
+                {
+                    if (pass == 1)
+                    {
+                        adjacency[adjacencyPointers[i]+nValues] = j;
+                    }
+                    nValues++;
+                }
+            }
+            if (pass == 0)
+            {
+                adjacencyPointers[i+1] = nValues;
+            }
+        }
+        if (pass == 0)
+        {
+            for (uint i=0;i<n;i++)
+            {
+                adjacencyPointers[i+1] += adjacencyPointers[i];
+            }
+            adjacency.resize(adjacencyPointers[n]);
+        }
+    }
+    T.clear();
+
+    // Fill-reducing ordering.
+    std::vector<uint> ordering;
+    RGraphOrdering::findNestedDissection(adjacencyPointers,adjacency,ordering);
+
+    std::vector<uint> inverseOrdering(n);
+    for (uint i=0;i<n;i++)
+    {
+        inverseOrdering[ordering[i]] = i;
+    }
+
+    // Elimination tree.
+    std::vector<uint> parents(n,RConstants::eod);
+    std::vector<uint> ancestors(n,RConstants::eod);
+    for (uint k=0;k<n;k++)
+    {
+        uint v = ordering[k];
+        for (uint p=adjacencyPointers[v];p<adjacencyPointers[v+1];p++)
+        {
+            uint i = inverseOrdering[adjacency[p]];
+            while (i < k)
+            {
+                uint next = ancestors[i];
+                ancestors[i] = k;
+                if (next == RConstants::eod)
+                {
+                    parents[i] = k;
+                    break;
+                }
+                i = next;
+            }
+        }
+    }
+    ancestors.clear();
+
+    // Postorder of elimination tree.
+    std::vector<uint> treeChildPointers(n+1,0);
+    for (uint i=0;i<n;i++)
+    {
+        if (parents[i] != RConstants::eod)
+        {
+            treeChildPointers[parents[i]+1]++;
+        }
+    }
+    for (uint i=0;i<n;i++)
+    {
+        treeChildPointers[i+1] += treeChildPointers[i];
+    }
+    std::vector<uint> treeChildren(treeChildPointers[n]);
+    std::vector<uint> childPositions(treeChildPointers.begin(),treeChildPointers.end()-1);
+    for (uint i=0;i<n;i++)
+    {
+        if (parents[i] != RConstants::eod)
+        {
+            treeChildren[childPositions[parents[i]]++] = i;
+        }
+    }
+
+    std::vector<uint> postorder;
+    postorder.reserve(n);
+    std::vector<uint> stack;
+    for (uint root=0;root<n;root++)
+    {
+        if (parents[root] != RConstants::eod)
+        {
+            continue;
+        }
+        stack.push_back(root);
+        childPositions[root] = treeChildPointers[root];
+        while (!stack.empty())
+        {
+            uint v = stack.back();
+            if (childPositions[v] < treeChildPointers[v+1])
+            {
+                uint c = treeChildren[childPositions[v]++];
+                childPositions[c] = treeChildPointers[c];
+                stack.push_back(c);
+            }
+            else
+            {
+                postorder.push_back(v);
+                stack.pop_back();
+            }
+        }
+    }
+
+    std::vector<uint> inversePostorder(n);
+    for (uint i=0;i<n;i++)
+    {
+        inversePostorder[postorder[i]] = i;
+    }
+
+    this->permutation.resize(n);
+    this->inversePermutation.resize(n);
+    std::vector<uint> postParents(n,RConstants::eod);
+    std::vector<uint> nChildren(n,0);
+    for (uint i=0;i<n;i++)
+    {
+        this->permutation[i] = ordering[postorder[i]];
+        this->inversePermutation[this->permutation[i]] = i;
+        if (parents[postorder[i]] != RConstants::eod)
+        {
+            postParents[i] = inversePostorder[parents[postorder[i]]];
+            nChildren[postParents[i]]++;
+        }
+    }
+    parents.swap(postParents);
+
+    // Column structure of L is union of lower adjacency and structures of children without them.
+    // Columns are processed in postorder so structures of children are on top of the stack.
+    std::vector<uint> columnCounts(n,0);
+    std::vector<uint> supernodeOf(n,0);
+    std::vector<uint> marks(n,RConstants::eod);
+    uint nSupernodes = 0;
+
+    for (uint pass=0;pass<2;pass++)
+    {
+        std::vector< std::vector<uint> > structures;
+        std::vector<uint> structure;
+
+        if (pass == 1)
+        {
+            this->rowIndexPointers.assign(1,0);
+            this->rowIndexes.clear();
+        }
+
+        for (uint j=0;j<n;j++)
+        {
+            structure.clear();
+            structure.push_back(j);
+            marks[j] = j;
+
+            uint v = this->permutation[j];
+            for (uint p=adjacencyPointers[v];p<adjacencyPointers[v+1];p++)
+            {
+                uint i = this->inversePermutation[adjacency[p]];
+                if (i > j && marks[i] != j)
+                {
+                    marks[i] = j;
+                    structure.push_back(i);
+                }
+            }
+            for (uint c=0;c<nChildren[j];c++)
+            {
+                const std::vector<uint> &childStructure = structures.back();
+                for (uint k=1;k<childStructure.size();k++)
+                {
+                    uint i = childStructure[k];
+                    if (marks[i] != j)
+                    {
+                        marks[i] = j;
+                        structure.push_back(i);
+                    }
+                }
+                structures.pop_back();
+            }
+            std::sort(structure.begin(),structure.end());
+
+            if (pass == 0)
+            {
+                columnCounts[j] = uint(structure.size());
+            }
+            else if (j == this->supernodePointers[supernodeOf[j]])
+            {
+                this->rowIndexes.insert(this->rowIndexes.end(),structure.begin(),structure.end());
+                this->rowIndexPointers.push_back(uint(this->rowIndexes.size()));
+            }
+
+            if (parents[j] != RConstants::eod)
+            {
+                structures.push_back(structure);
+            }
+        }
+
+        std::fill(marks.begin(),marks.end(),RConstants::eod);
+
+        if (pass == 0)
+        {
+            // Fundamental supernodes.
+            this->supernodePointers.assign(1,0);
+            for (uint j=0;j<n;j++)
+            {
+                if (j > 0 && parents[j-1] == j && nChildren[j] == 1 && columnCounts[j-1] == columnCounts[j] + 1)
+                {
+                    supernodeOf[j] = supernodeOf[j-1];
+                    this->supernodePointers.back() = j + 1;
+                }
+                else
+                {
+                    supernodeOf[j] = nSupernodes++;
+                    this->supernodePointers.push_back(j + 1);
+                }
+            }
+        }
+    }
+
+    // Supernodal elimination tree.
+    this->supernodeParents.assign(nSupernodes,RConstants::eod);
+    this->childPointers.assign(nSupernodes+1,0);
+    for (uint s=0;s<nSupernodes;s++)
+    {
+        uint last = this->supernodePointers[s+1] - 1;
+        if (parents[last] != RConstants::eod)
+        {
+            this->supernodeParents[s] = supernodeOf[parents[last]];
+            this->childPointers[this->supernodeParents[s]+1]++;
+        }
+    }
+    for (uint s=0;s<nSupernodes;s++)
+    {
+        this->childPointers[s+1] += this->childPointers[s];
+    }
+    this->children.resize(this->childPointers[nSupernodes]);
+    std::vector<uint> supernodeChildPositions(this->childPointers.begin(),this->childPointers.end()-1);
+    for (uint s=0;s<nSupernodes;s++)
+    {
+        if (this->supernodeParents[s] != RConstants::eod)
+        {
+            this->children[supernodeChildPositions[this->supernodeParents[s]]++] = s;
+        }
+    }
+
+    // Group supernodes by height, supernodes with the same height are independent.
+    std::vector<uint> heights(nSupernodes,0);
+    uint nLevels = 0;
+    for (uint s=0;s<nSupernodes;s++)
+    {
+        nLevels = std::max(nLevels,heights[s]+1);
+        if (this->supernodeParents[s] != RConstants::eod)
+        {
+            heights[this->supernodeParents[s]] = std::max(heights[this->supernodeParents[s]],heights[s]+1);
+        }
+    }
+    this->levelPointers.assign(nLevels+1,0);
+    for (uint s=0;s<nSupernodes;s++)
+    {
+        this->levelPointers[heights[s]+1]++;
+    }
+    for (uint l=0;l<nLevels;l++)
+    {
+        this->levelPointers[l+1] += this->levelPointers[l];
+    }
+    this->levelSupernodes.resize(nSupernodes);
+    std::vector<uint> levelPositions(this->levelPointers.begin(),this->levelPointers.end()-1);
+    for (uint s=0;s<nSupernodes;s++)
+    {
+        this->levelSupernodes[levelPositions[heights[s]]++] = s;
+    }
+
+    // Factor storage.
+    this->valuePointers.assign(nSupernodes+1,0);
+    for (uint s=0;s<nSupernodes;s++)
+    {
+        size_t ns = this->supernodePointers[s+1] - this->supernodePointers[s];
+        size_t nf = this->rowIndexPointers[s+1] - this->rowIndexPointers[s];
+        this->valuePointers[s+1] = this->valuePointers[s] + ns * nf;
+    }
+
+    RLogger::info("Supernodes = %u, elimination tree levels = %u\n",nSupernodes,nLevels);
+}
+
+bool RSparseDirectSolver::computeNumeric(void)
+{
+    uint n = this->matrix.getNRows();
+    uint nSupernodes = uint(this->supernodePointers.size()) - 1;
+
+    RSparseMatrixCSR T;
+    if (!this->symmetric)
+    {
+        RSparseMatrixCSR::transpose(this->matrix,n,T);
+    }
+
+    double maxValue = 0.0;
+    for (uint k=0;k<this->matrix.getNValues();k++)
+    {
+        maxValue = std::max(maxValue,std::abs(this->matrix.getValue(k)));
+    }
+    double pivotTolerance = pivotPerturbation * maxValue;
+
+    this->lValues.resize(this->valuePointers[nSupernodes]);
+    if (this->symmetric)
+    {
+        this->uValues.clear();
+        this->uValues.shrink_to_fit();
+    }
+    else
+    {
+        this->uValues.resize(this->valuePointers[nSupernodes]);
+    }
+
+    std::vector< std::vector<double> > updateMatrices(nSupernodes);
+    uint nPerturbedPivots = 0;
+    bool failed = false;
+    uint nThreads = uint(omp_get_max_threads());
+
+    for (uint l=0;l+1<this->levelPointers.size() && !failed;l++)
+    {
+        uint levelBegin = this->levelPointers[l];
+        uint levelEnd = this->levelPointers[l+1];
+
+        // Many independent supernodes are processed in parallel, few large ones use parallel dense update.
+        bool parallelLevel = (levelEnd - levelBegin >= nThreads);
+
+#pragma omp parallel for default(shared) schedule(dynamic) if(parallelLevel) reduction(+:nPerturbedPivots)
+        for (int64_t p=levelBegin;p<int64_t(levelEnd);p++)
+        {
+            if (!this->factorizeSupernode(this->levelSupernodes[p],T,pivotTolerance,!parallelLevel,updateMatrices,nPerturbedPivots))
+            {
+#pragma omp atomic write
+                failed = true;
+            }
+        }
+    }
+
+    if (failed)
+    {
+        return false;
+    }
+
+    if (nPerturbedPivots > 0)
+    {
+        RLogger::warning("Number of perturbed pivots = %u\n",nPerturbedPivots);
+    }
+    this->nPerturbedPivots = nPerturbedPivots;
+
+    return true;
+}
+
+bool RSparseDirectSolver::factorizeSupernode(uint supernode,
+                                             const RSparseMatrixCSR &transposedMatrix,
+                                             double pivotTolerance,
+                                             bool parallel,
+                                             std::vector< std::vector<double> > &updateMatrices,
+                                             uint &nPerturbedPivots)
+{
+    uint first = this->supernodePointers[supernode];
+    uint ns = this->supernodePointers[supernode+1] - first;
+    uint nf = this->rowIndexPointers[supernode+1] - this->rowIndexPointers[supernode];
+    const uint *rows = this->rowIndexes.data() + this->rowIndexPointers[supernode];
+
+    // Dense frontal matrix in column-major order.
+    std::vector<double> F(size_t(nf)*nf,0.0);
+
+    // Assemble original matrix values.
+    const RSparseMatrixCSR &lowerMatrix = this->symmetric ? this->matrix : transposedMatrix;
+    for (uint k=0;k<ns;k++)
+    {
+        uint j = first + k;
+        uint v = this->permutation[j];
+
+        // Column j (row v of A^T, for symmetric matrix equal to row v of A).
+        for (uint p=lowerMatrix.getRowBegin(v);p<lowerMatrix.getRowEnd(v);p++)
+        {
+            uint i = this->inversePermutation[lowerMatrix.getColumnIndex(p)];
+            if (i >= j)
+            {
+                uint li = uint(std::lower_bound(rows,rows+nf,i) - rows);
+                F[li + size_t(k)*nf] += lowerMatrix.getValue(p);
+            }
+        }
+
+        if (!this->symmetric)
+        {
+            // Row j.
+            for (uint p=this->matrix.getRowBegin(v);p<this->matrix.getRowEnd(v);p++)
+            {
+                uint i = this->inversePermutation[this->matrix.getColumnIndex(p)];
+                if (i > j)
+                {
+                    uint li = uint(std::lower_bound(rows,rows+nf,i) - rows);
+                    F[k + size_t(li)*nf] += this->matrix.getValue(p);
+                }
+            }
+        }
+    }
+
+    // Extend-add update matrices of children.
+    std::vector<uint> positions;
+    for (uint c=this->childPointers[supernode];c<this->childPointers[supernode+1];c++)
+    {
+        uint child = this->children[c];
+        uint nsc = this->supernodePointers[child+1] - this->supernodePointers[child];
+        uint nfc = this->rowIndexPointers[child+1] - this->rowIndexPointers[child];
+        const uint *childRows = this->rowIndexes.data() + this->rowIndexPointers[child] + nsc;
+        uint m = nfc - nsc;
+
+        // Child rows are subset of parent rows, both are sorted.
+        positions.resize(m);
+        uint li = 0;
+        for (uint i=0;i<m;i++)
+        {
+            while (rows[li] != childRows[i])
+            {
+                li++;
+            }
+            positions[i] = li;
+        }
+
+        const std::vector<double> &U = updateMatrices[child];
+        for (uint jj=0;jj<m;jj++)
+        {
+            double *Fj = F.data() + size_t(positions[jj])*nf;
+            const double *Uj = U.data() + size_t(jj)*m;
+            for (uint ii=(this->symmetric ? jj : 0);ii<m;ii++)
+            {
+                Fj[positions[ii]] += Uj[ii];
+            }
+        }
+
+        std::vector<double>().swap(updateMatrices[child]);
+    }
+
+    // Partial factorization of supernode columns.
+    for (uint k=0;k<ns;k++)
+    {
+        double *Fk = F.data() + size_t(k)*nf;
+
+        if (this->symmetric)
+        {
+            if (!(Fk[k] > 0.0))
+            {
+                return false;
+            }
+            Fk[k] = std::sqrt(Fk[k]);
+            for (uint i=k+1;i<nf;i++)
+            {
+                Fk[i] /= Fk[k];
+            }
+#pragma omp parallel for default(shared) if(parallel && nf-k >= parallelUpdateSize)
+            for (int64_t j=k+1;j<int64_t(ns);j++)
+            {
+                double ljk = Fk[j];
+                if (ljk != 0.0)
+                {
+                    double *Fj = F.data() + size_t(j)*nf;
+                    for (uint i=uint(j);i<nf;i++)
+                    {
+                        Fj[i] -= Fk[i] * ljk;
+                    }
+                }
+            }
+        }
+        else
+        {
+            if (std::abs(Fk[k]) < pivotTolerance)
+            {
+                Fk[k] = (Fk[k] < 0.0) ? -pivotTolerance : pivotTolerance;
+                nPerturbedPivots++;
+            }
+            for (uint i=k+1;i<nf;i++)
+            {
+                Fk[i] /= Fk[k];
+            }
+#pragma omp parallel for default(shared) if(parallel && nf-k >= parallelUpdateSize)
+            for (int64_t j=k+1;j<int64_t(nf);j++)
+            {
+                double *Fj = F.data() + size_t(j)*nf;
+                double ukj = Fj[k];
+                if (ukj != 0.0)
+                {
+                    // Panel columns are updated completely, remaining columns only in supernode rows.
+                    uint iEnd = (j < int64_t(ns)) ? nf : ns;
+                    for (uint i=k+1;i<iEnd;i++)
+                    {
+                        Fj[i] -= Fk[i] * ukj;
+                    }
+                }
+            }
+        }
+    }
+
+    // Update matrix (Schur complement) for parent supernode.
+    uint m = nf - ns;
+    if (m > 0)
+    {
+        std::vector<double> &U = updateMatrices[supernode];
+        U.resize(size_t(m)*m);
+
+#pragma omp parallel for default(shared) schedule(dynamic,16) if(parallel && m >= parallelUpdateSize)
+        for (int64_t jj=0;jj<int64_t(m);jj++)
+        {
+            uint j = ns + uint(jj);
+            double *Uj = U.data() + size_t(jj)*m;
+            const double *Fj = F.data() + size_t(j)*nf;
+            uint iBegin = this->symmetric ? uint(jj) : 0;
+
+            for (uint ii=iBegin;ii<m;ii++)
+            {
+                Uj[ii] = Fj[ns+ii];
+            }
+            for (uint k=0;k<ns;k++)
+            {
+                const double *Fk = F.data() + size_t(k)*nf + ns;
+                double factor = this->symmetric ? Fk[jj] : Fj[k];
+                if (factor != 0.0)
+                {
+                    for (uint ii=iBegin;ii<m;ii++)
+                    {
+                        Uj[ii] -= Fk[ii] * factor;
+                    }
+                }
+            }
+        }
+    }
+
+    // Store factor.
+    double *L = this->lValues.data() + this->valuePointers[supernode];
+    std::copy(F.begin(),F.begin()+size_t(ns)*nf,L);
+
+    if (!this->symmetric)
+    {
+        double *Ut = this->uValues.data() + this->valuePointers[supernode];
+        for (uint k=0;k<ns;k++)
+        {
+            for (uint j=0;j<nf;j++)
+            {
+                Ut[j + size_t(k)*nf] = F[k + size_t(j)*nf];
+            }
+        }
+    }
+
+    return true;
+}
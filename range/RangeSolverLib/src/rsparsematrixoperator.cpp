@@ -0,0 +1,109 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsparsematrixoperator.cpp                                *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Sparse matrix operator class definition             *
+ *********************************************************************/
+
+#include <cmath>
+
+#include "rsparsematrixoperator.h"
+
+void RSparseMatrixOperator::_init(const RSparseMatrixOperator *pSparseMatrixOperator)
+{
+    if (pSparseMatrixOperator)
+    {
+        this->pMatrix = pSparseMatrixOperator->pMatrix;
+        this->pBlockMatrix = pSparseMatrixOperator->pBlockMatrix;
+    }
+}
+
+RSparseMatrixOperator::RSparseMatrixOperator(const RSparseMatrixCSR &matrix, const RSparseMatrixBSR *pBlockMatrix)
+    : pMatrix(&matrix)
+    , pBlockMatrix(pBlockMatrix)
+{
+    this->_init();
+}
+
+RSparseMatrixOperator::RSparseMatrixOperator(const RSparseMatrixOperator &sparseMatrixOperator)
+    : RMatrixOperator()
+{
+    this->_init(&sparseMatrixOperator);
+}
+
+RSparseMatrixOperator::~RSparseMatrixOperator()
+{
+}
+
+RSparseMatrixOperator &RSparseMatrixOperator::operator =(const RSparseMatrixOperator &sparseMatrixOperator)
+{
+    this->_init(&sparseMatrixOperator);
+    return (*this);
+}
+
+uint RSparseMatrixOperator::getNRows(void) const
+{
+    return this->pMatrix->getNRows();
+}
+
+void RSparseMatrixOperator::mlt(const RRVector &x, RRVector &y) const
+{
+    if (this->pBlockMatrix && this->pBlockMatrix->getNBlocks() > 0)
+    {
+        RSparseMatrixBSR::mlt(*this->pBlockMatrix,x,y);
+    }
+    else
+    {
+        RSparseMatrixCSR::mlt(*this->pMatrix,x,y);
+    }
+}
+
+void RSparseMatrixOperator::findDiagonal(RRVector &d) const
+{
+    uint nRows = this->pMatrix->getNRows();
+
+    d.resize(nRows);
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nRows);i++)
+    {
+        d[i] = this->pMatrix->findValue(uint(i),uint(i));
+    }
+}
+
+double RSparseMatrixOperator::findNorm(void) const
+{
+    return this->pMatrix->findNorm();
+}
+
+double RSparseMatrixOperator::findFrobeniusNorm(void) const
+{
+    uint nRows = this->pMatrix->getNRows();
+    double norm = 0.0;
+
+#pragma omp parallel for default(shared) reduction(+:norm)
+    for (int64_t i=0;i<int64_t(nRows);i++)
+    {
+        for (uint k=this->pMatrix->getRowBegin(uint(i));k<this->pMatrix->getRowEnd(uint(i));k++)
+        {
+            double value = this->pMatrix->getValue(k);
+            norm += value*value;
+        }
+    }
+
+    return std::sqrt(norm);
+}
+
+void RSparseMatrixOperator::findSolutionNormWeights(RRVector &weights) const
+{
+    weights.resize(this->pMatrix->getNRows());
+    weights.fill(0.0);
+
+    for (uint k=0;k<this->pMatrix->getNValues();k++)
+    {
+        weights[this->pMatrix->getColumnIndex(k)] += 1.0;
+    }
+}
@@ -0,0 +1,214 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rviewfactorraytracer.cpp                                 *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   17-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: View-factor ray tracer class definition             *
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include "rviewfactorraytracer.h"
+
+//! Number of rays traced between two convergence checks.
+#define R_VIEW_FACTOR_RAY_TRACER_BATCH_SIZE 256
+//! Minimum number of rays.
+#define R_VIEW_FACTOR_RAY_TRACER_MIN_RAYS 1024
+
+void RViewFactorRayTracer::_init(const RViewFactorRayTracer *pViewFactorRayTracer)
+{
+    if (pViewFactorRayTracer)
+    {
+        this->vertices = pViewFactorRayTracer->vertices;
+        this->edges1 = pViewFactorRayTracer->edges1;
+        this->edges2 = pViewFactorRayTracer->edges2;
+        this->normals = pViewFactorRayTracer->normals;
+        this->tangents1 = pViewFactorRayTracer->tangents1;
+        this->tangents2 = pViewFactorRayTracer->tangents2;
+        this->cumulativeAreas = pViewFactorRayTracer->cumulativeAreas;
+        this->generator = pViewFactorRayTracer->generator;
+        this->nHits = pViewFactorRayTracer->nHits;
+        this->nRays = pViewFactorRayTracer->nRays;
+    }
+}
+
+RViewFactorRayTracer::RViewFactorRayTracer(const RModel &model, const RPatch &patch, quint64 seed)
+    : generator(seed)
+    , nRays(0)
+{
+    this->_init();
+
+    double totalArea = 0.0;
+
+    const RUVector &rElementIDs = patch.getElementIDs();
+    for (uint i=0;i<rElementIDs.size();i++)
+    {
+        QList<RTriangle> elementTriangles = model.getElement(rElementIDs[i]).triangulate(model.getNodes());
+        for (int j=0;j<elementTriangles.size();j++)
+        {
+            const RTriangle &rTriangle = elementTriangles[j];
+
+            double area = rTriangle.findArea();
+            if (area <= 0.0)
+            {
+                continue;
+            }
+            totalArea += area;
+
+            RR3Vector vertex(rTriangle.getNode1().toVector());
+            RR3Vector edge1(rTriangle.getNode2().toVector());
+            RR3Vector edge2(rTriangle.getNode3().toVector());
+            for (uint k=0;k<3;k++)
+            {
+                edge1[k] -= vertex[k];
+                edge2[k] -= vertex[k];
+            }
+
+            RR3Vector normal(rTriangle.getNormal());
+            normal.normalize();
+            RR3Vector tangent1(normal.findOrthogonal());
+            tangent1.normalize();
+            RR3Vector tangent2;
+            RR3Vector::cross(normal,tangent1,tangent2);
+
+            this->vertices.push_back(vertex);
+            this->edges1.push_back(edge1);
+            this->edges2.push_back(edge2);
+            this->normals.push_back(normal);
+            this->tangents1.push_back(tangent1);
+            this->tangents2.push_back(tangent2);
+            this->cumulativeAreas.push_back(totalArea);
+        }
+    }
+}
+
+RViewFactorRayTracer::RViewFactorRayTracer(const RViewFactorRayTracer &viewFactorRayTracer)
+{
+    this->_init(&viewFactorRayTracer);
+}
+
+RViewFactorRayTracer::~RViewFactorRayTracer()
+{
+
+}
+
+RViewFactorRayTracer &RViewFactorRayTracer::operator =(const RViewFactorRayTracer &viewFactorRayTracer)
+{
+    this->_init(&viewFactorRayTracer);
+    return (*this);
+}
+
+void RViewFactorRayTracer::rayTraceScene(const RHemiCubeScene &scene, uint skipColor, uint resolution)
+{
+    if (this->cumulativeAreas.empty())
+    {
+        return;
+    }
+
+    // Variance of view-factor estimate F = nHits/nRays is F*(1-F)/nRays <= 1/(4*nRays),
+    // therefore target variance is always reached after maxRays rays.
+    double targetVariance = 1.0 / (double(std::max(resolution,1U)) * double(std::max(resolution,1U)));
+    uint maxRays = std::max(uint(R_VIEW_FACTOR_RAY_TRACER_MIN_RAYS),uint(std::ceil(0.25 / targetVariance)));
+
+    RR3Vector origin;
+    RR3Vector direction;
+    double distance;
+    uint color;
+
+    while (this->nRays < maxRays)
+    {
+        for (uint i=0;i<R_VIEW_FACTOR_RAY_TRACER_BATCH_SIZE;i++)
+        {
+            this->generateRay(origin,direction);
+            if (scene.findIntersection(origin,direction,skipColor,distance,color))
+            {
+                this->nHits[color]++;
+            }
+            this->nRays++;
+        }
+
+        if (this->nRays < R_VIEW_FACTOR_RAY_TRACER_MIN_RAYS)
+        {
+            continue;
+        }
+
+        double maxVariance = 0.0;
+        std::map<uint,uint>::const_iterator iter;
+        for (iter = this->nHits.begin(); iter != this->nHits.end(); ++iter)
+        {
+            double p = double(iter->second) / double(this->nRays);
+            maxVariance = std::max(maxVariance,p * (1.0 - p) / double(this->nRays));
+        }
+        if (maxVariance <= targetVariance)
+        {
+            break;
+        }
+    }
+}
+
+std::map<uint, double> RViewFactorRayTracer::getViewFactors(void) const
+{
+    std::map<uint,double> viewFactors;
+
+    if (this->nRays == 0)
+    {
+        return viewFactors;
+    }
+
+    std::map<uint,uint>::const_iterator iter;
+    for (iter = this->nHits.begin(); iter != this->nHits.end(); ++iter)
+    {
+        viewFactors[iter->first] = double(iter->second) / double(this->nRays);
+    }
+
+    return viewFactors;
+}
+
+uint RViewFactorRayTracer::getNRays(void) const
+{
+    return this->nRays;
+}
+
+double RViewFactorRayTracer::generateRandomNumber(void)
+{
+    // Upper 53 bits give evenly distributed double independent of standard library implementation.
+    return double(this->generator() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void RViewFactorRayTracer::generateRay(RR3Vector &origin, RR3Vector &direction)
+{
+    // Triangle is selected with probability proportional to its area.
+    double a = this->generateRandomNumber() * this->cumulativeAreas.back();
+    uint triangleID = uint(std::upper_bound(this->cumulativeAreas.begin(),this->cumulativeAreas.end(),a) - this->cumulativeAreas.begin());
+    triangleID = std::min(triangleID,uint(this->cumulativeAreas.size()-1));
+
+    // Uniform point in triangle.
+    double s = std::sqrt(this->generateRandomNumber());
+    double t = this->generateRandomNumber();
+    double w1 = s * (1.0 - t);
+    double w2 = s * t;
+
+    // Cosine weighted direction (uniform point on unit disk projected to hemisphere).
+    double r2 = this->generateRandomNumber();
+    double phi = 2.0 * RConstants::pi * this->generateRandomNumber();
+    double r = std::sqrt(r2);
+    double x = r * std::cos(phi);
+    double y = r * std::sin(phi);
+    double z = std::sqrt(std::max(0.0,1.0 - r2));
+
+    const RR3Vector &rVertex = this->vertices[triangleID];
+    const RR3Vector &rEdge1 = this->edges1[triangleID];
+    const RR3Vector &rEdge2 = this->edges2[triangleID];
+    const RR3Vector &rNormal = this->normals[triangleID];
+    const RR3Vector &rTangent1 = this->tangents1[triangleID];
+    const RR3Vector &rTangent2 = this->tangents2[triangleID];
+
+    for (uint i=0;i<3;i++)
+    {
+        origin[i] = rVertex[i] + w1 * rEdge1[i] + w2 * rEdge2[i];
+        direction[i] = x * rTangent1[i] + y * rTangent2[i] + z * rNormal[i];
+    }
+}
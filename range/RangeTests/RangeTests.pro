@@ -24,17 +24,51 @@ BUILDPATH = $${PWD}/../../build-range3
 SOURCES += \
     TestRangeBase/tst_rbl_r3vector.cpp \
     TestRangeBase/tst_rbl_rmatrix.cpp \
+    TestRangeBase/tst_rbl_rsmall_matrix.cpp \
     TestRangeBase/tst_rbl_rvector.cpp \
+    TestRangeBase/tst_rbl_space_filling_curve.cpp \
+    TestRangeModel/tst_rml_element_geometry_cache.cpp \
+    TestRangeModel/tst_rml_element_kernel.cpp \
+    TestRangeModel/tst_rml_matrix_system.cpp \
+    TestRangeModel/tst_rml_mesh_view.cpp \
+    TestRangeModel/tst_rml_model.cpp \
     TestRangeModel/tst_rml_sparse_vector.cpp \
     TestRangeModel/tst_rml_sparse_matrix.cpp \
+    TestRangeModel/tst_rml_sparse_matrix_csr.cpp \
+    TestRangeModel/tst_rml_sparse_matrix_bsr.cpp \
+    TestRangeSolverLib/tst_relementmatrixoperator.cpp \
+    TestRangeSolverLib/tst_rgraphordering.cpp \
+    TestRangeSolverLib/tst_rhemicube.cpp \
+    TestRangeSolverLib/tst_rmatrixpreconditioner.cpp \
+    TestRangeSolverLib/tst_rmatrixsolver.cpp \
+    TestRangeSolverLib/tst_rsolvergeneric.cpp \
+    TestRangeSolverLib/tst_rsolverradiativeheat.cpp \
+    TestRangeSolverLib/tst_rsparsedirectsolver.cpp \
     tst_main.cpp
 
 HEADERS += \
     TestRangeBase/tst_rbl_r3vector.h \
     TestRangeBase/tst_rbl_rmatrix.h \
+    TestRangeBase/tst_rbl_rsmall_matrix.h \
     TestRangeBase/tst_rbl_rvector.h \
+    TestRangeBase/tst_rbl_space_filling_curve.h \
+    TestRangeModel/tst_rml_element_geometry_cache.h \
+    TestRangeModel/tst_rml_element_kernel.h \
+    TestRangeModel/tst_rml_matrix_system.h \
+    TestRangeModel/tst_rml_mesh_view.h \
+    TestRangeModel/tst_rml_model.h \
     TestRangeModel/tst_rml_sparse_vector.h \
-    TestRangeModel/tst_rml_sparse_matrix.h
+    TestRangeModel/tst_rml_sparse_matrix.h \
+    TestRangeModel/tst_rml_sparse_matrix_csr.h \
+    TestRangeModel/tst_rml_sparse_matrix_bsr.h \
+    TestRangeSolverLib/tst_relementmatrixoperator.h \
+    TestRangeSolverLib/tst_rgraphordering.h \
+    TestRangeSolverLib/tst_rhemicube.h \
+    TestRangeSolverLib/tst_rmatrixpreconditioner.h \
+    TestRangeSolverLib/tst_rmatrixsolver.h \
+    TestRangeSolverLib/tst_rsolvergeneric.h \
+    TestRangeSolverLib/tst_rsolverradiativeheat.h \
+    TestRangeSolverLib/tst_rsparsedirectsolver.h
 
 
 CONFIG -= debug_and_release
@@ -0,0 +1,102 @@
+#include <rblib.h>
+
+#include "tst_rbl_rsmall_matrix.h"
+
+void tst_RRSmallMatrix::resize() const
+{
+    RRSmallMatrix A(3,4,1.0);
+    QVERIFY(A.getNRows() == 3);
+    QVERIFY(A.getNColumns() == 4);
+    for (uint i=0;i<A.getNRows();i++)
+    {
+        for (uint j=0;j<A.getNColumns();j++)
+        {
+            QVERIFY(R_D_ARE_SAME(A[i][j],1.0));
+        }
+    }
+
+    A.resize(R_SMALL_MATRIX_MAX_SIZE,R_SMALL_MATRIX_MAX_SIZE,2.0);
+    QVERIFY(R_D_ARE_SAME(A.getValue(R_SMALL_MATRIX_MAX_SIZE-1,R_SMALL_MATRIX_MAX_SIZE-1),2.0));
+
+    bool failed = false;
+    try
+    {
+        A.resize(R_SMALL_MATRIX_MAX_SIZE+1,1);
+    }
+    catch (const RError &)
+    {
+        failed = true;
+    }
+    QVERIFY(failed);
+}
+
+void tst_RRSmallMatrix::access() const
+{
+    RRSmallMatrix A(2,3);
+    A[0][0] = 1.0; A[0][1] = 2.0; A[0][2] = 3.0;
+    A[1][0] = 4.0; A[1][1] = 5.0; A[1][2] = 6.0;
+
+    // Rows are stored contiguously.
+    for (uint k=0;k<6;k++)
+    {
+        QVERIFY(R_D_ARE_SAME(A.data()[k],double(k+1)));
+    }
+    QVERIFY(R_D_ARE_SAME(A.getValue(1,2),6.0));
+    A.setValue(1,2,7.0);
+    QVERIFY(R_D_ARE_SAME(A[1][2],7.0));
+
+    RRMatrix M = A.toMatrix();
+    QVERIFY(M.getNRows() == 2);
+    QVERIFY(M.getNColumns() == 3);
+    for (uint i=0;i<A.getNRows();i++)
+    {
+        for (uint j=0;j<A.getNColumns();j++)
+        {
+            QVERIFY(R_D_ARE_SAME(M[i][j],A[i][j]));
+        }
+    }
+}
+
+void tst_RRSmallMatrix::copy() const
+{
+    RRSmallMatrix A(4,4);
+    for (uint i=0;i<4;i++)
+    {
+        for (uint j=0;j<4;j++)
+        {
+            A[i][j] = double(i*4+j);
+        }
+    }
+    RRSmallMatrix B(2,2,-1.0);
+    B = A;
+    QVERIFY(B.getNRows() == 4);
+    QVERIFY(B.getNColumns() == 4);
+    B *= 2.0;
+    for (uint i=0;i<4;i++)
+    {
+        for (uint j=0;j<4;j++)
+        {
+            QVERIFY(R_D_ARE_SAME(B[i][j],2.0*A[i][j]));
+        }
+    }
+}
+
+void tst_RRSmallMatrix::mlt() const
+{
+    RRSmallMatrix A(2,3);
+    A[0][0] = 1.0; A[0][1] = 2.0; A[0][2] = 3.0;
+    A[1][0] = 4.0; A[1][1] = 5.0; A[1][2] = 6.0;
+    RRVector x(3);
+    x[0] = 1.0;
+    x[1] = -1.0;
+    x[2] = 2.0;
+    RRVector y;
+    RRSmallMatrix::mlt(A,x,y);
+    QVERIFY(y.size() == 2);
+    QVERIFY(R_D_ARE_SAME(y[0],5.0));
+    QVERIFY(R_D_ARE_SAME(y[1],11.0));
+
+    RRSmallMatrix::mlt(A,x,y,true);
+    QVERIFY(R_D_ARE_SAME(y[0],10.0));
+    QVERIFY(R_D_ARE_SAME(y[1],22.0));
+}
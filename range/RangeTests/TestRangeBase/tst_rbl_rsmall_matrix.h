@@ -0,0 +1,18 @@
+#ifndef TST_RSMALL_MATRIX_H
+#define TST_RSMALL_MATRIX_H
+
+#include <QtTest>
+
+class tst_RRSmallMatrix : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void resize() const;
+        void access() const;
+        void copy() const;
+        void mlt() const;
+
+};
+
+#endif // TST_RSMALL_MATRIX_H
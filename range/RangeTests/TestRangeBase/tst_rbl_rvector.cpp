@@ -34,3 +34,75 @@ void tst_RRVector::norm()
     r[9] = -10.0;
     QVERIFY(R_D_ARE_SAME(RRVector::norm(r),std::sqrt(385.0)));
 }
+
+void tst_RRVector::addSubtract()
+{
+    // Size not divisible by vector width to exercise remainder handling.
+    RRVector r1(37);
+    RRVector r2(37);
+    for (uint i=0;i<r1.size();i++)
+    {
+        r1[i] = double(i);
+        r2[i] = 2.0*double(i) + 1.0;
+    }
+    RRVector x;
+    RRVector::add(r1,r2,x);
+    QVERIFY(x.size() == r1.size());
+    for (uint i=0;i<x.size();i++)
+    {
+        QVERIFY(R_D_ARE_SAME(x[i],3.0*double(i) + 1.0));
+    }
+    RRVector::subtract(r1,r2,x);
+    for (uint i=0;i<x.size();i++)
+    {
+        QVERIFY(R_D_ARE_SAME(x[i],-double(i) - 1.0));
+    }
+}
+
+void tst_RRVector::axpy()
+{
+    RRVector x(29,2.0);
+    RRVector y(29,1.0);
+    RRVector::axpy(0.5,x,y);
+    for (uint i=0;i<y.size();i++)
+    {
+        QVERIFY(R_D_ARE_SAME(y[i],2.0));
+    }
+    y.scale(3.0);
+    for (uint i=0;i<y.size();i++)
+    {
+        QVERIFY(R_D_ARE_SAME(y[i],6.0));
+    }
+}
+
+void tst_RRVector::instructionSets()
+{
+    RSimd::InstructionSet instructionSet = RSimd::getInstructionSet();
+
+    for (uint n=0;n<67;n++)
+    {
+        RRVector r1(n);
+        RRVector r2(n);
+        double dotProd = 0.0;
+        for (uint i=0;i<n;i++)
+        {
+            r1[i] = 1.0 + double(i % 5);
+            r2[i] = 2.0 - double(i % 3);
+            dotProd += r1[i]*r2[i];
+        }
+        // Every kernel supported by CPU must give same result.
+        for (int type=RSimd::Generic;type<RSimd::NInstructionSets;type++)
+        {
+            RSimd::setInstructionSet(RSimd::InstructionSet(type));
+            QVERIFY(R_D_ARE_SAME(RRVector::dot(r1,r2),dotProd));
+            RRVector x(r2);
+            RRVector::axpy(2.0,r1,x);
+            for (uint i=0;i<n;i++)
+            {
+                QVERIFY(R_D_ARE_SAME(x[i],r2[i] + 2.0*r1[i]));
+            }
+        }
+    }
+
+    RSimd::setInstructionSet(instructionSet);
+}
@@ -10,6 +10,9 @@ class tst_RRVector : public QObject
     private slots:
         void dot();
         void norm();
+        void addSubtract();
+        void axpy();
+        void instructionSets();
 };
 
 #endif // TST_RRVECTOR_H
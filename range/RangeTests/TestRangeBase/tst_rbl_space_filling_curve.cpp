@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include <rblib.h>
+
+#include "tst_rbl_space_filling_curve.h"
+
+void tst_RSpaceFillingCurve::mortonKey() const
+{
+    QVERIFY(RSpaceFillingCurve::findMortonKey(0,0,0) == 0);
+    QVERIFY(RSpaceFillingCurve::findMortonKey(1,0,0) == 4);
+    QVERIFY(RSpaceFillingCurve::findMortonKey(0,1,0) == 2);
+    QVERIFY(RSpaceFillingCurve::findMortonKey(0,0,1) == 1);
+    QVERIFY(RSpaceFillingCurve::findMortonKey(3,3,3) == 63);
+}
+
+void tst_RSpaceFillingCurve::hilbertKey() const
+{
+    const uint n = 8;
+
+    // Sub-cube at origin is traversed first, keys must cover 0 .. n^3-1.
+    std::vector<int> cells(n*n*n,-1);
+    for (uint x=0;x<n;x++)
+    {
+        for (uint y=0;y<n;y++)
+        {
+            for (uint z=0;z<n;z++)
+            {
+                quint64 key = RSpaceFillingCurve::findHilbertKey(x,y,z);
+                QVERIFY(key < quint64(n*n*n));
+                QVERIFY(cells[key] < 0);
+                cells[key] = int((x*n+y)*n+z);
+            }
+        }
+    }
+
+    // Consecutive cells along the curve are face neighbors.
+    for (uint i=1;i<cells.size();i++)
+    {
+        int a = cells[i-1];
+        int b = cells[i];
+        int distance = std::abs(a/int(n*n)-b/int(n*n))
+                     + std::abs((a/int(n))%int(n)-(b/int(n))%int(n))
+                     + std::abs(a%int(n)-b%int(n));
+        QVERIFY(distance == 1);
+    }
+}
+
+void tst_RSpaceFillingCurve::order() const
+{
+    std::vector<RR3Vector> points;
+    for (uint i=0;i<1000;i++)
+    {
+        // Scrambled but deterministic point cloud with duplicates.
+        uint j = (i * 7919) % 500;
+        points.push_back(RR3Vector(double(j%10),double((j/10)%10),double(j/100)));
+    }
+
+    for (uint t=0;t<uint(RSpaceFillingCurve::NTypes);t++)
+    {
+        std::vector<uint> order;
+        RSpaceFillingCurve::findOrder(RSpaceFillingCurve::Type(t),points,order);
+
+        QVERIFY(order.size() == points.size());
+
+        std::vector<uint> sorted(order);
+        std::sort(sorted.begin(),sorted.end());
+        for (uint i=0;i<sorted.size();i++)
+        {
+            QVERIFY(sorted[i] == i);
+        }
+
+        // Equal points keep their original order.
+        for (uint i=1;i<order.size();i++)
+        {
+            if (points[order[i-1]] == points[order[i]])
+            {
+                QVERIFY(order[i-1] < order[i]);
+            }
+        }
+    }
+
+    std::vector<uint> order;
+    RSpaceFillingCurve::findOrder(RSpaceFillingCurve::Hilbert,std::vector<RR3Vector>(),order);
+    QVERIFY(order.empty());
+}
@@ -0,0 +1,17 @@
+#ifndef TST_RBL_SPACE_FILLING_CURVE_H
+#define TST_RBL_SPACE_FILLING_CURVE_H
+
+#include <QtTest>
+
+class tst_RSpaceFillingCurve : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void mortonKey() const;
+        void hilbertKey() const;
+        void order() const;
+
+};
+
+#endif // TST_RBL_SPACE_FILLING_CURVE_H
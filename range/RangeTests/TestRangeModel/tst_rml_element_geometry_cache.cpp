@@ -0,0 +1,139 @@
+#include <rmlib.h>
+
+#include "tst_rml_element_geometry_cache.h"
+
+static void buildMesh(std::vector<RNode> &nodes, std::vector<RElement> &elements)
+{
+    nodes.clear();
+    nodes.push_back(RNode(0.0,0.0,0.0));
+    nodes.push_back(RNode(1.0,0.1,0.0));
+    nodes.push_back(RNode(0.2,1.3,0.1));
+    nodes.push_back(RNode(0.1,0.3,1.2));
+    nodes.push_back(RNode(1.4,1.2,0.3));
+
+    elements.clear();
+
+    RElement point(R_ELEMENT_POINT);
+    point.setNodeId(0,4);
+    elements.push_back(point);
+
+    RElement truss(R_ELEMENT_TRUSS1);
+    truss.setNodeId(0,0);
+    truss.setNodeId(1,4);
+    elements.push_back(truss);
+
+    RElement triangle(R_ELEMENT_TRI1);
+    triangle.setNodeId(0,0);
+    triangle.setNodeId(1,1);
+    triangle.setNodeId(2,2);
+    elements.push_back(triangle);
+
+    RElement quadrilateral(R_ELEMENT_QUAD1);
+    quadrilateral.setNodeId(0,0);
+    quadrilateral.setNodeId(1,1);
+    quadrilateral.setNodeId(2,4);
+    quadrilateral.setNodeId(3,2);
+    elements.push_back(quadrilateral);
+
+    RElement tetrahedron(R_ELEMENT_TETRA1);
+    tetrahedron.setNodeId(0,0);
+    tetrahedron.setNodeId(1,1);
+    tetrahedron.setNodeId(2,2);
+    tetrahedron.setNodeId(3,3);
+    elements.push_back(tetrahedron);
+}
+
+static bool compareWithElements(const RElementGeometryCache &cache, const std::vector<RNode> &nodes, const std::vector<RElement> &elements)
+{
+    for (uint i=0;i<elements.size();i++)
+    {
+        for (uint k=0;k<RElement::getNIntegrationPoints(elements[i].getType());k++)
+        {
+            RRSmallMatrix B, R;
+            double detJ = elements[i].findShapeDerivatives(nodes,k,B,R);
+
+            RRSmallMatrix cB, cR;
+            double cDetJ = cache.findShapeDerivatives(i,k,cB);
+            cache.findRotation(i,cR);
+
+            if (std::abs(detJ - cDetJ) > 1.0e-12 * std::abs(detJ))
+            {
+                return false;
+            }
+            if (std::abs(cache.getJacobian(i,k) - cDetJ) > 0.0)
+            {
+                return false;
+            }
+            if (B.getNRows() != cB.getNRows() || B.getNColumns() != cB.getNColumns())
+            {
+                return false;
+            }
+            for (uint m=0;m<B.getNRows();m++)
+            {
+                for (uint c=0;c<B.getNColumns();c++)
+                {
+                    if (std::abs(B[m][c] - cB[m][c]) > 1.0e-12 * (1.0 + std::abs(B[m][c])))
+                    {
+                        return false;
+                    }
+                }
+            }
+            if (R_ELEMENT_TYPE_IS_LINE(elements[i].getType()) || R_ELEMENT_TYPE_IS_SURFACE(elements[i].getType()))
+            {
+                for (uint m=0;m<3;m++)
+                {
+                    for (uint c=0;c<3;c++)
+                    {
+                        if (std::abs(R[m][c] - cR[m][c]) > 1.0e-12)
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void tst_RElementGeometryCache::values() const
+{
+    std::vector<RNode> nodes;
+    std::vector<RElement> elements;
+    buildMesh(nodes,elements);
+
+    RElementGeometryCache cache;
+    QVERIFY(!cache.isValid(nodes,elements));
+    QVERIFY(cache.update(nodes,elements));
+    QVERIFY(cache.isValid(nodes,elements));
+
+    QVERIFY(compareWithElements(cache,nodes,elements));
+}
+
+void tst_RElementGeometryCache::update() const
+{
+    std::vector<RNode> nodes;
+    std::vector<RElement> elements;
+    buildMesh(nodes,elements);
+
+    RElementGeometryCache cache;
+    QVERIFY(cache.update(nodes,elements));
+    QCOMPARE(cache.getNBuilds(),uint(1));
+
+    // Unchanged mesh must not trigger rebuild.
+    QVERIFY(!cache.update(nodes,elements));
+    QCOMPARE(cache.getNBuilds(),uint(1));
+
+    // Moved node must trigger rebuild.
+    nodes[3].setZ(1.5);
+    QVERIFY(!cache.isValid(nodes,elements));
+    QVERIFY(cache.update(nodes,elements));
+    QCOMPARE(cache.getNBuilds(),uint(2));
+    QVERIFY(compareWithElements(cache,nodes,elements));
+
+    // Explicit invalidation.
+    cache.invalidate();
+    QVERIFY(!cache.isValid(nodes,elements));
+    QVERIFY(cache.update(nodes,elements));
+    QCOMPARE(cache.getNBuilds(),uint(3));
+}
@@ -0,0 +1,17 @@
+#ifndef TST_RELEMENTGEOMETRYCACHE_H
+#define TST_RELEMENTGEOMETRYCACHE_H
+
+#include <QtTest>
+
+class tst_RElementGeometryCache : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void values() const;
+        void update() const;
+
+};
+
+#endif // TST_RELEMENTGEOMETRYCACHE_H
@@ -0,0 +1,113 @@
+#include <rmlib.h>
+
+#include "tst_rml_element_kernel.h"
+
+static bool compareWithJacobian(RElementType type, const std::vector<RNode> &nodes)
+{
+    RElement element(type);
+    for (uint i=0;i<element.size();i++)
+    {
+        element.setNodeId(i,i);
+    }
+
+    for (uint k=0;k<RElement::getNIntegrationPoints(type);k++)
+    {
+        const RRMatrix &dN = RElement::getShapeFunction(type,k).getDN();
+
+        RRMatrix J, Rt;
+        double detJ = element.findJacobian(nodes,k,J,Rt);
+
+        RRSmallMatrix B, R;
+        double kernelDetJ = element.findShapeDerivatives(nodes,k,B,R);
+
+        if (std::abs(detJ - kernelDetJ) > 1.0e-12 * std::abs(detJ))
+        {
+            return false;
+        }
+        if (B.getNRows() != dN.getNRows() || B.getNColumns() != dN.getNColumns())
+        {
+            return false;
+        }
+        for (uint m=0;m<dN.getNRows();m++)
+        {
+            for (uint c=0;c<dN.getNColumns();c++)
+            {
+                double value = 0.0;
+                for (uint l=0;l<dN.getNColumns();l++)
+                {
+                    value += dN[m][l]*J[c][l];
+                }
+                if (std::abs(value - B[m][c]) > 1.0e-10 * (1.0 + std::abs(value)))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void tst_RElementKernel::truss1() const
+{
+    std::vector<RNode> nodes;
+    nodes.push_back(RNode(0.5,-1.0,2.0));
+    nodes.push_back(RNode(1.5,0.25,2.5));
+
+    QVERIFY(compareWithJacobian(R_ELEMENT_TRUSS1,nodes));
+
+    // Element parallel with X axis.
+    nodes[1] = RNode(3.0,-1.0,2.0);
+
+    QVERIFY(compareWithJacobian(R_ELEMENT_TRUSS1,nodes));
+}
+
+void tst_RElementKernel::tri1() const
+{
+    std::vector<RNode> nodes;
+    nodes.push_back(RNode(0.1,0.2,0.3));
+    nodes.push_back(RNode(1.2,0.4,-0.5));
+    nodes.push_back(RNode(0.3,1.6,0.9));
+
+    QVERIFY(compareWithJacobian(R_ELEMENT_TRI1,nodes));
+}
+
+void tst_RElementKernel::quad1() const
+{
+    std::vector<RNode> nodes;
+    nodes.push_back(RNode(0.0,0.0,1.0));
+    nodes.push_back(RNode(2.0,0.0,1.0));
+    nodes.push_back(RNode(2.5,1.5,1.0));
+    nodes.push_back(RNode(-0.5,1.0,1.0));
+
+    QVERIFY(compareWithJacobian(R_ELEMENT_QUAD1,nodes));
+}
+
+void tst_RElementKernel::tetra1() const
+{
+    std::vector<RNode> nodes;
+    nodes.push_back(RNode(0.0,0.0,0.0));
+    nodes.push_back(RNode(1.0,0.1,-0.2));
+    nodes.push_back(RNode(0.2,1.3,0.1));
+    nodes.push_back(RNode(-0.1,0.3,0.9));
+
+    QVERIFY(compareWithJacobian(R_ELEMENT_TETRA1,nodes));
+
+    RElement element(R_ELEMENT_TETRA1);
+    for (uint i=0;i<element.size();i++)
+    {
+        element.setNodeId(i,i);
+    }
+
+    // Partition of unity - derivatives sum to zero.
+    RRSmallMatrix B;
+    element.findShapeDerivatives(nodes,0,B);
+    for (uint c=0;c<3;c++)
+    {
+        double sum = 0.0;
+        for (uint m=0;m<element.size();m++)
+        {
+            sum += B[m][c];
+        }
+        QVERIFY(std::abs(sum) < 1.0e-12);
+    }
+}
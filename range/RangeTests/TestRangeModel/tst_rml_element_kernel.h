@@ -0,0 +1,19 @@
+#ifndef TST_RELEMENTKERNEL_H
+#define TST_RELEMENTKERNEL_H
+
+#include <QtTest>
+
+class tst_RElementKernel : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void truss1() const;
+        void tri1() const;
+        void quad1() const;
+        void tetra1() const;
+
+};
+
+#endif // TST_RELEMENTKERNEL_H
@@ -0,0 +1,206 @@
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+
+#include <rmlib.h>
+
+#include "tst_rml_matrix_system.h"
+
+// Values are exactly representable in ASCII file so that both formats can be compared exactly.
+// Last column has no values.
+static RSparseMatrixCSR buildMatrix(uint n)
+{
+    RSparseMatrix A;
+    A.setNRows(n);
+    for (uint i=0;i<n;i++)
+    {
+        if (i+1 < n)
+        {
+            A.addValue(i,i,4.0 + double(i));
+        }
+        if (i > 0)
+        {
+            A.addValue(i,i-1,-1.25);
+        }
+        if (i+2 < n)
+        {
+            A.addValue(i,i+1,0.5);
+        }
+    }
+    return RSparseMatrixCSR(A);
+}
+
+static RMatrixSystem buildMatrixSystem(void)
+{
+    uint n = 6;
+
+    RMatrixSolverConf matrixSolverConf(RMatrixSolverConf::GMRES);
+    matrixSolverConf.setSolverCvgValue(1.0e-8);
+    matrixSolverConf.setNOuterIterations(321);
+
+    RRVector b(n);
+    RRVector x(n);
+    std::vector<uint> rowBlockIndexes(n);
+    for (uint i=0;i<n;i++)
+    {
+        b[i] = 1.0 + double(i);
+        x[i] = -0.5 * double(i);
+        rowBlockIndexes[i] = i / 2;
+    }
+
+    std::vector<RRVector> nearNullSpace(2,RRVector(n,0.0));
+    for (uint i=0;i<n;i++)
+    {
+        nearNullSpace[i%2][i] = 1.0;
+    }
+
+    RMatrixSystem matrixSystem;
+    matrixSystem.setMatrixSolverConf(matrixSolverConf);
+    matrixSystem.setPreconditionerType(R_MATRIX_PRECONDITIONER_BLOCK_JACOBI);
+    matrixSystem.setBlockSize(2);
+    matrixSystem.setMatrix(buildMatrix(n));
+    matrixSystem.setRhs(b);
+    matrixSystem.setInitialGuess(x);
+    matrixSystem.setRowBlockIndexes(rowBlockIndexes);
+    matrixSystem.setNearNullSpace(nearNullSpace);
+    return matrixSystem;
+}
+
+static bool areSame(const RRVector &v1, const RRVector &v2)
+{
+    if (v1.size() != v2.size())
+    {
+        return false;
+    }
+    for (uint i=0;i<v1.size();i++)
+    {
+        if (v1[i] != v2[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool areSame(const RMatrixSystem &s1, const RMatrixSystem &s2)
+{
+    if (s1.getMatrixSolverConf().getType() != s2.getMatrixSolverConf().getType() ||
+        s1.getMatrixSolverConf().getSolverCvgValue() != s2.getMatrixSolverConf().getSolverCvgValue() ||
+        s1.getMatrixSolverConf().getNOuterIterations() != s2.getMatrixSolverConf().getNOuterIterations() ||
+        s1.getPreconditionerType() != s2.getPreconditionerType() ||
+        s1.getBlockSize() != s2.getBlockSize())
+    {
+        return false;
+    }
+    if (s1.getMatrix().getRowPointers() != s2.getMatrix().getRowPointers() ||
+        s1.getMatrix().getColumnIndexes() != s2.getMatrix().getColumnIndexes() ||
+        s1.getMatrix().getValues() != s2.getMatrix().getValues())
+    {
+        return false;
+    }
+    if (!areSame(s1.getRhs(),s2.getRhs()) || !areSame(s1.getInitialGuess(),s2.getInitialGuess()))
+    {
+        return false;
+    }
+    if (s1.getRowBlockIndexes() != s2.getRowBlockIndexes() || s1.getNearNullSpace().size() != s2.getNearNullSpace().size())
+    {
+        return false;
+    }
+    for (uint i=0;i<s1.getNearNullSpace().size();i++)
+    {
+        if (!areSame(s1.getNearNullSpace()[i],s2.getNearNullSpace()[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void checkWriteRead(bool binary)
+{
+    QString fileName(QDir::temp().filePath("tst_rml_matrix_system." + RMatrixSystem::getDefaultFileExtension(binary)));
+
+    RMatrixSystem matrixSystem(buildMatrixSystem());
+    matrixSystem.write(fileName);
+
+    RMatrixSystem readMatrixSystem;
+    readMatrixSystem.read(fileName);
+
+    QFile::remove(fileName);
+
+    QVERIFY(areSame(matrixSystem,readMatrixSystem));
+}
+
+void tst_RMatrixSystem::writeReadBinary() const
+{
+    checkWriteRead(true);
+}
+
+void tst_RMatrixSystem::writeReadAscii() const
+{
+    checkWriteRead(false);
+}
+
+void tst_RMatrixSystem::writeMatrixMarket() const
+{
+    QString fileName(QDir::temp().filePath("tst_rml_matrix_system." + RMatrixSystem::getMatrixMarketFileExtension()));
+    QString rhsFileName(RFileManager::getFileNameWithSuffix(fileName,"rhs"));
+
+    RMatrixSystem matrixSystem(buildMatrixSystem());
+    matrixSystem.write(fileName);
+
+    const RSparseMatrixCSR &A = matrixSystem.getMatrix();
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    QTextStream in(&file);
+
+    QVERIFY(in.readLine() == "%%MatrixMarket matrix coordinate real general");
+
+    // Number of columns is system size even though last column has no values.
+    uint nRows = 0;
+    uint nColumns = 0;
+    uint nValues = 0;
+    in >> nRows >> nColumns >> nValues;
+    QVERIFY(nRows == A.getNRows());
+    QVERIFY(nColumns == A.getNRows());
+    QVERIFY(nValues == A.getNValues());
+
+    // Entries are 1-based and follow row order.
+    for (uint i=0;i<A.getNRows();i++)
+    {
+        for (uint k=A.getRowBegin(i);k<A.getRowEnd(i);k++)
+        {
+            uint row = 0;
+            uint column = 0;
+            double value = 0.0;
+            in >> row >> column >> value;
+            QVERIFY(row == i+1);
+            QVERIFY(column == A.getColumnIndex(k)+1);
+            QVERIFY(value == A.getValue(k));
+        }
+    }
+    file.close();
+
+    QFile rhsFile(rhsFileName);
+    QVERIFY(rhsFile.open(QIODevice::ReadOnly | QIODevice::Text));
+    QTextStream rhsIn(&rhsFile);
+
+    QVERIFY(rhsIn.readLine() == "%%MatrixMarket matrix array real general");
+
+    uint nRhsRows = 0;
+    uint nRhsColumns = 0;
+    rhsIn >> nRhsRows >> nRhsColumns;
+    QVERIFY(nRhsRows == matrixSystem.getRhs().size());
+    QVERIFY(nRhsColumns == 1);
+    for (uint i=0;i<nRhsRows;i++)
+    {
+        double value = 0.0;
+        rhsIn >> value;
+        QVERIFY(value == matrixSystem.getRhs()[i]);
+    }
+    rhsFile.close();
+
+    QFile::remove(fileName);
+    QFile::remove(rhsFileName);
+}
@@ -0,0 +1,18 @@
+#ifndef TST_RMATRIXSYSTEM_H
+#define TST_RMATRIXSYSTEM_H
+
+#include <QtTest>
+
+class tst_RMatrixSystem : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void writeReadBinary() const;
+        void writeReadAscii() const;
+        void writeMatrixMarket() const;
+
+};
+
+#endif // TST_RMATRIXSYSTEM_H
@@ -0,0 +1,134 @@
+#include <rmlib.h>
+
+#include "tst_rml_mesh_view.h"
+
+static void buildMesh(std::vector<RNode> &nodes, std::vector<RElement> &elements)
+{
+    nodes.clear();
+    nodes.push_back(RNode(0.0,0.0,0.0));
+    nodes.push_back(RNode(1.0,0.1,0.0));
+    nodes.push_back(RNode(0.2,1.3,0.1));
+    nodes.push_back(RNode(0.1,0.3,1.2));
+    nodes.push_back(RNode(1.4,1.2,0.3));
+    nodes.push_back(RNode(2.0,2.0,2.0));
+
+    elements.clear();
+
+    RElement point(R_ELEMENT_POINT);
+    point.setNodeId(0,4);
+    elements.push_back(point);
+
+    RElement truss(R_ELEMENT_TRUSS1);
+    truss.setNodeId(0,0);
+    truss.setNodeId(1,4);
+    elements.push_back(truss);
+
+    RElement triangle(R_ELEMENT_TRI1);
+    triangle.setNodeId(0,0);
+    triangle.setNodeId(1,1);
+    triangle.setNodeId(2,2);
+    elements.push_back(triangle);
+
+    RElement tetrahedron(R_ELEMENT_TETRA1);
+    tetrahedron.setNodeId(0,0);
+    tetrahedron.setNodeId(1,1);
+    tetrahedron.setNodeId(2,2);
+    tetrahedron.setNodeId(3,3);
+    elements.push_back(tetrahedron);
+}
+
+static bool compareWithMesh(const RMeshView &meshView, const std::vector<RNode> &nodes, const std::vector<RElement> &elements)
+{
+    if (meshView.getNNodes() != nodes.size() || meshView.getNElements() != elements.size())
+    {
+        return false;
+    }
+    for (uint i=0;i<nodes.size();i++)
+    {
+        if (meshView.getX()[i] != nodes[i].getX() ||
+            meshView.getY()[i] != nodes[i].getY() ||
+            meshView.getZ()[i] != nodes[i].getZ())
+        {
+            return false;
+        }
+    }
+    for (uint i=0;i<elements.size();i++)
+    {
+        if (meshView.getElementType(i) != elements[i].getType() || meshView.getNElementNodes(i) != elements[i].size())
+        {
+            return false;
+        }
+        for (uint j=0;j<elements[i].size();j++)
+        {
+            if (meshView.getElementNodes(i)[j] != elements[i].getNodeId(j))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void tst_RMeshView::values() const
+{
+    std::vector<RNode> nodes;
+    std::vector<RElement> elements;
+    buildMesh(nodes,elements);
+
+    RMeshView meshView;
+    meshView.update(nodes,elements);
+
+    QVERIFY(compareWithMesh(meshView,nodes,elements));
+
+    // Node to element adjacency is sorted by element ID.
+    QCOMPARE(meshView.getNNodeElements(0),uint(3));
+    QCOMPARE(meshView.getNodeElements(0)[0],uint(1));
+    QCOMPARE(meshView.getNodeElements(0)[1],uint(2));
+    QCOMPARE(meshView.getNodeElements(0)[2],uint(3));
+    QCOMPARE(meshView.getNNodeElements(3),uint(1));
+    QCOMPARE(meshView.getNodeElements(3)[0],uint(3));
+    QCOMPARE(meshView.getNNodeElements(4),uint(2));
+    QCOMPARE(meshView.getNodeElements(4)[0],uint(0));
+    QCOMPARE(meshView.getNodeElements(4)[1],uint(1));
+
+    // Unused node.
+    QCOMPARE(meshView.getNNodeElements(5),uint(0));
+
+    RMeshView meshViewCopy(meshView);
+    QVERIFY(compareWithMesh(meshViewCopy,nodes,elements));
+}
+
+void tst_RMeshView::update() const
+{
+    std::vector<RNode> nodes;
+    std::vector<RElement> elements;
+    buildMesh(nodes,elements);
+
+    RMeshView meshView;
+    QVERIFY(meshView.update(nodes,elements));
+    QCOMPARE(meshView.getNBuilds(),uint(1));
+
+    // Unchanged mesh must not trigger rebuild.
+    QVERIFY(!meshView.update(nodes,elements));
+    QCOMPARE(meshView.getNBuilds(),uint(1));
+
+    // Moved node must trigger rebuild.
+    nodes[3].setZ(1.5);
+    QVERIFY(!meshView.isValid(nodes,elements));
+    QVERIFY(meshView.update(nodes,elements));
+    QCOMPARE(meshView.getNBuilds(),uint(2));
+    QVERIFY(compareWithMesh(meshView,nodes,elements));
+
+    // Changed connectivity must trigger rebuild.
+    elements[1].setNodeId(1,5);
+    QVERIFY(meshView.update(nodes,elements));
+    QCOMPARE(meshView.getNNodeElements(5),uint(1));
+    QCOMPARE(meshView.getNNodeElements(4),uint(1));
+
+    // Explicit invalidation.
+    meshView.invalidate();
+    QVERIFY(!meshView.isValid(nodes,elements));
+    QCOMPARE(meshView.getNElements(),uint(0));
+    QVERIFY(meshView.update(nodes,elements));
+    QCOMPARE(meshView.getNBuilds(),uint(4));
+}
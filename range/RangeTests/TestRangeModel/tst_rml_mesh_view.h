@@ -0,0 +1,17 @@
+#ifndef TST_RMESHVIEW_H
+#define TST_RMESHVIEW_H
+
+#include <QtTest>
+
+class tst_RMeshView : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void values() const;
+        void update() const;
+
+};
+
+#endif // TST_RMESHVIEW_H
@@ -0,0 +1,116 @@
+#include <cmath>
+
+#include <rmlib.h>
+
+#include "tst_rml_model.h"
+
+static double findPositionValue(double x, double y, double z)
+{
+    return x + 10.0*y + 100.0*z;
+}
+
+void tst_RModel::reorderMesh() const
+{
+    const uint n = 6;
+    const uint nNodes = (n+1)*(n+1)*(n+1);
+
+    // Cube of tetrahedra with scrambled node numbering split into two volumes.
+    std::vector<uint> nodeIDs(nNodes);
+    std::vector<RNode> nodes(nNodes);
+    for (uint k=0;k<=n;k++)
+    {
+        for (uint j=0;j<=n;j++)
+        {
+            for (uint i=0;i<=n;i++)
+            {
+                uint p = i+(n+1)*(j+(n+1)*k);
+                // Step is coprime with number of nodes.
+                nodeIDs[p] = (p * 11) % nNodes;
+                nodes[nodeIDs[p]] = RNode(double(i),double(j),double(k));
+            }
+        }
+    }
+
+    RModel model;
+    for (uint i=0;i<nNodes;i++)
+    {
+        model.addNode(nodes[i]);
+    }
+
+    const uint tetrahedra[5][4] = { {0,1,3,4}, {1,2,3,6}, {1,3,4,6}, {1,4,5,6}, {3,4,6,7} };
+    for (uint k=0;k<n;k++)
+    {
+        for (uint j=0;j<n;j++)
+        {
+            for (uint i=0;i<n;i++)
+            {
+                uint c[8] = { i+(n+1)*(j+(n+1)*k), i+1+(n+1)*(j+(n+1)*k), i+1+(n+1)*(j+1+(n+1)*k), i+(n+1)*(j+1+(n+1)*k),
+                              i+(n+1)*(j+(n+1)*(k+1)), i+1+(n+1)*(j+(n+1)*(k+1)), i+1+(n+1)*(j+1+(n+1)*(k+1)), i+(n+1)*(j+1+(n+1)*(k+1)) };
+                for (uint q=0;q<5;q++)
+                {
+                    RElement element(R_ELEMENT_TETRA1);
+                    for (uint r=0;r<4;r++)
+                    {
+                        element.setNodeId(r,nodeIDs[c[tetrahedra[q][r]]]);
+                    }
+                    model.addElement(element,true,(k < n/2) ? 1 : 0);
+                }
+            }
+        }
+    }
+
+    uint nElements = model.getNElements();
+
+    RVariable nodeVariable(R_VARIABLE_TEMPERATURE,R_VARIABLE_APPLY_NODE);
+    nodeVariable.resize(1,nNodes);
+    for (uint i=0;i<nNodes;i++)
+    {
+        const RNode &node = model.getNode(i);
+        nodeVariable.setValue(0,i,findPositionValue(node.getX(),node.getY(),node.getZ()));
+    }
+    model.addVariable(nodeVariable);
+
+    RVariable elementVariable(R_VARIABLE_HEAT_FLUX,R_VARIABLE_APPLY_ELEMENT);
+    elementVariable.resize(1,nElements);
+    for (uint i=0;i<nElements;i++)
+    {
+        double x, y, z;
+        model.getElement(i).findCenter(model.getNodes(),x,y,z);
+        elementVariable.setValue(0,i,findPositionValue(x,y,z));
+    }
+    model.addVariable(elementVariable);
+
+    model.reorderMesh();
+
+    QVERIFY(model.getNNodes() == nNodes);
+    QVERIFY(model.getNElements() == nElements);
+
+    // Results follow their nodes and elements.
+    for (uint i=0;i<nNodes;i++)
+    {
+        const RNode &node = model.getNode(i);
+        QVERIFY(std::fabs(model.getVariable(0).getValue(0,i) - findPositionValue(node.getX(),node.getY(),node.getZ())) < RConstants::eps);
+    }
+    for (uint i=0;i<nElements;i++)
+    {
+        double x, y, z;
+        model.getElement(i).findCenter(model.getNodes(),x,y,z);
+        QVERIFY(std::fabs(model.getVariable(1).getValue(0,i) - findPositionValue(x,y,z)) < RConstants::eps);
+    }
+
+    // Elements of each volume occupy contiguous block of IDs.
+    QVERIFY(model.getNVolumes() == 2);
+    uint nextID = 0;
+    for (uint i=0;i<model.getNVolumes();i++)
+    {
+        const RVolume &volume = model.getVolume(i);
+        QVERIFY(volume.size() == nElements/2);
+        for (uint j=0;j<volume.size();j++)
+        {
+            QVERIFY(volume.get(j) == nextID++);
+            double x, y, z;
+            model.getElement(volume.get(j)).findCenter(model.getNodes(),x,y,z);
+            QVERIFY((z < double(n/2)) == (i == 1));
+        }
+    }
+}
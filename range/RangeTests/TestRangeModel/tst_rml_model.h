@@ -0,0 +1,16 @@
+#ifndef TST_RMODEL_H
+#define TST_RMODEL_H
+
+#include <QtTest>
+
+class tst_RModel : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void reorderMesh() const;
+
+};
+
+#endif // TST_RMODEL_H
@@ -25,3 +25,35 @@ void tst_RSparseMatrix::addMatrix() const
     QVERIFY(R_D_ARE_SAME(A1.findValue(1,0),-1.0));
     QVERIFY(R_D_ARE_SAME(A1.findValue(1,1),4.0));
 }
+
+void tst_RSparseMatrix::clearValues() const
+{
+    RSparseMatrix A;
+    A.setNRows(2);
+
+    std::vector<uint> indexes;
+    indexes.push_back(0);
+    indexes.push_back(1);
+    A.getVector(0).setIndexes(indexes);
+
+    A.addValue(0,1,2.0);
+    A.addValue(1,1,3.0);
+
+    QVERIFY(A.getNColumns(0) == 2);
+    QVERIFY(R_D_ARE_SAME(A.findValue(0,0),0.0));
+    QVERIFY(R_D_ARE_SAME(A.findValue(0,1),2.0));
+
+    A.clearValues();
+
+    QVERIFY(A.getNColumns(0) == 2);
+    QVERIFY(A.getNColumns(1) == 1);
+    QVERIFY(R_D_ARE_SAME(A.findValue(0,1),0.0));
+
+    A.addValue(0,1,5.0);
+    A.addValue(1,0,1.0);
+
+    QVERIFY(A.getNColumns(0) == 2);
+    QVERIFY(R_D_ARE_SAME(A.findValue(0,1),5.0));
+    QVERIFY(A.getVector(1).getIndex(0) == 0);
+    QVERIFY(A.getVector(1).getIndex(1) == 1);
+}
@@ -10,6 +10,7 @@ class tst_RSparseMatrix : public QObject
 
     private slots:
         void addMatrix() const;
+        void clearValues() const;
 
 };
 
@@ -0,0 +1,149 @@
+#include <rmlib.h>
+
+#include "tst_rml_sparse_matrix_bsr.h"
+
+static RSparseMatrixCSR buildMatrix(uint n)
+{
+    RSparseMatrix A;
+    for (uint i=0;i<n;i++)
+    {
+        A.addValue(i,i,4.0 + double(i));
+        if (i > 0)
+        {
+            A.addValue(i,i-1,-1.0 - 0.1*double(i));
+        }
+        if (i+1 < n)
+        {
+            A.addValue(i,i+1,-1.0 + 0.2*double(i));
+        }
+        if (i+4 < n)
+        {
+            A.addValue(i,i+4,0.5);
+            A.addValue(i+4,i,0.25);
+        }
+    }
+    return RSparseMatrixCSR(A);
+}
+
+static bool compareMlt(const RSparseMatrixCSR &C, const RSparseMatrixBSR &B)
+{
+    RRVector x(C.getNRows());
+    for (uint i=0;i<x.size();i++)
+    {
+        x[i] = 1.0 + 0.5*double(i);
+    }
+
+    RRVector yc, yb;
+    RSparseMatrixCSR::mlt(C,x,yc);
+    RSparseMatrixBSR::mlt(B,x,yb);
+
+    if (yc.size() != yb.size())
+    {
+        return false;
+    }
+    for (uint i=0;i<yc.size();i++)
+    {
+        if (std::abs(yc[i]-yb[i]) > 1.0e-12)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void tst_RSparseMatrixBSR::build() const
+{
+    RSparseMatrixCSR C(buildMatrix(9));
+    RSparseMatrixBSR B(C,3);
+
+    QVERIFY(B.getBlockSize() == 3);
+    QVERIFY(B.getNRows() == 9);
+    QVERIFY(B.getNBlockRows() == 3);
+    QVERIFY(B.getNBlocks() == 9);
+
+    B.clear();
+    QVERIFY(B.getNRows() == 0);
+    QVERIFY(B.getNBlocks() == 0);
+}
+
+void tst_RSparseMatrixBSR::mlt() const
+{
+    RSparseMatrixCSR C3(buildMatrix(12));
+    QVERIFY(compareMlt(C3,RSparseMatrixBSR(C3,3)));
+
+    RSparseMatrixCSR C4(buildMatrix(16));
+    QVERIFY(compareMlt(C4,RSparseMatrixBSR(C4,4)));
+
+    RSparseMatrixCSR C5(buildMatrix(15));
+    QVERIFY(compareMlt(C5,RSparseMatrixBSR(C5,5)));
+}
+
+void tst_RSparseMatrixBSR::mltPartialBlocks() const
+{
+    // Last block is not complete.
+    RSparseMatrixCSR C(buildMatrix(11));
+    QVERIFY(compareMlt(C,RSparseMatrixBSR(C,3)));
+    QVERIFY(compareMlt(C,RSparseMatrixBSR(C,4)));
+
+    // Interleaved blocks with one and two missing components.
+    std::vector<uint> rowBlockIndexes = {0,1,0,2,1,0,2,3,3,3,1};
+    RSparseMatrixBSR B(C,3,rowBlockIndexes);
+    QVERIFY(B.getNBlockRows() == 4);
+    QVERIFY(compareMlt(C,B));
+
+    rowBlockIndexes = {0,0,0,0,1,1,1,1,2,2,3};
+    QVERIFY(compareMlt(C,RSparseMatrixBSR(C,4,rowBlockIndexes)));
+}
+
+void tst_RSparseMatrixBSR::updateValues() const
+{
+    RSparseMatrixCSR C(buildMatrix(11));
+    std::vector<uint> rowBlockIndexes = {0,1,0,2,1,0,2,3,3,3,1};
+    RSparseMatrixBSR B(C,3,rowBlockIndexes);
+
+    // Same pattern, different values.
+    for (uint i=0;i<C.getNValues();i++)
+    {
+        C.getValue(i) = 2.0*C.getValue(i) + 1.0;
+    }
+    QVERIFY(!compareMlt(C,B));
+
+    B.updateValues(C);
+    QVERIFY(compareMlt(C,B));
+}
+
+void tst_RSparseMatrixBSR::inverseBlockDiagonal() const
+{
+    RSparseMatrixCSR C(buildMatrix(10));
+    RSparseMatrixBSR B(C,3);
+
+    RSparseMatrixBSR D;
+    B.findInverseBlockDiagonal(D);
+
+    QVERIFY(D.getNBlockRows() == B.getNBlockRows());
+    QVERIFY(D.getNBlocks() == B.getNBlockRows());
+
+    // Inverse of block diagonal multiplied by block diagonal part of matrix gives identity.
+    for (uint i=0;i<C.getNRows();i++)
+    {
+        RRVector x(C.getNRows(),0.0);
+        x[i] = 1.0;
+
+        RRVector y;
+        RSparseMatrixCSR::mlt(C,x,y);
+        for (uint j=0;j<y.size();j++)
+        {
+            if (j/3 != i/3)
+            {
+                y[j] = 0.0;
+            }
+        }
+
+        RRVector z;
+        RSparseMatrixBSR::mlt(D,y,z);
+        for (uint j=0;j<z.size();j++)
+        {
+            QVERIFY(std::abs(z[j] - (i == j ? 1.0 : 0.0)) < 1.0e-12);
+        }
+    }
+}
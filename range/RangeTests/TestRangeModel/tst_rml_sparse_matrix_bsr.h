@@ -0,0 +1,20 @@
+#ifndef TST_RSPARSEMATRIXBSR_H
+#define TST_RSPARSEMATRIXBSR_H
+
+#include <QtTest>
+
+class tst_RSparseMatrixBSR : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void build() const;
+        void mlt() const;
+        void mltPartialBlocks() const;
+        void updateValues() const;
+        void inverseBlockDiagonal() const;
+
+};
+
+#endif // TST_RSPARSEMATRIXBSR_H
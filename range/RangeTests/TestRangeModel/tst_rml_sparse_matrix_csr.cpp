@@ -0,0 +1,96 @@
+#include <rmlib.h>
+
+#include "tst_rml_sparse_matrix_csr.h"
+
+void tst_RSparseMatrixCSR::build() const
+{
+    RSparseMatrix A;
+    A.addValue(0,2,2.0);
+    A.addValue(0,0,1.0);
+    A.addValue(1,1,3.0);
+    A.addValue(2,0,4.0);
+    A.addValue(2,2,5.0);
+
+    RSparseMatrixCSR C(A);
+
+    QVERIFY(C.getNRows() == 3);
+    QVERIFY(C.getNValues() == 5);
+    QVERIFY(C.getRowBegin(1) == 2);
+    QVERIFY(C.getRowEnd(1) == 3);
+    QVERIFY(C.getColumnIndex(0) == 0);
+    QVERIFY(C.getColumnIndex(1) == 2);
+
+    QVERIFY(R_D_ARE_SAME(C.findValue(0,2),2.0));
+    QVERIFY(R_D_ARE_SAME(C.findValue(2,0),4.0));
+    QVERIFY(R_D_ARE_SAME(C.findValue(1,0),0.0));
+    QVERIFY(R_D_ARE_SAME(C.findNorm(),A.findNorm()));
+}
+
+void tst_RSparseMatrixCSR::mlt() const
+{
+    RSparseMatrix A;
+    A.addValue(0,0,1.0);
+    A.addValue(0,2,2.0);
+    A.addValue(1,1,3.0);
+    A.addValue(2,0,4.0);
+    A.addValue(2,2,5.0);
+
+    RSparseMatrixCSR C(A);
+
+    RRVector x(3);
+    x[0] = 1.0;
+    x[1] = 2.0;
+    x[2] = 3.0;
+
+    RRVector y;
+    RSparseMatrixCSR::mlt(C,x,y);
+
+    QVERIFY(y.size() == 3);
+    QVERIFY(R_D_ARE_SAME(y[0],7.0));
+    QVERIFY(R_D_ARE_SAME(y[1],6.0));
+    QVERIFY(R_D_ARE_SAME(y[2],19.0));
+}
+
+void tst_RSparseMatrixCSR::mltMatrix() const
+{
+    RSparseMatrix A;
+    A.addValue(0,0,1.0);
+    A.addValue(0,2,2.0);
+    A.addValue(1,1,3.0);
+    A.addValue(2,0,4.0);
+    A.addValue(2,2,5.0);
+
+    RSparseMatrix B;
+    B.addValue(0,1,1.0);
+    B.addValue(1,0,2.0);
+    B.addValue(2,1,3.0);
+
+    RSparseMatrixCSR C;
+    RSparseMatrixCSR::mlt(RSparseMatrixCSR(A),RSparseMatrixCSR(B),C);
+
+    QVERIFY(C.getNRows() == 3);
+    QVERIFY(C.getNValues() == 3);
+    QVERIFY(R_D_ARE_SAME(C.findValue(0,1),7.0));
+    QVERIFY(R_D_ARE_SAME(C.findValue(1,0),6.0));
+    QVERIFY(R_D_ARE_SAME(C.findValue(2,1),19.0));
+}
+
+void tst_RSparseMatrixCSR::transpose() const
+{
+    RSparseMatrix A;
+    A.addValue(0,0,1.0);
+    A.addValue(0,2,2.0);
+    A.addValue(1,1,3.0);
+    A.addValue(2,0,4.0);
+
+    RSparseMatrixCSR At;
+    RSparseMatrixCSR::transpose(RSparseMatrixCSR(A),4,At);
+
+    QVERIFY(At.getNRows() == 4);
+    QVERIFY(At.getNValues() == 4);
+    QVERIFY(At.getRowBegin(3) == At.getRowEnd(3));
+    QVERIFY(At.getColumnIndex(At.getRowBegin(0)) == 0);
+    QVERIFY(At.getColumnIndex(At.getRowBegin(0)+1) == 2);
+    QVERIFY(R_D_ARE_SAME(At.findValue(2,0),2.0));
+    QVERIFY(R_D_ARE_SAME(At.findValue(0,2),4.0));
+}
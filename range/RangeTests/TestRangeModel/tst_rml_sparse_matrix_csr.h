@@ -0,0 +1,19 @@
+#ifndef TST_RSPARSEMATRIXCSR_H
+#define TST_RSPARSEMATRIXCSR_H
+
+#include <QtTest>
+
+class tst_RSparseMatrixCSR : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void build() const;
+        void mlt() const;
+        void mltMatrix() const;
+        void transpose() const;
+
+};
+
+#endif // TST_RSPARSEMATRIXCSR_H
@@ -0,0 +1,184 @@
+#include <rmlib.h>
+#include <relementmatrixoperator.h>
+#include <rmatrixsolver.h>
+
+#include "tst_relementmatrixoperator.h"
+
+// Bilinear quadrilateral elements on n x n grid (Laplace operator plus small mass term).
+// Boundary nodes are excluded from matrix system.
+// Elements are split into four batches so that elements in one batch do not share any node.
+static void buildGridOperator(uint n, bool symmetric, RElementMatrixOperator &matrixOperator, RSparseMatrix &matrix)
+{
+    uint nNodes = (n+1)*(n+1);
+    std::vector<uint> nodePositions(nNodes,RConstants::eod);
+    uint nRows = 0;
+    for (uint i=1;i<n;i++)
+    {
+        for (uint j=1;j<n;j++)
+        {
+            nodePositions[i*(n+1)+j] = nRows++;
+        }
+    }
+
+    std::vector<uint> elementSizes(n*n,4);
+    std::vector< std::vector<uint> > elementBatches(4);
+    for (uint i=0;i<n;i++)
+    {
+        for (uint j=0;j<n;j++)
+        {
+            elementBatches[2*(i%2)+(j%2)].push_back(i*n+j);
+        }
+    }
+
+    matrixOperator.build(nRows,elementSizes,elementBatches,symmetric);
+    matrix.setNRows(nRows);
+
+    for (uint i=0;i<n;i++)
+    {
+        for (uint j=0;j<n;j++)
+        {
+            uint elementID = i*n+j;
+            uint nodes[4] = { i*(n+1)+j, i*(n+1)+j+1, (i+1)*(n+1)+j+1, (i+1)*(n+1)+j };
+            uint positions[4];
+
+            RRSmallMatrix Ae(4,4);
+            for (uint m=0;m<4;m++)
+            {
+                positions[m] = nodePositions[nodes[m]];
+                for (uint l=0;l<4;l++)
+                {
+                    uint d = (m > l) ? (m - l) : (l - m);
+                    Ae[m][l] = (d == 0) ? 2.0/3.0 : ((d == 2) ? -1.0/3.0 : -1.0/6.0);
+                    Ae[m][l] += (m == l) ? 0.01 : 0.0;
+                    if (!symmetric && l == (m+1)%4)
+                    {
+                        Ae[m][l] += 0.05 * double(elementID%3);
+                    }
+                }
+            }
+
+            matrixOperator.setElementMatrix(elementID,positions,Ae);
+
+            for (uint m=0;m<4;m++)
+            {
+                for (uint l=0;l<4;l++)
+                {
+                    if (positions[m] != RConstants::eod && positions[l] != RConstants::eod)
+                    {
+                        matrix.addValue(positions[m],positions[l],Ae[m][l]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static RRVector buildVector(uint n)
+{
+    RRVector x(n);
+    for (uint i=0;i<n;i++)
+    {
+        x[i] = 1.0 + double(i%5) - 0.25 * double(i%3);
+    }
+    return x;
+}
+
+static bool isEqual(const RRVector &x, const RRVector &y, double tolerance)
+{
+    if (x.size() != y.size())
+    {
+        return false;
+    }
+    for (uint i=0;i<x.size();i++)
+    {
+        if (std::abs(x[i]-y[i]) > tolerance * (1.0 + std::abs(x[i])))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void tst_RElementMatrixOperator::mlt() const
+{
+    for (uint s=0;s<2;s++)
+    {
+        bool symmetric = (s == 0);
+
+        RElementMatrixOperator matrixOperator;
+        RSparseMatrix matrix;
+        buildGridOperator(12,symmetric,matrixOperator,matrix);
+        RSparseMatrixCSR A(matrix);
+
+        RRVector x(buildVector(A.getNRows()));
+        RRVector y1, y2;
+
+        RSparseMatrixCSR::mlt(A,x,y1);
+
+#pragma omp parallel default(shared)
+        {
+            matrixOperator.mlt(x,y2);
+        }
+
+        QVERIFY(isEqual(y1,y2,1.0e-12));
+
+        // Outside of parallel region.
+        y2.fill(0.0);
+        matrixOperator.mlt(x,y2);
+
+        QVERIFY(isEqual(y1,y2,1.0e-12));
+
+        QVERIFY(std::abs(matrixOperator.findNorm() - A.findNorm()) < 1.0e-12 * A.findNorm());
+    }
+}
+
+void tst_RElementMatrixOperator::diagonal() const
+{
+    RElementMatrixOperator matrixOperator;
+    RSparseMatrix matrix;
+    buildGridOperator(10,true,matrixOperator,matrix);
+    RSparseMatrixCSR A(matrix);
+
+    RRVector d;
+    matrixOperator.findDiagonal(d);
+
+    QVERIFY(d.size() == A.getNRows());
+    for (uint i=0;i<d.size();i++)
+    {
+        QVERIFY(std::abs(d[i] - A.findValue(i,i)) < 1.0e-12);
+    }
+
+    // Zeroed values keep layout.
+    matrixOperator.clearValues();
+    matrixOperator.findDiagonal(d);
+    QVERIFY(d.size() == A.getNRows());
+    QVERIFY(RRVector::norm(d) == 0.0);
+}
+
+void tst_RElementMatrixOperator::solve() const
+{
+    RElementMatrixOperator matrixOperator;
+    RSparseMatrix matrix;
+    buildGridOperator(20,true,matrixOperator,matrix);
+    RSparseMatrixCSR A(matrix);
+
+    RRVector b(buildVector(A.getNRows()));
+
+    RMatrixSolverConf matrixSolverConf(RMatrixSolverConf::CG);
+    matrixSolverConf.setSolverCvgValue(1.0e-12);
+    matrixSolverConf.setNOuterIterations(2000);
+
+    RRVector x1, x2;
+
+    RMatrixSolver solver1(matrixSolverConf);
+    solver1.solve(A,b,x1,R_MATRIX_PRECONDITIONER_JACOBI);
+
+    RMatrixSolver solver2(matrixSolverConf);
+    solver2.solve(matrixOperator,b,x2,R_MATRIX_PRECONDITIONER_JACOBI);
+
+    QVERIFY(isEqual(x1,x2,1.0e-8));
+
+    RRVector y;
+    RSparseMatrixCSR::mlt(A,x2,y);
+    QVERIFY(isEqual(y,b,1.0e-8));
+}
@@ -0,0 +1,18 @@
+#ifndef TST_RELEMENTMATRIXOPERATOR_H
+#define TST_RELEMENTMATRIXOPERATOR_H
+
+#include <QtTest>
+
+class tst_RElementMatrixOperator : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void mlt() const;
+        void diagonal() const;
+        void solve() const;
+
+};
+
+#endif // TST_RELEMENTMATRIXOPERATOR_H
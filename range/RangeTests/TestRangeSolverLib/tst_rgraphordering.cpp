@@ -0,0 +1,116 @@
+#include <algorithm>
+
+#include <rgraphordering.h>
+
+#include "tst_rgraphordering.h"
+
+// Adjacency of n x n grid graph with vertices numbered in scrambled order.
+static void buildGridGraph(uint n, std::vector<uint> &adjacencyPointers, std::vector<uint> &adjacency)
+{
+    uint nVertices = n*n;
+
+    // Vertex (i,j) gets number (i*n+j)*step % nVertices (n must not be multiple of step).
+    uint step = 7;
+
+    std::vector< std::vector<uint> > neighbors(nVertices);
+    for (uint i=0;i<n;i++)
+    {
+        for (uint j=0;j<n;j++)
+        {
+            uint v = ((i*n+j)*step) % nVertices;
+            if (i+1 < n)
+            {
+                uint w = (((i+1)*n+j)*step) % nVertices;
+                neighbors[v].push_back(w);
+                neighbors[w].push_back(v);
+            }
+            if (j+1 < n)
+            {
+                uint w = ((i*n+j+1)*step) % nVertices;
+                neighbors[v].push_back(w);
+                neighbors[w].push_back(v);
+            }
+        }
+    }
+
+    adjacencyPointers.assign(nVertices+1,0);
+    adjacency.clear();
+    for (uint i=0;i<nVertices;i++)
+    {
+        std::sort(neighbors[i].begin(),neighbors[i].end());
+        adjacency.insert(adjacency.end(),neighbors[i].begin(),neighbors[i].end());
+        adjacencyPointers[i+1] = uint(adjacency.size());
+    }
+}
+
+static bool isPermutation(const std::vector<uint> &permutation, uint nVertices)
+{
+    if (permutation.size() != nVertices)
+    {
+        return false;
+    }
+    std::vector<bool> found(nVertices,false);
+    for (uint i=0;i<permutation.size();i++)
+    {
+        if (permutation[i] >= nVertices || found[permutation[i]])
+        {
+            return false;
+        }
+        found[permutation[i]] = true;
+    }
+    return true;
+}
+
+void tst_RGraphOrdering::reverseCuthillMcKee() const
+{
+    uint n = 20;
+    std::vector<uint> adjacencyPointers;
+    std::vector<uint> adjacency;
+    buildGridGraph(n,adjacencyPointers,adjacency);
+
+    std::vector<uint> permutation;
+    RGraphOrdering::findReverseCuthillMcKee(adjacencyPointers,adjacency,permutation);
+
+    QVERIFY(isPermutation(permutation,n*n));
+
+    uint originalBandwidth = RGraphOrdering::findBandwidth(adjacencyPointers,adjacency,std::vector<uint>());
+    uint bandwidth = RGraphOrdering::findBandwidth(adjacencyPointers,adjacency,permutation);
+
+    QVERIFY(bandwidth < originalBandwidth);
+    // Level structure of grid started from corner has at most n+1 vertices per level.
+    QVERIFY(bandwidth <= 2*n);
+}
+
+void tst_RGraphOrdering::nestedDissection() const
+{
+    uint n = 40;
+    std::vector<uint> adjacencyPointers;
+    std::vector<uint> adjacency;
+    buildGridGraph(n,adjacencyPointers,adjacency);
+
+    std::vector<uint> permutation;
+    RGraphOrdering::findNestedDissection(adjacencyPointers,adjacency,permutation);
+
+    QVERIFY(isPermutation(permutation,n*n));
+}
+
+void tst_RGraphOrdering::disconnectedGraph() const
+{
+    // Two paths 0-2-4 and 1-3 and isolated vertex 5.
+    std::vector<uint> adjacencyPointers;
+    std::vector<uint> adjacency;
+
+    uint pointers[] = { 0, 1, 2, 4, 5, 6, 6 };
+    uint neighbors[] = { 2, 3, 0, 4, 1, 2 };
+    adjacencyPointers.assign(pointers,pointers+7);
+    adjacency.assign(neighbors,neighbors+6);
+
+    std::vector<uint> permutation;
+
+    RGraphOrdering::findReverseCuthillMcKee(adjacencyPointers,adjacency,permutation);
+    QVERIFY(isPermutation(permutation,6));
+    QVERIFY(RGraphOrdering::findBandwidth(adjacencyPointers,adjacency,permutation) == 1);
+
+    RGraphOrdering::findNestedDissection(adjacencyPointers,adjacency,permutation);
+    QVERIFY(isPermutation(permutation,6));
+}
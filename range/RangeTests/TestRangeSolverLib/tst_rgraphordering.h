@@ -0,0 +1,18 @@
+#ifndef TST_RGRAPHORDERING_H
+#define TST_RGRAPHORDERING_H
+
+#include <QtTest>
+
+class tst_RGraphOrdering : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void reverseCuthillMcKee() const;
+        void nestedDissection() const;
+        void disconnectedGraph() const;
+
+};
+
+#endif // TST_RGRAPHORDERING_H
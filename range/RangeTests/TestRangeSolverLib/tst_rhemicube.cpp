@@ -0,0 +1,398 @@
+#include <cmath>
+#include <set>
+
+#include <rhemicube.h>
+
+#include "tst_rhemicube.h"
+
+// Render square [-a,a]x[-a,a] at height h facing the eye in origin.
+static void rayTraceSquare(RHemiCube &hemiCube, double a, double h, uint color)
+{
+    hemiCube.rayTraceTriangle(RTriangle(RR3Vector(-a,-a,h),RR3Vector(-a,a,h),RR3Vector(a,a,h)),color);
+    hemiCube.rayTraceTriangle(RTriangle(RR3Vector(-a,-a,h),RR3Vector(a,a,h),RR3Vector(a,-a,h)),color);
+}
+
+// Add n x n triangulated square face (origin o, edges a and b, normal a x b) as one surface.
+static void addFace(RModel &model, const RR3Vector &o, const RR3Vector &a, const RR3Vector &b, uint n, uint surfaceID)
+{
+    double s[4][2] = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 1.0, 1.0 }, { 0.0, 1.0 } };
+    for (uint i=0;i<n;i++)
+    {
+        for (uint j=0;j<n;j++)
+        {
+            uint nodeID = model.getNNodes();
+            for (uint k=0;k<4;k++)
+            {
+                double u = (double(i) + s[k][0]) / double(n);
+                double v = (double(j) + s[k][1]) / double(n);
+                model.addNode(RNode(o[0]+u*a[0]+v*b[0],o[1]+u*a[1]+v*b[1],o[2]+u*a[2]+v*b[2]));
+            }
+            RElement e1(R_ELEMENT_TRI1);
+            e1.setNodeId(0,nodeID);
+            e1.setNodeId(1,nodeID+1);
+            e1.setNodeId(2,nodeID+2);
+            model.addElement(e1,true,surfaceID);
+            RElement e2(R_ELEMENT_TRI1);
+            e2.setNodeId(0,nodeID);
+            e2.setNodeId(1,nodeID+2);
+            e2.setNodeId(2,nodeID+3);
+            model.addElement(e2,true,surfaceID);
+        }
+    }
+}
+
+// Unit cube enclosure (inward normals) with small box inside (outward normals).
+static void buildEnclosure(RModel &model)
+{
+    double l = 0.35;
+    double d = 0.3;
+    uint surfaceID = 0;
+
+    addFace(model,RR3Vector(0.0,0.0,0.0),RR3Vector(1.0,0.0,0.0),RR3Vector(0.0,1.0,0.0),2,surfaceID++);
+    addFace(model,RR3Vector(0.0,1.0,1.0),RR3Vector(1.0,0.0,0.0),RR3Vector(0.0,-1.0,0.0),2,surfaceID++);
+    addFace(model,RR3Vector(0.0,0.0,0.0),RR3Vector(0.0,1.0,0.0),RR3Vector(0.0,0.0,1.0),2,surfaceID++);
+    addFace(model,RR3Vector(1.0,1.0,0.0),RR3Vector(0.0,-1.0,0.0),RR3Vector(0.0,0.0,1.0),2,surfaceID++);
+    addFace(model,RR3Vector(0.0,0.0,0.0),RR3Vector(0.0,0.0,1.0),RR3Vector(1.0,0.0,0.0),2,surfaceID++);
+    addFace(model,RR3Vector(1.0,1.0,0.0),RR3Vector(0.0,0.0,1.0),RR3Vector(-1.0,0.0,0.0),2,surfaceID++);
+
+    addFace(model,RR3Vector(l,l,l),RR3Vector(0.0,d,0.0),RR3Vector(d,0.0,0.0),1,surfaceID++);
+    addFace(model,RR3Vector(l,l,l+d),RR3Vector(d,0.0,0.0),RR3Vector(0.0,d,0.0),1,surfaceID++);
+    addFace(model,RR3Vector(l,l,l),RR3Vector(0.0,0.0,d),RR3Vector(0.0,d,0.0),1,surfaceID++);
+    addFace(model,RR3Vector(l+d,l,l),RR3Vector(0.0,d,0.0),RR3Vector(0.0,0.0,d),1,surfaceID++);
+    addFace(model,RR3Vector(l,l,l),RR3Vector(d,0.0,0.0),RR3Vector(0.0,0.0,d),1,surfaceID++);
+    addFace(model,RR3Vector(l,l+d,l),RR3Vector(0.0,0.0,d),RR3Vector(d,0.0,0.0),1,surfaceID++);
+
+    model.getProblemSetup().getRadiationSetup().setResolution(R_RADIATION_RESOLUTION_LOW);
+}
+
+static void preparePatches(const RModel &model, RViewFactorMatrix &viewFactorMatrix, uint nonEmitterSurfaceID)
+{
+    std::vector<RPatchInput> &rPatchInput = viewFactorMatrix.getHeader().getPatchInput();
+    rPatchInput.resize(model.getNSurfaces());
+    for (uint i=0;i<rPatchInput.size();i++)
+    {
+        rPatchInput[i].setEmitter(i != nonEmitterSurfaceID);
+        rPatchInput[i].setReceiver(true);
+        rPatchInput[i].setPatchSize(1);
+        rPatchInput[i].setPatchArea(0.0);
+    }
+    model.generatePatchSurface(rPatchInput,viewFactorMatrix.getPatchBook());
+}
+
+static bool areSame(const RViewFactorMatrix &m1, const RViewFactorMatrix &m2)
+{
+    if (m1.size() != m2.size())
+    {
+        return false;
+    }
+    for (uint i=0;i<m1.size();i++)
+    {
+        const RSparseVector<double> &v1 = m1.getRow(i).getViewFactors();
+        const RSparseVector<double> &v2 = m2.getRow(i).getViewFactors();
+        if (v1.size() != v2.size())
+        {
+            return false;
+        }
+        for (uint j=0;j<v1.size();j++)
+        {
+            if (v1.getIndex(j) != v2.getIndex(j) || std::fabs(v1.getValue(j) - v2.getValue(j)) > 1.0e-12)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void tst_RHemiCube::parallelSquare() const
+{
+    RHemiCube hemiCube(RR3Vector(0.0,0.0,0.0),RR3Vector(0.0,0.0,1.0),100);
+
+    rayTraceSquare(hemiCube,1.0,1.0,0);
+
+    // Differential area to coaxial parallel square (side 2, distance 1).
+    double vfExact = 4.0 / RConstants::pi * std::atan(1.0/std::sqrt(2.0)) / std::sqrt(2.0);
+
+    std::map<uint,double> viewFactors = hemiCube.getViewFactors();
+    QVERIFY(viewFactors.size() == 1);
+    QVERIFY(std::fabs(viewFactors[0] - vfExact) < 0.01);
+}
+
+void tst_RHemiCube::depthOrder() const
+{
+    RHemiCube hemiCube(RR3Vector(0.0,0.0,0.0),RR3Vector(0.0,0.0,1.0),100);
+
+    // Far square is rendered first and must be hidden by the near one.
+    rayTraceSquare(hemiCube,1.0,2.0,1);
+    rayTraceSquare(hemiCube,1.0,1.0,0);
+
+    std::map<uint,double> viewFactors = hemiCube.getViewFactors();
+    QVERIFY(viewFactors.find(1) == viewFactors.end());
+    QVERIFY(viewFactors.find(0) != viewFactors.end());
+}
+
+void tst_RHemiCube::rayTraceScene() const
+{
+    RModel model;
+    buildEnclosure(model);
+
+    RViewFactorMatrix viewFactorMatrix;
+    preparePatches(model,viewFactorMatrix,RConstants::eod);
+
+    const RPatchBook &patchBook = viewFactorMatrix.getPatchBook();
+    RHemiCubeScene scene(model,patchBook,viewFactorMatrix.getHeader().getPatchInput());
+
+    QVERIFY(scene.getNTriangles() > 0);
+    QVERIFY(scene.getNNodes() > 1);
+
+    // Scene rendered through bounding volume hierarchy must match rendering of each triangle.
+    double maxDifference = 0.0;
+    for (uint eyePatchID=0;eyePatchID<patchBook.getNPatches();eyePatchID++)
+    {
+        const RPatch &eyePatch = patchBook.getPatch(eyePatchID);
+
+        RR3Vector eyePosition;
+        RR3Vector eyeDirection;
+        model.findPatchCenter(eyePatch,eyePosition[0],eyePosition[1],eyePosition[2]);
+        model.findPatchNormal(eyePatch,eyeDirection[0],eyeDirection[1],eyeDirection[2]);
+
+        RHemiCube sceneHemiCube(eyePosition,eyeDirection,50);
+        sceneHemiCube.rayTraceScene(scene,eyePatchID);
+
+        RHemiCube triangleHemiCube(eyePosition,eyeDirection,50);
+        for (uint patchID=0;patchID<patchBook.getNPatches();patchID++)
+        {
+            if (patchID == eyePatchID)
+            {
+                continue;
+            }
+            const RUVector &elementIDs = patchBook.getPatch(patchID).getElementIDs();
+            for (uint i=0;i<elementIDs.size();i++)
+            {
+                QList<RTriangle> triangles = model.getElement(elementIDs[i]).triangulate(model.getNodes());
+                for (int j=0;j<triangles.size();j++)
+                {
+                    triangleHemiCube.rayTraceTriangle(triangles[j],patchID);
+                }
+            }
+        }
+
+        std::map<uint,double> sceneViewFactors = sceneHemiCube.getViewFactors();
+        std::map<uint,double> triangleViewFactors = triangleHemiCube.getViewFactors();
+
+        std::set<uint> patchIDs;
+        std::map<uint,double>::const_iterator iter;
+        for (iter = sceneViewFactors.begin(); iter != sceneViewFactors.end(); ++iter)
+        {
+            patchIDs.insert(iter->first);
+        }
+        for (iter = triangleViewFactors.begin(); iter != triangleViewFactors.end(); ++iter)
+        {
+            patchIDs.insert(iter->first);
+        }
+        for (std::set<uint>::const_iterator it = patchIDs.begin(); it != patchIDs.end(); ++it)
+        {
+            maxDifference = std::max(maxDifference,std::fabs(sceneViewFactors[*it] - triangleViewFactors[*it]));
+        }
+    }
+    QVERIFY(maxDifference < 1.0e-12);
+}
+
+void tst_RHemiCube::updateViewFactors() const
+{
+    RModel model;
+    buildEnclosure(model);
+
+    RViewFactorMatrix oldViewFactorMatrix;
+    preparePatches(model,oldViewFactorMatrix,RConstants::eod);
+    RHemiCube::calculateViewFactors(model,oldViewFactorMatrix);
+    QVERIFY(oldViewFactorMatrix.getHeader().getPatchHashes().size() == oldViewFactorMatrix.getPatchBook().getNPatches());
+
+    // Lift top face of inner box and switch off emitter of one outer wall.
+    const RSurface &rSurface = model.getSurface(7);
+    std::set<uint> nodeIDs;
+    for (uint i=0;i<rSurface.size();i++)
+    {
+        const RElement &rElement = model.getElement(rSurface.get(i));
+        for (uint j=0;j<rElement.size();j++)
+        {
+            nodeIDs.insert(rElement.getNodeId(j));
+        }
+    }
+    for (std::set<uint>::const_iterator iter = nodeIDs.begin(); iter != nodeIDs.end(); ++iter)
+    {
+        model.getNode(*iter).setZ(model.getNode(*iter).getZ() + 0.05);
+    }
+
+    RViewFactorMatrix viewFactorMatrix;
+    preparePatches(model,viewFactorMatrix,2);
+    RHemiCube::calculateViewFactors(model,viewFactorMatrix);
+
+    RViewFactorMatrix updatedViewFactorMatrix;
+    preparePatches(model,updatedViewFactorMatrix,2);
+    RHemiCube::updateViewFactors(model,oldViewFactorMatrix,updatedViewFactorMatrix);
+
+    QVERIFY(updatedViewFactorMatrix.getHeader().getPatchHashes() == viewFactorMatrix.getHeader().getPatchHashes());
+    QVERIFY(areSame(updatedViewFactorMatrix,viewFactorMatrix));
+}
+
+void tst_RHemiCube::postProcessViewFactors() const
+{
+    RModel model;
+    buildEnclosure(model);
+
+    RViewFactorMatrix rawViewFactorMatrix;
+    preparePatches(model,rawViewFactorMatrix,RConstants::eod);
+    RHemiCube::calculateViewFactors(model,rawViewFactorMatrix);
+
+    model.getProblemSetup().getRadiationSetup().setViewFactorCorrection(true);
+    model.getProblemSetup().getRadiationSetup().setViewFactorThreshold(1.0e-3);
+
+    RViewFactorMatrix viewFactorMatrix;
+    preparePatches(model,viewFactorMatrix,RConstants::eod);
+    RHemiCube::calculateViewFactors(model,viewFactorMatrix);
+
+    const RPatchBook &rPatchBook = viewFactorMatrix.getPatchBook();
+    QVERIFY(viewFactorMatrix.size() == rPatchBook.getNPatches());
+
+    uint nRawValues = 0;
+    uint nValues = 0;
+    for (uint i=0;i<viewFactorMatrix.size();i++)
+    {
+        const RSparseVector<double> &rRawViewFactors = rawViewFactorMatrix.getRow(i).getViewFactors();
+        const RSparseVector<double> &rViewFactors = viewFactorMatrix.getRow(i).getViewFactors();
+        nRawValues += rRawViewFactors.size();
+        nValues += rViewFactors.size();
+
+        // Row sums are preserved.
+        double rawRowSum = 0.0;
+        for (uint j=0;j<rRawViewFactors.size();j++)
+        {
+            rawRowSum += rRawViewFactors.getValue(j);
+        }
+        double rowSum = 0.0;
+        for (uint j=0;j<rViewFactors.size();j++)
+        {
+            rowSum += rViewFactors.getValue(j);
+        }
+        QVERIFY(std::fabs(rowSum - std::min(rawRowSum,1.0)) < 1.0e-5);
+
+        // Exchange areas are symmetric.
+        double ai = 0.0;
+        model.findPatchArea(rPatchBook.getPatch(i),ai);
+        for (uint j=0;j<rViewFactors.size();j++)
+        {
+            uint patchID = rViewFactors.getIndex(j);
+            double aj = 0.0;
+            model.findPatchArea(rPatchBook.getPatch(patchID),aj);
+
+            uint position;
+            QVERIFY(viewFactorMatrix.getRow(patchID).getViewFactors().findPosition(i,position));
+            double gji = aj * viewFactorMatrix.getRow(patchID).getViewFactors().getValue(position);
+            QVERIFY(std::fabs(ai * rViewFactors.getValue(j) - gji) < 1.0e-12);
+        }
+    }
+    QVERIFY(nValues < nRawValues);
+}
+
+void tst_RHemiCube::postProcessUpdateViewFactors() const
+{
+    RModel model;
+    buildEnclosure(model);
+    model.getProblemSetup().getRadiationSetup().setViewFactorCorrection(true);
+    model.getProblemSetup().getRadiationSetup().setViewFactorThreshold(1.0e-3);
+
+    RViewFactorMatrix oldViewFactorMatrix;
+    preparePatches(model,oldViewFactorMatrix,RConstants::eod);
+    RHemiCube::calculateViewFactors(model,oldViewFactorMatrix);
+    QVERIFY(oldViewFactorMatrix.getHeader().getViewFactorCorrection());
+
+    // Switch off emitter of one outer wall, geometry remains unchanged.
+    RViewFactorMatrix viewFactorMatrix;
+    preparePatches(model,viewFactorMatrix,2);
+    RHemiCube::calculateViewFactors(model,viewFactorMatrix);
+
+    RViewFactorMatrix updatedViewFactorMatrix;
+    preparePatches(model,updatedViewFactorMatrix,2);
+    RHemiCube::updateViewFactors(model,oldViewFactorMatrix,updatedViewFactorMatrix);
+
+    // Rows copied from old matrix must not be corrected twice.
+    QVERIFY(areSame(updatedViewFactorMatrix,viewFactorMatrix));
+}
+
+void tst_RHemiCube::monteCarloParallelPlates() const
+{
+    // Coaxial parallel unit squares at unit distance.
+    RModel model;
+    addFace(model,RR3Vector(0.0,0.0,0.0),RR3Vector(1.0,0.0,0.0),RR3Vector(0.0,1.0,0.0),4,0);
+    addFace(model,RR3Vector(0.0,0.0,1.0),RR3Vector(0.0,1.0,0.0),RR3Vector(1.0,0.0,0.0),4,1);
+    model.getProblemSetup().getRadiationSetup().setResolution(R_RADIATION_RESOLUTION_LOW);
+    model.getProblemSetup().getRadiationSetup().setViewFactorMethod(R_VIEW_FACTOR_METHOD_MONTE_CARLO);
+
+    RViewFactorMatrix viewFactorMatrix;
+    preparePatches(model,viewFactorMatrix,RConstants::eod);
+    RHemiCube::calculateViewFactors(model,viewFactorMatrix);
+    QVERIFY(viewFactorMatrix.getHeader().getViewFactorMethod() == R_VIEW_FACTOR_METHOD_MONTE_CARLO);
+
+    double x = std::sqrt(2.0);
+    double vfExact = 2.0 / RConstants::pi * (std::log(std::sqrt(4.0/3.0)) + 2.0 * x * std::atan(1.0/x) - 2.0 * std::atan(1.0));
+
+    double area = 0.0;
+    double vf = 0.0;
+    for (uint i=0;i<viewFactorMatrix.size();i++)
+    {
+        const RPatch &rPatch = viewFactorMatrix.getPatchBook().getPatch(i);
+        const RSparseVector<double> &rViewFactors = viewFactorMatrix.getRow(i).getViewFactors();
+        for (uint j=0;j<rViewFactors.size();j++)
+        {
+            // Patches of the same plate can not see each other.
+            QVERIFY(viewFactorMatrix.getPatchBook().getPatch(rViewFactors.getIndex(j)).getSurfaceID() != rPatch.getSurfaceID());
+        }
+        if (rPatch.getSurfaceID() != 0)
+        {
+            continue;
+        }
+        double patchArea = 0.0;
+        model.findPatchArea(rPatch,patchArea);
+        area += patchArea;
+        for (uint j=0;j<rViewFactors.size();j++)
+        {
+            vf += patchArea * rViewFactors.getValue(j);
+        }
+    }
+    QVERIFY(std::fabs(vf / area - vfExact) < 0.01);
+}
+
+void tst_RHemiCube::monteCarloUpdateViewFactors() const
+{
+    RModel model;
+    buildEnclosure(model);
+    model.getProblemSetup().getRadiationSetup().setViewFactorMethod(R_VIEW_FACTOR_METHOD_MONTE_CARLO);
+
+    RViewFactorMatrix oldViewFactorMatrix;
+    preparePatches(model,oldViewFactorMatrix,RConstants::eod);
+    RHemiCube::calculateViewFactors(model,oldViewFactorMatrix);
+
+    // Closed enclosure, every ray hits some patch.
+    for (uint i=0;i<oldViewFactorMatrix.size();i++)
+    {
+        const RSparseVector<double> &rViewFactors = oldViewFactorMatrix.getRow(i).getViewFactors();
+        double rowSum = 0.0;
+        for (uint j=0;j<rViewFactors.size();j++)
+        {
+            rowSum += rViewFactors.getValue(j);
+        }
+        QVERIFY(std::fabs(rowSum - 1.0) < 1.0e-12);
+    }
+
+    // Switch off emitter of one outer wall.
+    RViewFactorMatrix viewFactorMatrix;
+    preparePatches(model,viewFactorMatrix,2);
+    RHemiCube::calculateViewFactors(model,viewFactorMatrix);
+
+    RViewFactorMatrix updatedViewFactorMatrix;
+    preparePatches(model,updatedViewFactorMatrix,2);
+    RHemiCube::updateViewFactors(model,oldViewFactorMatrix,updatedViewFactorMatrix);
+
+    QVERIFY(areSame(updatedViewFactorMatrix,viewFactorMatrix));
+}
@@ -0,0 +1,23 @@
+#ifndef TST_RHEMICUBE_H
+#define TST_RHEMICUBE_H
+
+#include <QtTest>
+
+class tst_RHemiCube : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void parallelSquare() const;
+        void depthOrder() const;
+        void rayTraceScene() const;
+        void updateViewFactors() const;
+        void postProcessViewFactors() const;
+        void postProcessUpdateViewFactors() const;
+        void monteCarloParallelPlates() const;
+        void monteCarloUpdateViewFactors() const;
+
+};
+
+#endif // TST_RHEMICUBE_H
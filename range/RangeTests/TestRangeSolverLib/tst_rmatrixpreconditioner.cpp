@@ -0,0 +1,176 @@
+#include <rmlib.h>
+#include <rmatrixpreconditioner.h>
+
+#include "tst_rmatrixpreconditioner.h"
+
+// Tridiagonal matrix has no fill-in, therefore incomplete factorization is exact.
+static RSparseMatrix buildTridiagonalMatrix(uint n, double lower, double diagonal, double upper)
+{
+    RSparseMatrix A;
+    A.setNRows(n);
+    for (uint i=0;i<n;i++)
+    {
+        if (i > 0)
+        {
+            A.addValue(i,i-1,lower);
+        }
+        A.addValue(i,i,diagonal);
+        if (i+1 < n)
+        {
+            A.addValue(i,i+1,upper);
+        }
+    }
+    return A;
+}
+
+static bool isSolution(const RSparseMatrixCSR &A, const RRVector &x, const RRVector &b)
+{
+    RRVector y;
+    RSparseMatrixCSR::mlt(A,x,y);
+    for (uint i=0;i<b.size();i++)
+    {
+        if (std::abs(y[i]-b[i]) > 1.0e-12)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void tst_RMatrixPreconditioner::incompleteCholesky() const
+{
+    RSparseMatrixCSR A(buildTridiagonalMatrix(6,-1.0,2.0,-1.0));
+
+    RRVector b(6);
+    for (uint i=0;i<b.size();i++)
+    {
+        b[i] = double(i+1);
+    }
+
+    RMatrixPreconditioner P(A,R_MATRIX_PRECONDITIONER_INCOMPLETE_CHOLESKY);
+
+    RRVector x;
+    P.compute(b,x);
+
+    QVERIFY(x.size() == 6);
+    QVERIFY(isSolution(A,x,b));
+}
+
+void tst_RMatrixPreconditioner::incompleteLU() const
+{
+    RSparseMatrixCSR A(buildTridiagonalMatrix(6,-1.0,4.0,-2.0));
+
+    RRVector b(6);
+    for (uint i=0;i<b.size();i++)
+    {
+        b[i] = double(i+1);
+    }
+
+    RMatrixPreconditioner P(A,R_MATRIX_PRECONDITIONER_INCOMPLETE_LU);
+
+    RRVector x;
+    P.compute(b,x);
+
+    QVERIFY(x.size() == 6);
+    QVERIFY(isSolution(A,x,b));
+}
+
+// 2D Poisson matrix on n x n grid.
+static RSparseMatrixCSR buildPoissonMatrix(uint n)
+{
+    RSparseMatrix M;
+    M.setNRows(n*n);
+    for (uint i=0;i<n;i++)
+    {
+        for (uint j=0;j<n;j++)
+        {
+            uint r = i*n+j;
+            M.addValue(r,r,4.0);
+            if (i > 0)
+            {
+                M.addValue(r,r-n,-1.0);
+            }
+            if (i+1 < n)
+            {
+                M.addValue(r,r+n,-1.0);
+            }
+            if (j > 0)
+            {
+                M.addValue(r,r-1,-1.0);
+            }
+            if (j+1 < n)
+            {
+                M.addValue(r,r+1,-1.0);
+            }
+        }
+    }
+    return RSparseMatrixCSR(M);
+}
+
+// Return residual norm after given number of stationary iterations x += P^-1*(b - A*x).
+static double findStationaryResidual(const RSparseMatrixCSR &A, const RMatrixPreconditioner &P, const RRVector &b, uint nIterations)
+{
+    RRVector x(b.size(),0.0);
+    RRVector r(b);
+    RRVector z;
+    RRVector Ax;
+    for (uint iteration=0;iteration<nIterations;iteration++)
+    {
+        P.compute(r,z);
+        for (uint i=0;i<x.size();i++)
+        {
+            x[i] += z[i];
+        }
+        RSparseMatrixCSR::mlt(A,x,Ax);
+        for (uint i=0;i<r.size();i++)
+        {
+            r[i] = b[i] - Ax[i];
+        }
+    }
+    return RRVector::norm(r);
+}
+
+void tst_RMatrixPreconditioner::incompleteLUThreshold() const
+{
+    // Tridiagonal matrix - no fill-in, factorization is exact.
+    RSparseMatrixCSR T(buildTridiagonalMatrix(6,-1.0,4.0,-2.0));
+
+    RRVector c(6);
+    for (uint i=0;i<c.size();i++)
+    {
+        c[i] = double(i+1);
+    }
+
+    RMatrixPreconditioner PT(T,R_MATRIX_PRECONDITIONER_INCOMPLETE_LU_THRESHOLD);
+
+    RRVector y;
+    PT.compute(c,y);
+
+    QVERIFY(y.size() == 6);
+    QVERIFY(isSolution(T,y,c));
+
+    // Poisson matrix - kept fill-in must make ILUT more accurate than ILU(0).
+    RSparseMatrixCSR A(buildPoissonMatrix(20));
+    RRVector b(A.getNRows(),1.0);
+
+    RMatrixPreconditioner PILU(A,R_MATRIX_PRECONDITIONER_INCOMPLETE_LU);
+    RMatrixPreconditioner PILUT(A,R_MATRIX_PRECONDITIONER_INCOMPLETE_LU_THRESHOLD);
+
+    double rILU = findStationaryResidual(A,PILU,b,10);
+    double rILUT = findStationaryResidual(A,PILUT,b,10);
+
+    QVERIFY(rILUT < 0.5 * rILU);
+}
+
+void tst_RMatrixPreconditioner::algebraicMultigrid() const
+{
+    // 2D Poisson matrix on 40x40 grid, large enough to build more than one level.
+    RSparseMatrixCSR A(buildPoissonMatrix(40));
+
+    RRVector b(A.getNRows(),1.0);
+
+    RMatrixPreconditioner P(A,R_MATRIX_PRECONDITIONER_ALGEBRAIC_MULTIGRID);
+
+    // Stationary iteration x += P^-1*(b - A*x) must converge quickly.
+    QVERIFY(findStationaryResidual(A,P,b,10) < 1.0e-6 * RRVector::norm(b));
+}
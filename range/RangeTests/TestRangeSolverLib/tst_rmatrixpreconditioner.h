@@ -0,0 +1,19 @@
+#ifndef TST_RMATRIXPRECONDITIONER_H
+#define TST_RMATRIXPRECONDITIONER_H
+
+#include <QtTest>
+
+class tst_RMatrixPreconditioner : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void incompleteCholesky() const;
+        void incompleteLU() const;
+        void incompleteLUThreshold() const;
+        void algebraicMultigrid() const;
+
+};
+
+#endif // TST_RMATRIXPRECONDITIONER_H
@@ -0,0 +1,266 @@
+#include <rmlib.h>
+#include <rmatrixsolver.h>
+
+#include "tst_rmatrixsolver.h"
+
+// 2D diffusion matrix on n x n grid with variable (symmetric) edge coefficients.
+// Nonzero convection adds skew-symmetric part making the matrix nonsymmetric.
+static RSparseMatrixCSR buildGridMatrix(uint n, double convection = 0.0)
+{
+    RSparseMatrix A;
+    A.setNRows(n*n);
+    for (uint i=0;i<n;i++)
+    {
+        for (uint j=0;j<n;j++)
+        {
+            uint r = i*n + j;
+            uint neighbors[4] = { RConstants::eod, RConstants::eod, RConstants::eod, RConstants::eod };
+            if (i > 0)
+            {
+                neighbors[0] = r-n;
+            }
+            if (i+1 < n)
+            {
+                neighbors[1] = r+n;
+            }
+            if (j > 0)
+            {
+                neighbors[2] = r-1;
+            }
+            if (j+1 < n)
+            {
+                neighbors[3] = r+1;
+            }
+            double diagonal = 0.01;
+            for (uint k=0;k<4;k++)
+            {
+                double c = 1.0 + double((r+neighbors[k])%5);
+                diagonal += c;
+                if (neighbors[k] != RConstants::eod)
+                {
+                    A.addValue(r,neighbors[k],-c + ((neighbors[k] > r) ? convection : -convection));
+                }
+            }
+            A.addValue(r,r,diagonal);
+        }
+    }
+    return RSparseMatrixCSR(A);
+}
+
+static RRVector buildRightHandSide(uint n)
+{
+    RRVector b(n);
+    for (uint i=0;i<n;i++)
+    {
+        b[i] = 1.0 + double(i%7);
+    }
+    return b;
+}
+
+static double findRelativeResidual(const RSparseMatrixCSR &A, const RRVector &x, const RRVector &b)
+{
+    RRVector y;
+    RSparseMatrixCSR::mlt(A,x,y);
+    double rn = 0.0;
+    double bn = 0.0;
+    for (uint i=0;i<b.size();i++)
+    {
+        rn += (y[i]-b[i])*(y[i]-b[i]);
+        bn += b[i]*b[i];
+    }
+    return std::sqrt(rn/bn);
+}
+
+void tst_RMatrixSolver::pipelinedCG() const
+{
+    RSparseMatrixCSR A(buildGridMatrix(40));
+    RRVector b(buildRightHandSide(A.getNRows()));
+
+    RMatrixPreconditionerType preconditionerTypes[3] = { R_MATRIX_PRECONDITIONER_NONE,
+                                                         R_MATRIX_PRECONDITIONER_JACOBI,
+                                                         R_MATRIX_PRECONDITIONER_INCOMPLETE_CHOLESKY };
+
+    for (uint i=0;i<3;i++)
+    {
+        RMatrixSolverConf matrixSolverConf(RMatrixSolverConf::CG);
+        matrixSolverConf.setSolverCvgValue(1.0e-10);
+        matrixSolverConf.setNOuterIterations(5000);
+
+        RRVector x1, x2;
+
+        RMatrixSolver solver(matrixSolverConf);
+        solver.disableConvergenceLogFile();
+        solver.solve(A,b,x1,preconditionerTypes[i]);
+
+        matrixSolverConf.setPipelined(true);
+        RMatrixSolver pipelinedSolver(matrixSolverConf);
+        pipelinedSolver.disableConvergenceLogFile();
+        pipelinedSolver.solve(A,b,x2,preconditionerTypes[i]);
+
+        QVERIFY(findRelativeResidual(A,x1,b) < 1.0e-6);
+        QVERIFY(findRelativeResidual(A,x2,b) < 1.0e-6);
+
+        // Pipelined variant is mathematically equivalent, iteration count may differ only slightly.
+        uint nIterations = solver.getIterationInfo().getIteration();
+        uint nPipelinedIterations = pipelinedSolver.getIterationInfo().getIteration();
+        QVERIFY(nPipelinedIterations <= nIterations + nIterations/10 + 2);
+    }
+}
+
+void tst_RMatrixSolver::flexibleGMRES() const
+{
+    RSparseMatrixCSR A(buildGridMatrix(40,0.8));
+    RRVector b(buildRightHandSide(A.getNRows()));
+
+    RMatrixPreconditionerType preconditionerTypes[3] = { R_MATRIX_PRECONDITIONER_NONE,
+                                                         R_MATRIX_PRECONDITIONER_JACOBI,
+                                                         R_MATRIX_PRECONDITIONER_INCOMPLETE_LU };
+
+    for (uint i=0;i<3;i++)
+    {
+        RMatrixSolverConf matrixSolverConf(RMatrixSolverConf::GMRES);
+        matrixSolverConf.setSolverCvgValue(1.0e-10);
+        matrixSolverConf.setNOuterIterations(5000);
+        // Short restart length stagnates and has to be increased by solver.
+        matrixSolverConf.setNInnerIterations(2);
+
+        RRVector x;
+
+        RMatrixSolver solver(matrixSolverConf);
+        solver.disableConvergenceLogFile();
+        solver.solve(A,b,x,preconditionerTypes[i]);
+
+        QVERIFY(solver.getIterationInfo().hasConverged());
+        QVERIFY(findRelativeResidual(A,x,b) < 1.0e-6);
+    }
+}
+
+void tst_RMatrixSolver::mixedPrecision() const
+{
+    RMatrixSolverType solverTypes[4] = { RMatrixSolverConf::CG,
+                                         RMatrixSolverConf::CG,
+                                         RMatrixSolverConf::CG,
+                                         RMatrixSolverConf::GMRES };
+    RMatrixPreconditionerType preconditionerTypes[4] = { R_MATRIX_PRECONDITIONER_NONE,
+                                                         R_MATRIX_PRECONDITIONER_JACOBI,
+                                                         R_MATRIX_PRECONDITIONER_INCOMPLETE_CHOLESKY,
+                                                         R_MATRIX_PRECONDITIONER_INCOMPLETE_LU };
+
+    for (uint i=0;i<4;i++)
+    {
+        RSparseMatrixCSR A(buildGridMatrix(40,(solverTypes[i] == RMatrixSolverConf::GMRES) ? 0.8 : 0.0));
+        RRVector b(buildRightHandSide(A.getNRows()));
+
+        RMatrixSolverConf matrixSolverConf(solverTypes[i]);
+        matrixSolverConf.setSolverCvgValue(1.0e-12);
+        matrixSolverConf.setNOuterIterations(5000);
+
+        RRVector x1, x2;
+
+        RMatrixSolver solver(matrixSolverConf);
+        solver.disableConvergenceLogFile();
+        solver.solve(A,b,x1,preconditionerTypes[i]);
+
+        matrixSolverConf.setMixedPrecision(true);
+        RMatrixSolver mixedPrecisionSolver(matrixSolverConf);
+        mixedPrecisionSolver.disableConvergenceLogFile();
+        mixedPrecisionSolver.solve(A,b,x2,preconditionerTypes[i]);
+
+        // Refinement reaches the same accuracy as double precision solver.
+        double residual = findRelativeResidual(A,x1,b);
+        double mixedPrecisionResidual = findRelativeResidual(A,x2,b);
+        QVERIFY(residual < 1.0e-6);
+        QVERIFY(mixedPrecisionResidual < 1.0e-6);
+        QVERIFY(mixedPrecisionResidual < 10.0 * residual);
+
+        // Iteration info holds double precision residual of returned solution.
+        double error = mixedPrecisionSolver.getIterationInfo().getError();
+        QVERIFY(error < 1.0e-11);
+        QVERIFY(mixedPrecisionSolver.getIterationInfo().hasConverged() == (error < 1.0e-12));
+    }
+}
+
+void tst_RMatrixSolver::mixedPrecisionNotConverged() const
+{
+    RSparseMatrixCSR A(buildGridMatrix(20));
+    RRVector b(buildRightHandSide(A.getNRows()));
+
+    // Convergence value is below double precision round-off, refinement cannot reach it.
+    RMatrixSolverConf matrixSolverConf(RMatrixSolverConf::CG);
+    matrixSolverConf.setSolverCvgValue(1.0e-30);
+    matrixSolverConf.setNOuterIterations(5000);
+    matrixSolverConf.setMixedPrecision(true);
+
+    RRVector x;
+
+    RMatrixSolver solver(matrixSolverConf);
+    solver.disableConvergenceLogFile();
+    solver.solve(A,b,x,R_MATRIX_PRECONDITIONER_JACOBI);
+
+    QVERIFY(solver.getIterationInfo().getError() > 1.0e-30);
+    QVERIFY(!solver.getIterationInfo().hasConverged());
+    QVERIFY(findRelativeResidual(A,x,b) < 1.0e-6);
+}
+
+void tst_RMatrixSolver::mixedPrecisionOutOfRange() const
+{
+    // Matrix values overflow single precision, solver has to fall back to double precision.
+    RSparseMatrixCSR A(buildGridMatrix(20));
+    for (uint i=0;i<A.getNValues();i++)
+    {
+        A.getValue(i) *= 1.0e40;
+    }
+    RRVector b(buildRightHandSide(A.getNRows()));
+    for (uint i=0;i<b.size();i++)
+    {
+        b[i] *= 1.0e40;
+    }
+
+    QVERIFY(!RSinglePrecisionMatrixOperator::isInRange(A.getValues()));
+
+    RMatrixSolverConf matrixSolverConf(RMatrixSolverConf::CG);
+    matrixSolverConf.setSolverCvgValue(1.0e-12);
+    matrixSolverConf.setNOuterIterations(5000);
+    matrixSolverConf.setMixedPrecision(true);
+
+    RRVector x;
+
+    RMatrixSolver solver(matrixSolverConf);
+    solver.disableConvergenceLogFile();
+    solver.solve(A,b,x,R_MATRIX_PRECONDITIONER_INCOMPLETE_CHOLESKY);
+
+    QVERIFY(findRelativeResidual(A,x,b) < 1.0e-6);
+}
+
+void tst_RMatrixSolver::directSolverRefinement() const
+{
+    // Block diagonal matrix of 2x2 blocks with zero diagonal, LU without pivoting has to perturb pivots.
+    uint nBlocks = 20;
+    RSparseMatrix M;
+    M.setNRows(2*nBlocks);
+    for (uint i=0;i<nBlocks;i++)
+    {
+        M.addValue(2*i,2*i,0.0);
+        M.addValue(2*i,2*i+1,2.0 + double(i%3));
+        M.addValue(2*i+1,2*i,3.0);
+        M.addValue(2*i+1,2*i+1,0.0);
+    }
+    RSparseMatrixCSR A(M);
+    RRVector b(buildRightHandSide(A.getNRows()));
+
+    RMatrixSolverConf matrixSolverConf(RMatrixSolverConf::GMRES);
+    matrixSolverConf.setSolverCvgValue(1.0e-12);
+    matrixSolverConf.setDirectSolver(true);
+
+    RSparseDirectSolver directSolver;
+
+    RMatrixSolver solver(matrixSolverConf);
+    solver.setDirectSolver(&directSolver);
+
+    RRVector x;
+    solver.solve(A,b,x);
+
+    // Iterative refinement removes error caused by perturbed pivots.
+    QVERIFY(directSolver.getNPerturbedPivots() > 0);
+    QVERIFY(findRelativeResidual(A,x,b) < 1.0e-12);
+}
@@ -0,0 +1,21 @@
+#ifndef TST_RMATRIXSOLVER_H
+#define TST_RMATRIXSOLVER_H
+
+#include <QtTest>
+
+class tst_RMatrixSolver : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void pipelinedCG() const;
+        void flexibleGMRES() const;
+        void mixedPrecision() const;
+        void mixedPrecisionOutOfRange() const;
+        void mixedPrecisionNotConverged() const;
+        void directSolverRefinement() const;
+
+};
+
+#endif // TST_RMATRIXSOLVER_H
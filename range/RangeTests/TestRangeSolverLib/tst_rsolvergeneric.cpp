@@ -0,0 +1,258 @@
+#include <algorithm>
+
+#include <rsolvergeneric.h>
+
+#include "tst_rsolvergeneric.h"
+
+// Solver exposing element coloring, all solver stages are empty.
+class RElementColorSolver : public RSolverGeneric
+{
+
+    public:
+
+        RElementColorSolver(RModel *pModel, RSolverSharedData &sharedData)
+            : RSolverGeneric(pModel,QString(),QString(),sharedData)
+        {
+        }
+
+        bool hasConverged(void) const
+        {
+            return true;
+        }
+
+        const std::vector<uint> &findElementColors(void)
+        {
+            this->generateElementColors();
+            return this->elementColors;
+        }
+
+        std::vector< std::vector<uint> > findBatches(const RElementGroup &elementGroup) const
+        {
+            return this->findElementColorBatches(elementGroup);
+        }
+
+        std::vector< std::vector<uint> > findBatches(void) const
+        {
+            return this->findElementColorBatches();
+        }
+
+    protected:
+
+        void updateScales(void) {}
+        void recover(void) {}
+        void prepare(void) {}
+        void solve(void) {}
+        void process(void) {}
+        void store(void) {}
+        void statistics(void) {}
+
+};
+
+// n x n x m grid of tetrahedra (six per cell) in two volumes, bottom face covered by quadrilaterals and triangles,
+// bottom edge by trusses and two corners by points. Groups of different dimension share nodes.
+static void buildMixedMesh(RModel &model, uint n, uint m)
+{
+    for (uint k=0;k<=m;k++)
+    {
+        for (uint j=0;j<=n;j++)
+        {
+            for (uint i=0;i<=n;i++)
+            {
+                model.addNode(RNode(double(i),double(j),double(k)));
+            }
+        }
+    }
+
+    // Cube corners are numbered by bits (x,y,z), tetrahedra follow paths from corner 0 to corner 7.
+    uint paths[6][2] = { { 1, 3 }, { 1, 5 }, { 2, 3 }, { 2, 6 }, { 4, 5 }, { 4, 6 } };
+    for (uint k=0;k<m;k++)
+    {
+        for (uint j=0;j<n;j++)
+        {
+            for (uint i=0;i<n;i++)
+            {
+                uint corners[8];
+                for (uint c=0;c<8;c++)
+                {
+                    corners[c] = ((k + ((c >> 2) & 1))*(n+1) + (j + ((c >> 1) & 1)))*(n+1) + (i + (c & 1));
+                }
+                for (uint t=0;t<6;t++)
+                {
+                    RElement tetrahedron(R_ELEMENT_TETRA1);
+                    tetrahedron.setNodeId(0,corners[0]);
+                    tetrahedron.setNodeId(1,corners[paths[t][0]]);
+                    tetrahedron.setNodeId(2,corners[paths[t][1]]);
+                    tetrahedron.setNodeId(3,corners[7]);
+                    model.addElement(tetrahedron,true,(i < n/2) ? 0 : 1);
+                }
+            }
+        }
+    }
+
+    for (uint j=0;j<n;j++)
+    {
+        for (uint i=0;i<n;i++)
+        {
+            uint n0 = j*(n+1) + i;
+            uint n1 = n0 + 1;
+            uint n2 = n0 + n + 2;
+            uint n3 = n0 + n + 1;
+            if (i < n/2)
+            {
+                RElement quadrilateral(R_ELEMENT_QUAD1);
+                quadrilateral.setNodeId(0,n0);
+                quadrilateral.setNodeId(1,n1);
+                quadrilateral.setNodeId(2,n2);
+                quadrilateral.setNodeId(3,n3);
+                model.addElement(quadrilateral,true,0);
+            }
+            else
+            {
+                RElement triangle1(R_ELEMENT_TRI1);
+                triangle1.setNodeId(0,n0);
+                triangle1.setNodeId(1,n1);
+                triangle1.setNodeId(2,n2);
+                model.addElement(triangle1,true,1);
+                RElement triangle2(R_ELEMENT_TRI1);
+                triangle2.setNodeId(0,n0);
+                triangle2.setNodeId(1,n2);
+                triangle2.setNodeId(2,n3);
+                model.addElement(triangle2,true,1);
+            }
+        }
+    }
+
+    for (uint i=0;i<n;i++)
+    {
+        RElement truss(R_ELEMENT_TRUSS1);
+        truss.setNodeId(0,i);
+        truss.setNodeId(1,i+1);
+        model.addElement(truss,true,0);
+    }
+
+    RElement point1(R_ELEMENT_POINT);
+    point1.setNodeId(0,0);
+    model.addElement(point1,true,0);
+    RElement point2(R_ELEMENT_POINT);
+    point2.setNodeId(0,model.getNNodes()-1);
+    model.addElement(point2,true,1);
+}
+
+// Return true if no two elements of given batch share a node.
+static bool batchIsIndependent(const RModel &model, const std::vector<uint> &batch)
+{
+    std::vector<bool> nodeUsed(model.getNNodes(),false);
+    for (uint i=0;i<batch.size();i++)
+    {
+        const RElement &rElement = model.getElement(batch[i]);
+        for (uint j=0;j<rElement.size();j++)
+        {
+            if (nodeUsed[rElement.getNodeId(j)])
+            {
+                return false;
+            }
+            nodeUsed[rElement.getNodeId(j)] = true;
+        }
+    }
+    return true;
+}
+
+// Return true if batches contain each element of given group exactly once and are independent.
+static bool batchesCoverGroup(const RModel &model, const std::vector< std::vector<uint> > &batches, const std::vector<uint> &elementIDs)
+{
+    std::vector<uint> counts(model.getNElements(),0);
+    for (uint i=0;i<batches.size();i++)
+    {
+        if (!batchIsIndependent(model,batches[i]))
+        {
+            return false;
+        }
+        for (uint j=0;j<batches[i].size();j++)
+        {
+            counts[batches[i][j]]++;
+        }
+    }
+    std::vector<uint> expectedCounts(model.getNElements(),0);
+    for (uint i=0;i<elementIDs.size();i++)
+    {
+        expectedCounts[elementIDs[i]]++;
+    }
+    return (counts == expectedCounts);
+}
+
+void tst_RSolverGeneric::elementColors() const
+{
+    RModel model;
+    buildMixedMesh(model,4,2);
+
+    RSolverSharedData sharedData;
+    RElementColorSolver solver(&model,sharedData);
+
+    const std::vector<uint> &elementColors = solver.findElementColors();
+    QVERIFY(elementColors.size() == model.getNElements());
+
+    // Elements sharing a node have different colors.
+    std::vector< std::vector<uint> > nodeElements(model.getNNodes());
+    for (uint i=0;i<model.getNElements();i++)
+    {
+        const RElement &rElement = model.getElement(i);
+        for (uint j=0;j<rElement.size();j++)
+        {
+            nodeElements[rElement.getNodeId(j)].push_back(i);
+        }
+    }
+    uint nColors = 0;
+    for (uint i=0;i<nodeElements.size();i++)
+    {
+        std::vector<uint> colors;
+        for (uint j=0;j<nodeElements[i].size();j++)
+        {
+            colors.push_back(elementColors[nodeElements[i][j]]);
+            nColors = std::max(nColors,elementColors[nodeElements[i][j]]+1);
+        }
+        std::sort(colors.begin(),colors.end());
+        QVERIFY(std::adjacent_find(colors.begin(),colors.end()) == colors.end());
+    }
+    QVERIFY(nColors > 1);
+
+    // All elements.
+    std::vector<uint> elementIDs;
+    for (uint i=0;i<model.getNElements();i++)
+    {
+        elementIDs.push_back(i);
+    }
+    std::vector< std::vector<uint> > batches = solver.findBatches();
+    QVERIFY(batches.size() == nColors);
+    QVERIFY(batchesCoverGroup(model,batches,elementIDs));
+
+    // Each element group.
+    std::vector<const RElementGroup *> elementGroups;
+    for (uint i=0;i<model.getNPoints();i++)
+    {
+        elementGroups.push_back(model.getPointPtr(i));
+    }
+    for (uint i=0;i<model.getNLines();i++)
+    {
+        elementGroups.push_back(model.getLinePtr(i));
+    }
+    for (uint i=0;i<model.getNSurfaces();i++)
+    {
+        elementGroups.push_back(&model.getSurface(i));
+    }
+    for (uint i=0;i<model.getNVolumes();i++)
+    {
+        elementGroups.push_back(model.getVolumePtr(i));
+    }
+    QVERIFY(elementGroups.size() == 7);
+
+    for (uint i=0;i<elementGroups.size();i++)
+    {
+        elementIDs.clear();
+        for (uint j=0;j<elementGroups[i]->size();j++)
+        {
+            elementIDs.push_back(elementGroups[i]->get(j));
+        }
+        QVERIFY(!elementIDs.empty());
+        QVERIFY(batchesCoverGroup(model,solver.findBatches(*elementGroups[i]),elementIDs));
+    }
+}
@@ -0,0 +1,16 @@
+#ifndef TST_RSOLVERGENERIC_H
+#define TST_RSOLVERGENERIC_H
+
+#include <QtTest>
+
+class tst_RSolverGeneric : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void elementColors() const;
+
+};
+
+#endif // TST_RSOLVERGENERIC_H
@@ -0,0 +1,139 @@
+#include <cmath>
+
+#include <rsolverradiativeheat.h>
+
+#include "tst_rsolverradiativeheat.h"
+
+// Stefan-Boltzmann constant used by solver.
+static const double sigma = 5.670367e-8;
+
+// Build view-factor matrix from dense rows (zero view-factors are not stored).
+static void buildViewFactorMatrix(const std::vector< std::vector<double> > &F, RViewFactorMatrix &viewFactorMatrix)
+{
+    viewFactorMatrix.resize(uint(F.size()));
+    for (uint i=0;i<F.size();i++)
+    {
+        for (uint j=0;j<F[i].size();j++)
+        {
+            if (F[i][j] != 0.0)
+            {
+                viewFactorMatrix.getRow(i).getViewFactors().addValue(j,F[i][j]);
+            }
+        }
+    }
+}
+
+// Reference assembly looping over all patch pairs.
+static void assemblyDense(const std::vector< std::vector<double> > &F,
+                          const RRVector &E,
+                          const RRVector &T,
+                          const RRVector &Ta,
+                          RRMatrix &A,
+                          RRVector &b)
+{
+    uint n = uint(F.size());
+    A.resize(n,n,0.0);
+    b.resize(n,0.0);
+    b.fill(0.0);
+
+    for (uint i=0;i<n;i++)
+    {
+        double Fsum = 0.0;
+        for (uint j=0;j<n;j++)
+        {
+            double dij = (i == j ? 1.0 : 0.0);
+            double Fij = F[i][j];
+            double Ej = E[j];
+            Fsum += Fij;
+
+            double Aij = 0.0;
+            if (Ej != 0.0)
+            {
+                Aij = dij/Ej - Fij*(1.0-Ej)/Ej;
+            }
+            double Bij = (dij-Fij)*sigma;
+
+            A[i][j] += Aij;
+            b[j] -= Bij * std::pow(T[j],4);
+        }
+        b[i] += (1.0 - Fsum) * sigma * std::pow(Ta[i],4);
+    }
+}
+
+// Compare sparse assembly with dense reference.
+static bool assemblyMatches(const std::vector< std::vector<double> > &F, const RRVector &E, const RRVector &T, const RRVector &Ta)
+{
+    RViewFactorMatrix viewFactorMatrix;
+    buildViewFactorMatrix(F,viewFactorMatrix);
+
+    RSparseMatrix A;
+    RRVector b;
+    RSolverRadiativeHeat::assemblyRadiationSystem(viewFactorMatrix,E,T,Ta,A,b);
+
+    RRMatrix Aref;
+    RRVector bref;
+    assemblyDense(F,E,T,Ta,Aref,bref);
+
+    uint n = uint(F.size());
+    if (A.getNRows() != n || b.size() != n)
+    {
+        return false;
+    }
+
+    double bNorm = RRVector::norm(bref);
+    for (uint i=0;i<n;i++)
+    {
+        for (uint j=0;j<n;j++)
+        {
+            if (std::fabs(A.findValue(i,j) - Aref[i][j]) > 1.0e-12 * std::max(std::fabs(Aref[i][j]),1.0))
+            {
+                return false;
+            }
+        }
+        if (std::fabs(b[i] - bref[i]) > 1.0e-12 * bNorm)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void tst_RSolverRadiativeHeat::closedEnclosure() const
+{
+    // Rows sum to 1, first patch is concave and sees itself.
+    std::vector< std::vector<double> > F(3,std::vector<double>(3,0.0));
+    F[0][0] = 0.2; F[0][1] = 0.5; F[0][2] = 0.3;
+    F[1][0] = 0.6; F[1][1] = 0.0; F[1][2] = 0.4;
+    F[2][0] = 0.3; F[2][1] = 0.7; F[2][2] = 0.0;
+
+    RRVector E(3,0.0);
+    E[0] = 0.8; E[1] = 0.5; E[2] = 1.0;
+
+    RRVector T(3,0.0);
+    T[0] = 300.0; T[1] = 650.0; T[2] = 1200.0;
+
+    RRVector Ta(3,290.0);
+
+    QVERIFY(assemblyMatches(F,E,T,Ta));
+}
+
+void tst_RSolverRadiativeHeat::openEnclosure() const
+{
+    // Rows sum below 1, remainder is exchanged with ambient.
+    // Third patch has zero emissivity and last patch sees nothing.
+    std::vector< std::vector<double> > F(4,std::vector<double>(4,0.0));
+    F[0][1] = 0.25; F[0][2] = 0.1;
+    F[1][0] = 0.4;  F[1][1] = 0.05; F[1][2] = 0.3;
+    F[2][0] = 0.15; F[2][1] = 0.35;
+
+    RRVector E(4,0.0);
+    E[0] = 0.9; E[1] = 0.3; E[2] = 0.0; E[3] = 0.7;
+
+    RRVector T(4,0.0);
+    T[0] = 400.0; T[1] = 800.0; T[2] = 550.0; T[3] = 1000.0;
+
+    RRVector Ta(4,0.0);
+    Ta[0] = 280.0; Ta[1] = 300.0; Ta[2] = 320.0; Ta[3] = 340.0;
+
+    QVERIFY(assemblyMatches(F,E,T,Ta));
+}
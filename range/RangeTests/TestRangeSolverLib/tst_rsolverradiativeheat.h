@@ -0,0 +1,17 @@
+#ifndef TST_RSOLVERRADIATIVEHEAT_H
+#define TST_RSOLVERRADIATIVEHEAT_H
+
+#include <QtTest>
+
+class tst_RSolverRadiativeHeat : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void closedEnclosure() const;
+        void openEnclosure() const;
+
+};
+
+#endif // TST_RSOLVERRADIATIVEHEAT_H
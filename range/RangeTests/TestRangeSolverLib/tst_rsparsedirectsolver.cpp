@@ -0,0 +1,115 @@
+#include <rmlib.h>
+#include <rsparsedirectsolver.h>
+
+#include "tst_rsparsedirectsolver.h"
+
+// 2D convection-diffusion matrix on n x n grid, symmetric for zero convection.
+// Grid is large enough to be split by nested dissection.
+static RSparseMatrixCSR buildGridMatrix(uint n, double convection)
+{
+    RSparseMatrix A;
+    A.setNRows(n*n);
+    for (uint i=0;i<n;i++)
+    {
+        for (uint j=0;j<n;j++)
+        {
+            uint r = i*n + j;
+            A.addValue(r,r,4.0);
+            if (i > 0)
+            {
+                A.addValue(r,r-n,-1.0);
+            }
+            if (i+1 < n)
+            {
+                A.addValue(r,r+n,-1.0);
+            }
+            if (j > 0)
+            {
+                A.addValue(r,r-1,-1.0-convection);
+            }
+            if (j+1 < n)
+            {
+                A.addValue(r,r+1,-1.0+convection);
+            }
+        }
+    }
+    return RSparseMatrixCSR(A);
+}
+
+static RRVector buildRightHandSide(uint n)
+{
+    RRVector b(n);
+    for (uint i=0;i<n;i++)
+    {
+        b[i] = 1.0 + double(i%7);
+    }
+    return b;
+}
+
+static bool isSolution(const RSparseMatrixCSR &A, const RRVector &x, const RRVector &b)
+{
+    RRVector y;
+    RSparseMatrixCSR::mlt(A,x,y);
+    for (uint i=0;i<b.size();i++)
+    {
+        if (std::abs(y[i]-b[i]) > 1.0e-10)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void tst_RSparseDirectSolver::cholesky() const
+{
+    RSparseMatrixCSR A(buildGridMatrix(30,0.0));
+    RRVector b(buildRightHandSide(A.getNRows()));
+
+    RSparseDirectSolver solver;
+    solver.factorize(A,true);
+
+    RRVector x;
+    solver.solve(b,x);
+
+    QVERIFY(x.size() == b.size());
+    QVERIFY(isSolution(A,x,b));
+}
+
+void tst_RSparseDirectSolver::lu() const
+{
+    RSparseMatrixCSR A(buildGridMatrix(30,0.5));
+    RRVector b(buildRightHandSide(A.getNRows()));
+
+    RSparseDirectSolver solver;
+    solver.factorize(A,false);
+
+    RRVector x;
+    solver.solve(b,x);
+
+    QVERIFY(x.size() == b.size());
+    QVERIFY(isSolution(A,x,b));
+}
+
+void tst_RSparseDirectSolver::refactorize() const
+{
+    RSparseMatrixCSR A(buildGridMatrix(30,0.0));
+    RRVector b(buildRightHandSide(A.getNRows()));
+
+    RSparseDirectSolver solver;
+    solver.factorize(A,true);
+    QVERIFY(solver.isFactorized(A,true));
+
+    // Same pattern, different values.
+    for (uint i=0;i<A.getNValues();i++)
+    {
+        A.getValue(i) *= 2.0;
+    }
+    QVERIFY(!solver.isFactorized(A,true));
+
+    solver.factorize(A,true);
+
+    RRVector x;
+    solver.solve(b,x);
+
+    QVERIFY(isSolution(A,x,b));
+}
@@ -0,0 +1,18 @@
+#ifndef TST_RSPARSEDIRECTSOLVER_H
+#define TST_RSPARSEDIRECTSOLVER_H
+
+#include <QtTest>
+
+class tst_RSparseDirectSolver : public QObject
+{
+
+    Q_OBJECT
+
+    private slots:
+        void cholesky() const;
+        void lu() const;
+        void refactorize() const;
+
+};
+
+#endif // TST_RSPARSEDIRECTSOLVER_H
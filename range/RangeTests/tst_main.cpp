@@ -3,8 +3,25 @@
 #include "TestRangeBase/tst_rbl_rvector.h"
 #include "TestRangeBase/tst_rbl_r3vector.h"
 #include "TestRangeBase/tst_rbl_rmatrix.h"
+#include "TestRangeBase/tst_rbl_rsmall_matrix.h"
+#include "TestRangeBase/tst_rbl_space_filling_curve.h"
+#include "TestRangeModel/tst_rml_element_geometry_cache.h"
+#include "TestRangeModel/tst_rml_element_kernel.h"
+#include "TestRangeModel/tst_rml_matrix_system.h"
+#include "TestRangeModel/tst_rml_mesh_view.h"
+#include "TestRangeModel/tst_rml_model.h"
 #include "TestRangeModel/tst_rml_sparse_vector.h"
 #include "TestRangeModel/tst_rml_sparse_matrix.h"
+#include "TestRangeModel/tst_rml_sparse_matrix_csr.h"
+#include "TestRangeModel/tst_rml_sparse_matrix_bsr.h"
+#include "TestRangeSolverLib/tst_relementmatrixoperator.h"
+#include "TestRangeSolverLib/tst_rgraphordering.h"
+#include "TestRangeSolverLib/tst_rhemicube.h"
+#include "TestRangeSolverLib/tst_rmatrixpreconditioner.h"
+#include "TestRangeSolverLib/tst_rmatrixsolver.h"
+#include "TestRangeSolverLib/tst_rsolvergeneric.h"
+#include "TestRangeSolverLib/tst_rsolverradiativeheat.h"
+#include "TestRangeSolverLib/tst_rsparsedirectsolver.h"
 
 int main(int argc, char *argv[])
 {
@@ -25,6 +42,41 @@ int main(int argc, char *argv[])
        status |= QTest::qExec(&tc, argc, argv);
    }
 
+   {
+       tst_RRSmallMatrix tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RSpaceFillingCurve tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RElementGeometryCache tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RElementKernel tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RMatrixSystem tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RMeshView tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RModel tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
    {
        tst_RSparseVector tc;
        status |= QTest::qExec(&tc, argc, argv);
@@ -35,5 +87,55 @@ int main(int argc, char *argv[])
        status |= QTest::qExec(&tc, argc, argv);
    }
 
+   {
+       tst_RSparseMatrixCSR tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RSparseMatrixBSR tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RElementMatrixOperator tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RGraphOrdering tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RHemiCube tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RMatrixPreconditioner tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RMatrixSolver tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RSolverGeneric tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RSolverRadiativeHeat tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
+   {
+       tst_RSparseDirectSolver tc;
+       status |= QTest::qExec(&tc, argc, argv);
+   }
+
    return status;
 }
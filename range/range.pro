@@ -7,6 +7,7 @@ SUBDIRS = \
     RangeSolverLib \
     RangeSolver \
     Range \
+    RangeBench \
     Installer
     RangeTests
 
@@ -14,6 +15,7 @@ RangeModel.depends = RangeBase TetGen
 RangeSolverLib.depends = RangeModel
 RangeSolver.depends = RangeSolverLib
 Range.depends = RangeSolverLib
+RangeBench.depends = RangeSolverLib
 
 # build the project sequentially as listed in SUBDIRS !
 CONFIG += ordered